@@ -0,0 +1,30 @@
+﻿using Sharpmake;
+
+namespace ShipyardSharpmake
+{
+    [Generate]
+    class ShipyardLogDecoderProject : BaseExecutableProject
+    {
+        public ShipyardLogDecoderProject()
+            : base("shipyard.logdecoder", @"..\shipyard-log-decoder\", ShipyardUtils.DefaultShipyardTargetLib)
+        {
+        }
+
+        [Configure]
+        public override void ConfigureAll(Configuration configuration, ShipyardTarget target)
+        {
+            base.ConfigureAll(configuration, target);
+
+            configuration.ForcedIncludes.Add("shipyardlogdecoderprecomp.h");
+            configuration.PrecompHeader = "shipyardlogdecoderprecomp.h";
+            configuration.PrecompSource = "shipyardlogdecoderprecomp.cpp";
+        }
+
+        protected override void ConfigureProjectDependencies(Configuration configuration, ShipyardTarget target)
+        {
+            base.ConfigureProjectDependencies(configuration, target);
+
+            configuration.AddPublicDependency<ShipyardSystemProject>(target, ShipyardUtils.DefaultDependencySettings);
+        }
+    }
+}
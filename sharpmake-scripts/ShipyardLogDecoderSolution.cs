@@ -0,0 +1,22 @@
+﻿using Sharpmake;
+
+namespace ShipyardSharpmake
+{
+    [Generate]
+    class ShipyardLogDecoderSolution : BaseSolution
+    {
+        public ShipyardLogDecoderSolution()
+            : base("shipyard.logdecoder", ShipyardUtils.DefaultShipyardTargetLib)
+        {
+        }
+
+        [Configure]
+        public override void ConfigureAll(Configuration configuration, ShipyardTarget target)
+        {
+            base.ConfigureAll(configuration, target);
+
+            configuration.AddProject<ShipyardSystemProject>(target);
+            configuration.AddProject<ShipyardLogDecoderProject>(target);
+        }
+    }
+}
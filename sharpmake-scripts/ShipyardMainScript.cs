@@ -9,6 +9,8 @@
 [module: Sharpmake.Include("ShipyardUtils.cs")]
 [module: Sharpmake.Include("SharpmakeProject.cs")]
 [module: Sharpmake.Include("SharpmakeSolution.cs")]
+[module: Sharpmake.Include("ShipyardLogDecoderProject.cs")]
+[module: Sharpmake.Include("ShipyardLogDecoderSolution.cs")]
 [module: Sharpmake.Include("ShipyardProject.cs")]
 [module: Sharpmake.Include("ShipyardSolution.cs")]
 [module: Sharpmake.Include("ShipyardTarget.cs")]
@@ -30,6 +32,8 @@ namespace ShipyardSharpmake
 
             arguments.Generate<ShipyardUnitTestSolution>();
 
+            arguments.Generate<ShipyardLogDecoderSolution>();
+
             arguments.Generate<SharpmakeSolution>();
         }   
     }
@@ -0,0 +1,33 @@
+#include "shipyardlogdecoderprecomp.h"
+
+#include <system/logrecord.h>
+
+#include <cstdio>
+#include <string>
+
+// Turns a binary log written with LogFileFormat::Binary into a text log.
+//
+// Usage: shipyard.logdecoder <binary log> [text log]
+// The text log defaults to the binary log's filename with ".txt" appended.
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        printf("Usage: %s <binary log> [text log]\n", argv[0]);
+        return 1;
+    }
+
+    const char* pBinaryLogFilename = argv[1];
+    std::string textLogFilename = ((argc == 3) ? argv[2] : (std::string(pBinaryLogFilename) + ".txt"));
+
+    if (!Shipyard::DecodeBinaryLogFile(pBinaryLogFilename, textLogFilename.c_str()))
+    {
+        printf("Couldn't decode %s, it is either not a binary log or it is truncated. Messages decoded before the error were written to %s.\n",
+                pBinaryLogFilename, textLogFilename.c_str());
+        return 1;
+    }
+
+    printf("Decoded %s to %s.\n", pBinaryLogFilename, textLogFilename.c_str());
+
+    return 0;
+}
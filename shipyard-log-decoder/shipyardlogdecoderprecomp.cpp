@@ -0,0 +1 @@
+#include "shipyardlogdecoderprecomp.h"
\ No newline at end of file
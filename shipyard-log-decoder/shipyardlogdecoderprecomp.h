@@ -0,0 +1,3 @@
+#pragma once
+
+#include <system/systemprecomp.h>
\ No newline at end of file
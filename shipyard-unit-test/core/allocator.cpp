@@ -4,9 +4,23 @@
 
 #include <utils/unittestutils.h>
 
-#include <system/memory/linearallocator.h>
+#include <system/array.h>
+#include <system/string.h>
 
+#include <system/memory/debugallocator.h>
+#include <system/memory/frameallocator.h>
+#include <system/memory/linearallocator.h>
+#include <system/memory/scratchallocator.h>
+#include <system/memory/smallobjectallocator.h>
+#include <system/memory/tlsfallocator.h>
+#include <system/memory/virtualmemoryheap.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace
 {
@@ -936,6 +950,40 @@ TEST_CASE("Test FixedHeapAllocator", "[Allocator]")
 
     }
 
+    SECTION("freeing into the last free block gives the merged block back")
+    {
+        Shipyard::VirtualMemoryHeap virtualMemoryHeap;
+        REQUIRE(virtualMemoryHeap.Create(64 * 1024 * 1024));
+
+        REQUIRE(fixedHeapAllocator.Create(&virtualMemoryHeap));
+
+        void* pSmallAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 64, 8);
+        void* pBigAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 4 * 1024 * 1024, 8);
+
+        REQUIRE(pSmallAlloc != nullptr);
+        REQUIRE(pBigAlloc != nullptr);
+
+        // Up to the end of the committed memory, so that no free block is left after it.
+        size_t endOfCommittedMemory = size_t(virtualMemoryHeap.GetBaseAddress()) + virtualMemoryHeap.GetCommittedSize();
+
+        REQUIRE(fixedHeapAllocator.TryExpandInPlace(pBigAlloc, 4 * 1024 * 1024, endOfCommittedMemory - size_t(pBigAlloc)));
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pSmallAlloc);
+        SHIP_FREE_EX(&fixedHeapAllocator, pBigAlloc);
+
+        void* pAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 2 * 1024 * 1024, 8);
+
+        REQUIRE(pAlloc != nullptr);
+        REQUIRE(size_t(pAlloc) + 2 * 1024 * 1024 <= size_t(virtualMemoryHeap.GetBaseAddress()) + virtualMemoryHeap.GetCommittedSize());
+
+        memset(pAlloc, 0x5a, 2 * 1024 * 1024);
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pAlloc);
+
+        fixedHeapAllocator.Destroy();
+        virtualMemoryHeap.Destroy();
+    }
+
     fixedHeapAllocator.Destroy();
 }
 
@@ -1389,6 +1437,228 @@ TEST_CASE("Test PoolAllocator", "[Allocator]")
     poolAllocator.Destroy();
 }
 
+namespace
+{
+    void PoolAllocatorTestThreadFunction(Shipyard::PoolAllocator* pPoolAllocator, uint8_t threadPattern, size_t chunkSize, size_t numIterations, size_t numAllocationsPerIteration, bool* pAllocationsAreValid)
+    {
+        const size_t maxNumAllocationsPerIteration = 64;
+        numAllocationsPerIteration = std::min(numAllocationsPerIteration, maxNumAllocationsPerIteration);
+
+        void* pAllocs[maxNumAllocationsPerIteration];
+
+        *pAllocationsAreValid = true;
+
+        for (size_t iteration = 0; iteration < numIterations; iteration++)
+        {
+            size_t numAllocations = 0;
+
+            for (; numAllocations < numAllocationsPerIteration; numAllocations++)
+            {
+                void* pAlloc = SHIP_ALLOC_EX(pPoolAllocator, chunkSize, 1);
+                if (pAlloc == nullptr)
+                {
+                    break;
+                }
+
+                uint8_t* pBytes = reinterpret_cast<uint8_t*>(pAlloc);
+
+                for (size_t byteIndex = 0; byteIndex < chunkSize; byteIndex++)
+                {
+                    pBytes[byteIndex] = threadPattern;
+                }
+
+                pAllocs[numAllocations] = pAlloc;
+            }
+
+            for (size_t i = 0; i < numAllocations; i++)
+            {
+                const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pAllocs[i]);
+
+                for (size_t byteIndex = 0; byteIndex < chunkSize; byteIndex++)
+                {
+                    if (pBytes[byteIndex] != threadPattern)
+                    {
+                        *pAllocationsAreValid = false;
+                    }
+                }
+
+                SHIP_FREE_EX(pPoolAllocator, pAllocs[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test PoolAllocator lock-free", "[Allocator]")
+{
+    Shipyard::PoolAllocator poolAllocator;
+
+    SECTION("simple allocation")
+    {
+        const size_t chunkSize = 16;
+        const size_t numChunks = 2;
+        Shipyard::ScoppedBuffer scoppedBuffer(chunkSize * numChunks + chunkSize, chunkSize);
+
+        poolAllocator.Create(scoppedBuffer.pBuffer, numChunks, chunkSize, Shipyard::PoolAllocator::SynchronizationMode::LockFree);
+
+        void* pAlloc1 = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 1);
+        void* pAlloc2 = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 16);
+        void* pAlloc3 = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 1);
+
+        REQUIRE(pAlloc1 != nullptr);
+        REQUIRE(pAlloc2 != nullptr);
+        REQUIRE(pAlloc3 == nullptr);
+        REQUIRE(AllocsAreDontOverlap(pAlloc1, chunkSize, pAlloc2, chunkSize));
+        REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc2), 16));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(poolAllocator.GetMemoryInfo().numBlocksAllocated == 2);
+        REQUIRE(poolAllocator.GetMemoryInfo().numBytesUsed == chunkSize * 2);
+        REQUIRE(poolAllocator.GetMemoryInfo().numUserBytesAllocated == chunkSize * 2);
+        REQUIRE(poolAllocator.GetMemoryInfo().peakUserBytesAllocated == chunkSize * 2);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&poolAllocator, pAlloc1);
+
+        void* pAlloc4 = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 1);
+        REQUIRE(pAlloc4 == pAlloc1);
+
+        SHIP_FREE_EX(&poolAllocator, pAlloc2);
+        SHIP_FREE_EX(&poolAllocator, pAlloc4);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(poolAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(poolAllocator.GetMemoryInfo().numBytesUsed == 0);
+        REQUIRE(poolAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+        REQUIRE(poolAllocator.GetMemoryInfo().peakUserBytesAllocated == chunkSize * 2);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("alignment larger than chunk alignment")
+    {
+        const size_t chunkSize = 24;
+        const size_t numChunks = 4;
+        Shipyard::ScoppedBuffer scoppedBuffer(chunkSize * numChunks + 64, 64);
+
+        poolAllocator.Create(scoppedBuffer.pBuffer, numChunks, chunkSize, Shipyard::PoolAllocator::SynchronizationMode::LockFree);
+
+        void* pAlloc = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 16);
+        REQUIRE(pAlloc == nullptr);
+
+        pAlloc = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 8);
+        REQUIRE(pAlloc != nullptr);
+
+        SHIP_FREE_EX(&poolAllocator, pAlloc);
+    }
+
+    SECTION("allocations from multiple threads")
+    {
+        const size_t numThreads = 8;
+        const size_t chunkSize = 32;
+        const size_t numIterations = 2000;
+        const size_t numAllocationsPerIteration = 32;
+
+        // Not enough chunks for every thread, so that threads also have to handle running out of memory.
+        const size_t numChunks = numThreads * numAllocationsPerIteration / 2;
+
+        Shipyard::ScoppedBuffer scoppedBuffer(chunkSize * numChunks + chunkSize, chunkSize);
+
+        poolAllocator.Create(scoppedBuffer.pBuffer, numChunks, chunkSize, Shipyard::PoolAllocator::SynchronizationMode::LockFree);
+
+        std::thread threads[numThreads];
+        bool allocationsAreValid[numThreads];
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i] = std::thread(PoolAllocatorTestThreadFunction, &poolAllocator, uint8_t(i + 1), chunkSize, numIterations, numAllocationsPerIteration, &allocationsAreValid[i]);
+        }
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i].join();
+
+            REQUIRE(allocationsAreValid[i]);
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(poolAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(poolAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        // Every chunk must have been given back exactly once.
+        void* pAllocs[numChunks];
+
+        for (size_t i = 0; i < numChunks; i++)
+        {
+            pAllocs[i] = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 1);
+
+            REQUIRE(pAllocs[i] != nullptr);
+        }
+
+        REQUIRE(SHIP_ALLOC_EX(&poolAllocator, chunkSize, 1) == nullptr);
+
+        std::sort(pAllocs, pAllocs + numChunks);
+        REQUIRE(std::unique(pAllocs, pAllocs + numChunks) == pAllocs + numChunks);
+
+        for (size_t i = 0; i < numChunks; i++)
+        {
+            SHIP_FREE_EX(&poolAllocator, pAllocs[i]);
+        }
+    }
+
+    poolAllocator.Destroy();
+}
+
+TEST_CASE("Benchmark PoolAllocator lock-free", "[.][Benchmark][Allocator]")
+{
+    const size_t numThreads = 8;
+    const size_t chunkSize = 32;
+    const size_t numIterations = 20000;
+    const size_t numAllocationsPerIteration = 16;
+    const size_t numChunks = numThreads * numAllocationsPerIteration;
+
+    Shipyard::ScoppedBuffer scoppedBuffer(chunkSize * numChunks + chunkSize, chunkSize);
+
+    auto runThreads = [&](Shipyard::PoolAllocator& poolAllocator)
+    {
+        std::thread threads[numThreads];
+        bool allocationsAreValid[numThreads];
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i] = std::thread(PoolAllocatorTestThreadFunction, &poolAllocator, uint8_t(i + 1), chunkSize, numIterations, numAllocationsPerIteration, &allocationsAreValid[i]);
+        }
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i].join();
+        }
+    };
+
+    {
+        Shipyard::PoolAllocator poolAllocator;
+        poolAllocator.Create(scoppedBuffer.pBuffer, numChunks, chunkSize, Shipyard::PoolAllocator::SynchronizationMode::Mutex);
+
+        BENCHMARK("8 threads pool allocations with mutex")
+        {
+            runThreads(poolAllocator);
+        }
+
+        poolAllocator.Destroy();
+    }
+
+    {
+        Shipyard::PoolAllocator poolAllocator;
+        poolAllocator.Create(scoppedBuffer.pBuffer, numChunks, chunkSize, Shipyard::PoolAllocator::SynchronizationMode::LockFree);
+
+        BENCHMARK("8 threads pool allocations lock-free")
+        {
+            runThreads(poolAllocator);
+        }
+
+        poolAllocator.Destroy();
+    }
+}
+
 class LinearAllocatorTestThread
 {
 public:
@@ -1533,4 +1803,2080 @@ TEST_CASE("Test LinearAllocator", "[Allocator]")
     }
 
     linearAllocator.Destroy();
-}
\ No newline at end of file
+}
+namespace
+{
+    void FrameAllocatorTestThreadFunction(Shipyard::FrameAllocator* pFrameAllocator, uint8_t threadPattern, size_t numAllocations, bool* pAllocationsAreValid)
+    {
+        std::vector<std::pair<void*, size_t>> allocations;
+        allocations.reserve(numAllocations);
+
+        *pAllocationsAreValid = true;
+
+        for (size_t i = 0; i < numAllocations; i++)
+        {
+            size_t allocSize = 1 + (i % 64);
+            size_t alignment = size_t(1) << (i % 5);
+
+            void* pAlloc = SHIP_ALLOC_EX(pFrameAllocator, allocSize, alignment);
+            if (pAlloc == nullptr || !Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc), alignment))
+            {
+                *pAllocationsAreValid = false;
+                return;
+            }
+
+            uint8_t* pBytes = reinterpret_cast<uint8_t*>(pAlloc);
+            for (size_t byteIndex = 0; byteIndex < allocSize; byteIndex++)
+            {
+                pBytes[byteIndex] = threadPattern;
+            }
+
+            allocations.push_back(std::make_pair(pAlloc, allocSize));
+        }
+
+        for (const std::pair<void*, size_t>& allocation : allocations)
+        {
+            const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(allocation.first);
+            for (size_t byteIndex = 0; byteIndex < allocation.second; byteIndex++)
+            {
+                if (pBytes[byteIndex] != threadPattern)
+                {
+                    *pAllocationsAreValid = false;
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test FrameAllocator", "[Allocator]")
+{
+    Shipyard::FrameAllocator frameAllocator;
+
+    SECTION("allocations stay in the current frame's region")
+    {
+        const size_t heapSize = 3 * 4096;
+        const uint32_t numFramesInFlight = 3;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        REQUIRE(frameAllocator.Create(scoppedBuffer.pBuffer, heapSize, numFramesInFlight, 1024));
+
+        const size_t frameRegionSize = frameAllocator.GetFrameRegionSize();
+        REQUIRE(frameRegionSize == 4096);
+
+        for (uint32_t frameIndex = 0; frameIndex < 2 * numFramesInFlight; frameIndex++)
+        {
+            frameAllocator.BeginFrame(frameIndex);
+
+            size_t regionStart = size_t(scoppedBuffer.pBuffer) + (frameIndex % numFramesInFlight) * frameRegionSize;
+
+            // Small allocation, from the thread's sub-arena.
+            void* pSmallAlloc = SHIP_ALLOC_EX(&frameAllocator, 16, 8);
+
+            // Big allocation, directly in the region.
+            void* pBigAlloc = SHIP_ALLOC_EX(&frameAllocator, 1024, 16);
+
+            REQUIRE(pSmallAlloc != nullptr);
+            REQUIRE(pBigAlloc != nullptr);
+            REQUIRE(size_t(pSmallAlloc) >= regionStart);
+            REQUIRE(size_t(pSmallAlloc) + 16 <= regionStart + frameRegionSize);
+            REQUIRE(size_t(pBigAlloc) >= regionStart);
+            REQUIRE(size_t(pBigAlloc) + 1024 <= regionStart + frameRegionSize);
+            REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pBigAlloc), 16));
+            REQUIRE(AllocsAreDontOverlap(pSmallAlloc, 16, pBigAlloc, 1024));
+
+            SHIP_FREE_EX(&frameAllocator, pSmallAlloc);
+            SHIP_FREE_EX(&frameAllocator, pBigAlloc);
+        }
+    }
+
+    SECTION("previous frames are kept until their region is recycled")
+    {
+        const size_t heapSize = 2 * 1024;
+        const uint32_t numFramesInFlight = 2;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        REQUIRE(frameAllocator.Create(scoppedBuffer.pBuffer, heapSize, numFramesInFlight, 0));
+
+        frameAllocator.BeginFrame(0);
+        uint8_t* pFirstFrameAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&frameAllocator, 1024, 1));
+        REQUIRE(pFirstFrameAlloc != nullptr);
+        pFirstFrameAlloc[0] = 0xAB;
+
+        // The first frame's region is full.
+        REQUIRE(SHIP_ALLOC_EX(&frameAllocator, 1, 1) == nullptr);
+
+        frameAllocator.BeginFrame(1);
+        uint8_t* pSecondFrameAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&frameAllocator, 1024, 1));
+        REQUIRE(pSecondFrameAlloc != nullptr);
+        pSecondFrameAlloc[0] = 0xCD;
+
+        REQUIRE(pFirstFrameAlloc[0] == 0xAB);
+
+        frameAllocator.BeginFrame(2);
+        uint8_t* pThirdFrameAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&frameAllocator, 1024, 1));
+
+        REQUIRE(pThirdFrameAlloc == pFirstFrameAlloc);
+        REQUIRE(pSecondFrameAlloc[0] == 0xCD);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        frameAllocator.BeginFrame(3);
+
+        REQUIRE(frameAllocator.GetMemoryInfo().numFramesCompleted == 2);
+        REQUIRE(frameAllocator.GetMemoryInfo().numFramesOverflowed == 1);
+        REQUIRE(frameAllocator.GetMemoryInfo().numFailedAllocations == 1);
+        REQUIRE(frameAllocator.GetMemoryInfo().peakFrameBytesUsed == 1024);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("Allocations from multiple threads")
+    {
+        const size_t numThreads = 8;
+        const size_t numAllocationsForEachThread = 10000;
+        const uint32_t numFramesInFlight = 2;
+
+        // Enough space for the biggest allocations & alignments, and the wasted end of every sub-arena.
+        const size_t heapSize = numFramesInFlight * numThreads * numAllocationsForEachThread * 128;
+
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        REQUIRE(frameAllocator.Create(scoppedBuffer.pBuffer, heapSize, numFramesInFlight));
+
+        for (uint32_t frameIndex = 0; frameIndex < 4; frameIndex++)
+        {
+            frameAllocator.BeginFrame(frameIndex);
+
+            std::thread threads[numThreads];
+            bool allocationsAreValid[numThreads];
+
+            for (size_t i = 0; i < numThreads; i++)
+            {
+                threads[i] = std::thread(FrameAllocatorTestThreadFunction, &frameAllocator, uint8_t(i + 1), numAllocationsForEachThread, &allocationsAreValid[i]);
+            }
+
+            for (size_t i = 0; i < numThreads; i++)
+            {
+                threads[i].join();
+
+                REQUIRE(allocationsAreValid[i]);
+            }
+        }
+    }
+
+    frameAllocator.Destroy();
+}
+
+namespace
+{
+    void GlobalAllocatorTestThreadFunction(uint8_t threadPattern, size_t numIterations, size_t numAllocationsPerIteration, bool* pAllocationsAreValid)
+    {
+        const size_t maxNumAllocationsPerIteration = 64;
+        numAllocationsPerIteration = std::min(numAllocationsPerIteration, maxNumAllocationsPerIteration);
+
+        void* pAllocs[maxNumAllocationsPerIteration];
+        size_t allocSizes[maxNumAllocationsPerIteration];
+
+        *pAllocationsAreValid = true;
+
+        for (size_t iteration = 0; iteration < numIterations; iteration++)
+        {
+            for (size_t i = 0; i < numAllocationsPerIteration; i++)
+            {
+                allocSizes[i] = 1 + ((iteration + i) % 32);
+
+                pAllocs[i] = SHIP_ALLOC(allocSizes[i], 1);
+
+                uint8_t* pBytes = reinterpret_cast<uint8_t*>(pAllocs[i]);
+
+                for (size_t byteIndex = 0; byteIndex < allocSizes[i]; byteIndex++)
+                {
+                    pBytes[byteIndex] = threadPattern;
+                }
+            }
+
+            for (size_t i = 0; i < numAllocationsPerIteration; i++)
+            {
+                const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pAllocs[i]);
+
+                for (size_t byteIndex = 0; byteIndex < allocSizes[i]; byteIndex++)
+                {
+                    if (pBytes[byteIndex] != threadPattern)
+                    {
+                        *pAllocationsAreValid = false;
+                    }
+                }
+
+                SHIP_FREE(pAllocs[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test GlobalAllocator thread-local cache", "[Allocator]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(true);
+
+    SECTION("allocations are reused by the same thread")
+    {
+        void* pAlloc1 = SHIP_ALLOC(8, 1);
+        SHIP_FREE(pAlloc1);
+
+        void* pAlloc2 = SHIP_ALLOC(16, 1);
+        SHIP_FREE(pAlloc2);
+
+        REQUIRE(pAlloc1 == pAlloc2);
+    }
+
+    SECTION("allocations don't overlap")
+    {
+        const size_t numAllocs = 256;
+        void* pAllocs[numAllocs];
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            pAllocs[i] = SHIP_ALLOC(1 + (i % 32), 1);
+        }
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            for (size_t j = i + 1; j < numAllocs; j++)
+            {
+                REQUIRE(AllocsAreDontOverlap(pAllocs[i], 1 + (i % 32), pAllocs[j], 1 + (j % 32)));
+            }
+        }
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            SHIP_FREE(pAllocs[i]);
+        }
+    }
+
+    SECTION("aligned allocations")
+    {
+        void* pAlloc1 = SHIP_ALLOC(4, 4);
+        void* pAlloc2 = SHIP_ALLOC(24, 16);
+        void* pAlloc3 = SHIP_ALLOC(24, 64);
+
+        REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc1), 4));
+        REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc2), 16));
+        REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc3), 64));
+
+        SHIP_FREE(pAlloc1);
+        SHIP_FREE(pAlloc2);
+        SHIP_FREE(pAlloc3);
+    }
+
+    SECTION("allocations freed from another thread")
+    {
+        const size_t numAllocs = 256;
+        void* pAllocs[numAllocs];
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            pAllocs[i] = SHIP_ALLOC(16, 1);
+        }
+
+        std::thread deallocationThread([&pAllocs]()
+        {
+            for (size_t i = 0; i < numAllocs; i++)
+            {
+                SHIP_FREE(pAllocs[i]);
+            }
+        });
+
+        deallocationThread.join();
+
+        void* pAlloc = SHIP_ALLOC(16, 1);
+        REQUIRE(pAlloc != nullptr);
+        SHIP_FREE(pAlloc);
+    }
+
+    SECTION("allocations from multiple threads")
+    {
+        const size_t numThreads = 8;
+        const size_t numIterations = 2000;
+        const size_t numAllocationsPerIteration = 48;
+
+        std::thread threads[numThreads];
+        bool allocationsAreValid[numThreads];
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i] = std::thread(GlobalAllocatorTestThreadFunction, uint8_t(i + 1), numIterations, numAllocationsPerIteration, &allocationsAreValid[i]);
+        }
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i].join();
+
+            REQUIRE(allocationsAreValid[i]);
+        }
+    }
+
+    Shipyard::GetGlobalAllocator().FlushThreadLocalCache();
+}
+
+TEST_CASE("Benchmark GlobalAllocator thread-local cache", "[.][Benchmark][Allocator]")
+{
+    const size_t numThreads = 8;
+    const size_t numIterations = 20000;
+    const size_t numAllocationsPerIteration = 16;
+
+    auto runThreads = [&]()
+    {
+        std::thread threads[numThreads];
+        bool allocationsAreValid[numThreads];
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i] = std::thread(GlobalAllocatorTestThreadFunction, uint8_t(i + 1), numIterations, numAllocationsPerIteration, &allocationsAreValid[i]);
+        }
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i].join();
+        }
+    };
+
+    {
+        Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(false);
+
+        BENCHMARK("8 threads small allocations without thread-local cache")
+        {
+            runThreads();
+        }
+    }
+
+    {
+        Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(true);
+
+        BENCHMARK("8 threads small allocations with thread-local cache")
+        {
+            runThreads();
+        }
+    }
+}
+
+TEST_CASE("Test GlobalAllocator routing", "[Allocator]")
+{
+    // Allocators' maximum sizes aren't multiples of the size class granularity, and their heaps don't come from a single block.
+    const size_t chunkSizes[] = { 16, 32, 128, 8192 };
+    const size_t maxAllocationSizes[] = { 12, 20, 100, 5000 };
+    const size_t numPoolAllocators = sizeof(chunkSizes) / sizeof(chunkSizes[0]);
+    const size_t numChunks = 64;
+
+    Shipyard::ScoppedBuffer fixedHeapBuffer(1024 * 1024);
+    Shipyard::ScoppedBuffer poolBuffer0(numChunks * chunkSizes[0] + chunkSizes[0], chunkSizes[0]);
+    Shipyard::ScoppedBuffer poolBuffer1(numChunks * chunkSizes[1] + chunkSizes[1], chunkSizes[1]);
+    Shipyard::ScoppedBuffer poolBuffer2(numChunks * chunkSizes[2] + chunkSizes[2], chunkSizes[2]);
+    Shipyard::ScoppedBuffer poolBuffer3(numChunks * chunkSizes[3] + chunkSizes[3], chunkSizes[3]);
+
+    void* pPoolHeaps[numPoolAllocators] = { poolBuffer0.pBuffer, poolBuffer1.pBuffer, poolBuffer2.pBuffer, poolBuffer3.pBuffer };
+
+    Shipyard::PoolAllocator poolAllocators[numPoolAllocators];
+    Shipyard::FixedHeapAllocator fixedHeapAllocator;
+
+    Shipyard::GlobalAllocator::AllocatorInitEntry initEntries[numPoolAllocators + 1];
+
+    for (size_t i = 0; i < numPoolAllocators; i++)
+    {
+        poolAllocators[i].Create(pPoolHeaps[i], numChunks, chunkSizes[i]);
+
+        initEntries[i].pAllocator = &poolAllocators[i];
+        initEntries[i].maxAllocationSize = maxAllocationSizes[i];
+    }
+
+    fixedHeapAllocator.Create(fixedHeapBuffer.pBuffer, 1024 * 1024);
+
+    initEntries[numPoolAllocators].pAllocator = &fixedHeapAllocator;
+
+    Shipyard::GlobalAllocator& globalAllocator = Shipyard::GetGlobalAllocator();
+    globalAllocator.Create(initEntries, uint32_t(numPoolAllocators + 1));
+
+    auto isInHeap = [](void* pAlloc, Shipyard::BaseAllocator& allocator)
+    {
+        return (size_t(pAlloc) >= size_t(allocator.GetHeap()) && size_t(pAlloc) < size_t(allocator.GetHeap()) + allocator.GetHeapSize());
+    };
+
+    SECTION("allocations are routed to the smallest allocator that fits")
+    {
+        const size_t allocSizes[] = { 0, 1, 8, 12, 13, 16, 20, 21, 100, 101, 4096, 4097, 5000, 5001, 100000 };
+        const size_t expectedAllocators[] = { 0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 3, 3, 3, 4, 4 };
+
+        for (size_t i = 0; i < sizeof(allocSizes) / sizeof(allocSizes[0]); i++)
+        {
+            void* pAlloc = SHIP_ALLOC(allocSizes[i], 1);
+
+            Shipyard::BaseAllocator& expectedAllocator = (expectedAllocators[i] < numPoolAllocators) ?
+                    static_cast<Shipyard::BaseAllocator&>(poolAllocators[expectedAllocators[i]]) :
+                    static_cast<Shipyard::BaseAllocator&>(fixedHeapAllocator);
+
+            REQUIRE(isInHeap(pAlloc, expectedAllocator));
+
+            SHIP_FREE(pAlloc);
+
+            // Freeing must have given back the chunk to the right allocator.
+            void* pSameAlloc = SHIP_ALLOC(allocSizes[i], 1);
+            REQUIRE(pSameAlloc == pAlloc);
+
+            SHIP_FREE(pSameAlloc);
+        }
+    }
+
+    SECTION("full allocators fall back to the next ones")
+    {
+        void* pAllocs[numChunks + 1];
+
+        for (size_t i = 0; i < numChunks + 1; i++)
+        {
+            pAllocs[i] = SHIP_ALLOC(12, 1);
+        }
+
+        REQUIRE(isInHeap(pAllocs[numChunks - 1], poolAllocators[0]));
+        REQUIRE(isInHeap(pAllocs[numChunks], poolAllocators[1]));
+
+        for (size_t i = 0; i < numChunks + 1; i++)
+        {
+            SHIP_FREE(pAllocs[i]);
+        }
+    }
+
+    globalAllocator.Destroy();
+
+    fixedHeapAllocator.Destroy();
+
+    for (size_t i = 0; i < numPoolAllocators; i++)
+    {
+        poolAllocators[i].Destroy();
+    }
+}
+
+namespace
+{
+    // Small deterministic random generator, so that failures can be reproduced.
+    struct TestRandom
+    {
+        uint64_t state = 0x853c49e6748fea9bULL;
+
+        uint32_t Next()
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return uint32_t(state >> 33);
+        }
+    };
+
+    struct TestAllocation
+    {
+        void* pAlloc = nullptr;
+        size_t size = 0;
+        uint8_t pattern = 0;
+    };
+
+    bool FillAndCheckRandomAllocations(Shipyard::BaseAllocator& allocator, size_t numOperations, size_t maxAllocSize)
+    {
+        const size_t numSlots = 256;
+        TestAllocation allocations[numSlots];
+
+        TestRandom random;
+        bool allocationsAreValid = true;
+
+        for (size_t operation = 0; operation < numOperations; operation++)
+        {
+            TestAllocation& allocation = allocations[random.Next() % numSlots];
+
+            if (allocation.pAlloc != nullptr)
+            {
+                const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(allocation.pAlloc);
+
+                for (size_t byteIndex = 0; byteIndex < allocation.size; byteIndex++)
+                {
+                    allocationsAreValid = allocationsAreValid && (pBytes[byteIndex] == allocation.pattern);
+                }
+
+                SHIP_FREE_EX(&allocator, allocation.pAlloc);
+                allocation.pAlloc = nullptr;
+            }
+            else
+            {
+                size_t alignment = size_t(1) << (random.Next() % 8);
+
+                allocation.size = 1 + random.Next() % maxAllocSize;
+                allocation.pattern = uint8_t(operation);
+                allocation.pAlloc = SHIP_ALLOC_EX(&allocator, allocation.size, alignment);
+
+                if (allocation.pAlloc != nullptr)
+                {
+                    allocationsAreValid = allocationsAreValid && Shipyard::MemoryUtils::IsAddressAligned(size_t(allocation.pAlloc), alignment);
+
+                    uint8_t* pBytes = reinterpret_cast<uint8_t*>(allocation.pAlloc);
+
+                    for (size_t byteIndex = 0; byteIndex < allocation.size; byteIndex++)
+                    {
+                        pBytes[byteIndex] = allocation.pattern;
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < numSlots; i++)
+        {
+            if (allocations[i].pAlloc != nullptr)
+            {
+                SHIP_FREE_EX(&allocator, allocations[i].pAlloc);
+            }
+        }
+
+        return allocationsAreValid;
+    }
+}
+
+TEST_CASE("Test TLSFAllocator", "[Allocator]")
+{
+    Shipyard::TLSFAllocator tlsfAllocator;
+
+    SECTION("simple allocation")
+    {
+        const size_t heapSize = 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 100, 1);
+
+        REQUIRE(pAlloc != nullptr);
+        REQUIRE(size_t(pAlloc) >= size_t(scoppedBuffer.pBuffer));
+        REQUIRE(size_t(pAlloc) + 100 <= size_t(scoppedBuffer.pBuffer) + heapSize);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 1);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numUserBytesAllocated >= 100);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&tlsfAllocator, pAlloc);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBytesUsed == 0);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("aligned allocations")
+    {
+        const size_t heapSize = 64 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAllocs[12];
+
+        for (size_t i = 0; i < 12; i++)
+        {
+            size_t alignment = size_t(1) << i;
+
+            pAllocs[i] = SHIP_ALLOC_EX(&tlsfAllocator, 24, alignment);
+
+            REQUIRE(pAllocs[i] != nullptr);
+            REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAllocs[i]), alignment));
+        }
+
+        for (size_t i = 0; i < 12; i++)
+        {
+            for (size_t j = i + 1; j < 12; j++)
+            {
+                REQUIRE(AllocsAreDontOverlap(pAllocs[i], 24, pAllocs[j], 24));
+            }
+        }
+
+        for (size_t i = 0; i < 12; i++)
+        {
+            SHIP_FREE_EX(&tlsfAllocator, pAllocs[i]);
+        }
+    }
+
+    SECTION("freed blocks are merged")
+    {
+        const size_t heapSize = 4096;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAllocs[32];
+        size_t numAllocs = 0;
+
+        for (; numAllocs < 32; numAllocs++)
+        {
+            pAllocs[numAllocs] = SHIP_ALLOC_EX(&tlsfAllocator, 64, 8);
+            if (pAllocs[numAllocs] == nullptr)
+            {
+                break;
+            }
+        }
+
+        REQUIRE(numAllocs > 16);
+
+        // Free every other block first, so that merging happens with both neighbors.
+        for (size_t i = 0; i < numAllocs; i += 2)
+        {
+            SHIP_FREE_EX(&tlsfAllocator, pAllocs[i]);
+        }
+
+        for (size_t i = 1; i < numAllocs; i += 2)
+        {
+            SHIP_FREE_EX(&tlsfAllocator, pAllocs[i]);
+        }
+
+        // The whole heap is a single block again.
+        void* pBigAlloc = SHIP_ALLOC_EX(&tlsfAllocator, heapSize - 64, 8);
+        REQUIRE(pBigAlloc != nullptr);
+
+        SHIP_FREE_EX(&tlsfAllocator, pBigAlloc);
+    }
+
+    SECTION("out of memory")
+    {
+        const size_t heapSize = 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        REQUIRE(SHIP_ALLOC_EX(&tlsfAllocator, heapSize, 1) == nullptr);
+        REQUIRE(SHIP_ALLOC_EX(&tlsfAllocator, size_t(-1) / 2, 1) == nullptr);
+    }
+
+    SECTION("random allocations")
+    {
+        const size_t heapSize = 1024 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        REQUIRE(FillAndCheckRandomAllocations(tlsfAllocator, 100000, 4096));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBytesUsed == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("fallback allocator of the GlobalAllocator")
+    {
+        const size_t heapSize = 1024 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        Shipyard::GlobalAllocator::AllocatorInitEntry initEntry;
+        initEntry.pAllocator = &tlsfAllocator;
+
+        Shipyard::GlobalAllocator& globalAllocator = Shipyard::GetGlobalAllocator();
+        globalAllocator.Create(&initEntry, 1);
+
+        REQUIRE(FillAndCheckRandomAllocations(globalAllocator, 10000, 1024));
+
+        globalAllocator.Destroy();
+    }
+
+    tlsfAllocator.Destroy();
+}
+
+namespace
+{
+    struct AllocatorLatencies
+    {
+        double percentile50;
+        double percentile99;
+        double percentile999;
+        double maximum;
+    };
+
+    // Allocates and frees randomly sized blocks until the heap is fragmented, and measures the latency of each allocation.
+    // Returns the largest allocation that can still succeed afterwards, which tells how fragmented the free memory is.
+    size_t MeasureAllocatorFragmentationAndLatencies(Shipyard::BaseAllocator& allocator, size_t numOperations, AllocatorLatencies& latencies)
+    {
+        const size_t numSlots = 4096;
+        std::vector<void*> allocations(numSlots, nullptr);
+        std::vector<double> allocationTimes;
+        allocationTimes.reserve(numOperations);
+
+        TestRandom random;
+
+        for (size_t operation = 0; operation < numOperations; operation++)
+        {
+            void*& pAlloc = allocations[random.Next() % numSlots];
+
+            if (pAlloc != nullptr)
+            {
+                SHIP_FREE_EX(&allocator, pAlloc);
+                pAlloc = nullptr;
+            }
+            else
+            {
+                // Mostly small allocations, with the occasional large one.
+                size_t size = ((random.Next() % 16) == 0) ? (1024 + random.Next() % 16384) : (16 + random.Next() % 256);
+
+                auto start = std::chrono::high_resolution_clock::now();
+                pAlloc = SHIP_ALLOC_EX(&allocator, size, 8);
+                auto end = std::chrono::high_resolution_clock::now();
+
+                allocationTimes.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+
+        // Free every other live allocation to leave holes behind.
+        for (size_t i = 0; i < numSlots; i += 2)
+        {
+            if (allocations[i] != nullptr)
+            {
+                SHIP_FREE_EX(&allocator, allocations[i]);
+                allocations[i] = nullptr;
+            }
+        }
+
+        size_t largestAllocationSize = 0;
+
+        for (size_t size = size_t(1) << 30; size >= 16; size /= 2)
+        {
+            void* pAlloc = SHIP_ALLOC_EX(&allocator, largestAllocationSize + size, 8);
+            if (pAlloc != nullptr)
+            {
+                largestAllocationSize += size;
+                SHIP_FREE_EX(&allocator, pAlloc);
+            }
+        }
+
+        for (size_t i = 0; i < numSlots; i++)
+        {
+            if (allocations[i] != nullptr)
+            {
+                SHIP_FREE_EX(&allocator, allocations[i]);
+            }
+        }
+
+        std::sort(allocationTimes.begin(), allocationTimes.end());
+
+        latencies.percentile50 = allocationTimes[allocationTimes.size() / 2];
+        latencies.percentile99 = allocationTimes[allocationTimes.size() * 99 / 100];
+        latencies.percentile999 = allocationTimes[allocationTimes.size() * 999 / 1000];
+        latencies.maximum = allocationTimes.back();
+
+        return largestAllocationSize;
+    }
+}
+
+TEST_CASE("Benchmark TLSFAllocator", "[.][Benchmark][Allocator]")
+{
+    const size_t heapSize = 64 * 1024 * 1024;
+    const size_t numOperations = 1000000;
+
+    Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+    AllocatorLatencies fixedHeapLatencies;
+    AllocatorLatencies tlsfLatencies;
+
+    size_t fixedHeapLargestAllocation = 0;
+    size_t tlsfLargestAllocation = 0;
+
+    {
+        Shipyard::FixedHeapAllocator fixedHeapAllocator;
+        fixedHeapAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        BENCHMARK("FixedHeapAllocator random allocations")
+        {
+            fixedHeapLargestAllocation = MeasureAllocatorFragmentationAndLatencies(fixedHeapAllocator, numOperations, fixedHeapLatencies);
+        }
+
+        fixedHeapAllocator.Destroy();
+    }
+
+    {
+        Shipyard::TLSFAllocator tlsfAllocator;
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        BENCHMARK("TLSFAllocator random allocations")
+        {
+            tlsfLargestAllocation = MeasureAllocatorFragmentationAndLatencies(tlsfAllocator, numOperations, tlsfLatencies);
+        }
+
+        tlsfAllocator.Destroy();
+    }
+
+    WARN("FixedHeapAllocator allocation latency (ns): p50 " << fixedHeapLatencies.percentile50 << ", p99 " << fixedHeapLatencies.percentile99
+            << ", p99.9 " << fixedHeapLatencies.percentile999 << ", max " << fixedHeapLatencies.maximum
+            << ". Largest allocation after fragmentation: " << fixedHeapLargestAllocation << " bytes");
+
+    WARN("TLSFAllocator allocation latency (ns): p50 " << tlsfLatencies.percentile50 << ", p99 " << tlsfLatencies.percentile99
+            << ", p99.9 " << tlsfLatencies.percentile999 << ", max " << tlsfLatencies.maximum
+            << ". Largest allocation after fragmentation: " << tlsfLargestAllocation << " bytes");
+}
+
+TEST_CASE("Test SmallObjectAllocator", "[Allocator]")
+{
+    Shipyard::SmallObjectAllocator smallObjectAllocator;
+
+    const size_t pageSize = Shipyard::SmallObjectAllocator::ms_PageSize;
+
+    SECTION("size classes")
+    {
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(0) == 8);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(1) == 8);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(8) == 8);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(9) == 16);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(49) == 64);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(65) == 80);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(161) == 192);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(256) == 256);
+        REQUIRE(Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(257) == 0);
+    }
+
+    SECTION("simple allocation")
+    {
+        const size_t heapSize = 8 * pageSize;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        REQUIRE(smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize));
+
+        void* pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 20, 1);
+
+        REQUIRE(pAlloc != nullptr);
+        REQUIRE(size_t(pAlloc) >= size_t(scoppedBuffer.pBuffer));
+        REQUIRE(size_t(pAlloc) + 20 <= size_t(scoppedBuffer.pBuffer) + heapSize);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numBlocksAllocated == 1);
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numUserBytesAllocated == 24);
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numPagesUsed == 1);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        // Freed blocks are given back first.
+        void* pSameAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 24, 1);
+        REQUIRE(pSameAlloc == pAlloc);
+
+        SHIP_FREE_EX(&smallObjectAllocator, pSameAlloc);
+
+        REQUIRE(SHIP_ALLOC_EX(&smallObjectAllocator, 257, 1) == nullptr);
+    }
+
+    SECTION("size classes don't share pages")
+    {
+        const size_t heapSize = 8 * pageSize;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAlloc8 = SHIP_ALLOC_EX(&smallObjectAllocator, 8, 1);
+        void* pAlloc16 = SHIP_ALLOC_EX(&smallObjectAllocator, 16, 1);
+        void* pOtherAlloc8 = SHIP_ALLOC_EX(&smallObjectAllocator, 7, 1);
+
+        REQUIRE(size_t(pAlloc8) / pageSize != size_t(pAlloc16) / pageSize);
+        REQUIRE(size_t(pAlloc8) / pageSize == size_t(pOtherAlloc8) / pageSize);
+        REQUIRE(AllocsAreDontOverlap(pAlloc8, 8, pOtherAlloc8, 8));
+
+        SHIP_FREE_EX(&smallObjectAllocator, pAlloc8);
+        SHIP_FREE_EX(&smallObjectAllocator, pAlloc16);
+        SHIP_FREE_EX(&smallObjectAllocator, pOtherAlloc8);
+    }
+
+    SECTION("aligned allocations")
+    {
+        const size_t heapSize = 16 * pageSize;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        for (size_t alignment = 1; alignment <= 256; alignment *= 2)
+        {
+            void* pAllocs[3];
+
+            for (void*& pAlloc : pAllocs)
+            {
+                pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 24, alignment);
+
+                REQUIRE(pAlloc != nullptr);
+                REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc), alignment));
+            }
+
+            for (void* pAlloc : pAllocs)
+            {
+                SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+            }
+        }
+
+        REQUIRE(SHIP_ALLOC_EX(&smallObjectAllocator, 8, 512) == nullptr);
+    }
+
+    SECTION("in-place reallocation")
+    {
+        const size_t heapSize = 8 * pageSize;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 20, 1);
+
+        REQUIRE(smallObjectAllocator.TryExpandInPlace(pAlloc, 20, 24));
+        REQUIRE(!smallObjectAllocator.TryExpandInPlace(pAlloc, 24, 25));
+
+        SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+    }
+
+    SECTION("empty pages are reused by other size classes")
+    {
+        const size_t numPages = 4;
+        const size_t heapSize = numPages * pageSize + numPages * 64 + pageSize;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        std::vector<void*> allocs;
+
+        for (void* pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 16, 1); pAlloc != nullptr; pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 16, 1))
+        {
+            allocs.push_back(pAlloc);
+        }
+
+        REQUIRE(allocs.size() >= numPages * pageSize / 16);
+        REQUIRE(SHIP_ALLOC_EX(&smallObjectAllocator, 256, 1) == nullptr);
+
+        for (void* pAlloc : allocs)
+        {
+            SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        // The last page of a size class is kept around.
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numPagesUsed == 1);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        size_t numAllocs = allocs.size();
+        allocs.clear();
+
+        for (void* pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 256, 1); pAlloc != nullptr; pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, 256, 1))
+        {
+            allocs.push_back(pAlloc);
+        }
+
+        REQUIRE(allocs.size() == (numAllocs / (pageSize / 16) - 1) * (pageSize / 256));
+
+        for (void* pAlloc : allocs)
+        {
+            SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+        }
+    }
+
+    SECTION("random allocations")
+    {
+        const size_t heapSize = 1024 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        REQUIRE(FillAndCheckRandomAllocations(smallObjectAllocator, 100000, Shipyard::SmallObjectAllocator::ms_MaxAllocationSize));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("allocations from multiple threads")
+    {
+        const size_t numThreads = 8;
+        const size_t numIterations = 2000;
+        const size_t numAllocationsPerIteration = 32;
+        const size_t heapSize = 4 * 1024 * 1024;
+
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        // Threads share some size classes, and each uses a few of them to move pages between classes.
+        auto threadFunction = [&](uint8_t threadPattern, bool* pAllocationsAreValid)
+        {
+            void* pAllocs[numAllocationsPerIteration];
+            size_t allocSizes[numAllocationsPerIteration];
+
+            *pAllocationsAreValid = true;
+
+            for (size_t iteration = 0; iteration < numIterations; iteration++)
+            {
+                for (size_t i = 0; i < numAllocationsPerIteration; i++)
+                {
+                    allocSizes[i] = 1 + (threadPattern * 37 + iteration * 13 + i * 7) % Shipyard::SmallObjectAllocator::ms_MaxAllocationSize;
+                    pAllocs[i] = SHIP_ALLOC_EX(&smallObjectAllocator, allocSizes[i], 1);
+
+                    if (pAllocs[i] == nullptr)
+                    {
+                        *pAllocationsAreValid = false;
+                        return;
+                    }
+
+                    memset(pAllocs[i], threadPattern, allocSizes[i]);
+                }
+
+                for (size_t i = 0; i < numAllocationsPerIteration; i++)
+                {
+                    const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(pAllocs[i]);
+
+                    for (size_t byteIndex = 0; byteIndex < allocSizes[i]; byteIndex++)
+                    {
+                        if (pBytes[byteIndex] != threadPattern)
+                        {
+                            *pAllocationsAreValid = false;
+                        }
+                    }
+
+                    SHIP_FREE_EX(&smallObjectAllocator, pAllocs[i]);
+                }
+            }
+        };
+
+        std::thread threads[numThreads];
+        bool allocationsAreValid[numThreads];
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i] = std::thread(threadFunction, uint8_t(i + 1), &allocationsAreValid[i]);
+        }
+
+        for (size_t i = 0; i < numThreads; i++)
+        {
+            threads[i].join();
+
+            REQUIRE(allocationsAreValid[i]);
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(smallObjectAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    SECTION("allocator of the GlobalAllocator")
+    {
+        const size_t heapSize = 1024 * 1024;
+        Shipyard::ScoppedBuffer smallObjectBuffer(heapSize);
+        Shipyard::ScoppedBuffer tlsfBuffer(heapSize, 8);
+
+        smallObjectAllocator.Create(smallObjectBuffer.pBuffer, heapSize);
+
+        Shipyard::TLSFAllocator tlsfAllocator;
+        tlsfAllocator.Create(tlsfBuffer.pBuffer, heapSize);
+
+        Shipyard::GlobalAllocator::AllocatorInitEntry initEntries[2];
+        initEntries[0].pAllocator = &smallObjectAllocator;
+        initEntries[0].maxAllocationSize = Shipyard::SmallObjectAllocator::ms_MaxAllocationSize;
+        initEntries[1].pAllocator = &tlsfAllocator;
+
+        Shipyard::GlobalAllocator& globalAllocator = Shipyard::GetGlobalAllocator();
+        globalAllocator.Create(initEntries, 2);
+
+        void* pSmallAlloc = SHIP_ALLOC(200, 8);
+        void* pBigAlloc = SHIP_ALLOC(300, 8);
+
+        REQUIRE(size_t(pSmallAlloc) >= size_t(smallObjectBuffer.pBuffer));
+        REQUIRE(size_t(pSmallAlloc) < size_t(smallObjectBuffer.pBuffer) + heapSize);
+        REQUIRE(size_t(pBigAlloc) >= size_t(tlsfBuffer.pBuffer));
+        REQUIRE(size_t(pBigAlloc) < size_t(tlsfBuffer.pBuffer) + heapSize);
+
+        SHIP_FREE(pSmallAlloc);
+        SHIP_FREE(pBigAlloc);
+
+        REQUIRE(FillAndCheckRandomAllocations(globalAllocator, 10000, 1024));
+
+        globalAllocator.Destroy();
+        tlsfAllocator.Destroy();
+    }
+
+    smallObjectAllocator.Destroy();
+}
+
+namespace
+{
+    // Keeps a large set of small allocations alive, whose sizes slowly drift from the smallest to the biggest size classes
+    // like a program going through different phases. Returns the peak number of bytes allocated in each size class.
+    template <typename AllocateFunction, typename DeallocateFunction>
+    void RunSmallObjectWorkload(size_t numOperations, AllocateFunction allocate, DeallocateFunction deallocate, size_t* pPeakBytesPerBlockSize)
+    {
+        const size_t numSlots = 16384;
+        const size_t maxAllocationSize = Shipyard::SmallObjectAllocator::ms_MaxAllocationSize;
+        const size_t sizeWindow = 64;
+
+        std::vector<void*> allocations(numSlots, nullptr);
+        std::vector<size_t> allocationSizes(numSlots, 0);
+        size_t bytesPerBlockSize[maxAllocationSize + 1] = {};
+
+        TestRandom random;
+
+        for (size_t operation = 0; operation < numOperations; operation++)
+        {
+            size_t slot = random.Next() % numSlots;
+            size_t blockSize = Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(allocationSizes[slot]);
+
+            if (allocations[slot] != nullptr)
+            {
+                deallocate(allocations[slot], allocationSizes[slot]);
+                allocations[slot] = nullptr;
+
+                bytesPerBlockSize[blockSize] -= blockSize;
+            }
+            else
+            {
+                size_t smallestSize = operation * (maxAllocationSize - sizeWindow) / numOperations;
+
+                allocationSizes[slot] = smallestSize + 1 + random.Next() % sizeWindow;
+                allocations[slot] = allocate(allocationSizes[slot]);
+
+                blockSize = Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(allocationSizes[slot]);
+                bytesPerBlockSize[blockSize] += blockSize;
+
+                pPeakBytesPerBlockSize[blockSize] = std::max(pPeakBytesPerBlockSize[blockSize], bytesPerBlockSize[blockSize]);
+            }
+        }
+
+        for (size_t slot = 0; slot < numSlots; slot++)
+        {
+            if (allocations[slot] != nullptr)
+            {
+                deallocate(allocations[slot], allocationSizes[slot]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Benchmark SmallObjectAllocator", "[.][Benchmark][Allocator]")
+{
+    const size_t numOperations = 2000000;
+    const size_t maxAllocationSize = Shipyard::SmallObjectAllocator::ms_MaxAllocationSize;
+    const size_t pageSize = Shipyard::SmallObjectAllocator::ms_PageSize;
+
+    size_t peakBytesPerBlockSize[maxAllocationSize + 1] = {};
+    size_t smallObjectHighestAddress = 0;
+
+    {
+        const size_t heapSize = 16 * 1024 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        Shipyard::SmallObjectAllocator smallObjectAllocator;
+        smallObjectAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        BENCHMARK("SmallObjectAllocator drifting small allocations")
+        {
+            RunSmallObjectWorkload(
+                    numOperations,
+                    [&](size_t size)
+                    {
+                        void* pAlloc = SHIP_ALLOC_EX(&smallObjectAllocator, size, 1);
+                        smallObjectHighestAddress = std::max(smallObjectHighestAddress, size_t(pAlloc) + size);
+                        return pAlloc;
+                    },
+                    [&](void* pAlloc, size_t)
+                    {
+                        SHIP_FREE_EX(&smallObjectAllocator, pAlloc);
+                    },
+                    peakBytesPerBlockSize);
+        }
+
+        smallObjectHighestAddress -= size_t(scoppedBuffer.pBuffer);
+
+        smallObjectAllocator.Destroy();
+    }
+
+    {
+        // One pool per size class, each big enough to hold every live allocation.
+        const size_t numChunksPerPool = 16384;
+
+        std::vector<size_t> blockSizes;
+        for (size_t size = 1; size <= maxAllocationSize; size++)
+        {
+            size_t blockSize = Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(size);
+            if (blockSizes.empty() || blockSizes.back() != blockSize)
+            {
+                blockSizes.push_back(blockSize);
+            }
+        }
+
+        size_t poolsHeapSize = 0;
+        for (size_t blockSize : blockSizes)
+        {
+            poolsHeapSize += numChunksPerPool * blockSize + blockSize;
+        }
+
+        Shipyard::ScoppedBuffer scoppedBuffer(poolsHeapSize);
+
+        std::vector<Shipyard::PoolAllocator> poolAllocators(blockSizes.size());
+        Shipyard::PoolAllocator* pPoolAllocatorPerBlockSize[maxAllocationSize + 1] = {};
+
+        size_t poolHeapAddress = size_t(scoppedBuffer.pBuffer);
+
+        for (size_t i = 0; i < blockSizes.size(); i++)
+        {
+            poolHeapAddress = Shipyard::MemoryUtils::AlignAddress(poolHeapAddress, blockSizes[i]);
+            poolAllocators[i].Create(reinterpret_cast<void*>(poolHeapAddress), numChunksPerPool, blockSizes[i]);
+            poolHeapAddress += numChunksPerPool * blockSizes[i];
+
+            pPoolAllocatorPerBlockSize[blockSizes[i]] = &poolAllocators[i];
+        }
+
+        size_t poolPeakBytesPerBlockSize[maxAllocationSize + 1] = {};
+
+        BENCHMARK("PoolAllocator per size class drifting small allocations")
+        {
+            RunSmallObjectWorkload(
+                    numOperations,
+                    [&](size_t size)
+                    {
+                        return SHIP_ALLOC_EX(pPoolAllocatorPerBlockSize[Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(size)], size, 1);
+                    },
+                    [&](void* pAlloc, size_t size)
+                    {
+                        SHIP_FREE_EX(pPoolAllocatorPerBlockSize[Shipyard::SmallObjectAllocator::GetSizeClassBlockSize(size)], pAlloc);
+                    },
+                    poolPeakBytesPerBlockSize);
+        }
+
+        for (size_t i = 0; i < blockSizes.size(); i++)
+        {
+            poolAllocators[i].Destroy();
+        }
+    }
+
+    // Pools must each be sized for the peak of their own size class, while pages of the SmallObjectAllocator go from one
+    // size class to the other as the program needs them.
+    size_t poolBytesNeeded = 0;
+
+    for (size_t blockSize = 0; blockSize <= maxAllocationSize; blockSize++)
+    {
+        poolBytesNeeded += peakBytesPerBlockSize[blockSize];
+    }
+
+    WARN("Memory needed by one PoolAllocator per size class: " << poolBytesNeeded << " bytes. Memory used by the SmallObjectAllocator: "
+            << smallObjectHighestAddress << " bytes (" << (smallObjectHighestAddress / pageSize) << " pages)");
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+TEST_CASE("Test DebugAllocator", "[Allocator]")
+{
+    Shipyard::DebugAllocator& debugAllocator = Shipyard::DebugAllocator::GetInstance();
+
+    const size_t debugHeapSize = 1024 * 1024;
+    Shipyard::ScoppedBuffer debugBuffer(debugHeapSize, 8);
+
+    const size_t heapSize = 4 * 1024 * 1024;
+    Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+    Shipyard::TLSFAllocator tlsfAllocator;
+    tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+    REQUIRE(debugAllocator.Create(debugBuffer.pBuffer, debugHeapSize));
+
+    SECTION("allocations are found by address")
+    {
+        const size_t numAllocs = 10000;
+        std::vector<void*> allocs(numAllocs);
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            allocs[i] = SHIP_ALLOC_EX(&tlsfAllocator, 16 + i % 64, 8);
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == numAllocs);
+
+        // Free in an order unrelated to the table's, so that entries have to be moved back on removal.
+        TestRandom random;
+        for (size_t i = numAllocs - 1; i > 0; i--)
+        {
+            std::swap(allocs[i], allocs[random.Next() % (i + 1)]);
+        }
+
+        for (size_t i = 0; i < numAllocs; i++)
+        {
+            SHIP_FREE_EX(&tlsfAllocator, allocs[i]);
+
+            REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == numAllocs - i - 1);
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numBytesAllocated == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numUntrackedAllocations == 0);
+    }
+
+    SECTION("statistics per call site")
+    {
+        const int firstCallSiteLine = __LINE__ + 4;
+        void* pFirstAllocs[4];
+        for (void*& pAlloc : pFirstAllocs)
+        {
+            pAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 64, 8);
+        }
+
+        const int secondCallSiteLine = __LINE__ + 1;
+        void* pSecondAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 1000, 8);
+
+        Shipyard::DebugAllocator::CallSiteStatistics firstCallSite;
+        Shipyard::DebugAllocator::CallSiteStatistics secondCallSite;
+
+        REQUIRE(debugAllocator.GetCallSiteStatistics(__FILE__, firstCallSiteLine, firstCallSite));
+        REQUIRE(debugAllocator.GetCallSiteStatistics(__FILE__, secondCallSiteLine, secondCallSite));
+        REQUIRE(!debugAllocator.GetCallSiteStatistics(__FILE__, __LINE__, secondCallSite));
+
+        REQUIRE(firstCallSite.numLiveAllocations == 4);
+        REQUIRE(firstCallSite.numAllocations == 4);
+        REQUIRE(firstCallSite.numLiveBytes >= 4 * 64);
+        REQUIRE(firstCallSite.peakLiveBytes == firstCallSite.numLiveBytes);
+        REQUIRE(secondCallSite.numLiveAllocations == 1);
+        REQUIRE(secondCallSite.numLiveBytes >= 1000);
+
+        size_t peakLiveBytes = firstCallSite.peakLiveBytes;
+
+        SHIP_FREE_EX(&tlsfAllocator, pFirstAllocs[0]);
+        SHIP_FREE_EX(&tlsfAllocator, pFirstAllocs[1]);
+
+        REQUIRE(debugAllocator.GetCallSiteStatistics(__FILE__, firstCallSiteLine, firstCallSite));
+        REQUIRE(firstCallSite.numLiveAllocations == 2);
+        REQUIRE(firstCallSite.numAllocations == 4);
+        REQUIRE(firstCallSite.numLiveBytes < peakLiveBytes);
+        REQUIRE(firstCallSite.peakLiveBytes == peakLiveBytes);
+
+        // Growing in place is accounted to the call site that allocated the memory.
+        size_t secondAllocSize = secondCallSite.numLiveBytes;
+        if (tlsfAllocator.TryExpandInPlace(pSecondAlloc, secondAllocSize, secondAllocSize + 1000))
+        {
+            REQUIRE(debugAllocator.GetCallSiteStatistics(__FILE__, secondCallSiteLine, secondCallSite));
+            REQUIRE(secondCallSite.numLiveBytes >= secondAllocSize + 1000);
+            REQUIRE(secondCallSite.peakLiveBytes == secondCallSite.numLiveBytes);
+        }
+
+        SHIP_FREE_EX(&tlsfAllocator, pFirstAllocs[2]);
+        SHIP_FREE_EX(&tlsfAllocator, pFirstAllocs[3]);
+        SHIP_FREE_EX(&tlsfAllocator, pSecondAlloc);
+
+        REQUIRE(debugAllocator.GetCallSiteStatistics(__FILE__, firstCallSiteLine, firstCallSite));
+        REQUIRE(firstCallSite.numLiveAllocations == 0);
+        REQUIRE(firstCallSite.numLiveBytes == 0);
+    }
+
+    SECTION("dump to CSV")
+    {
+        void* pAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 128, 8);
+        void* pOtherAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 4096, 8);
+
+        const char* pCSVFilename = "debugallocator_test.csv";
+        REQUIRE(debugAllocator.DumpCallSiteStatisticsToCSV(pCSVFilename));
+
+        SHIP_FREE_EX(&tlsfAllocator, pAlloc);
+        SHIP_FREE_EX(&tlsfAllocator, pOtherAlloc);
+
+        std::ifstream csvFile(pCSVFilename);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(csvFile, line); )
+        {
+            lines.push_back(line);
+        }
+
+        csvFile.close();
+        remove(pCSVFilename);
+
+        REQUIRE(lines.size() == 3);
+        REQUIRE(lines[0] == "File,Line,Live bytes,Live allocations,Total allocations,Peak live bytes");
+
+        // Sorted by live bytes, so the biggest allocation comes first.
+        size_t liveBytes[2] = {};
+        size_t liveAllocations[2] = {};
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            const std::string& line = lines[i + 1];
+            REQUIRE(line.find(__FILE__) != std::string::npos);
+            REQUIRE(sscanf(line.c_str() + line.rfind('"') + 1, ",%*d,%zu,%zu", &liveBytes[i], &liveAllocations[i]) == 2);
+        }
+
+        REQUIRE(liveBytes[0] >= 4096);
+        REQUIRE(liveBytes[1] >= 128);
+        REQUIRE(liveBytes[1] < 4096);
+        REQUIRE(liveAllocations[0] == 1);
+        REQUIRE(liveAllocations[1] == 1);
+    }
+
+    SECTION("allocations are untracked once the entries are all used")
+    {
+        debugAllocator.Destroy();
+
+        const size_t smallDebugHeapSize = 4096;
+        REQUIRE(debugAllocator.Create(debugBuffer.pBuffer, smallDebugHeapSize));
+
+        std::vector<void*> allocs;
+        while (debugAllocator.GetMemoryInfo().numUntrackedAllocations == 0)
+        {
+            allocs.push_back(SHIP_ALLOC_EX(&tlsfAllocator, 32, 8));
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == allocs.size() - 1);
+
+        for (void* pAlloc : allocs)
+        {
+            SHIP_FREE_EX(&tlsfAllocator, pAlloc);
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numUntrackedDeallocations == 1);
+    }
+
+    SECTION("blocks going through the GlobalAllocator's thread-local caches")
+    {
+        Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(true);
+
+        // Enough for the caches to be refilled, and to give blocks back to their allocator.
+        const size_t numAllocs = 1000;
+        std::vector<void*> allocs(numAllocs);
+
+        for (void*& pAlloc : allocs)
+        {
+            pAlloc = SHIP_ALLOC(16, 8);
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == numAllocs);
+
+        for (void* pAlloc : allocs)
+        {
+            SHIP_FREE(pAlloc);
+        }
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == 0);
+
+        Shipyard::GetGlobalAllocator().FlushThreadLocalCache();
+
+        REQUIRE(debugAllocator.GetMemoryInfo().numAllocations == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numBytesAllocated == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numUntrackedAllocations == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numUntrackedDeallocations == 0);
+        REQUIRE(debugAllocator.GetMemoryInfo().numOverwrittenAllocations == 0);
+    }
+
+    debugAllocator.Destroy();
+    tlsfAllocator.Destroy();
+}
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+TEST_CASE("Test ScratchAllocator", "[Allocator]")
+{
+    Shipyard::ScratchAllocator scratchAllocator;
+
+    SECTION("rewinding to a marker")
+    {
+        const size_t heapSize = 256;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        scratchAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pFirstAlloc = SHIP_ALLOC_EX(&scratchAllocator, 16, 8);
+
+        Shipyard::ScratchAllocator::Marker marker = scratchAllocator.GetMarker();
+
+        void* pSecondAlloc = SHIP_ALLOC_EX(&scratchAllocator, 32, 16);
+        void* pThirdAlloc = SHIP_ALLOC_EX(&scratchAllocator, 64, 8);
+
+        REQUIRE(pFirstAlloc != nullptr);
+        REQUIRE(pSecondAlloc != nullptr);
+        REQUIRE(pThirdAlloc != nullptr);
+        REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pSecondAlloc), 16));
+        REQUIRE(AllocsAreDontOverlap(pFirstAlloc, 16, pSecondAlloc, 32));
+        REQUIRE(AllocsAreDontOverlap(pSecondAlloc, 32, pThirdAlloc, 64));
+
+        scratchAllocator.RewindToMarker(marker);
+
+        REQUIRE(SHIP_ALLOC_EX(&scratchAllocator, 32, 16) == pSecondAlloc);
+    }
+
+    SECTION("only the last allocation is given back")
+    {
+        const size_t heapSize = 256;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        scratchAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pFirstAlloc = SHIP_ALLOC_EX(&scratchAllocator, 16, 8);
+        void* pSecondAlloc = SHIP_ALLOC_EX(&scratchAllocator, 16, 8);
+
+        SHIP_FREE_EX(&scratchAllocator, pFirstAlloc);
+
+        void* pThirdAlloc = SHIP_ALLOC_EX(&scratchAllocator, 16, 8);
+        REQUIRE(pThirdAlloc != pFirstAlloc);
+
+        SHIP_FREE_EX(&scratchAllocator, pThirdAlloc);
+
+        REQUIRE(SHIP_ALLOC_EX(&scratchAllocator, 16, 8) == pThirdAlloc);
+
+        // Memory allocated before a marker is kept until rewinding to it.
+        Shipyard::ScratchAllocator::Marker marker = scratchAllocator.GetMarker();
+
+        SHIP_FREE_EX(&scratchAllocator, pThirdAlloc);
+
+        REQUIRE(scratchAllocator.GetMarker() == marker);
+
+        scratchAllocator.RewindToMarker(marker);
+    }
+
+    SECTION("full heap forwards to the GlobalAllocator")
+    {
+        Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+        const size_t heapSize = 64;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        scratchAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pAlloc = SHIP_ALLOC_EX(&scratchAllocator, 128, 8);
+
+        REQUIRE(pAlloc != nullptr);
+        REQUIRE(AllocsAreDontOverlap(pAlloc, 128, scoppedBuffer.pBuffer, heapSize));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(scratchAllocator.GetMemoryInfo().numForwardedAllocations == 1);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&scratchAllocator, pAlloc);
+    }
+
+    SECTION("scratch scopes free their temporaries")
+    {
+        Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+        Shipyard::ScratchAllocator& threadScratchAllocator = Shipyard::ScratchAllocator::GetThreadScratchAllocator();
+        Shipyard::ScratchAllocator::Marker initialMarker = threadScratchAllocator.GetMarker();
+
+        {
+            Shipyard::ScratchScope scratchScope;
+
+            REQUIRE(scratchScope.GetAllocator() == &threadScratchAllocator);
+
+            Shipyard::StringA temporaryString(scratchScope.GetAllocator());
+            temporaryString = "Some temporary string";
+
+            {
+                Shipyard::ScratchScope innerScratchScope;
+
+                Shipyard::Array<uint32_t> temporaryArray(innerScratchScope.GetAllocator());
+                for (uint32_t i = 0; i < 1000; i++)
+                {
+                    temporaryArray.Add(i);
+                }
+
+                REQUIRE(threadScratchAllocator.GetMarker() > initialMarker);
+            }
+
+            temporaryString += " that grows after the inner scope";
+
+            REQUIRE(temporaryString == "Some temporary string that grows after the inner scope");
+        }
+
+        REQUIRE(threadScratchAllocator.GetMarker() == initialMarker);
+
+        Shipyard::ScratchAllocator* pOtherThreadScratchAllocator = nullptr;
+        std::thread otherThread([&pOtherThreadScratchAllocator]()
+        {
+            pOtherThreadScratchAllocator = &Shipyard::ScratchAllocator::GetThreadScratchAllocator();
+        });
+        otherThread.join();
+
+        REQUIRE(pOtherThreadScratchAllocator != &threadScratchAllocator);
+    }
+
+    scratchAllocator.Destroy();
+}
+
+namespace
+{
+    // Mimics what the ShaderCompiler does with a shader's source for every sampler state block it finds.
+    size_t ExtractBlocksFromSource(Shipyard::BaseAllocator* pAllocator, const Shipyard::StringA& originalSource)
+    {
+        Shipyard::StringA source(pAllocator);
+        source += originalSource;
+
+        Shipyard::Array<Shipyard::StringA> blockSources(pAllocator);
+
+        size_t blockStartIndex = source.FindIndexOfFirst("Block", 0);
+        while (blockStartIndex != Shipyard::StringA::InvalidIndex)
+        {
+            size_t blockEndIndex = source.FindIndexOfFirst(';', blockStartIndex);
+
+            Shipyard::StringA blockSource = source.Substring(blockStartIndex, blockEndIndex - blockStartIndex);
+            source.Erase(blockStartIndex, blockEndIndex - blockStartIndex + 1);
+
+            blockSources.Add(blockSource);
+
+            source.Insert(blockStartIndex, "Declaration;");
+
+            blockStartIndex = source.FindIndexOfFirst("Block", blockStartIndex);
+        }
+
+        return blockSources.Size();
+    }
+}
+
+TEST_CASE("Benchmark ScratchScope", "[.][Benchmark][Allocator]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    const size_t numBlocks = 32;
+
+    Shipyard::StringA originalSource;
+    for (size_t i = 0; i < numBlocks; i++)
+    {
+        originalSource += "float4 SomeShaderCode(float4 position) { return position; }\n";
+        originalSource += "Block { Filter = Linear; AddressU = Wrap; AddressV = Wrap; };\n";
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    uint64_t numAllocationsBefore = Shipyard::GlobalAllocator::GetNumAllocationsForCurrentThread();
+    ExtractBlocksFromSource(&Shipyard::GetGlobalAllocator(), originalSource);
+    uint64_t numGlobalAllocationsWithoutScratch = Shipyard::GlobalAllocator::GetNumAllocationsForCurrentThread() - numAllocationsBefore;
+
+    numAllocationsBefore = Shipyard::GlobalAllocator::GetNumAllocationsForCurrentThread();
+    {
+        Shipyard::ScratchScope scratchScope;
+        ExtractBlocksFromSource(scratchScope.GetAllocator(), originalSource);
+    }
+    uint64_t numGlobalAllocationsWithScratch = Shipyard::GlobalAllocator::GetNumAllocationsForCurrentThread() - numAllocationsBefore;
+
+    WARN("GlobalAllocator allocations to extract " << numBlocks << " blocks: " << numGlobalAllocationsWithoutScratch << " without scratch scope, " << numGlobalAllocationsWithScratch << " with scratch scope");
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    BENCHMARK("Extract blocks with the GlobalAllocator")
+    {
+        for (size_t i = 0; i < 1000; i++)
+        {
+            ExtractBlocksFromSource(&Shipyard::GetGlobalAllocator(), originalSource);
+        }
+    }
+
+    BENCHMARK("Extract blocks with a ScratchScope")
+    {
+        for (size_t i = 0; i < 1000; i++)
+        {
+            Shipyard::ScratchScope scratchScope;
+            ExtractBlocksFromSource(scratchScope.GetAllocator(), originalSource);
+        }
+    }
+}
+
+TEST_CASE("Test in-place reallocation", "[Allocator]")
+{
+    SECTION("FixedHeapAllocator grows into the next free block")
+    {
+        const size_t heapSize = 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        Shipyard::FixedHeapAllocator fixedHeapAllocator;
+        fixedHeapAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        uint8_t* pAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&fixedHeapAllocator, 64, 8));
+        memset(pAlloc, 0x5a, 64);
+
+        REQUIRE(fixedHeapAllocator.TryExpandInPlace(pAlloc, 64, 256));
+        REQUIRE(pAlloc[63] == 0x5a);
+
+        // The memory after the grown allocation must still be available.
+        void* pSecondAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 128, 8);
+
+        REQUIRE(pSecondAlloc != nullptr);
+        REQUIRE(AllocsAreDontOverlap(pAlloc, 256, pSecondAlloc, 128));
+
+        // Now blocked by the second allocation.
+        REQUIRE(!fixedHeapAllocator.TryExpandInPlace(pAlloc, 256, 512));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBlocksAllocated == 2);
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numUserBytesAllocated >= 256 + 128);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pSecondAlloc);
+        SHIP_FREE_EX(&fixedHeapAllocator, pAlloc);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBytesUsed == 0);
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        // A smaller allocation afterwards doesn't lower the peak.
+        void* pSmallAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 16, 8);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().peakUserBytesAllocated >= 256 + 128);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pSmallAlloc);
+
+        // Everything must have been merged back in a single block.
+        void* pWholeHeapAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 512, 8);
+
+        REQUIRE(pWholeHeapAlloc != nullptr);
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pWholeHeapAlloc);
+
+        fixedHeapAllocator.Destroy();
+    }
+
+    SECTION("TLSFAllocator grows into the next free block")
+    {
+        const size_t heapSize = 4096;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        Shipyard::TLSFAllocator tlsfAllocator;
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        uint8_t* pAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&tlsfAllocator, 64, 8));
+        void* pSecondAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 64, 8);
+        memset(pAlloc, 0x5a, 64);
+
+        // Blocked by the second allocation.
+        REQUIRE(!tlsfAllocator.TryExpandInPlace(pAlloc, 64, 128));
+
+        SHIP_FREE_EX(&tlsfAllocator, pSecondAlloc);
+
+        REQUIRE(tlsfAllocator.TryExpandInPlace(pAlloc, 64, 1024));
+        REQUIRE(pAlloc[63] == 0x5a);
+
+        // Shrinking always succeeds.
+        REQUIRE(tlsfAllocator.TryExpandInPlace(pAlloc, 1024, 32));
+
+        // The rest of the heap must still be usable after the grown allocation.
+        void* pThirdAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 2048, 8);
+
+        REQUIRE(pThirdAlloc != nullptr);
+        REQUIRE(AllocsAreDontOverlap(pAlloc, 1024, pThirdAlloc, 2048));
+
+        SHIP_FREE_EX(&tlsfAllocator, pThirdAlloc);
+        SHIP_FREE_EX(&tlsfAllocator, pAlloc);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBytesUsed == 0);
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numUserBytesAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        tlsfAllocator.Destroy();
+    }
+
+    SECTION("LinearAllocator extends its last allocation")
+    {
+        const size_t heapSize = 256;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize);
+
+        Shipyard::LinearAllocator linearAllocator;
+        linearAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        void* pFirstAlloc = SHIP_ALLOC_EX(&linearAllocator, 32, 1);
+        void* pSecondAlloc = SHIP_ALLOC_EX(&linearAllocator, 32, 1);
+
+        REQUIRE(!linearAllocator.TryExpandInPlace(pFirstAlloc, 32, 64));
+        REQUIRE(linearAllocator.TryExpandInPlace(pSecondAlloc, 32, 64));
+        REQUIRE(!linearAllocator.TryExpandInPlace(pSecondAlloc, 64, heapSize));
+
+        REQUIRE(size_t(SHIP_ALLOC_EX(&linearAllocator, 1, 1)) == size_t(pSecondAlloc) + 64);
+
+        linearAllocator.Destroy();
+    }
+
+    SECTION("Reallocate moves the allocation when it can't grow in place")
+    {
+        const size_t heapSize = 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        Shipyard::TLSFAllocator tlsfAllocator;
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        uint8_t* pAlloc = reinterpret_cast<uint8_t*>(SHIP_ALLOC_EX(&tlsfAllocator, 32, 8));
+        void* pBlockingAlloc = SHIP_ALLOC_EX(&tlsfAllocator, 32, 8);
+
+        for (uint8_t i = 0; i < 32; i++)
+        {
+            pAlloc[i] = i;
+        }
+
+        uint8_t* pReallocatedAlloc = reinterpret_cast<uint8_t*>(SHIP_REALLOC_EX(&tlsfAllocator, pAlloc, 32, 128, 8));
+
+        REQUIRE(pReallocatedAlloc != nullptr);
+        REQUIRE(pReallocatedAlloc != pAlloc);
+
+        for (uint8_t i = 0; i < 32; i++)
+        {
+            REQUIRE(pReallocatedAlloc[i] == i);
+        }
+
+        // Too big for the heap, the allocation must be left untouched.
+        REQUIRE(SHIP_REALLOC_EX(&tlsfAllocator, pReallocatedAlloc, 128, heapSize, 8) == nullptr);
+        REQUIRE(pReallocatedAlloc[31] == 31);
+
+        SHIP_FREE_EX(&tlsfAllocator, pBlockingAlloc);
+        SHIP_FREE_EX(&tlsfAllocator, pReallocatedAlloc);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        tlsfAllocator.Destroy();
+    }
+
+    SECTION("containers grow in place")
+    {
+        const size_t heapSize = 64 * 1024;
+        Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 8);
+
+        Shipyard::TLSFAllocator tlsfAllocator;
+        tlsfAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+        {
+            Shipyard::Array<uint8_t> bigArray(&tlsfAllocator);
+            bigArray.Reserve(1024);
+
+            for (uint32_t i = 0; i < 1024; i++)
+            {
+                bigArray.Add(uint8_t(i));
+            }
+
+            const uint8_t* pBuffer = &bigArray[0];
+
+            bigArray.Resize(8 * 1024);
+
+            REQUIRE(&bigArray[0] == pBuffer);
+            REQUIRE(bigArray[1023] == uint8_t(1023));
+            REQUIRE(bigArray[8 * 1024 - 1] == 0);
+
+            Shipyard::Array<uint32_t> array(&tlsfAllocator);
+            array.Reserve(16);
+            array.Add(42);
+
+            const uint32_t* pArrayBuffer = &array[0];
+
+            array.Reserve(256);
+
+            REQUIRE(&array[0] == pArrayBuffer);
+            REQUIRE(array[0] == 42);
+            REQUIRE(array.Capacity() == 256);
+
+            Shipyard::StringA str(&tlsfAllocator);
+            str = "in-place";
+
+            const char* pStringBuffer = str.GetBuffer();
+
+            str += " reallocation";
+
+            REQUIRE(str.GetBuffer() == pStringBuffer);
+            REQUIRE(str == "in-place reallocation");
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(tlsfAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        tlsfAllocator.Destroy();
+    }
+}
+
+TEST_CASE("Test VirtualMemoryHeap", "[Allocator]")
+{
+    const size_t reservedSize = 64 * 1024 * 1024;
+
+    Shipyard::VirtualMemoryHeap virtualMemoryHeap;
+
+    SECTION("committing and decommitting pages")
+    {
+        REQUIRE(virtualMemoryHeap.Create(reservedSize));
+
+        size_t commitGranularity = virtualMemoryHeap.GetCommitGranularity();
+
+        REQUIRE(virtualMemoryHeap.GetBaseAddress() != nullptr);
+        REQUIRE(virtualMemoryHeap.GetReservedSize() == reservedSize);
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == 0);
+        REQUIRE(virtualMemoryHeap.GetResidentSize() == 0);
+
+        REQUIRE(virtualMemoryHeap.Grow(1));
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == commitGranularity);
+
+        REQUIRE(virtualMemoryHeap.Grow(3 * commitGranularity + 1));
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == 4 * commitGranularity);
+
+        REQUIRE(!virtualMemoryHeap.Grow(reservedSize + 1));
+
+        uint8_t* pBaseAddress = reinterpret_cast<uint8_t*>(virtualMemoryHeap.GetBaseAddress());
+        memset(pBaseAddress, 0x5a, 4 * commitGranularity);
+
+        REQUIRE(virtualMemoryHeap.GetResidentSize() <= virtualMemoryHeap.GetCommittedSize());
+        REQUIRE(virtualMemoryHeap.GetResidentSize() > 0);
+
+        virtualMemoryHeap.Shrink(commitGranularity);
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == commitGranularity);
+        REQUIRE(pBaseAddress[commitGranularity - 1] == 0x5a);
+
+        // Pages that were given back read as zero once committed again.
+        REQUIRE(virtualMemoryHeap.Grow(2 * commitGranularity));
+        REQUIRE(pBaseAddress[commitGranularity] == 0);
+    }
+
+    SECTION("the heap never shrinks below its initial committed size")
+    {
+        REQUIRE(virtualMemoryHeap.Create(reservedSize, 1024 * 1024));
+
+        size_t initialCommittedSize = virtualMemoryHeap.GetCommittedSize();
+
+        REQUIRE(initialCommittedSize >= 1024 * 1024);
+        REQUIRE(virtualMemoryHeap.GetInitialCommittedSize() == initialCommittedSize);
+
+        REQUIRE(virtualMemoryHeap.Grow(initialCommittedSize * 2));
+
+        virtualMemoryHeap.Shrink(0);
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == initialCommittedSize);
+    }
+
+    SECTION("FixedHeapAllocator grows and gives memory back")
+    {
+        REQUIRE(virtualMemoryHeap.Create(reservedSize));
+
+        Shipyard::FixedHeapAllocator fixedHeapAllocator;
+        REQUIRE(fixedHeapAllocator.Create(&virtualMemoryHeap));
+
+        size_t initialCommittedSize = virtualMemoryHeap.GetCommittedSize();
+
+        REQUIRE(fixedHeapAllocator.GetHeapSize() == reservedSize);
+
+        std::vector<void*> allocations;
+        for (size_t i = 0; i < 64; i++)
+        {
+            void* pAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 64 * 1024, 16);
+
+            REQUIRE(pAlloc != nullptr);
+            REQUIRE(Shipyard::MemoryUtils::IsAddressAligned(size_t(pAlloc), 16));
+
+            memset(pAlloc, int(i), 64 * 1024);
+
+            allocations.push_back(pAlloc);
+        }
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() >= 64 * 64 * 1024);
+
+        for (size_t i = 0; i < allocations.size(); i++)
+        {
+            REQUIRE(reinterpret_cast<uint8_t*>(allocations[i])[64 * 1024 - 1] == uint8_t(i));
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBytesCommitted == virtualMemoryHeap.GetCommittedSize());
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBytesResident >= 64 * 64 * 1024);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        // Freeing in reverse order leaves the end of the heap free every time.
+        for (size_t i = allocations.size(); i > 0; i--)
+        {
+            SHIP_FREE_EX(&fixedHeapAllocator, allocations[i - 1]);
+        }
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() <= initialCommittedSize + 2 * virtualMemoryHeap.GetCommitGranularity());
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+        REQUIRE(fixedHeapAllocator.GetMemoryInfo().numBytesUsed == 0);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        // The heap can grow again after shrinking.
+        void* pBigAlloc = SHIP_ALLOC_EX(&fixedHeapAllocator, 8 * 1024 * 1024, 8);
+
+        REQUIRE(pBigAlloc != nullptr);
+
+        SHIP_FREE_EX(&fixedHeapAllocator, pBigAlloc);
+
+        fixedHeapAllocator.Destroy();
+    }
+
+    SECTION("LinearAllocator commits pages as it allocates")
+    {
+        REQUIRE(virtualMemoryHeap.Create(reservedSize));
+
+        Shipyard::LinearAllocator linearAllocator;
+        REQUIRE(linearAllocator.Create(&virtualMemoryHeap));
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == 0);
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            void* pAlloc = SHIP_ALLOC_EX(&linearAllocator, 10000, 8);
+
+            REQUIRE(pAlloc != nullptr);
+
+            memset(pAlloc, 0, 10000);
+        }
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() >= 100 * 10000);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        REQUIRE(linearAllocator.GetMemoryInfo().numBytesUsed >= 100 * 10000);
+        REQUIRE(linearAllocator.GetMemoryInfo().numBytesResident >= 100 * 10000);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        REQUIRE(SHIP_ALLOC_EX(&linearAllocator, reservedSize, 8) == nullptr);
+
+        linearAllocator.FreeEverything();
+
+        REQUIRE(virtualMemoryHeap.GetCommittedSize() == 0);
+
+        linearAllocator.Destroy();
+    }
+
+    SECTION("PoolAllocator commits new chunks when it runs out")
+    {
+        const size_t chunkSize = 256;
+
+        auto growPoolTestCase = [&virtualMemoryHeap, chunkSize](Shipyard::PoolAllocator::SynchronizationMode synchronizationMode)
+        {
+            REQUIRE(virtualMemoryHeap.Create(reservedSize));
+
+            Shipyard::PoolAllocator poolAllocator;
+            REQUIRE(poolAllocator.Create(&virtualMemoryHeap, chunkSize, synchronizationMode));
+
+            size_t numChunksToAllocate = 4 * virtualMemoryHeap.GetCommitGranularity() / chunkSize;
+
+            std::vector<void*> allocations;
+            for (size_t i = 0; i < numChunksToAllocate; i++)
+            {
+                void* pAlloc = SHIP_ALLOC_EX(&poolAllocator, chunkSize, 8);
+
+                REQUIRE(pAlloc != nullptr);
+
+                memset(pAlloc, 0, chunkSize);
+
+                allocations.push_back(pAlloc);
+            }
+
+            std::sort(allocations.begin(), allocations.end());
+            REQUIRE(std::unique(allocations.begin(), allocations.end()) == allocations.end());
+
+            REQUIRE(virtualMemoryHeap.GetCommittedSize() >= numChunksToAllocate * chunkSize);
+
+            for (void* pAlloc : allocations)
+            {
+                SHIP_FREE_EX(&poolAllocator, pAlloc);
+            }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            REQUIRE(poolAllocator.GetMemoryInfo().numBlocksAllocated == 0);
+            REQUIRE(poolAllocator.GetMemoryInfo().numBytesCommitted == virtualMemoryHeap.GetCommittedSize());
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+            poolAllocator.Destroy();
+            virtualMemoryHeap.Destroy();
+        };
+
+        growPoolTestCase(Shipyard::PoolAllocator::SynchronizationMode::Mutex);
+        growPoolTestCase(Shipyard::PoolAllocator::SynchronizationMode::LockFree);
+    }
+
+    virtualMemoryHeap.Destroy();
+}
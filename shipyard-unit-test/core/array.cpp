@@ -8,6 +8,49 @@
 
 #include <algorithm>
 
+namespace
+{
+    // Counts copies, to make sure elements are moved or constructed in place.
+    struct CopyCountingElement
+    {
+        CopyCountingElement() = default;
+
+        CopyCountingElement(int first, int second)
+            : first(first)
+            , second(second)
+        {
+        }
+
+        CopyCountingElement(const CopyCountingElement& src)
+            : first(src.first)
+            , second(src.second)
+        {
+            ms_NumCopies += 1;
+        }
+
+        CopyCountingElement(CopyCountingElement&& src) = default;
+
+        CopyCountingElement& operator= (const CopyCountingElement& rhs)
+        {
+            first = rhs.first;
+            second = rhs.second;
+
+            ms_NumCopies += 1;
+
+            return *this;
+        }
+
+        CopyCountingElement& operator= (CopyCountingElement&& rhs) = default;
+
+        int first = 0;
+        int second = 0;
+
+        static int ms_NumCopies;
+    };
+
+    int CopyCountingElement::ms_NumCopies = 0;
+}
+
 TEST_CASE("Test array", "[Array]")
 {
     Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
@@ -171,6 +214,93 @@ TEST_CASE("Test array", "[Array]")
         }
     }
 
+    SECTION("lazy allocation")
+    {
+        REQUIRE(arr.Capacity() == 0);
+        REQUIRE(arr.begin() == arr.end());
+
+        Shipyard::Array<int> copiedArray = arr;
+
+        REQUIRE(copiedArray.Capacity() == 0);
+
+        arr.Add(1);
+
+        REQUIRE(arr.Size() == 1);
+        REQUIRE(arr.Capacity() >= 1);
+    }
+
+    SECTION("move")
+    {
+        constexpr int numElements = 3;
+
+        for (int i = 0; i < numElements; i++)
+        {
+            arr.Add(i);
+        }
+
+        const int* pBuffer = &arr[0];
+
+        Shipyard::Array<int> movedArray = std::move(arr);
+
+        REQUIRE(movedArray.Size() == numElements);
+        REQUIRE(&movedArray[0] == pBuffer);
+        REQUIRE(arr.Size() == 0);
+        REQUIRE(arr.Capacity() == 0);
+
+        arr.Add(42);
+        arr = std::move(movedArray);
+
+        REQUIRE(arr.Size() == numElements);
+        REQUIRE(&arr[0] == pBuffer);
+        REQUIRE(movedArray.Empty());
+
+        // The static buffer of an inplace array can't be taken, its elements are moved instead.
+        Shipyard::InplaceArray<int, numElements> inplaceArray;
+        inplaceArray.Add(7);
+
+        Shipyard::Array<int> arrayFromInplace = std::move(inplaceArray);
+
+        REQUIRE(arrayFromInplace.Size() == 1);
+        REQUIRE(arrayFromInplace[0] == 7);
+        REQUIRE(inplaceArray.Size() == 0);
+        REQUIRE(inplaceArray.Capacity() == numElements);
+    }
+
+    SECTION("emplace")
+    {
+        CopyCountingElement::ms_NumCopies = 0;
+
+        Shipyard::Array<CopyCountingElement> elements;
+
+        constexpr int numElements = 100;
+
+        for (int i = 0; i < numElements; i++)
+        {
+            CopyCountingElement& element = elements.EmplaceBack(i, i * 2);
+
+            REQUIRE(element.first == i);
+        }
+
+        CopyCountingElement& insertedElement = elements.Emplace(0, -1, -2);
+
+        REQUIRE(insertedElement.first == -1);
+        REQUIRE(elements.Size() == numElements + 1);
+        REQUIRE(elements[1].first == 0);
+        REQUIRE(elements[numElements].second == (numElements - 1) * 2);
+
+        elements.RemoveAtPreserveOrder(0);
+        elements.RemoveAt(0);
+
+        REQUIRE(elements.Size() == numElements - 1);
+        REQUIRE(elements[0].first == numElements - 1);
+        REQUIRE(elements[1].first == 1);
+
+        elements.Add(CopyCountingElement(1000, 2000));
+
+        REQUIRE(elements.Back().second == 2000);
+        REQUIRE(CopyCountingElement::ms_NumCopies == 0);
+    }
+
     SECTION("Inplace array")
     {
         constexpr int numElements = 3;
@@ -198,7 +328,8 @@ TEST_CASE("Test array", "[Array]")
 
         inplaceArray.Clear();
 
-        REQUIRE(inplaceArray.Capacity() == 0);
+        // Back to the static buffer.
+        REQUIRE(inplaceArray.Capacity() == numElements);
         REQUIRE(inplaceArray.Size() == 0);
 
         inplaceArray.Reserve(numElements);
@@ -210,6 +341,87 @@ TEST_CASE("Test array", "[Array]")
 
         REQUIRE(inplaceArray.Capacity() == numElements);
         REQUIRE(inplaceArray.Size() == numElements);
+
+        const int* pStaticBuffer = &inplaceArray[0];
+
+        Shipyard::InplaceArray<int, numElements> copiedInplaceArray = inplaceArray;
+
+        REQUIRE(copiedInplaceArray.Size() == numElements);
+        REQUIRE(copiedInplaceArray.Capacity() == numElements);
+        REQUIRE(copiedInplaceArray[numElements - 1] == numElements - 1);
+
+        copiedInplaceArray.Add(42);
+
+        // Assigning keeps using the static buffer when it's big enough.
+        inplaceArray = copiedInplaceArray;
+
+        REQUIRE(inplaceArray.Size() == numElements + 1);
+        REQUIRE(inplaceArray[numElements] == 42);
+
+        copiedInplaceArray.Resize(1);
+        inplaceArray = copiedInplaceArray;
+
+        REQUIRE(inplaceArray.Size() == 1);
+        REQUIRE(inplaceArray[0] == 0);
+
+        inplaceArray.Clear();
+
+        REQUIRE(inplaceArray.Capacity() == numElements);
+
+        inplaceArray.Add(1);
+
+        REQUIRE(&inplaceArray[0] == pStaticBuffer);
+
+        Shipyard::InplaceArray<int, numElements> movedInplaceArray = std::move(inplaceArray);
+
+        REQUIRE(movedInplaceArray.Size() == 1);
+        REQUIRE(movedInplaceArray[0] == 1);
+        REQUIRE(inplaceArray.Size() == 0);
+        REQUIRE(inplaceArray.Capacity() == numElements);
+    }
+
+    SECTION("Move to an inplace array through its base array")
+    {
+        constexpr int numElements = 3;
+
+        Shipyard::InplaceArray<int, numElements> inplaceArray;
+        inplaceArray.Add(0);
+
+        const int* pStaticBuffer = &inplaceArray[0];
+
+        Shipyard::Array<int>& baseArray = inplaceArray;
+
+        // Elements from a borrowed buffer are moved to the static buffer.
+        Shipyard::InplaceArray<int, numElements> smallInplaceArray;
+        smallInplaceArray.Add(1);
+        smallInplaceArray.Add(2);
+
+        baseArray = std::move(smallInplaceArray);
+
+        REQUIRE(inplaceArray.Size() == 2);
+        REQUIRE(inplaceArray[1] == 2);
+        REQUIRE(&inplaceArray[0] == pStaticBuffer);
+        REQUIRE(inplaceArray.Capacity() == numElements);
+
+        // Memory from the allocator is taken.
+        Shipyard::Array<int> largeArray;
+        for (int i = 0; i < numElements * 2; i++)
+        {
+            largeArray.Add(i);
+        }
+
+        const int* pLargeBuffer = &largeArray[0];
+
+        baseArray = std::move(largeArray);
+
+        REQUIRE(inplaceArray.Size() == numElements * 2);
+        REQUIRE(&inplaceArray[0] == pLargeBuffer);
+
+        inplaceArray.Clear();
+        inplaceArray.Add(42);
+
+        REQUIRE(&inplaceArray[0] == pStaticBuffer);
+        REQUIRE(inplaceArray.Capacity() == numElements);
     }
 
     SECTION("Change allocator")
@@ -242,4 +454,87 @@ TEST_CASE("Test array", "[Array]")
 
         fixedHeapAllocator.Destroy();
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Test large array", "[Array]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    Shipyard::Array<CopyCountingElement> bigArray;
+
+    SECTION("lazy allocation")
+    {
+        REQUIRE(bigArray.Capacity() == 0);
+        REQUIRE(bigArray.begin() == bigArray.end());
+    }
+
+    SECTION("emplace and move")
+    {
+        CopyCountingElement::ms_NumCopies = 0;
+
+        constexpr uint32_t numElements = 20000;
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            bigArray.EmplaceBack(int(i), int(i) + 1);
+        }
+
+        bigArray.Emplace(numElements / 2, -1, -1);
+        bigArray.RemoveAtPreserveOrder(numElements / 2);
+
+        const CopyCountingElement* pBuffer = &bigArray[0];
+
+        Shipyard::Array<CopyCountingElement> movedBigArray = std::move(bigArray);
+
+        REQUIRE(movedBigArray.Size() == numElements);
+        REQUIRE(&movedBigArray[0] == pBuffer);
+        REQUIRE(movedBigArray[numElements / 2].first == int(numElements / 2));
+        REQUIRE(bigArray.Size() == 0);
+        REQUIRE(bigArray.Capacity() == 0);
+
+        bigArray = std::move(movedBigArray);
+
+        REQUIRE(bigArray.Size() == numElements);
+        REQUIRE(CopyCountingElement::ms_NumCopies == 0);
+    }
+
+    SECTION("size and capacity")
+    {
+        // The size and capacity take 8 bytes, whatever the number of elements.
+        REQUIRE(sizeof(Shipyard::Array<uint8_t>) == sizeof(void*) * 2 + sizeof(uint32_t) * 2);
+
+        Shipyard::Array<uint32_t> integers;
+        integers.Resize(100000);
+
+        REQUIRE(integers.Size() == 100000);
+        REQUIRE(integers.Capacity() >= 100000);
+
+        integers.Back() = 42;
+        integers.Resize(16384);
+        integers.Add(43);
+
+        REQUIRE(integers.Size() == 16385);
+        REQUIRE(integers.Back() == 43);
+    }
+
+    SECTION("growth policy")
+    {
+        Shipyard::Array<uint32_t, 1, Shipyard::GeometricArrayGrowthPolicy<3, 2, 16>> integers;
+
+        integers.Add(0);
+
+        REQUIRE(integers.Capacity() == 16);
+
+        for (uint32_t i = 1; i < 17; i++)
+        {
+            integers.Add(i);
+        }
+
+        REQUIRE(integers.Capacity() == 24);
+
+        Shipyard::Array<uint32_t> copiedIntegers = integers;
+
+        REQUIRE(copiedIntegers.Size() == 17);
+        REQUIRE(copiedIntegers[16] == 16);
+    }
+}
@@ -0,0 +1,149 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/atomicoperations.h>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test AtomicOperations", "[AtomicOperations]")
+{
+    SECTION("32 bits operations")
+    {
+        volatile uint32_t value = 10;
+
+        REQUIRE(Shipyard::AtomicOperations::Load(value) == 10);
+        REQUIRE(Shipyard::AtomicOperations::Load(value, Shipyard::MemoryOrder::Relaxed) == 10);
+
+        Shipyard::AtomicOperations::Store(value, 20u, Shipyard::MemoryOrder::Release);
+        REQUIRE(Shipyard::AtomicOperations::Load(value, Shipyard::MemoryOrder::Acquire) == 20);
+
+        REQUIRE(Shipyard::AtomicOperations::Increment(value) == 21);
+        REQUIRE(Shipyard::AtomicOperations::Decrement(value, Shipyard::MemoryOrder::Relaxed) == 20);
+        REQUIRE(Shipyard::AtomicOperations::Add(value, 5u) == 20);
+        REQUIRE(Shipyard::AtomicOperations::Subtract(value, 10u, Shipyard::MemoryOrder::AcquireRelease) == 25);
+        REQUIRE(value == 15);
+
+        REQUIRE(Shipyard::AtomicOperations::Exchange(value, 0xF0u) == 15);
+        REQUIRE(Shipyard::AtomicOperations::Or(value, 0x0Fu) == 0xF0);
+        REQUIRE(Shipyard::AtomicOperations::And(value, 0x3Cu, Shipyard::MemoryOrder::Acquire) == 0xFF);
+        REQUIRE(value == 0x3C);
+
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange(value, 1u, 2u) == 0x3C);
+        REQUIRE(value == 0x3C);
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange(value, 1u, 0x3Cu, Shipyard::MemoryOrder::Release) == 0x3C);
+        REQUIRE(value == 1);
+
+        // Wrapping around doesn't touch neighbouring bytes.
+        volatile uint32_t values[3] = { 0xAAAAAAAA, 0, 0xBBBBBBBB };
+        REQUIRE(Shipyard::AtomicOperations::Decrement(values[1]) == 0xFFFFFFFF);
+        REQUIRE(Shipyard::AtomicOperations::Increment(values[1]) == 0);
+        REQUIRE(values[0] == 0xAAAAAAAA);
+        REQUIRE(values[2] == 0xBBBBBBBB);
+    }
+
+    SECTION("64 bits operations")
+    {
+        volatile uint64_t value = 0x100000000ull;
+
+        REQUIRE(Shipyard::AtomicOperations::Load(value, Shipyard::MemoryOrder::Acquire) == 0x100000000ull);
+        REQUIRE(Shipyard::AtomicOperations::Increment(value) == 0x100000001ull);
+        REQUIRE(Shipyard::AtomicOperations::Add(value, uint64_t(0x100000000), Shipyard::MemoryOrder::Relaxed) == 0x100000001ull);
+        REQUIRE(Shipyard::AtomicOperations::Subtract(value, uint64_t(1)) == 0x200000001ull);
+        REQUIRE(Shipyard::AtomicOperations::Or(value, uint64_t(0xFF)) == 0x200000000ull);
+        REQUIRE(Shipyard::AtomicOperations::And(value, uint64_t(0xFFFFFFFF0000000F)) == 0x2000000FFull);
+        REQUIRE(value == 0x20000000Full);
+
+        Shipyard::AtomicOperations::Store(value, uint64_t(42));
+        REQUIRE(Shipyard::AtomicOperations::Exchange(value, uint64_t(43), Shipyard::MemoryOrder::AcquireRelease) == 42);
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange(value, uint64_t(44), uint64_t(43)) == 43);
+        REQUIRE(value == 44);
+    }
+
+    SECTION("Signed integers, enums and pointers")
+    {
+        volatile int32_t signedValue = 0;
+        REQUIRE(Shipyard::AtomicOperations::Decrement(signedValue) == -1);
+        REQUIRE(Shipyard::AtomicOperations::Subtract(signedValue, 10) == -1);
+        REQUIRE(signedValue == -11);
+
+        enum class State : uint32_t { Idle, Running, Done };
+
+        volatile State state = State::Idle;
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange(state, State::Running, State::Idle) == State::Idle);
+        REQUIRE(Shipyard::AtomicOperations::Exchange(state, State::Done) == State::Running);
+        REQUIRE(Shipyard::AtomicOperations::Load(state) == State::Done);
+
+        int first = 0;
+        int second = 0;
+
+        int* volatile pointer = nullptr;
+        Shipyard::AtomicOperations::Store(pointer, &first, Shipyard::MemoryOrder::Release);
+        REQUIRE(Shipyard::AtomicOperations::Load(pointer, Shipyard::MemoryOrder::Acquire) == &first);
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange(pointer, &second, &first) == &first);
+        REQUIRE(Shipyard::AtomicOperations::Exchange(pointer, static_cast<int*>(nullptr)) == &second);
+    }
+
+#if CPU_BITS == CPU_BITS_64
+    SECTION("128 bits compare exchange")
+    {
+        volatile Shipyard::AtomicUint128 value;
+        value.low = 1;
+        value.high = 2;
+
+        Shipyard::AtomicUint128 exchangeValue = { 3, 4 };
+        Shipyard::AtomicUint128 comperand = { 1, 5 };
+
+        REQUIRE(!Shipyard::AtomicOperations::CompareExchange128(value, exchangeValue, comperand));
+        REQUIRE(comperand.low == 1);
+        REQUIRE(comperand.high == 2);
+        REQUIRE(value.low == 1);
+        REQUIRE(value.high == 2);
+
+        REQUIRE(Shipyard::AtomicOperations::CompareExchange128(value, exchangeValue, comperand));
+        REQUIRE(value.low == 3);
+        REQUIRE(value.high == 4);
+    }
+#endif // #if CPU_BITS == CPU_BITS_64
+
+    SECTION("Concurrent operations")
+    {
+        constexpr uint32_t numThreads = 4;
+        constexpr uint32_t numIterations = 100000;
+
+        volatile uint32_t counter = 0;
+        volatile uint64_t casCounter = 0;
+        volatile uint32_t bits = 0;
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < numThreads; i++)
+        {
+            threads.emplace_back([&counter, &casCounter, &bits, i]()
+            {
+                for (uint32_t j = 0; j < numIterations; j++)
+                {
+                    Shipyard::AtomicOperations::Increment(counter, Shipyard::MemoryOrder::Relaxed);
+
+                    uint64_t expected = Shipyard::AtomicOperations::Load(casCounter, Shipyard::MemoryOrder::Relaxed);
+                    uint64_t previous;
+                    while ((previous = Shipyard::AtomicOperations::CompareExchange(casCounter, expected + 1, expected)) != expected)
+                    {
+                        expected = previous;
+                    }
+                }
+
+                Shipyard::AtomicOperations::Or(bits, 1u << i);
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(counter == numThreads * numIterations);
+        REQUIRE(casCounter == numThreads * numIterations);
+        REQUIRE(bits == ((1u << numThreads) - 1));
+    }
+}
@@ -3,9 +3,13 @@
 #include <extern/catch/catch.hpp>
 
 #include <system/bitfield.h>
+#include <system/datapool.h>
 
 #include <utils/unittestutils.h>
 
+#include <random>
+#include <vector>
+
 TEST_CASE("Test bitfield 1 element", "[Bitfield]")
 {
     Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
@@ -520,4 +524,253 @@ TEST_CASE("Test bitfield less than an element", "[Bitfield]")
             REQUIRE(bitfield.IsBitSet(i));
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Test bitfield with summaries", "[Bitfield]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    // Not a multiple of the element size, so that the last element has bits that can't be set.
+    constexpr uint32_t bitfieldSize = 64 * 1024 + 37;
+    Shipyard::Bitfield<bitfieldSize> bitfield;
+
+    REQUIRE(bitfield.ms_HasSummaries);
+
+    bitfield.Create();
+
+    SECTION("Get first bit set and unset")
+    {
+        uint32_t foundBitIndex = 0;
+
+        REQUIRE(bitfield.IsClear());
+        REQUIRE(!bitfield.GetFirstBitSet(0, foundBitIndex));
+
+        bitfield.SetBit(bitfieldSize - 1);
+
+        REQUIRE(!bitfield.IsClear());
+        REQUIRE(bitfield.GetFirstBitSet(0, foundBitIndex));
+        REQUIRE(foundBitIndex == bitfieldSize - 1);
+
+        bitfield.SetBit(5000);
+
+        REQUIRE(bitfield.GetFirstBitSet(0, foundBitIndex));
+        REQUIRE(foundBitIndex == 5000);
+        REQUIRE(bitfield.GetFirstBitSet(5001, foundBitIndex));
+        REQUIRE(foundBitIndex == bitfieldSize - 1);
+
+        bitfield.UnsetBit(5000);
+        bitfield.UnsetBit(bitfieldSize - 1);
+
+        REQUIRE(bitfield.IsClear());
+
+        bitfield.SetAllBits();
+
+        REQUIRE(bitfield.GetNumBitsSet() == bitfieldSize);
+        REQUIRE(!bitfield.GetFirstBitUnset(0, foundBitIndex));
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(0) == bitfieldSize);
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(bitfieldSize - 1) == 1);
+
+        bitfield.UnsetBit(40000);
+
+        REQUIRE(bitfield.GetFirstBitUnset(0, foundBitIndex));
+        REQUIRE(foundBitIndex == 40000);
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(100) == 40000 - 100);
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(40000) == 0);
+    }
+
+    SECTION("Ranges")
+    {
+        bitfield.SetRange(100, 20000);
+
+        REQUIRE(bitfield.GetNumBitsSet() == 20000 - 100 + 1);
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(100) == 20000 - 100 + 1);
+
+        bitfield.UnsetRange(150, 19000);
+
+        REQUIRE(bitfield.GetLongestRangeWithBitsSet(100) == 50);
+
+        uint32_t foundBitIndex = 0;
+        REQUIRE(bitfield.GetFirstBitSet(150, foundBitIndex));
+        REQUIRE(foundBitIndex == 19001);
+
+        bitfield.UnsetRange(0, bitfieldSize - 1);
+
+        REQUIRE(bitfield.IsClear());
+    }
+
+    SECTION("Matches a reference bitfield")
+    {
+        std::vector<bool> referenceBitfield(bitfieldSize, false);
+
+        std::mt19937 randomEngine(7);
+
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            uint32_t bitIndex = randomEngine() % bitfieldSize;
+
+            // Mostly sets bits, so that both long runs of bits set and unset show up over time.
+            if ((randomEngine() % 4) != 0)
+            {
+                bitfield.SetBit(bitIndex);
+                referenceBitfield[bitIndex] = true;
+            }
+            else
+            {
+                bitfield.UnsetBit(bitIndex);
+                referenceBitfield[bitIndex] = false;
+            }
+
+            uint32_t startingBitIndex = randomEngine() % bitfieldSize;
+
+            uint32_t expectedFirstBitSet = startingBitIndex;
+            while (expectedFirstBitSet < bitfieldSize && !referenceBitfield[expectedFirstBitSet])
+            {
+                expectedFirstBitSet += 1;
+            }
+
+            uint32_t expectedFirstBitUnset = startingBitIndex;
+            while (expectedFirstBitUnset < bitfieldSize && referenceBitfield[expectedFirstBitUnset])
+            {
+                expectedFirstBitUnset += 1;
+            }
+
+            uint32_t firstBitSet = 0;
+            uint32_t firstBitUnset = 0;
+
+            REQUIRE(bitfield.GetFirstBitSet(startingBitIndex, firstBitSet) == (expectedFirstBitSet < bitfieldSize));
+            REQUIRE(bitfield.GetFirstBitUnset(startingBitIndex, firstBitUnset) == (expectedFirstBitUnset < bitfieldSize));
+
+            if (expectedFirstBitSet < bitfieldSize)
+            {
+                REQUIRE(firstBitSet == expectedFirstBitSet);
+            }
+
+            if (expectedFirstBitUnset < bitfieldSize)
+            {
+                REQUIRE(firstBitUnset == expectedFirstBitUnset);
+            }
+
+            REQUIRE(bitfield.GetLongestRangeWithBitsSet(startingBitIndex) == expectedFirstBitUnset - startingBitIndex);
+        }
+    }
+}
+
+namespace
+{
+    // Word by word scan, the way bitfields were searched before they had summaries.
+    bool LinearScanForFirstBitSet(const std::vector<uint64_t>& elements, uint32_t startingBitIndex, uint32_t& firstBitSet)
+    {
+        uint32_t elementIndex = startingBitIndex / 64;
+        uint64_t maskForScan = (uint64_t(-1) << (startingBitIndex % 64));
+
+        for (; elementIndex < elements.size(); elementIndex++)
+        {
+            uint64_t element = (elements[elementIndex] & maskForScan);
+            if (element != 0)
+            {
+                firstBitSet = elementIndex * 64 + Shipyard::GetLowestBitSetIndex(element);
+                return true;
+            }
+
+            maskForScan = uint64_t(-1);
+        }
+
+        return false;
+    }
+}
+
+TEST_CASE("Benchmark bitfield", "[.][Benchmark][Bitfield]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    constexpr uint32_t numSlots = 64 * 1024;
+    constexpr uint32_t numSearches = 100000;
+
+    uint64_t checksum = 0;
+
+    const uint32_t occupancies[] = { 10, 50, 90, 99 };
+
+    for (uint32_t occupancy : occupancies)
+    {
+        // Free slots are set bits, like in DataPool.
+        Shipyard::Bitfield<numSlots> freeSlots;
+        freeSlots.Create();
+
+        std::vector<uint64_t> linearFreeSlots(numSlots / 64, 0);
+
+        // Pools fill up from the front, so the occupied slots are packed at the beginning with the odd free slot in between.
+        uint32_t numOccupiedSlots = numSlots * occupancy / 100;
+
+        std::mt19937 randomEngine(occupancy);
+        for (uint32_t i = 0; i < numSlots; i++)
+        {
+            if (i >= numOccupiedSlots || (randomEngine() % 4096) == 0)
+            {
+                freeSlots.SetBit(i);
+                linearFreeSlots[i / 64] |= (uint64_t(1) << (i % 64));
+            }
+        }
+
+        std::vector<uint32_t> startingBitIndices(numSearches);
+        for (uint32_t& startingBitIndex : startingBitIndices)
+        {
+            startingBitIndex = randomEngine() % numSlots;
+        }
+
+        BENCHMARK("Bitfield search, " + std::to_string(occupancy) + "% full")
+        {
+            for (uint32_t startingBitIndex : startingBitIndices)
+            {
+                uint32_t firstBitSet = 0;
+                checksum += freeSlots.GetFirstBitSet(startingBitIndex, firstBitSet) ? firstBitSet : 0;
+            }
+        }
+
+        BENCHMARK("Linear search, " + std::to_string(occupancy) + "% full")
+        {
+            for (uint32_t startingBitIndex : startingBitIndices)
+            {
+                uint32_t firstBitSet = 0;
+                checksum += LinearScanForFirstBitSet(linearFreeSlots, startingBitIndex, firstBitSet) ? firstBitSet : 0;
+            }
+        }
+
+        Shipyard::DataPool<uint32_t, numSlots> dataPool;
+        dataPool.Create();
+
+        std::vector<uint32_t> allocatedIndices;
+        for (uint32_t i = 0; i < numSlots * occupancy / 100; i++)
+        {
+            allocatedIndices.push_back(dataPool.GetNewItemIndex());
+        }
+
+        // Frees every other item, leaving holes all over the pool, then iterates and refills it.
+        BENCHMARK("DataPool churn, " + std::to_string(occupancy) + "% full")
+        {
+            for (size_t i = 0; i < allocatedIndices.size(); i += 2)
+            {
+                dataPool.ReleaseItem(allocatedIndices[i]);
+            }
+
+            uint32_t index = 0;
+            if (dataPool.GetFirstAllocatedIndex(&index))
+            {
+                do
+                {
+                    checksum += index;
+                } while (dataPool.GetNextAllocatedIndex(index, &index));
+            }
+
+            for (size_t i = 0; i < allocatedIndices.size(); i += 2)
+            {
+                allocatedIndices[i] = dataPool.GetNewItemIndex();
+            }
+        }
+
+        for (uint32_t allocatedIndex : allocatedIndices)
+        {
+            dataPool.ReleaseItem(allocatedIndex);
+        }
+    }
+
+    WARN("Checksum: " << checksum);
+}
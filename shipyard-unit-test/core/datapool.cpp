@@ -0,0 +1,371 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/datapool.h>
+
+#include <utils/unittestutils.h>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test GenerationalDataPool", "[DataPool]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    Shipyard::GenerationalDataPool<uint32_t, 256> dataPool;
+    REQUIRE(dataPool.Create());
+
+    uint16_t firstGeneration = 0;
+    uint32_t firstIndex = dataPool.GetNewItemIndex(&firstGeneration);
+
+    uint16_t secondGeneration = 0;
+    uint32_t secondIndex = dataPool.GetNewItemIndex(&secondGeneration);
+
+    REQUIRE(firstIndex != secondIndex);
+
+    dataPool.GetItem(firstIndex, firstGeneration) = 12;
+    dataPool.GetItem(secondIndex, secondGeneration) = 34;
+
+    uint32_t allocatedIndex = 0;
+    uint16_t allocatedGeneration = 0;
+    REQUIRE(dataPool.GetFirstAllocatedIndex(&allocatedIndex, &allocatedGeneration));
+    REQUIRE(allocatedIndex == firstIndex);
+    REQUIRE(dataPool.GetNextAllocatedIndex(allocatedIndex, &allocatedIndex, &allocatedGeneration));
+    REQUIRE(allocatedIndex == secondIndex);
+    REQUIRE(!dataPool.GetNextAllocatedIndex(allocatedIndex, &allocatedIndex, &allocatedGeneration));
+
+    dataPool.ReleaseItem(firstIndex);
+
+    uint16_t reusedGeneration = 0;
+    uint32_t reusedIndex = dataPool.GetNewItemIndex(&reusedGeneration);
+
+    REQUIRE(reusedIndex == firstIndex);
+    REQUIRE(reusedGeneration == firstGeneration + 1);
+    REQUIRE(dataPool.GetItem(secondIndex, secondGeneration) == 34);
+
+    dataPool.ReleaseItem(reusedIndex);
+    dataPool.ReleaseItem(secondIndex);
+}
+
+TEST_CASE("Test ConcurrentGenerationalDataPool", "[DataPool]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    constexpr uint32_t maxElementsInPool = 1024;
+
+    Shipyard::ConcurrentGenerationalDataPool<uint32_t, maxElementsInPool> dataPool;
+    REQUIRE(dataPool.Create());
+
+    SECTION("Single thread")
+    {
+        uint16_t firstGeneration = 0;
+        uint32_t firstIndex = dataPool.GetNewItemIndex(&firstGeneration);
+
+        uint16_t secondGeneration = 0;
+        uint32_t secondIndex = dataPool.GetNewItemIndex(&secondGeneration);
+
+        REQUIRE(firstIndex != secondIndex);
+        REQUIRE(dataPool.GetNumAllocatedItems() == 2);
+
+        dataPool.GetItem(firstIndex, firstGeneration) = 12;
+        dataPool.GetItem(secondIndex, secondGeneration) = 34;
+
+        uint32_t allocatedIndex = 0;
+        uint16_t allocatedGeneration = 0;
+        REQUIRE(dataPool.GetFirstAllocatedIndex(&allocatedIndex, &allocatedGeneration));
+        REQUIRE(allocatedIndex == firstIndex);
+        REQUIRE(allocatedGeneration == firstGeneration);
+        REQUIRE(dataPool.GetNextAllocatedIndex(allocatedIndex, &allocatedIndex, &allocatedGeneration));
+        REQUIRE(allocatedIndex == secondIndex);
+        REQUIRE(!dataPool.GetNextAllocatedIndex(allocatedIndex, &allocatedIndex, &allocatedGeneration));
+
+        dataPool.ReleaseItem(firstIndex);
+
+        // The most recently released index is reused first, with the next generation.
+        uint16_t reusedGeneration = 0;
+        uint32_t reusedIndex = dataPool.GetNewItemIndex(&reusedGeneration);
+
+        REQUIRE(reusedIndex == firstIndex);
+        REQUIRE(reusedGeneration == firstGeneration + 1);
+        REQUIRE(dataPool.GetItem(secondIndex, secondGeneration) == 34);
+
+        dataPool.ReleaseItem(reusedIndex);
+        dataPool.ReleaseItem(secondIndex);
+
+        REQUIRE(dataPool.GetNumAllocatedItems() == 0);
+        REQUIRE(!dataPool.GetFirstAllocatedIndex(&allocatedIndex, &allocatedGeneration));
+    }
+
+    SECTION("Every index can be allocated")
+    {
+        std::vector<uint32_t> indices;
+        std::vector<bool> isIndexAllocated(maxElementsInPool, false);
+
+        for (uint32_t i = 0; i < maxElementsInPool; i++)
+        {
+            uint16_t generation = 0;
+            uint32_t index = dataPool.GetNewItemIndex(&generation);
+
+            REQUIRE(index < maxElementsInPool);
+            REQUIRE(!isIndexAllocated[index]);
+
+            isIndexAllocated[index] = true;
+            indices.push_back(index);
+        }
+
+        for (uint32_t index : indices)
+        {
+            dataPool.ReleaseItem(index);
+        }
+    }
+
+    SECTION("Multiple threads")
+    {
+        constexpr uint32_t numThreads = 4;
+        constexpr uint32_t numItemsPerThread = maxElementsInPool / numThreads;
+        constexpr uint32_t numIterations = 2000;
+
+        std::vector<uint32_t> numCorruptedItems(numThreads, 0);
+        std::vector<std::thread> threads;
+
+        // Every thread keeps its own items, writes its id in them, and checks that no other thread was handed the same index
+        // before releasing them.
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            threads.emplace_back([&dataPool, &numCorruptedItems, threadIndex]()
+            {
+                uint32_t indices[numItemsPerThread];
+                uint16_t generations[numItemsPerThread];
+
+                for (uint32_t iteration = 0; iteration < numIterations; iteration++)
+                {
+                    uint32_t numItems = 1 + (iteration % numItemsPerThread);
+
+                    for (uint32_t i = 0; i < numItems; i++)
+                    {
+                        indices[i] = dataPool.GetNewItemIndex(&generations[i]);
+                        dataPool.GetItem(indices[i], generations[i]) = threadIndex;
+                    }
+
+                    for (uint32_t i = 0; i < numItems; i++)
+                    {
+                        if (dataPool.GetItem(indices[i], generations[i]) != threadIndex)
+                        {
+                            numCorruptedItems[threadIndex] += 1;
+                        }
+
+                        dataPool.ReleaseItem(indices[i]);
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            REQUIRE(numCorruptedItems[threadIndex] == 0);
+        }
+
+        REQUIRE(dataPool.GetNumAllocatedItems() == 0);
+
+        // All indices made it back to the free list.
+        std::vector<uint32_t> indices;
+        for (uint32_t i = 0; i < maxElementsInPool; i++)
+        {
+            uint16_t generation = 0;
+            indices.push_back(dataPool.GetNewItemIndex(&generation));
+        }
+
+        for (uint32_t index : indices)
+        {
+            dataPool.ReleaseItem(index);
+        }
+    }
+}
+
+TEST_CASE("Test PagedGenerationalDataPool", "[DataPool]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    constexpr uint32_t numElementsPerPage = 16;
+
+    using PagedDataPool = Shipyard::PagedGenerationalDataPool<uint32_t, numElementsPerPage>;
+
+    PagedDataPool dataPool;
+    REQUIRE(dataPool.Create());
+
+    REQUIRE(PagedDataPool::ms_PageShift == 4);
+
+    SECTION("Nothing is allocated up front")
+    {
+        Shipyard::DataPoolStatistics statistics = dataPool.GetStatistics();
+
+        REQUIRE(statistics.numAllocatedItems == 0);
+        REQUIRE(statistics.numPages == 0);
+        REQUIRE(statistics.residentMemorySize == 0);
+
+        uint32_t allocatedIndex = 0;
+        uint16_t allocatedGeneration = 0;
+        REQUIRE(!dataPool.GetFirstAllocatedIndex(&allocatedIndex, &allocatedGeneration));
+    }
+
+    SECTION("Grows by pages")
+    {
+        constexpr uint32_t numItems = numElementsPerPage * 3 + 5;
+
+        std::vector<uint32_t> indices(numItems);
+        std::vector<uint16_t> generations(numItems);
+
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            indices[i] = dataPool.GetNewItemIndex(&generations[i]);
+            dataPool.GetItem(indices[i], generations[i]) = i;
+        }
+
+        // Pages are filled in order, so indices are handed out contiguously.
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            REQUIRE(indices[i] == i);
+            REQUIRE(dataPool.GetItem(indices[i], generations[i]) == i);
+        }
+
+        Shipyard::DataPoolStatistics statistics = dataPool.GetStatistics();
+
+        REQUIRE(statistics.numAllocatedItems == numItems);
+        REQUIRE(statistics.numPages == 4);
+        REQUIRE(statistics.numResidentPages == 4);
+        REQUIRE(statistics.capacity == numElementsPerPage * 4);
+
+        uint32_t numIteratedItems = 0;
+        uint32_t allocatedIndex = 0;
+        uint16_t allocatedGeneration = 0;
+        if (dataPool.GetFirstAllocatedIndex(&allocatedIndex, &allocatedGeneration))
+        {
+            do
+            {
+                REQUIRE(allocatedIndex == numIteratedItems);
+                numIteratedItems += 1;
+            } while (dataPool.GetNextAllocatedIndex(allocatedIndex, &allocatedIndex, &allocatedGeneration));
+        }
+
+        REQUIRE(numIteratedItems == numItems);
+
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            dataPool.ReleaseItem(indices[i]);
+        }
+    }
+
+    SECTION("Empty pages are freed")
+    {
+        constexpr uint32_t numItems = numElementsPerPage * 4;
+
+        std::vector<uint32_t> indices(numItems);
+        std::vector<uint16_t> generations(numItems);
+
+        for (uint32_t i = 0; i < numItems; i++)
+        {
+            indices[i] = dataPool.GetNewItemIndex(&generations[i]);
+        }
+
+        // Empties the second and third pages.
+        for (uint32_t i = numElementsPerPage; i < numElementsPerPage * 3; i++)
+        {
+            dataPool.ReleaseItem(indices[i]);
+        }
+
+        Shipyard::DataPoolStatistics statistics = dataPool.GetStatistics();
+
+        REQUIRE(statistics.numAllocatedItems == numElementsPerPage * 2);
+        REQUIRE(statistics.numPages == 4);
+        REQUIRE(statistics.numResidentPages == 2);
+
+        uint32_t allocatedIndex = 0;
+        uint16_t allocatedGeneration = 0;
+        REQUIRE(dataPool.GetNextAllocatedIndex(numElementsPerPage - 1, &allocatedIndex, &allocatedGeneration));
+        REQUIRE(allocatedIndex == numElementsPerPage * 3);
+
+        // Reusing a slot of a freed page gives it its elements back, with the next generation.
+        uint16_t newGeneration = 0;
+        uint32_t newIndex = dataPool.GetNewItemIndex(&newGeneration);
+
+        REQUIRE(newIndex == numElementsPerPage);
+        REQUIRE(newGeneration == generations[numElementsPerPage] + 1);
+        REQUIRE(dataPool.GetStatistics().numResidentPages == 3);
+
+        dataPool.ReleaseItem(newIndex);
+
+        for (uint32_t i = 0; i < numElementsPerPage; i++)
+        {
+            dataPool.ReleaseItem(indices[i]);
+            dataPool.ReleaseItem(indices[i + numElementsPerPage * 3]);
+        }
+
+        // The last page is kept around.
+        statistics = dataPool.GetStatistics();
+
+        REQUIRE(statistics.numAllocatedItems == 0);
+        REQUIRE(statistics.numResidentPages == 1);
+    }
+
+    SECTION("Multiple threads")
+    {
+        constexpr uint32_t numThreads = 4;
+        constexpr uint32_t numItemsPerThread = 100;
+        constexpr uint32_t numIterations = 200;
+
+        std::vector<uint32_t> numCorruptedItems(numThreads, 0);
+        std::vector<std::thread> threads;
+
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            threads.emplace_back([&dataPool, &numCorruptedItems, threadIndex]()
+            {
+                uint32_t indices[numItemsPerThread];
+                uint16_t generations[numItemsPerThread];
+
+                for (uint32_t iteration = 0; iteration < numIterations; iteration++)
+                {
+                    uint32_t numItems = 1 + (iteration % numItemsPerThread);
+
+                    for (uint32_t i = 0; i < numItems; i++)
+                    {
+                        indices[i] = dataPool.GetNewItemIndex(&generations[i]);
+                        dataPool.GetItem(indices[i], generations[i]) = threadIndex;
+                    }
+
+                    for (uint32_t i = 0; i < numItems; i++)
+                    {
+                        if (dataPool.GetItem(indices[i], generations[i]) != threadIndex)
+                        {
+                            numCorruptedItems[threadIndex] += 1;
+                        }
+
+                        dataPool.ReleaseItem(indices[i]);
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            REQUIRE(numCorruptedItems[threadIndex] == 0);
+        }
+
+        Shipyard::DataPoolStatistics statistics = dataPool.GetStatistics();
+
+        REQUIRE(statistics.numAllocatedItems == 0);
+        REQUIRE(statistics.numPages <= (numThreads * numItemsPerThread + numElementsPerPage - 1) / numElementsPerPage);
+        REQUIRE(statistics.numResidentPages == 1);
+    }
+}
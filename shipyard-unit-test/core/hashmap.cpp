@@ -0,0 +1,392 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/hashmap.h>
+#include <system/memory/fixedheapallocator.h>
+#include <system/string.h>
+
+#include <utils/unittestutils.h>
+
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Sends every key to the same few groups, to exercise long probes and deleted slots.
+    struct CollidingHasher
+    {
+        uint64_t operator() (uint32_t key) const
+        {
+            return uint64_t(key & 3);
+        }
+    };
+
+    struct LiveCountingValue
+    {
+        LiveCountingValue(uint32_t value = 0)
+            : value(value)
+        {
+            ms_NumLiveValues += 1;
+        }
+
+        LiveCountingValue(const LiveCountingValue& src)
+            : value(src.value)
+        {
+            ms_NumLiveValues += 1;
+        }
+
+        LiveCountingValue(LiveCountingValue&& src)
+            : value(src.value)
+        {
+            ms_NumLiveValues += 1;
+        }
+
+        ~LiveCountingValue()
+        {
+            ms_NumLiveValues -= 1;
+        }
+
+        uint32_t value;
+
+        static int ms_NumLiveValues;
+    };
+
+    int LiveCountingValue::ms_NumLiveValues = 0;
+}
+
+TEST_CASE("Test HashMap", "[HashMap]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    SECTION("Empty map")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        REQUIRE(map.Size() == 0);
+        REQUIRE(map.Capacity() == 0);
+        REQUIRE(map.Empty());
+        REQUIRE(map.Find(42) == nullptr);
+        REQUIRE(!map.Exists(42));
+        REQUIRE(!map.Remove(42));
+        REQUIRE(map.begin() == map.end());
+    }
+
+    SECTION("Insert and find")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        const uint32_t numElements = 10000;
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            REQUIRE(map.Insert(i * 7, i));
+        }
+
+        REQUIRE(map.Size() == numElements);
+        REQUIRE(map.Capacity() >= numElements);
+        REQUIRE((map.Capacity() & (map.Capacity() - 1)) == 0);
+
+        REQUIRE(!map.Insert(7, 42));
+        REQUIRE(*map.Find(7) == 1);
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            uint32_t* pValue = map.Find(i * 7);
+            REQUIRE(pValue != nullptr);
+            REQUIRE(*pValue == i);
+
+            REQUIRE(map.Find(i * 7 + 1) == nullptr);
+        }
+
+        uint32_t numIteratedElements = 0;
+        uint64_t sumOfValues = 0;
+        for (const Shipyard::HashMapEntry<uint32_t, uint32_t>& entry : map)
+        {
+            REQUIRE(entry.key == entry.value * 7);
+
+            numIteratedElements += 1;
+            sumOfValues += entry.value;
+        }
+
+        REQUIRE(numIteratedElements == numElements);
+        REQUIRE(sumOfValues == uint64_t(numElements) * (numElements - 1) / 2);
+    }
+
+    SECTION("operator[]")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        REQUIRE(map[3] == 0);
+        REQUIRE(map.Size() == 1);
+
+        map[3] = 12;
+        map[4] += 2;
+        map[4] += 2;
+
+        REQUIRE(map.Size() == 2);
+        REQUIRE(*map.Find(3) == 12);
+        REQUIRE(*map.Find(4) == 4);
+    }
+
+    SECTION("Remove")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        const uint32_t numElements = 1000;
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            map.Insert(i, i);
+        }
+
+        for (uint32_t i = 0; i < numElements; i += 2)
+        {
+            REQUIRE(map.Remove(i));
+            REQUIRE(!map.Remove(i));
+        }
+
+        REQUIRE(map.Size() == numElements / 2);
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            REQUIRE(map.Exists(i) == ((i % 2) == 1));
+        }
+
+        uint32_t numIteratedElements = 0;
+        for (const Shipyard::HashMapEntry<uint32_t, uint32_t>& entry : map)
+        {
+            REQUIRE((entry.key % 2) == 1);
+            numIteratedElements += 1;
+        }
+
+        REQUIRE(numIteratedElements == numElements / 2);
+    }
+
+    SECTION("Collisions and deleted slots")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t, CollidingHasher> map;
+
+        // Adding and removing keys over and over fills the table with deleted slots, which must be reclaimed by rehashing at
+        // the same capacity rather than by growing forever.
+        for (uint32_t round = 0; round < 64; round++)
+        {
+            for (uint32_t i = 0; i < 40; i++)
+            {
+                REQUIRE(map.Insert(round * 100 + i, i));
+            }
+
+            for (uint32_t i = 0; i < 40; i++)
+            {
+                REQUIRE(*map.Find(round * 100 + i) == i);
+            }
+
+            for (uint32_t i = 0; i < 40; i++)
+            {
+                REQUIRE(map.Remove(round * 100 + i));
+            }
+
+            REQUIRE(map.Empty());
+        }
+
+        REQUIRE(map.Capacity() <= 64);
+    }
+
+    SECTION("Reserve")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        map.Reserve(1000);
+
+        uint32_t capacity = map.Capacity();
+        REQUIRE(capacity >= 1000);
+
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            map.Insert(i, i);
+        }
+
+        REQUIRE(map.Capacity() == capacity);
+
+        map.Clear();
+
+        REQUIRE(map.Size() == 0);
+        REQUIRE(map.Capacity() == 0);
+        REQUIRE(!map.Exists(0));
+    }
+
+    SECTION("String keys")
+    {
+        Shipyard::HashMap<Shipyard::StringA, uint32_t> map;
+
+        map.Insert("albedo", 0);
+        map.Insert("normal", 1);
+        map["roughness"] = 2;
+
+        REQUIRE(map.Size() == 3);
+        REQUIRE(*map.Find("albedo") == 0);
+        REQUIRE(*map.Find("normal") == 1);
+        REQUIRE(*map.Find("roughness") == 2);
+        REQUIRE(map.Find("metalness") == nullptr);
+
+        REQUIRE(map.Remove("normal"));
+        REQUIRE(map.Find("normal") == nullptr);
+    }
+
+    SECTION("Elements are destroyed")
+    {
+        LiveCountingValue::ms_NumLiveValues = 0;
+
+        {
+            Shipyard::HashMap<uint32_t, LiveCountingValue> map;
+
+            for (uint32_t i = 0; i < 500; i++)
+            {
+                map.Emplace(i, i);
+            }
+
+            REQUIRE(LiveCountingValue::ms_NumLiveValues == 500);
+
+            for (uint32_t i = 0; i < 100; i++)
+            {
+                map.Remove(i);
+            }
+
+            REQUIRE(LiveCountingValue::ms_NumLiveValues == 400);
+
+            Shipyard::HashMap<uint32_t, LiveCountingValue> copiedMap = map;
+
+            REQUIRE(LiveCountingValue::ms_NumLiveValues == 800);
+            REQUIRE(copiedMap.Find(250)->value == 250);
+        }
+
+        REQUIRE(LiveCountingValue::ms_NumLiveValues == 0);
+    }
+
+    SECTION("Copy and move")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map;
+
+        for (uint32_t i = 0; i < 100; i++)
+        {
+            map.Insert(i, i * 2);
+        }
+
+        Shipyard::HashMap<uint32_t, uint32_t> copiedMap = map;
+
+        REQUIRE(copiedMap.Size() == 100);
+        REQUIRE(*copiedMap.Find(50) == 100);
+
+        copiedMap.Insert(1000, 0);
+        REQUIRE(!map.Exists(1000));
+
+        Shipyard::HashMap<uint32_t, uint32_t> movedMap = std::move(map);
+
+        REQUIRE(map.Size() == 0);
+        REQUIRE(map.Capacity() == 0);
+        REQUIRE(movedMap.Size() == 100);
+        REQUIRE(*movedMap.Find(99) == 198);
+
+        map = movedMap;
+
+        REQUIRE(map.Size() == 100);
+        REQUIRE(*map.Find(99) == 198);
+    }
+}
+
+TEST_CASE("Test HashSet", "[HashMap]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    Shipyard::HashSet<uint32_t> set;
+
+    REQUIRE(set.Add(1));
+    REQUIRE(set.Add(2));
+    REQUIRE(!set.Add(1));
+
+    REQUIRE(set.Size() == 2);
+    REQUIRE(set.Exists(1));
+    REQUIRE(set.Exists(2));
+    REQUIRE(!set.Exists(3));
+
+    REQUIRE(set.Remove(1));
+    REQUIRE(!set.Exists(1));
+    REQUIRE(set.Size() == 1);
+}
+
+TEST_CASE("Benchmark HashMap", "[.][Benchmark][HashMap]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    const uint32_t numElements = 1000000;
+
+    // The map grows past what the global allocator of the tests can hold.
+    const size_t heapSize = 64 * 1024 * 1024;
+
+    Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 16);
+
+    Shipyard::FixedHeapAllocator fixedHeapAllocator;
+    fixedHeapAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+    std::vector<uint32_t> keys(numElements);
+
+    std::mt19937 randomEngine(1234);
+    for (uint32_t& key : keys)
+    {
+        key = uint32_t(randomEngine());
+    }
+
+    uint64_t checksum = 0;
+
+    BENCHMARK("HashMap insert and find")
+    {
+        Shipyard::HashMap<uint32_t, uint32_t> map(&fixedHeapAllocator);
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            map[keys[i]] = i;
+        }
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            checksum += *map.Find(keys[i]);
+            checksum += (map.Find(keys[i] ^ 0x55555555) != nullptr);
+        }
+    }
+
+    BENCHMARK("std::unordered_map insert and find")
+    {
+        std::unordered_map<uint32_t, uint32_t> map;
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            map[keys[i]] = i;
+        }
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            checksum += map.find(keys[i])->second;
+            checksum += (map.find(keys[i] ^ 0x55555555) != map.end());
+        }
+    }
+
+    BENCHMARK("std::map insert and find")
+    {
+        std::map<uint32_t, uint32_t> map;
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            map[keys[i]] = i;
+        }
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            checksum += map.find(keys[i])->second;
+            checksum += (map.find(keys[i] ^ 0x55555555) != map.end());
+        }
+    }
+
+    fixedHeapAllocator.Destroy();
+
+    WARN("Checksum: " << checksum);
+}
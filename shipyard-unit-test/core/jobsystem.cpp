@@ -0,0 +1,511 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/jobsystem.h>
+#include <system/memory.h>
+#include <system/workstealingdeque.h>
+
+#include <utils/unittestutils.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Test WorkStealingDeque", "[JobSystem]")
+{
+    uint32_t values[16];
+
+    SECTION("Owner pops in LIFO order, thieves steal in FIFO order")
+    {
+        Shipyard::WorkStealingDeque<uint32_t*, 16> deque;
+
+        REQUIRE(deque.Pop() == nullptr);
+        REQUIRE(deque.Steal() == nullptr);
+
+        REQUIRE(deque.Push(&values[0]));
+        REQUIRE(deque.Push(&values[1]));
+        REQUIRE(deque.Push(&values[2]));
+        REQUIRE(deque.Size() == 3);
+
+        REQUIRE(deque.Steal() == &values[0]);
+        REQUIRE(deque.Pop() == &values[2]);
+        REQUIRE(deque.Pop() == &values[1]);
+        REQUIRE(deque.Pop() == nullptr);
+        REQUIRE(deque.Steal() == nullptr);
+        REQUIRE(deque.Size() == 0);
+    }
+
+    SECTION("Full deque")
+    {
+        Shipyard::WorkStealingDeque<uint32_t*, 4> deque;
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            REQUIRE(deque.Push(&values[i]));
+        }
+
+        REQUIRE(!deque.Push(&values[4]));
+
+        REQUIRE(deque.Steal() == &values[0]);
+        REQUIRE(deque.Push(&values[4]));
+
+        for (uint32_t i = 4; i > 0; i--)
+        {
+            REQUIRE(deque.Pop() == &values[i]);
+        }
+    }
+
+    SECTION("Owner and thieves take every element once")
+    {
+        constexpr uint32_t numElements = 200000;
+        constexpr uint32_t numThieves = 3;
+
+        std::vector<uint32_t> elements(numElements, 0);
+        std::vector<uint32_t> numTimesTaken(numElements, 0);
+
+        Shipyard::WorkStealingDeque<uint32_t*, 256> deque;
+        volatile uint32_t isOwnerDone = 0;
+
+        auto take = [&](uint32_t* pElement)
+        {
+            Shipyard::AtomicOperations::Increment(numTimesTaken[pElement - &elements[0]]);
+        };
+
+        std::vector<std::thread> thieves;
+        for (uint32_t i = 0; i < numThieves; i++)
+        {
+            thieves.emplace_back([&]()
+            {
+                while (Shipyard::AtomicOperations::Load(isOwnerDone) == 0 || deque.Size() > 0)
+                {
+                    uint32_t* pElement = deque.Steal();
+                    if (pElement != nullptr)
+                    {
+                        take(pElement);
+                    }
+                }
+            });
+        }
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            while (!deque.Push(&elements[i]))
+            {
+                uint32_t* pElement = deque.Pop();
+                if (pElement != nullptr)
+                {
+                    take(pElement);
+                }
+            }
+
+            // Popping every few pushes so that the owner and the thieves race for the last elements.
+            if ((i % 3) == 0)
+            {
+                uint32_t* pElement = deque.Pop();
+                if (pElement != nullptr)
+                {
+                    take(pElement);
+                }
+            }
+        }
+
+        uint32_t* pElement = nullptr;
+        while ((pElement = deque.Pop()) != nullptr)
+        {
+            take(pElement);
+        }
+
+        Shipyard::AtomicOperations::Store(isOwnerDone, 1u);
+
+        for (std::thread& thief : thieves)
+        {
+            thief.join();
+        }
+
+        uint32_t numElementsNotTakenOnce = 0;
+        for (uint32_t numTimes : numTimesTaken)
+        {
+            numElementsNotTakenOnce += (numTimes != 1);
+        }
+
+        REQUIRE(numElementsNotTakenOnce == 0);
+    }
+}
+
+TEST_CASE("Test JobSystem", "[JobSystem]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    Shipyard::JobSystem jobSystem;
+    REQUIRE(jobSystem.Create(4, 1024));
+    REQUIRE(jobSystem.GetNumThreads() == 4);
+    REQUIRE(jobSystem.GetCurrentThreadIndex() == 0);
+
+    SECTION("Run and wait for a counter")
+    {
+        constexpr uint32_t numJobs = 500;
+
+        volatile uint32_t numJobsRun = 0;
+        Shipyard::JobCounter counter;
+
+        for (uint32_t i = 0; i < numJobs; i++)
+        {
+            jobSystem.Run([&numJobsRun]()
+            {
+                Shipyard::AtomicOperations::Increment(numJobsRun);
+            }, &counter);
+        }
+
+        jobSystem.WaitForCounter(counter);
+
+        REQUIRE(counter.IsDone());
+        REQUIRE(numJobsRun == numJobs);
+    }
+
+    SECTION("Run with user data")
+    {
+        volatile uint32_t value = 0;
+        Shipyard::JobCounter counter;
+
+        jobSystem.Run([](void* pUserData)
+        {
+            *static_cast<volatile uint32_t*>(pUserData) = 42;
+        }, const_cast<uint32_t*>(&value), &counter);
+
+        jobSystem.WaitForCounter(counter);
+
+        REQUIRE(value == 42);
+    }
+
+    SECTION("Nested jobs waiting on their own counters")
+    {
+        constexpr uint32_t numOuterJobs = 16;
+        constexpr uint32_t numInnerJobs = 64;
+
+        volatile uint32_t numInnerJobsRun = 0;
+        Shipyard::JobCounter counter;
+
+        for (uint32_t i = 0; i < numOuterJobs; i++)
+        {
+            jobSystem.Run([&jobSystem, &numInnerJobsRun]()
+            {
+                Shipyard::JobCounter innerCounter;
+
+                for (uint32_t j = 0; j < numInnerJobs; j++)
+                {
+                    jobSystem.Run([&numInnerJobsRun]()
+                    {
+                        Shipyard::AtomicOperations::Increment(numInnerJobsRun);
+                    }, &innerCounter);
+                }
+
+                jobSystem.WaitForCounter(innerCounter);
+            }, &counter);
+        }
+
+        jobSystem.WaitForCounter(counter);
+
+        REQUIRE(numInnerJobsRun == numOuterJobs * numInnerJobs);
+    }
+
+    SECTION("Dependencies")
+    {
+        constexpr uint32_t numStages = 8;
+        constexpr uint32_t numJobsPerStage = 32;
+
+        // Each stage only starts once the previous one is done, so every job of a stage sees the previous stage complete.
+        volatile uint32_t numJobsRun = 0;
+        volatile uint32_t numJobsStartedTooEarly = 0;
+
+        Shipyard::JobCounter counters[numStages];
+
+        for (uint32_t stage = 0; stage < numStages; stage++)
+        {
+            Shipyard::JobCounter* pDependencyCounter = ((stage > 0) ? &counters[stage - 1] : nullptr);
+
+            for (uint32_t i = 0; i < numJobsPerStage; i++)
+            {
+                jobSystem.Run([&numJobsRun, &numJobsStartedTooEarly, stage]()
+                {
+                    if (Shipyard::AtomicOperations::Load(numJobsRun) < stage * numJobsPerStage)
+                    {
+                        Shipyard::AtomicOperations::Increment(numJobsStartedTooEarly);
+                    }
+
+                    std::this_thread::yield();
+
+                    Shipyard::AtomicOperations::Increment(numJobsRun);
+                }, &counters[stage], pDependencyCounter);
+            }
+        }
+
+        jobSystem.WaitForCounter(counters[numStages - 1]);
+
+        for (Shipyard::JobCounter& counter : counters)
+        {
+            REQUIRE(counter.IsDone());
+        }
+
+        REQUIRE(numJobsRun == numStages * numJobsPerStage);
+        REQUIRE(numJobsStartedTooEarly == 0);
+    }
+
+    SECTION("Dependent jobs added while the dependency finishes")
+    {
+        constexpr uint32_t numIterations = 10000;
+
+        // The single job of the first counter races with adding the dependent job to it, which must always end up started.
+        for (uint32_t i = 0; i < numIterations; i++)
+        {
+            Shipyard::JobCounter firstCounter;
+            Shipyard::JobCounter secondCounter;
+            Shipyard::JobCounter thirdCounter;
+
+            volatile uint32_t numJobsRun = 0;
+
+            jobSystem.Run([&numJobsRun]() { Shipyard::AtomicOperations::Increment(numJobsRun); }, &firstCounter);
+            jobSystem.Run([&numJobsRun]() { Shipyard::AtomicOperations::Increment(numJobsRun); }, &secondCounter, &firstCounter);
+            jobSystem.Run([&numJobsRun]() { Shipyard::AtomicOperations::Increment(numJobsRun); }, &thirdCounter, &secondCounter);
+
+            jobSystem.WaitForCounter(thirdCounter);
+
+            REQUIRE(firstCounter.IsDone());
+            REQUIRE(secondCounter.IsDone());
+            REQUIRE(numJobsRun == 3);
+        }
+    }
+
+    SECTION("Depending on a done counter")
+    {
+        Shipyard::JobCounter doneCounter;
+        Shipyard::JobCounter counter;
+
+        volatile uint32_t value = 0;
+        jobSystem.Run([&value]() { value = 1; }, &counter, &doneCounter);
+
+        jobSystem.WaitForCounter(counter);
+
+        REQUIRE(value == 1);
+    }
+
+    SECTION("ParallelFor over indices")
+    {
+        constexpr uint32_t numIndices = 10007;
+
+        std::vector<uint32_t> numTimesVisited(numIndices, 0);
+
+        jobSystem.ParallelFor(0, numIndices, [&numTimesVisited](uint32_t index)
+        {
+            numTimesVisited[index] += 1;
+        });
+
+        uint32_t numIndicesNotVisitedOnce = 0;
+        for (uint32_t numTimes : numTimesVisited)
+        {
+            numIndicesNotVisitedOnce += (numTimes != 1);
+        }
+
+        REQUIRE(numIndicesNotVisitedOnce == 0);
+
+        uint32_t numCalls = 0;
+        jobSystem.ParallelFor(5, 5, [&numCalls](uint32_t) { numCalls += 1; });
+        jobSystem.ParallelFor(10, 11, [&numCalls](uint32_t index) { numCalls += index; }, 64);
+
+        REQUIRE(numCalls == 10);
+    }
+
+    SECTION("ParallelFor over an Array")
+    {
+        Shipyard::Array<uint32_t> elements;
+        for (uint32_t i = 0; i < 5000; i++)
+        {
+            elements.Add(i);
+        }
+
+        jobSystem.ParallelFor(elements, [](uint32_t& element)
+        {
+            element *= 2;
+        }, 100);
+
+        uint32_t numWrongElements = 0;
+        for (uint32_t i = 0; i < elements.Size(); i++)
+        {
+            numWrongElements += (elements[i] != i * 2);
+        }
+
+        REQUIRE(numWrongElements == 0);
+
+        const Shipyard::Array<uint32_t>& constElements = elements;
+
+        volatile uint64_t sum = 0;
+        jobSystem.ParallelFor(constElements, [&sum](const uint32_t& element)
+        {
+            Shipyard::AtomicOperations::Add(sum, uint64_t(element));
+        });
+
+        REQUIRE(sum == uint64_t(4999) * 5000);
+    }
+
+    SECTION("Jobs run from a thread outside of the job system")
+    {
+        volatile uint32_t numJobsRun = 0;
+
+        std::thread externalThread([&jobSystem, &numJobsRun]()
+        {
+            REQUIRE(jobSystem.GetCurrentThreadIndex() == Shipyard::JobSystem::InvalidThreadIndex);
+
+            Shipyard::JobCounter counter;
+
+            for (uint32_t i = 0; i < 100; i++)
+            {
+                jobSystem.Run([&numJobsRun]()
+                {
+                    Shipyard::AtomicOperations::Increment(numJobsRun);
+                }, &counter);
+            }
+
+            jobSystem.WaitForCounter(counter);
+        });
+
+        externalThread.join();
+
+        REQUIRE(numJobsRun == 100);
+    }
+
+    jobSystem.Destroy();
+}
+
+TEST_CASE("Test JobSystem running jobs inline", "[JobSystem]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    // Without worker threads, nothing runs until the main thread waits, so the pool runs out after 16 jobs.
+    Shipyard::JobSystem jobSystem;
+    REQUIRE(jobSystem.Create(1, 16));
+
+    constexpr uint32_t numJobs = 100;
+
+    uint32_t order[numJobs];
+    uint32_t numJobsRun = 0;
+
+    Shipyard::JobCounter counter;
+    for (uint32_t i = 0; i < numJobs; i++)
+    {
+        jobSystem.Run([&order, &numJobsRun, i]()
+        {
+            order[numJobsRun] = i;
+            numJobsRun += 1;
+        }, &counter);
+    }
+
+    REQUIRE(numJobsRun == numJobs - 16);
+    REQUIRE(order[0] == 16);
+
+    jobSystem.WaitForCounter(counter);
+
+    REQUIRE(numJobsRun == numJobs);
+
+    // Queued jobs are run in LIFO order by their thread.
+    REQUIRE(order[numJobs - 16] == 15);
+    REQUIRE(order[numJobs - 1] == 0);
+
+    Shipyard::JobSystem::Statistics statistics = jobSystem.GetStatistics();
+    REQUIRE(statistics.numJobsExecutedInline == numJobs - 16);
+    REQUIRE(statistics.numJobsExecuted == 16);
+    REQUIRE(statistics.numJobsStolen == 0);
+
+    jobSystem.Destroy();
+}
+
+TEST_CASE("Benchmark JobSystem", "[.][Benchmark][JobSystem]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    Shipyard::JobSystem jobSystem;
+    REQUIRE(jobSystem.Create(0, 8192));
+
+    WARN("Job system threads: " << jobSystem.GetNumThreads());
+
+    SECTION("Empty jobs throughput")
+    {
+        constexpr uint32_t numRounds = 100;
+        constexpr uint32_t numJobsPerRound = 4000;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t round = 0; round < numRounds; round++)
+        {
+            Shipyard::JobCounter counter;
+
+            for (uint32_t i = 0; i < numJobsPerRound; i++)
+            {
+                jobSystem.Run([]() {}, &counter);
+            }
+
+            jobSystem.WaitForCounter(counter);
+        }
+
+        std::chrono::duration<double, std::nano> elapsedTime = std::chrono::high_resolution_clock::now() - startTime;
+
+        WARN("Empty jobs: " << (elapsedTime.count() / (numRounds * numJobsPerRound)) << " ns per job, "
+                << (numRounds * numJobsPerRound / elapsedTime.count() * 1000.0) << " million jobs per second");
+    }
+
+    SECTION("Fan-out and fan-in latency")
+    {
+        constexpr uint32_t numRounds = 2000;
+
+        uint32_t numJobsPerRound = jobSystem.GetNumThreads() * 4;
+
+        // Workers are kept awake between rounds, so that this measures scheduling and not waking threads up.
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t round = 0; round < numRounds; round++)
+        {
+            Shipyard::JobCounter counter;
+
+            for (uint32_t i = 0; i < numJobsPerRound; i++)
+            {
+                jobSystem.Run([]() {}, &counter);
+            }
+
+            jobSystem.WaitForCounter(counter);
+        }
+
+        std::chrono::duration<double, std::micro> elapsedTime = std::chrono::high_resolution_clock::now() - startTime;
+
+        WARN("Fan-out of " << numJobsPerRound << " jobs and fan-in: " << (elapsedTime.count() / numRounds) << " us per round");
+    }
+
+    SECTION("Steal rate")
+    {
+        constexpr uint32_t numIndices = 1 << 20;
+
+        std::vector<uint32_t> values(numIndices, 1);
+
+        Shipyard::JobSystem::Statistics statisticsBefore = jobSystem.GetStatistics();
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < 20; i++)
+        {
+            jobSystem.ParallelFor(0, numIndices, [&values](uint32_t index)
+            {
+                values[index] = values[index] * 3 + 1;
+            }, 1024);
+        }
+
+        std::chrono::duration<double, std::milli> elapsedTime = std::chrono::high_resolution_clock::now() - startTime;
+
+        Shipyard::JobSystem::Statistics statistics = jobSystem.GetStatistics();
+
+        uint64_t numJobsExecuted = statistics.numJobsExecuted - statisticsBefore.numJobsExecuted;
+        uint64_t numJobsStolen = statistics.numJobsStolen - statisticsBefore.numJobsStolen;
+
+        WARN("ParallelFor: " << (elapsedTime.count() / 20) << " ms per pass, " << numJobsStolen << " of " << numJobsExecuted
+                << " jobs stolen (" << (100.0 * numJobsStolen / MAX(numJobsExecuted, uint64_t(1))) << "%)");
+    }
+
+    jobSystem.Destroy();
+}
@@ -0,0 +1,378 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/logger.h>
+#include <system/logrecord.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <typename... Args>
+    std::string FormatLogMessageForTest(const char* format, const Args&... args)
+    {
+        std::vector<uint8_t> arguments(Shipyard::LogRecordInternal::GetEncodedLogArgumentsSize(args...) + 1);
+        Shipyard::LogRecordInternal::EncodeLogArguments(arguments.data(), args...);
+
+        char buffer[Shipyard::MaxLogMessageSize];
+        size_t length = Shipyard::FormatLogMessage(format, arguments.data(), arguments.size() - 1, buffer, sizeof(buffer));
+
+        REQUIRE(length == strlen(buffer));
+
+        return std::string(buffer, length);
+    }
+
+    enum class TestLogEnum : uint8_t
+    {
+        Value = 7
+    };
+}
+
+TEST_CASE("Test FormatLogMessage", "[Logger]")
+{
+    SECTION("Same output as printf")
+    {
+        int value = -42;
+        const char* pString = "string";
+        char stringArray[] = "array";
+
+        char expected[256];
+
+        snprintf(expected, sizeof(expected), "%d %u %llu %lld %x %08X %c", value, 42u, 1ull << 40, -(1ll << 40), 255u, 0xbeefu, 'z');
+        REQUIRE(FormatLogMessageForTest("%d %u %llu %lld %x %08X %c", value, 42u, 1ull << 40, -(1ll << 40), 255u, 0xbeefu, 'z') == expected);
+
+        snprintf(expected, sizeof(expected), "%.2f %e %g %10.3f", 3.14159, 1.5e10, 0.25f, -2.5);
+        REQUIRE(FormatLogMessageForTest("%.2f %e %g %10.3f", 3.14159, 1.5e10, 0.25f, -2.5) == expected);
+
+        snprintf(expected, sizeof(expected), "[%s] [%-8s] [%8s] [%.3s] [%s]", pString, pString, stringArray, pString, "literal");
+        REQUIRE(FormatLogMessageForTest("[%s] [%-8s] [%8s] [%.3s] [%s]", pString, pString, stringArray, pString, "literal") == expected);
+
+        snprintf(expected, sizeof(expected), "0x%p %*d %-*d|%.*f 100%%", &value, 6, value, 4, 1, 2, 1.0 / 3.0);
+        REQUIRE(FormatLogMessageForTest("0x%p %*d %-*d|%.*f 100%%", &value, 6, value, 4, 1, 2, 1.0 / 3.0) == expected);
+
+        // Negative 32 bits integers formatted as unsigned aren't sign extended.
+        int32_t hresult = int32_t(0x80004005);
+        short negativeShort = -2;
+        signed char negativeChar = -3;
+
+        snprintf(expected, sizeof(expected), "0x%x %u %hx %hu %hhx %hd %hhd", hresult, -1, negativeShort, negativeShort, negativeChar, 70000, 200);
+        REQUIRE(FormatLogMessageForTest("0x%x %u %hx %hu %hhx %hd %hhd", hresult, -1, negativeShort, negativeShort, negativeChar, 70000, 200) == expected);
+        REQUIRE(FormatLogMessageForTest("0x%x", hresult) == "0x80004005");
+
+        REQUIRE(FormatLogMessageForTest("No conversion") == "No conversion");
+        REQUIRE(FormatLogMessageForTest("%d", TestLogEnum::Value) == "7");
+        REQUIRE(FormatLogMessageForTest("%d %d", true, false) == "1 0");
+    }
+
+    SECTION("Length modifiers don't need to match")
+    {
+        REQUIRE(FormatLogMessageForTest("%u %hu %I64u %zu", 1ull << 33, 65536u, 3u, size_t(4)) == "8589934592 65536 3 4");
+        REQUIRE(FormatLogMessageForTest("%llx", 255u) == "ff");
+    }
+
+    SECTION("Mismatched and missing arguments")
+    {
+        REQUIRE(FormatLogMessageForTest("%d and %s", "text", 5) == "text and 5");
+        REQUIRE(FormatLogMessageForTest("%s", 2.5) == "2.5");
+        REQUIRE(FormatLogMessageForTest("%d, %u, %s", -1) == "-1, %u, %s");
+        REQUIRE(FormatLogMessageForTest("%*d", 5) == "%*d");
+        REQUIRE(FormatLogMessageForTest("trailing %") == "trailing %");
+        REQUIRE(FormatLogMessageForTest("%y %d", 3) == "%y 3");
+    }
+
+    SECTION("Null and long strings")
+    {
+        const char* pNullString = nullptr;
+        REQUIRE(FormatLogMessageForTest("[%s]", pNullString) == "[]");
+
+        std::string longString(2 * Shipyard::MaxLogMessageSize, 'a');
+        std::string message = FormatLogMessageForTest("%s", longString.c_str());
+
+        REQUIRE(message.size() == Shipyard::MaxLogMessageSize - 1);
+    }
+
+    SECTION("Truncated to the buffer size")
+    {
+        uint8_t arguments[64];
+        Shipyard::LogRecordInternal::EncodeLogArguments(arguments, 123456789);
+
+        char buffer[6];
+        size_t length = Shipyard::FormatLogMessage("ab%dcd", arguments, Shipyard::LogRecordInternal::GetEncodedLogArgumentsSize(123456789), buffer, sizeof(buffer));
+
+        REQUIRE(length == 5);
+        REQUIRE(std::string(buffer) == "ab123");
+    }
+}
+
+#ifdef SHIP_ENABLE_LOGGING
+
+TEST_CASE("Test Logger", "[Logger]")
+{
+    const char* logFilename = "shipyard_unit_test_logger.log";
+
+    Shipyard::Logger& logger = Shipyard::GetLogger();
+    logger.SetLogLevel(Shipyard::LogLevel_FullLog);
+
+    SECTION("Messages of every thread are written")
+    {
+        constexpr uint32_t numThreads = 4;
+        constexpr uint32_t numMessagesPerThread = 1000;
+
+        logger.SetFlushPolicy(Shipyard::LogFlushPolicy::Periodic, 5);
+
+        REQUIRE(logger.OpenLog(logFilename));
+
+        uint64_t numDroppedMessagesBefore = logger.GetNumDroppedMessages();
+
+        std::vector<std::thread> threads;
+
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            threads.emplace_back([&logger, threadIndex]()
+            {
+                for (uint32_t i = 0; i < numMessagesPerThread; i++)
+                {
+                    logger.LogInfo("thread %u message %u", threadIndex, i);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        logger.Flush();
+
+        uint64_t numDroppedMessages = logger.GetNumDroppedMessages() - numDroppedMessagesBefore;
+
+        logger.CloseLog();
+
+        // Messages are dropped when a thread logs faster than the writer thread drains its ring buffer, every other message
+        // is written in the order it was logged.
+        std::ifstream logFile(logFilename);
+
+        uint32_t nextMessagePerThread[numThreads] = {};
+        uint32_t numWrittenMessages = 0;
+        uint32_t numUnorderedMessages = 0;
+        uint64_t numReportedDroppedMessages = 0;
+
+        std::string line;
+        while (std::getline(logFile, line))
+        {
+            size_t headerPos = line.find(" [INFO]    thread ");
+
+            if (headerPos == std::string::npos)
+            {
+                unsigned long long numDroppedMessagesInLine = 0;
+                size_t warningPos = line.find(" [WARNING] ");
+
+                if (warningPos != std::string::npos && sscanf(line.c_str() + warningPos, " [WARNING] %llu messages were dropped", &numDroppedMessagesInLine) == 1)
+                {
+                    numReportedDroppedMessages += numDroppedMessagesInLine;
+                }
+
+                continue;
+            }
+
+            uint32_t threadIndex = 0;
+            uint32_t messageIndex = 0;
+
+            if (sscanf(line.c_str() + headerPos, " [INFO]    thread %u message %u", &threadIndex, &messageIndex) != 2 ||
+                threadIndex >= numThreads ||
+                messageIndex < nextMessagePerThread[threadIndex])
+            {
+                numUnorderedMessages += 1;
+                continue;
+            }
+
+            nextMessagePerThread[threadIndex] = messageIndex + 1;
+            numWrittenMessages += 1;
+        }
+
+        REQUIRE(numUnorderedMessages == 0);
+        REQUIRE(numWrittenMessages + numDroppedMessages == numThreads * numMessagesPerThread);
+        REQUIRE(numReportedDroppedMessages == numDroppedMessages);
+    }
+
+    SECTION("Messages are written when the log is closed")
+    {
+        logger.SetFlushPolicy(Shipyard::LogFlushPolicy::OnClose);
+
+        REQUIRE(logger.OpenLog(logFilename));
+
+        logger.LogWarning("first %s", "warning");
+        logger.LogError("an error");
+
+        logger.SetLogLevel(Shipyard::LogLevel_Error);
+        logger.LogWarning("filtered out");
+
+        logger.CloseLog();
+
+        // Logging to a closed log does nothing.
+        logger.LogError("after close");
+
+        std::ifstream logFile(logFilename);
+
+        std::string firstLine;
+        std::string secondLine;
+        std::string thirdLine;
+
+        REQUIRE(std::getline(logFile, firstLine));
+        REQUIRE(std::getline(logFile, secondLine));
+        REQUIRE(!std::getline(logFile, thirdLine));
+
+        REQUIRE(firstLine.find(" [WARNING] first warning") != std::string::npos);
+        REQUIRE(secondLine.find(" [ERROR]   an error") != std::string::npos);
+    }
+
+    SECTION("Deferred messages")
+    {
+        REQUIRE(logger.OpenLog(logFilename));
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            SHIP_LOG_INFO("deferred %u %s %.1f", i, "message", 0.5);
+        }
+
+        logger.SetLogLevel(Shipyard::LogLevel_Error);
+        SHIP_LOG_INFO("filtered out %u", 0u);
+
+        logger.CloseLog();
+
+        std::ifstream logFile(logFilename);
+        std::string line;
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            REQUIRE(std::getline(logFile, line));
+            REQUIRE(line.find(" [INFO]    deferred " + std::to_string(i) + " message 0.5") != std::string::npos);
+        }
+
+        REQUIRE(!std::getline(logFile, line));
+    }
+
+    SECTION("Binary log")
+    {
+        const char* decodedLogFilename = "shipyard_unit_test_logger_decoded.log";
+
+        REQUIRE(logger.OpenLog(logFilename, Shipyard::LogFileFormat::Binary));
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            SHIP_LOG_WARNING("binary %u %s 0x%llx", i, "message", 0xabcdull);
+        }
+
+        logger.LogError("preformatted %d", 10);
+        SHIP_LOG_DEBUG("%s", "last");
+
+        logger.CloseLog();
+
+        REQUIRE(Shipyard::DecodeBinaryLogFile(logFilename, decodedLogFilename));
+
+        std::ifstream decodedLogFile(decodedLogFilename);
+        std::string line;
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            REQUIRE(std::getline(decodedLogFile, line));
+            REQUIRE(line.find(" [WARNING] binary " + std::to_string(i) + " message 0xabcd") != std::string::npos);
+        }
+
+        REQUIRE(std::getline(decodedLogFile, line));
+        REQUIRE(line.find(" [ERROR]   preformatted 10") != std::string::npos);
+
+        REQUIRE(std::getline(decodedLogFile, line));
+        REQUIRE(line.find(" [DEBUG]   last") != std::string::npos);
+
+        REQUIRE(!std::getline(decodedLogFile, line));
+
+        decodedLogFile.close();
+        remove(decodedLogFilename);
+
+        // Not a binary log.
+        std::ofstream(logFilename) << "text";
+
+        REQUIRE(!Shipyard::DecodeBinaryLogFile(logFilename, decodedLogFilename));
+    }
+
+    logger.SetLogLevel(Shipyard::LogLevel(Shipyard::LogLevel_Error | Shipyard::LogLevel_Warning));
+    logger.SetFlushPolicy(Shipyard::LogFlushPolicy::EveryBatch);
+
+    remove(logFilename);
+}
+
+#endif // #ifdef SHIP_ENABLE_LOGGING
+
+#ifdef SHIP_ENABLE_LOGGING
+
+TEST_CASE("Benchmark Logger calls", "[.][Benchmark][Logger]")
+{
+    const char* logFilename = "shipyard_unit_test_logger_benchmark.log";
+    constexpr uint32_t numBatches = 200;
+    constexpr uint32_t numMessagesPerBatch = 500;
+
+    Shipyard::Logger& logger = Shipyard::GetLogger();
+    logger.SetLogLevel(Shipyard::LogLevel_FullLog);
+    logger.SetFlushPolicy(Shipyard::LogFlushPolicy::OnClose);
+
+    // Batches fit in the ring buffer and are flushed outside of the measured time, so that no message is dropped.
+    auto measureNanosecondsPerCall = [&](Shipyard::LogFileFormat logFileFormat, auto logMessage)
+    {
+        REQUIRE(logger.OpenLog(logFilename, logFileFormat));
+
+        uint64_t numDroppedMessagesBefore = logger.GetNumDroppedMessages();
+        std::chrono::nanoseconds elapsedTime(0);
+
+        for (uint32_t batch = 0; batch < numBatches; batch++)
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < numMessagesPerBatch; i++)
+            {
+                logMessage(i);
+            }
+
+            elapsedTime += (std::chrono::high_resolution_clock::now() - startTime);
+
+            logger.Flush();
+        }
+
+        REQUIRE(logger.GetNumDroppedMessages() == numDroppedMessagesBefore);
+
+        logger.CloseLog();
+
+        return (double(elapsedTime.count()) / double(numBatches * numMessagesPerBatch));
+    };
+
+    double preformattedCallTime = measureNanosecondsPerCall(Shipyard::LogFileFormat::Text, [&](uint32_t i)
+    {
+        logger.LogInfo("Message %u of batch, %s: %.2f", i, "value", 0.5);
+    });
+
+    double deferredTextCallTime = measureNanosecondsPerCall(Shipyard::LogFileFormat::Text, [&](uint32_t i)
+    {
+        SHIP_LOG_INFO("Message %u of batch, %s: %.2f", i, "value", 0.5);
+    });
+
+    double deferredBinaryCallTime = measureNanosecondsPerCall(Shipyard::LogFileFormat::Binary, [&](uint32_t i)
+    {
+        SHIP_LOG_INFO("Message %u of batch, %s: %.2f", i, "value", 0.5);
+    });
+
+    WARN("Log call time (ns): preformatted " << preformattedCallTime << ", deferred to text log " << deferredTextCallTime << ", deferred to binary log " << deferredBinaryCallTime);
+
+    logger.SetLogLevel(Shipyard::LogLevel(Shipyard::LogLevel_Error | Shipyard::LogLevel_Warning));
+    logger.SetFlushPolicy(Shipyard::LogFlushPolicy::EveryBatch);
+
+    remove(logFilename);
+}
+
+#endif // #ifdef SHIP_ENABLE_LOGGING
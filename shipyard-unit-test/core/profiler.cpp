@@ -0,0 +1,256 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/profiler.h>
+
+#ifdef SHIP_ENABLE_PROFILER
+
+#include <utils/unittestutils.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const char* const TraceFilename = "ProfilerUnitTest.json";
+
+    std::string WriteAndReadTrace()
+    {
+        REQUIRE(Shipyard::GetProfiler().WriteChromeTrace(TraceFilename));
+
+        std::ifstream traceFile(TraceFilename);
+        std::stringstream trace;
+        trace << traceFile.rdbuf();
+        traceFile.close();
+
+        std::remove(TraceFilename);
+
+        return trace.str();
+    }
+
+    uint32_t CountOccurrences(const std::string& text, const std::string& pattern)
+    {
+        uint32_t numOccurrences = 0;
+
+        for (size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + pattern.size()))
+        {
+            numOccurrences += 1;
+        }
+
+        return numOccurrences;
+    }
+
+    void RecordNestedScopes()
+    {
+        SHIP_PROFILE_SCOPE("Outer");
+
+        {
+            SHIP_PROFILE_SCOPE("Inner");
+        }
+    }
+}
+
+TEST_CASE("Test Profiler", "[Profiler]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(1024 * 1024);
+
+    Shipyard::Profiler& profiler = Shipyard::GetProfiler();
+
+    SECTION("Nothing is recorded without a capture")
+    {
+        REQUIRE(profiler.Create(4, 64));
+
+        RecordNestedScopes();
+        SHIP_PROFILE_FRAME();
+
+        profiler.StartCapture();
+        profiler.StopCapture();
+
+        RecordNestedScopes();
+
+        REQUIRE(profiler.GetNumThreadsCaptured() == 0);
+        REQUIRE(profiler.GetNumDroppedEvents() == 0);
+
+        std::string trace = WriteAndReadTrace();
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"B\"") == 0);
+
+        profiler.Destroy();
+    }
+
+    SECTION("Nested scopes and frame markers")
+    {
+        REQUIRE(profiler.Create(4, 64));
+
+        profiler.StartCapture();
+
+        SHIP_PROFILE_FRAME();
+        RecordNestedScopes();
+        SHIP_PROFILE_FRAME();
+
+        {
+            SHIP_PROFILE_SCOPE("Escaped \"name\"");
+        }
+
+        REQUIRE(Shipyard::Profiler::IsCapturing());
+        profiler.StopCapture();
+        REQUIRE(!Shipyard::Profiler::IsCapturing());
+
+        REQUIRE(profiler.GetNumThreadsCaptured() == 1);
+        REQUIRE(profiler.GetNumDroppedEvents() == 0);
+
+        std::string trace = WriteAndReadTrace();
+
+        REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"B\"") == 3);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"E\"") == 3);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"i\"") == 2);
+        REQUIRE(CountOccurrences(trace, "\"name\":\"thread_name\"") == 1);
+
+        size_t frame0 = trace.find("\"name\":\"Frame 0\"");
+        size_t outer = trace.find("\"name\":\"Outer\"");
+        size_t inner = trace.find("\"name\":\"Inner\"");
+        size_t frame1 = trace.find("\"name\":\"Frame 1\"");
+
+        REQUIRE(frame0 != std::string::npos);
+        REQUIRE(frame0 < outer);
+        REQUIRE(outer < inner);
+        REQUIRE(inner < frame1);
+        REQUIRE(frame1 != std::string::npos);
+
+        REQUIRE(trace.find("\"name\":\"Escaped \\\"name\\\"\"") != std::string::npos);
+
+        profiler.Destroy();
+    }
+
+    SECTION("Full buffers drop whole scopes")
+    {
+        REQUIRE(profiler.Create(4, 6));
+
+        profiler.StartCapture();
+
+        {
+            SHIP_PROFILE_SCOPE("A");
+
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                SHIP_PROFILE_SCOPE("B");
+            }
+        }
+
+        profiler.StopCapture();
+
+        // A and two of the B scopes fit, the other two B scopes are dropped.
+        REQUIRE(profiler.GetNumDroppedEvents() == 4);
+
+        std::string trace = WriteAndReadTrace();
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"B\"") == 3);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"E\"") == 3);
+
+        profiler.Destroy();
+    }
+
+    SECTION("Restarting a capture discards the previous one")
+    {
+        REQUIRE(profiler.Create(4, 64));
+
+        profiler.StartCapture();
+        RecordNestedScopes();
+        profiler.StopCapture();
+
+        profiler.StartCapture();
+        {
+            SHIP_PROFILE_SCOPE("Second");
+        }
+        profiler.StopCapture();
+
+        std::string trace = WriteAndReadTrace();
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"B\"") == 1);
+        REQUIRE(trace.find("\"name\":\"Second\"") != std::string::npos);
+
+        profiler.Destroy();
+    }
+
+    SECTION("Threads record in their own buffers")
+    {
+        constexpr uint32_t numThreads = 4;
+        constexpr uint32_t numScopesPerThread = 100;
+
+        // One buffer short, the last thread to record has its events dropped.
+        REQUIRE(profiler.Create(numThreads - 1, 1024));
+
+        profiler.StartCapture();
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < numThreads; i++)
+        {
+            threads.emplace_back([]()
+            {
+                for (uint32_t j = 0; j < numScopesPerThread; j++)
+                {
+                    RecordNestedScopes();
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        profiler.StopCapture();
+
+        REQUIRE(profiler.GetNumThreadsCaptured() == numThreads - 1);
+        REQUIRE(profiler.GetNumDroppedEvents() == numScopesPerThread * 4);
+
+        std::string trace = WriteAndReadTrace();
+        REQUIRE(CountOccurrences(trace, "\"name\":\"thread_name\"") == numThreads - 1);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"B\"") == (numThreads - 1) * numScopesPerThread * 2);
+        REQUIRE(CountOccurrences(trace, "\"ph\":\"E\"") == (numThreads - 1) * numScopesPerThread * 2);
+
+        profiler.Destroy();
+    }
+}
+
+TEST_CASE("Benchmark Profiler", "[.][Benchmark][Profiler]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator(64 * 1024 * 1024);
+
+    constexpr uint32_t numScopes = 500000;
+
+    Shipyard::Profiler& profiler = Shipyard::GetProfiler();
+    REQUIRE(profiler.Create(1, numScopes * 2));
+
+    auto runScopes = [&]()
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < numScopes; i++)
+        {
+            SHIP_PROFILE_SCOPE("Benchmark");
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / double(numScopes);
+    };
+
+    double disabledScopeTime = runScopes();
+
+    profiler.StartCapture();
+    double enabledScopeTime = runScopes();
+    profiler.StopCapture();
+
+    REQUIRE(profiler.GetNumDroppedEvents() == 0);
+
+    WARN("Scope without a capture: " << disabledScopeTime << " ns, scope during a capture: " << enabledScopeTime << " ns");
+
+    profiler.Destroy();
+}
+
+#endif // #ifdef SHIP_ENABLE_PROFILER
@@ -0,0 +1,179 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/ringbuffer.h>
+
+#include <cstring>
+#include <thread>
+
+TEST_CASE("Test SPSCRingBuffer", "[RingBuffer]")
+{
+    SECTION("Write and read")
+    {
+        Shipyard::SPSCRingBuffer<256> ringBuffer;
+
+        uint32_t recordSize = 0;
+        REQUIRE(ringBuffer.BeginRead(&recordSize) == nullptr);
+
+        void* pRecord = ringBuffer.BeginWrite(5);
+        REQUIRE(pRecord != nullptr);
+        memcpy(pRecord, "Hello", 5);
+        ringBuffer.EndWrite();
+
+        const void* pReadRecord = ringBuffer.BeginRead(&recordSize);
+        REQUIRE(pReadRecord != nullptr);
+        REQUIRE(recordSize == 5);
+        REQUIRE(memcmp(pReadRecord, "Hello", 5) == 0);
+        ringBuffer.EndRead();
+
+        REQUIRE(ringBuffer.BeginRead(&recordSize) == nullptr);
+        REQUIRE(ringBuffer.GetNumBytesUsed() == 0);
+    }
+
+    SECTION("Unpublished records are not read")
+    {
+        Shipyard::SPSCRingBuffer<256> ringBuffer;
+
+        REQUIRE(ringBuffer.BeginWrite(8) != nullptr);
+
+        uint32_t recordSize = 0;
+        REQUIRE(ringBuffer.BeginRead(&recordSize) == nullptr);
+
+        ringBuffer.EndWrite();
+
+        REQUIRE(ringBuffer.BeginRead(&recordSize) != nullptr);
+        REQUIRE(recordSize == 8);
+    }
+
+    SECTION("Full buffer")
+    {
+        Shipyard::SPSCRingBuffer<256> ringBuffer;
+
+        // 60 bytes records take 64 bytes with their size.
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            REQUIRE(ringBuffer.BeginWrite(60) != nullptr);
+            ringBuffer.EndWrite();
+        }
+
+        REQUIRE(ringBuffer.BeginWrite(1) == nullptr);
+
+        uint32_t recordSize = 0;
+        REQUIRE(ringBuffer.BeginRead(&recordSize) != nullptr);
+        ringBuffer.EndRead();
+
+        REQUIRE(ringBuffer.BeginWrite(60) != nullptr);
+        ringBuffer.EndWrite();
+
+        REQUIRE(ringBuffer.BeginWrite(1) == nullptr);
+    }
+
+    SECTION("Records don't wrap around")
+    {
+        Shipyard::SPSCRingBuffer<256> ringBuffer;
+        uint32_t recordSize = 0;
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            REQUIRE(ringBuffer.BeginWrite(60) != nullptr);
+            ringBuffer.EndWrite();
+        }
+
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            REQUIRE(ringBuffer.BeginRead(&recordSize) != nullptr);
+            ringBuffer.EndRead();
+        }
+
+        // Only 64 bytes are left before the end, the record is written at the start of the buffer.
+        uint8_t* pRecord = reinterpret_cast<uint8_t*>(ringBuffer.BeginWrite(100));
+        REQUIRE(pRecord != nullptr);
+        memset(pRecord, 0xab, 100);
+        ringBuffer.EndWrite();
+
+        REQUIRE(ringBuffer.BeginRead(&recordSize) != nullptr);
+        REQUIRE(recordSize == 60);
+        ringBuffer.EndRead();
+
+        const uint8_t* pReadRecord = reinterpret_cast<const uint8_t*>(ringBuffer.BeginRead(&recordSize));
+        REQUIRE(pReadRecord == pRecord);
+        REQUIRE(recordSize == 100);
+        REQUIRE(pReadRecord[99] == 0xab);
+        ringBuffer.EndRead();
+
+        REQUIRE(ringBuffer.BeginRead(&recordSize) == nullptr);
+        REQUIRE(ringBuffer.GetNumBytesUsed() == 0);
+    }
+
+    SECTION("Producer and consumer threads")
+    {
+        constexpr uint32_t numRecords = 200000;
+
+        Shipyard::SPSCRingBuffer<1024>* pRingBuffer = new Shipyard::SPSCRingBuffer<1024>();
+
+        // Records have varying sizes so that padding records are written, and are filled with their index.
+        std::thread producerThread([pRingBuffer]()
+        {
+            for (uint32_t i = 0; i < numRecords; i++)
+            {
+                uint32_t numValues = 1 + (i % 37);
+
+                void* pRecord = nullptr;
+                while ((pRecord = pRingBuffer->BeginWrite(numValues * sizeof(uint32_t))) == nullptr)
+                {
+                    std::this_thread::yield();
+                }
+
+                uint32_t* pValues = reinterpret_cast<uint32_t*>(pRecord);
+                for (uint32_t j = 0; j < numValues; j++)
+                {
+                    pValues[j] = i;
+                }
+
+                pRingBuffer->EndWrite();
+            }
+        });
+
+        uint32_t numCorruptedRecords = 0;
+
+        for (uint32_t i = 0; i < numRecords; i++)
+        {
+            uint32_t recordSize = 0;
+            const void* pRecord = nullptr;
+            while ((pRecord = pRingBuffer->BeginRead(&recordSize)) == nullptr)
+            {
+                std::this_thread::yield();
+            }
+
+            uint32_t numValues = 1 + (i % 37);
+            if (recordSize != numValues * sizeof(uint32_t))
+            {
+                numCorruptedRecords += 1;
+            }
+            else
+            {
+                const uint32_t* pValues = reinterpret_cast<const uint32_t*>(pRecord);
+                for (uint32_t j = 0; j < numValues; j++)
+                {
+                    if (pValues[j] != i)
+                    {
+                        numCorruptedRecords += 1;
+                        break;
+                    }
+                }
+            }
+
+            pRingBuffer->EndRead();
+        }
+
+        producerThread.join();
+
+        uint32_t recordSize = 0;
+
+        REQUIRE(numCorruptedRecords == 0);
+        REQUIRE(pRingBuffer->BeginRead(&recordSize) == nullptr);
+
+        delete pRingBuffer;
+    }
+}
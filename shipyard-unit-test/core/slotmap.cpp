@@ -0,0 +1,288 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/datapool.h>
+#include <system/memory/fixedheapallocator.h>
+#include <system/slotmap.h>
+
+#include <utils/unittestutils.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct SlotMapHandle
+    {
+        uint32_t index = 0;
+        uint16_t generation = 0;
+    };
+
+    // About the size of a transform and a bounding volume, which is what systems walking their objects every frame touch.
+    struct BenchmarkItem
+    {
+        float values[15] = {};
+        uint32_t id = 0;
+    };
+}
+
+TEST_CASE("Test SlotMap", "[SlotMap]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    SECTION("Add and release")
+    {
+        Shipyard::SlotMap<uint32_t> slotMap;
+
+        REQUIRE(slotMap.Empty());
+        REQUIRE(slotMap.begin() == slotMap.end());
+
+        SlotMapHandle handles[8];
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            handles[i].index = slotMap.GetNewItemIndex(&handles[i].generation, i * 10);
+        }
+
+        REQUIRE(slotMap.Size() == 8);
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            REQUIRE(slotMap.IsValid(handles[i].index, handles[i].generation));
+            REQUIRE(slotMap.GetItem(handles[i].index, handles[i].generation) == i * 10);
+        }
+
+        // The last item is moved in place of the released one, its handle must still point to it.
+        slotMap.ReleaseItem(handles[2].index);
+        slotMap.ReleaseItem(handles[0].index);
+
+        REQUIRE(slotMap.Size() == 6);
+        REQUIRE(!slotMap.IsValid(handles[2].index, handles[2].generation));
+        REQUIRE(!slotMap.IsValid(handles[0].index, handles[0].generation));
+
+        for (uint32_t i = 1; i < 8; i++)
+        {
+            if (i != 2)
+            {
+                REQUIRE(*slotMap.GetItemPtr(handles[i].index, handles[i].generation) == i * 10);
+            }
+        }
+
+        // Released slots are reused with a new generation.
+        SlotMapHandle newHandle;
+        newHandle.index = slotMap.GetNewItemIndex(&newHandle.generation, 1000u);
+
+        REQUIRE(newHandle.index == handles[0].index);
+        REQUIRE(newHandle.generation != handles[0].generation);
+        REQUIRE(slotMap.GetItem(newHandle.index, newHandle.generation) == 1000);
+    }
+
+    SECTION("Iteration")
+    {
+        Shipyard::SlotMap<uint32_t> slotMap;
+
+        std::vector<SlotMapHandle> handles(1000);
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            handles[i].index = slotMap.GetNewItemIndex(&handles[i].generation, i);
+        }
+
+        for (uint32_t i = 0; i < 1000; i += 3)
+        {
+            slotMap.ReleaseItem(handles[i].index);
+        }
+
+        uint32_t numIteratedItems = 0;
+        uint64_t sumOfItems = 0;
+        for (uint32_t item : slotMap)
+        {
+            REQUIRE((item % 3) != 0);
+
+            numIteratedItems += 1;
+            sumOfItems += item;
+        }
+
+        uint64_t expectedSumOfItems = 0;
+        for (uint32_t i = 0; i < 1000; i++)
+        {
+            if ((i % 3) != 0)
+            {
+                expectedSumOfItems += i;
+            }
+        }
+
+        REQUIRE(numIteratedItems == slotMap.Size());
+        REQUIRE(sumOfItems == expectedSumOfItems);
+
+        // Items found while iterating can give back their handle.
+        for (uint32_t denseIndex = 0; denseIndex < slotMap.Size(); denseIndex++)
+        {
+            uint16_t generation = 0;
+            uint32_t index = slotMap.GetItemIndex(denseIndex, &generation);
+
+            REQUIRE(index == slotMap[denseIndex]);
+            REQUIRE(generation == handles[index].generation);
+        }
+    }
+
+    SECTION("Random adds and releases")
+    {
+        Shipyard::SlotMap<uint32_t> slotMap;
+
+        std::mt19937 randomEngine(7);
+
+        std::vector<SlotMapHandle> liveHandles;
+        std::vector<uint32_t> liveValues;
+
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            if (liveHandles.empty() || (randomEngine() % 3) != 0)
+            {
+                SlotMapHandle handle;
+                handle.index = slotMap.GetNewItemIndex(&handle.generation, i);
+
+                liveHandles.push_back(handle);
+                liveValues.push_back(i);
+            }
+            else
+            {
+                size_t handleToRelease = randomEngine() % liveHandles.size();
+
+                slotMap.ReleaseItem(liveHandles[handleToRelease].index);
+
+                liveHandles[handleToRelease] = liveHandles.back();
+                liveHandles.pop_back();
+                liveValues[handleToRelease] = liveValues.back();
+                liveValues.pop_back();
+            }
+        }
+
+        REQUIRE(slotMap.Size() == liveHandles.size());
+
+        for (size_t i = 0; i < liveHandles.size(); i++)
+        {
+            REQUIRE(slotMap.GetItem(liveHandles[i].index, liveHandles[i].generation) == liveValues[i]);
+        }
+
+        slotMap.Clear();
+
+        REQUIRE(slotMap.Empty());
+
+        for (size_t i = 0; i < liveHandles.size(); i++)
+        {
+            REQUIRE(!slotMap.IsValid(liveHandles[i].index, liveHandles[i].generation));
+        }
+    }
+}
+
+TEST_CASE("Benchmark SlotMap", "[.][Benchmark][SlotMap]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    constexpr uint32_t numSlots = 65536;
+
+    // The pools reserve all of their slots, which doesn't fit in the global allocator of the tests.
+    const size_t heapSize = 64 * 1024 * 1024;
+
+    Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 16);
+
+    Shipyard::FixedHeapAllocator fixedHeapAllocator;
+    fixedHeapAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+    uint64_t checksum = 0;
+
+    const uint32_t occupancies[] = { 10, 50, 90 };
+    for (uint32_t occupancy : occupancies)
+    {
+        Shipyard::GenerationalDataPool<BenchmarkItem, numSlots> dataPool(&fixedHeapAllocator);
+        dataPool.Create();
+
+        Shipyard::PagedGenerationalDataPool<BenchmarkItem> pagedDataPool(&fixedHeapAllocator);
+        pagedDataPool.Create();
+
+        Shipyard::SlotMap<BenchmarkItem> slotMap(&fixedHeapAllocator);
+
+        std::vector<SlotMapHandle> dataPoolHandles(numSlots);
+        std::vector<SlotMapHandle> pagedDataPoolHandles(numSlots);
+        std::vector<SlotMapHandle> slotMapHandles(numSlots);
+
+        for (uint32_t i = 0; i < numSlots; i++)
+        {
+            dataPoolHandles[i].index = dataPool.GetNewItemIndex(&dataPoolHandles[i].generation);
+            dataPool.GetItem(dataPoolHandles[i].index, dataPoolHandles[i].generation).id = i;
+
+            pagedDataPoolHandles[i].index = pagedDataPool.GetNewItemIndex(&pagedDataPoolHandles[i].generation);
+            pagedDataPool.GetItem(pagedDataPoolHandles[i].index, pagedDataPoolHandles[i].generation).id = i;
+
+            slotMapHandles[i].index = slotMap.GetNewItemIndex(&slotMapHandles[i].generation);
+            slotMap.GetItem(slotMapHandles[i].index, slotMapHandles[i].generation).id = i;
+        }
+
+        // Objects are released in random order, which leaves the pools' live items scattered.
+        std::mt19937 randomEngine(occupancy);
+
+        std::vector<uint32_t> itemsToRelease(numSlots);
+        for (uint32_t i = 0; i < numSlots; i++)
+        {
+            itemsToRelease[i] = i;
+        }
+
+        std::shuffle(itemsToRelease.begin(), itemsToRelease.end(), randomEngine);
+
+        uint32_t numItemsToRelease = numSlots - (numSlots * occupancy) / 100;
+        for (uint32_t i = 0; i < numItemsToRelease; i++)
+        {
+            dataPool.ReleaseItem(dataPoolHandles[itemsToRelease[i]].index);
+            pagedDataPool.ReleaseItem(pagedDataPoolHandles[itemsToRelease[i]].index);
+            slotMap.ReleaseItem(slotMapHandles[itemsToRelease[i]].index);
+        }
+
+        std::string occupancyName = std::to_string(occupancy) + "%";
+
+        BENCHMARK(std::string("GenerationalDataPool iteration at ") + occupancyName)
+        {
+            uint32_t index = 0;
+            uint16_t generation = 0;
+            if (dataPool.GetFirstAllocatedIndex(&index, &generation))
+            {
+                do
+                {
+                    checksum += dataPool.GetItem(index, generation).id;
+                } while (dataPool.GetNextAllocatedIndex(index, &index, &generation));
+            }
+        }
+
+        BENCHMARK(std::string("PagedGenerationalDataPool iteration at ") + occupancyName)
+        {
+            uint32_t index = 0;
+            uint16_t generation = 0;
+            if (pagedDataPool.GetFirstAllocatedIndex(&index, &generation))
+            {
+                do
+                {
+                    checksum += pagedDataPool.GetItem(index, generation).id;
+                } while (pagedDataPool.GetNextAllocatedIndex(index, &index, &generation));
+            }
+        }
+
+        BENCHMARK(std::string("SlotMap iteration at ") + occupancyName)
+        {
+            for (const BenchmarkItem& item : slotMap)
+            {
+                checksum += item.id;
+            }
+        }
+
+        for (uint32_t i = numItemsToRelease; i < numSlots; i++)
+        {
+            dataPool.ReleaseItem(dataPoolHandles[itemsToRelease[i]].index);
+            pagedDataPool.ReleaseItem(pagedDataPoolHandles[itemsToRelease[i]].index);
+        }
+    }
+
+    fixedHeapAllocator.Destroy();
+
+    WARN("Checksum: " << checksum);
+}
@@ -0,0 +1,304 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/array.h>
+#include <system/memory/fixedheapallocator.h>
+#include <system/sort.h>
+
+#include <utils/unittestutils.h>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    struct SortKeyAndIndex
+    {
+        uint32_t sortKey = 0;
+        uint32_t index = 0;
+    };
+
+    struct CompareSortKeys
+    {
+        bool operator() (const SortKeyAndIndex& lhs, const SortKeyAndIndex& rhs) const
+        {
+            return (lhs.sortKey < rhs.sortKey);
+        }
+    };
+
+    struct GetSortKey
+    {
+        uint32_t operator() (const SortKeyAndIndex& element) const
+        {
+            return element.sortKey;
+        }
+    };
+
+    template <typename T>
+    void FillWithRandomValues(Shipyard::Array<T>& values, uint32_t numValues, uint64_t maxValue, uint32_t seed)
+    {
+        std::mt19937_64 randomEngine(seed);
+
+        values.Resize(numValues);
+        for (T& value : values)
+        {
+            value = T(randomEngine() % maxValue);
+        }
+    }
+
+    template <typename T>
+    bool IsSorted(const Shipyard::Array<T>& values)
+    {
+        for (uint32_t i = 1; i < values.Size(); i++)
+        {
+            if (values[i] < values[i - 1])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Elements with the same sort key must keep the order of their indices.
+    bool IsSortedStably(const Shipyard::Array<SortKeyAndIndex>& elements)
+    {
+        for (uint32_t i = 1; i < elements.Size(); i++)
+        {
+            const SortKeyAndIndex& previous = elements[i - 1];
+            const SortKeyAndIndex& current = elements[i];
+
+            if (current.sortKey < previous.sortKey || (current.sortKey == previous.sortKey && current.index < previous.index))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void FillSortKeysWithDuplicates(Shipyard::Array<SortKeyAndIndex>& elements, uint32_t numElements)
+    {
+        std::mt19937 randomEngine(42);
+
+        elements.Resize(numElements);
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            elements[i].sortKey = (randomEngine() % 64) << 20;
+            elements[i].index = i;
+        }
+    }
+}
+
+TEST_CASE("Test Sort", "[Sort]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    SECTION("Small and empty arrays")
+    {
+        Shipyard::Array<uint32_t> values;
+
+        Shipyard::Sort(values);
+        Shipyard::StableSort(values);
+        Shipyard::RadixSort(values);
+
+        values.Add(3);
+        values.Add(1);
+        values.Add(2);
+
+        Shipyard::Sort(values);
+
+        REQUIRE(values[0] == 1);
+        REQUIRE(values[1] == 2);
+        REQUIRE(values[2] == 3);
+    }
+
+    SECTION("Introsort")
+    {
+        Shipyard::Array<uint32_t> values;
+        FillWithRandomValues(values, 50000, 0xFFFFFFFF, 1);
+
+        Shipyard::Array<uint32_t> expectedValues = values;
+        std::sort(&expectedValues[0], &expectedValues[0] + expectedValues.Size());
+
+        Shipyard::Sort(values);
+
+        REQUIRE(IsSorted(values));
+        REQUIRE(memcmp(&values[0], &expectedValues[0], sizeof(uint32_t) * values.Size()) == 0);
+
+        Shipyard::Sort(values, [](uint32_t lhs, uint32_t rhs) { return lhs > rhs; });
+
+        REQUIRE(values[0] == expectedValues.Back());
+        REQUIRE(values.Back() == expectedValues[0]);
+    }
+
+    SECTION("Introsort worst cases")
+    {
+        const uint32_t numElements = 20000;
+
+        Shipyard::Array<uint32_t> values;
+        values.Resize(numElements);
+
+        // Already sorted, reversed, all equal, and organ pipe, which makes a median of three pick bad pivots.
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            values[i] = i;
+        }
+
+        Shipyard::Sort(values);
+        REQUIRE(IsSorted(values));
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            values[i] = numElements - i;
+        }
+
+        Shipyard::Sort(values);
+        REQUIRE(IsSorted(values));
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            values[i] = 7;
+        }
+
+        Shipyard::Sort(values);
+        REQUIRE(IsSorted(values));
+
+        for (uint32_t i = 0; i < numElements; i++)
+        {
+            values[i] = (i < numElements / 2) ? i : (numElements - i);
+        }
+
+        Shipyard::Sort(values);
+        REQUIRE(IsSorted(values));
+    }
+
+    SECTION("Stable sort")
+    {
+        Shipyard::Array<SortKeyAndIndex> elements;
+        FillSortKeysWithDuplicates(elements, 30000);
+
+        Shipyard::StableSort(elements, CompareSortKeys());
+
+        REQUIRE(IsSortedStably(elements));
+    }
+
+    SECTION("Radix sort")
+    {
+        Shipyard::Array<uint64_t> values;
+        FillWithRandomValues(values, 50000, 0xFFFFFFFFFFFFFFFFull, 2);
+
+        Shipyard::Array<uint64_t> expectedValues = values;
+        std::sort(&expectedValues[0], &expectedValues[0] + expectedValues.Size());
+
+        Shipyard::RadixSort(values);
+
+        REQUIRE(memcmp(&values[0], &expectedValues[0], sizeof(uint64_t) * values.Size()) == 0);
+
+        // Only the low bytes are used, the other passes are skipped.
+        Shipyard::Array<uint32_t> smallValues;
+        FillWithRandomValues(smallValues, 1000, 1000, 3);
+
+        Shipyard::RadixSort(smallValues);
+
+        REQUIRE(IsSorted(smallValues));
+
+        Shipyard::Array<SortKeyAndIndex> elements;
+        FillSortKeysWithDuplicates(elements, 30000);
+
+        Shipyard::RadixSort(elements, GetSortKey());
+
+        REQUIRE(IsSortedStably(elements));
+    }
+
+    SECTION("Parallel sort")
+    {
+        Shipyard::Array<uint32_t> values;
+        FillWithRandomValues(values, 100000, 0xFFFFFFFF, 4);
+
+        Shipyard::Array<uint32_t> expectedValues = values;
+        std::sort(&expectedValues[0], &expectedValues[0] + expectedValues.Size());
+
+        // An odd number of chunks leaves a run unmerged at every other step.
+        const uint32_t numThreads = 5;
+        const uint32_t minElementsPerThread = 1000;
+
+        Shipyard::ParallelSort(&values[0], values.Size(), Shipyard::LessThan<uint32_t>(), numThreads, minElementsPerThread);
+
+        REQUIRE(memcmp(&values[0], &expectedValues[0], sizeof(uint32_t) * values.Size()) == 0);
+    }
+}
+
+TEST_CASE("Benchmark Sort", "[.][Benchmark][Sort]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    const uint32_t numElements = 1000000;
+
+    // The keys and the temporary buffers don't fit in the global allocator of the tests.
+    const size_t heapSize = 64 * 1024 * 1024;
+
+    Shipyard::ScoppedBuffer scoppedBuffer(heapSize, 16);
+
+    Shipyard::FixedHeapAllocator fixedHeapAllocator;
+    fixedHeapAllocator.Create(scoppedBuffer.pBuffer, heapSize);
+
+    {
+        Shipyard::Array<uint64_t> randomKeys(&fixedHeapAllocator);
+        FillWithRandomValues(randomKeys, numElements, 0xFFFFFFFFFFFFFFFFull, 5);
+
+        Shipyard::Array<uint64_t> keys(&fixedHeapAllocator);
+
+        keys = randomKeys;
+        BENCHMARK("std::sort of 1M 64-bit keys")
+        {
+            std::sort(&keys[0], &keys[0] + numElements);
+        }
+
+        keys = randomKeys;
+        BENCHMARK("Sort of 1M 64-bit keys")
+        {
+            Shipyard::Sort(keys);
+        }
+
+        keys = randomKeys;
+        BENCHMARK("StableSort of 1M 64-bit keys")
+        {
+            Shipyard::StableSort(keys);
+        }
+
+        keys = randomKeys;
+        BENCHMARK("RadixSort of 1M 64-bit keys")
+        {
+            Shipyard::RadixSort(keys);
+        }
+
+        keys = randomKeys;
+        BENCHMARK("ParallelSort of 1M 64-bit keys")
+        {
+            Shipyard::ParallelSort(keys);
+        }
+
+        REQUIRE(IsSorted(keys));
+
+        Shipyard::Array<uint32_t> shaderKeys(&fixedHeapAllocator);
+        FillWithRandomValues(shaderKeys, numElements, 0xFFFFFFFF, 6);
+
+        Shipyard::Array<uint32_t> shaderKeysCopy(&fixedHeapAllocator);
+
+        shaderKeysCopy = shaderKeys;
+        BENCHMARK("std::sort of 1M 32-bit keys")
+        {
+            std::sort(&shaderKeysCopy[0], &shaderKeysCopy[0] + numElements);
+        }
+
+        shaderKeysCopy = shaderKeys;
+        BENCHMARK("RadixSort of 1M 32-bit keys")
+        {
+            Shipyard::RadixSort(shaderKeysCopy);
+        }
+    }
+
+    fixedHeapAllocator.Destroy();
+}
@@ -15,8 +15,15 @@ TEST_CASE("Test StringA", "[String]")
     SECTION("Default Constructor")
     {
         REQUIRE(string.Size() == 0);
-        REQUIRE(string.Capacity() == string.DefaultStringCapacity);
+        REQUIRE(string.Capacity() == 0);
         REQUIRE(string.GetBuffer()[0] == '\0');
+        REQUIRE(string == "");
+
+        string += 'a';
+
+        REQUIRE(string.Size() == 1);
+        REQUIRE(string.Capacity() >= 2);
+        REQUIRE(string == "a");
     }
 
     SECTION("String Constructor")
@@ -48,9 +55,9 @@ TEST_CASE("Test StringA", "[String]")
     {
         Shipyard::StringA copiedString = string;
 
-        REQUIRE(string.Size() == 0);
-        REQUIRE(string.Capacity() >= 1);
-        REQUIRE(string.GetBuffer()[0] == '\0');
+        REQUIRE(copiedString.Size() == 0);
+        REQUIRE(copiedString.Capacity() == 0);
+        REQUIRE(copiedString.GetBuffer()[0] == '\0');
 
         Shipyard::StringA initializedString = "Test";
 
@@ -116,6 +123,40 @@ TEST_CASE("Test StringA", "[String]")
         REQUIRE(string.GetBuffer()[1] == '\0');
     }
 
+    SECTION("String Move")
+    {
+        Shipyard::StringA movedFromString = "Test";
+
+        const char* pBuffer = movedFromString.GetBuffer();
+
+        Shipyard::StringA movedString = std::move(movedFromString);
+
+        REQUIRE(movedString == "Test");
+        REQUIRE(movedString.GetBuffer() == pBuffer);
+        REQUIRE(movedFromString.Size() == 0);
+        REQUIRE(movedFromString.GetBuffer()[0] == '\0');
+
+        string = "Previous content";
+        string = std::move(movedString);
+
+        REQUIRE(string == "Test");
+        REQUIRE(string.GetBuffer() == pBuffer);
+        REQUIRE(movedString.Size() == 0);
+
+        movedString = "Reused";
+
+        REQUIRE(movedString == "Reused");
+
+        // Memory of an inplace string is never taken, it's copied instead.
+        Shipyard::InplaceStringA<32> inplaceString = "Inplace";
+
+        Shipyard::StringA stringFromInplace = std::move(inplaceString);
+
+        REQUIRE(stringFromInplace == "Inplace");
+        REQUIRE(stringFromInplace.GetBuffer() != inplaceString.GetBuffer());
+        REQUIRE(inplaceString == "Inplace");
+    }
+
     SECTION("String Equality")
     {
         string = "Test";
@@ -256,6 +297,9 @@ TEST_CASE("Test StringA", "[String]")
 
     SECTION("String Resize")
     {
+        // Default constructed strings don't allocate, give it room to grow without reallocating.
+        string.Reserve(string.DefaultStringCapacity);
+
         string.Resize(4);
 
         REQUIRE(string.Size() == 4);
@@ -0,0 +1,114 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/hashmap.h>
+#include <system/stringid.h>
+
+#include <utils/unittestutils.h>
+
+#include <string.h>
+
+#include <thread>
+
+TEST_CASE("Test StringId", "[StringId]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    SECTION("Compile time and runtime ids")
+    {
+        constexpr Shipyard::StringId albedoId = SHIP_STRING_ID("Albedo");
+        static_assert(albedoId.IsValid(), "StringId should be computed at compile time");
+        static_assert(albedoId != SHIP_STRING_ID("Normal"), "StringId should be computed at compile time");
+
+        REQUIRE(Shipyard::StringId("Albedo") == albedoId);
+        REQUIRE(Shipyard::StringId("AlbedoTexture", 6) == albedoId);
+        REQUIRE(Shipyard::StringId(Shipyard::StringA("Albedo")) == albedoId);
+
+        REQUIRE(Shipyard::StringId("albedo") != albedoId);
+        REQUIRE(Shipyard::StringId("") != Shipyard::StringId());
+        REQUIRE(!Shipyard::StringId().IsValid());
+    }
+
+    SECTION("Case insensitive ids")
+    {
+        Shipyard::StringId shaderFileId = Shipyard::StringId::CreateCaseInsensitive(Shipyard::StringA("Shaders\\Default.fx"));
+
+        REQUIRE(Shipyard::StringId::CreateCaseInsensitive("shaders\\default.FX", 18) == shaderFileId);
+        REQUIRE(Shipyard::StringId::CreateCaseInsensitive("shaders\\error.fx", 16) != shaderFileId);
+        REQUIRE(SHIP_STRING_ID("shaders\\default.fx") == shaderFileId);
+    }
+
+    SECTION("HashMap keys")
+    {
+        Shipyard::HashMap<Shipyard::StringId, uint32_t> map;
+
+        map.Insert(SHIP_STRING_ID("Albedo"), 0);
+        map.Insert(SHIP_STRING_ID("Normal"), 1);
+
+        REQUIRE(*map.Find(Shipyard::StringId("Albedo")) == 0);
+        REQUIRE(*map.Find(Shipyard::StringId("Normal")) == 1);
+        REQUIRE(map.Find(Shipyard::StringId("Roughness")) == nullptr);
+    }
+
+#ifdef SHIP_STRING_ID_INTERNING
+    SECTION("Reverse lookup")
+    {
+        Shipyard::StringId stringId("TestStringIdReverseLookup");
+
+        REQUIRE(strcmp(stringId.GetString(), "TestStringIdReverseLookup") == 0);
+        REQUIRE(SHIP_STRING_ID("TestStringIdReverseLookup").GetString() == stringId.GetString());
+
+        // Substrings are interned with only their characters.
+        Shipyard::StringId substringId("TestStringIdSubstring", 12);
+
+        REQUIRE(strcmp(substringId.GetString(), "TestStringId") == 0);
+
+        REQUIRE(SHIP_STRING_ID("TestStringIdNeverInterned").GetString() == nullptr);
+
+        // The same id from a case insensitive and a case sensitive string isn't a collision.
+        Shipyard::StringId caseInsensitiveId = Shipyard::StringId::CreateCaseInsensitive("TestStringIdCase", 16);
+
+        REQUIRE(Shipyard::StringId("teststringidcase") == caseInsensitiveId);
+        REQUIRE(strcmp(caseInsensitiveId.GetString(), "TestStringIdCase") == 0);
+    }
+
+    SECTION("Interning from multiple threads")
+    {
+        const uint32_t numThreads = 4;
+        const uint32_t numStringsPerThread = 500;
+
+        std::thread threads[numThreads];
+        for (uint32_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            threads[threadIndex] = std::thread([numStringsPerThread]()
+            {
+                // Every thread interns the same strings.
+                for (uint32_t i = 0; i < numStringsPerThread; i++)
+                {
+                    char str[32];
+                    snprintf(str, sizeof(str), "TestStringIdThread%u", i);
+
+                    Shipyard::StringId stringId(str);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (uint32_t i = 0; i < numStringsPerThread; i++)
+        {
+            char str[32];
+            snprintf(str, sizeof(str), "TestStringIdThread%u", i);
+
+            const char* internedString = Shipyard::StringId::FromHash(Shipyard::StringIdUtils::HashString(str)).GetString();
+
+            REQUIRE(internedString != nullptr);
+            REQUIRE(strcmp(internedString, str) == 0);
+        }
+    }
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+}
@@ -0,0 +1,219 @@
+#include <shipyardunittestprecomp.h>
+
+#include <extern/catch/catch.hpp>
+
+#include <system/string.h>
+#include <system/stringid.h>
+#include <system/stringview.h>
+
+#include <utils/unittestutils.h>
+
+TEST_CASE("Test StringView", "[StringView]")
+{
+    Shipyard::ScoppedGlobalAllocator scoppedGlobalAllocator;
+
+    SECTION("Construction")
+    {
+        Shipyard::StringView emptyView;
+
+        REQUIRE(emptyView.IsEmpty());
+        REQUIRE(emptyView.Size() == 0);
+        REQUIRE(emptyView == "");
+
+        const char* sz = "Test String";
+        Shipyard::StringView view(sz);
+
+        REQUIRE(view.Size() == 11);
+        REQUIRE(view.GetBuffer() == sz);
+        REQUIRE(view[5] == 'S');
+
+        Shipyard::StringView partialView(sz, 4);
+
+        REQUIRE(partialView.Size() == 4);
+        REQUIRE(partialView == "Test");
+        REQUIRE(partialView != "Test String");
+
+        Shipyard::StringA string("Test String");
+        Shipyard::StringView stringView = string;
+
+        REQUIRE(stringView.GetBuffer() == string.GetBuffer());
+        REQUIRE(stringView.Size() == string.Size());
+    }
+
+    SECTION("Substring")
+    {
+        Shipyard::StringView view("Hello, World");
+
+        Shipyard::StringView substring = view.Substring(7, 5);
+
+        REQUIRE(substring == "World");
+        REQUIRE(substring.GetBuffer() == view.GetBuffer() + 7);
+
+        REQUIRE(view.Substring(7, 100) == "World");
+        REQUIRE(view.Substring(100, 5).IsEmpty());
+        REQUIRE(view.Substring(0, 0).IsEmpty());
+    }
+
+    SECTION("Find")
+    {
+        Shipyard::StringView view("RenderTarget[3] = rgba");
+
+        REQUIRE(view.FindIndexOfFirst('[', 0) == 12);
+        REQUIRE(view.FindIndexOfFirst('[', 13) == Shipyard::StringView::InvalidIndex);
+        REQUIRE(view.FindIndexOfFirst("Target", 0) == 6);
+        REQUIRE(view.FindIndexOfFirst("target", 0) == Shipyard::StringView::InvalidIndex);
+        REQUIRE(view.FindIndexOfFirst("rgba", 18) == 18);
+        REQUIRE(view.FindIndexOfFirst("rgbaa", 18) == Shipyard::StringView::InvalidIndex);
+
+        REQUIRE(view.FindIndexOfFirstCaseInsensitive("target", 0) == 6);
+        REQUIRE(view.FindIndexOfFirstCaseInsensitive('R', 1) == 5);
+
+        REQUIRE(view.FindIndexOfFirstReverse('r', view.Size() - 1) == 18);
+        REQUIRE(view.FindIndexOfFirstReverse('r', 17) == 8);
+        REQUIRE(view.FindIndexOfFirstReverse('R', 1000) == 0);
+        REQUIRE(view.FindIndexOfFirstReverse('z', 1000) == Shipyard::StringView::InvalidIndex);
+
+        // The view stops before the end of the string, characters after it are never matched.
+        Shipyard::StringView partialView(view.GetBuffer(), 6);
+
+        REQUIRE(partialView.FindIndexOfFirst("Target", 0) == Shipyard::StringView::InvalidIndex);
+        REQUIRE(partialView.FindIndexOfFirst('T', 0) == Shipyard::StringView::InvalidIndex);
+    }
+
+    SECTION("Trim")
+    {
+        Shipyard::StringView view(" \t\r\nDepthEnable \n");
+
+        REQUIRE(view.Trim() == "DepthEnable");
+        REQUIRE(view.TrimLeft() == "DepthEnable \n");
+        REQUIRE(view.TrimRight() == " \t\r\nDepthEnable");
+
+        REQUIRE(Shipyard::StringView("   ").Trim().IsEmpty());
+        REQUIRE(Shipyard::StringView().Trim().IsEmpty());
+    }
+
+    SECTION("Starts and ends with")
+    {
+        Shipyard::StringView view("shaders/generic.fx");
+
+        REQUIRE(view.StartsWith("shaders/"));
+        REQUIRE(view.StartsWith(""));
+        REQUIRE(!view.StartsWith("generic"));
+        REQUIRE(view.EndsWith(".fx"));
+        REQUIRE(!view.EndsWith(".hlsl"));
+        REQUIRE(!Shipyard::StringView("fx").EndsWith(".fx"));
+    }
+
+    SECTION("Compare")
+    {
+        Shipyard::StringView view("Abc");
+
+        REQUIRE(view.Compare("Abc") == 0);
+        REQUIRE(view.Compare("Abd") < 0);
+        REQUIRE(view.Compare("Abb") > 0);
+        REQUIRE(view.Compare("Ab") > 0);
+        REQUIRE(view.Compare("Abcd") < 0);
+
+        REQUIRE(view.CompareCaseInsensitive("aBC") == 0);
+        REQUIRE(view.CompareCaseInsensitive("aBD") < 0);
+        REQUIRE(view.CompareCaseInsensitive("ab") > 0);
+
+        REQUIRE(view.EqualCaseInsensitive("ABC"));
+        REQUIRE(!view.EqualCaseInsensitive("ABCD"));
+        REQUIRE(!view.EqualCaseInsensitive("ABD"));
+
+        // Views of the beginning of a longer string only compare their own characters.
+        Shipyard::StringView partialView("AbcDef", 3);
+
+        REQUIRE(partialView.Compare(view) == 0);
+        REQUIRE(partialView.EqualCaseInsensitive("abc"));
+        REQUIRE(partialView == view);
+    }
+
+    SECTION("Split")
+    {
+        Shipyard::InplaceArray<Shipyard::StringView, 8> parts;
+
+        Shipyard::StringView("data/shaders//generic.fx", 21).Split('/', parts);
+
+        REQUIRE(parts.Size() == 4);
+        REQUIRE(parts[0] == "data");
+        REQUIRE(parts[1] == "shaders");
+        REQUIRE(parts[2].IsEmpty());
+        REQUIRE(parts[3] == "generic");
+
+        // Same rules as StringSplit.
+        parts.Clear();
+        Shipyard::StringSplit("a.b.", '.', parts);
+
+        Shipyard::Array<Shipyard::StringA> stringParts;
+        Shipyard::StringSplit("a.b.", '.', stringParts);
+
+        REQUIRE(parts.Size() == stringParts.Size());
+        for (uint32_t i = 0; i < parts.Size(); i++)
+        {
+            REQUIRE(stringParts[i] == parts[i]);
+        }
+
+        parts.Clear();
+        Shipyard::StringSplit("", '.', parts);
+
+        REQUIRE(parts.Empty());
+    }
+
+    SECTION("String with views")
+    {
+        Shipyard::StringA string("Hello, World");
+
+        Shipyard::StringView substringView = string.SubstringView(7, 100);
+
+        REQUIRE(substringView == "World");
+        REQUIRE(substringView.GetBuffer() == string.GetBuffer() + 7);
+
+        REQUIRE(string.FindIndexOfFirst(Shipyard::StringView("World!", 5), 0) == 7);
+        REQUIRE(string.FindIndexOfFirstCaseInsensitive(Shipyard::StringView("WORLD!", 5), 0) == 7);
+
+        REQUIRE(string.Compare(Shipyard::StringView("Hello, World!", 12)) == 0);
+        REQUIRE(string.Compare(Shipyard::StringView("Hello", 5)) > 0);
+        REQUIRE(string.CompareCaseInsensitive(Shipyard::StringView("hello, world")) == 0);
+        REQUIRE(string.EqualCaseInsensitive(Shipyard::StringView("HELLO, WORLD!", 12)));
+
+        REQUIRE(string == Shipyard::StringView("Hello, World!", 12));
+        REQUIRE(string != Shipyard::StringView("Hello, World!", 13));
+
+        Shipyard::StringA constructedString(Shipyard::StringView("Test String", 4));
+
+        REQUIRE(constructedString == "Test");
+        REQUIRE(constructedString.GetBuffer()[4] == '\0');
+
+        constructedString += Shipyard::StringView(" String!", 7);
+
+        REQUIRE(constructedString == "Test String");
+
+        constructedString.Insert(4, Shipyard::StringView("ed ", 2));
+
+        REQUIRE(constructedString == "Tested String");
+
+        // Assigning a view on the string itself.
+        constructedString = constructedString.SubstringView(7, 3);
+
+        REQUIRE(constructedString == "Str");
+
+        constructedString.Append(Shipyard::StringView("ing!", 3));
+
+        REQUIRE(constructedString == "String");
+
+        Shipyard::SmallInplaceStringA inplaceString;
+        inplaceString.Assign(Shipyard::StringView("Inplace String", 7));
+
+        REQUIRE(inplaceString == "Inplace");
+    }
+
+    SECTION("StringId from view")
+    {
+        Shipyard::StringView view("AlbedoTexture", 6);
+
+        REQUIRE(Shipyard::StringId(view) == SHIP_STRING_ID("Albedo"));
+        REQUIRE(Shipyard::StringId::CreateCaseInsensitive(Shipyard::StringView("ALBEDO")) == SHIP_STRING_ID("albedo"));
+    }
+}
@@ -9,7 +9,7 @@ namespace Shipyard
     class ScoppedGlobalAllocator
     {
     public:
-        ScoppedGlobalAllocator()
+        ScoppedGlobalAllocator(shipBool useThreadLocalCache = false)
             : m_pHeap(nullptr)
         {
             size_t totalHeapSize = 16 * 1024 * 1024;
@@ -37,25 +37,28 @@ namespace Shipyard
 
                 secondPoolAllocatorSize = numChunks * chunkSize;
 
-                void* pHeap = reinterpret_cast<void*>(Shipyard::MemoryUtils::AlignAddress(size_t(m_pHeap) + firstPoolAllocatorSize, chunkSize));
+                void* pHeap = reinterpret_cast<void*>(Shipyard::MemoryUtils::AlignAddress(size_t(m_FirstPoolAllocator.GetHeap()) + firstPoolAllocatorSize, chunkSize));
 
                 m_SecondPoolAllocator.Create(pHeap, numChunks, chunkSize);
             }
 
             {
-                size_t previousSize = firstPoolAllocatorSize + secondPoolAllocatorSize;
-
-                size_t heapStartAddress = size_t(m_pHeap) + previousSize;
+                // Pools' heaps may have been shifted by their alignment, so start right after the last one to avoid overlapping it.
+                size_t heapStartAddress = size_t(m_SecondPoolAllocator.GetHeap()) + secondPoolAllocatorSize;
                 void* pHeap = reinterpret_cast<void*>(heapStartAddress);
 
+                size_t previousSize = heapStartAddress - size_t(m_pHeap);
+
                 m_FixedHeapAllocator.Create(pHeap, totalHeapSize - previousSize);
             }
 
             Shipyard::GlobalAllocator::AllocatorInitEntry initEntries[3];
             initEntries[0].pAllocator = &m_FirstPoolAllocator;
             initEntries[0].maxAllocationSize = 16;
+            initEntries[0].useThreadLocalCache = useThreadLocalCache;
             initEntries[1].pAllocator = &m_SecondPoolAllocator;
             initEntries[1].maxAllocationSize = 32;
+            initEntries[1].useThreadLocalCache = useThreadLocalCache;
             initEntries[2].pAllocator = &m_FixedHeapAllocator;
             initEntries[2].maxAllocationSize = size_t(-1);
 
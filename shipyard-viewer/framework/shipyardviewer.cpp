@@ -26,6 +26,7 @@
 #include <graphics/shipyardimgui.h>
 
 #include <system/logger.h>
+#include <system/profiler.h>
 
 #include <tools/meshimporter.h>
 
@@ -81,7 +82,8 @@ ShipyardViewer::~ShipyardViewer()
 
     GetLogger().CloseLog();
 
-    m_FixedHeapAllocator.Destroy();
+    m_TLSFAllocator.Destroy();
+    m_SmallObjectAllocator.Destroy();
     m_PoolAllocator64.Destroy();
     m_PoolAllocator32.Destroy();
     m_PoolAllocator16.Destroy();
@@ -112,13 +114,17 @@ shipBool ShipyardViewer::CreateApp(HWND windowHandle, shipUint32 windowWidth, sh
     void* pHeap32 = reinterpret_cast<void*>(MemoryUtils::AlignAddress(size_t(pHeap16) + numChunks * 16, 32));
     void* pHeap64 = reinterpret_cast<void*>(MemoryUtils::AlignAddress(size_t(pHeap32) + numChunks * 32, 64));
 
-    void* pFixedHeap = reinterpret_cast<void*>(size_t(pHeap64) + numChunks * 64);
-    size_t fixedHeapSize = heapSize - (size_t(pHeap64) + numChunks * 64 - size_t(m_pHeap));
+    size_t smallObjectHeapSize = 32 * 1024 * 1024;
+    void* pSmallObjectHeap = reinterpret_cast<void*>(size_t(pHeap64) + numChunks * 64);
+
+    void* pTLSFHeap = reinterpret_cast<void*>(size_t(pSmallObjectHeap) + smallObjectHeapSize);
+    size_t tlsfHeapSize = heapSize - (size_t(pTLSFHeap) - size_t(m_pHeap));
 
     m_PoolAllocator16.Create(pHeap16, numChunks, 16);
     m_PoolAllocator32.Create(pHeap32, numChunks, 32);
     m_PoolAllocator64.Create(pHeap64, numChunks, 64);
-    m_FixedHeapAllocator.Create(pFixedHeap, fixedHeapSize);
+    m_SmallObjectAllocator.Create(pSmallObjectHeap, smallObjectHeapSize);
+    m_TLSFAllocator.Create(pTLSFHeap, tlsfHeapSize);
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
     size_t debugHeapSize = 32 * 1024 * 1024;
@@ -129,20 +135,26 @@ shipBool ShipyardViewer::CreateApp(HWND windowHandle, shipUint32 windowWidth, sh
     m_PoolAllocator16.SetAllocatorDebugName("PoolAllocator 16 bytes");
     m_PoolAllocator32.SetAllocatorDebugName("PoolAllocator 32 bytes");
     m_PoolAllocator64.SetAllocatorDebugName("PoolAllocator 64 bytes");
-    m_FixedHeapAllocator.SetAllocatorDebugName("FixedHeapAllocator");
+    m_SmallObjectAllocator.SetAllocatorDebugName("SmallObjectAllocator");
+    m_TLSFAllocator.SetAllocatorDebugName("TLSFAllocator");
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
-    GlobalAllocator::AllocatorInitEntry allocatorInitEntries[4];
+    GlobalAllocator::AllocatorInitEntry allocatorInitEntries[5];
     allocatorInitEntries[0].pAllocator = &m_PoolAllocator16;
     allocatorInitEntries[0].maxAllocationSize = 16;
+    allocatorInitEntries[0].useThreadLocalCache = true;
     allocatorInitEntries[1].pAllocator = &m_PoolAllocator32;
     allocatorInitEntries[1].maxAllocationSize = 32;
+    allocatorInitEntries[1].useThreadLocalCache = true;
     allocatorInitEntries[2].pAllocator = &m_PoolAllocator64;
     allocatorInitEntries[2].maxAllocationSize = 64;
-    allocatorInitEntries[3].pAllocator = &m_FixedHeapAllocator;
-    allocatorInitEntries[3].maxAllocationSize = 0;
+    allocatorInitEntries[2].useThreadLocalCache = true;
+    allocatorInitEntries[3].pAllocator = &m_SmallObjectAllocator;
+    allocatorInitEntries[3].maxAllocationSize = SmallObjectAllocator::ms_MaxAllocationSize;
+    allocatorInitEntries[4].pAllocator = &m_TLSFAllocator;
+    allocatorInitEntries[4].maxAllocationSize = 0;
 
-    GetGlobalAllocator().Create(allocatorInitEntries, 4);
+    GetGlobalAllocator().Create(allocatorInitEntries, 5);
 
     m_pGfxRenderDevice = SHIP_NEW(GFXRenderDevice, 1);
     m_pGfxRenderDevice->Create();
@@ -211,6 +223,9 @@ shipBool ShipyardViewer::CreateApp(HWND windowHandle, shipUint32 windowWidth, sh
 
 void ShipyardViewer::ComputeOneFrame()
 {
+    SHIP_PROFILE_FRAME();
+    SHIP_PROFILE_SCOPE("ShipyardViewer::ComputeOneFrame");
+
     StartNewImGuiFrame();
     ImGuizmo::BeginFrame();
 
@@ -268,6 +283,14 @@ void ShipyardViewer::ComputeOneFrame()
         imguizmoMode = ImGuizmo::MODE::LOCAL;
     }
 
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    constexpr int keyM = 0x4D;
+    if (ImGui::IsKeyPressed(keyM))
+    {
+        DebugAllocator::GetInstance().DumpCallSiteStatisticsToCSV("shipyard_viewer_allocations.csv");
+    }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
     ImGuizmo::Manipulate(
             reinterpret_cast<shipFloat*>(&viewFromWorldMatrix),
             reinterpret_cast<shipFloat*>(&projectionFromViewMatrix),
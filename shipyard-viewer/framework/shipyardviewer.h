@@ -9,8 +9,9 @@
 #include <graphics/wrapper/wrapper_common.h>
 
 #include <system/memory.h>
-#include <system/memory/fixedheapallocator.h>
+#include <system/memory/tlsfallocator.h>
 #include <system/memory/poolallocator.h>
+#include <system/memory/smallobjectallocator.h>
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 #include <system/memory/debugallocator.h>
@@ -46,7 +47,8 @@ namespace Shipyard
         PoolAllocator m_PoolAllocator16;
         PoolAllocator m_PoolAllocator32;
         PoolAllocator m_PoolAllocator64;
-        FixedHeapAllocator m_FixedHeapAllocator;
+        SmallObjectAllocator m_SmallObjectAllocator;
+        TLSFAllocator m_TLSFAllocator;
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
         void* m_pDebugHeap = nullptr;
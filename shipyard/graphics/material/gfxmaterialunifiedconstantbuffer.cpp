@@ -8,6 +8,7 @@
 
 #include <system/array.h>
 #include <system/atomicoperations.h>
+#include <system/profiler.h>
 #include <system/systemdebug.h>
 
 namespace Shipyard
@@ -157,6 +158,8 @@ void* GFXMaterialUnifiedConstantBuffer::MapBufferForShaderInputProvider(const Sh
 
 GFXByteBufferHandle GFXMaterialUnifiedConstantBuffer::GetUpdatedMaterialUnifiedConstantBuffer(DirectRenderCommandList& gfxDirectRenderCommandList)
 {
+    SHIP_PROFILE_SCOPE("GFXMaterialUnifiedConstantBuffer::GetUpdatedMaterialUnifiedConstantBuffer");
+
     if (m_IsDirty)
     {
         // For now, Write_Discard will do. Will revisit later.
@@ -6,6 +6,7 @@
 
 #include <graphics/rendercontext.h>
 
+#include <system/profiler.h>
 #include <system/systemdebug.h>
 
 namespace Shipyard
@@ -73,6 +74,8 @@ shipBool RenderGraph::BuildRenderGraph()
 
 void RenderGraph::ExecuteRenderGraph(RenderContext& renderContext)
 {
+    SHIP_PROFILE_SCOPE("RenderGraph::ExecuteRenderGraph");
+
     for (shipUint32 i = 0; i < m_OrderedRenderPassesToExecute.Size(); i++)
     {
         m_OrderedRenderPassesToExecute[i]->Execute(renderContext);
@@ -5,6 +5,7 @@
 #include <graphics/shader/shaderresourcebinder.h>
 
 #include <system/memory.h>
+#include <system/profiler.h>
 
 namespace Shipyard
 {;
@@ -68,6 +69,8 @@ ShaderDatabase::~ShaderDatabase()
 
 shipBool ShaderDatabase::Load(const StringT& filename)
 {
+    SHIP_PROFILE_SCOPE("ShaderDatabase::Load");
+
     m_Filename = filename;
 
     if (!m_FileHandler.Open(m_Filename, FileHandlerOpenFlag(FileHandlerOpenFlag_ReadWrite | FileHandlerOpenFlag_Binary)))
@@ -119,6 +122,7 @@ shipBool ShaderDatabase::Load(const StringT& filename)
     {
         m_ShaderEntryKeys.Reserve(shaderEntriesHeader.numShaderEntries);
         m_ShaderEntrySets.Reserve(shaderEntriesHeader.numShaderEntries);
+        m_ShaderEntryIndices.Reserve(shaderEntriesHeader.numShaderEntries);
     }
 
     for (shipUint32 i = 0; i < shaderEntriesHeader.numShaderEntries; i++)
@@ -130,6 +134,9 @@ shipBool ShaderDatabase::Load(const StringT& filename)
             Invalidate();
             return false;
         }
+
+        shipUint32 shaderSetIndex = m_ShaderEntryKeys.Size() - 1;
+        m_ShaderEntryIndices.Insert(m_ShaderEntryKeys[shaderSetIndex].shaderKey, shaderSetIndex);
     }
 
     return true;
@@ -144,6 +151,7 @@ void ShaderDatabase::Close()
     m_ShaderInputProviderDeclarationEntries.Clear();
 
     m_ShaderEntryKeys.Clear();
+    m_ShaderEntryIndices.Clear();
 
     for (ShaderEntrySet& shaderEntrySet : m_ShaderEntrySets)
     {
@@ -208,25 +216,15 @@ shipBool ShaderDatabase::Invalidate()
 
 shipBool ShaderDatabase::RetrieveShadersForShaderKey(const ShaderKey& shaderKey, ShaderEntrySet& shaderEntrySet) const
 {
-    shipUint32 shaderSetIndex = 0;
-    shipUint32 numShaderEntries = m_ShaderEntryKeys.Size();
+    const shipUint32* pShaderSetIndex = m_ShaderEntryIndices.Find(shaderKey);
 
-    for (; shaderSetIndex < numShaderEntries; shaderSetIndex++)
-    {
-        const ShaderEntryKey& shaderEntryKey = m_ShaderEntryKeys[shaderSetIndex];
-        if (shaderEntryKey.shaderKey == shaderKey)
-        {
-            break;
-        }
-    }
-
-    shipBool foundShaderKey = (shaderSetIndex < numShaderEntries);
+    shipBool foundShaderKey = (pShaderSetIndex != nullptr);
     if (!foundShaderKey)
     {
         return false;
     }
 
-    shaderEntrySet = m_ShaderEntrySets[shaderSetIndex];
+    shaderEntrySet = m_ShaderEntrySets[*pShaderSetIndex];
     SHIP_ASSERT((shaderEntrySet.rawVertexShaderSize + shaderEntrySet.rawPixelShaderSize + shaderEntrySet.rawHullShaderSize +
             shaderEntrySet.rawDomainShaderSize + shaderEntrySet.rawGeometryShaderSize + shaderEntrySet.rawComputeShaderSize) > 0);
 
@@ -235,24 +233,16 @@ shipBool ShaderDatabase::RetrieveShadersForShaderKey(const ShaderKey& shaderKey,
 
 void ShaderDatabase::RemoveShadersForShaderKey(const ShaderKey& shaderKey)
 {
-    shipUint32 shaderSetIndexToRemove = 0;
-    shipUint32 numShaderEntries = m_ShaderEntryKeys.Size();
-
-    for (; shaderSetIndexToRemove < numShaderEntries; shaderSetIndexToRemove++)
-    {
-        const ShaderEntryKey& shaderEntryKey = m_ShaderEntryKeys[shaderSetIndexToRemove];
-        if (shaderEntryKey.shaderKey == shaderKey)
-        {
-            break;
-        }
-    }
+    const shipUint32* pShaderSetIndexToRemove = m_ShaderEntryIndices.Find(shaderKey);
 
-    shipBool foundShaderKey = (shaderSetIndexToRemove < numShaderEntries);
+    shipBool foundShaderKey = (pShaderSetIndexToRemove != nullptr);
     if (!foundShaderKey)
     {
         return;
     }
 
+    shipUint32 shaderSetIndexToRemove = *pShaderSetIndexToRemove;
+
     size_t positionToRemoveInFile = GetShaderEntrySetStartPosition();
 
     for (shipUint32 i = 0; i < shaderSetIndexToRemove; i++)
@@ -282,6 +272,15 @@ void ShaderDatabase::RemoveShadersForShaderKey(const ShaderKey& shaderKey)
     m_ShaderEntryKeys.RemoveAtPreserveOrder(shaderSetIndexToRemove);
     m_ShaderEntrySets.RemoveAtPreserveOrder(shaderSetIndexToRemove);
 
+    m_ShaderEntryIndices.Remove(shaderKey);
+
+    // Every following entry moved down by one.
+    shipUint32 numShaderEntries = m_ShaderEntryKeys.Size();
+    for (shipUint32 i = shaderSetIndexToRemove; i < numShaderEntries; i++)
+    {
+        m_ShaderEntryIndices[m_ShaderEntryKeys[i].shaderKey] = i;
+    }
+
     ShaderEntriesHeader shaderEntriesHeader;
 
     size_t shaderEntriesHeaderPosition = sizeof(DatabaseHeader);
@@ -347,6 +346,8 @@ void ShaderDatabase::AppendShadersForShaderKey(const ShaderKey& shaderKey, Shade
     ShaderEntryKey& newShaderEntryKey = m_ShaderEntryKeys.Grow();
     newShaderEntryKey.shaderKey = shaderKey;
 
+    m_ShaderEntryIndices.Insert(shaderKey, m_ShaderEntryKeys.Size() - 1);
+
     m_ShaderEntrySets.Add(shaderEntrySet);
 
     ShaderEntriesHeader shaderEntriesHeader;
@@ -454,7 +455,8 @@ shipBool ShaderDatabase::ValidateShaderInputProviderDeclarations(shipUint8*& dat
         memcpy(&newEntry, databaseBuffer, sizeof(newEntry));
         databaseBuffer += sizeof(newEntry);
 
-        if (shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(newEntry.shaderInputProviderDeclarationName) == nullptr)
+        StringId shaderInputProviderDeclarationNameId(newEntry.shaderInputProviderDeclarationName, newEntry.shaderInputProviderDeclarationNameLength);
+        if (shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(shaderInputProviderDeclarationNameId) == nullptr)
         {
             return false;
         }
@@ -463,7 +465,7 @@ shipBool ShaderDatabase::ValidateShaderInputProviderDeclarations(shipUint8*& dat
     return true;
 }
 
-shipBool ShaderDatabase::LoadNextShaderEntry(shipUint8*& databaseBuffer, BigArray<ShaderEntryKey>& shaderEntryKeys, BigArray<ShaderEntrySet>& shaderEntrySets) const
+shipBool ShaderDatabase::LoadNextShaderEntry(shipUint8*& databaseBuffer, Array<ShaderEntryKey>& shaderEntryKeys, Array<ShaderEntrySet>& shaderEntrySets) const
 {
     ShaderEntryHeader shaderEntryHeader = *(ShaderEntryHeader*)databaseBuffer;
 
@@ -650,9 +652,10 @@ shipBool ShaderDatabase::ReadShaderResourceBinderEntries(shipUint8*& databaseBuf
 
             if (shaderInputProviderNameIndex != 0xffffffff)
             {
-                const shipChar* shaderInputProviderName = m_ShaderInputProviderDeclarationEntries[shaderInputProviderNameIndex].shaderInputProviderDeclarationName;
+                const ShaderInputProviderDeclarationEntry& entry = m_ShaderInputProviderDeclarationEntries[shaderInputProviderNameIndex];
+                StringId shaderInputProviderNameId(entry.shaderInputProviderDeclarationName, entry.shaderInputProviderDeclarationNameLength);
 
-                shaderInputProviderDeclaration = shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(shaderInputProviderName);
+                shaderInputProviderDeclaration = shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(shaderInputProviderNameId);
                 if (shaderInputProviderDeclaration == nullptr)
                 {
                     return false;
@@ -9,6 +9,7 @@
 #include <system/systemcommon.h>
 
 #include <system/array.h>
+#include <system/hashmap.h>
 #include <system/wrapper/wrapper.h>
 
 namespace Shipyard
@@ -74,7 +75,7 @@ namespace Shipyard
     private:
         shipBool ValidateShaderInputProviderDeclarations(shipUint8*& databaseBuffer, Array<ShaderInputProviderDeclarationEntry>& shaderInputProviderDeclarationEntries) const;
 
-        shipBool LoadNextShaderEntry(shipUint8*& databaseBuffer, BigArray<ShaderEntryKey>& shaderEntryKeys, BigArray<ShaderEntrySet>& shaderEntrySets) const;
+        shipBool LoadNextShaderEntry(shipUint8*& databaseBuffer, Array<ShaderEntryKey>& shaderEntryKeys, Array<ShaderEntrySet>& shaderEntrySets) const;
 
         void WriteRootSignatureParameters(const Array<RootSignatureParameterEntry>& rootSignatureParameters);
         void WriteShaderResourceBinderEntries(const Array<ShaderResourceBinder::ShaderResourceBinderEntry>& shaderResourceBinderEntries);
@@ -89,7 +90,10 @@ namespace Shipyard
         FileHandlerStream m_FileHandler;
 
         Array<ShaderInputProviderDeclarationEntry> m_ShaderInputProviderDeclarationEntries;
-        BigArray<ShaderEntryKey> m_ShaderEntryKeys;
-        BigArray<ShaderEntrySet> m_ShaderEntrySets;
+        Array<ShaderEntryKey> m_ShaderEntryKeys;
+        Array<ShaderEntrySet> m_ShaderEntrySets;
+
+        // Index of each shader key in m_ShaderEntryKeys, which must stay in the same order as the entries in the file.
+        HashMap<ShaderKey, shipUint32> m_ShaderEntryIndices;
     };
 }
\ No newline at end of file
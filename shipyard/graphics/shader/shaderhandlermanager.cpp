@@ -62,7 +62,7 @@ shipBool ShaderHandlerManager::Initialize(GFXRenderDevice& gfxRenderDevice, Shad
     mandatoryShaderFamilies.Add(ShaderFamily::Error);
     mandatoryShaderFamilies.Add(ShaderFamily::ImGui);
 
-    BigArray<ShaderKey> mandatoryShaderKeys;
+    Array<ShaderKey> mandatoryShaderKeys;
 
     for (ShaderFamily shaderFamily : mandatoryShaderFamilies)
     {
@@ -100,9 +100,9 @@ void ShaderHandlerManager::Destroy()
         return;
     }
 
-    for (const std::pair<ShaderKey, ShaderHandler*>& keyValue : m_ShaderHandlers)
+    for (const HashMapEntry<ShaderKey, ShaderHandler*>& shaderHandlerEntry : m_ShaderHandlers)
     {
-        ShaderHandler* shaderHandler = keyValue.second;
+        ShaderHandler* shaderHandler = shaderHandlerEntry.value;
 
         if (shaderHandler->m_GfxVertexShaderHandle.IsValid())
         {
@@ -147,7 +147,7 @@ void ShaderHandlerManager::Destroy()
         SHIP_DELETE(shaderHandler);
     }
 
-    m_ShaderHandlers.clear();
+    m_ShaderHandlers.Clear();
 
     m_RenderDevice = nullptr;
 }
@@ -210,12 +210,12 @@ ShaderHandler* ShaderHandlerManager::GetShaderHandlerForShaderKey(ShaderKey shad
 
     shipBool createShaders = gotRecompiledSinceLastAccess;
 
-    auto it = m_ShaderHandlers.find(shaderKey);
-    if (it == m_ShaderHandlers.end())
+    ShaderHandler** ppShaderHandler = m_ShaderHandlers.Find(shaderKey);
+    if (ppShaderHandler == nullptr)
     {
         shaderHandler = SHIP_NEW(ShaderHandler, 1)(shaderKey);
 
-        m_ShaderHandlers[shaderKey] = shaderHandler;
+        m_ShaderHandlers.Insert(shaderKey, shaderHandler);
 
         if (shaderKey.GetShaderFamily() == ShaderFamily::Error)
         {
@@ -228,7 +228,7 @@ ShaderHandler* ShaderHandlerManager::GetShaderHandlerForShaderKey(ShaderKey shad
     }
     else
     {
-        shaderHandler = it->second;
+        shaderHandler = *ppShaderHandler;
     }
 
     if (createShaders)
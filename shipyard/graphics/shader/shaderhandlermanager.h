@@ -6,7 +6,7 @@
 
 #include <graphics/graphicssingleton.h>
 
-#include <map>
+#include <system/hashmap.h>
 
 namespace Shipyard
 {
@@ -28,7 +28,7 @@ namespace Shipyard
 
     private:
         GFXRenderDevice* m_RenderDevice;
-        std::map<ShaderKey, ShaderHandler*> m_ShaderHandlers;
+        HashMap<ShaderKey, ShaderHandler*> m_ShaderHandlers;
         ShaderDatabase* m_ShaderDatabase;
     };
 
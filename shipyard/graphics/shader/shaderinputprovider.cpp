@@ -1068,12 +1068,12 @@ shipUint32 ShaderInputProviderManager::GetTexture2DHandlesFromProvider(const Sha
     return numTexture2DHandles;
 }
 
-ShaderInputProviderDeclaration* ShaderInputProviderManager::FindShaderInputProviderDeclarationFromName(const StringA& shaderInputProviderDeclarationName) const
+ShaderInputProviderDeclaration* ShaderInputProviderManager::FindShaderInputProviderDeclarationFromName(StringId shaderInputProviderDeclarationNameId) const
 {
     ShaderInputProviderDeclaration* pCurrent = m_pHead;
     while (pCurrent != nullptr)
     {
-        if (shaderInputProviderDeclarationName == pCurrent->m_ShaderInputProviderName)
+        if (shaderInputProviderDeclarationNameId == pCurrent->m_ShaderInputProviderNameId)
         {
             return pCurrent;
         }
@@ -1170,11 +1170,16 @@ const shipChar* ShaderInputProviderDeclaration::GetShaderInputProviderName() con
     return m_ShaderInputProviderName;
 }
 
-shipBool ShaderInputProviderDeclaration::HasShaderInput(const shipChar* shaderInputName, shipInt32& offsetInProvider) const
+StringId ShaderInputProviderDeclaration::GetShaderInputProviderNameId() const
+{
+    return m_ShaderInputProviderNameId;
+}
+
+shipBool ShaderInputProviderDeclaration::HasShaderInput(StringId shaderInputNameId, shipInt32& offsetInProvider) const
 {
     for (shipUint32 i = 0; i < m_NumShaderInputDeclarations; i++)
     {
-        if (StringCompare(m_ShaderInputDeclarations[i].Name, shaderInputName) == 0)
+        if (m_ShaderInputDeclarations[i].NameId == shaderInputNameId)
         {
             offsetInProvider = m_ShaderInputDeclarations[i].DataOffsetInProvider;
             return true;
@@ -1184,11 +1189,11 @@ shipBool ShaderInputProviderDeclaration::HasShaderInput(const shipChar* shaderIn
     return false;
 }
 
-ShaderInputProviderDeclaration::ShaderInputDeclaration const * const ShaderInputProviderDeclaration::GetShaderInput(const shipChar* shaderInputName, shipInt32& offsetInProvider) const
+ShaderInputProviderDeclaration::ShaderInputDeclaration const * const ShaderInputProviderDeclaration::GetShaderInput(StringId shaderInputNameId, shipInt32& offsetInProvider) const
 {
     for (shipUint32 i = 0; i < m_NumShaderInputDeclarations; i++)
     {
-        if (StringCompare(m_ShaderInputDeclarations[i].Name, shaderInputName) == 0)
+        if (m_ShaderInputDeclarations[i].NameId == shaderInputNameId)
         {
             offsetInProvider = m_ShaderInputDeclarations[i].DataOffsetInProvider;
             return &m_ShaderInputDeclarations[i];
@@ -8,6 +8,7 @@
 
 #include <system/array.h>
 #include <system/string.h>
+#include <system/stringid.h>
 
 #include <type_traits>
 
@@ -152,6 +153,7 @@ namespace Shipyard
         struct ShaderInputDeclaration
         {
             const shipChar* Name = "";
+            StringId NameId;
             ShaderInputType Type = ShaderInputType::Scalar;
             ShaderInputUsage Usage = ShaderInputUsage::ScalarInConstantBuffer;
             ShaderInputScalarType ScalarType = ShaderInputScalarType::Unknown;
@@ -183,11 +185,13 @@ namespace Shipyard
         ShaderInputProviderUsage GetShaderInputProviderUsage() const;
 
         const shipChar* GetShaderInputProviderName() const;
-        shipBool HasShaderInput(const shipChar* shaderInputName, shipInt32& offsetInProvider) const;
-        ShaderInputDeclaration const * const GetShaderInput(const shipChar* shaderInputName, shipInt32& offsetInProvider) const;
+        StringId GetShaderInputProviderNameId() const;
+        shipBool HasShaderInput(StringId shaderInputNameId, shipInt32& offsetInProvider) const;
+        ShaderInputDeclaration const * const GetShaderInput(StringId shaderInputNameId, shipInt32& offsetInProvider) const;
 
     protected:
         const shipChar* m_ShaderInputProviderName;
+        StringId m_ShaderInputProviderNameId;
         ShaderInputDeclaration m_ShaderInputDeclarations[MaxShaderInputsPerProvider];
         ShaderInputCopyRange m_ShaderInputCopyRanges[MaxShaderInputsPerProvider];
         ShaderInputProviderUsage m_ShaderInputProviderUsage;
@@ -228,7 +232,7 @@ namespace Shipyard
 
         shipUint32 GetTexture2DHandlesFromProvider(const ShaderInputProvider& shaderInputProvider, GFXTexture2DHandle* pGfxTextureHandles) const;
 
-        ShaderInputProviderDeclaration* FindShaderInputProviderDeclarationFromName(const StringA& shaderInputProviderDeclarationName) const;
+        ShaderInputProviderDeclaration* FindShaderInputProviderDeclarationFromName(StringId shaderInputProviderDeclarationNameId) const;
 
         const ShaderInputProvider* GetShaderInputProviderForDeclaration(const Array<const ShaderInputProvider*>& shaderInputProviders, const ShaderInputProviderDeclaration* shaderInputProviderDeclaration) const;
         const shipChar* GetShaderInputNameFromProvider(const ShaderInputProviderDeclaration* shaderInputProviderDeclaration, shipInt32 dataOffsetInProvider) const;
@@ -390,6 +394,7 @@ namespace Shipyard
         { \
             SHIP_ASSERT(strlen(#shaderInputProviderType) <= ShaderInputProviderDeclaration::MaxShaderInputProviderNameLength); \
             m_ShaderInputProviderName = #shaderInputProviderType; \
+            m_ShaderInputProviderNameId = StringId(m_ShaderInputProviderName); \
             m_ShaderInputProviderUsage = ShaderInputProviderUsage::##shaderInputProviderUsage; \
             shipInt32 offsetInBuffer = 0;
 
@@ -407,6 +412,7 @@ namespace Shipyard
 
 #define SHIP_SHADER_INPUT_INTERNAL(shaderInputType, shaderInputUsage, shaderInputScalarType, shaderInputName, shaderInputData) \
         m_ShaderInputDeclarations[m_NumShaderInputDeclarations].Name = shaderInputName; \
+        m_ShaderInputDeclarations[m_NumShaderInputDeclarations].NameId = StringId(shaderInputName); \
         m_ShaderInputDeclarations[m_NumShaderInputDeclarations].Type = shaderInputType; \
         m_ShaderInputDeclarations[m_NumShaderInputDeclarations].Usage = shaderInputUsage; \
         m_ShaderInputDeclarations[m_NumShaderInputDeclarations].ScalarType = shaderInputScalarType; \
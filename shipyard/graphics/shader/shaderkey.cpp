@@ -156,19 +156,19 @@ ShaderKey::RawShaderKeyType ShaderKey::GetRawShaderKeyOptions() const
     return (m_RawShaderKey & (ms_ShaderOptionMask << ms_ShaderOptionShift));
 }
 
-void ShaderKey::GetEveryShaderKeyForShaderFamily(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily)
+void ShaderKey::GetEveryShaderKeyForShaderFamily(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily)
 {
     constexpr shipBool onlyValidShaderKeys = false;
     GetEveryShaderKeyForShaderFamilyInternal(shaderFamily, everyShaderKeyForShaderFamily, onlyValidShaderKeys);
 }
 
-void ShaderKey::GetEveryValidShaderKeyForShaderFamily(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily)
+void ShaderKey::GetEveryValidShaderKeyForShaderFamily(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily)
 {
     constexpr shipBool onlyValidShaderKeys = true;
     GetEveryShaderKeyForShaderFamilyInternal(shaderFamily, everyShaderKeyForShaderFamily, onlyValidShaderKeys);
 }
 
-void ShaderKey::GetEveryShaderKeyForShaderFamilyInternal(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily, shipBool onlyValidShaderKeys)
+void ShaderKey::GetEveryShaderKeyForShaderFamilyInternal(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily, shipBool onlyValidShaderKeys)
 {
     Array<ShaderOption> everyPossibleShaderOption;
     ShaderKey::GetShaderKeyOptionsForShaderFamily(shaderFamily, everyPossibleShaderOption);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <system/array.h>
+#include <system/hash.h>
 #include <system/platform.h>
 
 #include <graphics/shader/shaderoptions.h>
@@ -32,10 +33,10 @@ namespace Shipyard
         static void InitializeShaderKeyGroups();
 
         static void GetShaderKeyOptionsForShaderFamily(ShaderFamily shaderFamily, Array<ShaderOption>& shaderOptions);
-        static void GetEveryShaderKeyForShaderFamily(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily);
-        static void GetEveryValidShaderKeyForShaderFamily(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily);
+        static void GetEveryShaderKeyForShaderFamily(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily);
+        static void GetEveryValidShaderKeyForShaderFamily(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily);
 
-        // Required to be used in a map (ShaderHandlerManager)
+        // Required to be sorted or used as a key in a HashMap
         shipBool operator< (const ShaderKey& rhs) const { return m_RawShaderKey < rhs.m_RawShaderKey; }
         shipBool operator== (const ShaderKey& rhs) const { return m_RawShaderKey == rhs.m_RawShaderKey; }
         shipBool operator!= (const ShaderKey& rhs) const { return m_RawShaderKey != rhs.m_RawShaderKey; }
@@ -49,7 +50,16 @@ namespace Shipyard
     private:
         RawShaderKeyType m_RawShaderKey;
 
-        static void GetEveryShaderKeyForShaderFamilyInternal(ShaderFamily shaderFamily, BigArray<ShaderKey>& everyShaderKeyForShaderFamily, shipBool onlyValidShaderKeys);
+        static void GetEveryShaderKeyForShaderFamilyInternal(ShaderFamily shaderFamily, Array<ShaderKey>& everyShaderKeyForShaderFamily, shipBool onlyValidShaderKeys);
+    };
+
+    template <>
+    struct DefaultHasher<ShaderKey>
+    {
+        shipUint64 operator() (const ShaderKey& shaderKey) const
+        {
+            return HashUint64(shaderKey.GetRawShaderKey());
+        }
     };
 }
 
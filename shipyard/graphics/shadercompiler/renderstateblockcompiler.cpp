@@ -15,28 +15,26 @@
 namespace Shipyard
 {;
 
-shipBool GetArrayIndexIfOptionIsAnArray(const StringA& value, shipUint32* outValue)
+shipBool GetArrayIndexIfOptionIsAnArray(const StringView& value, shipUint32* outValue)
 {
     size_t indexOfEndingBracket = value.FindIndexOfFirstReverse(']', value.Size() - 1);
-    if (indexOfEndingBracket == StringA::InvalidIndex)
+    if (indexOfEndingBracket == StringView::InvalidIndex)
     {
         return false;
     }
 
     size_t indexOfStartingBracket = value.FindIndexOfFirstReverse('[', indexOfEndingBracket);
-    if (indexOfStartingBracket == StringA::InvalidIndex)
+    if (indexOfStartingBracket == StringView::InvalidIndex)
     {
         return false;
     }
 
-    StringA numberString = value.Substring(indexOfStartingBracket + 1, indexOfEndingBracket - indexOfStartingBracket - 1);
+    StringView numberString = value.Substring(indexOfStartingBracket + 1, indexOfEndingBracket - indexOfStartingBracket - 1);
 
-    *outValue = shipUint32(atoi(numberString.GetBuffer()));
-
-    return true;
+    return InterpretIntegerValue(numberString, outValue);
 }
 
-RenderStateBlockCompilationError InterpretFillMode(const StringA& value, FillMode* outValue)
+RenderStateBlockCompilationError InterpretFillMode(const StringView& value, FillMode* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -56,7 +54,7 @@ RenderStateBlockCompilationError InterpretFillMode(const StringA& value, FillMod
     return renderStateBlockCompilationError;
 }
 
-RenderStateBlockCompilationError InterpretCullMode(const StringA& value, CullMode* outValue)
+RenderStateBlockCompilationError InterpretCullMode(const StringView& value, CullMode* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -80,7 +78,7 @@ RenderStateBlockCompilationError InterpretCullMode(const StringA& value, CullMod
     return renderStateBlockCompilationError;
 }
 
-RenderStateBlockCompilationError InterpretStencilOperation(const StringA& value, StencilOperation* outValue)
+RenderStateBlockCompilationError InterpretStencilOperation(const StringView& value, StencilOperation* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -124,7 +122,7 @@ RenderStateBlockCompilationError InterpretStencilOperation(const StringA& value,
     return renderStateBlockCompilationError;
 }
 
-RenderStateBlockCompilationError InterpretBlendFactor(const StringA& value, BlendFactor* outValue)
+RenderStateBlockCompilationError InterpretBlendFactor(const StringView& value, BlendFactor* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -204,7 +202,7 @@ RenderStateBlockCompilationError InterpretBlendFactor(const StringA& value, Blen
     return renderStateBlockCompilationError;
 }
 
-RenderStateBlockCompilationError InterpretBlendOperator(const StringA& value, BlendOperator* outValue)
+RenderStateBlockCompilationError InterpretBlendOperator(const StringView& value, BlendOperator* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -236,7 +234,7 @@ RenderStateBlockCompilationError InterpretBlendOperator(const StringA& value, Bl
     return renderStateBlockCompilationError;
 }
 
-RenderStateBlockCompilationError InterpretRenderTargetWriteMask(const StringA& value, RenderTargetWriteMask* outValue)
+RenderStateBlockCompilationError InterpretRenderTargetWriteMask(const StringView& value, RenderTargetWriteMask* outValue)
 {
     RenderStateBlockCompilationError renderStateBlockCompilationError = RenderStateBlockCompilationError::NoError;
 
@@ -281,18 +279,18 @@ RenderStateBlockCompilationError InterpretRenderTargetWriteMask(const StringA& v
 }
 
 shipBool InterpretStateBlockOption(
-        const StringA& renderPipelineStateOption,
-        const StringA& renderPipelineStateValue,
+        const StringView& renderPipelineStateOption,
+        const StringView& renderPipelineStateValue,
         RenderStateBlock& renderStateBlock,
         RenderStateBlockCompilationError& renderStateBlockCompilationError)
 {
-    if (renderPipelineStateOption == "")
+    if (renderPipelineStateOption.IsEmpty())
     {
         renderStateBlockCompilationError = RenderStateBlockCompilationError::MissingOption;
         return false;
     }
 
-    if (renderPipelineStateValue == "")
+    if (renderPipelineStateValue.IsEmpty())
     {
         renderStateBlockCompilationError = RenderStateBlockCompilationError::MissingValueForOption;
         return false;
@@ -20,7 +20,7 @@
 namespace Shipyard
 {;
 
-SamplerStateCompilerError InterpretSamplingFilterValue(const StringA& value, SamplingFilter* outValue)
+SamplerStateCompilerError InterpretSamplingFilterValue(const StringView& value, SamplingFilter* outValue)
 {
     if (value.EqualCaseInsensitive("Nearest"))
     {
@@ -38,7 +38,7 @@ SamplerStateCompilerError InterpretSamplingFilterValue(const StringA& value, Sam
     return SamplerStateCompilerError::NoError;
 }
 
-SamplerStateCompilerError InterpretAddressModeValue(const StringA& value, TextureAddressMode* outValue)
+SamplerStateCompilerError InterpretAddressModeValue(const StringView& value, TextureAddressMode* outValue)
 {
     if (value.EqualCaseInsensitive("Clamp"))
     {
@@ -64,7 +64,7 @@ SamplerStateCompilerError InterpretAddressModeValue(const StringA& value, Textur
     return SamplerStateCompilerError::NoError;
 }
 
-SamplerStateCompilerError InterpretBorderColor(const StringA& value, shipFloat outValue[4])
+SamplerStateCompilerError InterpretBorderColor(const StringView& value, shipFloat outValue[4])
 {
     shipUint32 colorRGBA8888 = 0;
     shipBool validOption = InterpretIntegerValue(value, &colorRGBA8888);
@@ -83,18 +83,18 @@ SamplerStateCompilerError InterpretBorderColor(const StringA& value, shipFloat o
 }
 
 shipBool InterpretStateBlockOption(
-        const StringA& samplerStateOption,
-        const StringA& samplerStateValue,
+        const StringView& samplerStateOption,
+        const StringView& samplerStateValue,
         SamplerState& samplerStateBlock,
         SamplerStateCompilerError& samplerStateBlockCompilationError)
 {
-    if (samplerStateOption == "")
+    if (samplerStateOption.IsEmpty())
     {
         samplerStateBlockCompilationError = SamplerStateCompilerError::MissingOption;
         return false;
     }
 
-    if (samplerStateValue == "")
+    if (samplerStateValue.IsEmpty())
     {
         samplerStateBlockCompilationError = SamplerStateCompilerError::MissingValueForOption;
         return false;
@@ -12,6 +12,9 @@
 #include <math/mathutilities.h>
 
 #include <system/logger.h>
+#include <system/profiler.h>
+
+#include <system/memory/scratchallocator.h>
 
 #pragma warning( disable : 4005 )
 
@@ -264,7 +267,7 @@ shipBool SplitShaderSourceAndRenderStateBlock(StringA& shaderSource, StringA& re
             }
         }
 
-        renderStateBlockSource = shaderSource.Substring(openingBracketIndex + 1, (endingBracketIndex - openingBracketIndex - 1));
+        renderStateBlockSource = shaderSource.SubstringView(openingBracketIndex + 1, (endingBracketIndex - openingBracketIndex - 1));
         shaderSource.Erase(renderStateBlockStartIndex, (endingBracketIndex - renderStateBlockStartIndex));
 
         return true;
@@ -273,14 +276,16 @@ shipBool SplitShaderSourceAndRenderStateBlock(StringA& shaderSource, StringA& re
     return true;
 }
 
-shipBool SplitShaderSourceAndOneSamplerStateBlock(
-        StringA& shaderSource,
-        StringA& samplerStateBlockSource,
-        StringA& samplerStateName,
+// Only finds the sampler state block, the shader source is left untouched. The block spans [samplerStateBlockStartIndex, samplerStateBlockEndIndex].
+shipBool FindOneSamplerStateBlock(
+        const StringA& shaderSource,
+        StringView& samplerStateBlockSource,
+        StringView& samplerStateName,
         shipUint32 startIndex,
-        shipUint32& samplerStateIndex)
+        size_t& samplerStateBlockStartIndex,
+        size_t& samplerStateBlockEndIndex)
 {
-    size_t samplerStateBlockStartIndex = shaderSource.FindIndexOfFirstCaseInsensitive(ShaderCompiler::SamplerStateBlockName, startIndex);
+    samplerStateBlockStartIndex = shaderSource.FindIndexOfFirstCaseInsensitive(ShaderCompiler::SamplerStateBlockName, startIndex);
     if (samplerStateBlockStartIndex == shaderSource.InvalidIndex)
     {
         return false;
@@ -305,6 +310,8 @@ shipBool SplitShaderSourceAndOneSamplerStateBlock(
 
     // Name must begin by a letter, and only be composed of letters and digits.
     shipBool beginning = true;
+    size_t samplerStateNameStartIndex = 0;
+    size_t samplerStateNameLength = 0;
     for (size_t i = firstSpaceIndex; i < newlineIndex; i++)
     {
         shipChar c = shaderSource[i];
@@ -312,7 +319,8 @@ shipBool SplitShaderSourceAndOneSamplerStateBlock(
         {
             if (isalpha(c))
             {
-                samplerStateName += c;
+                samplerStateNameStartIndex = i;
+                samplerStateNameLength = 1;
                 beginning = false;
             }
             else if (c != ' ' && c != '\t')
@@ -332,7 +340,7 @@ shipBool SplitShaderSourceAndOneSamplerStateBlock(
                 break;
             }
 
-            samplerStateName += c;
+            samplerStateNameLength += 1;
         }
     }
 
@@ -392,24 +400,36 @@ shipBool SplitShaderSourceAndOneSamplerStateBlock(
         return false;
     }
 
-    samplerStateBlockSource = shaderSource.Substring(openingBracketIndex + 1, (endingBracketIndex - openingBracketIndex - 2));
-    shaderSource.Erase(samplerStateBlockStartIndex, (endingBracketIndex - samplerStateBlockStartIndex + 1));
-
-    samplerStateIndex = shipUint32(samplerStateBlockStartIndex);
+    samplerStateName = shaderSource.SubstringView(samplerStateNameStartIndex, samplerStateNameLength);
+    samplerStateBlockSource = shaderSource.SubstringView(openingBracketIndex + 1, (endingBracketIndex - openingBracketIndex - 2));
+    samplerStateBlockEndIndex = endingBracketIndex;
 
     return true;
 }
 
 shipBool SplitShaderSourceAndSamplerStateBlocks(StringA& shaderSource, Array<ShaderCompiler::SamplerStateToBeCompiled>& samplerStatesToBeCompiled)
 {
+    // The shader source is copied once in a new string, replacing every sampler state block by a simple sampler declaration.
+    // A declaration is always shorter than its block, so the source's size is enough for the new string to never grow, which
+    // matters since the shader source usually lives in the caller's ScratchScope.
+    StringA newShaderSource(shaderSource.GetAllocator());
+    size_t numCharsCopied = 0;
+
     shipUint32 startIndex = 0;
     shipBool continueParsing = true;
     while (continueParsing)
     {
-        StringA samplerStateBlockSource;
-        StringA samplerStateName;
-        shipUint32 samplerStateIndex = 0;
-        continueParsing = SplitShaderSourceAndOneSamplerStateBlock(shaderSource, samplerStateBlockSource, samplerStateName, startIndex, samplerStateIndex);
+        StringView samplerStateBlockSource;
+        StringView samplerStateName;
+        size_t samplerStateBlockStartIndex = 0;
+        size_t samplerStateBlockEndIndex = 0;
+        continueParsing = FindOneSamplerStateBlock(
+                shaderSource,
+                samplerStateBlockSource,
+                samplerStateName,
+                startIndex,
+                samplerStateBlockStartIndex,
+                samplerStateBlockEndIndex);
 
         if (samplerStateBlockSource.IsEmpty())
         {
@@ -423,13 +443,30 @@ shipBool SplitShaderSourceAndSamplerStateBlocks(StringA& shaderSource, Array<Sha
             ShaderCompiler::SamplerStateToBeCompiled& samplerStateToBeCompiled = samplerStatesToBeCompiled.Grow();
             samplerStateToBeCompiled.Name = samplerStateName;
             samplerStateToBeCompiled.SamplerStateSource = samplerStateBlockSource;
-            
+
+            if (newShaderSource.Capacity() == 0)
+            {
+                newShaderSource.Reserve(shaderSource.Size() + 1);
+            }
+
+            newShaderSource.Append(shaderSource.GetBuffer() + numCharsCopied, samplerStateBlockStartIndex - numCharsCopied);
+
             // So that shader reflection can pick up the sampler, add it back as a simple sampler declaration.
-            shaderSource.Insert(samplerStateIndex, StringFormat("SamplerState %s;\n", samplerStateName.GetBuffer()));
-            startIndex = samplerStateIndex + 1;
+            newShaderSource += "SamplerState ";
+            newShaderSource += samplerStateName;
+            newShaderSource += ";\n";
+
+            numCharsCopied = samplerStateBlockEndIndex + 1;
+            startIndex = shipUint32(numCharsCopied);
         }
     }
 
+    if (numCharsCopied > 0)
+    {
+        newShaderSource.Append(shaderSource.GetBuffer() + numCharsCopied, shaderSource.Size() - numCharsCopied);
+        shaderSource = std::move(newShaderSource);
+    }
+
     return true;
 }
 
@@ -503,9 +540,9 @@ shipBool ReadShaderFile(
             break;
         }
 
-        StringA shaderInputProviderName = shaderSource.Substring(shaderInputProviderDeclarationIdx, (endOfIncludeIdx - shaderInputProviderDeclarationIdx));
+        StringId shaderInputProviderNameId(shaderSource.GetBuffer() + shaderInputProviderDeclarationIdx, (endOfIncludeIdx - shaderInputProviderDeclarationIdx));
 
-        ShaderInputProviderDeclaration* shaderInputProvider = shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(shaderInputProviderName);
+        ShaderInputProviderDeclaration* shaderInputProvider = shaderInputProviderManager.FindShaderInputProviderDeclarationFromName(shaderInputProviderNameId);
         if (shaderInputProvider != nullptr)
         {
             includedShaderInputProviders.Add(shaderInputProvider);
@@ -522,12 +559,14 @@ shipBool ReadShaderFile(
 
 void ShaderCompiler::CompileShaderFamily(ShaderFamily shaderFamily)
 {
+    ScratchScope scratchScope;
+
     SmallInplaceStringT sourceFilename = m_ShaderDirectoryName;
     sourceFilename += g_ShaderFamilyFilenames[shipUint32(shaderFamily)];
 
-    StringA shaderSource;
+    StringA shaderSource(scratchScope.GetAllocator());
     LargeInplaceStringA renderStateBlockSource;
-    Array<SamplerStateToBeCompiled> samplerStatesToBeCompiled;
+    Array<SamplerStateToBeCompiled> samplerStatesToBeCompiled(scratchScope.GetAllocator());
     InplaceArray<ShaderInputProviderDeclaration*, 8> includedShaderInputProviders;
 
     shipBool couldReadShaderFile = ReadShaderFile(
@@ -541,7 +580,7 @@ void ShaderCompiler::CompileShaderFamily(ShaderFamily shaderFamily)
         return;
     }
 
-    Array<ShaderOption> everyPossibleShaderOption;
+    Array<ShaderOption> everyPossibleShaderOption(scratchScope.GetAllocator());
     ShaderKey::GetShaderKeyOptionsForShaderFamily(shaderFamily, everyPossibleShaderOption);
 
     shipUint32 numBitsInShaderKey = 0;
@@ -582,12 +621,16 @@ void ShaderCompiler::CompileShaderFamily(ShaderFamily shaderFamily)
 
 void ShaderCompiler::CompileShaderKey(const ShaderKey& shaderKeyToCompile)
 {
+    SHIP_PROFILE_SCOPE("ShaderCompiler::CompileShaderKey");
+
+    ScratchScope scratchScope;
+
     SmallInplaceStringT sourceFilename = m_ShaderDirectoryName;
     sourceFilename += g_ShaderFamilyFilenames[shipUint32(shaderKeyToCompile.GetShaderFamily())];
 
-    StringA shaderSource;
+    StringA shaderSource(scratchScope.GetAllocator());
     LargeInplaceStringA renderStateBlockSource;
-    Array<SamplerStateToBeCompiled> samplerStatesToBeCompiled;
+    Array<SamplerStateToBeCompiled> samplerStatesToBeCompiled(scratchScope.GetAllocator());
     InplaceArray<ShaderInputProviderDeclaration*, 8> includedShaderInputProviders;
 
     shipBool couldReadShaderFile = ReadShaderFile(
@@ -601,7 +644,7 @@ void ShaderCompiler::CompileShaderKey(const ShaderKey& shaderKeyToCompile)
         return;
     }
 
-    Array<ShaderOption> everyPossibleShaderOptionForShaderKey;
+    Array<ShaderOption> everyPossibleShaderOptionForShaderKey(scratchScope.GetAllocator());
     ShaderKey::GetShaderKeyOptionsForShaderFamily(shaderKeyToCompile.GetShaderFamily(), everyPossibleShaderOptionForShaderKey);
 
     CompileShaderKey(
@@ -623,12 +666,21 @@ void ShaderCompiler::CompileShaderKey(
         const Array<SamplerStateToBeCompiled>& samplerStatesToBeCompiled,
         const Array<ShaderInputProviderDeclaration*>& includedShaderInputProviders)
 {
+    SHIP_PROFILE_SCOPE("ShaderCompiler::CompileShaderKey Permutation");
+
     m_ShaderCompilationRequestLock.lock();
 
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    shipUint64 numGlobalAllocationsBeforeCompilation = GlobalAllocator::GetNumAllocationsForCurrentThread();
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    // Everything allocated from this scope is only needed for this permutation, and is freed at once when it ends.
+    ScratchScope scratchScope;
+
     CompiledShaderKeyEntry& compiledShaderKeyEntry = GetCompiledShaderKeyEntry(shaderKeyToCompile.GetRawShaderKey());
     compiledShaderKeyEntry.Reset();
 
-    Array<D3D_SHADER_MACRO> shaderOptionDefines;
+    Array<D3D_SHADER_MACRO> shaderOptionDefines(scratchScope.GetAllocator());
     shaderOptionDefines.Reserve(everyPossibleShaderOptionForShaderKey.Size() + 1);
 
     for (ShaderOption shaderOption : everyPossibleShaderOptionForShaderKey)
@@ -638,7 +690,7 @@ void ShaderCompiler::CompileShaderKey(
         D3D_SHADER_MACRO shaderDefine;
         shaderDefine.Name = g_ShaderOptionString[shipUint32(shaderOption)];
 
-        shipChar* buf = reinterpret_cast<shipChar*>(SHIP_ALLOC(8, 1));
+        shipChar* buf = reinterpret_cast<shipChar*>(SHIP_ALLOC_EX(scratchScope.GetAllocator(), 8, 1));
         sprintf_s(buf, 8, "%u", valueForShaderOption);
 
         shaderDefine.Definition = buf;
@@ -653,11 +705,6 @@ void ShaderCompiler::CompileShaderKey(
     ID3D10Blob* pixelShaderBlob = CompilePixelShaderForShaderKey(shaderKeyToCompile, sourceFilename, shaderSource, &shaderOptionDefines[0]);
     ID3D10Blob* computeShaderBlob = CompileComputeShaderForShaderKey(shaderKeyToCompile, sourceFilename, shaderSource, &shaderOptionDefines[0]);
 
-    for (D3D_SHADER_MACRO& shaderMacro : shaderOptionDefines)
-    {
-        SHIP_FREE(shaderMacro.Definition);
-    }
-
     compiledShaderKeyEntry.m_GotCompilationError = ((vertexShaderBlob != nullptr && pixelShaderBlob == nullptr) || (pixelShaderBlob != nullptr && vertexShaderBlob == nullptr) || (vertexShaderBlob == nullptr && pixelShaderBlob == nullptr && computeShaderBlob == nullptr));
 
     if (!compiledShaderKeyEntry.m_GotCompilationError)
@@ -711,7 +758,7 @@ void ShaderCompiler::CompileShaderKey(
 
         compiledShaderKeyEntry.m_RootSignatureParameters = rootSignatureParameters;
 
-        Array<CompiledSamplerState> compiledSamplerStates;
+        Array<CompiledSamplerState> compiledSamplerStates(scratchScope.GetAllocator());
         if (samplerStatesToBeCompiled.Size() > 0)
         {
             compiledSamplerStates.Reserve(samplerStatesToBeCompiled.Size());
@@ -731,6 +778,7 @@ void ShaderCompiler::CompileShaderKey(
 
                     CompiledSamplerState& compiledSamplerState = compiledSamplerStates.Grow();
                     compiledSamplerState.Name = samplerStateToBeCompiled.Name;
+                    compiledSamplerState.NameId = StringId(samplerStateToBeCompiled.Name);
                     compiledSamplerState.State = samplerState;
                 }
             }
@@ -783,6 +831,13 @@ void ShaderCompiler::CompileShaderKey(
         compiledShaderKeyEntry.m_CompiledRenderStateBlock = renderStateBlock;
     }
 
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    SHIP_LOG_DEBUG(
+            "ShaderCompiler::CompileShaderKey --> %llu GlobalAllocator allocations to compile shader key 0x%x.",
+            GlobalAllocator::GetNumAllocationsForCurrentThread() - numGlobalAllocationsBeforeCompilation,
+            shaderKeyToCompile.GetRawShaderKey());
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
     m_ShaderCompilationRequestLock.unlock();
 }
 
@@ -848,7 +903,7 @@ ID3D10Blob* ShaderCompiler::CompileShader(ShaderKey shaderKey, const StringT& sh
         if (preprocessError != nullptr && (logShaderKeyPreprocessError.find(shaderKey.GetRawShaderKey()) == logShaderKeyPreprocessError.end()))
         {
             shipChar* errorMsg = (shipChar*)preprocessError->GetBufferPointer();
-            SHIP_LOG_ERROR(errorMsg);
+            SHIP_LOG_ERROR("%s", errorMsg);
 
             logShaderKeyPreprocessError.insert(shaderKey.GetRawShaderKey());
         }
@@ -864,12 +919,12 @@ ID3D10Blob* ShaderCompiler::CompileShader(ShaderKey shaderKey, const StringT& sh
         if (error != nullptr && (logShaderKeyCompilationError.find(shaderKey.GetRawShaderKey()) == logShaderKeyCompilationError.end()))
         {
             shipChar* errorMsg = (shipChar*)error->GetBufferPointer();
-            SHIP_LOG_ERROR(errorMsg);
+            SHIP_LOG_ERROR("%s", errorMsg);
 
             if (preprocessedBlob != nullptr)
             {
                 shipChar* data = (shipChar*)preprocessedBlob->GetBufferPointer();
-                SHIP_LOG_ERROR(data);
+                SHIP_LOG_ERROR("%s", data);
             }
 
             logShaderKeyCompilationError.insert(shaderKey.GetRawShaderKey());
@@ -952,10 +1007,12 @@ void ShaderCompiler::GetReflectionDataForShader(
         {
             Array<ShaderInputReflectionData>& shaderInputReflectionDatas = *pShaderInputReflectionDatas;
 
+            StringId resourceNameId(resourceDesc.Name);
+
             shipUint32 idx = 0;
             for (; idx < shaderInputReflectionDatas.Size(); idx++)
             {
-                if (shaderInputReflectionDatas[idx].Name == resourceDesc.Name)
+                if (shaderInputReflectionDatas[idx].NameId == resourceNameId)
                 {
                     SHIP_ASSERT(shaderInputReflectionDatas[idx].BindPoint == resourceDesc.BindPoint);
 
@@ -968,6 +1025,7 @@ void ShaderCompiler::GetReflectionDataForShader(
             {
                 ShaderInputReflectionData& newEntry = shaderInputReflectionDatas.Grow();
                 newEntry.Name = resourceDesc.Name;
+                newEntry.NameId = resourceNameId;
                 newEntry.BindPoint = shipUint16(resourceDesc.BindPoint);
                 newEntry.shaderVisibility = shaderVisibility;
             }
@@ -1132,7 +1190,7 @@ void ShaderCompiler::CreateShaderResourceBinder(
             shipUint32 samplerStateIndex = 0;
             for (; samplerStateIndex < compiledSamplerStates.Size(); samplerStateIndex++)
             {
-                if (compiledSamplerStates[samplerStateIndex].Name == shaderInputReflectionData.Name)
+                if (compiledSamplerStates[samplerStateIndex].NameId == shaderInputReflectionData.NameId)
                 {
                     break;
                 }
@@ -1213,7 +1271,7 @@ void ShaderCompiler::CreateShaderResourceBinderForDescriptorRangeType(
             {
                 shipInt32 dataOffsetInProvider;
                 ShaderInputProviderDeclaration::ShaderInputDeclaration const * const shaderInputDeclaration = shaderInputProviderDeclaration->GetShaderInput(
-                        shaderInputReflectionData.Name.GetBuffer(),
+                        shaderInputReflectionData.NameId,
                         dataOffsetInProvider);
 
                 if (shaderInputDeclaration != nullptr)
@@ -1279,23 +1337,20 @@ shipUint16 ShaderCompiler::GetDescriptorRangeEntryIndex(
 
 ShaderCompiler::CompiledShaderKeyEntry& ShaderCompiler::GetCompiledShaderKeyEntry(ShaderKey::RawShaderKeyType rawShaderKey)
 {
-    shipUint32 idx = 0;
-    for (; idx < m_CompiledShaderKeyEntries.Size(); idx++)
+    const shipUint32* pIdx = m_CompiledShaderKeyEntryIndices.Find(rawShaderKey);
+    if (pIdx != nullptr)
     {
-        if (m_CompiledShaderKeyEntries[idx].m_RawShaderKey == rawShaderKey)
-        {
-            break;
-        }
+        return m_CompiledShaderKeyEntries[*pIdx];
     }
 
-    if (idx == m_CompiledShaderKeyEntries.Size())
-    {
-        CompiledShaderKeyEntry newCompiledShaderKeyEntry;
-        newCompiledShaderKeyEntry.m_RawShaderKey = rawShaderKey;
-        newCompiledShaderKeyEntry.m_GotCompilationError = true;
+    shipUint32 idx = m_CompiledShaderKeyEntries.Size();
+    m_CompiledShaderKeyEntryIndices.Insert(rawShaderKey, idx);
 
-        m_CompiledShaderKeyEntries.Add(newCompiledShaderKeyEntry);
-    }
+    CompiledShaderKeyEntry newCompiledShaderKeyEntry;
+    newCompiledShaderKeyEntry.m_RawShaderKey = rawShaderKey;
+    newCompiledShaderKeyEntry.m_GotCompilationError = true;
+
+    m_CompiledShaderKeyEntries.Add(newCompiledShaderKeyEntry);
 
     return m_CompiledShaderKeyEntries[idx];
 }
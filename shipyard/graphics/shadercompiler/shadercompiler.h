@@ -7,8 +7,10 @@
 #include <graphics/graphicssingleton.h>
 
 #include <system/array.h>
+#include <system/hashmap.h>
 #include <system/platform.h>
 #include <system/string.h>
+#include <system/stringid.h>
 
 #include <mutex>
 #include <thread>
@@ -78,6 +80,7 @@ namespace Shipyard
         struct ShaderInputReflectionData
         {
             SmallInplaceStringA Name;
+            StringId NameId;
             shipUint16 BindPoint;
             ShaderVisibility shaderVisibility;
         };
@@ -98,6 +101,7 @@ namespace Shipyard
         struct CompiledSamplerState
         {
             StringA Name;
+            StringId NameId;
             SamplerState State;
         };
 
@@ -169,5 +173,6 @@ namespace Shipyard
         ShaderKey m_CurrentShaderKeyBeingCompiled;
 
         Array<CompiledShaderKeyEntry> m_CompiledShaderKeyEntries;
+        HashMap<ShaderKey::RawShaderKeyType, shipUint32> m_CompiledShaderKeyEntryIndices;
     };
 }
\ No newline at end of file
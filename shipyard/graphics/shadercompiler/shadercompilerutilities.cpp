@@ -99,7 +99,7 @@ void GetEffectiveSourceForShaderKey(
     }
 }
 
-shipBool InterpretBooleanValue(const StringA& value, shipBool* outValue)
+shipBool InterpretBooleanValue(const StringView& value, shipBool* outValue)
 {
     if (value.EqualCaseInsensitive("true"))
     {
@@ -117,7 +117,7 @@ shipBool InterpretBooleanValue(const StringA& value, shipBool* outValue)
     return true;
 }
 
-shipBool InterpretFloatValue(const StringA& value, shipFloat* outValue)
+shipBool InterpretFloatValue(const StringView& value, shipFloat* outValue)
 {
     for (size_t i = 0; i < value.Size(); i++)
     {
@@ -130,13 +130,17 @@ shipBool InterpretFloatValue(const StringA& value, shipFloat* outValue)
         }
     }
 
-    *outValue = shipFloat(atof(value.GetBuffer()));
+    // atof needs a null-terminated string.
+    TinyInplaceStringA floatString;
+    floatString.Assign(value);
+
+    *outValue = shipFloat(atof(floatString.GetBuffer()));
 
     return true;
 }
 
 
-shipBool InterpretComparisonFunc(const StringA& value, ComparisonFunc* outValue)
+shipBool InterpretComparisonFunc(const StringView& value, ComparisonFunc* outValue)
 {
     if (value.EqualCaseInsensitive("Never"))
     {
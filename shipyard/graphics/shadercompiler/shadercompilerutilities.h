@@ -19,31 +19,33 @@ namespace Shipyard
     // Assumes that the state block is composed of statements of type:
     // option = value;
     //
+    // Options and values are views on the state block source, trimmed of their whitespaces.
+    //
     // Will call user callback when the parser accumulated one option with one value. The callback must return false if an error occured during the parsing
     // of the current option & value pair, true if everything was parsed properly.
     //
     // Returns an error code.
     template <typename ErrorType, typename StateBlockType>
     using InterpretStateBlockOptionPtr = shipBool (*) (
-            const StringA& stateOption,
-            const StringA& stateValue,
+            const StringView& stateOption,
+            const StringView& stateValue,
             StateBlockType& stateBlock,
             ErrorType& compilationError);
 
     template <typename ErrorType, typename StateBlockType>
     void CompileStateBlock(
-            const StringA& stateBlockSource,
+            const StringView& stateBlockSource,
             StateBlockType& compiledStateBlock,
             ErrorType& stateBlockCompilationError,
             InterpretStateBlockOptionPtr<ErrorType, StateBlockType> userCallback);
 
-    shipBool InterpretBooleanValue(const StringA& value, shipBool* outValue);
+    shipBool InterpretBooleanValue(const StringView& value, shipBool* outValue);
 
     template <typename IntegerType>
-    shipBool InterpretIntegerValue(const StringA& value, IntegerType* outValue);
+    shipBool InterpretIntegerValue(const StringView& value, IntegerType* outValue);
 
-    shipBool InterpretFloatValue(const StringA& value, shipFloat* outValue);
-    shipBool InterpretComparisonFunc(const StringA& value, ComparisonFunc* outValue);
+    shipBool InterpretFloatValue(const StringView& value, shipFloat* outValue);
+    shipBool InterpretComparisonFunc(const StringView& value, ComparisonFunc* outValue);
 }
 
 #include <graphics/shadercompiler/shadercompilerutilities.inl>
\ No newline at end of file
@@ -4,65 +4,52 @@ namespace Shipyard
 {
     template <typename ErrorType, typename StateBlockType>
     void CompileStateBlock(
-            const StringA& stateBlockSource,
+            const StringView& stateBlockSource,
             StateBlockType& compiledStateBlock,
             ErrorType& stateBlockCompilationError,
             InterpretStateBlockOptionPtr<ErrorType, StateBlockType> userCallback)
     {
-        StringA stateOption;
-        StringA stateValue;
-        stateOption.Reserve(256);
-        stateValue.Reserve(256);
+        size_t statementStartIndex = 0;
+        size_t statementEndIndex = stateBlockSource.FindIndexOfFirst(';', statementStartIndex);
 
-        shipBool processOption = true;
-
-        for (size_t i = 0; i < stateBlockSource.Size(); i++)
+        while (statementEndIndex != StringView::InvalidIndex)
         {
-            shipChar c = stateBlockSource[i];
+            StringView statement = stateBlockSource.Substring(statementStartIndex, statementEndIndex - statementStartIndex);
 
-            if (c == ';')
-            {
-                shipBool couldCompileOption = userCallback(
-                        stateOption,
-                        stateValue,
-                        compiledStateBlock,
-                        stateBlockCompilationError);
-
-                if (!couldCompileOption)
-                {
-                    return;
-                }
-
-                stateOption.Resize(0);
-                stateValue.Resize(0);
-                processOption = true;
-            }
-            else if (c == '=')
+            StringView stateOption = statement;
+            StringView stateValue;
+
+            size_t equalIndex = statement.FindIndexOfFirst('=', 0);
+            if (equalIndex != StringView::InvalidIndex)
             {
-                processOption = false;
+                stateOption = statement.Substring(0, equalIndex);
+                stateValue = statement.Substring(equalIndex + 1, StringView::InvalidIndex);
             }
-            else
+
+            shipBool couldCompileOption = userCallback(
+                    stateOption.Trim(),
+                    stateValue.Trim(),
+                    compiledStateBlock,
+                    stateBlockCompilationError);
+
+            if (!couldCompileOption)
             {
-                if (!isalnum(c) && c != '-' && c != '.' && c != '[' && c != ']')
-                {
-                    continue;
-                }
-
-                if (processOption)
-                {
-                    stateOption += c;
-                }
-                else
-                {
-                    stateValue += c;
-                }
+                return;
             }
+
+            statementStartIndex = statementEndIndex + 1;
+            statementEndIndex = stateBlockSource.FindIndexOfFirst(';', statementStartIndex);
         }
     }
 
     template <typename IntegerType>
-    shipBool InterpretIntegerValue(const StringA& value, IntegerType* outValue)
+    shipBool InterpretIntegerValue(const StringView& value, IntegerType* outValue)
     {
+        if (value.IsEmpty())
+        {
+            return false;
+        }
+
         size_t startingIndex = 0;
         shipBool isNegative = false;
         if (value[0] == '-')
@@ -71,68 +58,55 @@ namespace Shipyard
             isNegative = true;
         }
 
-        if (value.Substring(startingIndex, 2 + startingIndex).EqualCaseInsensitive("0x"))
-        {
-            StringA hexadecimalValue = value.Substring(2 + startingIndex, value.InvalidIndex);
+        StringView digits = value.Substring(startingIndex, value.InvalidIndex);
 
-            for (size_t i = 0; i < hexadecimalValue.Size(); i++)
-            {
-                int c = int(hexadecimalValue[i]);
+        int base = 10;
+        if (digits.Substring(0, 2).EqualCaseInsensitive("0x"))
+        {
+            base = 16;
+            digits = digits.Substring(2, digits.InvalidIndex);
+        }
+        else if (digits.Substring(0, 2).EqualCaseInsensitive("0b"))
+        {
+            base = 2;
+            digits = digits.Substring(2, digits.InvalidIndex);
+        }
 
-                shipBool isCharacterInvalidHexadecimal = ((c < int('0') || c > int('9')) && (c < int('a') || c > int('f')) && (c < int('A') || c > int('F')));
-                if (isCharacterInvalidHexadecimal)
-                {
-                    return false;
-                }
-            }
+        // The value is accumulated directly from the view, which isn't null-terminated for strtoull.
+        unsigned long long interpretedValue = 0;
 
-            unsigned long long interpretedValue = strtoull(hexadecimalValue.GetBuffer(), nullptr, 16);
-            *outValue = IntegerType(interpretedValue);
+        for (size_t i = 0; i < digits.Size(); i++)
+        {
+            int c = int(digits[i]);
 
-            if (isNegative)
+            int digit = base;
+            if (c >= int('0') && c <= int('9'))
             {
-                *outValue = static_cast<IntegerType>(-std::make_signed<IntegerType>::type(*outValue));
+                digit = c - int('0');
             }
-        }
-        else if (value.Substring(startingIndex, 2 + startingIndex).EqualCaseInsensitive("0b"))
-        {
-            StringA binaryValue = value.Substring(2 + startingIndex, value.InvalidIndex);
-
-            for (size_t i = 0; i < binaryValue.Size(); i++)
+            else if (c >= int('a') && c <= int('f'))
             {
-                shipChar c = binaryValue[i];
-
-                shipBool isCharacterInvalidBinary = (c != '0' && c != '1');
-                if (isCharacterInvalidBinary)
-                {
-                    return false;
-                }
+                digit = c - int('a') + 10;
+            }
+            else if (c >= int('A') && c <= int('F'))
+            {
+                digit = c - int('A') + 10;
             }
 
-            unsigned long long interpretedValue = strtoull(binaryValue.GetBuffer(), nullptr, 2);
-            *outValue = IntegerType(interpretedValue);
-
-            if (isNegative)
+            shipBool isCharacterInvalidForBase = (digit >= base);
+            if (isCharacterInvalidForBase)
             {
-                *outValue = static_cast<IntegerType>(-std::make_signed<IntegerType>::type(*outValue));
+                return false;
             }
+
+            interpretedValue = interpretedValue * base + digit;
         }
-        else
-        {
-            for (size_t i = startingIndex; i < value.Size(); i++)
-            {
-                int c = int(value[i]);
 
-                shipBool isCharacterInvalidDecimal = (c < int('0') || c > int('9'));
-                if (isCharacterInvalidDecimal)
-                {
-                    return false;
-                }
-            }
+        *outValue = IntegerType(interpretedValue);
 
-            // Negative values are properly handled here since we hand over the whole string.
-            unsigned long long interpretedValue = strtoull(value.GetBuffer(), nullptr, 10);
-            *outValue = IntegerType(interpretedValue);
+        if (isNegative)
+        {
+            *outValue = static_cast<IntegerType>(-std::make_signed<IntegerType>::type(*outValue));
         }
 
         return true;
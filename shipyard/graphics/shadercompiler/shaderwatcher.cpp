@@ -9,6 +9,8 @@
 #include <system/pathutils.h>
 #include <system/systemcommon.h>
 
+#include <system/memory/scratchallocator.h>
+
 #include <algorithm>
 
 #include <windows.h>
@@ -50,7 +52,7 @@ shipUint64 ShaderWatcher::GetTimestampForShaderKey(const ShaderKey& shaderKey) c
     ShaderFamily shaderFamily = shaderKey.GetShaderFamily();
     const TinyInplaceStringA& shaderFamilyShaderFile = g_ShaderFamilyFilenames[shipUint8(shaderFamily)];
 
-    size_t shaderFileSize = shaderFamilyShaderFile.Size();
+    StringId shaderFamilyShaderFileId = StringId::CreateCaseInsensitive(shaderFamilyShaderFile);
 
     shipUint64 lastModifiedTimestamp = 0;
 
@@ -58,13 +60,7 @@ shipUint64 ShaderWatcher::GetTimestampForShaderKey(const ShaderKey& shaderKey) c
 
     for (const ShaderFile& watchedShaderFile : m_WatchedShaderFiles)
     {
-        size_t watchedShaderFileSize = watchedShaderFile.m_Filename.Size();
-        if (watchedShaderFileSize < shaderFileSize)
-        {
-            continue;
-        }
-
-        if (shaderFamilyShaderFile.CompareCaseInsensitive(watchedShaderFile.m_Filename) == 0)
+        if (watchedShaderFile.m_FilenameId == shaderFamilyShaderFileId)
         {
             lastModifiedTimestamp = watchedShaderFile.m_LastWriteTimestamp;
             break;
@@ -267,10 +263,12 @@ void UpdateFileIfModified(
 
     for (const StringA& shaderFileToUpdate : shaderFilesToUpdate)
     {
+        StringId shaderFileToUpdateId = StringId::CreateCaseInsensitive(shaderFileToUpdate);
+
         shipUint32 idx = 0;
         for (; idx < watchedShaderFiles.Size(); idx++)
         {
-            if (watchedShaderFiles[idx].m_Filename.EqualCaseInsensitive(shaderFileToUpdate))
+            if (watchedShaderFiles[idx].m_FilenameId == shaderFileToUpdateId)
             {
                 break;
             }
@@ -280,6 +278,7 @@ void UpdateFileIfModified(
         {
             ShaderWatcher::ShaderFile& newWatchedShaderFile = watchedShaderFiles.Grow();
             newWatchedShaderFile.m_Filename = shaderFileToUpdate;
+            newWatchedShaderFile.m_FilenameId = shaderFileToUpdateId;
             newWatchedShaderFile.m_LastWriteTimestamp = lastWriteTimestamp;
         }
         else if (lastWriteTimestamp > watchedShaderFiles[idx].m_LastWriteTimestamp)
@@ -293,7 +292,7 @@ void UpdateFileIfModified(
 
 void GetModifiedFilesInDirectory(
         const SmallInplaceStringT& shaderDirectory,
-        const SmallInplaceStringT& directoryName,
+        const StringT& directoryName,
         Array<ShaderWatcher::ShaderFile>& watchedShaderFiles,
         StringT& fileToCheckContent,
         std::mutex& shaderWatcherLock,
@@ -302,7 +301,12 @@ void GetModifiedFilesInDirectory(
     WIN32_FIND_DATAA findData;
     HANDLE findHandle = INVALID_HANDLE_VALUE;
 
-    TinyInplaceStringA fileRegex = shaderDirectory + directoryName;
+    // The paths built while going through the directory are only needed until we're done with it.
+    ScratchScope scratchScope;
+
+    StringT fileRegex(scratchScope.GetAllocator());
+    fileRegex += shaderDirectory;
+    fileRegex += directoryName;
     fileRegex += '*';
 
     findHandle = FindFirstFileA(fileRegex.GetBuffer(), &findData);
@@ -326,7 +330,12 @@ void GetModifiedFilesInDirectory(
 
         if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) > 0 && recursiveSearch)
         {
-            GetModifiedFilesInDirectory(shaderDirectory, directoryName + findData.cFileName + "\\", watchedShaderFiles, fileToCheckContent, shaderWatcherLock, recursiveSearch);
+            StringT subDirectoryName(scratchScope.GetAllocator());
+            subDirectoryName += directoryName;
+            subDirectoryName += findData.cFileName;
+            subDirectoryName += '\\';
+
+            GetModifiedFilesInDirectory(shaderDirectory, subDirectoryName, watchedShaderFiles, fileToCheckContent, shaderWatcherLock, recursiveSearch);
             continue;
         }
 
@@ -346,8 +355,12 @@ void ShaderWatcher::ShaderWatcherThreadFunction()
     {
         Sleep(100);
 
+        ScratchScope scratchScope;
+
+        StringT rootDirectoryName(scratchScope.GetAllocator());
+
         constexpr shipBool recursiveSearch = true;
-        GetModifiedFilesInDirectory(m_ShaderDirectoryName, "", m_WatchedShaderFiles, m_FileToCheckContent, m_ShaderWatcherLock, recursiveSearch);
+        GetModifiedFilesInDirectory(m_ShaderDirectoryName, rootDirectoryName, m_WatchedShaderFiles, m_FileToCheckContent, m_ShaderWatcherLock, recursiveSearch);
     }
 }
 
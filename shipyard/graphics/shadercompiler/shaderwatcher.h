@@ -3,6 +3,7 @@
 #include <system/array.h>
 #include <system/platform.h>
 #include <system/string.h>
+#include <system/stringid.h>
 #include <graphics/shader/shaderkey.h>
 
 #include <graphics/graphicssingleton.h>
@@ -35,6 +36,9 @@ namespace Shipyard
             {}
 
             StringA m_Filename;
+
+            // Case insensitive, like the file system.
+            StringId m_FilenameId;
             shipUint64 m_LastWriteTimestamp;
         };
 
@@ -9,6 +9,7 @@
 #include <graphics/wrapper/dx11/dx11renderdevice.h>
 
 #include <system/logger.h>
+#include <system/profiler.h>
 
 namespace Shipyard
 {;
@@ -73,6 +74,8 @@ void DX11CommandQueue::Destroy()
 
 void DX11CommandQueue::ExecuteCommandLists(GFXRenderCommandList** ppRenderCommandLists, shipUint32 numRenderCommandLists)
 {
+    SHIP_PROFILE_SCOPE("DX11CommandQueue::ExecuteCommandLists");
+
     for (shipUint32 i = 0; i < numRenderCommandLists; i++)
     {
         GFXRenderCommandList* pRenderCommandList = ppRenderCommandLists[i];
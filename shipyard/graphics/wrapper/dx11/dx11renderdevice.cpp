@@ -32,19 +32,29 @@ ID3D11InputLayout* g_RegisteredInputLayouts[shipUint32(VertexFormatType::VertexF
 
 ID3D11InputLayout* RegisterVertexFormatType(ID3D11Device* device, VertexFormatType vertexFormatType);
 
-DX11RenderDevice::DX11RenderDevice()
-    : m_Device(nullptr)
-    , m_ImmediateDeviceContext(nullptr)
+// Ref counts are indexed by handle, and grow with the pool they track.
+shipUint32& GetHandleRefCount(Array<shipUint32>& handleRefCounts, shipUint32 handle)
 {
-    for (shipUint32 i = 0; i < SHIP_MAX_SAMPLERS; i++)
-    {
-        m_SamplerHandleRefCounts[i] = 0;
-    }
+    SHIP_ASSERT(handle != InvalidGfxHandle);
 
-    for (shipUint32 i = 0; i < SHIP_MAX_GRAPHICS_PIPELINE_STATE_OBJECTS; i++)
+    shipUint32 numRefCounts = handleRefCounts.Size();
+    if (handle >= numRefCounts)
     {
-        m_GraphicsPipelineStateObjectHandleRefCounts[i] = 0;
+        handleRefCounts.Resize(handle + 1);
+
+        for (shipUint32 i = numRefCounts; i <= handle; i++)
+        {
+            handleRefCounts[i] = 0;
+        }
     }
+
+    return handleRefCounts[handle];
+}
+
+DX11RenderDevice::DX11RenderDevice()
+    : m_Device(nullptr)
+    , m_ImmediateDeviceContext(nullptr)
+{
 }
 
 DX11RenderDevice::~DX11RenderDevice()
@@ -338,6 +348,8 @@ void DX11RenderDevice::Destroy()
         } while (m_GraphicsPipelineStateObjectPool.GetNextAllocatedIndex(indexToFree, &indexToFree, &generation));
     }
 
+    m_GraphicsPipelineStateObjectHandles.Clear();
+
     if (m_ComputePipelineStateObjectPool.GetFirstAllocatedIndex(&indexToFree, &generation))
     {
         do
@@ -367,6 +379,43 @@ void DX11RenderDevice::Destroy()
     }
 }
 
+template <typename PoolType>
+void LogPoolStatistics(const shipChar* pPoolName, const PoolType& pool)
+{
+    DataPoolStatistics statistics = pool.GetStatistics();
+
+    SHIP_LOG_INFO(
+            "%s: %u items allocated, capacity of %u items, %u/%u pages resident, %llu bytes resident.",
+            pPoolName,
+            statistics.numAllocatedItems,
+            statistics.capacity,
+            statistics.numResidentPages,
+            statistics.numPages,
+            shipUint64(statistics.residentMemorySize));
+}
+
+void DX11RenderDevice::LogPoolStatistics() const
+{
+    Shipyard::LogPoolStatistics("VertexBufferPool", m_VertexBufferPool);
+    Shipyard::LogPoolStatistics("IndexBufferPool", m_IndexBufferPool);
+    Shipyard::LogPoolStatistics("ConstantBufferPool", m_ConstantBufferPool);
+    Shipyard::LogPoolStatistics("ByteBufferPool", m_ByteBufferPool);
+    Shipyard::LogPoolStatistics("Texture2dPool", m_Texture2dPool);
+    Shipyard::LogPoolStatistics("Texture2dArrayPool", m_Texture2dArrayPool);
+    Shipyard::LogPoolStatistics("Texture3dPool", m_Texture3dPool);
+    Shipyard::LogPoolStatistics("TextureCubePool", m_TextureCubePool);
+    Shipyard::LogPoolStatistics("SamplerPool", m_SamplerPool);
+    Shipyard::LogPoolStatistics("RenderTargetPool", m_RenderTargetPool);
+    Shipyard::LogPoolStatistics("DepthStencilRenderTargetPool", m_DepthStencilRenderTargetPool);
+    Shipyard::LogPoolStatistics("VertexShaderPool", m_VertexShaderPool);
+    Shipyard::LogPoolStatistics("PixelShaderPool", m_PixelShaderPool);
+    Shipyard::LogPoolStatistics("ComputeShaderPool", m_ComputeShaderPool);
+    Shipyard::LogPoolStatistics("RootSignaturePool", m_RootSignaturePool);
+    Shipyard::LogPoolStatistics("GraphicsPipelineStateObjectPool", m_GraphicsPipelineStateObjectPool);
+    Shipyard::LogPoolStatistics("ComputePipelineStateObjectPool", m_ComputePipelineStateObjectPool);
+    Shipyard::LogPoolStatistics("DescriptorSetPool", m_DescriptorSetPool);
+}
+
 GFXVertexBufferHandle DX11RenderDevice::CreateVertexBuffer(shipUint32 numVertices, VertexFormatType vertexFormatType, shipBool dynamic, void* initialData)
 {
     GFXVertexBufferHandle gfxVertexBufferHandle;
@@ -740,7 +789,10 @@ const GFXTextureCube* DX11RenderDevice::GetTextureCubePtr(GFXTextureCubeHandle g
     return m_TextureCubePool.GetItemPtr(gfxTextureCubeHandle.handle, gfxTextureCubeHandle.generation);
 }
 
-shipUint32 GetSamplerIndexFromSamplerState(const GenerationalDataPool<GFXSampler, SHIP_MAX_SAMPLERS>& samplerPool, const SamplerState& samplerState)
+shipUint32 GetSamplerIndexFromSamplerState(
+        const PagedGenerationalDataPool<GFXSampler>& samplerPool,
+        const SamplerState& samplerState,
+        shipUint16* samplerGeneration)
 {
     shipUint32 allocatedSamplerIndex = 0;
     shipUint16 allocatedSamplerGeneration = 0;
@@ -750,6 +802,7 @@ shipUint32 GetSamplerIndexFromSamplerState(const GenerationalDataPool<GFXSampler
         {
             if (samplerPool.GetItem(allocatedSamplerIndex, allocatedSamplerGeneration).GetSamplerState() == samplerState)
             {
+                *samplerGeneration = allocatedSamplerGeneration;
                 return allocatedSamplerIndex;
             }
         } while (samplerPool.GetNextAllocatedIndex(allocatedSamplerIndex, &allocatedSamplerIndex, &allocatedSamplerGeneration));
@@ -760,15 +813,20 @@ shipUint32 GetSamplerIndexFromSamplerState(const GenerationalDataPool<GFXSampler
 
 GFXSamplerHandle DX11RenderDevice::CreateSampler(const SamplerState& samplerState)
 {
-    shipUint32 samplerIndex = GetSamplerIndexFromSamplerState(m_SamplerPool, samplerState);
-    if (samplerIndex != InvalidGfxHandle)
+    std::lock_guard<std::mutex> lock(m_SamplerLock);
+
+    GFXSamplerHandle gfxSamplerHandle;
+
+    // The existing sampler is returned with its current generation, so that handles to shared samplers pass the stale handle
+    // checks.
+    gfxSamplerHandle.handle = GetSamplerIndexFromSamplerState(m_SamplerPool, samplerState, &gfxSamplerHandle.generation);
+    if (gfxSamplerHandle.handle != InvalidGfxHandle)
     {
-        m_SamplerHandleRefCounts[samplerIndex] += 1;
+        GetHandleRefCount(m_SamplerHandleRefCounts, gfxSamplerHandle.handle) += 1;
 
-        return GFXSamplerHandle(samplerIndex);
+        return gfxSamplerHandle;
     }
 
-    GFXSamplerHandle gfxSamplerHandle;
     gfxSamplerHandle.handle = m_SamplerPool.GetNewItemIndex(&gfxSamplerHandle.generation);
 
     GFXSampler& gfxSampler = m_SamplerPool.GetItem(gfxSamplerHandle.handle, gfxSamplerHandle.generation);
@@ -776,17 +834,19 @@ GFXSamplerHandle DX11RenderDevice::CreateSampler(const SamplerState& samplerStat
 
     SHIP_ASSERT(isValid);
 
-    m_SamplerHandleRefCounts[gfxSamplerHandle.handle] += 1;
+    GetHandleRefCount(m_SamplerHandleRefCounts, gfxSamplerHandle.handle) += 1;
 
     return gfxSamplerHandle;
 }
 
 void DX11RenderDevice::DestroySampler(GFXSamplerHandle& gfxSamplerHandle)
 {
-    SHIP_ASSERT(m_SamplerHandleRefCounts[gfxSamplerHandle.handle] > 0);
-    m_SamplerHandleRefCounts[gfxSamplerHandle.handle] -= 1;
+    std::lock_guard<std::mutex> lock(m_SamplerLock);
 
-    if (m_SamplerHandleRefCounts[gfxSamplerHandle.handle] == 0)
+    SHIP_ASSERT(GetHandleRefCount(m_SamplerHandleRefCounts, gfxSamplerHandle.handle) > 0);
+    GetHandleRefCount(m_SamplerHandleRefCounts, gfxSamplerHandle.handle) -= 1;
+
+    if (GetHandleRefCount(m_SamplerHandleRefCounts, gfxSamplerHandle.handle) == 0)
     {
         GFXSampler& gfxSampler = m_SamplerPool.GetItem(gfxSamplerHandle.handle, gfxSamplerHandle.generation);
         gfxSampler.Destroy();
@@ -1044,34 +1104,31 @@ const GFXRootSignature* DX11RenderDevice::GetRootSignaturePtr(GFXRootSignatureHa
     return m_RootSignaturePool.GetItemPtr(gfxRootSignatureHandle.handle, gfxRootSignatureHandle.generation);
 }
 
-shipUint32 GetGraphicsPipelineStateObjectIndex(
-        const GenerationalDataPool<GFXGraphicsPipelineStateObject, SHIP_MAX_GRAPHICS_PIPELINE_STATE_OBJECTS>& pipelineStateObjectPool,
-        const GraphicsPipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters)
+shipUint64 DX11RenderDevice::GraphicsPipelineStateObjectCreationParametersHasher::operator() (const GraphicsPipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters) const
 {
-    shipUint32 allocatedPipelineStateObjectIndex = 0;
-    shipUint16 allocatedPipelineStateObjectGeneration = 0;
-    if (pipelineStateObjectPool.GetFirstAllocatedIndex(&allocatedPipelineStateObjectIndex, &allocatedPipelineStateObjectGeneration))
+    shipUint64 hash = HashUint64(pipelineStateObjectCreationParameters.GfxRootSignatureHandle.handle);
+    hash = HashCombine(hash, pipelineStateObjectCreationParameters.GfxVertexShaderHandle.handle);
+    hash = HashCombine(hash, pipelineStateObjectCreationParameters.GfxPixelShaderHandle.handle);
+    hash = HashCombine(hash, shipUint64(pipelineStateObjectCreationParameters.VertexFormatTypeToUse));
+    hash = HashCombine(hash, shipUint64(pipelineStateObjectCreationParameters.PrimitiveTopologyToUse));
+    hash = HashCombine(hash, shipUint64(pipelineStateObjectCreationParameters.DepthStencilFormat));
+
+    for (shipUint32 i = 0; i < pipelineStateObjectCreationParameters.NumRenderTargets; i++)
     {
-        do
-        {
-            if (pipelineStateObjectPool.GetItem(allocatedPipelineStateObjectIndex, allocatedPipelineStateObjectGeneration).GetCreationParameters() == pipelineStateObjectCreationParameters)
-            {
-                return allocatedPipelineStateObjectIndex;
-            }
-        } while (pipelineStateObjectPool.GetNextAllocatedIndex(allocatedPipelineStateObjectIndex, &allocatedPipelineStateObjectIndex, &allocatedPipelineStateObjectGeneration));
+        hash = HashCombine(hash, shipUint64(pipelineStateObjectCreationParameters.RenderTargetsFormat[i]));
     }
 
-    return InvalidGfxHandle;
+    return hash;
 }
 
 GFXGraphicsPipelineStateObjectHandle DX11RenderDevice::CreateGraphicsPipelineStateObject(const GraphicsPipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters)
 {
-    shipUint32 pipelineStateObjectIndex = GetGraphicsPipelineStateObjectIndex(m_GraphicsPipelineStateObjectPool, pipelineStateObjectCreationParameters);
-    if (pipelineStateObjectIndex != InvalidGfxHandle)
+    const GFXGraphicsPipelineStateObjectHandle* pExistingPipelineStateObjectHandle = m_GraphicsPipelineStateObjectHandles.Find(pipelineStateObjectCreationParameters);
+    if (pExistingPipelineStateObjectHandle != nullptr)
     {
-        m_GraphicsPipelineStateObjectHandleRefCounts[pipelineStateObjectIndex] += 1;
+        GetHandleRefCount(m_GraphicsPipelineStateObjectHandleRefCounts, pExistingPipelineStateObjectHandle->handle) += 1;
 
-        return GFXGraphicsPipelineStateObjectHandle(pipelineStateObjectIndex);
+        return *pExistingPipelineStateObjectHandle;
     }
 
     GFXGraphicsPipelineStateObjectHandle gfxPipelineStateObjectHandle;
@@ -1082,19 +1139,24 @@ GFXGraphicsPipelineStateObjectHandle DX11RenderDevice::CreateGraphicsPipelineSta
 
     SHIP_ASSERT(isValid);
 
-    m_GraphicsPipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] += 1;
+    GetHandleRefCount(m_GraphicsPipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) += 1;
+
+    m_GraphicsPipelineStateObjectHandles.Insert(pipelineStateObjectCreationParameters, gfxPipelineStateObjectHandle);
 
     return gfxPipelineStateObjectHandle;
 }
 
 void DX11RenderDevice::DestroyGraphicsPipelineStateObject(GFXGraphicsPipelineStateObjectHandle& gfxPipelineStateObjectHandle)
 {
-    SHIP_ASSERT(m_GraphicsPipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] > 0);
-    m_GraphicsPipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] -= 1;
+    SHIP_ASSERT(GetHandleRefCount(m_GraphicsPipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) > 0);
+    GetHandleRefCount(m_GraphicsPipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) -= 1;
 
-    if (m_GraphicsPipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] == 0)
+    if (GetHandleRefCount(m_GraphicsPipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) == 0)
     {
         GFXGraphicsPipelineStateObject& gfxPipelineStateObject = m_GraphicsPipelineStateObjectPool.GetItem(gfxPipelineStateObjectHandle.handle, gfxPipelineStateObjectHandle.generation);
+
+        m_GraphicsPipelineStateObjectHandles.Remove(gfxPipelineStateObject.GetCreationParameters());
+
         gfxPipelineStateObject.Destroy();
 
         m_GraphicsPipelineStateObjectPool.ReleaseItem(gfxPipelineStateObjectHandle.handle);
@@ -1114,8 +1176,9 @@ const GFXGraphicsPipelineStateObject& DX11RenderDevice::GetGraphicsPipelineState
 }
 
 shipUint32 GetComputePipelineStateObjectIndex(
-        const GenerationalDataPool<GFXComputePipelineStateObject, SHIP_MAX_COMPUTE_PIPELINE_STATE_OBJECTS>& pipelineStateObjectPool,
-        const ComputePipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters)
+        const PagedGenerationalDataPool<GFXComputePipelineStateObject>& pipelineStateObjectPool,
+        const ComputePipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters,
+        shipUint16* pipelineStateObjectGeneration)
 {
     shipUint32 allocatedPipelineStateObjectIndex = 0;
     shipUint16 allocatedPipelineStateObjetGeneration = 0;
@@ -1125,6 +1188,7 @@ shipUint32 GetComputePipelineStateObjectIndex(
         {
             if (pipelineStateObjectPool.GetItem(allocatedPipelineStateObjectIndex, allocatedPipelineStateObjetGeneration).GetCreationParameters() == pipelineStateObjectCreationParameters)
             {
+                *pipelineStateObjectGeneration = allocatedPipelineStateObjetGeneration;
                 return allocatedPipelineStateObjectIndex;
             }
         } while (pipelineStateObjectPool.GetNextAllocatedIndex(allocatedPipelineStateObjectIndex, &allocatedPipelineStateObjectIndex, &allocatedPipelineStateObjetGeneration));
@@ -1135,15 +1199,17 @@ shipUint32 GetComputePipelineStateObjectIndex(
 
 GFXComputePipelineStateObjectHandle DX11RenderDevice::CreateComputePipelineStateObject(const ComputePipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters)
 {
-    shipUint32 pipelineStateObjectIndex = GetComputePipelineStateObjectIndex(m_ComputePipelineStateObjectPool, pipelineStateObjectCreationParameters);
-    if (pipelineStateObjectIndex != InvalidGfxHandle)
+    GFXComputePipelineStateObjectHandle gfxPipelineStateObjectHandle;
+
+    // Like samplers, the existing pipeline state object is returned with its current generation.
+    gfxPipelineStateObjectHandle.handle = GetComputePipelineStateObjectIndex(m_ComputePipelineStateObjectPool, pipelineStateObjectCreationParameters, &gfxPipelineStateObjectHandle.generation);
+    if (gfxPipelineStateObjectHandle.handle != InvalidGfxHandle)
     {
-        m_GraphicsPipelineStateObjectHandleRefCounts[pipelineStateObjectIndex] += 1;
+        GetHandleRefCount(m_ComputePipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) += 1;
 
-        return GFXComputePipelineStateObjectHandle(pipelineStateObjectIndex);
+        return gfxPipelineStateObjectHandle;
     }
 
-    GFXComputePipelineStateObjectHandle gfxPipelineStateObjectHandle;
     gfxPipelineStateObjectHandle.handle = m_ComputePipelineStateObjectPool.GetNewItemIndex(&gfxPipelineStateObjectHandle.generation);
 
     GFXComputePipelineStateObject& gfxPipelineStateObject = m_ComputePipelineStateObjectPool.GetItem(gfxPipelineStateObjectHandle.handle, gfxPipelineStateObjectHandle.generation);
@@ -1151,17 +1217,17 @@ GFXComputePipelineStateObjectHandle DX11RenderDevice::CreateComputePipelineState
 
     SHIP_ASSERT(isValid);
 
-    m_GraphicsPipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] += 1;
+    GetHandleRefCount(m_ComputePipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) += 1;
 
     return gfxPipelineStateObjectHandle;
 }
 
 void DX11RenderDevice::DestroyComputePipelineStateObject(GFXComputePipelineStateObjectHandle& gfxPipelineStateObjectHandle)
 {
-    SHIP_ASSERT(m_ComputePipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] > 0);
-    m_ComputePipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] -= 1;
+    SHIP_ASSERT(GetHandleRefCount(m_ComputePipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) > 0);
+    GetHandleRefCount(m_ComputePipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) -= 1;
 
-    if (m_ComputePipelineStateObjectHandleRefCounts[gfxPipelineStateObjectHandle.handle] == 0)
+    if (GetHandleRefCount(m_ComputePipelineStateObjectHandleRefCounts, gfxPipelineStateObjectHandle.handle) == 0)
     {
         GFXComputePipelineStateObject& gfxPipelineStateObject = m_ComputePipelineStateObjectPool.GetItem(gfxPipelineStateObjectHandle.handle, gfxPipelineStateObjectHandle.generation);
         gfxPipelineStateObject.Destroy();
@@ -1315,7 +1381,7 @@ ID3D11InputLayout* RegisterVertexFormatType(ID3D11Device* device, VertexFormatTy
         if (error != nullptr)
         {
             shipChar* errorMsg = (shipChar*)error->GetBufferPointer();
-            SHIP_LOG_ERROR(errorMsg);
+            SHIP_LOG_ERROR("%s", errorMsg);
 
             error->Release();
         }
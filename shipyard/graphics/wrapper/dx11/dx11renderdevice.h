@@ -14,6 +14,9 @@
 #include <graphics/wrapper/dx11/dx11texture.h>
 
 #include <system/datapool.h>
+#include <system/hashmap.h>
+
+#include <mutex>
 
 #include <windows.h>
 
@@ -168,37 +171,56 @@ namespace Shipyard
 
         IDXGISwapChain* CreateSwapchain(shipUint32 width, shipUint32 height, GfxFormat format, HWND hWnd, GFXTexture2DHandle& swapChainTextureHandle);
 
+        // Logs the occupancy and memory usage of every resource pool.
+        void LogPoolStatistics() const;
+
         ID3D11Device* GetDevice() const { return m_Device; }
         ID3D11DeviceContext* GetImmediateDeviceContext() const { return m_ImmediateDeviceContext; }
 
+    private:
+        // The render state isn't hashed since it's compared with a tolerance: pipeline state objects that only differ by their
+        // render state get the same hash, and are told apart by operator==.
+        struct GraphicsPipelineStateObjectCreationParametersHasher
+        {
+            shipUint64 operator() (const GraphicsPipelineStateObjectCreationParameters& pipelineStateObjectCreationParameters) const;
+        };
+
     private:
         ID3D11Device* m_Device;
         ID3D11DeviceContext* m_ImmediateDeviceContext;
 
-        // Render device pools.
-        GenerationalDataPool<GFXVertexBuffer, SHIP_MAX_VERTEX_BUFFERS> m_VertexBufferPool;
-        GenerationalDataPool<GFXIndexBuffer, SHIP_MAX_INDEX_BUFFERS> m_IndexBufferPool;
-        GenerationalDataPool<GFXConstantBuffer, SHIP_MAX_CONSTANT_BUFFERS> m_ConstantBufferPool;
-        GenerationalDataPool<GFXByteBuffer, SHIP_MAX_BYTE_BUFFERS> m_ByteBufferPool;
-        GenerationalDataPool<GFXTexture2D, SHIP_MAX_2D_TEXTURES> m_Texture2dPool;
-        GenerationalDataPool<GFXTexture2DArray, SHIP_MAX_2D_ARRAY_TEXTURES> m_Texture2dArrayPool;
-        GenerationalDataPool<GFXTexture3D, SHIP_MAX_3D_TEXTURES> m_Texture3dPool;
-        GenerationalDataPool<GFXTextureCube, SHIP_MAX_CUBE_TEXTURES> m_TextureCubePool;
-        GenerationalDataPool<GFXSampler, SHIP_MAX_SAMPLERS> m_SamplerPool;
-        GenerationalDataPool<GFXRenderTarget, SHIP_MAX_RENDER_TARGETS> m_RenderTargetPool;
-        GenerationalDataPool<GFXDepthStencilRenderTarget, SHIP_MAX_DEPTH_STENCIL_RENDER_TARGETS> m_DepthStencilRenderTargetPool;
-        GenerationalDataPool<GFXVertexShader, SHIP_MAX_VERTEX_SHADERS> m_VertexShaderPool;
-        GenerationalDataPool<GFXPixelShader, SHIP_MAX_PIXEL_SHADERS> m_PixelShaderPool;
-        GenerationalDataPool<GFXComputeShader, SHIP_MAX_COMPUTE_SHADERS> m_ComputeShaderPool;
-        GenerationalDataPool<GFXRootSignature, SHIP_MAX_ROOT_SIGNATURES> m_RootSignaturePool;
-        GenerationalDataPool<GFXGraphicsPipelineStateObject, SHIP_MAX_GRAPHICS_PIPELINE_STATE_OBJECTS> m_GraphicsPipelineStateObjectPool;
-        GenerationalDataPool<GFXComputePipelineStateObject, SHIP_MAX_COMPUTE_PIPELINE_STATE_OBJECTS> m_ComputePipelineStateObjectPool;
-        GenerationalDataPool<GFXDescriptorSet, SHIP_MAX_DESCRIPTOR_SETS> m_DescriptorSetPool;
+        // Render device pools, which grow as resources are created. Buffers, textures and samplers can be created and destroyed
+        // from loading threads, the other resources must be created on the render thread.
+        PagedGenerationalDataPool<GFXVertexBuffer> m_VertexBufferPool;
+        PagedGenerationalDataPool<GFXIndexBuffer> m_IndexBufferPool;
+        PagedGenerationalDataPool<GFXConstantBuffer> m_ConstantBufferPool;
+        PagedGenerationalDataPool<GFXByteBuffer> m_ByteBufferPool;
+        PagedGenerationalDataPool<GFXTexture2D> m_Texture2dPool;
+        PagedGenerationalDataPool<GFXTexture2DArray> m_Texture2dArrayPool;
+        PagedGenerationalDataPool<GFXTexture3D> m_Texture3dPool;
+        PagedGenerationalDataPool<GFXTextureCube> m_TextureCubePool;
+        PagedGenerationalDataPool<GFXSampler> m_SamplerPool;
+        PagedGenerationalDataPool<GFXRenderTarget> m_RenderTargetPool;
+        PagedGenerationalDataPool<GFXDepthStencilRenderTarget> m_DepthStencilRenderTargetPool;
+        PagedGenerationalDataPool<GFXVertexShader> m_VertexShaderPool;
+        PagedGenerationalDataPool<GFXPixelShader> m_PixelShaderPool;
+        PagedGenerationalDataPool<GFXComputeShader> m_ComputeShaderPool;
+        PagedGenerationalDataPool<GFXRootSignature> m_RootSignaturePool;
+        PagedGenerationalDataPool<GFXGraphicsPipelineStateObject> m_GraphicsPipelineStateObjectPool;
+        PagedGenerationalDataPool<GFXComputePipelineStateObject> m_ComputePipelineStateObjectPool;
+        PagedGenerationalDataPool<GFXDescriptorSet> m_DescriptorSetPool;
 
         // Ref counts for particular type of objects, of which there can be a limited number. Therefore,
-        // with each creation, we can return an already allocated handle.
-        shipUint32 m_SamplerHandleRefCounts[SHIP_MAX_SAMPLERS];
-        shipUint32 m_GraphicsPipelineStateObjectHandleRefCounts[SHIP_MAX_GRAPHICS_PIPELINE_STATE_OBJECTS];
-        shipUint32 m_ComputePipelineStateObjectHandleRefCounts[SHIP_MAX_COMPUTE_PIPELINE_STATE_OBJECTS];
+        // with each creation, we can return an already allocated handle. They are indexed by handle and grow with their pool.
+        Array<shipUint32> m_SamplerHandleRefCounts;
+        Array<shipUint32> m_GraphicsPipelineStateObjectHandleRefCounts;
+        Array<shipUint32> m_ComputePipelineStateObjectHandleRefCounts;
+
+        // Samplers are shared between identical sampler states, so looking for an existing sampler, creating a new one and
+        // updating the ref counts must happen as a whole.
+        std::mutex m_SamplerLock;
+
+        // Lets pipeline state objects created with the same parameters be shared without going through every one of them.
+        HashMap<GraphicsPipelineStateObjectCreationParameters, GFXGraphicsPipelineStateObjectHandle, GraphicsPipelineStateObjectCreationParametersHasher> m_GraphicsPipelineStateObjectHandles;
     };
 }
\ No newline at end of file
@@ -18,4 +18,10 @@ namespace Shipyard
     {
         return ((fabs(a - b)) < epsilon);
     }
+
+    // Number of bits needed to represent the value, 0 for 0.
+    constexpr shipUint32 GetNumBitsForValue(shipUint32 value)
+    {
+        return ((value == 0) ? 0 : (1 + GetNumBitsForValue(value >> 1)));
+    }
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 
 #include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Shipyard
 {
@@ -148,34 +150,62 @@ namespace Shipyard
         };
     };
 
-    // This array can hold a maximum of 16383 elements.
-    template <typename T, size_t alignment = 1>
+    // Capacity given to a full array. Growing geometrically by numerator / denominator keeps adding elements one at a time
+    // amortized constant, a smaller factor wasting less memory at the cost of more reallocations.
+    template <shipUint32 numerator, shipUint32 denominator, shipUint32 minCapacity>
+    struct GeometricArrayGrowthPolicy
+    {
+        static_assert(numerator > denominator, "Arrays must grow.");
+
+        static shipUint64 GetGrownCapacity(shipUint32 currentCapacity)
+        {
+            shipUint64 newCapacity = shipUint64(currentCapacity) * numerator / denominator;
+
+            return MAX(newCapacity, MAX(shipUint64(currentCapacity) + 1, shipUint64(minCapacity)));
+        }
+    };
+
+    using DefaultArrayGrowthPolicy = GeometricArrayGrowthPolicy<2, 1, 4>;
+
+    // This array can hold a maximum of 2147483647 elements (2 ** 31 - 1). Its size and capacity are held in 8 bytes, the highest
+    // bit of the capacity telling whether the memory is borrowed, as is the case for the InplaceArray.
+    template <typename T, size_t alignment = 1, typename GrowthPolicy = DefaultArrayGrowthPolicy>
     class Array : public ArrayIterator<T>
     {
+        template <typename U, size_t otherAlignment, typename OtherGrowthPolicy>
+        friend class Array;
+
+    public:
+        enum : shipUint32
+        {
+            MaxCapacity = 0x7FFFFFFF
+        };
+
     protected:
-        enum
+        enum : shipUint32
         {
-            BORROWED_MEMORY_FLAG = 0x80000000
+            BORROWED_MEMORY_FLAG = 0x80000000,
+            CAPACITY_MASK = MaxCapacity
         };
 
     public:
         Array(BaseAllocator* pAllocator = nullptr)
             : m_pAllocator(pAllocator)
             , m_Array(nullptr)
-            , m_ArraySizeAndCapacity(0)
+            , m_Size(0)
+            , m_CapacityAndFlags(0)
         {
             if (pAllocator == nullptr)
             {
                 m_pAllocator = &GetGlobalAllocator();
             }
-
-            Reserve(4);
         }
 
         Array(shipUint32 initialCapacity, BaseAllocator* pAllocator = nullptr)
             : m_pAllocator(pAllocator)
             , m_Array(nullptr)
-            , m_ArraySizeAndCapacity(0)
+            , m_Size(0)
+            , m_CapacityAndFlags(0)
         {
             if (pAllocator == nullptr)
             {
@@ -193,85 +223,74 @@ namespace Shipyard
             Clear();
         }
 
+        // Copies only allocate when there are elements to copy.
         Array(const Array& src)
-            : m_Array(nullptr)
-            , m_ArraySizeAndCapacity(0)
+            : m_pAllocator(src.GetAllocator())
+            , m_Array(nullptr)
+            , m_Size(0)
+            , m_CapacityAndFlags(0)
         {
-            m_pAllocator = src.GetAllocator();
-
-            Reserve(MAX(src.Capacity(), 4));
-
-            shipUint32 srcSize = src.Size();
-
-            m_ArraySizeAndCapacity |= srcSize;
-
-            for (shipUint32 i = 0; i < srcSize; i++)
-            {
-                m_Array[i] = src[i];
-            }
+            CopyElementsFrom(src);
         }
 
-        template <typename U, size_t otherAlignment>
-        Array(const Array<U, otherAlignment>& src)
-            : m_Array(nullptr)
-            , m_ArraySizeAndCapacity(0)
+        template <typename U, size_t otherAlignment, typename OtherGrowthPolicy>
+        Array(const Array<U, otherAlignment, OtherGrowthPolicy>& src)
+            : m_pAllocator(src.GetAllocator())
+            , m_Array(nullptr)
+            , m_Size(0)
+            , m_CapacityAndFlags(0)
         {
-            m_pAllocator = src.GetAllocator();
-
-            Reserve(MAX(src.Capacity(), 4));
-
-            shipUint32 srcSize = src.Size();
-
-            m_ArraySizeAndCapacity |= srcSize;
+            CopyElementsFrom(src);
+        }
 
-            for (shipUint32 i = 0; i < srcSize; i++)
-            {
-                m_Array[i] = src[i];
-            }
+        // Takes the memory of src, which is left empty. Memory borrowed by src, like the static buffer of an InplaceArray, can't be
+        // taken, so its elements are moved one by one instead.
+        Array(Array&& src)
+            : m_pAllocator(src.m_pAllocator)
+            , m_Array(nullptr)
+            , m_Size(0)
+            , m_CapacityAndFlags(0)
+        {
+            TakeElementsFrom(src);
         }
 
+        // The current memory is reused when it comes from the same allocator, or when it's borrowed.
         Array& operator= (const Array& rhs)
         {
             if (this != &rhs)
             {
-                Clear();
-
-                m_pAllocator = rhs.GetAllocator();
-
-                Reserve(MAX(rhs.Capacity(), 4));
-
-                shipUint32 srcSize = rhs.Size();
+                AssignElementsFrom(rhs);
+            }
 
-                m_ArraySizeAndCapacity |= srcSize;
+            return *this;
+        }
 
-                for (shipUint32 i = 0; i < srcSize; i++)
-                {
-                    m_Array[i] = rhs[i];
-                }
-            }
+        template <typename U, size_t otherAlignment, typename OtherGrowthPolicy>
+        Array& operator= (const Array<U, otherAlignment, OtherGrowthPolicy>& rhs)
+        {
+            AssignElementsFrom(rhs);
 
             return *this;
         }
 
-        template <typename U, size_t otherAlignment>
-        Array& operator= (const Array<U, otherAlignment>& rhs)
+        // Borrowed memory is kept, so that moving to an InplaceArray through a reference to its base Array doesn't drop the static
+        // buffer. The memory of rhs is still taken if it isn't borrowed.
+        Array& operator= (Array&& rhs)
         {
             if (this != &rhs)
             {
-                Clear();
-
-                m_pAllocator = rhs.GetAllocator();
-
-                Reserve(MAX(rhs.Capacity(), 4));
-
-                shipUint32 srcSize = rhs.Size();
-
-                m_ArraySizeAndCapacity |= srcSize;
-
-                for (shipUint32 i = 0; i < srcSize; i++)
+                if (IsMemoryBorrowed())
                 {
-                    m_Array[i] = rhs[i];
+                    Resize(0);
                 }
+                else
+                {
+                    Clear();
+                }
+
+                m_pAllocator = rhs.m_pAllocator;
+
+                TakeElementsFrom(rhs);
             }
 
             return *this;
@@ -279,165 +298,161 @@ namespace Shipyard
 
         T& operator[] (shipUint32 index)
         {
-            SHIP_ASSERT(index < Size());
+            SHIP_ASSERT(index < m_Size);
             return m_Array[index];
         }
 
         const T& operator[] (shipUint32 index) const
         {
-            SHIP_ASSERT(index < Size());
+            SHIP_ASSERT(index < m_Size);
             return m_Array[index];
         }
 
         T& Front()
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize > 0);
+            SHIP_ASSERT(m_Size > 0);
 
             return m_Array[0];
         }
 
         const T& Front() const
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize > 0);
+            SHIP_ASSERT(m_Size > 0);
 
             return m_Array[0];
         }
 
         T& Back()
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize > 0);
+            SHIP_ASSERT(m_Size > 0);
 
-            return m_Array[currentSize - 1];
+            return m_Array[m_Size - 1];
         }
 
         const T& Back() const
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize > 0);
+            SHIP_ASSERT(m_Size > 0);
 
-            return m_Array[currentSize - 1];
+            return m_Array[m_Size - 1];
         }
 
         void Add(const T& element)
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize < 16383);
+            GrowCapacityIfFull();
 
-            shipUint32 currentCapacity = Capacity();
+            m_Array[m_Size] = element;
 
-            if ((currentSize + 1) > currentCapacity)
-            {
-                shipUint32 newCapacity = MIN(currentCapacity * 2, 16383);
-                Reserve(MAX(newCapacity, 4));
-            }
+            m_Size += 1;
+        }
+
+        void Add(T&& element)
+        {
+            GrowCapacityIfFull();
 
-            m_Array[currentSize] = element;
+            m_Array[m_Size] = std::move(element);
 
-            m_ArraySizeAndCapacity += 1;
+            m_Size += 1;
         }
 
-        // Returns true if the element is unique and could be added, false if the element was already in the array
-        shipBool AddUnique(const T& element)
+        // Constructs the new element in place from args, without any temporary.
+        template <typename... Args>
+        T& EmplaceBack(Args&&... args)
+        {
+            GrowCapacityIfFull();
+
+            T* pElement = &m_Array[m_Size];
+            ReconstructElement(pElement, std::forward<Args>(args)...);
+
+            m_Size += 1;
+
+            return *pElement;
+        }
+
+        // Elements from indexToEmplaceAt are shifted right to make room for the new element, which is constructed in place from args.
+        template <typename... Args>
+        T& Emplace(shipUint32 indexToEmplaceAt, Args&&... args)
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize < 16383);
+            SHIP_ASSERT(indexToEmplaceAt <= m_Size);
+
+            GrowCapacityIfFull();
 
-            for (shipUint32 i = 0; i < currentSize; i++)
+            for (shipUint32 i = m_Size; i > indexToEmplaceAt; i--)
             {
-                if (m_Array[i] == element)
-                {
-                    return false;
-                }
+                m_Array[i] = std::move(m_Array[i - 1]);
             }
 
-            shipUint32 currentCapacity = Capacity();
+            T* pElement = &m_Array[indexToEmplaceAt];
+            ReconstructElement(pElement, std::forward<Args>(args)...);
 
-            if ((currentSize + 1) > currentCapacity)
+            m_Size += 1;
+
+            return *pElement;
+        }
+
+        // Returns true if the element is unique and could be added, false if the element was already in the array
+        shipBool AddUnique(const T& element)
+        {
+            if (Exists(element))
             {
-                shipUint32 newCapacity = MIN(currentCapacity * 2, 16383);
-                Reserve(MAX(newCapacity, 4));
+                return false;
             }
 
-            m_Array[currentSize] = element;
-
-            m_ArraySizeAndCapacity += 1;
+            Add(element);
 
             return true;
         }
 
         T& Grow()
         {
-            Add(T());
-            return Back();
+            return EmplaceBack();
         }
 
         void Pop()
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize > 0);
+            SHIP_ASSERT(m_Size > 0);
 
-            m_Array[currentSize - 1].~T();
+            ReconstructElement(&m_Array[m_Size - 1]);
 
-            m_ArraySizeAndCapacity -= 1;
+            m_Size -= 1;
         }
 
         void Remove(const T& elementToRemove)
         {
-            shipUint32 currentSize = Size();
-            if (currentSize == 0)
-            {
-                return;
-            }
-
-            for (shipUint32 i = 0; i < currentSize; i++)
+            shipUint32 indexToRemove = FindIndex(elementToRemove);
+            if (indexToRemove != shipUint32(-1))
             {
-                if (m_Array[i] == elementToRemove)
-                {
-                    RemoveAt(i);
-                    break;
-                }
+                RemoveAt(indexToRemove);
             }
         }
 
         void RemoveAt(shipUint32 indexToRemove)
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(indexToRemove < currentSize);
+            SHIP_ASSERT(indexToRemove < m_Size);
 
             // Fast remove by swapping the index to remove with the last one.
-            m_Array[indexToRemove] = m_Array[currentSize - 1];
+            if (indexToRemove != (m_Size - 1))
+            {
+                m_Array[indexToRemove] = std::move(m_Array[m_Size - 1]);
+            }
 
             Pop();
         }
 
         void RemoveAtPreserveOrder(shipUint32 indexToRemove)
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(indexToRemove < currentSize);
+            SHIP_ASSERT(indexToRemove < m_Size);
 
-            if (currentSize > 1)
+            for (shipUint32 i = indexToRemove; i < (m_Size - 1); i++)
             {
-                m_Array[indexToRemove].~T();
-
-                for (shipUint32 i = indexToRemove; i < (currentSize - 1); i++)
-                {
-                    m_Array[i] = m_Array[i + 1];
-                }
-
-                m_ArraySizeAndCapacity -= 1;
-            }
-            else
-            {
-                Pop();
+                m_Array[i] = std::move(m_Array[i + 1]);
             }
+
+            Pop();
         }
 
         void Clear()
         {
-            if ((m_ArraySizeAndCapacity & BORROWED_MEMORY_FLAG) == 0)
+            if (!IsMemoryBorrowed())
             {
                 shipUint32 currentCapacity = Capacity();
                 for (shipUint32 i = 0; i < currentCapacity; i++)
@@ -449,127 +464,127 @@ namespace Shipyard
             }
 
             m_Array = nullptr;
-            m_ArraySizeAndCapacity = 0;
+            m_Size = 0;
+            m_CapacityAndFlags = 0;
         }
 
         shipBool Empty() const
         {
-            return (Size() == 0);
+            return (m_Size == 0);
         }
 
         void InsertAt(shipUint32 indexToInsertAt, const T& elementToInsert)
         {
-            shipUint32 currentSize = Size();
-            SHIP_ASSERT(currentSize < 16384);
+            SHIP_ASSERT(indexToInsertAt <= m_Size);
 
-            shipUint32 currentCapacity = Capacity();
-
-            if ((currentSize + 1) > currentCapacity)
-            {
-                shipUint32 newCapacity = MIN(currentCapacity * 2, 16383);
-                Reserve(MAX(newCapacity, 4));
-            }
+            GrowCapacityIfFull();
 
             // We have to go in reverse order, otherwise we'd shift the element right after the index at which we want
             // to insert at every other location.
-            for (shipUint32 i = currentSize + 1; i > (indexToInsertAt + 1); i--)
+            for (shipUint32 i = m_Size + 1; i > (indexToInsertAt + 1); i--)
             {
                 shipUint32 currentIdx = i - 1;
                 shipUint32 previousIdx = i - 2;
 
-                m_Array[currentIdx] = m_Array[previousIdx];
+                m_Array[currentIdx] = std::move(m_Array[previousIdx]);
             }
 
             m_Array[indexToInsertAt] = elementToInsert;
 
-            m_ArraySizeAndCapacity += 1;
+            m_Size += 1;
         }
 
         void Reserve(shipUint32 newCapacity)
         {
-            SHIP_ASSERT(newCapacity <= 16383);
+            SHIP_ASSERT(newCapacity <= MaxCapacity);
+
+            shipUint32 currentCapacity = Capacity();
 
-            if (newCapacity <= Capacity())
+            if (newCapacity <= currentCapacity)
             {
                 return;
             }
 
             size_t requiredSize = sizeof(T) * newCapacity;
 
-            T* newArray = reinterpret_cast<T*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, alignment));
-
-            for (shipUint32 i = 0; i < newCapacity; i++)
+            // Trivially copyable elements can be moved with a memcpy, which lets the allocator grow the memory in place when it can.
+            // Big buffers then don't need the old and the new memory at the same time while growing.
+            shipBool canReallocate = (std::is_trivially_copyable<T>::value && m_Array != nullptr && !IsMemoryBorrowed());
+            if (canReallocate)
             {
-                new(newArray + i)T();
-            }
+                T* newArray = reinterpret_cast<T*>(SHIP_REALLOC_EX(m_pAllocator, m_Array, sizeof(T) * currentCapacity, requiredSize, alignment));
 
-            shipUint32 currentSize = Size();
+                for (shipUint32 i = currentCapacity; i < newCapacity; i++)
+                {
+                    new(newArray + i)T();
+                }
 
-            for (shipUint32 i = 0; i < currentSize; i++)
-            {
-                newArray[i] = m_Array[i];
+                m_Array = newArray;
             }
-
-            if ((m_ArraySizeAndCapacity & BORROWED_MEMORY_FLAG) == 0)
+            else
             {
-                shipUint32 currentCapacity = Capacity();
-                for (shipUint32 i = 0; i < currentCapacity; i++)
+                T* newArray = reinterpret_cast<T*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, alignment));
+
+                MoveConstructElements(newArray, newCapacity);
+
+                if (!IsMemoryBorrowed())
                 {
-                    m_Array[i].~T();
+                    for (shipUint32 i = 0; i < currentCapacity; i++)
+                    {
+                        m_Array[i].~T();
+                    }
+
+                    SHIP_FREE_EX(m_pAllocator, m_Array);
+                }
+                else
+                {
+                    // Borrowed elements outlive the array, leave them in their default state rather than moved-from.
+                    for (shipUint32 i = 0; i < m_Size; i++)
+                    {
+                        ReconstructElement(&m_Array[i]);
+                    }
                 }
 
-                SHIP_FREE_EX(m_pAllocator, m_Array);
+                m_Array = newArray;
             }
 
-            m_Array = newArray;
-
-            m_ArraySizeAndCapacity &= ~0xFFFC000;
-            m_ArraySizeAndCapacity |= (newCapacity << 14);
+            // The memory is now owned by the array.
+            m_CapacityAndFlags = newCapacity;
         }
 
         void Resize(shipUint32 newSize)
         {
-            SHIP_ASSERT(newSize <= 16383);
-
-            shipUint32 currentSize = Size();
+            SHIP_ASSERT(newSize <= MaxCapacity);
 
-            if (newSize < currentSize)
+            if (newSize < m_Size)
             {
-                shipUint32 numElementsToRemove = (currentSize - newSize);
+                shipUint32 numElementsToRemove = (m_Size - newSize);
                 for (shipUint32 i = 0; i < numElementsToRemove; i++)
                 {
                     Pop();
                 }
             }
-            else if (newSize > currentSize)
+            else if (newSize > Capacity())
             {
-                shipUint32 currentCapacity = Capacity();
-
-                if (newSize > currentCapacity)
-                {
-                    Reserve(MAX(newSize, 4));
-                }
-
-                m_ArraySizeAndCapacity &= ~0x3FFF;
-                m_ArraySizeAndCapacity |= newSize;
+                Reserve(MAX(newSize, 4));
             }
+
+            m_Size = newSize;
         }
 
         shipUint32 Size() const
         {
-            return (m_ArraySizeAndCapacity & 0x3FFF);
+            return m_Size;
         }
 
         shipUint32 Capacity() const
         {
-            return ((m_ArraySizeAndCapacity >> 14) & 0x3FFF);
+            return (m_CapacityAndFlags & CAPACITY_MASK);
         }
 
         shipUint32 FindIndex(const T& elementToFind) const
         {
-            shipUint32 currentSize = Size();
-            
-            for (shipUint32 i = 0; i < currentSize; i++)
+            for (shipUint32 i = 0; i < m_Size; i++)
             {
                 if (m_Array[i] == elementToFind)
                 {
@@ -589,16 +604,15 @@ namespace Shipyard
         {
             SHIP_ASSERT(userArray != nullptr);
             SHIP_ASSERT(numElements > 0);
-            SHIP_ASSERT(numElements < 16384);
+            SHIP_ASSERT(numElements <= MaxCapacity);
             SHIP_ASSERT(startingSize <= numElements);
 
             Clear();
 
             m_Array = userArray;
 
-            m_ArraySizeAndCapacity |= startingSize;
-            m_ArraySizeAndCapacity |= (numElements << 14);
-            m_ArraySizeAndCapacity |= BORROWED_MEMORY_FLAG;
+            m_Size = startingSize;
+            m_CapacityAndFlags = (numElements | BORROWED_MEMORY_FLAG);
         }
 
         void SetAllocator(BaseAllocator* pAllocator)
@@ -608,35 +622,22 @@ namespace Shipyard
                 return;
             }
 
-            if ((m_ArraySizeAndCapacity & BORROWED_MEMORY_FLAG) == 0)
-            {
-                size_t capacity = Capacity();
+            shipUint32 currentCapacity = Capacity();
 
-                size_t requiredSize = sizeof(T) * capacity;
+            // Nothing to move if there's no memory yet, the first allocation will use the new allocator.
+            if (!IsMemoryBorrowed() && currentCapacity > 0)
+            {
+                size_t requiredSize = sizeof(T) * currentCapacity;
                 T* pNewArray = reinterpret_cast<T*>(SHIP_ALLOC_EX(pAllocator, requiredSize, alignment));
 
-                for (shipUint32 i = 0; i < capacity; i++)
-                {
-                    new(pNewArray + i)T();
-                }
+                MoveConstructElements(pNewArray, currentCapacity);
 
-                shipUint32 numElements = Size();
-
-                for (shipUint32 i = 0; i < numElements; i++)
+                for (shipUint32 i = 0; i < currentCapacity; i++)
                 {
-                    pNewArray[i] = m_Array[i];
+                    m_Array[i].~T();
                 }
 
-                if ((m_ArraySizeAndCapacity & BORROWED_MEMORY_FLAG) == 0)
-                {
-                    shipUint32 currentCapacity = Capacity();
-                    for (shipUint32 i = 0; i < currentCapacity; i++)
-                    {
-                        m_Array[i].~T();
-                    }
-
-                    SHIP_FREE_EX(m_pAllocator, m_Array);
-                }
+                SHIP_FREE_EX(m_pAllocator, m_Array);
 
                 m_Array = pNewArray;
             }
@@ -650,437 +651,234 @@ namespace Shipyard
         }
 
     protected:
-        BaseAllocator* m_pAllocator;
-        T* m_Array;
-        shipUint32 m_ArraySizeAndCapacity;
-
-    public:
-        Iterator begin()
-        {
-            return Iterator(&m_Array[0]);
-        }
-
-        ConstIterator begin() const
-        {
-            return ConstIterator(&m_Array[0]);
-        }
-
-        Iterator end()
-        {
-            return Iterator(&m_Array[Size()]);
-        }
-
-        ConstIterator end() const
+        shipBool IsMemoryBorrowed() const
         {
-            return ConstIterator(&m_Array[Size()]);
-        }
-    };
-
-    // Syntactic sugar for:
-    //
-    // ArrayType staticBuffer[100];
-    // Array<ArrayType> myArray;
-    // myArray.SetUserPoint(staticBuffer, 100, 0);
-    //
-    // Instead:
-    //
-    // InplaceArray<ArrayType, 100> myArray;
-    template <typename T, shipUint32 inplaceSize, size_t alignment = 1>
-    class InplaceArray : public Array<T, alignment>
-    {
-    public:
-        InplaceArray(BaseAllocator* pAllocator = nullptr)
-            : Array(0, pAllocator)
-        {
-            this->SetUserPointer(m_StaticArray, inplaceSize, 0);
+            return ((m_CapacityAndFlags & BORROWED_MEMORY_FLAG) != 0);
         }
 
-    private:
-        T m_StaticArray[inplaceSize];
-    };
-
-    // Array of number of elements larger than 16383, up to 4294967295 elements (2 ** 32 - 1)
-    template <typename T, size_t alignment = 1>
-    class BigArray : public ArrayIterator<T>
-    {
-    public:
-        BigArray(BaseAllocator* pAllocator = nullptr)
-            : m_pAllocator(pAllocator)
-            , m_Array(nullptr)
-            , m_Size(0)
-            , m_Capacity(0)
+        // The array must be empty.
+        void TakeElementsFrom(Array& src)
         {
-            if (pAllocator == nullptr)
+            if (!src.IsMemoryBorrowed())
             {
-                m_pAllocator = &GetGlobalAllocator();
-            }
+                m_Array = src.m_Array;
+                m_Size = src.m_Size;
+                m_CapacityAndFlags = src.m_CapacityAndFlags;
 
-            Reserve(4);
-        }
+                src.m_Array = nullptr;
+                src.m_Size = 0;
+                src.m_CapacityAndFlags = 0;
 
-        BigArray(shipUint32 initialCapacity, BaseAllocator* pAllocator = nullptr)
-            : m_pAllocator(pAllocator)
-            , m_Array(nullptr)
-            , m_Size(0)
-            , m_Capacity(0)
-        {
-            if (pAllocator == nullptr)
-            {
-                m_pAllocator = &GetGlobalAllocator();
+                return;
             }
 
-            if (initialCapacity > 0)
+            shipUint32 srcSize = src.Size();
+            if (srcSize == 0)
             {
-                Reserve(initialCapacity);
+                return;
             }
-        }
 
-        ~BigArray()
-        {
-            Clear();
-        }
+            Reserve(srcSize);
 
-        BigArray(const BigArray& src)
-            : m_pAllocator(src.m_pAllocator)
-            , m_Array(nullptr)
-            , m_Size(0)
-            , m_Capacity(0)
-        {
-            Reserve(MAX(src.m_Capacity, 4));
-
-            m_Size = src.m_Size;
-
-            for (shipUint32 i = 0; i < m_Size; i++)
-            {
-                m_Array[i] = src.m_Array[i];
-            }
-        }
+            m_Size = srcSize;
 
-        BigArray& operator= (const BigArray& rhs)
-        {
-            if (this != &rhs)
+            for (shipUint32 i = 0; i < srcSize; i++)
             {
-                Clear();
-
-                m_pAllocator = rhs.m_pAllocator;
-
-                Reserve(MAX(rhs.m_Capacity, 4));
-
-                m_Size = rhs.m_Size;
-
-                for (shipUint32 i = 0; i < m_Size; i++)
-                {
-                    m_Array[i] = rhs.m_Array[i];
-                }
+                m_Array[i] = std::move(src.m_Array[i]);
             }
 
-            return *this;
-        }
-
-        T& operator[] (shipUint32 index)
-        {
-            SHIP_ASSERT(index < m_Size);
-            return m_Array[index];
-        }
-
-        const T& operator[] (shipUint32 index) const
-        {
-            SHIP_ASSERT(index < m_Size);
-            return m_Array[index];
+            src.Resize(0);
         }
 
-        T& Front()
-        {
-            SHIP_ASSERT(m_Size > 0);
-
-            return m_Array[0];
-        }
-
-        const T& Front() const
+    private:
+        // Every slot up to the capacity holds a constructed element. Slots past the size are kept in their default state, so
+        // they are destroyed and constructed again to be given a new value in place.
+        template <typename... Args>
+        static void ReconstructElement(T* pElement, Args&&... args)
         {
-            SHIP_ASSERT(m_Size > 0);
-
-            return m_Array[0];
+            pElement->~T();
+            new(pElement)T(std::forward<Args>(args)...);
         }
 
-        T& Back()
+        void GrowCapacityIfFull()
         {
-            SHIP_ASSERT(m_Size > 0);
-
-            return m_Array[m_Size - 1];
-        }
+            shipUint32 currentCapacity = Capacity();
 
-        const T& Back() const
-        {
-            SHIP_ASSERT(m_Size > 0);
+            if (m_Size == currentCapacity)
+            {
+                SHIP_ASSERT_MSG(currentCapacity < MaxCapacity, "Array can't hold more than %u elements", shipUint32(MaxCapacity));
 
-            return m_Array[m_Size - 1];
+                shipUint64 newCapacity = GrowthPolicy::GetGrownCapacity(currentCapacity);
+                Reserve(shipUint32(MIN(newCapacity, shipUint64(MaxCapacity))));
+            }
         }
 
-        void Add(const T& element)
+        // Constructs newCapacity elements in pNewArray, the current elements being moved to the first ones.
+        void MoveConstructElements(T* pNewArray, shipUint32 newCapacity)
         {
-            SHIP_ASSERT(m_Size < 0xFFFFFFFF);
-
-            if ((m_Size + 1) > m_Capacity)
+            for (shipUint32 i = 0; i < m_Size; i++)
             {
-                shipUint32 newCapacity = shipUint32(MIN(shipUint64(m_Capacity) * 2, 0xFFFFFFFF));
-                Reserve(MAX(newCapacity, 4));
+                new(pNewArray + i)T(std::move(m_Array[i]));
             }
 
-            m_Array[m_Size] = element;
-
-            m_Size += 1;
-        }
-
-        T& Grow()
-        {
-            Add(T());
-            return Back();
-        }
-
-        void Pop()
-        {
-            SHIP_ASSERT(m_Size > 0);
-
-            m_Array[m_Size - 1].~T();
-
-            m_Size -= 1;
+            for (shipUint32 i = m_Size; i < newCapacity; i++)
+            {
+                new(pNewArray + i)T();
+            }
         }
 
-        void Remove(const T& elementToRemove)
+        // The array must be empty.
+        template <typename U, size_t otherAlignment, typename OtherGrowthPolicy>
+        void CopyElementsFrom(const Array<U, otherAlignment, OtherGrowthPolicy>& src)
         {
-            if (m_Size == 0)
+            shipUint32 srcSize = src.Size();
+            if (srcSize == 0)
             {
                 return;
             }
 
-            for (shipUint32 i = 0; i < m_Size; i++)
-            {
-                if (m_Array[i] == elementToRemove)
-                {
-                    RemoveAt(i);
-                    break;
-                }
-            }
-        }
+            Reserve(srcSize);
 
-        void RemoveAt(shipUint32 indexToRemove)
-        {
-            SHIP_ASSERT(indexToRemove < m_Size);
-
-            // Fast remove by swapping the index to remove with the last one.
-            m_Array[indexToRemove] = m_Array[m_Size - 1];
+            m_Size = srcSize;
 
-            Pop();
+            for (shipUint32 i = 0; i < srcSize; i++)
+            {
+                m_Array[i] = src[i];
+            }
         }
 
-        void RemoveAtPreserveOrder(shipUint32 indexToRemove)
+        template <typename U, size_t otherAlignment, typename OtherGrowthPolicy>
+        void AssignElementsFrom(const Array<U, otherAlignment, OtherGrowthPolicy>& src)
         {
-            SHIP_ASSERT(indexToRemove < m_Size);
-
-            if (m_Size > 1)
+            if (!IsMemoryBorrowed() && m_pAllocator != src.GetAllocator())
             {
-                m_Array[indexToRemove].~T();
-
-                for (shipUint32 i = indexToRemove; i < (m_Size - 1); i++)
-                {
-                    m_Array[i] = m_Array[i + 1];
-                }
+                Clear();
 
-                m_Size -= 1;
+                m_pAllocator = src.GetAllocator();
             }
             else
             {
-                Pop();
+                Resize(0);
             }
-        }
 
-        void Clear()
-        {
-            for (shipUint32 i = 0; i < m_Capacity; i++)
-            {
-                m_Array[i].~T();
-            }
+            CopyElementsFrom(src);
+        }
 
-            SHIP_FREE_EX(m_pAllocator, m_Array);
+    protected:
+        BaseAllocator* m_pAllocator;
+        T* m_Array;
+        shipUint32 m_Size;
+        shipUint32 m_CapacityAndFlags;
 
-            m_Array = nullptr;
-            m_Size = 0;
-            m_Capacity = 0;
+    public:
+        Iterator begin()
+        {
+            return Iterator(m_Array);
         }
 
-        shipBool Empty() const
+        ConstIterator begin() const
         {
-            return (m_Size == 0);
+            return ConstIterator(m_Array);
         }
 
-        void InsertAt(shipUint32 indexToInsertAt, const T& elementToInsert)
+        Iterator end()
         {
-            SHIP_ASSERT(m_Size < 0xFFFFFFFF);
-
-            if ((m_Size + 1) > m_Capacity)
-            {
-                shipUint32 newCapacity = shipUint32(MIN(shipUint64(m_Capacity) * 2, 0xFFFFFFFF));
-                Reserve(MAX(newCapacity, 4));
-            }
-
-            // We have to go in reverse order, otherwise we'd shift the element right after the index at which we want
-            // to insert at every other location.
-            for (shipUint32 i = m_Size + 1; i > (indexToInsertAt + 1); i--)
-            {
-                shipUint32 currentIdx = i - 1;
-                shipUint32 previousIdx = i - 2;
-
-                m_Array[currentIdx] = m_Array[previousIdx];
-            }
-
-            m_Array[indexToInsertAt] = elementToInsert;
-
-            m_Size += 1;
+            return Iterator(m_Array + m_Size);
         }
 
-        void Reserve(shipUint32 newCapacity)
+        ConstIterator end() const
         {
-            SHIP_ASSERT(newCapacity <= 0xFFFFFFFF);
-
-            if (newCapacity <= m_Capacity)
-            {
-                return;
-            }
-
-            size_t requiredSize = sizeof(T) * newCapacity;
-
-            T* newArray = reinterpret_cast<T*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, alignment));
-
-            for (shipUint32 i = 0; i < newCapacity; i++)
-            {
-                new(newArray + i)T();
-            }
-
-            for (shipUint32 i = 0; i < m_Size; i++)
-            {
-                newArray[i] = m_Array[i];
-            }
-
-            for (shipUint32 i = 0; i < m_Capacity; i++)
-            {
-                m_Array[i].~T();
-            }
-
-            SHIP_FREE_EX(m_pAllocator, m_Array);
+            return ConstIterator(m_Array + m_Size);
+        }
+    };
 
-            m_Array = newArray;
+    // Syntactic sugar for:
+    //
+    // ArrayType staticBuffer[100];
+    // Array<ArrayType> myArray;
+    // myArray.SetUserPoint(staticBuffer, 100, 0);
+    //
+    // Instead:
+    //
+    // InplaceArray<ArrayType, 100> myArray;
+    //
+    // Elements past inplaceSize are moved to memory from the allocator. Copying or moving to it keeps using the static buffer
+    // while it's big enough. Once the elements are in memory from the allocator, only InplaceArray::Clear goes back to the static
+    // buffer, Array::Clear isn't virtual and can't know about it.
+    template <typename T, shipUint32 inplaceSize, size_t alignment = 1, typename GrowthPolicy = DefaultArrayGrowthPolicy>
+    class InplaceArray : public Array<T, alignment, GrowthPolicy>
+    {
+        using BaseType = Array<T, alignment, GrowthPolicy>;
 
-            m_Capacity = newCapacity;
+    public:
+        InplaceArray(BaseAllocator* pAllocator = nullptr)
+            : BaseType(pAllocator)
+        {
+            this->SetUserPointer(m_StaticArray, inplaceSize, 0);
         }
 
-        void Resize(shipUint32 newSize)
+        InplaceArray(const BaseType& src)
+            : BaseType(src.GetAllocator())
         {
-            SHIP_ASSERT(newSize <= 0xFFFFFFFF);
-
-            if (newSize < m_Size)
-            {
-                shipUint32 numElementsToRemove = (m_Size - newSize);
-                for (shipUint32 i = 0; i < numElementsToRemove; i++)
-                {
-                    Pop();
-                }
-            }
-            else if (newSize > m_Size)
-            {
-                if (newSize > m_Capacity)
-                {
-                    Reserve(MAX(newSize, 4));
-                }
-            }
+            this->SetUserPointer(m_StaticArray, inplaceSize, 0);
 
-            m_Size = newSize;
+            BaseType::operator=(src);
         }
 
-        shipUint32 Size() const
+        InplaceArray(const InplaceArray& src)
+            : InplaceArray(static_cast<const BaseType&>(src))
         {
-            return m_Size;
         }
 
-        shipUint32 Capacity() const
+        InplaceArray(InplaceArray&& src)
+            : BaseType(src.GetAllocator())
         {
-            return m_Capacity;
+            this->SetUserPointer(m_StaticArray, inplaceSize, 0);
+
+            *this = std::move(src);
         }
 
-        shipUint32 FindIndex(const T& elementToFind) const
+        InplaceArray& operator= (const BaseType& rhs)
         {
-            for (shipUint32 i = 0; i < m_Size; i++)
-            {
-                if (m_Array[i] == elementToFind)
-                {
-                    return i;
-                }
-            }
+            BaseType::operator=(rhs);
 
-            return shipUint32(-1);
+            return *this;
         }
 
-        shipBool Exists(const T& elementToFind) const
+        InplaceArray& operator= (const InplaceArray& rhs)
         {
-            return (FindIndex(elementToFind) != shipUint32(-1));
+            BaseType::operator=(rhs);
+
+            return *this;
         }
 
-        void SetAllocator(BaseAllocator* pAllocator)
+        InplaceArray& operator= (InplaceArray&& rhs)
         {
-            if (pAllocator == m_pAllocator)
-            {
-                return;
-            }
-
-            size_t requiredSize = sizeof(T) * m_Capacity;
-            T* pNewArray = reinterpret_cast<T*>(SHIP_ALLOC_EX(pAllocator, requiredSize, alignment));
-
-            for (shipUint32 i = 0; i < m_Capacity; i++)
+            if (this != &rhs)
             {
-                new(pNewArray + i)T();
-            }
+                Clear();
 
-            for (shipUint32 i = 0; i < m_Size; i++)
-            {
-                pNewArray[i] = m_Array[i];
-            }
+                this->m_pAllocator = rhs.m_pAllocator;
+                this->TakeElementsFrom(rhs);
 
-            for (shipUint32 i = 0; i < m_Capacity; i++)
-            {
-                m_Array[i].~T();
+                rhs.Clear();
             }
 
-            SHIP_FREE_EX(m_pAllocator, m_Array);
-
-            m_Array = pNewArray;
-            m_pAllocator = pAllocator;
-        }
-
-    protected:
-        BaseAllocator* m_pAllocator;
-        T* m_Array;
-        shipUint32 m_Size;
-        shipUint32 m_Capacity;
-
-    public:
-        Iterator begin()
-        {
-            return Iterator(&m_Array[0]);
+            return *this;
         }
 
-        ConstIterator begin() const
+        // Frees the memory taken from the allocator, if any, and goes back to the static buffer.
+        void Clear()
         {
-            return ConstIterator(&m_Array[0]);
-        }
+            this->Resize(0);
 
-        Iterator end()
-        {
-            return Iterator(&m_Array[Size()]);
+            if (!this->IsMemoryBorrowed())
+            {
+                this->SetUserPointer(m_StaticArray, inplaceSize, 0);
+            }
         }
 
-        ConstIterator end() const
-        {
-            return ConstIterator(&m_Array[Size()]);
-        }
+    private:
+        T m_StaticArray[inplaceSize];
     };
-}
\ No newline at end of file
+}
@@ -2,38 +2,440 @@
 
 #include <system/platform.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if COMPILER == COMPILER_MSVC
+#include <intrin.h>
+#endif // #if COMPILER == COMPILER_MSVC
+
 namespace Shipyard
 {
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicIncrement(volatile shipUint32& val);
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicDecrement(volatile shipUint32& val);
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicCompareExchange(volatile shipUint32& dest, shipUint32 exchangeValue, shipUint32 comperand);
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicExchange(volatile shipUint32& target, shipUint32 value);
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicAdd(volatile shipUint32& target, shipUint32 value);
-    shipUint32 SHIPYARD_SYSTEM_API InternalAtomicSubtract(volatile shipUint32& target, shipUint32 value);
-
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicIncrement(volatile shipUint64& val);
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicDecrement(volatile shipUint64& val);
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicCompareExchange(volatile shipUint64& dest, shipUint64 exchangeValue, shipUint64 comperand);
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicExchange(volatile shipUint64& target, shipUint64 value);
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicAdd(volatile shipUint64& target, shipUint64 value);
-    shipUint64 SHIPYARD_SYSTEM_API InternalAtomicSubtract(volatile shipUint64& target, shipUint64 value);
-
-#if PLATFORM == PLATFORM_WINDOWS
+    // Same meaning as std::memory_order. Loads can't be Release or AcquireRelease, stores can't be Acquire or AcquireRelease.
+    enum class MemoryOrder : shipUint8
+    {
+        Relaxed,
+        Acquire,
+        Release,
+        AcquireRelease,
+        SequentiallyConsistent
+    };
+
+    // Operand of AtomicOperations::CompareExchange128, only available on 64 bits targets.
+    struct SHIP_ALIGN(16) AtomicUint128
+    {
+        shipUint64 low;
+        shipUint64 high;
+    };
+
+    namespace AtomicOperationsInternal
+    {
+        template <size_t Size>
+        struct AtomicIntrinsics
+        {
+            static_assert(Size == 0, "AtomicOperations only support 4 and 8 bytes types");
+        };
+
+#if COMPILER == COMPILER_MSVC
+
+#if !defined(_M_IX86) && !defined(_M_X64) && !defined(_M_ARM64)
+#error "AtomicOperations only support x86, x64 and ARM64 with MSVC"
+#endif // #if !defined(_M_IX86) && !defined(_M_X64) && !defined(_M_ARM64)
+
+        // x86 and x64 loads already have acquire semantics and stores release semantics, only the compiler must not reorder
+        // them. ARM64 reorders plain loads and stores, so ordered ones go through ldar and stlr, which are also sequentially
+        // consistent with each other. The _Interlocked intrinsics are full barriers on every target, so read-modify-write
+        // operations ignore their memory order.
+        template <>
+        struct AtomicIntrinsics<4>
+        {
+            using IntegerType = long;
+
+            static IntegerType Load(const volatile IntegerType* pValue, MemoryOrder memoryOrder)
+            {
+#if defined(_M_ARM64)
+                if (memoryOrder == MemoryOrder::Relaxed)
+                {
+                    return IntegerType(__iso_volatile_load32(reinterpret_cast<const volatile __int32*>(pValue)));
+                }
+
+                return IntegerType(__ldar32(reinterpret_cast<volatile unsigned __int32*>(const_cast<volatile IntegerType*>(pValue))));
+#else
+                IntegerType value = *pValue;
+                _ReadWriteBarrier();
+
+                return value;
+#endif // #if defined(_M_ARM64)
+            }
+
+            static void Store(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+#if defined(_M_ARM64)
+                if (memoryOrder == MemoryOrder::Relaxed)
+                {
+                    __iso_volatile_store32(reinterpret_cast<volatile __int32*>(pTarget), __int32(value));
+                    return;
+                }
+
+                __stlr32(reinterpret_cast<volatile unsigned __int32*>(pTarget), static_cast<unsigned __int32>(value));
+#else
+                // Sequentially consistent stores must not be reordered with later loads, which only a locked instruction does.
+                if (memoryOrder == MemoryOrder::SequentiallyConsistent)
+                {
+                    _InterlockedExchange(pTarget, value);
+                    return;
+                }
+
+                _ReadWriteBarrier();
+                *pTarget = value;
+#endif // #if defined(_M_ARM64)
+            }
+
+            static IntegerType Exchange(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedExchange(pTarget, value);
+            }
+
+            static IntegerType CompareExchange(volatile IntegerType* pDest, IntegerType exchangeValue, IntegerType comperand, MemoryOrder)
+            {
+                return _InterlockedCompareExchange(pDest, exchangeValue, comperand);
+            }
+
+            static IntegerType FetchAdd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedExchangeAdd(pTarget, value);
+            }
+
+            static IntegerType FetchOr(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedOr(pTarget, value);
+            }
+
+            static IntegerType FetchAnd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedAnd(pTarget, value);
+            }
+        };
+
+        template <>
+        struct AtomicIntrinsics<8>
+        {
+            using IntegerType = __int64;
+
+#if CPU_BITS == CPU_BITS_64
+
+            static IntegerType Load(const volatile IntegerType* pValue, MemoryOrder memoryOrder)
+            {
+#if defined(_M_ARM64)
+                if (memoryOrder == MemoryOrder::Relaxed)
+                {
+                    return IntegerType(__iso_volatile_load64(pValue));
+                }
+
+                return IntegerType(__ldar64(reinterpret_cast<volatile unsigned __int64*>(const_cast<volatile IntegerType*>(pValue))));
+#else
+                IntegerType value = *pValue;
+                _ReadWriteBarrier();
+
+                return value;
+#endif // #if defined(_M_ARM64)
+            }
+
+            static void Store(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+#if defined(_M_ARM64)
+                if (memoryOrder == MemoryOrder::Relaxed)
+                {
+                    __iso_volatile_store64(pTarget, value);
+                    return;
+                }
+
+                __stlr64(reinterpret_cast<volatile unsigned __int64*>(pTarget), static_cast<unsigned __int64>(value));
+#else
+                if (memoryOrder == MemoryOrder::SequentiallyConsistent)
+                {
+                    _InterlockedExchange64(pTarget, value);
+                    return;
+                }
+
+                _ReadWriteBarrier();
+                *pTarget = value;
+#endif // #if defined(_M_ARM64)
+            }
+
+            static IntegerType Exchange(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedExchange64(pTarget, value);
+            }
+
+            static IntegerType FetchAdd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedExchangeAdd64(pTarget, value);
+            }
+
+            static IntegerType FetchOr(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedOr64(pTarget, value);
+            }
+
+            static IntegerType FetchAnd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                return _InterlockedAnd64(pTarget, value);
+            }
+
+#else
+
+            // 32 bits targets only have a 64 bits compare exchange, every other operation is built on top of it.
+            static IntegerType Load(const volatile IntegerType* pValue, MemoryOrder)
+            {
+                return _InterlockedCompareExchange64(const_cast<volatile IntegerType*>(pValue), 0, 0);
+            }
+
+            static void Store(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                Exchange(pTarget, value, memoryOrder);
+            }
+
+            static IntegerType Exchange(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                IntegerType initialValue = *pTarget;
+                IntegerType previousValue;
+
+                while ((previousValue = _InterlockedCompareExchange64(pTarget, value, initialValue)) != initialValue)
+                {
+                    initialValue = previousValue;
+                }
+
+                return initialValue;
+            }
+
+            static IntegerType FetchAdd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                IntegerType initialValue = *pTarget;
+                IntegerType previousValue;
+
+                while ((previousValue = _InterlockedCompareExchange64(pTarget, initialValue + value, initialValue)) != initialValue)
+                {
+                    initialValue = previousValue;
+                }
+
+                return initialValue;
+            }
+
+            static IntegerType FetchOr(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                IntegerType initialValue = *pTarget;
+                IntegerType previousValue;
+
+                while ((previousValue = _InterlockedCompareExchange64(pTarget, initialValue | value, initialValue)) != initialValue)
+                {
+                    initialValue = previousValue;
+                }
+
+                return initialValue;
+            }
+
+            static IntegerType FetchAnd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder)
+            {
+                IntegerType initialValue = *pTarget;
+                IntegerType previousValue;
+
+                while ((previousValue = _InterlockedCompareExchange64(pTarget, initialValue & value, initialValue)) != initialValue)
+                {
+                    initialValue = previousValue;
+                }
+
+                return initialValue;
+            }
+
+#endif // #if CPU_BITS == CPU_BITS_64
+
+            static IntegerType CompareExchange(volatile IntegerType* pDest, IntegerType exchangeValue, IntegerType comperand, MemoryOrder)
+            {
+                return _InterlockedCompareExchange64(pDest, exchangeValue, comperand);
+            }
+        };
+
+#if CPU_BITS == CPU_BITS_64
+        SHIP_INLINE shipBool CompareExchange128(volatile AtomicUint128* pDest, const AtomicUint128& exchangeValue, AtomicUint128* pComperand)
+        {
+            return (_InterlockedCompareExchange128(
+                    reinterpret_cast<volatile __int64*>(pDest),
+                    __int64(exchangeValue.high),
+                    __int64(exchangeValue.low),
+                    reinterpret_cast<__int64*>(pComperand)) != 0);
+        }
+#endif // #if CPU_BITS == CPU_BITS_64
+
+#elif COMPILER == COMPILER_GNUC
+
+        constexpr int GetGnucMemoryOrder(MemoryOrder memoryOrder)
+        {
+            return (memoryOrder == MemoryOrder::Relaxed) ? __ATOMIC_RELAXED :
+                   (memoryOrder == MemoryOrder::Acquire) ? __ATOMIC_ACQUIRE :
+                   (memoryOrder == MemoryOrder::Release) ? __ATOMIC_RELEASE :
+                   (memoryOrder == MemoryOrder::AcquireRelease) ? __ATOMIC_ACQ_REL :
+                                                              __ATOMIC_SEQ_CST;
+        }
+
+        // The order used when a compare exchange fails, which can't have release semantics.
+        constexpr int GetGnucFailureMemoryOrder(MemoryOrder memoryOrder)
+        {
+            return (memoryOrder == MemoryOrder::Release) ? __ATOMIC_RELAXED :
+                   (memoryOrder == MemoryOrder::AcquireRelease) ? __ATOMIC_ACQUIRE :
+                                                              GetGnucMemoryOrder(memoryOrder);
+        }
+
+        template <typename T>
+        struct GnucAtomicIntrinsics
+        {
+            using IntegerType = T;
+
+            static IntegerType Load(const volatile IntegerType* pValue, MemoryOrder memoryOrder)
+            {
+                return __atomic_load_n(pValue, GetGnucMemoryOrder(memoryOrder));
+            }
+
+            static void Store(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                __atomic_store_n(pTarget, value, GetGnucMemoryOrder(memoryOrder));
+            }
+
+            static IntegerType Exchange(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                return __atomic_exchange_n(pTarget, value, GetGnucMemoryOrder(memoryOrder));
+            }
+
+            static IntegerType CompareExchange(volatile IntegerType* pDest, IntegerType exchangeValue, IntegerType comperand, MemoryOrder memoryOrder)
+            {
+                __atomic_compare_exchange_n(
+                        pDest,
+                        &comperand,
+                        exchangeValue,
+                        false,
+                        GetGnucMemoryOrder(memoryOrder),
+                        GetGnucFailureMemoryOrder(memoryOrder));
+
+                // On failure, comperand was updated with the current value.
+                return comperand;
+            }
+
+            static IntegerType FetchAdd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                return __atomic_fetch_add(pTarget, value, GetGnucMemoryOrder(memoryOrder));
+            }
+
+            static IntegerType FetchOr(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                return __atomic_fetch_or(pTarget, value, GetGnucMemoryOrder(memoryOrder));
+            }
+
+            static IntegerType FetchAnd(volatile IntegerType* pTarget, IntegerType value, MemoryOrder memoryOrder)
+            {
+                return __atomic_fetch_and(pTarget, value, GetGnucMemoryOrder(memoryOrder));
+            }
+        };
+
+        template <> struct AtomicIntrinsics<4> : GnucAtomicIntrinsics<shipUint32> {};
+        template <> struct AtomicIntrinsics<8> : GnucAtomicIntrinsics<shipUint64> {};
+
+#if CPU_BITS == CPU_BITS_64
+        SHIP_INLINE shipBool CompareExchange128(volatile AtomicUint128* pDest, const AtomicUint128& exchangeValue, AtomicUint128* pComperand)
+        {
+#if defined(__x86_64__)
+            // Inlined cmpxchg16b, __atomic_compare_exchange on 128 bits integers goes through libatomic unless -mcx16 is used.
+            shipBool exchanged;
+
+            __asm__ __volatile__(
+                    "lock cmpxchg16b %1\n\t"
+                    "sete %0"
+                    : "=q"(exchanged), "+m"(*pDest), "+a"(pComperand->low), "+d"(pComperand->high)
+                    : "b"(exchangeValue.low), "c"(exchangeValue.high)
+                    : "cc", "memory");
+
+            return exchanged;
+#else
+            return __atomic_compare_exchange(
+                    reinterpret_cast<volatile unsigned __int128*>(pDest),
+                    reinterpret_cast<unsigned __int128*>(pComperand),
+                    reinterpret_cast<const unsigned __int128*>(&exchangeValue),
+                    false,
+                    __ATOMIC_SEQ_CST,
+                    __ATOMIC_SEQ_CST);
+#endif // #if defined(__x86_64__)
+        }
+#endif // #if CPU_BITS == CPU_BITS_64
+
+#else
+#error "Unsupported compiler"
+#endif // #if COMPILER == COMPILER_MSVC
+
+        template <typename T>
+        struct AtomicTraits
+        {
+            static_assert(std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value, "AtomicOperations only support integers, enums and pointers");
+
+            using Intrinsics = AtomicIntrinsics<sizeof(T)>;
+            using IntegerType = typename Intrinsics::IntegerType;
+
+            static volatile IntegerType* GetAddress(volatile T& value)
+            {
+                return reinterpret_cast<volatile IntegerType*>(&value);
+            }
+
+            static const volatile IntegerType* GetAddress(const volatile T& value)
+            {
+                return reinterpret_cast<const volatile IntegerType*>(&value);
+            }
+
+            static IntegerType ToInteger(T value)
+            {
+                return (IntegerType)value;
+            }
+
+            static T FromInteger(IntegerType value)
+            {
+                return (T)value;
+            }
+        };
+    }
 
+    // Atomic operations on naturally aligned 4 and 8 bytes integers, enums and pointers. Everything is inlined, on MSVC through
+    // the _Interlocked intrinsics and on GCC through the __atomic builtins.
+    //
+    // Every operation is sequentially consistent by default, weaker memory orders are only a hint on x86 and x64 for
+    // read-modify-write operations, but they still matter for the compiler and on other architectures.
     struct AtomicOperations
     {
+        template <typename T>
+        static T Load(const volatile T& value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
+        {
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::Load(Traits::GetAddress(value), memoryOrder));
+        }
+
+        template <typename T>
+        static void Store(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
+        {
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            Traits::Intrinsics::Store(Traits::GetAddress(target), Traits::ToInteger(value), memoryOrder);
+        }
+
         // Returns the incremented value
         template <typename T>
-        static T Increment(volatile T& val)
+        static T Increment(volatile T& val, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
         {
-            return InternalAtomicIncrement(val);
+            return T(Add(val, T(1), memoryOrder) + T(1));
         }
 
         // Returns the decremented value
         template <typename T>
-        static T Decrement(volatile T& val)
+        static T Decrement(volatile T& val, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
         {
-            return InternalAtomicDecrement(val);
+            return T(Subtract(val, T(1), memoryOrder) - T(1));
         }
 
         // Equivalent to:
@@ -41,33 +443,73 @@ namespace Shipyard
         // if (dest == comperand) dest = exchangeValue;
         // return oldDest;
         template <typename T>
-        static T CompareExchange(volatile T& dest, T exchangeValue, T comperand)
+        static T CompareExchange(volatile T& dest, T exchangeValue, T comperand, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
+        {
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::CompareExchange(
+                    Traits::GetAddress(dest),
+                    Traits::ToInteger(exchangeValue),
+                    Traits::ToInteger(comperand),
+                    memoryOrder));
+        }
+
+        // Returns the initial value of target
+        template <typename T>
+        static T Exchange(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
         {
-            return InternalAtomicCompareExchange(dest, exchangeValue, comperand);
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::Exchange(Traits::GetAddress(target), Traits::ToInteger(value), memoryOrder));
+        }
+
+        // Returns the initial value of target
+        template <typename T>
+        static T Add(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
+        {
+            static_assert(std::is_integral<T>::value, "AtomicOperations::Add only supports integers");
+
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::FetchAdd(Traits::GetAddress(target), Traits::ToInteger(value), memoryOrder));
         }
 
         // Returns the initial value of target
         template <typename T>
-        static T Exchange(volatile T& target, T value)
+        static T Subtract(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
         {
-            return InternalAtomicExchange(target, value);
+            return Add(target, T(T(0) - value), memoryOrder);
         }
 
         // Returns the initial value of target
         template <typename T>
-        static T Add(volatile T& target, T value)
+        static T Or(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
         {
-            return InternalAtomicAdd(target, value);
+            static_assert(std::is_integral<T>::value, "AtomicOperations::Or only supports integers");
+
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::FetchOr(Traits::GetAddress(target), Traits::ToInteger(value), memoryOrder));
         }
 
         // Returns the initial value of target
         template <typename T>
-        static T Subtract(volatile T& target, T value)
+        static T And(volatile T& target, T value, MemoryOrder memoryOrder = MemoryOrder::SequentiallyConsistent)
+        {
+            static_assert(std::is_integral<T>::value, "AtomicOperations::And only supports integers");
+
+            using Traits = AtomicOperationsInternal::AtomicTraits<T>;
+
+            return Traits::FromInteger(Traits::Intrinsics::FetchAnd(Traits::GetAddress(target), Traits::ToInteger(value), memoryOrder));
+        }
+
+#if CPU_BITS == CPU_BITS_64
+        // Sequentially consistent. Returns true if dest was equal to comperand and was replaced by exchangeValue, otherwise
+        // comperand is updated with the value of dest.
+        static shipBool CompareExchange128(volatile AtomicUint128& dest, const AtomicUint128& exchangeValue, AtomicUint128& comperand)
         {
-            return InternalAtomicSubtract(target, value);
+            return AtomicOperationsInternal::CompareExchange128(&dest, exchangeValue, &comperand);
         }
+#endif // #if CPU_BITS == CPU_BITS_64
     };
-#else
-#error "Unsupported platform"
-#endif // #if PLATFORM == PLATFORM_WINDOWS
-}
\ No newline at end of file
+}
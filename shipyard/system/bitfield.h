@@ -13,6 +13,10 @@ namespace Shipyard
 #   define NUM_BITS_PER_BITFIELD_ELEMENT 32
 #endif // #if CPU_BITS == CPU_BITS_64
 
+    // Large bitfields keep two levels of summary bits on top of their elements: the first level has a bit per element, and the
+    // second level has a bit per first level element. One summary tells which elements have bits set and the other which elements
+    // have bits unset, so that searching for the first bit set or unset only looks at a few elements, whatever the size of the
+    // bitfield. With 64 bits elements, bitfields of up to 262144 bits have a single second level element.
     template <shipUint32 NumBits, size_t alignment = SHIP_CACHE_LINE_SIZE>
     class Bitfield
     {
@@ -26,6 +30,19 @@ namespace Shipyard
 
         static constexpr shipUint32 ms_NumElements = ((NumBits + NUM_BITS_PER_BITFIELD_ELEMENT - 1) / NUM_BITS_PER_BITFIELD_ELEMENT);
 
+        // Small bitfields are scanned faster directly than through summaries.
+        static constexpr shipUint32 ms_MaxNumElementsWithoutSummaries = 4;
+        static constexpr shipBool ms_HasSummaries = (ms_NumElements > ms_MaxNumElementsWithoutSummaries);
+
+        static constexpr shipUint32 ms_NumFirstLevelSummaryElements =
+                ms_HasSummaries ? ((ms_NumElements + NUM_BITS_PER_BITFIELD_ELEMENT - 1) / NUM_BITS_PER_BITFIELD_ELEMENT) : 0;
+        static constexpr shipUint32 ms_NumSecondLevelSummaryElements =
+                ms_HasSummaries ? ((ms_NumFirstLevelSummaryElements + NUM_BITS_PER_BITFIELD_ELEMENT - 1) / NUM_BITS_PER_BITFIELD_ELEMENT) : 0;
+        static constexpr shipUint32 ms_NumElementsPerSummary = (ms_NumFirstLevelSummaryElements + ms_NumSecondLevelSummaryElements);
+
+        // Number of elements needed to store the bitfield and both of its summaries.
+        static constexpr shipUint32 ms_NumStorageElements = (ms_NumElements + 2 * ms_NumElementsPerSummary);
+
     public:
         Bitfield(BaseAllocator* pAllocator = nullptr)
             : m_pAllocator(pAllocator)
@@ -48,7 +65,7 @@ namespace Shipyard
 
         shipBool Create(shipBool setAllBits = false)
         {
-            size_t requiredSize = sizeof(BitfieldType) * ms_NumElements;
+            size_t requiredSize = sizeof(BitfieldType) * ms_NumStorageElements;
 
             m_BitField = reinterpret_cast<BitfieldType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, alignment));
             if (m_BitField == nullptr)
@@ -72,17 +89,29 @@ namespace Shipyard
 
         void Clear()
         {
-            for (shipUint32 i = 0; i < ms_NumElements; i++)
+            FillElements(m_BitField, NumBits, false);
+
+            if (ms_HasSummaries)
             {
-                m_BitField[i] = 0;
+                FillSummary(GetElementsWithBitsSetSummary(), false);
+                FillSummary(GetElementsWithBitsUnsetSummary(), true);
             }
         }
 
         shipBool IsClear() const
         {
-            for (shipUint32 i = 0; i < ms_NumElements; i++)
+            const BitfieldType* pElementsToCheck = m_BitField;
+            shipUint32 numElementsToCheck = ms_NumElements;
+
+            if (ms_HasSummaries)
+            {
+                pElementsToCheck = GetElementsWithBitsSetSummary() + ms_NumFirstLevelSummaryElements;
+                numElementsToCheck = ms_NumSecondLevelSummaryElements;
+            }
+
+            for (shipUint32 i = 0; i < numElementsToCheck; i++)
             {
-                if (m_BitField[i] != 0)
+                if (pElementsToCheck[i] != 0)
                 {
                     return false;
                 }
@@ -96,9 +125,10 @@ namespace Shipyard
             SHIP_ASSERT(bitIndex < NumBits);
 
             shipUint32 elementIndex = bitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
-            shipUint32 bit = bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT;
 
-            m_BitField[elementIndex] |= (BitfieldType(1) << BitfieldType(bit));
+            m_BitField[elementIndex] |= GetBitMask(bitIndex);
+
+            UpdateSummaries(elementIndex);
         }
 
         void UnsetBit(shipUint32 bitIndex)
@@ -106,9 +136,10 @@ namespace Shipyard
             SHIP_ASSERT(bitIndex < NumBits);
 
             shipUint32 elementIndex = bitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
-            shipUint32 bit = bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT;
 
-            m_BitField[elementIndex] &= ~(BitfieldType(1) << BitfieldType(bit));
+            m_BitField[elementIndex] &= ~GetBitMask(bitIndex);
+
+            UpdateSummaries(elementIndex);
         }
 
         shipBool IsBitSet(shipUint32 bitIndex) const
@@ -116,103 +147,73 @@ namespace Shipyard
             SHIP_ASSERT(bitIndex < NumBits);
 
             shipUint32 elementIndex = bitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
-            shipUint32 bit = bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT;
 
-            return ((m_BitField[elementIndex] & (BitfieldType(1) << BitfieldType(bit))) > 0);
+            return ((m_BitField[elementIndex] & GetBitMask(bitIndex)) != 0);
         }
 
         void SetRange(shipUint32 startingBitIndexInclusive, shipUint32 endingBitIndexInclusive)
         {
-            SHIP_ASSERT(startingBitIndexInclusive < NumBits);
+            SHIP_ASSERT(startingBitIndexInclusive <= endingBitIndexInclusive);
             SHIP_ASSERT(endingBitIndexInclusive < NumBits);
 
             shipUint32 startingElementIndex = startingBitIndexInclusive / NUM_BITS_PER_BITFIELD_ELEMENT;
             shipUint32 endingElementIndex = endingBitIndexInclusive / NUM_BITS_PER_BITFIELD_ELEMENT;
 
-            shipBool rangeInSingleElement = (startingBitIndexInclusive == endingElementIndex);
+            BitfieldType maskOfBitsFromStart = GetMaskOfBitsFrom(startingBitIndexInclusive);
+            BitfieldType maskOfBitsUpToEnd = GetMaskOfBitsUpTo(endingBitIndexInclusive);
+
+            shipBool rangeInSingleElement = (startingElementIndex == endingElementIndex);
             if (rangeInSingleElement)
             {
-                BitfieldType maskOfBitsSetBeforeStart = ((BitfieldType(1) << BitfieldType(startingBitIndexInclusive)) - 1);
-
-                BitfieldType bitfieldAtEndingBit = (BitfieldType(1) << BitfieldType(endingBitIndexInclusive));
-                BitfieldType maskOfBitsSetBeforeEnd = ((bitfieldAtEndingBit - 1) | bitfieldAtEndingBit);
-
-                BitfieldType maskOfBitsToSet = (maskOfBitsSetBeforeStart ^ maskOfBitsSetBeforeEnd);
-
-                m_BitField[startingElementIndex] |= maskOfBitsToSet;
+                m_BitField[startingElementIndex] |= (maskOfBitsFromStart & maskOfBitsUpToEnd);
+                UpdateSummaries(startingElementIndex);
             }
             else
             {
-                shipUint32 elementIndex = startingElementIndex;
-
-                BitfieldType maskOfBitsToSet = ~((BitfieldType(1) << BitfieldType(startingBitIndexInclusive)) - 1);
-                m_BitField[elementIndex] |= maskOfBitsToSet;
+                m_BitField[startingElementIndex] |= maskOfBitsFromStart;
+                UpdateSummaries(startingElementIndex);
 
-                elementIndex += 1;
-
-                for (; elementIndex <= endingElementIndex; elementIndex++)
+                for (shipUint32 elementIndex = startingElementIndex + 1; elementIndex < endingElementIndex; elementIndex++)
                 {
-                    shipBool setFullRange = (elementIndex < endingElementIndex);
-
-                    if (setFullRange)
-                    {
-                        m_BitField[elementIndex] |= BitfieldType(-1);
-                    }
-                    else
-                    {
-                        BitfieldType bitfieldAtEndingBit = (BitfieldType(1) << BitfieldType(endingBitIndexInclusive));
-                        maskOfBitsToSet = ((bitfieldAtEndingBit - 1) | bitfieldAtEndingBit);
-
-                        m_BitField[elementIndex] |= maskOfBitsToSet;
-                    }
+                    m_BitField[elementIndex] = BitfieldType(-1);
+                    UpdateSummaries(elementIndex);
                 }
+
+                m_BitField[endingElementIndex] |= maskOfBitsUpToEnd;
+                UpdateSummaries(endingElementIndex);
             }
         }
 
         void UnsetRange(shipUint32 startingBitIndexInclusive, shipUint32 endingBitIndexInclusive)
         {
-            SHIP_ASSERT(startingBitIndexInclusive < NumBits);
+            SHIP_ASSERT(startingBitIndexInclusive <= endingBitIndexInclusive);
             SHIP_ASSERT(endingBitIndexInclusive < NumBits);
 
             shipUint32 startingElementIndex = startingBitIndexInclusive / NUM_BITS_PER_BITFIELD_ELEMENT;
             shipUint32 endingElementIndex = endingBitIndexInclusive / NUM_BITS_PER_BITFIELD_ELEMENT;
 
-            shipBool rangeInSingleElement = (startingBitIndexInclusive == endingElementIndex);
+            BitfieldType maskOfBitsFromStart = GetMaskOfBitsFrom(startingBitIndexInclusive);
+            BitfieldType maskOfBitsUpToEnd = GetMaskOfBitsUpTo(endingBitIndexInclusive);
+
+            shipBool rangeInSingleElement = (startingElementIndex == endingElementIndex);
             if (rangeInSingleElement)
             {
-                BitfieldType maskOfBitsSetBeforeStart = ((BitfieldType(1) << BitfieldType(startingBitIndexInclusive)) - 1);
-
-                BitfieldType bitfieldAtEndingBit = (BitfieldType(1) << BitfieldType(endingBitIndexInclusive));
-                BitfieldType maskOfBitsSetBeforeEnd = ((bitfieldAtEndingBit - 1) | bitfieldAtEndingBit);;
-
-                BitfieldType maskOfBitsToSet = (maskOfBitsSetBeforeStart ^ maskOfBitsSetBeforeEnd);
-
-                m_BitField[startingElementIndex] &= ~maskOfBitsToSet;
+                m_BitField[startingElementIndex] &= ~(maskOfBitsFromStart & maskOfBitsUpToEnd);
+                UpdateSummaries(startingElementIndex);
             }
             else
             {
-                shipUint32 elementIndex = startingElementIndex;
-
-                BitfieldType maskOfBitsToSet = ~((BitfieldType(1) << BitfieldType(startingBitIndexInclusive)) - 1);
-                m_BitField[elementIndex] &= ~maskOfBitsToSet;
+                m_BitField[startingElementIndex] &= ~maskOfBitsFromStart;
+                UpdateSummaries(startingElementIndex);
 
-                elementIndex += 1;
-
-                for (; elementIndex <= endingElementIndex; elementIndex++)
+                for (shipUint32 elementIndex = startingElementIndex + 1; elementIndex < endingElementIndex; elementIndex++)
                 {
-                    shipBool unsetFullRange = (elementIndex < endingElementIndex);
-                    if (unsetFullRange)
-                    {
-                        m_BitField[elementIndex] &= 0;
-                    }
-                    else
-                    {
-                        BitfieldType bitfieldAtEndingBit = (BitfieldType(1) << BitfieldType(endingBitIndexInclusive));
-                        maskOfBitsToSet = ((bitfieldAtEndingBit - 1) | bitfieldAtEndingBit);
-
-                        m_BitField[elementIndex] &= ~maskOfBitsToSet;
-                    }
+                    m_BitField[elementIndex] = 0;
+                    UpdateSummaries(elementIndex);
                 }
+
+                m_BitField[endingElementIndex] &= ~maskOfBitsUpToEnd;
+                UpdateSummaries(endingElementIndex);
             }
         }
 
@@ -220,150 +221,277 @@ namespace Shipyard
         // Returns false if a bit set to 1 after the starting bit index, including it, couldn't be found.
         shipBool GetFirstBitSet(shipUint32 startingBitIndex, shipUint32& firstBitSet) const
         {
-            SHIP_ASSERT(startingBitIndex < NumBits);
+            constexpr shipBool lookForBitsSet = true;
+            return FindFirstBit(startingBitIndex, lookForBitsSet, firstBitSet);
+        }
 
-            shipUint32 elementIndex = startingBitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
-            
-            BitfieldType maskOfEveryBitsBeforeCleared = ~((BitfieldType(1) << BitfieldType(startingBitIndex)) - 1);
+        // Finds the index of the first bit set to 0, starting from the specified bit index.
+        // Returns false if a bit set to 0 after the starting bit index, including it, couldn't be found.
+        shipBool GetFirstBitUnset(shipUint32 startingBitIndex, shipUint32& firstBitUnset) const
+        {
+            constexpr shipBool lookForBitsSet = false;
+            return FindFirstBit(startingBitIndex, lookForBitsSet, firstBitUnset);
+        }
+
+        // Basically counts the number of bits set to 1 starting at the bit representing the given starting bit index.
+        // Returns 0 if the starting bit is set to 0.
+        shipUint32 GetLongestRangeWithBitsSet(shipUint32 startingBitIndex) const
+        {
+            shipUint32 firstBitUnset = 0;
+            if (!GetFirstBitUnset(startingBitIndex, firstBitUnset))
+            {
+                return (NumBits - startingBitIndex);
+            }
 
-            unsigned long bitScanResult = (unsigned long)startingBitIndex;
+            return (firstBitUnset - startingBitIndex);
+        }
 
-#if COMPILER == COMPILER_MSVC
+        shipUint32 GetNumBitsSet() const
+        {
+            shipUint32 numBitsSet = 0;
 
-            for (; elementIndex < ms_NumElements; elementIndex++)
+            for (shipUint32 elementIndex = 0; elementIndex < ms_NumElements; elementIndex++)
             {
-                BitfieldType maskForScan = (m_BitField[elementIndex] & maskOfEveryBitsBeforeCleared);
+                numBitsSet += Shipyard::GetNumBitsSet(m_BitField[elementIndex]);
+            }
 
-                unsigned char foundValue = FindFirstBitSet(&bitScanResult, maskForScan);
+            return numBitsSet;
+        }
 
-                shipBool foundBitSet = (foundValue != 0);
+        void SetAllBits()
+        {
+            FillElements(m_BitField, NumBits, true);
 
-                if (foundBitSet)
-                {
-                    firstBitSet = shipUint32(bitScanResult) + elementIndex * NUM_BITS_PER_BITFIELD_ELEMENT;
-                    return true;
-                }
-                else
+            if (ms_HasSummaries)
+            {
+                FillSummary(GetElementsWithBitsSetSummary(), true);
+                FillSummary(GetElementsWithBitsUnsetSummary(), false);
+            }
+        }
+
+        // Assumed to be at least sizeof(BitfieldType) * ms_NumStorageElements bytes. Clear or SetAllBits must be called before
+        // using the bitfield.
+        void SetUserPointer(BitfieldType* pUserPtr)
+        {
+            if (m_MemoryOwned)
+            {
+                SHIP_FREE_EX(m_pAllocator, m_BitField);
+            }
+
+            m_BitField = pUserPtr;
+
+            m_MemoryOwned = false;
+        }
+
+        void SetAllocator(BaseAllocator* pAllocator)
+        {
+            if (pAllocator == m_pAllocator)
+            {
+                return;
+            }
+
+            if (m_MemoryOwned)
+            {
+                size_t requiredSize = sizeof(BitfieldType) * ms_NumStorageElements;
+                BitfieldType* pNewBitfield = reinterpret_cast<BitfieldType*>(SHIP_ALLOC_EX(pAllocator, requiredSize, alignment));
+
+                for (shipUint32 i = 0; i < ms_NumStorageElements; i++)
                 {
-                    maskOfEveryBitsBeforeCleared = BitfieldType(-1);
+                    pNewBitfield[i] = m_BitField[i];
                 }
+
+                SHIP_FREE_EX(m_pAllocator, m_BitField);
+
+                m_BitField = pNewBitfield;
             }
-#else
 
-#pragma error "Implement using intrinsic for bit scanning for specific compiler"
+            m_pAllocator = pAllocator;
+        }
 
-#endif // #if COMPILER == COMPILER_MSVC
+    private:
+        static BitfieldType GetBitMask(shipUint32 bitIndex)
+        {
+            return (BitfieldType(1) << BitfieldType(bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT));
+        }
 
-            return false;
+        // Mask of the bits of the element containing the given bit, starting at that bit.
+        static BitfieldType GetMaskOfBitsFrom(shipUint32 bitIndex)
+        {
+            return (BitfieldType(-1) << BitfieldType(bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT));
         }
 
-        // Basically counts the number of bits set to 1 starting at the bit representing the given starting bit index.
-        // The starting bit is assumed to be set to 1 in the bitfield.
-        shipUint32 GetLongestRangeWithBitsSet(shipUint32 startingBitIndex) const
+        // Mask of the bits of the element containing the given bit, up to that bit, including it.
+        static BitfieldType GetMaskOfBitsUpTo(shipUint32 bitIndex)
         {
-            SHIP_ASSERT(startingBitIndex < NumBits);
+            return (BitfieldType(-1) >> BitfieldType(NUM_BITS_PER_BITFIELD_ELEMENT - 1 - (bitIndex % NUM_BITS_PER_BITFIELD_ELEMENT)));
+        }
 
-            shipUint32 elementIndex = startingBitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
-            
-            BitfieldType maskOfEveryBitsBeforeSet = ((BitfieldType(1) << BitfieldType(startingBitIndex)) - 1);
+        // The last element may have bits past NumBits, which are always 0.
+        static BitfieldType GetMaskOfValidBits(shipUint32 elementIndex)
+        {
+            return ((elementIndex == ms_NumElements - 1) ? GetMaskOfBitsUpTo(NumBits - 1) : BitfieldType(-1));
+        }
 
-            shipUint32 numBitsSet = 0;
-            shipUint32 bitIndexInFirstElementToSearch = startingBitIndex;
+        // Sets the first numBits bits of the elements to 1 and the rest to 0, or all of them to 0.
+        static void FillElements(BitfieldType* pElements, shipUint32 numBits, shipBool setBits)
+        {
+            shipUint32 numElements = ((numBits + NUM_BITS_PER_BITFIELD_ELEMENT - 1) / NUM_BITS_PER_BITFIELD_ELEMENT);
 
-#if COMPILER == COMPILER_MSVC
-            for (; elementIndex < ms_NumElements; elementIndex++)
+            BitfieldType fillValue = (setBits ? BitfieldType(-1) : BitfieldType(0));
+            for (shipUint32 i = 0; i < numElements - 1; i++)
             {
-                // Here, we reverse our bitfield, and scan for the first bit set to 1. This will be our first bit set to 0, which
-                // will tell us the end of our continous range of bits set to 1.
-                BitfieldType maskForScan = ~(m_BitField[elementIndex] | maskOfEveryBitsBeforeSet);
-
-                unsigned long firstBitSet = 0;
-                unsigned char foundValue = FindFirstBitSet(&firstBitSet, maskForScan);
+                pElements[i] = fillValue;
+            }
 
-                shipBool foundBitSet = (foundValue != 0);
+            pElements[numElements - 1] = (fillValue & GetMaskOfBitsUpTo(numBits - 1));
+        }
 
-                if (foundBitSet)
-                {
-                    numBitsSet = shipUint32(firstBitSet) + NUM_BITS_PER_BITFIELD_ELEMENT * elementIndex - bitIndexInFirstElementToSearch;
-                    break;
-                }
-                else
-                {
-                    maskOfEveryBitsBeforeSet = 0;
-                    numBitsSet += (NUM_BITS_PER_BITFIELD_ELEMENT - startingBitIndex);
+        static void FillSummary(BitfieldType* pSummary, shipBool setBits)
+        {
+            FillElements(pSummary, ms_NumElements, setBits);
+            FillElements(pSummary + ms_NumFirstLevelSummaryElements, ms_NumFirstLevelSummaryElements, setBits);
+        }
 
-                    startingBitIndex = 0;
-                }
-            }
-#else
+        static void SetSummaryBit(BitfieldType* pSummary, shipUint32 elementIndex, shipBool isSet)
+        {
+            shipUint32 firstLevelIndex = elementIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
+            BitfieldType& firstLevelElement = pSummary[firstLevelIndex];
 
-#pragma error "Implement using intrinsic for bit counting for specific compiler"
+            BitfieldType firstLevelBitMask = GetBitMask(elementIndex);
+            firstLevelElement = (isSet ? (firstLevelElement | firstLevelBitMask) : (firstLevelElement & ~firstLevelBitMask));
 
-#endif // #if COMPILER == COMPILER_MSVC
+            BitfieldType& secondLevelElement = pSummary[ms_NumFirstLevelSummaryElements + firstLevelIndex / NUM_BITS_PER_BITFIELD_ELEMENT];
 
-            return numBitsSet;
+            BitfieldType secondLevelBitMask = GetBitMask(firstLevelIndex);
+            secondLevelElement = ((firstLevelElement != 0) ? (secondLevelElement | secondLevelBitMask) : (secondLevelElement & ~secondLevelBitMask));
         }
 
-        void SetAllBits()
+        // Finds the first element, starting at the given element index, with its summary bit set.
+        static shipBool FindFirstElementInSummary(const BitfieldType* pSummary, shipUint32 elementIndex, shipUint32& foundElementIndex)
         {
-            shipUint32 remainingBitsToSet = (NumBits - (ms_NumElements - 1) * NUM_BITS_PER_BITFIELD_ELEMENT);
+            if (elementIndex >= ms_NumElements)
+            {
+                return false;
+            }
 
-            for (shipUint32 elementIndex = 0; elementIndex < ms_NumElements; elementIndex++)
+            shipUint32 firstLevelIndex = elementIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
+            BitfieldType firstLevelElement = (pSummary[firstLevelIndex] & GetMaskOfBitsFrom(elementIndex));
+
+            if (firstLevelElement == 0)
             {
-                if (elementIndex != (ms_NumElements - 1))
+                firstLevelIndex += 1;
+                if (firstLevelIndex == ms_NumFirstLevelSummaryElements)
                 {
-                    m_BitField[elementIndex] = BitfieldType(-1);
+                    return false;
                 }
-                else
+
+                const BitfieldType* pSecondLevel = (pSummary + ms_NumFirstLevelSummaryElements);
+
+                shipUint32 secondLevelIndex = firstLevelIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
+                BitfieldType secondLevelElement = (pSecondLevel[secondLevelIndex] & GetMaskOfBitsFrom(firstLevelIndex));
+
+                while (secondLevelElement == 0)
                 {
-                    if (remainingBitsToSet == NUM_BITS_PER_BITFIELD_ELEMENT)
+                    secondLevelIndex += 1;
+                    if (secondLevelIndex == ms_NumSecondLevelSummaryElements)
                     {
-                        m_BitField[elementIndex] = BitfieldType(-1);
-                    }
-                    else
-                    {
-                        m_BitField[elementIndex] = ((BitfieldType(1) << remainingBitsToSet) - 1);
+                        return false;
                     }
+
+                    secondLevelElement = pSecondLevel[secondLevelIndex];
                 }
+
+                firstLevelIndex = secondLevelIndex * NUM_BITS_PER_BITFIELD_ELEMENT + GetLowestBitSetIndex(secondLevelElement);
+                firstLevelElement = pSummary[firstLevelIndex];
             }
+
+            foundElementIndex = firstLevelIndex * NUM_BITS_PER_BITFIELD_ELEMENT + GetLowestBitSetIndex(firstLevelElement);
+
+            return true;
         }
 
-        // Assumed to be at least sizeof(BitfieldType) * ms_NumElements bytes.
-        void SetUserPointer(BitfieldType* pUserPtr)
+        BitfieldType* GetElementsWithBitsSetSummary()
         {
-            if (m_MemoryOwned)
-            {
-                SHIP_FREE_EX(m_pAllocator, m_BitField);
-            }
+            return (m_BitField + ms_NumElements);
+        }
 
-            m_BitField = pUserPtr;
+        const BitfieldType* GetElementsWithBitsSetSummary() const
+        {
+            return (m_BitField + ms_NumElements);
+        }
 
-            m_MemoryOwned = false;
+        BitfieldType* GetElementsWithBitsUnsetSummary()
+        {
+            return (m_BitField + ms_NumElements + ms_NumElementsPerSummary);
         }
 
-        void SetAllocator(BaseAllocator* pAllocator)
+        const BitfieldType* GetElementsWithBitsUnsetSummary() const
         {
-            if (pAllocator == m_pAllocator)
+            return (m_BitField + ms_NumElements + ms_NumElementsPerSummary);
+        }
+
+        void UpdateSummaries(shipUint32 elementIndex)
+        {
+            if (!ms_HasSummaries)
             {
                 return;
             }
 
-            if (m_MemoryOwned)
+            BitfieldType element = m_BitField[elementIndex];
+
+            SetSummaryBit(GetElementsWithBitsSetSummary(), elementIndex, (element != 0));
+            SetSummaryBit(GetElementsWithBitsUnsetSummary(), elementIndex, (element != GetMaskOfValidBits(elementIndex)));
+        }
+
+        // Returns the bits of the element that are searched for, as 1s.
+        BitfieldType GetBitsToScan(shipUint32 elementIndex, shipBool lookForBitsSet) const
+        {
+            BitfieldType element = m_BitField[elementIndex];
+            return (lookForBitsSet ? element : (~element & GetMaskOfValidBits(elementIndex)));
+        }
+
+        shipBool FindFirstBit(shipUint32 startingBitIndex, shipBool lookForBitsSet, shipUint32& foundBitIndex) const
+        {
+            SHIP_ASSERT(startingBitIndex < NumBits);
+
+            shipUint32 elementIndex = startingBitIndex / NUM_BITS_PER_BITFIELD_ELEMENT;
+            BitfieldType bitsToScan = (GetBitsToScan(elementIndex, lookForBitsSet) & GetMaskOfBitsFrom(startingBitIndex));
+
+            if (bitsToScan == 0)
             {
-                size_t requiredSize = sizeof(BitfieldType) * ms_NumElements;
-                BitfieldType* pNewBitfield = reinterpret_cast<BitfieldType*>(SHIP_ALLOC_EX(pAllocator, requiredSize, alignment));
+                elementIndex += 1;
 
-                for (shipUint32 i = 0; i < ms_NumElements; i++)
+                if (ms_HasSummaries)
                 {
-                    pNewBitfield[i] = m_BitField[i];
-                }
+                    const BitfieldType* pSummary = (lookForBitsSet ? GetElementsWithBitsSetSummary() : GetElementsWithBitsUnsetSummary());
+                    if (!FindFirstElementInSummary(pSummary, elementIndex, elementIndex))
+                    {
+                        return false;
+                    }
 
-                SHIP_FREE_EX(m_pAllocator, m_BitField);
+                    bitsToScan = GetBitsToScan(elementIndex, lookForBitsSet);
+                }
+                else
+                {
+                    for (; elementIndex < ms_NumElements; elementIndex++)
+                    {
+                        bitsToScan = GetBitsToScan(elementIndex, lookForBitsSet);
+                        if (bitsToScan != 0)
+                        {
+                            break;
+                        }
+                    }
 
-                m_BitField = pNewBitfield;
+                    if (elementIndex == ms_NumElements)
+                    {
+                        return false;
+                    }
+                }
             }
 
-            m_pAllocator = pAllocator;
+            foundBitIndex = elementIndex * NUM_BITS_PER_BITFIELD_ELEMENT + GetLowestBitSetIndex(bitsToScan);
+
+            return true;
         }
 
     private:
@@ -391,6 +519,6 @@ namespace Shipyard
         }
 
     private:
-        BitfieldType m_StackBitfield[ms_NumElements];
+        BitfieldType m_StackBitfield[ms_NumStorageElements];
     };
 }
\ No newline at end of file
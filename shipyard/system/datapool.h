@@ -5,15 +5,18 @@
 #include <math/mathutilities.h>
 
 #include <system/array.h>
+#include <system/atomicoperations.h>
 #include <system/bitfield.h>
 
+#include <mutex>
+
 namespace Shipyard
 {
     // To be used for a maximum sized array where objects must be as contiguous as possible.
     // With the use of a bitfield, the container will prioritize empty locations that are closest
     // to the beginning of the internal array.
     //
-    // Allocated size is floor(MaxElementsInPool / 64) * sizeof(Bitfield::BitfieldType) bytes due to the bitfield + MaxElementsInPool * sizeof(T) bytes.
+    // Allocated size is Bitfield::ms_NumStorageElements * sizeof(Bitfield::BitfieldType) bytes due to the bitfield and its summaries + MaxElementsInPool * sizeof(T) bytes.
     //
     // The rationale behind returning indices in the pool instead of pointers is that
     // shipUint32 can access the full range of the array without wasting another 4 bytes
@@ -334,4 +337,619 @@ namespace Shipyard
         T* m_Datas;
         shipUint32 m_LastFreeIndex;
     };
+
+    // Thread-safe version of GenerationalDataPool: items can be created and released from any thread at the same time.
+    //
+    // Free indices are kept in a lock-free stack. Its head is tagged with a counter that changes on every push and pop, so that
+    // an index popped and pushed back by another thread between the read of the head and the compare exchange is detected.
+    //
+    // Each slot has a generation counter incremented atomically when the slot is allocated and when it is released, which
+    // makes allocated slots the ones with odd counters. Generations handed out are the counter divided by two.
+    //
+    // Unlike GenerationalDataPool, the most recently released index is reused first, and iterating over the allocated items
+    // scans every slot. Iteration must not run at the same time as items are created or released.
+    template<typename T, shipUint32 MaxElementsInPool, size_t alignment = 1>
+    class ConcurrentGenerationalDataPool
+    {
+    public:
+        static const shipUint32 InvalidDataPoolIndex = shipUint32(-1);
+        using GenerationType = shipUint16;
+
+    public:
+        ConcurrentGenerationalDataPool(BaseAllocator* pAllocator = nullptr)
+            : m_pAllocator(pAllocator)
+            , m_GenerationCounters(nullptr)
+            , m_NextFreeIndices(nullptr)
+            , m_Datas(nullptr)
+            , m_FreeListHead(MakeFreeListHead(InvalidDataPoolIndex, 0))
+            , m_NumAllocatedItems(0)
+        {
+            if (pAllocator == nullptr)
+            {
+                m_pAllocator = &GetGlobalAllocator();
+            }
+        }
+
+        ~ConcurrentGenerationalDataPool()
+        {
+            SHIP_ASSERT_MSG(m_NumAllocatedItems == 0, "DataPool 0x%p elements were not all freed.", this);
+
+            SHIP_FREE_EX(m_pAllocator, const_cast<shipUint32*>(m_NextFreeIndices));
+            SHIP_FREE_EX(m_pAllocator, const_cast<shipUint32*>(m_GenerationCounters));
+            SHIP_FREE_EX(m_pAllocator, m_Datas);
+        }
+
+        shipBool Create()
+        {
+            size_t requiredSizeForPool = MaxElementsInPool * sizeof(T);
+
+            m_Datas = reinterpret_cast<T*>(SHIP_ALLOC_EX(m_pAllocator, requiredSizeForPool, alignment));
+            if (m_Datas == nullptr)
+            {
+                return false;
+            }
+
+            m_GenerationCounters = reinterpret_cast<volatile shipUint32*>(SHIP_ALLOC_EX(m_pAllocator, MaxElementsInPool * sizeof(shipUint32), sizeof(shipUint32)));
+            if (m_GenerationCounters == nullptr)
+            {
+                SHIP_FREE_EX(m_pAllocator, m_Datas);
+                m_Datas = nullptr;
+
+                return false;
+            }
+
+            m_NextFreeIndices = reinterpret_cast<volatile shipUint32*>(SHIP_ALLOC_EX(m_pAllocator, MaxElementsInPool * sizeof(shipUint32), sizeof(shipUint32)));
+            if (m_NextFreeIndices == nullptr)
+            {
+                SHIP_FREE_EX(m_pAllocator, const_cast<shipUint32*>(m_GenerationCounters));
+                SHIP_FREE_EX(m_pAllocator, m_Datas);
+                m_GenerationCounters = nullptr;
+                m_Datas = nullptr;
+
+                return false;
+            }
+
+            for (shipUint32 i = 0; i < MaxElementsInPool; i++)
+            {
+                m_GenerationCounters[i] = 0;
+                m_NextFreeIndices[i] = ((i + 1) < MaxElementsInPool) ? (i + 1) : InvalidDataPoolIndex;
+            }
+
+            m_FreeListHead = MakeFreeListHead(0, 0);
+
+            return true;
+        }
+
+        shipUint32 GetNewItemIndex(GenerationType* newItemGeneration)
+        {
+            shipUint64 freeListHead = AtomicOperations::Load(m_FreeListHead, MemoryOrder::Acquire);
+            shipUint32 newItemIndex = InvalidDataPoolIndex;
+
+            for (;;)
+            {
+                newItemIndex = GetFreeListHeadIndex(freeListHead);
+                if (newItemIndex == InvalidDataPoolIndex)
+                {
+                    SHIP_ASSERT_MSG(false, "Trying to get a new element from an empty data pool 0x%p with maximum size %u", this, MaxElementsInPool);
+                    return InvalidDataPoolIndex;
+                }
+
+                // The next index may have been changed by another thread that popped newItemIndex in the meantime, in which
+                // case the tag of the head changed as well and the compare exchange fails.
+                shipUint64 newFreeListHead = MakeFreeListHead(m_NextFreeIndices[newItemIndex], GetFreeListHeadTag(freeListHead) + 1);
+
+                shipUint64 previousFreeListHead = AtomicOperations::CompareExchange(m_FreeListHead, newFreeListHead, freeListHead);
+                if (previousFreeListHead == freeListHead)
+                {
+                    break;
+                }
+
+                freeListHead = previousFreeListHead;
+            }
+
+            new (m_Datas + newItemIndex)T();
+
+            shipUint32 generationCounter = AtomicOperations::Increment(m_GenerationCounters[newItemIndex]);
+            *newItemGeneration = GetGeneration(generationCounter);
+
+            AtomicOperations::Increment(m_NumAllocatedItems);
+
+            return newItemIndex;
+        }
+
+        shipBool GetFirstAllocatedIndex(shipUint32* firstAllocatedIndex, GenerationType* firstAllocatedGeneration) const
+        {
+            return FindAllocatedIndex(0, firstAllocatedIndex, firstAllocatedGeneration);
+        }
+
+        shipBool GetNextAllocatedIndex(shipUint32 currentIndex, shipUint32* nextAllocatedIndex, GenerationType* nextAllocationGeneration) const
+        {
+            return FindAllocatedIndex(currentIndex + 1, nextAllocatedIndex, nextAllocationGeneration);
+        }
+
+        void ReleaseItem(shipUint32 index)
+        {
+            SHIP_ASSERT_MSG(IsAllocated(m_GenerationCounters[index]), "Releasing index %u more than once for data pool 0x%p", index, this);
+
+            m_Datas[index].~T();
+
+            AtomicOperations::Increment(m_GenerationCounters[index]);
+            AtomicOperations::Decrement(m_NumAllocatedItems);
+
+            shipUint64 freeListHead = AtomicOperations::Load(m_FreeListHead, MemoryOrder::Acquire);
+
+            for (;;)
+            {
+                m_NextFreeIndices[index] = GetFreeListHeadIndex(freeListHead);
+
+                shipUint64 newFreeListHead = MakeFreeListHead(index, GetFreeListHeadTag(freeListHead) + 1);
+
+                shipUint64 previousFreeListHead = AtomicOperations::CompareExchange(m_FreeListHead, newFreeListHead, freeListHead);
+                if (previousFreeListHead == freeListHead)
+                {
+                    break;
+                }
+
+                freeListHead = previousFreeListHead;
+            }
+        }
+
+        T& GetItem(shipUint32 index, GenerationType generation)
+        {
+            ValidateItemAccess(index, generation);
+            return m_Datas[index];
+        }
+
+        const T& GetItem(shipUint32 index, GenerationType generation) const
+        {
+            ValidateItemAccess(index, generation);
+            return m_Datas[index];
+        }
+
+        T* GetItemPtr(shipUint32 index, GenerationType generation)
+        {
+            ValidateItemAccess(index, generation);
+            return &m_Datas[index];
+        }
+
+        const T* GetItemPtr(shipUint32 index, GenerationType generation) const
+        {
+            ValidateItemAccess(index, generation);
+            return &m_Datas[index];
+        }
+
+        shipUint32 GetNumAllocatedItems() const
+        {
+            return m_NumAllocatedItems;
+        }
+
+        shipUint32 GetMaxElementsInPool() const
+        {
+            return MaxElementsInPool;
+        }
+
+    private:
+        static shipUint64 MakeFreeListHead(shipUint32 index, shipUint32 tag)
+        {
+            return ((shipUint64(tag) << 32) | shipUint64(index));
+        }
+
+        static shipUint32 GetFreeListHeadIndex(shipUint64 freeListHead)
+        {
+            return shipUint32(freeListHead);
+        }
+
+        static shipUint32 GetFreeListHeadTag(shipUint64 freeListHead)
+        {
+            return shipUint32(freeListHead >> 32);
+        }
+
+        static shipBool IsAllocated(shipUint32 generationCounter)
+        {
+            return ((generationCounter & 1) != 0);
+        }
+
+        static GenerationType GetGeneration(shipUint32 generationCounter)
+        {
+            return GenerationType(generationCounter >> 1);
+        }
+
+        void ValidateItemAccess(shipUint32 index, GenerationType generation) const
+        {
+            shipUint32 generationCounter = m_GenerationCounters[index];
+
+            SHIP_ASSERT_MSG(IsAllocated(generationCounter), "Accessing index %u that was not previously allocated for data pool 0x%p", index, this);
+            SHIP_ASSERT_MSG(GetGeneration(generationCounter) == generation, "Accessing index %u that was already deleted! Current generation %u, requested generation %u", index, GetGeneration(generationCounter), generation);
+        }
+
+        shipBool FindAllocatedIndex(shipUint32 startingIndex, shipUint32* allocatedIndex, GenerationType* allocatedGeneration) const
+        {
+            for (shipUint32 index = startingIndex; index < MaxElementsInPool; index++)
+            {
+                shipUint32 generationCounter = m_GenerationCounters[index];
+                if (IsAllocated(generationCounter))
+                {
+                    *allocatedIndex = index;
+                    *allocatedGeneration = GetGeneration(generationCounter);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    protected:
+        BaseAllocator* m_pAllocator;
+        volatile shipUint32* m_GenerationCounters;
+        volatile shipUint32* m_NextFreeIndices;
+        T* m_Datas;
+        volatile shipUint64 m_FreeListHead;
+        volatile shipUint32 m_NumAllocatedItems;
+    };
+
+    struct DataPoolStatistics
+    {
+        shipUint32 numAllocatedItems = 0;
+
+        // Items that can be allocated without allocating new memory.
+        shipUint32 capacity = 0;
+
+        // Pages whose elements are allocated, and pages that were freed because they were empty.
+        shipUint32 numResidentPages = 0;
+        shipUint32 numPages = 0;
+
+        size_t residentMemorySize = 0;
+    };
+
+    // GenerationalDataPool that grows by pages of NumElementsPerPage elements allocated on demand, instead of reserving its
+    // maximum size up front. Indices are (pageIndex << ms_PageShift | slotInPage) so that they stay valid as the pool grows.
+    //
+    // The elements of a page are freed when its last item is released, but its generations are kept so that handles to the
+    // released items are still caught. Pages are looked up in a two level page table whose blocks live until the pool is
+    // destroyed, so items can be accessed without locking while other threads create and release items. Creating and
+    // releasing items take a lock, iterating over the allocated items must not happen at the same time.
+    template<typename T, shipUint32 NumElementsPerPage = 64, size_t alignment = 1>
+    class PagedGenerationalDataPool
+    {
+        static_assert((NumElementsPerPage & (NumElementsPerPage - 1)) == 0, "NumElementsPerPage must be a power of two.");
+
+    public:
+        static const shipUint32 InvalidDataPoolIndex = shipUint32(-1);
+        using GenerationType = shipUint16;
+
+        static constexpr shipUint32 ms_PageShift = GetNumBitsForValue(NumElementsPerPage - 1);
+        static constexpr shipUint32 ms_NumPagesPerPageTableBlock = 1024;
+        static constexpr shipUint32 ms_MaxNumPageTableBlocks = 64;
+        static constexpr shipUint32 ms_MaxNumPages = ms_NumPagesPerPageTableBlock * ms_MaxNumPageTableBlocks;
+
+    public:
+        PagedGenerationalDataPool(BaseAllocator* pAllocator = nullptr)
+            : m_pAllocator(pAllocator)
+            , m_NumPages(0)
+            , m_NumResidentPages(0)
+            , m_NumAllocatedItems(0)
+            , m_FirstPageWithFreeSlots(0)
+        {
+            if (pAllocator == nullptr)
+            {
+                m_pAllocator = &GetGlobalAllocator();
+            }
+
+            for (shipUint32 i = 0; i < ms_MaxNumPageTableBlocks; i++)
+            {
+                m_PageTableBlocks[i] = nullptr;
+            }
+        }
+
+        ~PagedGenerationalDataPool()
+        {
+            SHIP_ASSERT_MSG(m_NumAllocatedItems == 0, "DataPool 0x%p elements were not all freed.", this);
+
+            for (shipUint32 pageIndex = 0; pageIndex < m_NumPages; pageIndex++)
+            {
+                Page* pPage = GetPage(pageIndex);
+
+                SHIP_FREE_EX(m_pAllocator, pPage->pDatas);
+                SHIP_DELETE_EX(m_pAllocator, pPage);
+            }
+
+            for (shipUint32 i = 0; i < ms_MaxNumPageTableBlocks; i++)
+            {
+                SHIP_FREE_EX(m_pAllocator, m_PageTableBlocks[i]);
+            }
+        }
+
+        // Nothing is allocated before the first item is created.
+        shipBool Create()
+        {
+            return true;
+        }
+
+        shipUint32 GetNewItemIndex(GenerationType* newItemGeneration)
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+
+            shipUint32 pageIndex = FindPageWithFreeSlots();
+            if (pageIndex == InvalidDataPoolIndex)
+            {
+                pageIndex = AddPage();
+                if (pageIndex == InvalidDataPoolIndex)
+                {
+                    return InvalidDataPoolIndex;
+                }
+            }
+
+            Page& page = *GetPage(pageIndex);
+
+            if (page.pDatas == nullptr)
+            {
+                page.pDatas = reinterpret_cast<T*>(SHIP_ALLOC_EX(m_pAllocator, NumElementsPerPage * sizeof(T), alignment));
+                if (page.pDatas == nullptr)
+                {
+                    return InvalidDataPoolIndex;
+                }
+
+                m_NumResidentPages += 1;
+            }
+
+            shipUint32 slot = 0;
+            page.freeSlots.GetFirstBitSet(0, slot);
+            page.freeSlots.UnsetBit(slot);
+
+            page.numAllocatedItems += 1;
+            m_NumAllocatedItems += 1;
+
+            new (page.pDatas + slot)T();
+
+            *newItemGeneration = page.generations[slot];
+
+            return ((pageIndex << ms_PageShift) | slot);
+        }
+
+        shipBool GetFirstAllocatedIndex(shipUint32* firstAllocatedIndex, GenerationType* firstAllocatedGeneration) const
+        {
+            return FindAllocatedIndex(0, firstAllocatedIndex, firstAllocatedGeneration);
+        }
+
+        shipBool GetNextAllocatedIndex(shipUint32 currentIndex, shipUint32* nextAllocatedIndex, GenerationType* nextAllocationGeneration) const
+        {
+            return FindAllocatedIndex(currentIndex + 1, nextAllocatedIndex, nextAllocationGeneration);
+        }
+
+        void ReleaseItem(shipUint32 index)
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+
+            shipUint32 pageIndex = GetPageIndex(index);
+            shipUint32 slot = GetSlot(index);
+
+            SHIP_ASSERT_MSG(pageIndex < m_NumPages, "Releasing index %u that was never allocated for data pool 0x%p", index, this);
+
+            Page& page = *GetPage(pageIndex);
+
+            SHIP_ASSERT_MSG(!page.freeSlots.IsBitSet(slot), "Releasing index %u more than once for data pool 0x%p", index, this);
+
+            page.pDatas[slot].~T();
+            page.generations[slot] += 1;
+            page.freeSlots.SetBit(slot);
+
+            page.numAllocatedItems -= 1;
+            m_NumAllocatedItems -= 1;
+
+            m_FirstPageWithFreeSlots = MIN(pageIndex, m_FirstPageWithFreeSlots);
+
+            // The last resident page is kept, to avoid freeing and allocating it over and over when a single item is created
+            // and released repeatedly.
+            if (page.numAllocatedItems == 0 && m_NumResidentPages > 1)
+            {
+                SHIP_FREE_EX(m_pAllocator, page.pDatas);
+                page.pDatas = nullptr;
+
+                m_NumResidentPages -= 1;
+            }
+        }
+
+        T& GetItem(shipUint32 index, GenerationType generation)
+        {
+            Page& page = GetAllocatedItemPage(index, generation);
+            return page.pDatas[GetSlot(index)];
+        }
+
+        const T& GetItem(shipUint32 index, GenerationType generation) const
+        {
+            const Page& page = GetAllocatedItemPage(index, generation);
+            return page.pDatas[GetSlot(index)];
+        }
+
+        T* GetItemPtr(shipUint32 index, GenerationType generation)
+        {
+            Page& page = GetAllocatedItemPage(index, generation);
+            return &page.pDatas[GetSlot(index)];
+        }
+
+        const T* GetItemPtr(shipUint32 index, GenerationType generation) const
+        {
+            const Page& page = GetAllocatedItemPage(index, generation);
+            return &page.pDatas[GetSlot(index)];
+        }
+
+        shipUint32 GetNumAllocatedItems() const
+        {
+            return m_NumAllocatedItems;
+        }
+
+        shipUint32 GetMaxElementsInPool() const
+        {
+            return (ms_MaxNumPages * NumElementsPerPage);
+        }
+
+        DataPoolStatistics GetStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+
+            DataPoolStatistics statistics;
+            statistics.numAllocatedItems = m_NumAllocatedItems;
+            statistics.capacity = m_NumResidentPages * NumElementsPerPage;
+            statistics.numResidentPages = m_NumResidentPages;
+            statistics.numPages = m_NumPages;
+            statistics.residentMemorySize = m_NumPages * sizeof(Page) + m_NumResidentPages * NumElementsPerPage * sizeof(T);
+
+            return statistics;
+        }
+
+    private:
+        struct Page
+        {
+            Page()
+                : pDatas(nullptr)
+                , numAllocatedItems(0)
+                , freeSlots(true)
+            {
+                for (shipUint32 i = 0; i < NumElementsPerPage; i++)
+                {
+                    generations[i] = 0;
+                }
+            }
+
+            T* pDatas;
+            shipUint32 numAllocatedItems;
+            GenerationType generations[NumElementsPerPage];
+
+            // Set bits are free slots, like in DataPool.
+            InplaceBitfield<NumElementsPerPage, sizeof(shipUint64)> freeSlots;
+        };
+
+        static shipUint32 GetPageIndex(shipUint32 index)
+        {
+            return (index >> ms_PageShift);
+        }
+
+        static shipUint32 GetSlot(shipUint32 index)
+        {
+            return (index & (NumElementsPerPage - 1));
+        }
+
+        Page* GetPage(shipUint32 pageIndex) const
+        {
+            return m_PageTableBlocks[pageIndex / ms_NumPagesPerPageTableBlock][pageIndex % ms_NumPagesPerPageTableBlock];
+        }
+
+        Page& GetAllocatedItemPage(shipUint32 index, GenerationType generation) const
+        {
+            shipUint32 pageIndex = GetPageIndex(index);
+            shipUint32 slot = GetSlot(index);
+
+            SHIP_ASSERT_MSG(pageIndex < m_NumPages, "Accessing index %u that was not previously allocated for data pool 0x%p", index, this);
+
+            Page& page = *GetPage(pageIndex);
+
+            SHIP_ASSERT_MSG(!page.freeSlots.IsBitSet(slot), "Accessing index %u that was not previously allocated for data pool 0x%p", index, this);
+            SHIP_ASSERT_MSG(page.generations[slot] == generation, "Accessing index %u that was already deleted! Current generation %u, requested generation %u", index, page.generations[slot], generation);
+
+            return page;
+        }
+
+        // Pages that still have their elements allocated are filled first, so that freed pages stay freed for as long as possible.
+        shipUint32 FindPageWithFreeSlots()
+        {
+            shipUint32 firstFreedPageIndex = InvalidDataPoolIndex;
+
+            for (shipUint32 pageIndex = m_FirstPageWithFreeSlots; pageIndex < m_NumPages; pageIndex++)
+            {
+                const Page& page = *GetPage(pageIndex);
+
+                if (page.numAllocatedItems == NumElementsPerPage)
+                {
+                    if (pageIndex == m_FirstPageWithFreeSlots)
+                    {
+                        m_FirstPageWithFreeSlots += 1;
+                    }
+
+                    continue;
+                }
+
+                if (page.pDatas != nullptr)
+                {
+                    return pageIndex;
+                }
+
+                if (firstFreedPageIndex == InvalidDataPoolIndex)
+                {
+                    firstFreedPageIndex = pageIndex;
+                }
+            }
+
+            return firstFreedPageIndex;
+        }
+
+        shipUint32 AddPage()
+        {
+            SHIP_ASSERT_MSG(m_NumPages < ms_MaxNumPages, "Data pool 0x%p reached its maximum number of pages %u", this, ms_MaxNumPages);
+
+            if (m_NumPages == ms_MaxNumPages)
+            {
+                return InvalidDataPoolIndex;
+            }
+
+            shipUint32 pageIndex = m_NumPages;
+
+            Page**& pageTableBlock = m_PageTableBlocks[pageIndex / ms_NumPagesPerPageTableBlock];
+            if (pageTableBlock == nullptr)
+            {
+                pageTableBlock = reinterpret_cast<Page**>(SHIP_ALLOC_EX(m_pAllocator, ms_NumPagesPerPageTableBlock * sizeof(Page*), sizeof(Page*)));
+                if (pageTableBlock == nullptr)
+                {
+                    return InvalidDataPoolIndex;
+                }
+            }
+
+            Page* pPage = SHIP_NEW_EX(m_pAllocator, Page, SHIP_CACHE_LINE_SIZE)();
+            if (pPage == nullptr)
+            {
+                return InvalidDataPoolIndex;
+            }
+
+            pageTableBlock[pageIndex % ms_NumPagesPerPageTableBlock] = pPage;
+
+            m_NumPages += 1;
+
+            return pageIndex;
+        }
+
+        shipBool FindAllocatedIndex(shipUint32 startingIndex, shipUint32* allocatedIndex, GenerationType* allocatedGeneration) const
+        {
+            shipUint32 startingSlot = GetSlot(startingIndex);
+
+            for (shipUint32 pageIndex = GetPageIndex(startingIndex); pageIndex < m_NumPages; pageIndex++)
+            {
+                const Page& page = *GetPage(pageIndex);
+
+                shipUint32 slot = 0;
+                if (page.numAllocatedItems > 0 && page.freeSlots.GetFirstBitUnset(startingSlot, slot))
+                {
+                    *allocatedIndex = ((pageIndex << ms_PageShift) | slot);
+                    *allocatedGeneration = page.generations[slot];
+
+                    return true;
+                }
+
+                startingSlot = 0;
+            }
+
+            return false;
+        }
+
+    private:
+        BaseAllocator* m_pAllocator;
+        Page** m_PageTableBlocks[ms_MaxNumPageTableBlocks];
+        shipUint32 m_NumPages;
+        shipUint32 m_NumResidentPages;
+        shipUint32 m_NumAllocatedItems;
+
+        // Every page before this one is full.
+        shipUint32 m_FirstPageWithFreeSlots;
+
+        mutable std::mutex m_Lock;
+    };
 }
\ No newline at end of file
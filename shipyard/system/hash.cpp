@@ -0,0 +1,53 @@
+#include <system/systemprecomp.h>
+
+#include <system/hash.h>
+
+#include <string.h>
+
+namespace Shipyard
+{;
+
+shipUint64 HashBytes(const void* pData, size_t numBytes, shipUint64 seed)
+{
+    const shipUint64 m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+
+    shipUint64 hash = seed ^ (numBytes * m);
+
+    const shipUint8* pBytes = reinterpret_cast<const shipUint8*>(pData);
+    const shipUint8* pEnd = pBytes + (numBytes & ~size_t(7));
+
+    for (; pBytes != pEnd; pBytes += 8)
+    {
+        // memcpy is turned into a single unaligned load.
+        shipUint64 k;
+        memcpy(&k, pBytes, sizeof(k));
+
+        k *= m;
+        k ^= (k >> r);
+        k *= m;
+
+        hash ^= k;
+        hash *= m;
+    }
+
+    switch (numBytes & 7)
+    {
+    case 7: hash ^= shipUint64(pBytes[6]) << 48; // Fallthrough
+    case 6: hash ^= shipUint64(pBytes[5]) << 40; // Fallthrough
+    case 5: hash ^= shipUint64(pBytes[4]) << 32; // Fallthrough
+    case 4: hash ^= shipUint64(pBytes[3]) << 24; // Fallthrough
+    case 3: hash ^= shipUint64(pBytes[2]) << 16; // Fallthrough
+    case 2: hash ^= shipUint64(pBytes[1]) << 8; // Fallthrough
+    case 1: hash ^= shipUint64(pBytes[0]);
+        hash *= m;
+    };
+
+    hash ^= (hash >> r);
+    hash *= m;
+    hash ^= (hash >> r);
+
+    return hash;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <system/platform.h>
+#include <system/string.h>
+
+#include <type_traits>
+
+namespace Shipyard
+{
+    // Finalizer of MurmurHash3: every bit of the value affects every bit of the result, which hash tables need since
+    // they use both the low and the high bits of the hash.
+    SHIP_INLINE shipUint64 HashUint64(shipUint64 value)
+    {
+        value ^= (value >> 33);
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= (value >> 33);
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= (value >> 33);
+
+        return value;
+    }
+
+    SHIP_INLINE shipUint64 HashCombine(shipUint64 seed, shipUint64 hash)
+    {
+        return HashUint64(seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+
+    // MurmurHash64A, which reads the data 8 bytes at a time.
+    SHIPYARD_SYSTEM_API shipUint64 HashBytes(const void* pData, size_t numBytes, shipUint64 seed = 0);
+
+    // Hash used by the HashMap and HashSet when none is given. It can be specialized for other key types, or a custom hasher
+    // can be given to the containers instead. Keys that compare equal must have the same hash.
+    template <typename T, typename Enable = void>
+    struct DefaultHasher;
+
+    template <typename T>
+    struct DefaultHasher<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type>
+    {
+        shipUint64 operator() (T value) const
+        {
+            return HashUint64(shipUint64(value));
+        }
+    };
+
+    template <typename T>
+    struct DefaultHasher<T*>
+    {
+        shipUint64 operator() (const T* pointer) const
+        {
+            return HashUint64(shipUint64(size_t(pointer)));
+        }
+    };
+
+    template <typename CharType>
+    struct DefaultHasher<String<CharType>>
+    {
+        shipUint64 operator() (const String<CharType>& str) const
+        {
+            return HashBytes(str.GetBuffer(), str.Size() * sizeof(CharType));
+        }
+    };
+}
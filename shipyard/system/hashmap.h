@@ -0,0 +1,774 @@
+#pragma once
+
+#include <math/mathutilities.h>
+
+#include <system/hash.h>
+#include <system/memory.h>
+#include <system/platform.h>
+#include <system/systemdebug.h>
+
+#include <string.h>
+
+#include <new>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#   define SHIP_HASH_TABLE_SSE2
+#   include <emmintrin.h>
+#endif // #if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+
+#if COMPILER == COMPILER_MSVC
+#   include <intrin.h>
+#endif // #if COMPILER == COMPILER_MSVC
+
+namespace Shipyard
+{
+    namespace HashTableControl
+    {
+        // Every slot has a control byte. Full slots hold the 7 low bits of their hash, which makes them positive, while empty and
+        // deleted slots are negative.
+        using ControlByte = shipInt8;
+
+        constexpr ControlByte Empty = -128;
+        constexpr ControlByte Deleted = -2;
+
+        // Control bytes are probed a group at a time. Tables are at least a group big, and the first group's control bytes are
+        // copied after the last slot, so that a group can be loaded from any slot without wrapping around.
+        constexpr shipUint32 GroupWidth = 16;
+
+        // Bit i is set when the ith control byte of the group matches.
+        using BitMask = shipUint32;
+
+        SHIP_INLINE shipUint32 GetLowestBitIndex(BitMask bitMask)
+        {
+#if COMPILER == COMPILER_MSVC
+            unsigned long index = 0;
+            _BitScanForward(&index, bitMask);
+            return shipUint32(index);
+#else
+            return shipUint32(__builtin_ctz(bitMask));
+#endif // #if COMPILER == COMPILER_MSVC
+        }
+
+        SHIP_INLINE shipUint32 GetHighestBitIndex(BitMask bitMask)
+        {
+#if COMPILER == COMPILER_MSVC
+            unsigned long index = 0;
+            _BitScanReverse(&index, bitMask);
+            return shipUint32(index);
+#else
+            return shipUint32(31 - __builtin_clz(bitMask));
+#endif // #if COMPILER == COMPILER_MSVC
+        }
+
+        struct Group
+        {
+#ifdef SHIP_HASH_TABLE_SSE2
+            explicit Group(const ControlByte* pControlBytes)
+                : controlBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pControlBytes)))
+            {
+            }
+
+            BitMask Match(ControlByte h2) const
+            {
+                return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), controlBytes)));
+            }
+
+            BitMask MatchEmpty() const
+            {
+                return BitMask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Empty), controlBytes)));
+            }
+
+            BitMask MatchEmptyOrDeleted() const
+            {
+                // Empty and deleted are the only values below -1.
+                return BitMask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), controlBytes)));
+            }
+
+            __m128i controlBytes;
+#else
+            explicit Group(const ControlByte* pControlBytes)
+                : pControlBytes(pControlBytes)
+            {
+            }
+
+            BitMask Match(ControlByte h2) const
+            {
+                BitMask bitMask = 0;
+                for (shipUint32 i = 0; i < GroupWidth; i++)
+                {
+                    bitMask |= (BitMask(pControlBytes[i] == h2) << i);
+                }
+
+                return bitMask;
+            }
+
+            BitMask MatchEmpty() const
+            {
+                return Match(Empty);
+            }
+
+            BitMask MatchEmptyOrDeleted() const
+            {
+                BitMask bitMask = 0;
+                for (shipUint32 i = 0; i < GroupWidth; i++)
+                {
+                    bitMask |= (BitMask(pControlBytes[i] < -1) << i);
+                }
+
+                return bitMask;
+            }
+
+            const ControlByte* pControlBytes;
+#endif // #ifdef SHIP_HASH_TABLE_SSE2
+        };
+    }
+
+    // Open addressing hash table laid out like SwissTable. The hash of a key gives both the group where probing starts (the
+    // high bits) and the 7 bits stored in the control byte of its slot (the low bits). A lookup compares the whole group of
+    // control bytes at once and only compares the keys of slots whose 7 bits match, moving on to the next group only if the
+    // current one has no empty slot. Slots are stored apart from the control bytes, so probing doesn't touch them.
+    //
+    // Tables are kept at most 7/8 full. Removed slots become empty again when no probe could have gone past them, otherwise they
+    // are marked as deleted until the next rehash.
+    //
+    // Slots are only constructed when a key is added, and may be moved when the table grows: pointers to slots are invalidated
+    // by any insertion. KeyOfSlot::Get returns the key of a slot. Use the HashMap or the HashSet rather than this class.
+    template <typename Key, typename Slot, typename KeyOfSlot, typename Hasher>
+    class HashTable
+    {
+    protected:
+        using ControlByte = HashTableControl::ControlByte;
+        using BitMask = HashTableControl::BitMask;
+        using Group = HashTableControl::Group;
+
+    public:
+        template <typename SlotType>
+        class IteratorType
+        {
+        public:
+            IteratorType(const ControlByte* pControlByte, SlotType* pSlot, SlotType* pEnd)
+                : m_pControlByte(pControlByte)
+                , m_pSlot(pSlot)
+                , m_pEnd(pEnd)
+            {
+                SkipSlotsNotFull();
+            }
+
+            SlotType& operator* () const
+            {
+                return *m_pSlot;
+            }
+
+            SlotType* operator-> () const
+            {
+                return m_pSlot;
+            }
+
+            IteratorType& operator++ ()
+            {
+                ++m_pControlByte;
+                ++m_pSlot;
+
+                SkipSlotsNotFull();
+
+                return *this;
+            }
+
+            shipBool operator== (const IteratorType& rhs) const
+            {
+                return (m_pSlot == rhs.m_pSlot);
+            }
+
+            shipBool operator!= (const IteratorType& rhs) const
+            {
+                return (m_pSlot != rhs.m_pSlot);
+            }
+
+        private:
+            void SkipSlotsNotFull()
+            {
+                while (m_pSlot != m_pEnd && *m_pControlByte < 0)
+                {
+                    ++m_pControlByte;
+                    ++m_pSlot;
+                }
+            }
+
+            const ControlByte* m_pControlByte;
+            SlotType* m_pSlot;
+            SlotType* m_pEnd;
+        };
+
+        using Iterator = IteratorType<Slot>;
+        using ConstIterator = IteratorType<const Slot>;
+
+    public:
+        HashTable(BaseAllocator* pAllocator = nullptr)
+            : m_pAllocator(pAllocator)
+            , m_pSlots(nullptr)
+            , m_pControlBytes(nullptr)
+            , m_Size(0)
+            , m_Capacity(0)
+            , m_GrowthLeft(0)
+        {
+            if (pAllocator == nullptr)
+            {
+                m_pAllocator = &GetGlobalAllocator();
+            }
+        }
+
+        HashTable(shipUint32 initialNumElements, BaseAllocator* pAllocator = nullptr)
+            : HashTable(pAllocator)
+        {
+            Reserve(initialNumElements);
+        }
+
+        HashTable(const HashTable& src)
+            : HashTable(src.m_pAllocator)
+        {
+            CopyFrom(src);
+        }
+
+        HashTable(HashTable&& src)
+            : HashTable(src.m_pAllocator)
+        {
+            TakeFrom(src);
+        }
+
+        ~HashTable()
+        {
+            Clear();
+        }
+
+        HashTable& operator= (const HashTable& rhs)
+        {
+            if (this != &rhs)
+            {
+                Clear();
+
+                m_pAllocator = rhs.m_pAllocator;
+
+                CopyFrom(rhs);
+            }
+
+            return *this;
+        }
+
+        HashTable& operator= (HashTable&& rhs)
+        {
+            if (this != &rhs)
+            {
+                Clear();
+
+                m_pAllocator = rhs.m_pAllocator;
+
+                TakeFrom(rhs);
+            }
+
+            return *this;
+        }
+
+        shipBool Exists(const Key& key) const
+        {
+            return (FindSlot(key) != nullptr);
+        }
+
+        // Returns false if the key wasn't found.
+        shipBool Remove(const Key& key)
+        {
+            Slot* pSlot = FindSlot(key);
+            if (pSlot == nullptr)
+            {
+                return false;
+            }
+
+            RemoveSlot(shipUint32(pSlot - m_pSlots));
+
+            return true;
+        }
+
+        // Destroys every element and frees the memory.
+        void Clear()
+        {
+            if (m_pSlots == nullptr)
+            {
+                return;
+            }
+
+            for (shipUint32 i = 0; i < m_Capacity; i++)
+            {
+                if (m_pControlBytes[i] >= 0)
+                {
+                    m_pSlots[i].~Slot();
+                }
+            }
+
+            SHIP_FREE_EX(m_pAllocator, m_pSlots);
+
+            m_pSlots = nullptr;
+            m_pControlBytes = nullptr;
+            m_Size = 0;
+            m_Capacity = 0;
+            m_GrowthLeft = 0;
+        }
+
+        // Makes room for numElements without having to rehash.
+        void Reserve(shipUint32 numElements)
+        {
+            if (numElements <= (m_Size + m_GrowthLeft))
+            {
+                return;
+            }
+
+            shipUint32 newCapacity = HashTableControl::GroupWidth;
+            while (GetMaxNumElements(newCapacity) < numElements)
+            {
+                SHIP_ASSERT(newCapacity < 0x80000000);
+                newCapacity *= 2;
+            }
+
+            Rehash(MAX(newCapacity, m_Capacity));
+        }
+
+        shipUint32 Size() const
+        {
+            return m_Size;
+        }
+
+        shipUint32 Capacity() const
+        {
+            return m_Capacity;
+        }
+
+        shipBool Empty() const
+        {
+            return (m_Size == 0);
+        }
+
+        BaseAllocator* GetAllocator() const
+        {
+            return m_pAllocator;
+        }
+
+        Iterator begin()
+        {
+            return Iterator(m_pControlBytes, m_pSlots, m_pSlots + m_Capacity);
+        }
+
+        ConstIterator begin() const
+        {
+            return ConstIterator(m_pControlBytes, m_pSlots, m_pSlots + m_Capacity);
+        }
+
+        Iterator end()
+        {
+            return Iterator(nullptr, m_pSlots + m_Capacity, m_pSlots + m_Capacity);
+        }
+
+        ConstIterator end() const
+        {
+            return ConstIterator(nullptr, m_pSlots + m_Capacity, m_pSlots + m_Capacity);
+        }
+
+    protected:
+        Slot* FindSlot(const Key& key) const
+        {
+            if (m_Size == 0)
+            {
+                return nullptr;
+            }
+
+            shipUint64 hash = m_Hasher(key);
+
+            ControlByte h2 = GetH2(hash);
+            shipUint32 mask = (m_Capacity - 1);
+            shipUint32 groupStart = GetProbeStart(hash);
+
+            // The table is never full, so every probe ends on a group with an empty slot.
+            for (shipUint32 probeStep = HashTableControl::GroupWidth; true; probeStep += HashTableControl::GroupWidth)
+            {
+                Group group(m_pControlBytes + groupStart);
+
+                for (BitMask match = group.Match(h2); match != 0; match &= (match - 1))
+                {
+                    shipUint32 slotIndex = ((groupStart + HashTableControl::GetLowestBitIndex(match)) & mask);
+
+                    if (KeyOfSlot::Get(m_pSlots[slotIndex]) == key)
+                    {
+                        return &m_pSlots[slotIndex];
+                    }
+                }
+
+                if (group.MatchEmpty() != 0)
+                {
+                    return nullptr;
+                }
+
+                groupStart = ((groupStart + probeStep) & mask);
+            }
+        }
+
+        // Returns the slot of key. If key wasn't found, the returned slot is counted as full but isn't constructed, which is left
+        // to the caller.
+        Slot* FindOrPrepareInsert(const Key& key, shipBool& foundKey)
+        {
+            Slot* pSlot = FindSlot(key);
+
+            foundKey = (pSlot != nullptr);
+            if (foundKey)
+            {
+                return pSlot;
+            }
+
+            shipUint64 hash = m_Hasher(key);
+
+            shipUint32 slotIndex = 0;
+
+            // Reusing a deleted slot doesn't make the table any fuller.
+            shipBool needToGrow = (m_Capacity == 0);
+            if (!needToGrow)
+            {
+                slotIndex = FindFirstSlotNotFull(hash);
+                needToGrow = (m_GrowthLeft == 0 && m_pControlBytes[slotIndex] == HashTableControl::Empty);
+            }
+
+            if (needToGrow)
+            {
+                // Rehashing at the same capacity is enough when it's mostly deleted slots that fill the table.
+                shipUint32 newCapacity = HashTableControl::GroupWidth;
+                if (m_Capacity > 0)
+                {
+                    newCapacity = ((m_Size * 2) <= GetMaxNumElements(m_Capacity)) ? m_Capacity : (m_Capacity * 2);
+                }
+
+                Rehash(newCapacity);
+
+                slotIndex = FindFirstSlotNotFull(hash);
+            }
+
+            if (m_pControlBytes[slotIndex] == HashTableControl::Empty)
+            {
+                m_GrowthLeft -= 1;
+            }
+
+            SetControlByte(slotIndex, GetH2(hash));
+
+            m_Size += 1;
+
+            return &m_pSlots[slotIndex];
+        }
+
+        void RemoveSlot(shipUint32 slotIndex)
+        {
+            m_pSlots[slotIndex].~Slot();
+
+            shipUint32 mask = (m_Capacity - 1);
+
+            // If the slots around this one that aren't empty don't cover a whole group, no probe ever went past this slot, since
+            // it would have seen an empty slot first. It can then be made empty, otherwise it has to be marked as deleted.
+            BitMask emptyAfter = Group(m_pControlBytes + slotIndex).MatchEmpty();
+            BitMask emptyBefore = Group(m_pControlBytes + ((slotIndex - HashTableControl::GroupWidth) & mask)).MatchEmpty();
+
+            shipBool canBeEmpty = false;
+            if (emptyAfter != 0 && emptyBefore != 0)
+            {
+                shipUint32 numSlotsNotEmptyAfter = HashTableControl::GetLowestBitIndex(emptyAfter);
+                shipUint32 numSlotsNotEmptyBefore = (HashTableControl::GroupWidth - 1) - HashTableControl::GetHighestBitIndex(emptyBefore);
+
+                canBeEmpty = ((numSlotsNotEmptyAfter + numSlotsNotEmptyBefore) < HashTableControl::GroupWidth);
+            }
+
+            if (canBeEmpty)
+            {
+                SetControlByte(slotIndex, HashTableControl::Empty);
+                m_GrowthLeft += 1;
+            }
+            else
+            {
+                SetControlByte(slotIndex, HashTableControl::Deleted);
+            }
+
+            m_Size -= 1;
+        }
+
+    private:
+        static ControlByte GetH2(shipUint64 hash)
+        {
+            return ControlByte(hash & 0x7F);
+        }
+
+        shipUint32 GetProbeStart(shipUint64 hash) const
+        {
+            return (shipUint32(hash >> 7) & (m_Capacity - 1));
+        }
+
+        static shipUint32 GetMaxNumElements(shipUint32 capacity)
+        {
+            return (capacity - (capacity / 8));
+        }
+
+        shipUint32 FindFirstSlotNotFull(shipUint64 hash) const
+        {
+            shipUint32 mask = (m_Capacity - 1);
+            shipUint32 groupStart = GetProbeStart(hash);
+
+            for (shipUint32 probeStep = HashTableControl::GroupWidth; true; probeStep += HashTableControl::GroupWidth)
+            {
+                BitMask emptyOrDeleted = Group(m_pControlBytes + groupStart).MatchEmptyOrDeleted();
+                if (emptyOrDeleted != 0)
+                {
+                    return ((groupStart + HashTableControl::GetLowestBitIndex(emptyOrDeleted)) & mask);
+                }
+
+                groupStart = ((groupStart + probeStep) & mask);
+            }
+        }
+
+        void SetControlByte(shipUint32 slotIndex, ControlByte controlByte)
+        {
+            m_pControlBytes[slotIndex] = controlByte;
+
+            if (slotIndex < HashTableControl::GroupWidth)
+            {
+                m_pControlBytes[m_Capacity + slotIndex] = controlByte;
+            }
+        }
+
+        // Slots come first in the allocation, followed by the control bytes.
+        void AllocateTable(shipUint32 capacity)
+        {
+            SHIP_ASSERT(capacity >= HashTableControl::GroupWidth && (capacity & (capacity - 1)) == 0);
+
+            size_t requiredSize = sizeof(Slot) * capacity + sizeof(ControlByte) * (capacity + HashTableControl::GroupWidth);
+
+            m_pSlots = reinterpret_cast<Slot*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, alignof(Slot)));
+            m_pControlBytes = reinterpret_cast<ControlByte*>(m_pSlots + capacity);
+
+            m_Capacity = capacity;
+        }
+
+        void Rehash(shipUint32 newCapacity)
+        {
+            Slot* pOldSlots = m_pSlots;
+            ControlByte* pOldControlBytes = m_pControlBytes;
+            shipUint32 oldCapacity = m_Capacity;
+
+            AllocateTable(newCapacity);
+
+            memset(m_pControlBytes, HashTableControl::Empty, newCapacity + HashTableControl::GroupWidth);
+
+            for (shipUint32 i = 0; i < oldCapacity; i++)
+            {
+                if (pOldControlBytes[i] < 0)
+                {
+                    continue;
+                }
+
+                Slot& oldSlot = pOldSlots[i];
+
+                shipUint64 hash = m_Hasher(KeyOfSlot::Get(oldSlot));
+                shipUint32 slotIndex = FindFirstSlotNotFull(hash);
+
+                SetControlByte(slotIndex, GetH2(hash));
+
+                new(m_pSlots + slotIndex)Slot(std::move(oldSlot));
+                oldSlot.~Slot();
+            }
+
+            m_GrowthLeft = GetMaxNumElements(newCapacity) - m_Size;
+
+            SHIP_FREE_EX(m_pAllocator, pOldSlots);
+        }
+
+        // The table must be empty.
+        void CopyFrom(const HashTable& src)
+        {
+            if (src.m_Size == 0)
+            {
+                return;
+            }
+
+            // Same capacity and hasher, so every element can stay at the same index.
+            AllocateTable(src.m_Capacity);
+
+            memcpy(m_pControlBytes, src.m_pControlBytes, m_Capacity + HashTableControl::GroupWidth);
+
+            for (shipUint32 i = 0; i < m_Capacity; i++)
+            {
+                if (m_pControlBytes[i] >= 0)
+                {
+                    new(m_pSlots + i)Slot(src.m_pSlots[i]);
+                }
+            }
+
+            m_Size = src.m_Size;
+            m_GrowthLeft = src.m_GrowthLeft;
+        }
+
+        // The table must be empty.
+        void TakeFrom(HashTable& src)
+        {
+            m_pSlots = src.m_pSlots;
+            m_pControlBytes = src.m_pControlBytes;
+            m_Size = src.m_Size;
+            m_Capacity = src.m_Capacity;
+            m_GrowthLeft = src.m_GrowthLeft;
+
+            src.m_pSlots = nullptr;
+            src.m_pControlBytes = nullptr;
+            src.m_Size = 0;
+            src.m_Capacity = 0;
+            src.m_GrowthLeft = 0;
+        }
+
+    protected:
+        BaseAllocator* m_pAllocator;
+        Slot* m_pSlots;
+        ControlByte* m_pControlBytes;
+        shipUint32 m_Size;
+        shipUint32 m_Capacity;
+
+        // Number of empty slots that can still be filled before having to rehash.
+        shipUint32 m_GrowthLeft;
+
+        Hasher m_Hasher;
+    };
+
+    template <typename Key, typename Value>
+    struct HashMapEntry
+    {
+        template <typename... Args>
+        HashMapEntry(const Key& key, Args&&... args)
+            : key(key)
+            , value(std::forward<Args>(args)...)
+        {
+        }
+
+        // Changing the key of an entry in a map would leave it in the wrong slot.
+        Key key;
+        Value value;
+    };
+
+    template <typename Key, typename Value>
+    struct HashMapKeyOfEntry
+    {
+        static const Key& Get(const HashMapEntry<Key, Value>& entry)
+        {
+            return entry.key;
+        }
+    };
+
+    // Iterating over a HashMap gives HashMapEntry, in no particular order.
+    template <typename Key, typename Value, typename Hasher = DefaultHasher<Key>>
+    class HashMap : public HashTable<Key, HashMapEntry<Key, Value>, HashMapKeyOfEntry<Key, Value>, Hasher>
+    {
+        using Entry = HashMapEntry<Key, Value>;
+        using BaseType = HashTable<Key, Entry, HashMapKeyOfEntry<Key, Value>, Hasher>;
+
+    public:
+        HashMap(BaseAllocator* pAllocator = nullptr)
+            : BaseType(pAllocator)
+        {
+        }
+
+        HashMap(shipUint32 initialNumElements, BaseAllocator* pAllocator = nullptr)
+            : BaseType(initialNumElements, pAllocator)
+        {
+        }
+
+        // Returns nullptr if the key isn't in the map.
+        Value* Find(const Key& key)
+        {
+            Entry* pEntry = this->FindSlot(key);
+            return ((pEntry != nullptr) ? &pEntry->value : nullptr);
+        }
+
+        const Value* Find(const Key& key) const
+        {
+            const Entry* pEntry = this->FindSlot(key);
+            return ((pEntry != nullptr) ? &pEntry->value : nullptr);
+        }
+
+        // Returns true if the key was added, false if it was already in the map, in which case its value is left unchanged.
+        shipBool Insert(const Key& key, const Value& value)
+        {
+            return Emplace(key, value);
+        }
+
+        shipBool Insert(const Key& key, Value&& value)
+        {
+            return Emplace(key, std::move(value));
+        }
+
+        // Same as Insert, with the value constructed in place from args.
+        template <typename... Args>
+        shipBool Emplace(const Key& key, Args&&... args)
+        {
+            shipBool foundKey = false;
+            Entry* pEntry = this->FindOrPrepareInsert(key, foundKey);
+
+            if (!foundKey)
+            {
+                new(pEntry)Entry(key, std::forward<Args>(args)...);
+            }
+
+            return !foundKey;
+        }
+
+        // Adds a default constructed value if the key isn't in the map.
+        Value& operator[] (const Key& key)
+        {
+            shipBool foundKey = false;
+            Entry* pEntry = this->FindOrPrepareInsert(key, foundKey);
+
+            if (!foundKey)
+            {
+                new(pEntry)Entry(key);
+            }
+
+            return pEntry->value;
+        }
+    };
+
+    template <typename Key>
+    struct HashSetKeyOfKey
+    {
+        static const Key& Get(const Key& key)
+        {
+            return key;
+        }
+    };
+
+    // Iterating over a HashSet gives its keys, in no particular order. Keys must not be modified.
+    template <typename Key, typename Hasher = DefaultHasher<Key>>
+    class HashSet : public HashTable<Key, Key, HashSetKeyOfKey<Key>, Hasher>
+    {
+        using BaseType = HashTable<Key, Key, HashSetKeyOfKey<Key>, Hasher>;
+
+    public:
+        HashSet(BaseAllocator* pAllocator = nullptr)
+            : BaseType(pAllocator)
+        {
+        }
+
+        HashSet(shipUint32 initialNumElements, BaseAllocator* pAllocator = nullptr)
+            : BaseType(initialNumElements, pAllocator)
+        {
+        }
+
+        // Returns true if the key was added, false if it was already in the set.
+        shipBool Add(const Key& key)
+        {
+            shipBool foundKey = false;
+            Key* pKey = this->FindOrPrepareInsert(key, foundKey);
+
+            if (!foundKey)
+            {
+                new(pKey)Key(key);
+            }
+
+            return !foundKey;
+        }
+    };
+}
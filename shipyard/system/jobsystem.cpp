@@ -0,0 +1,513 @@
+#include <system/systemprecomp.h>
+
+#include <system/jobsystem.h>
+
+#include <system/memory.h>
+#include <system/systemdebug.h>
+
+namespace Shipyard
+{;
+
+namespace
+{
+    // Number of times a thread looks for a job, yielding in between, before going to sleep.
+    constexpr shipUint32 NumIdleIterationsBeforeSleeping = 64;
+
+    struct JobSystemThread
+    {
+        const JobSystem* pJobSystem = nullptr;
+        shipUint32 threadIndex = JobSystem::InvalidThreadIndex;
+    };
+
+    thread_local JobSystemThread t_JobSystemThread;
+
+    shipUint32 GetNextRandomNumber(shipUint32& randomState)
+    {
+        // xorshift32, only used to spread thieves over the threads.
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+
+        return randomState;
+    }
+
+    void RunFunctionWithUserData(JobFunction pFunction, void* pUserData)
+    {
+        pFunction(pUserData);
+    }
+
+    void IncrementStatistic(volatile shipUint64& statistic)
+    {
+        // Only the owning thread writes its statistics, other threads only read them.
+        AtomicOperations::Store(statistic, AtomicOperations::Load(statistic, MemoryOrder::Relaxed) + 1, MemoryOrder::Relaxed);
+    }
+}
+
+JobCounter::JobCounter()
+    : m_State(0)
+    , m_pFirstDependentJob(nullptr)
+{
+}
+
+JobCounter::~JobCounter()
+{
+    SHIP_ASSERT_MSG(IsDone(), "JobCounter destroyed while %u jobs are still pending", GetNumPendingJobs());
+}
+
+JobSystem::JobSystem()
+    : m_pThreadContexts(nullptr)
+    , m_NumThreads(0)
+    , m_pAllocator(nullptr)
+    , m_pJobPoolHeap(nullptr)
+    , m_pFirstExternalJob(nullptr)
+    , m_pLastExternalJob(nullptr)
+    , m_NumExternalJobs(0)
+    , m_NumQueuedJobs(0)
+    , m_NumSleepingThreads(0)
+    , m_IsRunning(0)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    SHIP_ASSERT_MSG(m_pThreadContexts == nullptr, "JobSystem::Destroy wasn't called");
+}
+
+shipBool JobSystem::Create(shipUint32 numThreads, shipUint32 maxNumJobs, BaseAllocator* pAllocator)
+{
+    SHIP_ASSERT_MSG(m_pThreadContexts == nullptr, "JobSystem::Create called twice");
+    SHIP_ASSERT(maxNumJobs > 0);
+
+    if (numThreads == 0)
+    {
+        numThreads = MAX(std::thread::hardware_concurrency(), 1u);
+    }
+
+    m_NumThreads = MIN(numThreads, MaxNumThreads);
+    m_pAllocator = ((pAllocator != nullptr) ? pAllocator : &GetGlobalAllocator());
+
+    m_pJobPoolHeap = SHIP_ALLOC_EX(m_pAllocator, size_t(maxNumJobs) * sizeof(Job), SHIP_CACHE_LINE_SIZE);
+    if (m_pJobPoolHeap == nullptr)
+    {
+        return false;
+    }
+
+    if (!m_JobPool.Create(m_pJobPoolHeap, maxNumJobs, sizeof(Job), PoolAllocator::SynchronizationMode::LockFree))
+    {
+        SHIP_FREE_EX(m_pAllocator, m_pJobPoolHeap);
+        m_pJobPoolHeap = nullptr;
+
+        return false;
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_JobPool.SetAllocatorDebugName("JobSystem Job Pool");
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    m_pThreadContexts = SHIP_NEW_ARRAY_EX(m_pAllocator, ThreadContext, m_NumThreads, SHIP_CACHE_LINE_SIZE);
+
+    for (shipUint32 i = 0; i < m_NumThreads; i++)
+    {
+        m_pThreadContexts[i].randomState = 0x9E3779B9u * (i + 1);
+    }
+
+    t_JobSystemThread.pJobSystem = this;
+    t_JobSystemThread.threadIndex = 0;
+
+    AtomicOperations::Store(m_IsRunning, 1u);
+
+    for (shipUint32 i = 1; i < m_NumThreads; i++)
+    {
+        m_pThreadContexts[i].thread = std::thread(&JobSystem::WorkerThreadFunction, this, i);
+    }
+
+    return true;
+}
+
+void JobSystem::Destroy()
+{
+    if (m_pThreadContexts == nullptr)
+    {
+        return;
+    }
+
+    SHIP_ASSERT_MSG(GetCurrentThreadIndex() == 0, "JobSystem::Destroy must be called from the thread that created it");
+    SHIP_ASSERT_MSG(AtomicOperations::Load(m_NumQueuedJobs) == 0, "JobSystem destroyed with %u jobs still queued", m_NumQueuedJobs);
+
+    {
+        std::lock_guard<std::mutex> lock(m_SleepLock);
+        AtomicOperations::Store(m_IsRunning, 0u);
+    }
+
+    m_SleepCondition.notify_all();
+
+    for (shipUint32 i = 1; i < m_NumThreads; i++)
+    {
+        m_pThreadContexts[i].thread.join();
+    }
+
+    SHIP_DELETE_ARRAY_EX(m_pAllocator, m_pThreadContexts);
+    m_pThreadContexts = nullptr;
+    m_NumThreads = 0;
+
+    m_JobPool.Destroy();
+
+    SHIP_FREE_EX(m_pAllocator, m_pJobPoolHeap);
+    m_pJobPoolHeap = nullptr;
+
+    t_JobSystemThread = JobSystemThread();
+}
+
+void JobSystem::Run(JobFunction pFunction, void* pUserData, JobCounter* pCounter, JobCounter* pDependencyCounter)
+{
+    Run([pFunction, pUserData]()
+    {
+        RunFunctionWithUserData(pFunction, pUserData);
+    }, pCounter, pDependencyCounter);
+}
+
+void JobSystem::WaitForCounter(const JobCounter& counter)
+{
+    shipUint32 threadIndex = GetCurrentThreadIndex();
+
+    while (!counter.IsDone())
+    {
+        if (!RunOneJob(threadIndex))
+        {
+            // The remaining jobs are running on other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+shipUint32 JobSystem::GetCurrentThreadIndex() const
+{
+    return ((t_JobSystemThread.pJobSystem == this) ? t_JobSystemThread.threadIndex : InvalidThreadIndex);
+}
+
+JobSystem::Statistics JobSystem::GetStatistics() const
+{
+    Statistics statistics;
+
+    for (shipUint32 i = 0; i < m_NumThreads; i++)
+    {
+        const ThreadContext& threadContext = m_pThreadContexts[i];
+
+        statistics.numJobsExecuted += AtomicOperations::Load(threadContext.numJobsExecuted, MemoryOrder::Relaxed);
+        statistics.numJobsStolen += AtomicOperations::Load(threadContext.numJobsStolen, MemoryOrder::Relaxed);
+        statistics.numJobsExecutedInline += AtomicOperations::Load(threadContext.numJobsExecutedInline, MemoryOrder::Relaxed);
+    }
+
+    return statistics;
+}
+
+Job* JobSystem::AllocateJob()
+{
+    SHIP_ASSERT_MSG(m_pThreadContexts != nullptr, "JobSystem used before being created");
+
+    Job* pJob = reinterpret_cast<Job*>(SHIP_ALLOC_EX(&m_JobPool, sizeof(Job), SHIP_CACHE_LINE_SIZE));
+
+    if (pJob == nullptr)
+    {
+        shipUint32 threadIndex = GetCurrentThreadIndex();
+        if (threadIndex != InvalidThreadIndex)
+        {
+            IncrementStatistic(m_pThreadContexts[threadIndex].numJobsExecutedInline);
+        }
+    }
+
+    return pJob;
+}
+
+void JobSystem::SubmitJob(Job* pJob, JobCounter* pCounter, JobCounter* pDependencyCounter)
+{
+    pJob->pCounter = pCounter;
+    pJob->pNextJob = nullptr;
+
+    if (pCounter != nullptr)
+    {
+        SHIP_ASSERT_MSG(pCounter->GetNumPendingJobs() < JobCounter::NumPendingJobsMask, "Too many jobs pending on a JobCounter");
+
+        AtomicOperations::Increment(pCounter->m_State);
+    }
+
+    if (pDependencyCounter != nullptr && AddDependentJob(*pDependencyCounter, pJob))
+    {
+        return;
+    }
+
+    ScheduleJob(pJob);
+}
+
+void JobSystem::ScheduleJob(Job* pJob)
+{
+    // Counted before being pushed, so that a thread about to sleep either sees it or is woken up below.
+    AtomicOperations::Increment(m_NumQueuedJobs);
+
+    shipUint32 threadIndex = GetCurrentThreadIndex();
+
+    if (threadIndex == InvalidThreadIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalJobsLock);
+
+        if (m_pLastExternalJob != nullptr)
+        {
+            m_pLastExternalJob->pNextJob = pJob;
+        }
+        else
+        {
+            m_pFirstExternalJob = pJob;
+        }
+
+        m_pLastExternalJob = pJob;
+
+        AtomicOperations::Increment(m_NumExternalJobs);
+    }
+    else if (!m_pThreadContexts[threadIndex].jobQueue.Push(pJob))
+    {
+        AtomicOperations::Decrement(m_NumQueuedJobs);
+
+        IncrementStatistic(m_pThreadContexts[threadIndex].numJobsExecutedInline);
+
+        ExecuteJob(pJob);
+        return;
+    }
+
+    if (AtomicOperations::Load(m_NumSleepingThreads) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_SleepLock);
+        m_SleepCondition.notify_one();
+    }
+}
+
+shipBool JobSystem::AddDependentJob(JobCounter& dependencyCounter, Job* pJob)
+{
+    shipUint32 state = AtomicOperations::Load(dependencyCounter.m_State, MemoryOrder::Relaxed);
+
+    while (true)
+    {
+        if ((state & JobCounter::LockedFlag) != 0)
+        {
+            std::this_thread::yield();
+            state = AtomicOperations::Load(dependencyCounter.m_State, MemoryOrder::Relaxed);
+
+            continue;
+        }
+
+        if ((state & JobCounter::NumPendingJobsMask) == 0)
+        {
+            return false;
+        }
+
+        // The flag is set along with the lock, so that the last job, should it finish while the lock is held, sees that it has
+        // dependent jobs to start and waits for the lock to be released.
+        shipUint32 newState = (state | JobCounter::LockedFlag | JobCounter::HasDependentJobsFlag);
+
+        shipUint32 previousState = AtomicOperations::CompareExchange(dependencyCounter.m_State, newState, state, MemoryOrder::Acquire);
+        if (previousState == state)
+        {
+            break;
+        }
+
+        state = previousState;
+    }
+
+    pJob->pNextJob = dependencyCounter.m_pFirstDependentJob;
+    dependencyCounter.m_pFirstDependentJob = pJob;
+
+    AtomicOperations::And(dependencyCounter.m_State, ~shipUint32(JobCounter::LockedFlag), MemoryOrder::Release);
+
+    return true;
+}
+
+void JobSystem::ExecuteJob(Job* pJob)
+{
+    pJob->pEntryPoint(pJob);
+
+    JobCounter* pCounter = pJob->pCounter;
+
+    m_JobPool.Deallocate(pJob);
+
+    if (pCounter != nullptr)
+    {
+        FinishJob(*pCounter);
+    }
+}
+
+void JobSystem::FinishJob(JobCounter& counter)
+{
+    shipUint32 state = AtomicOperations::Decrement(counter.m_State, MemoryOrder::AcquireRelease);
+
+    if ((state & JobCounter::NumPendingJobsMask) != 0 || (state & JobCounter::HasDependentJobsFlag) == 0)
+    {
+        // Past this point, the counter may have been destroyed by a thread waiting for it.
+        return;
+    }
+
+    while (true)
+    {
+        if ((state & JobCounter::LockedFlag) == 0)
+        {
+            shipUint32 previousState = AtomicOperations::CompareExchange(counter.m_State, state | JobCounter::LockedFlag, state, MemoryOrder::Acquire);
+            if (previousState == state)
+            {
+                break;
+            }
+
+            state = previousState;
+        }
+        else
+        {
+            std::this_thread::yield();
+            state = AtomicOperations::Load(counter.m_State, MemoryOrder::Relaxed);
+        }
+
+        // Another job finishing after the counter was reused starts the dependent jobs instead.
+        if ((state & JobCounter::NumPendingJobsMask) != 0 || (state & JobCounter::HasDependentJobsFlag) == 0)
+        {
+            return;
+        }
+    }
+
+    Job* pDependentJob = counter.m_pFirstDependentJob;
+    counter.m_pFirstDependentJob = nullptr;
+
+    AtomicOperations::And(counter.m_State, ~shipUint32(JobCounter::LockedFlag | JobCounter::HasDependentJobsFlag), MemoryOrder::Release);
+
+    while (pDependentJob != nullptr)
+    {
+        Job* pNextDependentJob = pDependentJob->pNextJob;
+        pDependentJob->pNextJob = nullptr;
+
+        ScheduleJob(pDependentJob);
+
+        pDependentJob = pNextDependentJob;
+    }
+}
+
+Job* JobSystem::FindJob(shipUint32 threadIndex)
+{
+    if (threadIndex != InvalidThreadIndex)
+    {
+        Job* pJob = m_pThreadContexts[threadIndex].jobQueue.Pop();
+        if (pJob != nullptr)
+        {
+            return pJob;
+        }
+    }
+
+    if (AtomicOperations::Load(m_NumExternalJobs, MemoryOrder::Relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_ExternalJobsLock);
+
+        Job* pJob = m_pFirstExternalJob;
+        if (pJob != nullptr)
+        {
+            m_pFirstExternalJob = pJob->pNextJob;
+            if (m_pFirstExternalJob == nullptr)
+            {
+                m_pLastExternalJob = nullptr;
+            }
+
+            AtomicOperations::Decrement(m_NumExternalJobs);
+
+            return pJob;
+        }
+    }
+
+    // Threads outside of the job system always start with the main thread, they have no random state of their own.
+    shipUint32 firstVictimIndex = 0;
+    if (threadIndex != InvalidThreadIndex)
+    {
+        firstVictimIndex = GetNextRandomNumber(m_pThreadContexts[threadIndex].randomState) % m_NumThreads;
+    }
+
+    for (shipUint32 i = 0; i < m_NumThreads; i++)
+    {
+        shipUint32 victimIndex = (firstVictimIndex + i) % m_NumThreads;
+        if (victimIndex == threadIndex)
+        {
+            continue;
+        }
+
+        Job* pJob = m_pThreadContexts[victimIndex].jobQueue.Steal();
+        if (pJob != nullptr)
+        {
+            if (threadIndex != InvalidThreadIndex)
+            {
+                IncrementStatistic(m_pThreadContexts[threadIndex].numJobsStolen);
+            }
+
+            return pJob;
+        }
+    }
+
+    return nullptr;
+}
+
+shipBool JobSystem::RunOneJob(shipUint32 threadIndex)
+{
+    Job* pJob = FindJob(threadIndex);
+    if (pJob == nullptr)
+    {
+        return false;
+    }
+
+    AtomicOperations::Decrement(m_NumQueuedJobs);
+
+    ExecuteJob(pJob);
+
+    if (threadIndex != InvalidThreadIndex)
+    {
+        IncrementStatistic(m_pThreadContexts[threadIndex].numJobsExecuted);
+    }
+
+    return true;
+}
+
+void JobSystem::WorkerThreadFunction(shipUint32 threadIndex)
+{
+    t_JobSystemThread.pJobSystem = this;
+    t_JobSystemThread.threadIndex = threadIndex;
+
+    shipUint32 numIdleIterations = 0;
+
+    while (AtomicOperations::Load(m_IsRunning, MemoryOrder::Relaxed) != 0)
+    {
+        if (RunOneJob(threadIndex))
+        {
+            numIdleIterations = 0;
+            continue;
+        }
+
+        numIdleIterations += 1;
+        if (numIdleIterations < NumIdleIterationsBeforeSleeping)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        numIdleIterations = 0;
+
+        std::unique_lock<std::mutex> lock(m_SleepLock);
+
+        // Counted before checking for jobs, so that ScheduleJob either sees this thread sleeping or its job is seen here.
+        AtomicOperations::Increment(m_NumSleepingThreads);
+
+        while (AtomicOperations::Load(m_NumQueuedJobs) == 0 && AtomicOperations::Load(m_IsRunning) != 0)
+        {
+            m_SleepCondition.wait(lock);
+        }
+
+        AtomicOperations::Decrement(m_NumSleepingThreads);
+    }
+
+    t_JobSystemThread = JobSystemThread();
+}
+
+SHIPYARD_SYSTEM_API JobSystem& GetJobSystem()
+{
+    return JobSystem::GetInstance();
+}
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <system/array.h>
+#include <system/atomicoperations.h>
+#include <system/workstealingdeque.h>
+
+#include <system/memory/poolallocator.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Shipyard
+{
+    class BaseAllocator;
+
+    struct Job;
+
+    // Counts the jobs started with it that aren't done yet. Jobs can also depend on a counter, in which case they only start
+    // once it reaches 0, allowing fork-join graphs without blocking any thread.
+    //
+    // A counter must outlive its jobs, which WaitForCounter ensures. It can be reused once done, jobs depending on it then
+    // waiting for it to reach 0 again.
+    class SHIPYARD_SYSTEM_API JobCounter
+    {
+        friend class JobSystem;
+
+    public:
+        JobCounter();
+        ~JobCounter();
+
+        JobCounter(const JobCounter& src) = delete;
+        JobCounter& operator= (const JobCounter& rhs) = delete;
+
+        // Also waits for the thread finishing the last job to be done with the counter.
+        shipBool IsDone() const
+        {
+            return (AtomicOperations::Load(m_State, MemoryOrder::Acquire) == 0);
+        }
+
+        shipUint32 GetNumPendingJobs() const
+        {
+            return (AtomicOperations::Load(m_State, MemoryOrder::Relaxed) & NumPendingJobsMask);
+        }
+
+    private:
+        // The number of pending jobs, the lock protecting the list of dependent jobs and whether that list is empty all share the
+        // same word, so that the last job clears them all at once and a waiter never sees the counter done while it's still used.
+        enum : shipUint32
+        {
+            LockedFlag = 0x80000000,
+            HasDependentJobsFlag = 0x40000000,
+            NumPendingJobsMask = 0x3FFFFFFF
+        };
+
+        volatile shipUint32 m_State;
+        Job* m_pFirstDependentJob;
+    };
+
+    using JobFunction = void (*)(void* pUserData);
+
+    struct SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) Job
+    {
+        void (*pEntryPoint)(Job* pJob);
+        JobCounter* pCounter;
+
+        // Next job in a counter's dependent jobs, or in the job system's queue of jobs run by other threads.
+        Job* pNextJob;
+
+        // Functions passed to JobSystem::Run are copied here.
+        SHIP_ALIGN(8) shipUint8 data[40];
+    };
+
+    // Runs jobs on a fixed pool of worker threads, one per hardware thread, the thread that creates the job system counting as
+    // one of them.
+    //
+    // Each thread pushes the jobs it runs to its own WorkStealingDeque, and executes them in LIFO order. Threads running out of
+    // jobs steal the oldest ones of other threads, starting at a random thread, and go to sleep after a while if there's still
+    // nothing to run. Jobs run from threads outside of the job system go through a shared queue.
+    //
+    // Jobs are allocated from a lock-free PoolAllocator. When it's empty, or when the deque of the calling thread is full, the
+    // job is executed right away by the calling thread instead.
+    class SHIPYARD_SYSTEM_API JobSystem
+    {
+    public:
+        static const shipUint32 MaxNumThreads = 64;
+        static const shipUint32 MaxNumQueuedJobsPerThread = 4096;
+        static const shipUint32 InvalidThreadIndex = shipUint32(-1);
+
+        // Largest function that Run can copy in a job.
+        static const size_t MaxJobFunctionSize = sizeof(Job::data);
+
+        struct Statistics
+        {
+            // Jobs run by threads outside of the job system while waiting aren't counted.
+            shipUint64 numJobsExecuted = 0;
+            shipUint64 numJobsStolen = 0;
+            shipUint64 numJobsExecutedInline = 0;
+        };
+
+    public:
+        static JobSystem& GetInstance()
+        {
+            static JobSystem s_JobSystem;
+            return s_JobSystem;
+        }
+
+        JobSystem();
+        ~JobSystem();
+
+        JobSystem(const JobSystem& src) = delete;
+        JobSystem& operator= (const JobSystem& rhs) = delete;
+
+        // numThreads includes the calling thread, and is the number of hardware threads when 0. Up to maxNumJobs jobs can be
+        // pending at once, they're allocated from pAllocator, or from the global allocator if it's null.
+        shipBool Create(shipUint32 numThreads = 0, shipUint32 maxNumJobs = 4096, BaseAllocator* pAllocator = nullptr);
+
+        // Must be called from the thread that created the job system, once every job is done.
+        void Destroy();
+
+        // pUserData must stay valid until the job is done.
+        void Run(JobFunction pFunction, void* pUserData, JobCounter* pCounter = nullptr, JobCounter* pDependencyCounter = nullptr);
+
+        // function is copied in the job, and called without arguments. It's started once pDependencyCounter is done, if any.
+        template <typename Function>
+        void Run(const Function& function, JobCounter* pCounter = nullptr, JobCounter* pDependencyCounter = nullptr);
+
+        // Runs jobs on the calling thread until the counter is done, so that waiting from a job doesn't take a thread away.
+        void WaitForCounter(const JobCounter& counter);
+
+        // Calls function(index) for every index in [begin, end), in batches of up to batchSize indices each run as a job. The
+        // calling thread runs jobs until every batch is done. batchSize is picked from the number of threads when 0.
+        template <typename Function>
+        void ParallelFor(shipUint32 begin, shipUint32 end, const Function& function, shipUint32 batchSize = 0);
+
+        // Calls function(element) for every element of the array.
+        template <typename T, size_t alignment, typename GrowthPolicy, typename Function>
+        void ParallelFor(Array<T, alignment, GrowthPolicy>& elements, const Function& function, shipUint32 batchSize = 0);
+
+        template <typename T, size_t alignment, typename GrowthPolicy, typename Function>
+        void ParallelFor(const Array<T, alignment, GrowthPolicy>& elements, const Function& function, shipUint32 batchSize = 0);
+
+        shipUint32 GetNumThreads() const { return m_NumThreads; }
+
+        // 0 for the thread that created the job system, InvalidThreadIndex for threads outside of the job system.
+        shipUint32 GetCurrentThreadIndex() const;
+
+        Statistics GetStatistics() const;
+
+    private:
+        struct SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) ThreadContext
+        {
+            WorkStealingDeque<Job*, MaxNumQueuedJobsPerThread> jobQueue;
+            std::thread thread;
+
+            // Only written by the owning thread.
+            volatile shipUint64 numJobsExecuted = 0;
+            volatile shipUint64 numJobsStolen = 0;
+            volatile shipUint64 numJobsExecutedInline = 0;
+
+            shipUint32 randomState = 0;
+        };
+
+    private:
+        Job* AllocateJob();
+
+        // Increments pCounter, and schedules the job once pDependencyCounter is done.
+        void SubmitJob(Job* pJob, JobCounter* pCounter, JobCounter* pDependencyCounter);
+        void ScheduleJob(Job* pJob);
+
+        // Returns false if the counter was already done, in which case the job wasn't added.
+        shipBool AddDependentJob(JobCounter& dependencyCounter, Job* pJob);
+
+        void ExecuteJob(Job* pJob);
+        void FinishJob(JobCounter& counter);
+
+        Job* FindJob(shipUint32 threadIndex);
+        shipBool RunOneJob(shipUint32 threadIndex);
+
+        void WorkerThreadFunction(shipUint32 threadIndex);
+
+        template <typename Function>
+        static void RunFunctionJob(Job* pJob);
+
+    private:
+        ThreadContext* m_pThreadContexts;
+        shipUint32 m_NumThreads;
+
+        BaseAllocator* m_pAllocator;
+        void* m_pJobPoolHeap;
+        PoolAllocator m_JobPool;
+
+        // Jobs run by threads outside of the job system, in FIFO order.
+        std::mutex m_ExternalJobsLock;
+        Job* m_pFirstExternalJob;
+        Job* m_pLastExternalJob;
+        volatile shipUint32 m_NumExternalJobs;
+
+        // Jobs scheduled and not taken yet by a thread, which sleeping threads check before going to sleep.
+        volatile shipUint32 m_NumQueuedJobs;
+        volatile shipUint32 m_NumSleepingThreads;
+
+        std::mutex m_SleepLock;
+        std::condition_variable m_SleepCondition;
+
+        volatile shipUint32 m_IsRunning;
+    };
+
+    SHIPYARD_SYSTEM_API JobSystem& GetJobSystem();
+}
+
+#include <system/jobsystem.inl>
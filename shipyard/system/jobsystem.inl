@@ -0,0 +1,121 @@
+#include <system/systemdebug.h>
+
+#include <new>
+
+namespace Shipyard
+{;
+
+template <typename Function>
+void JobSystem::RunFunctionJob(Job* pJob)
+{
+    Function& function = *reinterpret_cast<Function*>(pJob->data);
+
+    function();
+
+    function.~Function();
+}
+
+template <typename Function>
+void JobSystem::Run(const Function& function, JobCounter* pCounter, JobCounter* pDependencyCounter)
+{
+    static_assert(sizeof(Function) <= MaxJobFunctionSize, "Function is too large to be copied in a job, capture less or capture by reference");
+    static_assert(alignof(Function) <= 8, "Function requires a larger alignment than jobs provide");
+
+    Job* pJob = AllocateJob();
+
+    if (pJob == nullptr)
+    {
+        if (pDependencyCounter != nullptr)
+        {
+            WaitForCounter(*pDependencyCounter);
+        }
+
+        function();
+        return;
+    }
+
+    new (pJob->data) Function(function);
+    pJob->pEntryPoint = &RunFunctionJob<Function>;
+
+    SubmitJob(pJob, pCounter, pDependencyCounter);
+}
+
+template <typename Function>
+void JobSystem::ParallelFor(shipUint32 begin, shipUint32 end, const Function& function, shipUint32 batchSize)
+{
+    SHIP_ASSERT_MSG(m_pThreadContexts != nullptr, "JobSystem used before being created");
+
+    if (begin >= end)
+    {
+        return;
+    }
+
+    shipUint32 numIndices = end - begin;
+
+    if (batchSize == 0)
+    {
+        // A few batches per thread, so that threads finishing early have some left to steal.
+        batchSize = MAX(numIndices / (m_NumThreads * 4), 1u);
+    }
+
+    shipUint32 numBatches = numIndices / batchSize + ((numIndices % batchSize) != 0);
+
+    JobCounter counter;
+
+    for (shipUint32 i = 1; i < numBatches; i++)
+    {
+        shipUint32 batchBegin = begin + i * batchSize;
+        shipUint32 batchEnd = ((end - batchBegin) > batchSize) ? (batchBegin + batchSize) : end;
+
+        Run([&function, batchBegin, batchEnd]()
+        {
+            for (shipUint32 index = batchBegin; index < batchEnd; index++)
+            {
+                function(index);
+            }
+        }, &counter);
+    }
+
+    // The first batch is run right away, the others are likely to still be there when it's done unless other threads stole them.
+    shipUint32 firstBatchEnd = (numIndices > batchSize) ? (begin + batchSize) : end;
+    for (shipUint32 index = begin; index < firstBatchEnd; index++)
+    {
+        function(index);
+    }
+
+    WaitForCounter(counter);
+}
+
+template <typename T, size_t alignment, typename GrowthPolicy, typename Function>
+void JobSystem::ParallelFor(Array<T, alignment, GrowthPolicy>& elements, const Function& function, shipUint32 batchSize)
+{
+    if (elements.Empty())
+    {
+        return;
+    }
+
+    T* pElements = &elements[0];
+
+    ParallelFor(0, elements.Size(), [pElements, &function](shipUint32 index)
+    {
+        function(pElements[index]);
+    }, batchSize);
+}
+
+template <typename T, size_t alignment, typename GrowthPolicy, typename Function>
+void JobSystem::ParallelFor(const Array<T, alignment, GrowthPolicy>& elements, const Function& function, shipUint32 batchSize)
+{
+    if (elements.Empty())
+    {
+        return;
+    }
+
+    const T* pElements = &elements[0];
+
+    ParallelFor(0, elements.Size(), [pElements, &function](shipUint32 index)
+    {
+        function(pElements[index]);
+    }, batchSize);
+}
+
+}
@@ -4,14 +4,181 @@
 
 #ifdef SHIP_ENABLE_LOGGING
 
+#include <system/atomicoperations.h>
+#include <system/ringbuffer.h>
 #include <system/systemcommon.h>
 
+#if PLATFORM == PLATFORM_WINDOWS
+#include <windows.h>
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+
+#include <chrono>
+#include <csignal>
+
 namespace Shipyard
 {;
 
+namespace
+{
+    constexpr shipUint32 LogRingBufferSize = 64 * 1024;
+    constexpr shipUint32 MaxNumLogRingBuffers = 32;
+    constexpr shipUint32 InvalidLogRingBufferIndex = shipUint32(-1);
+    constexpr shipUint32 WriterThreadWakeUpIntervalInMs = 20;
+
+    using LogRingBuffer = SPSCRingBuffer<LogRingBufferSize>;
+
+    // Followed by the message for preformatted records, or by the encoded arguments of the call site otherwise.
+    struct LogRecordHeader
+    {
+        shipUint64 timestamp;
+        shipUint32 callSiteId;
+        LogLevel logLevel;
+    };
+
+    // The ring buffers don't use the engine's allocators, since threads can log before they are created or after they are
+    // destroyed.
+    struct LogRingBuffers
+    {
+        LogRingBuffers()
+            : numRingBuffersUsed(0)
+            , numDroppedMessages(0)
+        {
+            for (volatile shipUint32& isOwned : isRingBufferOwned)
+            {
+                isOwned = 0;
+            }
+        }
+
+        LogRingBuffer ringBuffers[MaxNumLogRingBuffers];
+        volatile shipUint32 isRingBufferOwned[MaxNumLogRingBuffers];
+
+        // Only the ring buffers below this index were ever used.
+        volatile shipUint32 numRingBuffersUsed;
+
+        volatile shipUint64 numDroppedMessages;
+    };
+
+    LogRingBuffers& GetLogRingBuffers()
+    {
+        static LogRingBuffers s_LogRingBuffers;
+        return s_LogRingBuffers;
+    }
+
+    // Gives its ring buffer back when the thread exits. The messages left in it are still written, the next thread taking the
+    // ring buffer adds its messages after them.
+    struct ThreadLogRingBuffer
+    {
+        ~ThreadLogRingBuffer()
+        {
+            if (ringBufferIndex != InvalidLogRingBufferIndex)
+            {
+                AtomicOperations::Exchange(GetLogRingBuffers().isRingBufferOwned[ringBufferIndex], 0u);
+            }
+        }
+
+        shipUint32 ringBufferIndex = InvalidLogRingBufferIndex;
+    };
+
+    thread_local ThreadLogRingBuffer t_ThreadLogRingBuffer;
+
+    LogRingBuffer* GetThreadLogRingBuffer()
+    {
+        LogRingBuffers& logRingBuffers = GetLogRingBuffers();
+
+        if (t_ThreadLogRingBuffer.ringBufferIndex == InvalidLogRingBufferIndex)
+        {
+            for (shipUint32 i = 0; i < MaxNumLogRingBuffers; i++)
+            {
+                if (AtomicOperations::CompareExchange(logRingBuffers.isRingBufferOwned[i], 1u, 0u) == 0)
+                {
+                    t_ThreadLogRingBuffer.ringBufferIndex = i;
+                    break;
+                }
+            }
+
+            if (t_ThreadLogRingBuffer.ringBufferIndex == InvalidLogRingBufferIndex)
+            {
+                return nullptr;
+            }
+
+            shipUint32 numRingBuffersUsed = logRingBuffers.numRingBuffersUsed;
+            while (numRingBuffersUsed <= t_ThreadLogRingBuffer.ringBufferIndex)
+            {
+                numRingBuffersUsed = AtomicOperations::CompareExchange(logRingBuffers.numRingBuffersUsed, t_ThreadLogRingBuffer.ringBufferIndex + 1, numRingBuffersUsed);
+            }
+        }
+
+        return &logRingBuffers.ringBuffers[t_ThreadLogRingBuffer.ringBufferIndex];
+    }
+
+    template <typename T>
+    void WriteBinaryLogValue(std::ofstream& logFile, const T& value)
+    {
+        logFile.write(reinterpret_cast<const shipChar*>(&value), sizeof(T));
+    }
+
+    // Crash handlers aren't restricted to async-signal-safe functions, writing the log is worth the risk once the program is
+    // going down anyway.
+    void (*g_PreviousAbortHandler)(int) = SIG_DFL;
+
+    void FlushLogOnAbort(int signal)
+    {
+        GetLogger().FlushOnCrash();
+
+        if (g_PreviousAbortHandler != SIG_DFL && g_PreviousAbortHandler != SIG_IGN && g_PreviousAbortHandler != SIG_ERR)
+        {
+            g_PreviousAbortHandler(signal);
+        }
+    }
+
+#if PLATFORM == PLATFORM_WINDOWS
+    LPTOP_LEVEL_EXCEPTION_FILTER g_PreviousUnhandledExceptionFilter = nullptr;
+
+    LONG WINAPI FlushLogOnUnhandledException(EXCEPTION_POINTERS* pExceptionPointers)
+    {
+        GetLogger().FlushOnCrash();
+
+        if (g_PreviousUnhandledExceptionFilter != nullptr)
+        {
+            return g_PreviousUnhandledExceptionFilter(pExceptionPointers);
+        }
+
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+
+    void InstallCrashHandlers()
+    {
+        g_PreviousAbortHandler = signal(SIGABRT, &FlushLogOnAbort);
+
+#if PLATFORM == PLATFORM_WINDOWS
+        g_PreviousUnhandledExceptionFilter = SetUnhandledExceptionFilter(&FlushLogOnUnhandledException);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+
+    void UninstallCrashHandlers()
+    {
+        signal(SIGABRT, (g_PreviousAbortHandler != SIG_ERR) ? g_PreviousAbortHandler : SIG_DFL);
+
+#if PLATFORM == PLATFORM_WINDOWS
+        SetUnhandledExceptionFilter(g_PreviousUnhandledExceptionFilter);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+}
+
 Logger::Logger()
-    : m_LogLevel(LogLevel(LogLevel_Error | LogLevel_Warning))
-    , m_IsLogOpen(false)
+    : m_LogFileFormat(LogFileFormat::Text)
+    , m_LogLevel(LogLevel(LogLevel_Error | LogLevel_Warning))
+    , m_FlushPolicy(LogFlushPolicy::EveryBatch)
+    , m_FlushIntervalInMs(1000)
+    , m_LastFlushTimestamp(0)
+    , m_IsLogOpen(0)
+    , m_IsWriterThreadRunning(0)
+    , m_NumReportedDroppedMessages(0)
 {
 }
 
@@ -20,26 +187,79 @@ Logger::~Logger()
     CloseLog();
 }
 
-shipBool Logger::OpenLog(const shipChar* pLogFilename)
+shipBool Logger::OpenLog(const shipChar* pLogFilename, LogFileFormat logFileFormat)
 {
     CloseLog();
 
-    m_LogFile.open(pLogFilename, std::ios_base::ate | std::ios_base::out);
+    std::ios_base::openmode openMode = (std::ios_base::ate | std::ios_base::out);
+    if (logFileFormat == LogFileFormat::Binary)
+    {
+        openMode |= std::ios_base::binary;
+    }
+
+    m_LogFile.open(pLogFilename, openMode);
     if (!m_LogFile.is_open())
     {
         return false;
     }
 
-    m_IsLogOpen = true;
+    m_LogFileFormat = logFileFormat;
+
+    if (m_LogFileFormat == LogFileFormat::Binary)
+    {
+        BinaryLogFileHeader fileHeader;
+        fileHeader.magic = BinaryLogFileMagic;
+        fileHeader.version = BinaryLogFileVersion;
+
+        WriteBinaryLogValue(m_LogFile, fileHeader);
+
+        memset(m_CallSitesWrittenToLogFile, 0, sizeof(m_CallSitesWrittenToLogFile));
+    }
+
+    // Makes sure the ring buffers exist before a crash handler needs them.
+    GetLogRingBuffers();
+
+    m_NumReportedDroppedMessages = GetNumDroppedMessages();
+    m_LastFlushTimestamp = GetCurrentTimestamp();
+
+    m_IsWriterThreadRunning = 1;
+    m_WriterThread = std::thread(&Logger::WriterThreadFunction, this);
+
+    InstallCrashHandlers();
+
+    AtomicOperations::Exchange(m_IsLogOpen, 1u);
 
     return true;
 }
 
 void Logger::CloseLog()
 {
-    m_LogFile.close();
+    if (!m_WriterThread.joinable())
+    {
+        return;
+    }
+
+    AtomicOperations::Exchange(m_IsLogOpen, 0u);
 
-    m_IsLogOpen = false;
+    UninstallCrashHandlers();
+
+    {
+        std::lock_guard<std::mutex> lock(m_WriterLock);
+        m_IsWriterThreadRunning = 0;
+    }
+
+    m_WriterCondition.notify_one();
+    m_WriterThread.join();
+
+    {
+        std::lock_guard<std::mutex> drainLock(m_DrainLock);
+
+        shipBool wroteErrors = false;
+        WriteMessagesFromRingBuffers(&wroteErrors);
+        WriteNumDroppedMessages();
+
+        m_LogFile.close();
+    }
 }
 
 void Logger::SetLogLevel(LogLevel logLevel)
@@ -47,31 +267,80 @@ void Logger::SetLogLevel(LogLevel logLevel)
     m_LogLevel = logLevel;
 }
 
-void GetCurrentTimeForLog(StringA& currentTimeForLog)
+void Logger::SetFlushPolicy(LogFlushPolicy flushPolicy, shipUint32 flushIntervalInMs)
+{
+    m_FlushPolicy = flushPolicy;
+    m_FlushIntervalInMs = flushIntervalInMs;
+}
+
+void Logger::Log(LogLevel logLevel, const shipChar* pMessage, va_list argsPtr)
+{
+    shipChar messageBuffer[MaxLogMessageSize];
+    int numChars = vsnprintf_s(messageBuffer, MaxLogMessageSize, MaxLogMessageSize - 1, pMessage, argsPtr);
+
+    // Truncated messages are still logged.
+    size_t messageLength = ((numChars < 0) ? strlen(messageBuffer) : MIN(size_t(numChars), size_t(MaxLogMessageSize - 1)));
+
+    shipUint8* pRecordMessage = BeginLogRecord(InvalidLogCallSiteId, logLevel, messageLength);
+    if (pRecordMessage == nullptr)
+    {
+        return;
+    }
+
+    memcpy(pRecordMessage, messageBuffer, messageLength);
+
+    EndLogRecord(logLevel);
+}
+
+void Logger::LogFormatted(LogLevel logLevel, const shipChar* pMessage, ...)
 {
-    currentTimeForLog.Reserve(32);
+    va_list argsPtr;
+    va_start(argsPtr, pMessage);
 
-    GetCurrentTimeFullyFormatted(currentTimeForLog);
+    Log(logLevel, pMessage, argsPtr);
 
-    currentTimeForLog += " - ";
+    va_end(argsPtr);
 }
 
-void Log(std::ofstream& file, const shipChar* pHeader, const shipChar* pMessage, va_list argPtr)
+shipUint8* Logger::BeginLogRecord(shipUint32 callSiteId, LogLevel logLevel, size_t payloadSize)
 {
-    StringA currentTime;
-    GetCurrentTimeForLog(currentTime);
+    LogRecordHeader recordHeader;
+    recordHeader.timestamp = GetCurrentTimestamp();
+    recordHeader.callSiteId = callSiteId;
+    recordHeader.logLevel = logLevel;
 
-    constexpr int maxCount = 4096;
-    shipChar pBuffer[maxCount];
+    LogRingBuffer* pRingBuffer = GetThreadLogRingBuffer();
+    if (pRingBuffer == nullptr || payloadSize > LogRingBuffer::MaxRecordSize - sizeof(LogRecordHeader))
+    {
+        AtomicOperations::Increment(GetLogRingBuffers().numDroppedMessages);
+        return nullptr;
+    }
 
-    vsnprintf_s(pBuffer, maxCount, maxCount - 1, pMessage, argPtr);
+    shipUint8* pRecord = reinterpret_cast<shipUint8*>(pRingBuffer->BeginWrite(shipUint32(sizeof(LogRecordHeader) + payloadSize)));
+    if (pRecord == nullptr)
+    {
+        AtomicOperations::Increment(GetLogRingBuffers().numDroppedMessages);
 
-    file << currentTime.GetBuffer() << pHeader << pBuffer << std::endl;
+        m_WriterCondition.notify_one();
+        return nullptr;
+    }
 
-    shipChar outputBuffer[8192];
-    sprintf_s(outputBuffer, "%s%s\n", pHeader, pBuffer);
+    memcpy(pRecord, &recordHeader, sizeof(LogRecordHeader));
 
-    OutputDebugString(outputBuffer);
+    return (pRecord + sizeof(LogRecordHeader));
+}
+
+void Logger::EndLogRecord(LogLevel logLevel)
+{
+    LogRingBuffer* pRingBuffer = GetThreadLogRingBuffer();
+
+    pRingBuffer->EndWrite();
+
+    // Errors are written right away, and the writer is woken up before the ring buffer fills up.
+    if (logLevel == LogLevel_Error || pRingBuffer->GetNumBytesUsed() > LogRingBufferSize / 2)
+    {
+        m_WriterCondition.notify_one();
+    }
 }
 
 void Logger::LogDebug(const shipChar* pMessage, ...)
@@ -81,16 +350,12 @@ void Logger::LogDebug(const shipChar* pMessage, ...)
         return;
     }
 
-    m_LoggerLock.lock();
-
     va_list argsPtr;
     va_start(argsPtr, pMessage);
 
-    Log(m_LogFile, " [DEBUG]   ", pMessage, argsPtr);
+    Log(LogLevel_Debug, pMessage, argsPtr);
 
     va_end(argsPtr);
-
-    m_LoggerLock.unlock();
 }
 
 void Logger::LogInfo(const shipChar* pMessage, ...)
@@ -100,16 +365,12 @@ void Logger::LogInfo(const shipChar* pMessage, ...)
         return;
     }
 
-    m_LoggerLock.lock();
-
     va_list argsPtr;
     va_start(argsPtr, pMessage);
 
-    Log(m_LogFile, " [INFO]    ", pMessage, argsPtr);
+    Log(LogLevel_Info, pMessage, argsPtr);
 
     va_end(argsPtr);
-
-    m_LoggerLock.unlock();
 }
 
 void Logger::LogWarning(const shipChar* pMessage, ...)
@@ -119,16 +380,12 @@ void Logger::LogWarning(const shipChar* pMessage, ...)
         return;
     }
 
-    m_LoggerLock.lock();
-
     va_list argsPtr;
     va_start(argsPtr, pMessage);
 
-    Log(m_LogFile, " [WARNING] ", pMessage, argsPtr);
+    Log(LogLevel_Warning, pMessage, argsPtr);
 
     va_end(argsPtr);
-
-    m_LoggerLock.unlock();
 }
 
 void Logger::LogError(const shipChar* pMessage, ...)
@@ -138,16 +395,276 @@ void Logger::LogError(const shipChar* pMessage, ...)
         return;
     }
 
-    m_LoggerLock.lock();
-
     va_list argsPtr;
     va_start(argsPtr, pMessage);
 
-    Log(m_LogFile, " [ERROR]   ", pMessage, argsPtr);
+    Log(LogLevel_Error, pMessage, argsPtr);
 
     va_end(argsPtr);
+}
+
+void Logger::Flush()
+{
+    if (!m_IsLogOpen)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> drainLock(m_DrainLock);
+
+    shipBool wroteErrors = false;
+    WriteMessagesFromRingBuffers(&wroteErrors);
+    WriteNumDroppedMessages();
+
+    m_LogFile.flush();
+
+    m_LastFlushTimestamp = GetCurrentTimestamp();
+}
+
+void Logger::FlushOnCrash()
+{
+    if (!m_IsLogOpen)
+    {
+        return;
+    }
+
+    // The writer thread may be in the middle of a batch, it is given some time to finish it. If the crashing thread is the one
+    // holding the lock, the messages are lost.
+    shipBool lockedDrainLock = false;
+    for (shipUint32 i = 0; i < 100 && !lockedDrainLock; i++)
+    {
+        lockedDrainLock = m_DrainLock.try_lock();
+
+        if (!lockedDrainLock)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    if (!lockedDrainLock)
+    {
+        return;
+    }
+
+    shipBool wroteErrors = false;
+    WriteMessagesFromRingBuffers(&wroteErrors);
+    WriteNumDroppedMessages();
+
+    m_LogFile.flush();
+
+    m_DrainLock.unlock();
+}
+
+shipUint64 Logger::GetNumDroppedMessages() const
+{
+    return GetLogRingBuffers().numDroppedMessages;
+}
+
+void Logger::WriterThreadFunction()
+{
+    while (m_IsWriterThreadRunning)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_WriterLock);
+
+            if (m_IsWriterThreadRunning)
+            {
+                m_WriterCondition.wait_for(lock, std::chrono::milliseconds(WriterThreadWakeUpIntervalInMs));
+            }
+        }
+
+        std::lock_guard<std::mutex> drainLock(m_DrainLock);
+
+        shipBool wroteErrors = false;
+        shipBool wroteMessages = WriteMessagesFromRingBuffers(&wroteErrors);
+
+        WriteNumDroppedMessages();
+
+        if (!wroteMessages)
+        {
+            continue;
+        }
+
+        shipBool flushLogFile = false;
+        shipUint64 currentTimestamp = GetCurrentTimestamp();
+
+        switch (m_FlushPolicy)
+        {
+        case LogFlushPolicy::EveryBatch:
+            flushLogFile = true;
+            break;
+
+        case LogFlushPolicy::Periodic:
+            // Timestamps are in 100 nanoseconds intervals.
+            flushLogFile = (wroteErrors || (currentTimestamp - m_LastFlushTimestamp) >= shipUint64(m_FlushIntervalInMs) * 10000);
+            break;
+
+        case LogFlushPolicy::OnClose:
+            break;
+        }
+
+        if (flushLogFile)
+        {
+            m_LogFile.flush();
+
+            m_LastFlushTimestamp = currentTimestamp;
+        }
+    }
+}
+
+shipBool Logger::WriteMessagesFromRingBuffers(shipBool* pWroteErrors)
+{
+    LogRingBuffers& logRingBuffers = GetLogRingBuffers();
+
+    shipUint32 numRingBuffersUsed = logRingBuffers.numRingBuffersUsed;
+
+    const shipUint8* nextRecords[MaxNumLogRingBuffers];
+    shipUint32 nextRecordSizes[MaxNumLogRingBuffers];
+
+    for (shipUint32 i = 0; i < numRingBuffersUsed; i++)
+    {
+        nextRecords[i] = reinterpret_cast<const shipUint8*>(logRingBuffers.ringBuffers[i].BeginRead(&nextRecordSizes[i]));
+    }
+
+    shipBool wroteMessages = false;
+
+    // Merges the messages of every thread, so that the log stays in order.
+    for (;;)
+    {
+        shipUint32 oldestRecordIndex = InvalidLogRingBufferIndex;
+        LogRecordHeader oldestRecordHeader;
+
+        for (shipUint32 i = 0; i < numRingBuffersUsed; i++)
+        {
+            if (nextRecords[i] == nullptr)
+            {
+                continue;
+            }
+
+            LogRecordHeader recordHeader;
+            memcpy(&recordHeader, nextRecords[i], sizeof(LogRecordHeader));
+
+            if (oldestRecordIndex == InvalidLogRingBufferIndex || recordHeader.timestamp < oldestRecordHeader.timestamp)
+            {
+                oldestRecordIndex = i;
+                oldestRecordHeader = recordHeader;
+            }
+        }
+
+        if (oldestRecordIndex == InvalidLogRingBufferIndex)
+        {
+            break;
+        }
+
+        const shipUint8* pPayload = nextRecords[oldestRecordIndex] + sizeof(LogRecordHeader);
+        size_t payloadSize = nextRecordSizes[oldestRecordIndex] - sizeof(LogRecordHeader);
+
+        const LogCallSite* pLogCallSite = GetLogCallSite(oldestRecordHeader.callSiteId);
+
+        if (pLogCallSite != nullptr)
+        {
+            WriteDeferredRecord(oldestRecordHeader.timestamp, *pLogCallSite, pPayload, payloadSize);
+        }
+        else
+        {
+            WriteRecord(oldestRecordHeader.timestamp, oldestRecordHeader.logLevel, reinterpret_cast<const shipChar*>(pPayload), payloadSize);
+        }
+
+        wroteMessages = true;
+        *pWroteErrors = (*pWroteErrors || oldestRecordHeader.logLevel == LogLevel_Error);
+
+        LogRingBuffer& ringBuffer = logRingBuffers.ringBuffers[oldestRecordIndex];
+        ringBuffer.EndRead();
+
+        nextRecords[oldestRecordIndex] = reinterpret_cast<const shipUint8*>(ringBuffer.BeginRead(&nextRecordSizes[oldestRecordIndex]));
+    }
+
+    return wroteMessages;
+}
+
+void Logger::WriteRecord(shipUint64 timestamp, LogLevel logLevel, const shipChar* pMessage, size_t messageLength)
+{
+    if (m_LogFileFormat == LogFileFormat::Binary)
+    {
+        WriteBinaryLogValue(m_LogFile, BinaryLogEntryType::Text);
+        WriteBinaryLogValue(m_LogFile, timestamp);
+        WriteBinaryLogValue(m_LogFile, logLevel);
+        WriteBinaryLogValue(m_LogFile, shipUint32(messageLength));
+        m_LogFile.write(pMessage, messageLength);
+
+        return;
+    }
+
+    shipChar timeBuffer[64];
+    shipUint32 timeLength = FormatTimestamp(timestamp, timeBuffer, sizeof(timeBuffer));
+
+    const shipChar* pHeader = GetLogLevelHeader(logLevel);
+
+    m_LogFile.write(timeBuffer, timeLength);
+    m_LogFile << " - " << pHeader;
+    m_LogFile.write(pMessage, messageLength);
+    m_LogFile << '\n';
+
+    shipChar outputBuffer[8192];
+    sprintf_s(outputBuffer, "%s%.*s\n", pHeader, int(messageLength), pMessage);
+
+    OutputDebugString(outputBuffer);
+}
+
+void Logger::WriteDeferredRecord(shipUint64 timestamp, const LogCallSite& logCallSite, const shipUint8* pArguments, size_t argumentsSize)
+{
+    if (m_LogFileFormat == LogFileFormat::Text)
+    {
+        size_t messageLength = FormatLogMessage(logCallSite.GetFormat(), pArguments, argumentsSize, m_FormattedMessageBuffer, MaxLogMessageSize);
+
+        WriteRecord(timestamp, logCallSite.GetLogLevel(), m_FormattedMessageBuffer, messageLength);
+
+        return;
+    }
+
+    shipUint32 callSiteId = logCallSite.GetId();
+    shipUint32 callSiteBit = (1u << (callSiteId % 32));
+
+    if ((m_CallSitesWrittenToLogFile[callSiteId / 32] & callSiteBit) == 0)
+    {
+        WriteBinaryCallSite(logCallSite);
+
+        m_CallSitesWrittenToLogFile[callSiteId / 32] |= callSiteBit;
+    }
+
+    WriteBinaryLogValue(m_LogFile, BinaryLogEntryType::Message);
+    WriteBinaryLogValue(m_LogFile, timestamp);
+    WriteBinaryLogValue(m_LogFile, callSiteId);
+    WriteBinaryLogValue(m_LogFile, shipUint32(argumentsSize));
+    m_LogFile.write(reinterpret_cast<const shipChar*>(pArguments), argumentsSize);
+}
+
+void Logger::WriteBinaryCallSite(const LogCallSite& logCallSite)
+{
+    const shipChar* pFormat = logCallSite.GetFormat();
+    shipUint32 formatLength = shipUint32(strlen(pFormat));
+
+    WriteBinaryLogValue(m_LogFile, BinaryLogEntryType::CallSite);
+    WriteBinaryLogValue(m_LogFile, logCallSite.GetId());
+    WriteBinaryLogValue(m_LogFile, logCallSite.GetLogLevel());
+    WriteBinaryLogValue(m_LogFile, formatLength);
+    m_LogFile.write(pFormat, formatLength);
+}
+
+void Logger::WriteNumDroppedMessages()
+{
+    shipUint64 numDroppedMessages = GetNumDroppedMessages();
+    if (numDroppedMessages == m_NumReportedDroppedMessages)
+    {
+        return;
+    }
+
+    shipChar message[128];
+    int messageLength = sprintf_s(message, "%llu messages were dropped, the log ring buffers were full.", numDroppedMessages - m_NumReportedDroppedMessages);
+
+    WriteRecord(GetCurrentTimestamp(), LogLevel_Warning, message, size_t(messageLength));
 
-    m_LoggerLock.unlock();
+    m_NumReportedDroppedMessages = numDroppedMessages;
 }
 
 SHIPYARD_SYSTEM_API Logger& GetLogger()
@@ -157,4 +674,4 @@ SHIPYARD_SYSTEM_API Logger& GetLogger()
 
 }
 
-#endif // #ifdef SHIP_ENABLE_LOGGING
\ No newline at end of file
+#endif // #ifdef SHIP_ENABLE_LOGGING
@@ -6,26 +6,54 @@
 
 #ifdef SHIP_ENABLE_LOGGING
 
+#include <system/logrecord.h>
 #include <system/string.h>
 
+#include <condition_variable>
+
 #include <fstream>
 
 #include <mutex>
 
+#include <thread>
+
 #include <stdarg.h>
 
 namespace Shipyard
 {
-    enum LogLevel : shipUint8
+    enum class LogFileFormat : shipUint8
+    {
+        Text,
+
+        // Messages logged with the SHIP_LOG_* macros are written unformatted, see DecodeBinaryLogFile. Nothing is sent to the
+        // debugger's output.
+        Binary
+    };
+
+    // When the log file is flushed to disk by the writer thread.
+    enum class LogFlushPolicy : shipUint8
     {
-        LogLevel_Debug = 0x01,
-        LogLevel_Info = 0x02,
-        LogLevel_Warning = 0x04,
-        LogLevel_Error = 0x08,
+        // After every batch of messages written.
+        EveryBatch,
 
-        LogLevel_FullLog = (LogLevel_Debug | LogLevel_Info | LogLevel_Warning | LogLevel_Error)
+        // At most once per flush interval, or right away when errors were written.
+        Periodic,
+
+        // Only when the log is closed, or when the program crashes.
+        OnClose
     };
 
+    // Logs are written asynchronously: messages are copied into a ring buffer owned by the calling thread, and a writer thread
+    // drains every ring buffer in batches to the log file, in timestamp order.
+    //
+    // The SHIP_LOG_* macros only copy their arguments, formatting is done by the writer thread, or by the log decoder for
+    // binary logs. LogDebug, LogInfo, LogWarning and LogError format their message on the calling thread.
+    //
+    // Messages are dropped when a thread's ring buffer is full, or when too many threads have logged. Dropped messages are
+    // counted, and reported in the log.
+    //
+    // While the log is open, aborts and unhandled exceptions write the messages left in the ring buffers before the program
+    // goes down.
     class SHIPYARD_SYSTEM_API Logger
     {
     public:
@@ -35,16 +63,34 @@ namespace Shipyard
             return s_Logger;
         }
 
-        shipBool OpenLog(const shipChar* pLogFilename);
+        shipBool OpenLog(const shipChar* pLogFilename, LogFileFormat logFileFormat = LogFileFormat::Text);
+
+        // Writes the messages still in the ring buffers before closing the file.
         void CloseLog();
 
         void SetLogLevel(LogLevel logLevel);
 
+        // flushIntervalInMs is only used by LogFlushPolicy::Periodic.
+        void SetFlushPolicy(LogFlushPolicy flushPolicy, shipUint32 flushIntervalInMs = 1000);
+
         void LogDebug(const shipChar* pMessage, ...);
         void LogInfo(const shipChar* pMessage, ...);
         void LogWarning(const shipChar* pMessage, ...);
         void LogError(const shipChar* pMessage, ...);
 
+        // Used by the SHIP_LOG_* macros.
+        template <typename... Args>
+        void LogDeferred(const LogCallSite& logCallSite, const Args&... args);
+
+        // Blocks until the messages logged before the call are written and flushed to the file.
+        void Flush();
+
+        // Writes the messages left in the ring buffers from the crashing thread. Called by the crash handlers installed when
+        // opening the log.
+        void FlushOnCrash();
+
+        shipUint64 GetNumDroppedMessages() const;
+
     private:
         Logger();
         ~Logger();
@@ -53,21 +99,65 @@ namespace Shipyard
         Logger(const Logger&& src) = delete;
         Logger& operator= (const Logger& rhs) = delete;
 
+        void Log(LogLevel logLevel, const shipChar* pMessage, va_list argsPtr);
+        void LogFormatted(LogLevel logLevel, const shipChar* pMessage, ...);
+
+        // Returns where the record's payload must be written, or nullptr if the message is dropped.
+        shipUint8* BeginLogRecord(shipUint32 callSiteId, LogLevel logLevel, size_t payloadSize);
+        void EndLogRecord(LogLevel logLevel);
+
+        void WriterThreadFunction();
+
+        // Returns true if messages were written. m_DrainLock must be held.
+        shipBool WriteMessagesFromRingBuffers(shipBool* pWroteErrors);
+        void WriteRecord(shipUint64 timestamp, LogLevel logLevel, const shipChar* pMessage, size_t messageLength);
+        void WriteDeferredRecord(shipUint64 timestamp, const LogCallSite& logCallSite, const shipUint8* pArguments, size_t argumentsSize);
+        void WriteBinaryCallSite(const LogCallSite& logCallSite);
+        void WriteNumDroppedMessages();
+
         std::ofstream m_LogFile;
+        LogFileFormat m_LogFileFormat;
         LogLevel m_LogLevel;
 
-        std::mutex m_LoggerLock;
+        LogFlushPolicy m_FlushPolicy;
+        shipUint32 m_FlushIntervalInMs;
+        shipUint64 m_LastFlushTimestamp;
+
+        std::thread m_WriterThread;
+        std::mutex m_WriterLock;
+        std::condition_variable m_WriterCondition;
 
-        shipBool m_IsLogOpen;
+        // Held while reading the ring buffers and writing to the file, which only one thread can do at a time.
+        std::mutex m_DrainLock;
+
+        volatile shipUint32 m_IsLogOpen;
+        volatile shipUint32 m_IsWriterThreadRunning;
+
+        shipUint64 m_NumReportedDroppedMessages;
+
+        // Binary logs write each call site once, before its first message.
+        shipUint32 m_CallSitesWrittenToLogFile[MaxNumLogCallSites / 32];
+
+        shipChar m_FormattedMessageBuffer[MaxLogMessageSize];
     };
 
     SHIPYARD_SYSTEM_API Logger& GetLogger();
 }
 
-#define SHIP_LOG_DEBUG(msg, ...) Shipyard::GetLogger().LogDebug(msg, __VA_ARGS__)
-#define SHIP_LOG_INFO(msg, ...) Shipyard::GetLogger().LogInfo(msg, __VA_ARGS__)
-#define SHIP_LOG_WARNING(msg, ...) Shipyard::GetLogger().LogWarning(msg, __VA_ARGS__)
-#define SHIP_LOG_ERROR(msg, ...) Shipyard::GetLogger().LogError(msg, __VA_ARGS__)
+#include <system/logger.inl>
+
+// Messages must be string literals, dynamic strings are logged with "%s".
+#define SHIP_LOG_INTERNAL(logLevel, msg, ...) \
+    do \
+    { \
+        static const Shipyard::LogCallSite s_ShipLogCallSite(logLevel, "" msg); \
+        Shipyard::GetLogger().LogDeferred(s_ShipLogCallSite, __VA_ARGS__); \
+    } while (false)
+
+#define SHIP_LOG_DEBUG(msg, ...) SHIP_LOG_INTERNAL(Shipyard::LogLevel_Debug, msg, __VA_ARGS__)
+#define SHIP_LOG_INFO(msg, ...) SHIP_LOG_INTERNAL(Shipyard::LogLevel_Info, msg, __VA_ARGS__)
+#define SHIP_LOG_WARNING(msg, ...) SHIP_LOG_INTERNAL(Shipyard::LogLevel_Warning, msg, __VA_ARGS__)
+#define SHIP_LOG_ERROR(msg, ...) SHIP_LOG_INTERNAL(Shipyard::LogLevel_Error, msg, __VA_ARGS__)
 
 #else
 
@@ -76,4 +166,4 @@ namespace Shipyard
 #define SHIP_LOG_WARNING(msg, ...)
 #define SHIP_LOG_ERROR(msg, ...)
 
-#endif // #ifdef SHIP_ENABLE_LOGGING
\ No newline at end of file
+#endif // #ifdef SHIP_ENABLE_LOGGING
@@ -0,0 +1,33 @@
+namespace Shipyard
+{;
+
+template <typename... Args>
+void Logger::LogDeferred(const LogCallSite& logCallSite, const Args&... args)
+{
+    LogLevel logLevel = logCallSite.GetLogLevel();
+
+    if ((m_LogLevel & logLevel) == 0 || !m_IsLogOpen)
+    {
+        return;
+    }
+
+    if (logCallSite.GetId() == InvalidLogCallSiteId)
+    {
+        LogFormatted(logLevel, logCallSite.GetFormat(), args...);
+        return;
+    }
+
+    size_t argumentsSize = LogRecordInternal::GetEncodedLogArgumentsSize(args...);
+
+    shipUint8* pArguments = BeginLogRecord(logCallSite.GetId(), logLevel, argumentsSize);
+    if (pArguments == nullptr)
+    {
+        return;
+    }
+
+    LogRecordInternal::EncodeLogArguments(pArguments, args...);
+
+    EndLogRecord(logLevel);
+}
+
+}
@@ -0,0 +1,755 @@
+#include <system/systemprecomp.h>
+
+#include <system/logrecord.h>
+
+#include <system/atomicoperations.h>
+#include <system/systemcommon.h>
+#include <system/systemdebug.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Shipyard
+{;
+
+namespace
+{
+    // Call sites are registered from static initializers of functions, the table must not need construction.
+    const LogCallSite* g_LogCallSites[MaxNumLogCallSites];
+    volatile shipUint32 g_NumLogCallSites = 0;
+
+    struct LogArgument
+    {
+        LogArgumentType type;
+
+        union
+        {
+            shipInt64 signedValue;
+            shipUint64 unsignedValue;
+            double doubleValue;
+        };
+
+        const shipChar* pString;
+    };
+
+    // Returns false on malformed arguments, the remaining arguments are then considered missing.
+    shipBool DecodeLogArgument(const shipUint8*& pArguments, const shipUint8* pArgumentsEnd, LogArgument& argument)
+    {
+        if (pArguments >= pArgumentsEnd)
+        {
+            return false;
+        }
+
+        argument.type = LogArgumentType(*pArguments);
+        argument.pString = nullptr;
+
+        const shipUint8* pValue = pArguments + sizeof(LogArgumentType);
+        size_t numBytesLeft = size_t(pArgumentsEnd - pValue);
+        size_t valueSize = 0;
+
+        switch (argument.type)
+        {
+        case LogArgumentType::Int32:
+        {
+            shipInt32 value = 0;
+            valueSize = sizeof(value);
+
+            if (numBytesLeft < valueSize)
+            {
+                return false;
+            }
+
+            memcpy(&value, pValue, valueSize);
+            argument.signedValue = value;
+            break;
+        }
+
+        case LogArgumentType::UInt32:
+        {
+            shipUint32 value = 0;
+            valueSize = sizeof(value);
+
+            if (numBytesLeft < valueSize)
+            {
+                return false;
+            }
+
+            memcpy(&value, pValue, valueSize);
+            argument.unsignedValue = value;
+            break;
+        }
+
+        case LogArgumentType::Int64:
+        case LogArgumentType::UInt64:
+        case LogArgumentType::Pointer:
+        case LogArgumentType::Double:
+            valueSize = sizeof(shipUint64);
+
+            if (numBytesLeft < valueSize)
+            {
+                return false;
+            }
+
+            memcpy(&argument.unsignedValue, pValue, valueSize);
+            break;
+
+        case LogArgumentType::String:
+        {
+            shipUint32 stringLength = 0;
+
+            if (numBytesLeft < sizeof(stringLength))
+            {
+                return false;
+            }
+
+            memcpy(&stringLength, pValue, sizeof(stringLength));
+            valueSize = sizeof(stringLength) + size_t(stringLength) + 1;
+
+            if (numBytesLeft < valueSize || pValue[valueSize - 1] != '\0')
+            {
+                return false;
+            }
+
+            argument.pString = reinterpret_cast<const shipChar*>(pValue + sizeof(stringLength));
+            break;
+        }
+
+        default:
+            return false;
+        }
+
+        pArguments = pValue + valueSize;
+
+        return true;
+    }
+
+    shipInt64 GetLogArgumentAsSignedInteger(const LogArgument& argument)
+    {
+        switch (argument.type)
+        {
+        case LogArgumentType::Int32:
+        case LogArgumentType::Int64:
+            return argument.signedValue;
+
+        case LogArgumentType::UInt32:
+        case LogArgumentType::UInt64:
+        case LogArgumentType::Pointer:
+            return shipInt64(argument.unsignedValue);
+
+        case LogArgumentType::Double:
+            return shipInt64(argument.doubleValue);
+        }
+
+        return 0;
+    }
+
+    // Only the length modifiers narrowing integers are kept, the others are implied by the argument's type.
+    enum class LogLengthModifier : shipUint8
+    {
+        None,
+        Short,
+        Char
+    };
+
+    // Int32 arguments are what printf would have been given, so they're narrowed as printf would. Other integers keep their full
+    // value, whatever the length modifier.
+    shipInt64 GetNarrowedLogArgumentAsSignedInteger(const LogArgument& argument, LogLengthModifier lengthModifier)
+    {
+        if (argument.type != LogArgumentType::Int32)
+        {
+            return GetLogArgumentAsSignedInteger(argument);
+        }
+
+        switch (lengthModifier)
+        {
+        case LogLengthModifier::Short:
+            return shipInt16(argument.signedValue);
+
+        case LogLengthModifier::Char:
+            return shipInt8(argument.signedValue);
+        }
+
+        return argument.signedValue;
+    }
+
+    shipUint64 GetNarrowedLogArgumentAsUnsignedInteger(const LogArgument& argument, LogLengthModifier lengthModifier)
+    {
+        if (argument.type != LogArgumentType::Int32)
+        {
+            return shipUint64(GetLogArgumentAsSignedInteger(argument));
+        }
+
+        switch (lengthModifier)
+        {
+        case LogLengthModifier::Short:
+            return shipUint16(argument.signedValue);
+
+        case LogLengthModifier::Char:
+            return shipUint8(argument.signedValue);
+        }
+
+        // Truncated before being widened, so that negative values aren't sign extended.
+        return shipUint32(argument.signedValue);
+    }
+
+    enum class LogConversionType : shipUint8
+    {
+        SignedInteger,
+        UnsignedInteger,
+        Character,
+        FloatingPoint,
+        String,
+        Pointer,
+        Count,
+        Unknown
+    };
+
+    LogConversionType GetLogConversionType(shipChar conversion)
+    {
+        switch (conversion)
+        {
+        case 'd': case 'i':
+            return LogConversionType::SignedInteger;
+
+        case 'u': case 'o': case 'x': case 'X':
+            return LogConversionType::UnsignedInteger;
+
+        case 'c':
+            return LogConversionType::Character;
+
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return LogConversionType::FloatingPoint;
+
+        case 's':
+            return LogConversionType::String;
+
+        case 'p':
+            return LogConversionType::Pointer;
+
+        case 'n':
+            return LogConversionType::Count;
+        }
+
+        return LogConversionType::Unknown;
+    }
+
+    shipBool IsLogArgumentCompatibleWithConversion(LogArgumentType argumentType, LogConversionType conversionType)
+    {
+        shipBool isIntegerArgument = (argumentType != LogArgumentType::Double && argumentType != LogArgumentType::String);
+
+        switch (conversionType)
+        {
+        case LogConversionType::SignedInteger:
+        case LogConversionType::UnsignedInteger:
+        case LogConversionType::Character:
+        case LogConversionType::Pointer:
+            return isIntegerArgument;
+
+        case LogConversionType::FloatingPoint:
+            return (argumentType == LogArgumentType::Double);
+
+        case LogConversionType::String:
+            return (argumentType == LogArgumentType::String);
+        }
+
+        return false;
+    }
+
+    // Conversion used for arguments that don't match their format's conversion.
+    shipChar GetLogArgumentDefaultConversion(LogArgumentType argumentType)
+    {
+        switch (argumentType)
+        {
+        case LogArgumentType::Int32:
+        case LogArgumentType::Int64:
+            return 'd';
+
+        case LogArgumentType::UInt32:
+        case LogArgumentType::UInt64:
+            return 'u';
+
+        case LogArgumentType::Double:
+            return 'g';
+
+        case LogArgumentType::String:
+            return 's';
+
+        case LogArgumentType::Pointer:
+            return 'p';
+        }
+
+        return 'u';
+    }
+
+    struct LogMessageWriter
+    {
+        LogMessageWriter(shipChar* pBuffer, size_t bufferSize)
+            : m_pBuffer(pBuffer)
+            , m_BufferSize(bufferSize)
+            , m_Length(0)
+        {
+            m_pBuffer[0] = '\0';
+        }
+
+        void Append(const shipChar* pString, size_t length)
+        {
+            size_t numCharsToCopy = MIN(length, m_BufferSize - 1 - m_Length);
+
+            memcpy(m_pBuffer + m_Length, pString, numCharsToCopy);
+            m_Length += numCharsToCopy;
+
+            m_pBuffer[m_Length] = '\0';
+        }
+
+        template <typename T>
+        void AppendFormatted(const shipChar* pFormat, T value)
+        {
+            int numChars = snprintf(m_pBuffer + m_Length, m_BufferSize - m_Length, pFormat, value);
+
+            if (numChars > 0)
+            {
+                m_Length = MIN(m_Length + size_t(numChars), m_BufferSize - 1);
+            }
+
+            m_pBuffer[m_Length] = '\0';
+        }
+
+        void AppendArgument(
+                shipChar* pConversionSpecification,
+                size_t conversionSpecificationLength,
+                shipChar conversion,
+                LogLengthModifier lengthModifier,
+                const LogArgument& argument)
+        {
+            // Every integer is formatted as 64 bits, once narrowed by the length modifier.
+            shipChar* pConversion = pConversionSpecification + conversionSpecificationLength;
+
+            switch (GetLogConversionType(conversion))
+            {
+            case LogConversionType::SignedInteger:
+                pConversion[0] = 'l';
+                pConversion[1] = 'l';
+                pConversion[2] = conversion;
+                pConversion[3] = '\0';
+
+                AppendFormatted(pConversionSpecification, (long long)GetNarrowedLogArgumentAsSignedInteger(argument, lengthModifier));
+                break;
+
+            case LogConversionType::UnsignedInteger:
+                pConversion[0] = 'l';
+                pConversion[1] = 'l';
+                pConversion[2] = conversion;
+                pConversion[3] = '\0';
+
+                AppendFormatted(pConversionSpecification, (unsigned long long)GetNarrowedLogArgumentAsUnsignedInteger(argument, lengthModifier));
+                break;
+
+            case LogConversionType::Character:
+                pConversion[0] = conversion;
+                pConversion[1] = '\0';
+
+                AppendFormatted(pConversionSpecification, int(GetLogArgumentAsSignedInteger(argument)));
+                break;
+
+            case LogConversionType::FloatingPoint:
+                pConversion[0] = conversion;
+                pConversion[1] = '\0';
+
+                AppendFormatted(pConversionSpecification, argument.doubleValue);
+                break;
+
+            case LogConversionType::String:
+                pConversion[0] = conversion;
+                pConversion[1] = '\0';
+
+                AppendFormatted(pConversionSpecification, argument.pString);
+                break;
+
+            case LogConversionType::Pointer:
+                pConversion[0] = conversion;
+                pConversion[1] = '\0';
+
+                AppendFormatted(pConversionSpecification, reinterpret_cast<const void*>(size_t(argument.unsignedValue)));
+                break;
+            }
+        }
+
+        shipChar* m_pBuffer;
+        size_t m_BufferSize;
+        size_t m_Length;
+    };
+
+    shipBool IsLogConversionFlag(shipChar c)
+    {
+        return (c == '-' || c == '+' || c == ' ' || c == '#' || c == '0');
+    }
+
+    shipBool IsLogLengthModifier(shipChar c)
+    {
+        return (c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L' || c == 'q' || c == 'I' || c == 'w');
+    }
+
+    shipBool IsDigit(shipChar c)
+    {
+        return (c >= '0' && c <= '9');
+    }
+}
+
+LogCallSite::LogCallSite(LogLevel logLevel, const shipChar* pFormat)
+    : m_pFormat(pFormat)
+    , m_Id(InvalidLogCallSiteId)
+    , m_LogLevel(logLevel)
+{
+    shipUint32 callSiteId = AtomicOperations::Increment(g_NumLogCallSites) - 1;
+
+    if (callSiteId < MaxNumLogCallSites)
+    {
+        g_LogCallSites[callSiteId] = this;
+        m_Id = callSiteId;
+    }
+}
+
+SHIPYARD_SYSTEM_API const LogCallSite* GetLogCallSite(shipUint32 callSiteId)
+{
+    if (callSiteId >= MaxNumLogCallSites)
+    {
+        return nullptr;
+    }
+
+    return g_LogCallSites[callSiteId];
+}
+
+SHIPYARD_SYSTEM_API size_t FormatLogMessage(
+        const shipChar* pFormat,
+        const shipUint8* pArguments,
+        size_t argumentsSize,
+        shipChar* pBuffer,
+        size_t bufferSize)
+{
+    SHIP_ASSERT(bufferSize > 0);
+
+    const shipUint8* pArgumentsEnd = pArguments + argumentsSize;
+    shipBool hasMoreArguments = true;
+
+    LogMessageWriter messageWriter(pBuffer, bufferSize);
+
+    const shipChar* pCurrent = pFormat;
+
+    while (*pCurrent != '\0')
+    {
+        const shipChar* pNextConversion = strchr(pCurrent, '%');
+        if (pNextConversion == nullptr)
+        {
+            messageWriter.Append(pCurrent, strlen(pCurrent));
+            break;
+        }
+
+        messageWriter.Append(pCurrent, size_t(pNextConversion - pCurrent));
+
+        pCurrent = pNextConversion + 1;
+
+        if (*pCurrent == '%')
+        {
+            messageWriter.Append("%", 1);
+            pCurrent += 1;
+            continue;
+        }
+
+        // Flags, width and precision are kept, length modifiers are replaced depending on the argument.
+        constexpr size_t maxConversionSpecificationLength = 64;
+        constexpr size_t maxConversionSpecificationPrefixLength = maxConversionSpecificationLength - 4;
+
+        shipChar conversionSpecification[maxConversionSpecificationLength];
+        size_t conversionSpecificationLength = 0;
+
+        conversionSpecification[conversionSpecificationLength++] = '%';
+
+        shipBool isMissingArgument = false;
+
+        // Once an argument is missing or malformed, every following argument is missing.
+        auto decodeNextArgument = [&](LogArgument& argument)
+        {
+            hasMoreArguments = (hasMoreArguments && DecodeLogArgument(pArguments, pArgumentsEnd, argument));
+            return hasMoreArguments;
+        };
+
+        auto appendToConversionSpecification = [&](shipChar c)
+        {
+            if (conversionSpecificationLength < maxConversionSpecificationPrefixLength)
+            {
+                conversionSpecification[conversionSpecificationLength++] = c;
+            }
+        };
+
+        // Widths and precisions given as arguments are written in the conversion specification.
+        auto appendArgumentToConversionSpecification = [&]()
+        {
+            LogArgument argument;
+            if (!decodeNextArgument(argument))
+            {
+                isMissingArgument = true;
+                return;
+            }
+
+            shipChar value[32];
+            int valueLength = snprintf(value, sizeof(value), "%d", int(GetLogArgumentAsSignedInteger(argument)));
+
+            for (int i = 0; i < valueLength; i++)
+            {
+                appendToConversionSpecification(value[i]);
+            }
+        };
+
+        while (IsLogConversionFlag(*pCurrent))
+        {
+            appendToConversionSpecification(*pCurrent++);
+        }
+
+        if (*pCurrent == '*')
+        {
+            appendArgumentToConversionSpecification();
+            pCurrent += 1;
+        }
+        else
+        {
+            while (IsDigit(*pCurrent))
+            {
+                appendToConversionSpecification(*pCurrent++);
+            }
+        }
+
+        if (*pCurrent == '.')
+        {
+            appendToConversionSpecification(*pCurrent++);
+
+            if (*pCurrent == '*')
+            {
+                appendArgumentToConversionSpecification();
+                pCurrent += 1;
+            }
+            else
+            {
+                while (IsDigit(*pCurrent))
+                {
+                    appendToConversionSpecification(*pCurrent++);
+                }
+            }
+        }
+
+        LogLengthModifier lengthModifier = LogLengthModifier::None;
+
+        while (IsLogLengthModifier(*pCurrent))
+        {
+            if (*pCurrent == 'h')
+            {
+                lengthModifier = ((lengthModifier == LogLengthModifier::None) ? LogLengthModifier::Short : LogLengthModifier::Char);
+            }
+
+            // MSVC's I32 and I64.
+            if (*pCurrent == 'I' && ((pCurrent[1] == '3' && pCurrent[2] == '2') || (pCurrent[1] == '6' && pCurrent[2] == '4')))
+            {
+                pCurrent += 2;
+            }
+
+            pCurrent += 1;
+        }
+
+        shipChar conversion = *pCurrent;
+        LogConversionType conversionType = GetLogConversionType(conversion);
+
+        if (conversion == '\0')
+        {
+            messageWriter.Append(pNextConversion, strlen(pNextConversion));
+            break;
+        }
+
+        pCurrent += 1;
+
+        if (conversionType == LogConversionType::Unknown)
+        {
+            messageWriter.Append(pNextConversion, size_t(pCurrent - pNextConversion));
+            continue;
+        }
+
+        LogArgument argument;
+        if (isMissingArgument || !decodeNextArgument(argument))
+        {
+            messageWriter.Append(pNextConversion, size_t(pCurrent - pNextConversion));
+            continue;
+        }
+
+        if (conversionType == LogConversionType::Count)
+        {
+            continue;
+        }
+
+        if (!IsLogArgumentCompatibleWithConversion(argument.type, conversionType))
+        {
+            conversion = GetLogArgumentDefaultConversion(argument.type);
+        }
+
+        messageWriter.AppendArgument(conversionSpecification, conversionSpecificationLength, conversion, lengthModifier, argument);
+    }
+
+    return messageWriter.m_Length;
+}
+
+SHIPYARD_SYSTEM_API const shipChar* GetLogLevelHeader(LogLevel logLevel)
+{
+    switch (logLevel)
+    {
+    case LogLevel_Debug:    return " [DEBUG]   ";
+    case LogLevel_Info:     return " [INFO]    ";
+    case LogLevel_Warning:  return " [WARNING] ";
+    case LogLevel_Error:    return " [ERROR]   ";
+    }
+
+    return " ";
+}
+
+namespace
+{
+    template <typename T>
+    shipBool ReadBinaryLogValue(std::ifstream& binaryLogFile, T& value)
+    {
+        return !!binaryLogFile.read(reinterpret_cast<shipChar*>(&value), sizeof(T));
+    }
+
+    shipBool ReadBinaryLogBytes(std::ifstream& binaryLogFile, shipUint32 numBytes, std::vector<shipUint8>& bytes)
+    {
+        bytes.resize(numBytes);
+
+        return (numBytes == 0 || !!binaryLogFile.read(reinterpret_cast<shipChar*>(bytes.data()), numBytes));
+    }
+
+    void WriteDecodedLogLine(std::ofstream& textLogFile, shipUint64 timestamp, LogLevel logLevel, const shipChar* pMessage, size_t messageLength)
+    {
+        shipChar timeBuffer[64];
+        shipUint32 timeLength = FormatTimestamp(timestamp, timeBuffer, sizeof(timeBuffer));
+
+        textLogFile.write(timeBuffer, timeLength);
+        textLogFile << " - " << GetLogLevelHeader(logLevel);
+        textLogFile.write(pMessage, messageLength);
+        textLogFile << '\n';
+    }
+}
+
+SHIPYARD_SYSTEM_API shipBool DecodeBinaryLogFile(const shipChar* pBinaryLogFilename, const shipChar* pTextLogFilename)
+{
+    std::ifstream binaryLogFile(pBinaryLogFilename, std::ios_base::in | std::ios_base::binary);
+    if (!binaryLogFile.is_open())
+    {
+        return false;
+    }
+
+    BinaryLogFileHeader fileHeader;
+    if (!ReadBinaryLogValue(binaryLogFile, fileHeader) || fileHeader.magic != BinaryLogFileMagic || fileHeader.version != BinaryLogFileVersion)
+    {
+        return false;
+    }
+
+    std::ofstream textLogFile(pTextLogFilename, std::ios_base::out);
+    if (!textLogFile.is_open())
+    {
+        return false;
+    }
+
+    // Call sites are indexed by their id in the program that wrote the log, which can't be reused here. Standard containers are
+    // used so that tools can decode logs without creating the engine's allocators.
+    struct DecodedCallSite
+    {
+        std::string format;
+        LogLevel logLevel = LogLevel_Error;
+        shipBool isValid = false;
+    };
+
+    std::vector<DecodedCallSite> callSites;
+    std::vector<shipUint8> entryBytes;
+
+    shipChar messageBuffer[MaxLogMessageSize];
+
+    shipUint8 entryType = 0;
+    while (ReadBinaryLogValue(binaryLogFile, entryType))
+    {
+        switch (BinaryLogEntryType(entryType))
+        {
+        case BinaryLogEntryType::CallSite:
+        {
+            shipUint32 callSiteId = 0;
+            LogLevel logLevel = LogLevel_Error;
+            shipUint32 formatLength = 0;
+
+            if (!ReadBinaryLogValue(binaryLogFile, callSiteId) || callSiteId >= MaxNumLogCallSites ||
+                !ReadBinaryLogValue(binaryLogFile, logLevel) ||
+                !ReadBinaryLogValue(binaryLogFile, formatLength) ||
+                !ReadBinaryLogBytes(binaryLogFile, formatLength, entryBytes))
+            {
+                return false;
+            }
+
+            if (callSiteId >= callSites.size())
+            {
+                callSites.resize(callSiteId + 1);
+            }
+
+            DecodedCallSite& callSite = callSites[callSiteId];
+            callSite.format.assign(reinterpret_cast<const shipChar*>(entryBytes.data()), formatLength);
+            callSite.logLevel = logLevel;
+            callSite.isValid = true;
+
+            break;
+        }
+
+        case BinaryLogEntryType::Message:
+        {
+            shipUint64 timestamp = 0;
+            shipUint32 callSiteId = 0;
+            shipUint32 argumentsSize = 0;
+
+            if (!ReadBinaryLogValue(binaryLogFile, timestamp) ||
+                !ReadBinaryLogValue(binaryLogFile, callSiteId) ||
+                !ReadBinaryLogValue(binaryLogFile, argumentsSize) ||
+                !ReadBinaryLogBytes(binaryLogFile, argumentsSize, entryBytes) ||
+                callSiteId >= callSites.size() || !callSites[callSiteId].isValid)
+            {
+                return false;
+            }
+
+            const DecodedCallSite& callSite = callSites[callSiteId];
+            size_t messageLength = FormatLogMessage(callSite.format.c_str(), entryBytes.data(), argumentsSize, messageBuffer, MaxLogMessageSize);
+
+            WriteDecodedLogLine(textLogFile, timestamp, callSite.logLevel, messageBuffer, messageLength);
+
+            break;
+        }
+
+        case BinaryLogEntryType::Text:
+        {
+            shipUint64 timestamp = 0;
+            LogLevel logLevel = LogLevel_Error;
+            shipUint32 textLength = 0;
+
+            if (!ReadBinaryLogValue(binaryLogFile, timestamp) ||
+                !ReadBinaryLogValue(binaryLogFile, logLevel) ||
+                !ReadBinaryLogValue(binaryLogFile, textLength) ||
+                !ReadBinaryLogBytes(binaryLogFile, textLength, entryBytes))
+            {
+                return false;
+            }
+
+            WriteDecodedLogLine(textLogFile, timestamp, logLevel, reinterpret_cast<const shipChar*>(entryBytes.data()), textLength);
+
+            break;
+        }
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
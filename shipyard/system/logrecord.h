@@ -0,0 +1,103 @@
+#pragma once
+
+#include <system/platform.h>
+
+#include <cstddef>
+
+namespace Shipyard
+{
+    enum LogLevel : shipUint8
+    {
+        LogLevel_Debug = 0x01,
+        LogLevel_Info = 0x02,
+        LogLevel_Warning = 0x04,
+        LogLevel_Error = 0x08,
+
+        LogLevel_FullLog = (LogLevel_Debug | LogLevel_Info | LogLevel_Warning | LogLevel_Error)
+    };
+
+    constexpr shipUint32 MaxNumLogCallSites = 4096;
+    constexpr shipUint32 InvalidLogCallSiteId = shipUint32(-1);
+
+    // Longest formatted message, and longest string argument kept in a log record. Longer ones are truncated.
+    constexpr shipUint32 MaxLogMessageSize = 4096;
+
+    // Every SHIP_LOG_* call site registers its format string once, the first time it is reached. Log records only store the
+    // call site's id, and the raw arguments, formatting is left to the logger's writer thread or to the log decoder.
+    //
+    // Format strings must outlive the call site, which is the case for string literals.
+    class SHIPYARD_SYSTEM_API LogCallSite
+    {
+    public:
+        LogCallSite(LogLevel logLevel, const shipChar* pFormat);
+
+        LogLevel GetLogLevel() const { return m_LogLevel; }
+        const shipChar* GetFormat() const { return m_pFormat; }
+
+        // InvalidLogCallSiteId once MaxNumLogCallSites call sites are registered, calls are then formatted right away.
+        shipUint32 GetId() const { return m_Id; }
+
+    private:
+        const shipChar* m_pFormat;
+        shipUint32 m_Id;
+        LogLevel m_LogLevel;
+    };
+
+    SHIPYARD_SYSTEM_API const LogCallSite* GetLogCallSite(shipUint32 callSiteId);
+
+    enum class LogArgumentType : shipUint8
+    {
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Double,
+        String,
+        Pointer
+    };
+
+    // Arguments are stored back to back, each one is a LogArgumentType byte followed by its value, unaligned. Strings store their
+    // length as a shipUint32, then their characters and a null terminator. See LogRecordInternal::EncodeLogArguments.
+
+    // Formats encoded arguments with the format string of their call site. Conversions that don't match the type of their
+    // argument are converted to the argument's type, missing arguments are written as is.
+    //
+    // Returns the length of the message, which is always null terminated in pBuffer.
+    SHIPYARD_SYSTEM_API size_t FormatLogMessage(
+            const shipChar* pFormat,
+            const shipUint8* pArguments,
+            size_t argumentsSize,
+            shipChar* pBuffer,
+            size_t bufferSize);
+
+    SHIPYARD_SYSTEM_API const shipChar* GetLogLevelHeader(LogLevel logLevel);
+
+    // Binary log files start with a BinaryLogFileHeader, followed by entries. Each entry starts with its BinaryLogEntryType
+    // byte, fields are stored unaligned:
+    //
+    //   CallSite: shipUint32 callSiteId, LogLevel, shipUint32 formatLength, format characters.
+    //   Message:  shipUint64 timestamp, shipUint32 callSiteId, shipUint32 argumentsSize, encoded arguments.
+    //   Text:     shipUint64 timestamp, LogLevel, shipUint32 textLength, text characters.
+    //
+    // A call site is always written before the first message that refers to it.
+    constexpr shipUint32 BinaryLogFileMagic = 0x4c504853; // "SHPL"
+    constexpr shipUint32 BinaryLogFileVersion = 1;
+
+    struct BinaryLogFileHeader
+    {
+        shipUint32 magic;
+        shipUint32 version;
+    };
+
+    enum class BinaryLogEntryType : shipUint8
+    {
+        CallSite,
+        Message,
+        Text
+    };
+
+    // Writes a binary log as the logger would have written it in text.
+    SHIPYARD_SYSTEM_API shipBool DecodeBinaryLogFile(const shipChar* pBinaryLogFilename, const shipChar* pTextLogFilename);
+}
+
+#include <system/logrecord.inl>
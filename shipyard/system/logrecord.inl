@@ -0,0 +1,175 @@
+#include <cstring>
+#include <type_traits>
+
+namespace Shipyard
+{;
+
+namespace LogRecordInternal
+{
+    template <typename T, typename Enable = void>
+    struct LogArgumentEncoder
+    {
+        static_assert(sizeof(T) == 0, "Unsupported log argument type, only integers, enums, floating point numbers, strings and pointers can be logged.");
+    };
+
+    template <typename ValueType, LogArgumentType ArgumentType>
+    struct BaseLogArgumentEncoder
+    {
+        static size_t GetEncodedSize()
+        {
+            return (sizeof(LogArgumentType) + sizeof(ValueType));
+        }
+
+        static shipUint8* Encode(shipUint8* pBuffer, ValueType value)
+        {
+            *pBuffer = shipUint8(ArgumentType);
+            memcpy(pBuffer + sizeof(LogArgumentType), &value, sizeof(ValueType));
+
+            return (pBuffer + sizeof(LogArgumentType) + sizeof(ValueType));
+        }
+    };
+
+    template <shipBool IsSigned, shipBool Is64Bits>
+    struct IntegerLogArgumentEncoder;
+
+    template <> struct IntegerLogArgumentEncoder<true, false> : BaseLogArgumentEncoder<shipInt32, LogArgumentType::Int32> {};
+    template <> struct IntegerLogArgumentEncoder<false, false> : BaseLogArgumentEncoder<shipUint32, LogArgumentType::UInt32> {};
+    template <> struct IntegerLogArgumentEncoder<true, true> : BaseLogArgumentEncoder<shipInt64, LogArgumentType::Int64> {};
+    template <> struct IntegerLogArgumentEncoder<false, true> : BaseLogArgumentEncoder<shipUint64, LogArgumentType::UInt64> {};
+
+    template <typename T>
+    struct LogArgumentEncoder<T, typename std::enable_if<std::is_integral<T>::value>::type>
+        : IntegerLogArgumentEncoder<std::is_signed<T>::value, (sizeof(T) > sizeof(shipUint32))>
+    {
+        using BaseEncoder = IntegerLogArgumentEncoder<std::is_signed<T>::value, (sizeof(T) > sizeof(shipUint32))>;
+
+        static size_t GetEncodedSize(T)
+        {
+            return BaseEncoder::GetEncodedSize();
+        }
+    };
+
+    template <typename T>
+    struct LogArgumentEncoder<T, typename std::enable_if<std::is_enum<T>::value>::type>
+    {
+        using UnderlyingType = typename std::underlying_type<T>::type;
+
+        static size_t GetEncodedSize(T value)
+        {
+            return LogArgumentEncoder<UnderlyingType>::GetEncodedSize(UnderlyingType(value));
+        }
+
+        static shipUint8* Encode(shipUint8* pBuffer, T value)
+        {
+            return LogArgumentEncoder<UnderlyingType>::Encode(pBuffer, UnderlyingType(value));
+        }
+    };
+
+    template <typename T>
+    struct LogArgumentEncoder<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+        : BaseLogArgumentEncoder<double, LogArgumentType::Double>
+    {
+        static size_t GetEncodedSize(T)
+        {
+            return BaseLogArgumentEncoder<double, LogArgumentType::Double>::GetEncodedSize();
+        }
+    };
+
+    template <typename T>
+    struct LogArgumentEncoder<T*, void>
+    {
+        static size_t GetEncodedSize(const T*)
+        {
+            return (sizeof(LogArgumentType) + sizeof(shipUint64));
+        }
+
+        static shipUint8* Encode(shipUint8* pBuffer, const T* pointer)
+        {
+            return BaseLogArgumentEncoder<shipUint64, LogArgumentType::Pointer>::Encode(pBuffer, shipUint64(reinterpret_cast<size_t>(pointer)));
+        }
+    };
+
+    struct StringLogArgumentEncoder
+    {
+        static size_t GetStringLength(const shipChar* pString)
+        {
+            if (pString == nullptr)
+            {
+                return 0;
+            }
+
+            return strnlen(pString, MaxLogMessageSize - 1);
+        }
+
+        static size_t GetEncodedSize(const shipChar* pString)
+        {
+            return (sizeof(LogArgumentType) + sizeof(shipUint32) + GetStringLength(pString) + 1);
+        }
+
+        static shipUint8* Encode(shipUint8* pBuffer, const shipChar* pString)
+        {
+            shipUint32 stringLength = shipUint32(GetStringLength(pString));
+
+            *pBuffer = shipUint8(LogArgumentType::String);
+            pBuffer += sizeof(LogArgumentType);
+
+            memcpy(pBuffer, &stringLength, sizeof(shipUint32));
+            pBuffer += sizeof(shipUint32);
+
+            if (stringLength > 0)
+            {
+                memcpy(pBuffer, pString, stringLength);
+            }
+
+            pBuffer[stringLength] = '\0';
+
+            return (pBuffer + stringLength + 1);
+        }
+    };
+
+    // Strings are copied in the record, they may not exist anymore by the time the record is formatted.
+    template <>
+    struct LogArgumentEncoder<const shipChar*, void> : StringLogArgumentEncoder
+    {
+    };
+
+    template <>
+    struct LogArgumentEncoder<shipChar*, void> : StringLogArgumentEncoder
+    {
+    };
+
+    template <size_t N>
+    struct LogArgumentEncoder<shipChar[N], void> : StringLogArgumentEncoder
+    {
+    };
+
+    template <size_t N>
+    struct LogArgumentEncoder<const shipChar[N], void> : StringLogArgumentEncoder
+    {
+    };
+
+    SHIP_INLINE size_t GetEncodedLogArgumentsSize()
+    {
+        return 0;
+    }
+
+    template <typename Arg, typename... Args>
+    size_t GetEncodedLogArgumentsSize(const Arg& arg, const Args&... args)
+    {
+        return (LogArgumentEncoder<Arg>::GetEncodedSize(arg) + GetEncodedLogArgumentsSize(args...));
+    }
+
+    SHIP_INLINE void EncodeLogArguments(shipUint8*)
+    {
+    }
+
+    template <typename Arg, typename... Args>
+    void EncodeLogArguments(shipUint8* pBuffer, const Arg& arg, const Args&... args)
+    {
+        pBuffer = LogArgumentEncoder<Arg>::Encode(pBuffer, arg);
+
+        EncodeLogArguments(pBuffer, args...);
+    }
+}
+
+}
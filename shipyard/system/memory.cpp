@@ -4,11 +4,64 @@
 
 #include <system/systemdebug.h>
 
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+#include <system/memory/debugallocator.h>
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
 namespace Shipyard
 {;
 
+namespace
+{
+    struct ThreadLocalCacheMagazine
+    {
+        void* pBlocks[GlobalAllocator::ms_ThreadLocalCacheNumBlocks];
+        shipUint32 numBlocks = 0;
+    };
+
+    struct ThreadLocalAllocatorCache
+    {
+        ~ThreadLocalAllocatorCache()
+        {
+            // Give back the blocks when the thread exits, otherwise they would be lost for the other threads.
+            GetGlobalAllocator().FlushThreadLocalCache();
+        }
+
+        ThreadLocalCacheMagazine magazines[GlobalAllocator::ms_MaxNumAllocators];
+        shipUint32 generation = 0;
+    };
+
+    thread_local ThreadLocalAllocatorCache g_ThreadLocalAllocatorCache;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    thread_local shipUint64 g_NumAllocationsForCurrentThread = 0;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    ThreadLocalAllocatorCache& GetThreadLocalAllocatorCache(shipUint32 currentGeneration)
+    {
+        ThreadLocalAllocatorCache& threadLocalAllocatorCache = g_ThreadLocalAllocatorCache;
+
+        // Blocks cached for a previous set of allocators point in heaps that don't exist anymore, they can't be given back.
+        if (threadLocalAllocatorCache.generation != currentGeneration)
+        {
+            for (ThreadLocalCacheMagazine& magazine : threadLocalAllocatorCache.magazines)
+            {
+                magazine.numBlocks = 0;
+            }
+
+            threadLocalAllocatorCache.generation = currentGeneration;
+        }
+
+        return threadLocalAllocatorCache;
+    }
+}
+
 GlobalAllocator::GlobalAllocator()
     : m_NumAllocators(0)
+    , m_PageMapStartingAddress(0)
+    , m_PageMapEndingAddress(0)
+    , m_PageMapPageShift(0)
+    , m_Generation(0)
 
 #ifdef SHIP_DEBUG
     , m_Initialized(false)
@@ -26,6 +79,7 @@ shipBool GlobalAllocator::Create(AllocatorInitEntry* pInitEntries, shipUint32 nu
 {
     SHIP_ASSERT(pInitEntries != nullptr);
     SHIP_ASSERT(numAllocators > 0);
+    SHIP_ASSERT(numAllocators <= ms_MaxNumAllocators);
 
     size_t lastSize = 0;
 
@@ -39,6 +93,8 @@ shipBool GlobalAllocator::Create(AllocatorInitEntry* pInitEntries, shipUint32 nu
 
         if (lastAllocator)
         {
+            SHIP_ASSERT_MSG(!allocatorInitEntry.useThreadLocalCache, "GlobalAllocator::Create --> The fallback allocator cannot use a thread-local cache");
+
             m_MaxAllocationSizes[i] = size_t(-1);
         }
         else
@@ -57,10 +113,22 @@ shipBool GlobalAllocator::Create(AllocatorInitEntry* pInitEntries, shipUint32 nu
 
         SHIP_ASSERT(allocatorAddressRange.startingAddressBytes < allocatorAddressRange.endingAddressBytes);
 
+        m_UseThreadLocalCache[i] = (allocatorInitEntry.useThreadLocalCache && !lastAllocator);
+
+        // Cached blocks are shared by every allocation size of the allocator, so we align them to the largest power of 2
+        // dividing the block size, up to 16 bytes. This is the natural alignment of the chunks of a PoolAllocator.
+        size_t maxAllocationSize = m_MaxAllocationSizes[i];
+        size_t blockAlignment = (maxAllocationSize & (~maxAllocationSize + 1));
+        m_ThreadLocalCacheBlockAlignments[i] = MIN(blockAlignment, 16);
+
         m_HeapSize += allocatorInitEntry.pAllocator->GetHeapSize();
     }
 
     m_NumAllocators = numAllocators;
+    m_Generation += 1;
+
+    BuildSizeClassTable();
+    BuildPageMap();
 
 #ifdef SHIP_DEBUG
     m_Initialized = true;
@@ -72,6 +140,9 @@ shipBool GlobalAllocator::Create(AllocatorInitEntry* pInitEntries, shipUint32 nu
 void GlobalAllocator::Destroy()
 {
     m_NumAllocators = 0;
+    m_PageMapStartingAddress = 0;
+    m_PageMapEndingAddress = 0;
+    m_Generation += 1;
 
 #ifdef SHIP_DEBUG
     m_Initialized = false;
@@ -91,18 +162,44 @@ void* GlobalAllocator::Allocate(size_t size, size_t alignment
     SHIP_ASSERT_MSG(m_Initialized, "The GlobalAllocator needs to be initialized before using it for allocations!");
 #endif // #ifdef SHIP_DEBUG
 
-    std::lock_guard<std::mutex> lock(m_Lock);
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    g_NumAllocationsForCurrentThread += 1;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
-    shipUint32 allocatorIndexToUse = 0;
+    size_t sizeClass = (size + ms_SizeClassGranularity - 1) / ms_SizeClassGranularity;
+    shipUint32 allocatorIndexToUse = m_SizeClassTable[MIN(sizeClass, ms_NumSizeClasses - 1)];
 
-    for (; allocatorIndexToUse < m_NumAllocators; allocatorIndexToUse++)
+    // The last allocator accepts any size, so this always ends.
+    while (size > m_MaxAllocationSizes[allocatorIndexToUse])
+    {
+        allocatorIndexToUse += 1;
+    }
+
+    if (m_UseThreadLocalCache[allocatorIndexToUse])
     {
-        if (size > m_MaxAllocationSizes[allocatorIndexToUse])
+        void* pCachedBlock = AllocateFromThreadLocalCache(allocatorIndexToUse, alignment
+
+                #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , pAllocationFilename
+                    , allocationLineNumber
+                #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                );
+
+        if (pCachedBlock != nullptr)
         {
-            continue;
+            return pCachedBlock;
         }
+    }
 
-        void* pAllocatedPtr = m_pAllocators[allocatorIndexToUse].pAllocator->Allocate(size, alignment
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    for (; allocatorIndexToUse < m_NumAllocators; allocatorIndexToUse++)
+    {
+        // Blocks of cached allocators may be reused for any size they accept, so they must always be of the maximum size.
+        size_t sizeToAllocate = (m_UseThreadLocalCache[allocatorIndexToUse] ? m_MaxAllocationSizes[allocatorIndexToUse] : size);
+
+        void* pAllocatedPtr = m_pAllocators[allocatorIndexToUse].pAllocator->Allocate(sizeToAllocate, alignment
 
                 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
                     , pAllocationFilename
@@ -141,22 +238,305 @@ void GlobalAllocator::Deallocate(const void* memory)
     SHIP_ASSERT_MSG(m_Initialized, "The GlobalAllocator needs to be initialized before using it for freeing memory!");
 #endif // #ifdef SHIP_DEBUG
 
+    shipUint32 allocatorIndex = FindAllocatorIndexForAddress(size_t(memory));
+
+    if (allocatorIndex == m_NumAllocators)
+    {
+        SHIP_ASSERT_MSG(false, "GlobalAllocator::Deallocate --> Memory %p doesn't belong to any allocator", memory);
+        return;
+    }
+
+    if (m_UseThreadLocalCache[allocatorIndex])
+    {
+        DeallocateToThreadLocalCache(allocatorIndex, memory);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(m_Lock);
 
-    size_t memoryAddress = size_t(memory);
+    m_pAllocators[allocatorIndex].pAllocator->Deallocate(memory);
+}
+
+shipBool GlobalAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+#ifdef SHIP_DEBUG
+    SHIP_ASSERT_MSG(m_Initialized, "The GlobalAllocator needs to be initialized before using it for reallocating memory!");
+#endif // #ifdef SHIP_DEBUG
+
+    shipUint32 allocatorIndex = FindAllocatorIndexForAddress(size_t(memory));
+
+    if (allocatorIndex == m_NumAllocators)
+    {
+        SHIP_ASSERT_MSG(false, "GlobalAllocator::TryExpandInPlace --> Memory %p doesn't belong to any allocator", memory);
+        return false;
+    }
+
+    if (newSize > m_MaxAllocationSizes[allocatorIndex])
+    {
+        return false;
+    }
+
+    // Blocks of cached allocators all have the maximum allocation size.
+    if (m_UseThreadLocalCache[allocatorIndex])
+    {
+        return true;
+    }
+
+    shipBool expandedInPlace = false;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+
+        expandedInPlace = m_pAllocators[allocatorIndex].pAllocator->TryExpandInPlace(memory, currentSize, newSize);
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    // Not every allocator updates the DebugAllocator when one of its allocations is resized.
+    if (expandedInPlace)
+    {
+        DebugAllocator::GetInstance().Resize(memory, newSize);
+    }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return expandedInPlace;
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+shipUint64 GlobalAllocator::GetNumAllocationsForCurrentThread()
+{
+    return g_NumAllocationsForCurrentThread;
+}
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+void GlobalAllocator::FlushThreadLocalCache()
+{
+    if (m_NumAllocators == 0)
+    {
+        return;
+    }
+
+    ThreadLocalAllocatorCache& threadLocalAllocatorCache = GetThreadLocalAllocatorCache(m_Generation);
+
+    std::lock_guard<std::mutex> lock(m_Lock);
 
     for (shipUint32 i = 0; i < m_NumAllocators; i++)
     {
-        AllocatorAddressRange& allocatorAddressRange = m_pAllocators[i];
+        ThreadLocalCacheMagazine& magazine = threadLocalAllocatorCache.magazines[i];
 
-        if (memoryAddress >= allocatorAddressRange.startingAddressBytes && memoryAddress < allocatorAddressRange.endingAddressBytes)
+        for (shipUint32 blockIndex = 0; blockIndex < magazine.numBlocks; blockIndex++)
         {
-            allocatorAddressRange.pAllocator->Deallocate(memory);
-            return;
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            DebugAllocator::GetInstance().TrackCachedBlock(m_pAllocators[i].pAllocator, magazine.pBlocks[blockIndex], m_MaxAllocationSizes[i]);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+            m_pAllocators[i].pAllocator->Deallocate(magazine.pBlocks[blockIndex]);
         }
+
+        magazine.numBlocks = 0;
     }
+}
+
+void* GlobalAllocator::AllocateFromThreadLocalCache(shipUint32 allocatorIndex, size_t alignment
 
-    SHIP_ASSERT(false);
+        #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            , const shipChar* pAllocationFilename
+            , int allocationLineNumber
+        #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        )
+{
+    ThreadLocalCacheMagazine& magazine = GetThreadLocalAllocatorCache(m_Generation).magazines[allocatorIndex];
+
+    BaseAllocator* pAllocator = m_pAllocators[allocatorIndex].pAllocator;
+
+    if (magazine.numBlocks == 0)
+    {
+        // Refill half of the magazine at once, so that we only take the locks once per batch.
+        std::lock_guard<std::mutex> lock(m_Lock);
+
+        size_t blockSize = m_MaxAllocationSizes[allocatorIndex];
+        size_t blockAlignment = m_ThreadLocalCacheBlockAlignments[allocatorIndex];
+
+        for (; magazine.numBlocks < ms_ThreadLocalCacheBatchSize; magazine.numBlocks++)
+        {
+            void* pBlock = SHIP_ALLOC_EX(pAllocator, blockSize, blockAlignment);
+            if (pBlock == nullptr)
+            {
+                break;
+            }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            // Blocks sitting in the cache aren't user allocations, they are tracked again once handed out.
+            DebugAllocator::GetInstance().Deallocate(pBlock);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+            magazine.pBlocks[magazine.numBlocks] = pBlock;
+        }
+
+        if (magazine.numBlocks == 0)
+        {
+            return nullptr;
+        }
+    }
+
+    void* pBlock = magazine.pBlocks[magazine.numBlocks - 1];
+
+    // Alignments larger than what the cached blocks guarantee go through the regular path.
+    if (!MemoryUtils::IsAddressAligned(size_t(pBlock), alignment))
+    {
+        return nullptr;
+    }
+
+    magazine.numBlocks -= 1;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    DebugAllocator::GetInstance().Allocate(pAllocator, pBlock, m_MaxAllocationSizes[allocatorIndex], pAllocationFilename, allocationLineNumber);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return pBlock;
+}
+
+void GlobalAllocator::DeallocateToThreadLocalCache(shipUint32 allocatorIndex, const void* memory)
+{
+    ThreadLocalCacheMagazine& magazine = GetThreadLocalAllocatorCache(m_Generation).magazines[allocatorIndex];
+
+    if (magazine.numBlocks == ms_ThreadLocalCacheNumBlocks)
+    {
+        // Give back the oldest blocks in a single batch, and keep the most recently freed ones since they are more likely to be in cache.
+        {
+            std::lock_guard<std::mutex> lock(m_Lock);
+
+            BaseAllocator* pAllocator = m_pAllocators[allocatorIndex].pAllocator;
+
+            for (shipUint32 i = 0; i < ms_ThreadLocalCacheBatchSize; i++)
+            {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                DebugAllocator::GetInstance().TrackCachedBlock(pAllocator, magazine.pBlocks[i], m_MaxAllocationSizes[allocatorIndex]);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                pAllocator->Deallocate(magazine.pBlocks[i]);
+            }
+        }
+
+        magazine.numBlocks -= ms_ThreadLocalCacheBatchSize;
+
+        memmove(&magazine.pBlocks[0], &magazine.pBlocks[ms_ThreadLocalCacheBatchSize], magazine.numBlocks * sizeof(void*));
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    DebugAllocator::GetInstance().Deallocate(memory);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    magazine.pBlocks[magazine.numBlocks] = const_cast<void*>(memory);
+    magazine.numBlocks += 1;
+}
+
+void GlobalAllocator::BuildSizeClassTable()
+{
+    shipUint32 allocatorIndex = 0;
+
+    for (size_t sizeClass = 0; sizeClass < ms_NumSizeClasses; sizeClass++)
+    {
+        // Smallest size belonging to this size class.
+        size_t size = ((sizeClass == 0) ? 0 : (sizeClass - 1) * ms_SizeClassGranularity + 1);
+
+        while (size > m_MaxAllocationSizes[allocatorIndex])
+        {
+            allocatorIndex += 1;
+        }
+
+        m_SizeClassTable[sizeClass] = shipUint8(allocatorIndex);
+    }
+}
+
+void GlobalAllocator::BuildPageMap()
+{
+    for (shipUint32 i = 0; i < m_NumAllocators; i++)
+    {
+        m_AddressSortedAllocatorIndices[i] = shipUint8(i);
+    }
+
+    // Insertion sort, there are at most ms_MaxNumAllocators entries.
+    for (shipUint32 i = 1; i < m_NumAllocators; i++)
+    {
+        shipUint8 allocatorIndex = m_AddressSortedAllocatorIndices[i];
+        size_t startingAddress = m_pAllocators[allocatorIndex].startingAddressBytes;
+
+        shipUint32 j = i;
+        for (; j > 0 && m_pAllocators[m_AddressSortedAllocatorIndices[j - 1]].startingAddressBytes > startingAddress; j--)
+        {
+            m_AddressSortedAllocatorIndices[j] = m_AddressSortedAllocatorIndices[j - 1];
+        }
+
+        m_AddressSortedAllocatorIndices[j] = allocatorIndex;
+    }
+
+    for (shipUint32 i = 1; i < m_NumAllocators; i++)
+    {
+        SHIP_ASSERT_MSG(m_pAllocators[m_AddressSortedAllocatorIndices[i - 1]].endingAddressBytes <= m_pAllocators[m_AddressSortedAllocatorIndices[i]].startingAddressBytes,
+                "GlobalAllocator::Create --> Allocators' heaps cannot overlap");
+    }
+
+    m_PageMapStartingAddress = m_pAllocators[m_AddressSortedAllocatorIndices[0]].startingAddressBytes;
+    m_PageMapEndingAddress = m_PageMapStartingAddress;
+
+    for (shipUint32 i = 0; i < m_NumAllocators; i++)
+    {
+        m_PageMapEndingAddress = MAX(m_PageMapEndingAddress, m_pAllocators[i].endingAddressBytes);
+    }
+
+    // Smallest power of 2 page size for which the whole range fits in the page map.
+    size_t lastAddressOffset = m_PageMapEndingAddress - m_PageMapStartingAddress - 1;
+
+    m_PageMapPageShift = 0;
+    while ((lastAddressOffset >> m_PageMapPageShift) >= ms_PageMapNumPages)
+    {
+        m_PageMapPageShift += 1;
+    }
+
+    size_t numPages = (lastAddressOffset >> m_PageMapPageShift) + 1;
+    shipUint32 sortedIndex = 0;
+
+    for (size_t page = 0; page < numPages; page++)
+    {
+        size_t pageStartingAddress = m_PageMapStartingAddress + (page << m_PageMapPageShift);
+
+        while (m_pAllocators[m_AddressSortedAllocatorIndices[sortedIndex]].endingAddressBytes <= pageStartingAddress)
+        {
+            sortedIndex += 1;
+        }
+
+        m_PageMap[page] = shipUint8(sortedIndex);
+    }
+}
+
+shipUint32 GlobalAllocator::FindAllocatorIndexForAddress(size_t address) const
+{
+    if (address < m_PageMapStartingAddress || address >= m_PageMapEndingAddress)
+    {
+        return m_NumAllocators;
+    }
+
+    size_t page = ((address - m_PageMapStartingAddress) >> m_PageMapPageShift);
+
+    for (shipUint32 sortedIndex = m_PageMap[page]; sortedIndex < m_NumAllocators; sortedIndex++)
+    {
+        shipUint32 allocatorIndex = m_AddressSortedAllocatorIndices[sortedIndex];
+        const AllocatorAddressRange& allocatorAddressRange = m_pAllocators[allocatorIndex];
+
+        // Heaps are sorted, so the address falls between two heaps.
+        if (address < allocatorAddressRange.startingAddressBytes)
+        {
+            break;
+        }
+
+        if (address < allocatorAddressRange.endingAddressBytes)
+        {
+            return allocatorIndex;
+        }
+    }
+
+    return m_NumAllocators;
 }
 
 GlobalAllocator& GetGlobalAllocator()
@@ -164,4 +544,4 @@ GlobalAllocator& GetGlobalAllocator()
     return GlobalAllocator::GetInstance();
 }
 
-}
\ No newline at end of file
+}
@@ -11,12 +11,31 @@ namespace Shipyard
     public:
         static const shipUint32 ms_MaxNumAllocators = 32;
 
+        // Number of blocks each thread can keep in its cache for a single allocator, and number of blocks moved
+        // at once between a thread's cache and the allocator when the cache is empty or full.
+        static const shipUint32 ms_ThreadLocalCacheNumBlocks = 64;
+        static const shipUint32 ms_ThreadLocalCacheBatchSize = 32;
+
+        // Allocation sizes up to ms_SizeClassTableMaxSize are routed to their allocator with a single table lookup,
+        // using one entry every ms_SizeClassGranularity bytes.
+        static const size_t ms_SizeClassGranularity = 8;
+        static const size_t ms_SizeClassTableMaxSize = 4096;
+        static const size_t ms_NumSizeClasses = ms_SizeClassTableMaxSize / ms_SizeClassGranularity + 1;
+
+        // Number of pages used to map the address range covered by all allocators to the allocator owning it.
+        static const size_t ms_PageMapNumPages = 4096;
+
         struct AllocatorInitEntry
         {
             BaseAllocator* pAllocator = nullptr;
 
             // maxAllocationSize is the size in bytes for up to which the allocator will be considered.
             size_t maxAllocationSize = 0;
+
+            // When enabled, every allocation served by this allocator is rounded up to maxAllocationSize bytes, and freed blocks
+            // are kept in a per-thread cache so that they can be reused by the same thread without taking any lock.
+            // Cannot be used on the last allocator, since its maximum size is ignored.
+            shipBool useThreadLocalCache = false;
         };
 
     public:
@@ -47,6 +66,19 @@ namespace Shipyard
         // Memory must come from the allocator that allocated it.
         virtual void Deallocate(const void* memory) override;
 
+        // Allocations never grow past the maximum allocation size of the allocator that owns them, so that big allocations still end up
+        // in the allocators meant for them.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
+        // Returns every block held in the calling thread's cache to their allocators. Threads do this automatically when exiting,
+        // but it can be called manually to release memory sooner. Blocks cached by other threads are dropped on Destroy.
+        void FlushThreadLocalCache();
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        // Number of allocations made by the calling thread since it started, used to measure how many allocations some code does.
+        static shipUint64 GetNumAllocationsForCurrentThread();
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
     private:
         struct AllocatorAddressRange
         {
@@ -63,10 +95,45 @@ namespace Shipyard
         GlobalAllocator& operator= (const GlobalAllocator& rhs) = delete;
         GlobalAllocator& operator= (const GlobalAllocator&& rhs) = delete;
 
+        void* AllocateFromThreadLocalCache(shipUint32 allocatorIndex, size_t alignment
+
+                #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+                #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+            );
+
+        void DeallocateToThreadLocalCache(shipUint32 allocatorIndex, const void* memory);
+
+        void BuildSizeClassTable();
+        void BuildPageMap();
+
+        // Returns m_NumAllocators if no allocator owns this address.
+        shipUint32 FindAllocatorIndexForAddress(size_t address) const;
+
         size_t m_MaxAllocationSizes[ms_MaxNumAllocators];
         AllocatorAddressRange m_pAllocators[ms_MaxNumAllocators];
+        shipBool m_UseThreadLocalCache[ms_MaxNumAllocators];
+        size_t m_ThreadLocalCacheBlockAlignments[ms_MaxNumAllocators];
         shipUint32 m_NumAllocators;
 
+        // Index of the first allocator to consider for each size class. Since allocators' maximum sizes don't have to be multiples
+        // of the granularity, the allocator found may be one too small, in which case we continue with the next ones.
+        shipUint8 m_SizeClassTable[ms_NumSizeClasses];
+
+        // Allocator indices sorted by increasing heap address, and for each page of the address range covered by all the allocators,
+        // the position in that sorted list of the first allocator whose heap ends after the start of the page.
+        // Allocators' heaps are usually carved out of a single block of memory, in which case a page only holds a few of them.
+        shipUint8 m_AddressSortedAllocatorIndices[ms_MaxNumAllocators];
+        shipUint8 m_PageMap[ms_PageMapNumPages];
+        size_t m_PageMapStartingAddress;
+        size_t m_PageMapEndingAddress;
+        shipUint32 m_PageMapPageShift;
+
+        // Incremented on every Create and Destroy, so that thread-local caches filled from a previous set of allocators are dropped.
+        shipUint32 m_Generation;
+
         std::mutex m_Lock;
 
 #ifdef SHIP_DEBUG
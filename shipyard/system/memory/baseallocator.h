@@ -6,6 +6,8 @@
 
 #include <system/memory/memoryutils.h>
 
+#include <string.h>
+
 #ifndef SHIP_OPTIMIZED
 
 // This define allows logging of some information about allocation and deallocation.
@@ -44,6 +46,49 @@ namespace Shipyard
         // Memory must come from the allocator that allocated it.
         virtual void Deallocate(const void* memory) = 0;
 
+        // Tries to resize an allocation to newSize bytes without moving it, currentSize being the size it was allocated or last resized with.
+        // Returns false if the allocation couldn't be resized, in which case it is left untouched. Allocators that can't resize allocations
+        // in place don't need to implement it.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+        {
+            return false;
+        }
+
+        // Resizes an allocation to newSize bytes, in place if possible, otherwise by moving its first MIN(currentSize, newSize) bytes to a new
+        // allocation. A null memory is the same as a new allocation. Returns nullptr if out of memory, in which case the allocation is left untouched.
+        void* Reallocate(void* memory, size_t currentSize, size_t newSize, size_t alignment
+
+                #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+                #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+            )
+        {
+            if (memory != nullptr && TryExpandInPlace(memory, currentSize, newSize))
+            {
+                return memory;
+            }
+
+            void* pNewMemory = Allocate(newSize, alignment
+
+                #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , pAllocationFilename
+                    , allocationLineNumber
+                #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                );
+
+            if (pNewMemory != nullptr && memory != nullptr)
+            {
+                memcpy(pNewMemory, memory, MIN(currentSize, newSize));
+
+                Deallocate(memory);
+            }
+
+            return pNewMemory;
+        }
+
         const void* GetHeap() const { return m_pHeap; }
         size_t GetHeapSize() const { return m_HeapSize; }
 
@@ -168,6 +213,8 @@ namespace Shipyard
 
 #define SHIP_NEW_ARRAY_EX(pAllocator, classX, length, alignment) NewArray<classX>(pAllocator, length, alignment, __FILE__, __LINE__)
 
+#define SHIP_REALLOC_EX(pAllocator, memory, currentSize, newSize, alignment) (pAllocator)->Reallocate(memory, currentSize, newSize, alignment, __FILE__, __LINE__)
+
 #else
 
 #define SHIP_ALLOC_EX(pAllocator, size, alignment) (pAllocator)->Allocate(size, alignment)
@@ -176,6 +223,8 @@ namespace Shipyard
 
 #define SHIP_NEW_ARRAY_EX(pAllocator, classX, length, alignment) NewArray<classX>(pAllocator, length, alignment)
 
+#define SHIP_REALLOC_EX(pAllocator, memory, currentSize, newSize, alignment) (pAllocator)->Reallocate(memory, currentSize, newSize, alignment)
+
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
 #define SHIP_FREE_EX(pAllocator, memory) if (memory != nullptr) (pAllocator)->Deallocate(memory)
@@ -7,14 +7,61 @@
 #include <system/logger.h>
 #include <system/systemdebug.h>
 
+#include <system/memory/memoryutils.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
 namespace Shipyard
 {;
 
 DebugAllocator::MemoryBreaks g_MemoryBreaks;
 
+namespace
+{
+    size_t GetLargestPowerOf2LowerOrEqualTo(size_t value)
+    {
+        size_t powerOf2 = 1;
+        while (powerOf2 <= value / 2)
+        {
+            powerOf2 *= 2;
+        }
+
+        return powerOf2;
+    }
+
+    size_t HashAddress(size_t memoryAddress)
+    {
+        shipUint64 hash = shipUint64(memoryAddress) * 0x9E3779B97F4A7C15ULL;
+        return size_t(hash ^ (hash >> 29));
+    }
+
+    size_t HashCallSite(const shipChar* pAllocationFilename, int allocationLineNumber)
+    {
+        // The same file can have a different filename string in every file it's included from, so its content is hashed.
+        shipUint64 hash = 0xCBF29CE484222325ULL ^ shipUint64(allocationLineNumber);
+
+        for (const shipChar* pCurrentChar = pAllocationFilename; pCurrentChar != nullptr && *pCurrentChar != '\0'; pCurrentChar++)
+        {
+            hash = (hash ^ shipUint64(shipUint8(*pCurrentChar))) * 0x100000001B3ULL;
+        }
+
+        return size_t(hash ^ (hash >> 29));
+    }
+
+    shipBool IsSameFilename(const shipChar* pFilename, const shipChar* pOtherFilename)
+    {
+        return (pFilename == pOtherFilename || (pFilename != nullptr && pOtherFilename != nullptr && strcmp(pFilename, pOtherFilename) == 0));
+    }
+}
+
 DebugAllocator::DebugAllocator()
     : m_pFirstFreeChunk(nullptr)
-    , m_pFirstDebugAllocationInfo(nullptr)
+    , m_ppAllocationSlots(nullptr)
+    , m_NumAllocationSlots(0)
+    , m_pCallSiteSlots(nullptr)
+    , m_NumCallSiteSlots(0)
     , m_pHeap(nullptr)
     , m_HeapSize(0)
     , m_NumAllocations(0)
@@ -33,12 +80,43 @@ shipBool DebugAllocator::Create(void* pHeap, size_t heapSize)
         return false;
     }
 
+    size_t heapStartAddress = MemoryUtils::AlignAddress(size_t(pHeap), alignof(DebugAllocationInfo));
+    size_t usableHeapSize = heapSize - (heapStartAddress - size_t(pHeap));
+
+    // An eighth of the heap goes to call sites, there are far less of them than allocations.
+    m_NumCallSiteSlots = GetLargestPowerOf2LowerOrEqualTo(usableHeapSize / 8 / sizeof(CallSiteStatistics));
+
+    size_t callSiteTableSize = m_NumCallSiteSlots * sizeof(CallSiteStatistics);
+    size_t remainingHeapSize = usableHeapSize - callSiteTableSize;
+
+    // Keep the address table at most three quarters full, so that probing stays short.
+    m_NumAllocationSlots = GetLargestPowerOf2LowerOrEqualTo(remainingHeapSize / (sizeof(DebugAllocationInfo*) + sizeof(DebugAllocationInfo) / 2));
+
+    size_t allocationTableSize = m_NumAllocationSlots * sizeof(DebugAllocationInfo*);
+
+    m_NumAllocations = MIN((remainingHeapSize - allocationTableSize) / sizeof(DebugAllocationInfo), m_NumAllocationSlots * 3 / 4);
+
+    if (m_NumAllocations == 0)
+    {
+        return false;
+    }
+
     m_pHeap = pHeap;
     m_HeapSize = heapSize;
 
-    m_NumAllocations = heapSize / sizeof(DebugAllocationInfo);
+    m_pCallSiteSlots = reinterpret_cast<CallSiteStatistics*>(heapStartAddress);
+    for (size_t i = 0; i < m_NumCallSiteSlots; i++)
+    {
+        m_pCallSiteSlots[i] = CallSiteStatistics();
+    }
+
+    m_ppAllocationSlots = reinterpret_cast<DebugAllocationInfo**>(heapStartAddress + callSiteTableSize);
+    for (size_t i = 0; i < m_NumAllocationSlots; i++)
+    {
+        m_ppAllocationSlots[i] = nullptr;
+    }
 
-    m_pFirstFreeChunk = reinterpret_cast<FreeChunkHeader*>(m_pHeap);
+    m_pFirstFreeChunk = reinterpret_cast<FreeChunkHeader*>(heapStartAddress + callSiteTableSize + allocationTableSize);
     FreeChunkHeader* pCurrentFreeChunk = m_pFirstFreeChunk;
     FreeChunkHeader* pLastFreeChunk = nullptr;
 
@@ -56,7 +134,7 @@ shipBool DebugAllocator::Create(void* pHeap, size_t heapSize)
 
     pLastFreeChunk->pNextFreeChunk = nullptr;
 
-    m_pFirstDebugAllocationInfo = nullptr;
+    m_MemoryInfo = MemoryInfo();
 
     return true;
 }
@@ -65,62 +143,15 @@ void DebugAllocator::Destroy()
 {
     if (m_MemoryInfo.numAllocations != 0)
     {
-        SHIP_ASSERT(m_pFirstDebugAllocationInfo != nullptr);
-
-        SHIP_LOG_ERROR("***** Memory leaks detected! *****");
-
-        // For convenience, let's pack the memory leaks by allocator. So we need to first gather the different allocators.
-        BaseAllocator* pAllocators[32];
-        shipUint32 numMemoryLeaksPerAllocator[32];
-        size_t numAllocators = 0;
-
-        for (DebugAllocationInfo* pCurrentMemoryLeak = m_pFirstDebugAllocationInfo; pCurrentMemoryLeak != nullptr; pCurrentMemoryLeak = pCurrentMemoryLeak->pNextDebugAllocationInfo)
-        {
-            size_t idx = 0;
-            for (; idx < numAllocators; idx++)
-            {
-                if (pAllocators[idx] == pCurrentMemoryLeak->pAllocator)
-                {
-                    break;
-                }
-            }
-
-            shipBool newAllocator = (idx == numAllocators);
-
-            if (newAllocator)
-            {
-                pAllocators[idx] = pCurrentMemoryLeak->pAllocator;
-                numMemoryLeaksPerAllocator[idx] = 1;
-
-                numAllocators += 1;
-            }
-            else
-            {
-                numMemoryLeaksPerAllocator[idx] += 1;
-            }
-        }
-
-        for (size_t i = 0; i < numAllocators; i++)
-        {
-            BaseAllocator* pAllocator = pAllocators[i];
-
-            SHIP_LOG_ERROR("    %u Memory leaks for allocator %s at address 0x%p", numMemoryLeaksPerAllocator[i], pAllocator->GetAllocatorDebugName(), pAllocator);
-
-            for (DebugAllocationInfo* pCurrentMemoryLeak = m_pFirstDebugAllocationInfo; pCurrentMemoryLeak != nullptr; pCurrentMemoryLeak = pCurrentMemoryLeak->pNextDebugAllocationInfo)
-            {
-                if (pCurrentMemoryLeak->pAllocator != pAllocator)
-                {
-                    continue;
-                }
-
-                SHIP_LOG_ERROR("        Memory leak of allocation #%llu of %llu bytes at address 0x%p --> \t%s (line %d)", pCurrentMemoryLeak->allocationId, pCurrentMemoryLeak->allocationSizeInBytes, pCurrentMemoryLeak->memoryAddress, pCurrentMemoryLeak->pAllocationFilename, pCurrentMemoryLeak->allocationLineNumber);
-            }
-        }
+        ReportMemoryLeaks();
     }
 
     m_pHeap = nullptr;
     m_pFirstFreeChunk = nullptr;
-    m_pFirstDebugAllocationInfo = nullptr;
+    m_ppAllocationSlots = nullptr;
+    m_NumAllocationSlots = 0;
+    m_pCallSiteSlots = nullptr;
+    m_NumCallSiteSlots = 0;
 }
 
 void DebugAllocator::Allocate(BaseAllocator* pAllocator, void* pAllocatedMemory, size_t size, const shipChar* pAllocationFilename, int allocationLineNumber)
@@ -132,20 +163,33 @@ void DebugAllocator::Allocate(BaseAllocator* pAllocator, void* pAllocatedMemory,
 
     std::lock_guard<std::mutex> lock(m_Lock);
 
-    if (m_pFirstFreeChunk == nullptr)
+    size_t slot = FindAllocationSlot(size_t(pAllocatedMemory));
+
+    DebugAllocationInfo* pDebugAllocationInfo = m_ppAllocationSlots[slot];
+
+    if (pDebugAllocationInfo != nullptr)
     {
-        return;
-    }
+        // Blocks of the GlobalAllocator's thread-local caches are untracked while cached, so this is an allocator handing out
+        // memory that is still live. Forget about the previous allocation and reuse its entry to keep going.
+        SHIP_ASSERT_MSG(false, "DebugAllocator::Allocate --> Memory at %p was allocated while still live", pAllocatedMemory);
 
-    DebugAllocationInfo* pDebugAllocationInfo = reinterpret_cast<DebugAllocationInfo*>(m_pFirstFreeChunk);
+        m_MemoryInfo.numOverwrittenAllocations += 1;
 
-    m_pFirstFreeChunk = m_pFirstFreeChunk->pNextFreeChunk;
+        FreeDebugAllocationInfo(pDebugAllocationInfo);
+    }
+    else
+    {
+        pDebugAllocationInfo = AddDebugAllocationInfo(slot);
+        if (pDebugAllocationInfo == nullptr)
+        {
+            return;
+        }
+    }
 
     pDebugAllocationInfo->memoryAddress = size_t(pAllocatedMemory);
     pDebugAllocationInfo->allocationSizeInBytes = size;
     pDebugAllocationInfo->pAllocator = pAllocator;
-    pDebugAllocationInfo->pAllocationFilename = pAllocationFilename;
-    pDebugAllocationInfo->allocationLineNumber = allocationLineNumber;
+    pDebugAllocationInfo->pCallSiteStatistics = FindOrAddCallSite(pAllocationFilename, allocationLineNumber);
 
     static size_t s_AllocationId = 0;
 
@@ -162,17 +206,17 @@ void DebugAllocator::Allocate(BaseAllocator* pAllocator, void* pAllocatedMemory,
     pDebugAllocationInfo->allocationId = s_AllocationId;
     s_AllocationId += 1;
 
-    pDebugAllocationInfo->pPreviousDebugAllocationInfo = nullptr;
-    pDebugAllocationInfo->pNextDebugAllocationInfo = m_pFirstDebugAllocationInfo;
-
-    if (m_pFirstDebugAllocationInfo != nullptr)
+    CallSiteStatistics* pCallSiteStatistics = pDebugAllocationInfo->pCallSiteStatistics;
+    if (pCallSiteStatistics != nullptr)
     {
-        m_pFirstDebugAllocationInfo->pPreviousDebugAllocationInfo = pDebugAllocationInfo;
+        pCallSiteStatistics->numLiveBytes += size;
+        pCallSiteStatistics->numLiveAllocations += 1;
+        pCallSiteStatistics->numAllocations += 1;
+        pCallSiteStatistics->peakLiveBytes = MAX(pCallSiteStatistics->peakLiveBytes, pCallSiteStatistics->numLiveBytes);
     }
 
-    m_pFirstDebugAllocationInfo = pDebugAllocationInfo;
-
     m_MemoryInfo.numAllocations += 1;
+    m_MemoryInfo.numBytesAllocated += size;
 }
 
 void DebugAllocator::Deallocate(const void* memory)
@@ -184,35 +228,230 @@ void DebugAllocator::Deallocate(const void* memory)
 
     std::lock_guard<std::mutex> lock(m_Lock);
 
-    SHIP_ASSERT(m_pFirstDebugAllocationInfo != nullptr);
+    size_t slot = FindAllocationSlot(size_t(memory));
 
-    DebugAllocationInfo* pDebugAllocationInfo = nullptr;
-    for (pDebugAllocationInfo = m_pFirstDebugAllocationInfo; pDebugAllocationInfo != nullptr; pDebugAllocationInfo = pDebugAllocationInfo->pNextDebugAllocationInfo)
+    DebugAllocationInfo* pDebugAllocationInfo = m_ppAllocationSlots[slot];
+
+    if (pDebugAllocationInfo == nullptr)
     {
-        if (pDebugAllocationInfo->memoryAddress == size_t(memory))
+        // Allocations aren't tracked when we run out of debug entries, anything else is a double or an invalid free.
+        shipBool isUntrackedAllocation = (m_MemoryInfo.numUntrackedDeallocations < m_MemoryInfo.numUntrackedAllocations);
+
+        SHIP_ASSERT_MSG(isUntrackedAllocation, "DebugAllocator::Deallocate --> Memory at %p was already freed, or was never allocated", memory);
+
+        if (isUntrackedAllocation)
         {
-            break;
+            m_MemoryInfo.numUntrackedDeallocations += 1;
         }
+
+        return;
     }
 
+    FreeDebugAllocationInfo(pDebugAllocationInfo);
+
+    RemoveAllocationSlot(slot);
+
     FreeChunkHeader* pNewFreeChunk = reinterpret_cast<FreeChunkHeader*>(pDebugAllocationInfo);
     pNewFreeChunk->pNextFreeChunk = m_pFirstFreeChunk;
 
     m_pFirstFreeChunk = pNewFreeChunk;
+}
+
+void DebugAllocator::TrackCachedBlock(BaseAllocator* pAllocator, const void* pBlock, size_t size)
+{
+    if (m_pHeap == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    size_t slot = FindAllocationSlot(size_t(pBlock));
+
+    SHIP_ASSERT_MSG(m_ppAllocationSlots[slot] == nullptr, "DebugAllocator::TrackCachedBlock --> Cached block %p is also a live allocation", pBlock);
+
+    if (m_ppAllocationSlots[slot] != nullptr)
+    {
+        return;
+    }
 
-    if (m_pFirstDebugAllocationInfo == pDebugAllocationInfo)
+    DebugAllocationInfo* pDebugAllocationInfo = AddDebugAllocationInfo(slot);
+    if (pDebugAllocationInfo == nullptr)
     {
-        m_pFirstDebugAllocationInfo = pDebugAllocationInfo->pNextDebugAllocationInfo;
+        return;
     }
 
-    if (pDebugAllocationInfo->pNextDebugAllocationInfo != nullptr)
+    // Not accounted to any call site, the block was only allocated by the cache.
+    pDebugAllocationInfo->memoryAddress = size_t(pBlock);
+    pDebugAllocationInfo->allocationSizeInBytes = size;
+    pDebugAllocationInfo->allocationId = size_t(-1);
+    pDebugAllocationInfo->pAllocator = pAllocator;
+    pDebugAllocationInfo->pCallSiteStatistics = nullptr;
+
+    m_MemoryInfo.numAllocations += 1;
+    m_MemoryInfo.numBytesAllocated += size;
+}
+
+void DebugAllocator::Resize(const void* pAllocatedMemory, size_t newSize)
+{
+    if (m_pHeap == nullptr)
     {
-        pDebugAllocationInfo->pNextDebugAllocationInfo->pPreviousDebugAllocationInfo = pDebugAllocationInfo->pPreviousDebugAllocationInfo;
+        return;
     }
 
-    if (pDebugAllocationInfo->pPreviousDebugAllocationInfo != nullptr)
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    DebugAllocationInfo* pDebugAllocationInfo = m_ppAllocationSlots[FindAllocationSlot(size_t(pAllocatedMemory))];
+    if (pDebugAllocationInfo == nullptr)
     {
-        pDebugAllocationInfo->pPreviousDebugAllocationInfo->pNextDebugAllocationInfo = pDebugAllocationInfo->pNextDebugAllocationInfo;
+        return;
+    }
+
+    CallSiteStatistics* pCallSiteStatistics = pDebugAllocationInfo->pCallSiteStatistics;
+    if (pCallSiteStatistics != nullptr)
+    {
+        pCallSiteStatistics->numLiveBytes = pCallSiteStatistics->numLiveBytes - pDebugAllocationInfo->allocationSizeInBytes + newSize;
+        pCallSiteStatistics->peakLiveBytes = MAX(pCallSiteStatistics->peakLiveBytes, pCallSiteStatistics->numLiveBytes);
+    }
+
+    m_MemoryInfo.numBytesAllocated = m_MemoryInfo.numBytesAllocated - pDebugAllocationInfo->allocationSizeInBytes + newSize;
+    pDebugAllocationInfo->allocationSizeInBytes = newSize;
+}
+
+shipBool DebugAllocator::GetCallSiteStatistics(const shipChar* pAllocationFilename, int allocationLineNumber, CallSiteStatistics& callSiteStatistics)
+{
+    if (m_pHeap == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    const CallSiteStatistics& callSiteSlot = m_pCallSiteSlots[FindCallSiteSlot(pAllocationFilename, allocationLineNumber)];
+    if (callSiteSlot.numAllocations == 0)
+    {
+        return false;
+    }
+
+    callSiteStatistics = callSiteSlot;
+
+    return true;
+}
+
+shipBool DebugAllocator::DumpCallSiteStatisticsToCSV(const shipChar* pCSVFilename)
+{
+    if (m_pHeap == nullptr)
+    {
+        return false;
+    }
+
+    // The standard containers don't go through the GlobalAllocator, which would need our lock to track their allocations.
+    std::vector<CallSiteStatistics> callSites;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Lock);
+
+        callSites.reserve(m_MemoryInfo.numCallSites);
+
+        for (size_t i = 0; i < m_NumCallSiteSlots; i++)
+        {
+            if (m_pCallSiteSlots[i].numAllocations > 0)
+            {
+                callSites.push_back(m_pCallSiteSlots[i]);
+            }
+        }
+    }
+
+    std::sort(callSites.begin(), callSites.end(), [](const CallSiteStatistics& lhs, const CallSiteStatistics& rhs)
+    {
+        return (lhs.numLiveBytes != rhs.numLiveBytes) ? (lhs.numLiveBytes > rhs.numLiveBytes) : (lhs.peakLiveBytes > rhs.peakLiveBytes);
+    });
+
+    std::ofstream csvFile(pCSVFilename, std::ios_base::out | std::ios_base::trunc);
+    if (!csvFile.is_open())
+    {
+        SHIP_LOG_ERROR("DebugAllocator::DumpCallSiteStatisticsToCSV --> Couldn't open %s", pCSVFilename);
+
+        return false;
+    }
+
+    csvFile << "File,Line,Live bytes,Live allocations,Total allocations,Peak live bytes\n";
+
+    for (const CallSiteStatistics& callSite : callSites)
+    {
+        csvFile << "\"" << ((callSite.pAllocationFilename != nullptr) ? callSite.pAllocationFilename : "") << "\","
+                << callSite.allocationLineNumber << ","
+                << callSite.numLiveBytes << ","
+                << callSite.numLiveAllocations << ","
+                << callSite.numAllocations << ","
+                << callSite.peakLiveBytes << "\n";
+    }
+
+    return true;
+}
+
+size_t DebugAllocator::FindAllocationSlot(size_t memoryAddress) const
+{
+    // The table is never full, so there is always an empty slot to stop at.
+    size_t slotMask = m_NumAllocationSlots - 1;
+    size_t slot = HashAddress(memoryAddress) & slotMask;
+
+    while (m_ppAllocationSlots[slot] != nullptr && m_ppAllocationSlots[slot]->memoryAddress != memoryAddress)
+    {
+        slot = (slot + 1) & slotMask;
+    }
+
+    return slot;
+}
+
+void DebugAllocator::RemoveAllocationSlot(size_t slot)
+{
+    // Move back the entries following the removed one that would not be found anymore, instead of leaving a tombstone
+    // that would make every later search longer.
+    size_t slotMask = m_NumAllocationSlots - 1;
+    size_t emptySlot = slot;
+
+    for (size_t currentSlot = (slot + 1) & slotMask; m_ppAllocationSlots[currentSlot] != nullptr; currentSlot = (currentSlot + 1) & slotMask)
+    {
+        size_t idealSlot = HashAddress(m_ppAllocationSlots[currentSlot]->memoryAddress) & slotMask;
+
+        shipBool canMoveToEmptySlot = (((currentSlot - idealSlot) & slotMask) >= ((currentSlot - emptySlot) & slotMask));
+        if (canMoveToEmptySlot)
+        {
+            m_ppAllocationSlots[emptySlot] = m_ppAllocationSlots[currentSlot];
+            emptySlot = currentSlot;
+        }
+    }
+
+    m_ppAllocationSlots[emptySlot] = nullptr;
+}
+
+DebugAllocator::DebugAllocationInfo* DebugAllocator::AddDebugAllocationInfo(size_t slot)
+{
+    if (m_pFirstFreeChunk == nullptr)
+    {
+        m_MemoryInfo.numUntrackedAllocations += 1;
+        return nullptr;
+    }
+
+    DebugAllocationInfo* pDebugAllocationInfo = reinterpret_cast<DebugAllocationInfo*>(m_pFirstFreeChunk);
+
+    m_pFirstFreeChunk = m_pFirstFreeChunk->pNextFreeChunk;
+
+    m_ppAllocationSlots[slot] = pDebugAllocationInfo;
+
+    return pDebugAllocationInfo;
+}
+
+void DebugAllocator::FreeDebugAllocationInfo(DebugAllocationInfo* pDebugAllocationInfo)
+{
+    CallSiteStatistics* pCallSiteStatistics = pDebugAllocationInfo->pCallSiteStatistics;
+    if (pCallSiteStatistics != nullptr)
+    {
+        SHIP_ASSERT(pCallSiteStatistics->numLiveAllocations > 0);
+
+        pCallSiteStatistics->numLiveBytes -= pDebugAllocationInfo->allocationSizeInBytes;
+        pCallSiteStatistics->numLiveAllocations -= 1;
     }
 
     SHIP_ASSERT(m_MemoryInfo.numAllocations > 0);
@@ -221,6 +460,110 @@ void DebugAllocator::Deallocate(const void* memory)
     m_MemoryInfo.numBytesAllocated -= pDebugAllocationInfo->allocationSizeInBytes;
 }
 
+DebugAllocator::CallSiteStatistics* DebugAllocator::FindOrAddCallSite(const shipChar* pAllocationFilename, int allocationLineNumber)
+{
+    CallSiteStatistics* pCallSiteStatistics = &m_pCallSiteSlots[FindCallSiteSlot(pAllocationFilename, allocationLineNumber)];
+
+    if (pCallSiteStatistics->numAllocations == 0)
+    {
+        // Same as the address table, keep empty slots around so that searches always end.
+        if (m_MemoryInfo.numCallSites >= m_NumCallSiteSlots * 3 / 4)
+        {
+            return nullptr;
+        }
+
+        pCallSiteStatistics->pAllocationFilename = pAllocationFilename;
+        pCallSiteStatistics->allocationLineNumber = allocationLineNumber;
+
+        m_MemoryInfo.numCallSites += 1;
+    }
+
+    return pCallSiteStatistics;
+}
+
+size_t DebugAllocator::FindCallSiteSlot(const shipChar* pAllocationFilename, int allocationLineNumber) const
+{
+    // Call sites are never removed, and a slot is in use as soon as an allocation was made from it.
+    size_t slotMask = m_NumCallSiteSlots - 1;
+    size_t slot = HashCallSite(pAllocationFilename, allocationLineNumber) & slotMask;
+
+    while (m_pCallSiteSlots[slot].numAllocations > 0 &&
+           (m_pCallSiteSlots[slot].allocationLineNumber != allocationLineNumber || !IsSameFilename(m_pCallSiteSlots[slot].pAllocationFilename, pAllocationFilename)))
+    {
+        slot = (slot + 1) & slotMask;
+    }
+
+    return slot;
+}
+
+void DebugAllocator::ReportMemoryLeaks() const
+{
+    SHIP_LOG_ERROR("***** Memory leaks detected! *****");
+
+    // For convenience, let's pack the memory leaks by allocator. So we need to first gather the different allocators.
+    BaseAllocator* pAllocators[32];
+    shipUint32 numMemoryLeaksPerAllocator[32];
+    size_t numAllocators = 0;
+
+    for (size_t slot = 0; slot < m_NumAllocationSlots; slot++)
+    {
+        const DebugAllocationInfo* pCurrentMemoryLeak = m_ppAllocationSlots[slot];
+        if (pCurrentMemoryLeak == nullptr)
+        {
+            continue;
+        }
+
+        size_t idx = 0;
+        for (; idx < numAllocators; idx++)
+        {
+            if (pAllocators[idx] == pCurrentMemoryLeak->pAllocator)
+            {
+                break;
+            }
+        }
+
+        shipBool newAllocator = (idx == numAllocators);
+
+        if (newAllocator)
+        {
+            if (numAllocators == sizeof(pAllocators) / sizeof(pAllocators[0]))
+            {
+                continue;
+            }
+
+            pAllocators[idx] = pCurrentMemoryLeak->pAllocator;
+            numMemoryLeaksPerAllocator[idx] = 1;
+
+            numAllocators += 1;
+        }
+        else
+        {
+            numMemoryLeaksPerAllocator[idx] += 1;
+        }
+    }
+
+    for (size_t i = 0; i < numAllocators; i++)
+    {
+        BaseAllocator* pAllocator = pAllocators[i];
+
+        SHIP_LOG_ERROR("    %u Memory leaks for allocator %s at address 0x%p", numMemoryLeaksPerAllocator[i], pAllocator->GetAllocatorDebugName(), pAllocator);
+
+        for (size_t slot = 0; slot < m_NumAllocationSlots; slot++)
+        {
+            const DebugAllocationInfo* pCurrentMemoryLeak = m_ppAllocationSlots[slot];
+            if (pCurrentMemoryLeak == nullptr || pCurrentMemoryLeak->pAllocator != pAllocator)
+            {
+                continue;
+            }
+
+            const shipChar* pAllocationFilename = (pCurrentMemoryLeak->pCallSiteStatistics != nullptr) ? pCurrentMemoryLeak->pCallSiteStatistics->pAllocationFilename : "<unknown>";
+            int allocationLineNumber = (pCurrentMemoryLeak->pCallSiteStatistics != nullptr) ? pCurrentMemoryLeak->pCallSiteStatistics->allocationLineNumber : 0;
+
+            SHIP_LOG_ERROR("        Memory leak of allocation #%llu of %llu bytes at address 0x%p --> \t%s (line %d)", pCurrentMemoryLeak->allocationId, pCurrentMemoryLeak->allocationSizeInBytes, pCurrentMemoryLeak->memoryAddress, pAllocationFilename, allocationLineNumber);
+        }
+    }
+}
+
 }
 
-#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
\ No newline at end of file
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
@@ -11,6 +11,10 @@ namespace Shipyard
     // This allocator is not really an allocator, just a debugging class to log allocations. As such, it
     // doesn't have the same interface as the BaseAllocator, since we'd like to log the result of an other
     // allocation.
+    //
+    // Live allocations are found by address in an open-addressing hash table, so that tracking them stays cheap no matter how
+    // many there are. Statistics are also aggregated per call site, which is the (pAllocationFilename, allocationLineNumber)
+    // pair given on allocation, and can be dumped to a CSV file at any time to find where memory is allocated.
     class SHIPYARD_SYSTEM_API DebugAllocator
     {
     public:
@@ -20,11 +24,33 @@ namespace Shipyard
             size_t allocationSizeToBreak = size_t(-1);
         };
 
+        struct CallSiteStatistics
+        {
+            const shipChar* pAllocationFilename = nullptr;
+            int allocationLineNumber = 0;
+
+            size_t numLiveBytes = 0;
+            size_t numLiveAllocations = 0;
+            size_t numAllocations = 0;
+            size_t peakLiveBytes = 0;
+        };
+
     private:
         struct MemoryInfo
         {
             size_t numAllocations = 0;
             size_t numBytesAllocated = 0;
+
+            // Allocations made when every debug entry was in use, which therefore don't appear anywhere.
+            size_t numUntrackedAllocations = 0;
+
+            // Deallocations of memory that isn't tracked. They can't be told apart from invalid ones, and are only accepted as
+            // long as there are untracked allocations left to account for them.
+            size_t numUntrackedDeallocations = 0;
+
+            // Allocations returned while the same memory was still live, which are then forgotten about.
+            size_t numOverwrittenAllocations = 0;
+            size_t numCallSites = 0;
         };
 
     public:
@@ -35,6 +61,7 @@ namespace Shipyard
             return s_DebugAllocator;
         }
 
+        // The heap is shared between the allocation entries, the address hash table and the call site table.
         shipBool Create(void* pHeap, size_t heapSize);
         void Destroy();
 
@@ -42,6 +69,19 @@ namespace Shipyard
 
         void Deallocate(const void* pAllocatedMemory);
 
+        // Blocks kept in the GlobalAllocator's thread-local caches are deallocated as far as the DebugAllocator is concerned. They
+        // are tracked again right before being given back to their allocator, so that it deallocates a live allocation.
+        void TrackCachedBlock(BaseAllocator* pAllocator, const void* pBlock, size_t size);
+
+        // Updates the size of an allocation that was resized in place.
+        void Resize(const void* pAllocatedMemory, size_t newSize);
+
+        // Returns false if no allocation was ever made from this call site.
+        shipBool GetCallSiteStatistics(const shipChar* pAllocationFilename, int allocationLineNumber, CallSiteStatistics& callSiteStatistics);
+
+        // Writes one line per call site, sorted by live bytes.
+        shipBool DumpCallSiteStatisticsToCSV(const shipChar* pCSVFilename);
+
         const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
 
     private:
@@ -58,11 +98,8 @@ namespace Shipyard
 
             BaseAllocator* pAllocator = nullptr;
 
-            DebugAllocationInfo* pNextDebugAllocationInfo = nullptr;
-            DebugAllocationInfo* pPreviousDebugAllocationInfo = nullptr;
-
-            const shipChar* pAllocationFilename = nullptr;
-            int allocationLineNumber = 0;
+            // Null when the call site table is full.
+            CallSiteStatistics* pCallSiteStatistics = nullptr;
         };
 
     private:
@@ -73,8 +110,26 @@ namespace Shipyard
         DebugAllocator& operator= (const DebugAllocator& rhs) = delete;
         DebugAllocator& operator= (const DebugAllocator&& rhs) = delete;
 
+        size_t FindAllocationSlot(size_t memoryAddress) const;
+
+        // Returns nullptr if every entry is in use.
+        DebugAllocationInfo* AddDebugAllocationInfo(size_t slot);
+        void RemoveAllocationSlot(size_t slot);
+        void FreeDebugAllocationInfo(DebugAllocationInfo* pDebugAllocationInfo);
+
+        CallSiteStatistics* FindOrAddCallSite(const shipChar* pAllocationFilename, int allocationLineNumber);
+        size_t FindCallSiteSlot(const shipChar* pAllocationFilename, int allocationLineNumber) const;
+
+        void ReportMemoryLeaks() const;
+
         FreeChunkHeader* m_pFirstFreeChunk;
-        DebugAllocationInfo* m_pFirstDebugAllocationInfo;
+
+        // Tables have a power of 2 number of slots, and use linear probing. Empty slots are null.
+        DebugAllocationInfo** m_ppAllocationSlots;
+        size_t m_NumAllocationSlots;
+
+        CallSiteStatistics* m_pCallSiteSlots;
+        size_t m_NumCallSiteSlots;
 
         void* m_pHeap;
         size_t m_HeapSize;
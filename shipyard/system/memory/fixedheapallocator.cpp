@@ -6,6 +6,7 @@
 #include <system/systemdebug.h>
 
 #include <system/memory/memoryutils.h>
+#include <system/memory/virtualmemoryheap.h>
 
 namespace Shipyard
 {;
@@ -19,6 +20,7 @@ const size_t FixedHeapAllocator::MemoryAllocationHeaderSize = sizeof(MemoryAlloc
 
 FixedHeapAllocator::FixedHeapAllocator()
     : m_pFirstFreeMemoryBlock(nullptr)
+    , m_pVirtualMemoryHeap(nullptr)
 {
 }
 
@@ -52,6 +54,8 @@ shipBool FixedHeapAllocator::Create(void* pHeap, size_t heapSize)
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
     m_MemoryInfo.heapSize = heapSize;
+    m_MemoryInfo.numBytesCommitted = heapSize;
+    m_MemoryInfo.numBytesResident = heapSize;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
     FreeMemoryBlock* pFreeMemoryBlock = reinterpret_cast<FreeMemoryBlock*>(m_pHeap);
@@ -60,6 +64,33 @@ shipBool FixedHeapAllocator::Create(void* pHeap, size_t heapSize)
     pFreeMemoryBlock->pPreviousFreeBlock = nullptr;
 
     m_pFirstFreeMemoryBlock = pFreeMemoryBlock;
+    m_pVirtualMemoryHeap = nullptr;
+
+    return true;
+}
+
+shipBool FixedHeapAllocator::Create(VirtualMemoryHeap* pVirtualMemoryHeap)
+{
+    SHIP_ASSERT_MSG(pVirtualMemoryHeap != nullptr && pVirtualMemoryHeap->GetBaseAddress() != nullptr, "FixedHeapAllocator::Create --> Trying to initialize a fixed heap allocator with an invalid virtual memory heap");
+
+    // The first free block needs some committed memory to live in.
+    if (!pVirtualMemoryHeap->Grow(pVirtualMemoryHeap->GetCommitGranularity()))
+    {
+        return false;
+    }
+
+    if (!Create(pVirtualMemoryHeap->GetBaseAddress(), pVirtualMemoryHeap->GetCommittedSize()))
+    {
+        return false;
+    }
+
+    // Allocations can be anywhere in the reserved range.
+    m_HeapSize = pVirtualMemoryHeap->GetReservedSize();
+    m_pVirtualMemoryHeap = pVirtualMemoryHeap;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.heapSize = m_HeapSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
     return true;
 }
@@ -68,6 +99,8 @@ void FixedHeapAllocator::Destroy()
 {
     m_pHeap = nullptr;
     m_HeapSize = 0;
+
+    m_pVirtualMemoryHeap = nullptr;
 }
 
 void* FixedHeapAllocator::Allocate(size_t size, size_t alignment
@@ -84,6 +117,18 @@ void* FixedHeapAllocator::Allocate(size_t size, size_t alignment
 
     std::lock_guard<std::mutex> lock(m_Lock);
 
+    void* pUserPointer = FindAndPrepareBlock(size, alignment);
+
+    if (pUserPointer == nullptr && m_pVirtualMemoryHeap != nullptr && GrowHeap(size, alignment))
+    {
+        pUserPointer = FindAndPrepareBlock(size, alignment);
+    }
+
+    return pUserPointer;
+}
+
+void* FixedHeapAllocator::FindAndPrepareBlock(size_t size, size_t alignment)
+{
     if (m_pFirstFreeMemoryBlock == nullptr)
     {
         return nullptr;
@@ -208,7 +253,7 @@ void* FixedHeapAllocator::Allocate(size_t size, size_t alignment
         m_MemoryInfo.numUserBytesAllocated += size;
         m_MemoryInfo.maxAllocatedUserSize = MAX(m_MemoryInfo.maxAllocatedUserSize, size);
         m_MemoryInfo.minAllocatedUserSize = MIN(m_MemoryInfo.minAllocatedUserSize, size);
-        m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.maxAllocatedUserSize, m_MemoryInfo.numUserBytesAllocated);
+        m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.peakUserBytesAllocated, m_MemoryInfo.numUserBytesAllocated);
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
 #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
@@ -315,6 +360,8 @@ void FixedHeapAllocator::Deallocate(const void* memory)
                     if (canCollapsePreviousMemoryBlock)
                     {
                         pCurrentFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader += pNewFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader;
+
+                        pNewFreeMemoryBlock = pCurrentFreeMemoryBlock;
                     }
                     else
                     {
@@ -397,6 +444,201 @@ void FixedHeapAllocator::Deallocate(const void* memory)
 
     memset(pStartOfFreedMemory, FixedHeapAllocatorDebugConstants_FreedMemory, sizeOfFreedMemory);
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
+
+    if (m_pVirtualMemoryHeap != nullptr)
+    {
+        ReleaseHeapEnd(pNewFreeMemoryBlock);
+    }
 }
 
+shipBool FixedHeapAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    SHIP_ASSERT_MSG(size_t(m_pHeap) <= size_t(memory) && (size_t(m_pHeap) + size_t(m_HeapSize)) >= size_t(memory), "FixedHeapAllocator::TryExpandInPlace --> Memory address %p was not allocated from allocator %p", memory, this);
+
+    size_t addressOfMemoryAllocationHeader = size_t(memory) - sizeof(MemoryAllocationHeader);
+    MemoryAllocationHeader* pMemoryAllocationHeader = reinterpret_cast<MemoryAllocationHeader*>(addressOfMemoryAllocationHeader);
+
+    // The allocation may already be bigger than requested, if it claimed a memory bubble when it was allocated.
+    size_t userAllocationRegionSizeInBytes = pMemoryAllocationHeader->userAllocationRegionSizeInBytes;
+    if (newSize <= userAllocationRegionSizeInBytes)
+    {
+        return true;
+    }
+
+    size_t endAddressOfAllocation = size_t(memory) + userAllocationRegionSizeInBytes;
+    size_t requiredExtraSize = newSize - userAllocationRegionSizeInBytes;
+
+    // Free blocks are sorted by address, so we can stop looking as soon as we get past the end of the allocation.
+    FreeMemoryBlock* pNextFreeMemoryBlock = m_pFirstFreeMemoryBlock;
+    while (pNextFreeMemoryBlock != nullptr && size_t(pNextFreeMemoryBlock) < endAddressOfAllocation)
+    {
+        pNextFreeMemoryBlock = pNextFreeMemoryBlock->pNextFreeBlock;
+    }
+
+    shipBool isFollowedByFreeMemoryBlock = (pNextFreeMemoryBlock != nullptr && size_t(pNextFreeMemoryBlock) == endAddressOfAllocation);
+    if (!isFollowedByFreeMemoryBlock || pNextFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader < requiredExtraSize)
+    {
+        return false;
+    }
+
+    FreeMemoryBlock freeMemoryBlock = *pNextFreeMemoryBlock;
+
+    size_t remainingSizeForFreeBlock = freeMemoryBlock.sizeOfBlockInBytesIncludingThisHeader - requiredExtraSize;
+
+    constexpr size_t minimalAllocationSizeInBytes = 1;
+    size_t minimalSizeForNewFreeBlock = MAX(sizeof(FreeMemoryBlock), sizeof(MemoryAllocationHeader) + minimalAllocationSizeInBytes);
+
+    FreeMemoryBlock* pReplacementFreeMemoryBlock = nullptr;
+
+    shipBool canKeepFreeBlock = (remainingSizeForFreeBlock >= minimalSizeForNewFreeBlock);
+    if (canKeepFreeBlock)
+    {
+        // Move the free block's header past the grown allocation, it keeps its place in the list.
+        pReplacementFreeMemoryBlock = reinterpret_cast<FreeMemoryBlock*>(endAddressOfAllocation + requiredExtraSize);
+
+        pReplacementFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader = remainingSizeForFreeBlock;
+        pReplacementFreeMemoryBlock->pNextFreeBlock = freeMemoryBlock.pNextFreeBlock;
+        pReplacementFreeMemoryBlock->pPreviousFreeBlock = freeMemoryBlock.pPreviousFreeBlock;
+
+        if (freeMemoryBlock.pNextFreeBlock != nullptr)
+        {
+            freeMemoryBlock.pNextFreeBlock->pPreviousFreeBlock = pReplacementFreeMemoryBlock;
+        }
+    }
+    else
+    {
+        // Same as when allocating, claim the memory bubble that would be left as part of the allocation.
+        requiredExtraSize += remainingSizeForFreeBlock;
+
+        if (freeMemoryBlock.pNextFreeBlock != nullptr)
+        {
+            freeMemoryBlock.pNextFreeBlock->pPreviousFreeBlock = freeMemoryBlock.pPreviousFreeBlock;
+        }
+    }
+
+    if (freeMemoryBlock.pPreviousFreeBlock != nullptr)
+    {
+        freeMemoryBlock.pPreviousFreeBlock->pNextFreeBlock = (canKeepFreeBlock) ? pReplacementFreeMemoryBlock : freeMemoryBlock.pNextFreeBlock;
+    }
+
+    if (m_pFirstFreeMemoryBlock == pNextFreeMemoryBlock)
+    {
+        m_pFirstFreeMemoryBlock = (canKeepFreeBlock) ? pReplacementFreeMemoryBlock : freeMemoryBlock.pNextFreeBlock;
+    }
+
+    pMemoryAllocationHeader->userAllocationRegionSizeInBytes += requiredExtraSize;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.numBytesUsed += requiredExtraSize;
+    m_MemoryInfo.numUserBytesAllocated += requiredExtraSize;
+    m_MemoryInfo.maxAllocatedUserSize = MAX(m_MemoryInfo.maxAllocatedUserSize, pMemoryAllocationHeader->userAllocationRegionSizeInBytes);
+    m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.peakUserBytesAllocated, m_MemoryInfo.numUserBytesAllocated);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+shipBool FixedHeapAllocator::GrowHeap(size_t allocationSize, size_t alignment)
+{
+    size_t heapStartAddress = size_t(m_pHeap);
+    size_t committedSize = m_pVirtualMemoryHeap->GetCommittedSize();
+
+    // Enough for the allocation wherever its alignment puts it in a new free block, as well as a free block after it.
+    const size_t minimalSpaceRequiredForHeader = MAX(sizeof(FreeMemoryBlock), sizeof(MemoryAllocationHeader));
+    size_t requiredSize = allocationSize + alignment + 2 * minimalSpaceRequiredForHeader;
+
+    // Find the last free block, since it can be extended with the new pages if it reaches the end of the committed memory.
+    FreeMemoryBlock* pLastFreeMemoryBlock = m_pFirstFreeMemoryBlock;
+    while (pLastFreeMemoryBlock != nullptr && pLastFreeMemoryBlock->pNextFreeBlock != nullptr)
+    {
+        pLastFreeMemoryBlock = pLastFreeMemoryBlock->pNextFreeBlock;
+    }
+
+    size_t endAddressOfLastFreeBlock = (pLastFreeMemoryBlock != nullptr) ? size_t(pLastFreeMemoryBlock) + pLastFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader : 0;
+
+    shipBool canExtendLastFreeBlock = (endAddressOfLastFreeBlock == heapStartAddress + committedSize);
+    if (canExtendLastFreeBlock)
+    {
+        size_t sizeOfLastFreeBlock = pLastFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader;
+        requiredSize -= MIN(sizeOfLastFreeBlock, requiredSize - minimalSpaceRequiredForHeader);
+    }
+
+    if (!m_pVirtualMemoryHeap->Grow(committedSize + requiredSize))
+    {
+        return false;
+    }
+
+    size_t newCommittedSize = m_pVirtualMemoryHeap->GetCommittedSize();
+
+#ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
+    memset(reinterpret_cast<void*>(heapStartAddress + committedSize), FixedHeapAllocatorDebugConstants_NeverAllocatedMemory, newCommittedSize - committedSize);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
+
+    if (canExtendLastFreeBlock)
+    {
+        pLastFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader += (newCommittedSize - committedSize);
+    }
+    else
+    {
+        FreeMemoryBlock* pNewFreeMemoryBlock = reinterpret_cast<FreeMemoryBlock*>(heapStartAddress + committedSize);
+        pNewFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader = (newCommittedSize - committedSize);
+        pNewFreeMemoryBlock->pNextFreeBlock = nullptr;
+        pNewFreeMemoryBlock->pPreviousFreeBlock = pLastFreeMemoryBlock;
+
+        if (pLastFreeMemoryBlock != nullptr)
+        {
+            pLastFreeMemoryBlock->pNextFreeBlock = pNewFreeMemoryBlock;
+        }
+        else
+        {
+            m_pFirstFreeMemoryBlock = pNewFreeMemoryBlock;
+        }
+    }
+
+    return true;
+}
+
+void FixedHeapAllocator::ReleaseHeapEnd(FreeMemoryBlock* pLastFreeMemoryBlock)
+{
+    size_t startAddressOfBlock = size_t(pLastFreeMemoryBlock);
+    size_t endAddressOfBlock = startAddressOfBlock + pLastFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader;
+
+    size_t heapStartAddress = size_t(m_pHeap);
+    size_t committedSize = m_pVirtualMemoryHeap->GetCommittedSize();
+
+    if (endAddressOfBlock != heapStartAddress + committedSize)
+    {
+        return;
+    }
+
+    // Keep the free block's header committed, as well as one extra commit granule so that an allocation pattern oscillating
+    // around a page boundary doesn't keep going back to the OS.
+    size_t commitGranularity = m_pVirtualMemoryHeap->GetCommitGranularity();
+    size_t sizeToKeep = MemoryUtils::AlignAddress(startAddressOfBlock - heapStartAddress + sizeof(FreeMemoryBlock), commitGranularity) + commitGranularity;
+
+    if (sizeToKeep >= committedSize)
+    {
+        return;
+    }
+
+    m_pVirtualMemoryHeap->Shrink(sizeToKeep);
+
+    pLastFreeMemoryBlock->sizeOfBlockInBytesIncludingThisHeader = (heapStartAddress + m_pVirtualMemoryHeap->GetCommittedSize() - startAddressOfBlock);
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+const FixedHeapAllocator::MemoryInfo& FixedHeapAllocator::GetMemoryInfo() const
+{
+    if (m_pVirtualMemoryHeap != nullptr)
+    {
+        m_MemoryInfo.numBytesCommitted = m_pVirtualMemoryHeap->GetCommittedSize();
+        m_MemoryInfo.numBytesResident = m_pVirtualMemoryHeap->GetResidentSize();
+    }
+
+    return m_MemoryInfo;
+}
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
 }
\ No newline at end of file
@@ -6,9 +6,14 @@
 
 namespace Shipyard
 {
+    class VirtualMemoryHeap;
+
     // Use this class to allocate variably sized chunk of memory from a fixed heap.
     // The FixedHeapAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
     // calling FixedHeapAllocator::Destroy()
+    //
+    // When created on a VirtualMemoryHeap, the heap is committed as needed when allocations don't fit anymore, and the free memory
+    // at the end of the heap is given back to the OS.
     class SHIPYARD_SYSTEM_API FixedHeapAllocator : public BaseAllocator
     {
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
@@ -20,6 +25,7 @@ namespace Shipyard
         ~FixedHeapAllocator();
 
         shipBool Create(void* pHeap, size_t heapSize);
+        shipBool Create(VirtualMemoryHeap* pVirtualMemoryHeap);
         void Destroy();
 
         // Alignment must be a power of 2 and non-zero.
@@ -35,8 +41,11 @@ namespace Shipyard
         // Memory must come from the allocator that allocated it.
         virtual void Deallocate(const void* memory) override;
 
+        // Grows the allocation into the free block that directly follows it, if there is one big enough.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
-        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+        const MemoryInfo& GetMemoryInfo() const;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
     private:
@@ -65,6 +74,10 @@ namespace Shipyard
             size_t maxAllocatedUserSize = 0;
             size_t minAllocatedUserSize = size_t(-1);
             size_t peakUserBytesAllocated = 0;
+
+            // Sampled every time the memory info is retrieved, since pages become resident when they're first touched.
+            mutable size_t numBytesCommitted = 0;
+            mutable size_t numBytesResident = 0;
         };
 
     public:
@@ -73,8 +86,19 @@ namespace Shipyard
         static const size_t MemoryAllocationHeaderSize;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
+    private:
+        void* FindAndPrepareBlock(size_t size, size_t alignment);
+
+        // Commits enough of the virtual memory heap for an allocation of allocationSize bytes with the given alignment,
+        // and makes it available as a free block.
+        shipBool GrowHeap(size_t allocationSize, size_t alignment);
+
+        // Gives the pages of the free block back to the OS if it's the last one of the heap.
+        void ReleaseHeapEnd(FreeMemoryBlock* pLastFreeMemoryBlock);
+
     private:
         FreeMemoryBlock* m_pFirstFreeMemoryBlock;
+        VirtualMemoryHeap* m_pVirtualMemoryHeap;
 
         std::mutex m_Lock;
 
@@ -0,0 +1,285 @@
+#include <system/systemprecomp.h>
+
+#include <system/memory/frameallocator.h>
+
+#include <system/systemdebug.h>
+
+#include <system/atomicoperations.h>
+
+#include <system/memory/memoryutils.h>
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+#include <system/logger.h>
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+namespace Shipyard
+{;
+
+namespace
+{
+    // Allocations bigger than this fraction of a thread's sub-arena go directly in the frame's region, to avoid wasting
+    // most of a sub-arena when it can't fit them.
+    const size_t g_ThreadArenaMaxAllocationSizeDivisor = 4;
+
+    // A thread can allocate from a few FrameAllocators at the same time without having to reserve a new sub-arena every time.
+    const shipUint32 g_NumThreadArenasPerThread = 4;
+
+    struct ThreadArena
+    {
+        // Stamp of the frame the sub-arena was reserved in, 0 if the sub-arena is unused.
+        shipUint64 frameStamp = 0;
+        size_t currentAddress = 0;
+        size_t endAddress = 0;
+    };
+
+    struct ThreadArenaCache
+    {
+        ThreadArena threadArenas[g_NumThreadArenasPerThread];
+        shipUint32 nextThreadArenaToReplace = 0;
+    };
+
+    thread_local ThreadArenaCache g_ThreadArenaCache;
+
+    SHIP_ALIGN(8) shipUint64 g_FrameStampCounter = 0;
+
+    shipUint64 GetNewFrameStamp()
+    {
+        return AtomicOperations::Increment(g_FrameStampCounter);
+    }
+}
+
+FrameAllocator::FrameAllocator()
+    : m_FrameRegionSize(0)
+    , m_ThreadArenaSize(0)
+    , m_NumFramesInFlight(0)
+    , m_CurrentFrameRegionIndex(0)
+    , m_CurrentFrameStamp(0)
+{
+    memset(m_FrameRegions, 0, sizeof(m_FrameRegions));
+}
+
+FrameAllocator::~FrameAllocator()
+{
+    SHIP_ASSERT_MSG(m_pHeap == nullptr, "It is required to manually call Destroy on the FrameAllocator %p to control when to free the memory.", this);
+}
+
+shipBool FrameAllocator::Create(void* pHeap, size_t heapSize, shipUint32 numFramesInFlight, size_t threadArenaSize)
+{
+    SHIP_ASSERT(pHeap != nullptr);
+    SHIP_ASSERT(numFramesInFlight > 0 && numFramesInFlight <= ms_MaxNumFramesInFlight);
+    SHIP_ASSERT_MSG(MemoryUtils::IsAddressAligned(size_t(pHeap), 8), "FrameAllocator::Create --> Heap must be aligned to 8 bytes.");
+
+    m_pHeap = pHeap;
+    m_HeapSize = heapSize;
+
+    // Keep every region aligned like the heap.
+    m_FrameRegionSize = (heapSize / numFramesInFlight) & ~size_t(7);
+
+    if (m_FrameRegionSize == 0)
+    {
+        m_pHeap = nullptr;
+        m_HeapSize = 0;
+
+        return false;
+    }
+
+    m_ThreadArenaSize = MIN(threadArenaSize, m_FrameRegionSize);
+    m_NumFramesInFlight = numFramesInFlight;
+    m_CurrentFrameRegionIndex = 0;
+    m_CurrentFrameStamp = GetNewFrameStamp();
+
+    memset(m_FrameRegions, 0, sizeof(m_FrameRegions));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo = MemoryInfo();
+    m_MemoryInfo.heapSize = heapSize;
+    m_MemoryInfo.frameRegionSize = m_FrameRegionSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+void FrameAllocator::Destroy()
+{
+    m_pHeap = nullptr;
+    m_HeapSize = 0;
+
+    m_FrameRegionSize = 0;
+    m_NumFramesInFlight = 0;
+
+    // Make sure no thread keeps using a sub-arena from this allocator.
+    m_CurrentFrameStamp = 0;
+}
+
+void FrameAllocator::BeginFrame(shipUint32 frameIndex)
+{
+    SHIP_ASSERT(m_pHeap != nullptr);
+
+    m_CurrentFrameRegionIndex = (frameIndex % m_NumFramesInFlight);
+    m_CurrentFrameStamp = GetNewFrameStamp();
+
+    FrameRegion& frameRegion = m_FrameRegions[m_CurrentFrameRegionIndex];
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    ReportFrameRegionUsage(frameRegion);
+
+    frameRegion.numUserBytesAllocated = 0;
+    frameRegion.numFailedAllocations = 0;
+    frameRegion.numFailedBytes = 0;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    frameRegion.allocationOffset = 0;
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment
+
+        #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            , const shipChar* pAllocationFilename
+            , int allocationLineNumber
+        #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        )
+{
+    SHIP_ASSERT(m_pHeap != nullptr);
+
+    FrameRegion& frameRegion = m_FrameRegions[m_CurrentFrameRegionIndex];
+    size_t regionStartAddress = size_t(m_pHeap) + m_CurrentFrameRegionIndex * m_FrameRegionSize;
+
+    size_t allocatedAddress = 0;
+
+    if (size + alignment <= m_ThreadArenaSize / g_ThreadArenaMaxAllocationSizeDivisor)
+    {
+        allocatedAddress = AllocateFromThreadArena(frameRegion, regionStartAddress, size, alignment);
+    }
+    else
+    {
+        allocatedAddress = AllocateFromRegion(frameRegion, regionStartAddress, size, alignment);
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    if (allocatedAddress == 0)
+    {
+        AtomicOperations::Increment(frameRegion.numFailedAllocations);
+        AtomicOperations::Add(frameRegion.numFailedBytes, shipUint64(size));
+    }
+    else
+    {
+        AtomicOperations::Add(frameRegion.numUserBytesAllocated, shipUint64(size));
+    }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return reinterpret_cast<void*>(allocatedAddress);
+}
+
+void FrameAllocator::Deallocate(const void* memory)
+{
+    SHIP_ASSERT(memory == nullptr || (size_t(memory) >= size_t(m_pHeap) && size_t(memory) < size_t(m_pHeap) + m_HeapSize));
+}
+
+size_t FrameAllocator::AllocateFromRegion(FrameRegion& frameRegion, size_t regionStartAddress, size_t size, size_t alignment)
+{
+    size_t allocationOffset = 0;
+    size_t newAllocationOffset = 0;
+    size_t allocatedAddress = 0;
+
+    do
+    {
+        allocationOffset = frameRegion.allocationOffset;
+
+        allocatedAddress = MemoryUtils::AlignAddress(regionStartAddress + allocationOffset, alignment);
+        newAllocationOffset = allocatedAddress - regionStartAddress + size;
+
+        shipBool validAllocation = (newAllocationOffset <= m_FrameRegionSize);
+        if (!validAllocation)
+        {
+            return 0;
+        }
+
+    } while (AtomicOperations::CompareExchange(frameRegion.allocationOffset, newAllocationOffset, allocationOffset) != allocationOffset);
+
+    return allocatedAddress;
+}
+
+size_t FrameAllocator::AllocateFromThreadArena(FrameRegion& frameRegion, size_t regionStartAddress, size_t size, size_t alignment)
+{
+    ThreadArenaCache& threadArenaCache = g_ThreadArenaCache;
+
+    ThreadArena* pThreadArena = nullptr;
+    for (ThreadArena& threadArena : threadArenaCache.threadArenas)
+    {
+        if (threadArena.frameStamp == m_CurrentFrameStamp)
+        {
+            pThreadArena = &threadArena;
+            break;
+        }
+    }
+
+    if (pThreadArena != nullptr)
+    {
+        size_t allocatedAddress = MemoryUtils::AlignAddress(pThreadArena->currentAddress, alignment);
+        if (allocatedAddress + size <= pThreadArena->endAddress)
+        {
+            pThreadArena->currentAddress = allocatedAddress + size;
+
+            return allocatedAddress;
+        }
+    }
+    else
+    {
+        pThreadArena = &threadArenaCache.threadArenas[threadArenaCache.nextThreadArenaToReplace];
+        threadArenaCache.nextThreadArenaToReplace = (threadArenaCache.nextThreadArenaToReplace + 1) % g_NumThreadArenasPerThread;
+    }
+
+    size_t threadArenaStartAddress = AllocateFromRegion(frameRegion, regionStartAddress, m_ThreadArenaSize, 8);
+    if (threadArenaStartAddress == 0)
+    {
+        // Not enough room left in the region for a whole sub-arena, the allocation may still fit on its own.
+        return AllocateFromRegion(frameRegion, regionStartAddress, size, alignment);
+    }
+
+    pThreadArena->frameStamp = m_CurrentFrameStamp;
+    pThreadArena->endAddress = threadArenaStartAddress + m_ThreadArenaSize;
+
+    size_t allocatedAddress = MemoryUtils::AlignAddress(threadArenaStartAddress, alignment);
+    pThreadArena->currentAddress = allocatedAddress + size;
+
+    return allocatedAddress;
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+void FrameAllocator::ReportFrameRegionUsage(FrameRegion& frameRegion)
+{
+    // The region was never used, we're still filling the frames in flight for the first time.
+    if (frameRegion.allocationOffset == 0 && frameRegion.numFailedAllocations == 0)
+    {
+        return;
+    }
+
+    size_t frameBytesUsed = frameRegion.allocationOffset;
+    size_t frameUserBytesAllocated = size_t(frameRegion.numUserBytesAllocated);
+
+    m_MemoryInfo.numFramesCompleted += 1;
+    m_MemoryInfo.lastFrameBytesUsed = frameBytesUsed;
+    m_MemoryInfo.lastFrameUserBytesAllocated = frameUserBytesAllocated;
+    m_MemoryInfo.peakFrameBytesUsed = MAX(m_MemoryInfo.peakFrameBytesUsed, frameBytesUsed);
+    m_MemoryInfo.peakFrameUserBytesAllocated = MAX(m_MemoryInfo.peakFrameUserBytesAllocated, frameUserBytesAllocated);
+
+    if (frameRegion.numFailedAllocations > 0)
+    {
+        m_MemoryInfo.numFramesOverflowed += 1;
+        m_MemoryInfo.numFailedAllocations += frameRegion.numFailedAllocations;
+
+        SHIP_LOG_WARNING(
+                "FrameAllocator %s overflowed: %llu allocations (%llu bytes) failed in a frame. Frame used %llu bytes (%llu user bytes) out of %llu, peak usage is %llu bytes.",
+                m_pAllocatorDebugName,
+                frameRegion.numFailedAllocations,
+                frameRegion.numFailedBytes,
+                shipUint64(frameBytesUsed),
+                shipUint64(frameUserBytesAllocated),
+                shipUint64(m_FrameRegionSize),
+                shipUint64(m_MemoryInfo.peakFrameBytesUsed));
+    }
+}
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <system/memory/baseallocator.h>
+
+namespace Shipyard
+{
+    // Allocator for transient data that lives for a few frames. The heap is split in numFramesInFlight regions, and each
+    // frame allocates linearly in its own region, the same way the LinearAllocator does. BeginFrame recycles the region of the
+    // oldest frame in flight, so data from the previous frames stays valid while the current frame is being built.
+    //
+    // To avoid contention on the region's offset, small allocations are made from per-thread sub-arenas that are reserved
+    // from the current region. Single deallocation does nothing, memory is only given back when its region is recycled.
+    //
+    // The FrameAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
+    // calling FrameAllocator::Destroy()
+    class SHIPYARD_SYSTEM_API FrameAllocator : public BaseAllocator
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    public:
+        static const shipUint32 ms_MaxNumFramesInFlight = 4;
+        static const size_t ms_DefaultThreadArenaSize = 64 * 1024;
+
+    public:
+        FrameAllocator();
+        ~FrameAllocator();
+
+        // pHeap is assumed to be aligned to 8 bytes. threadArenaSize is the size reserved by a thread every time its sub-arena
+        // runs out of memory, 0 means that every allocation is made directly in the current region.
+        shipBool Create(void* pHeap, size_t heapSize, shipUint32 numFramesInFlight, size_t threadArenaSize = ms_DefaultThreadArenaSize);
+        void Destroy();
+
+        // Starts allocating in the region of frameIndex, discarding everything that was allocated in it numFramesInFlight frames ago.
+        // The caller must make sure that the frame being recycled is not used anymore, on the CPU or the GPU.
+        // Not thread-safe, no allocation can happen during BeginFrame.
+        void BeginFrame(shipUint32 frameIndex);
+
+        // Alignment must be a power of 2 and non-zero. Returns nullptr if the current frame's region is full.
+        virtual void* Allocate(size_t size, size_t alignment
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                ) override;
+
+        // Does nothing, memory is reclaimed when its frame's region is recycled by BeginFrame.
+        virtual void Deallocate(const void* memory) override;
+
+        size_t GetFrameRegionSize() const { return m_FrameRegionSize; }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        struct FrameRegion
+        {
+            SHIP_ALIGN(8) size_t allocationOffset;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            SHIP_ALIGN(8) shipUint64 numUserBytesAllocated;
+            SHIP_ALIGN(8) shipUint64 numFailedAllocations;
+            SHIP_ALIGN(8) shipUint64 numFailedBytes;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        };
+
+    private:
+        size_t AllocateFromRegion(FrameRegion& frameRegion, size_t regionStartAddress, size_t size, size_t alignment);
+        size_t AllocateFromThreadArena(FrameRegion& frameRegion, size_t regionStartAddress, size_t size, size_t alignment);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        void ReportFrameRegionUsage(FrameRegion& frameRegion);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        FrameRegion m_FrameRegions[ms_MaxNumFramesInFlight];
+
+        size_t m_FrameRegionSize;
+        size_t m_ThreadArenaSize;
+        shipUint32 m_NumFramesInFlight;
+        shipUint32 m_CurrentFrameRegionIndex;
+
+        // Unique among all FrameAllocators, changes on every BeginFrame so that threads can tell their sub-arena is stale.
+        shipUint64 m_CurrentFrameStamp;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo
+        {
+            size_t heapSize = 0;
+            size_t frameRegionSize = 0;
+            shipUint32 numFramesCompleted = 0;
+            shipUint32 numFramesOverflowed = 0;
+            size_t lastFrameBytesUsed = 0;
+            size_t lastFrameUserBytesAllocated = 0;
+            size_t peakFrameBytesUsed = 0;
+            size_t peakFrameUserBytesAllocated = 0;
+            shipUint64 numFailedAllocations = 0;
+        };
+
+        MemoryInfo m_MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    };
+}
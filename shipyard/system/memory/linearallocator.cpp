@@ -6,11 +6,14 @@
 
 #include <system/atomicoperations.h>
 
+#include <system/memory/virtualmemoryheap.h>
+
 namespace Shipyard
 {;
 
 LinearAllocator::LinearAllocator()
     : m_AllocationOffset(0)
+    , m_pVirtualMemoryHeap(nullptr)
 {
 
 }
@@ -25,6 +28,27 @@ shipBool LinearAllocator::Create(void* pHeap, size_t heapSize)
     m_pHeap = pHeap;
     m_HeapSize = heapSize;
 
+    m_pVirtualMemoryHeap = nullptr;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo = MemoryInfo();
+    m_MemoryInfo.heapSize = heapSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+shipBool LinearAllocator::Create(VirtualMemoryHeap* pVirtualMemoryHeap)
+{
+    SHIP_ASSERT_MSG(pVirtualMemoryHeap != nullptr && pVirtualMemoryHeap->GetBaseAddress() != nullptr, "LinearAllocator::Create --> Trying to initialize a linear allocator with an invalid virtual memory heap");
+
+    if (!Create(pVirtualMemoryHeap->GetBaseAddress(), pVirtualMemoryHeap->GetReservedSize()))
+    {
+        return false;
+    }
+
+    m_pVirtualMemoryHeap = pVirtualMemoryHeap;
+
     return true;
 }
 
@@ -32,6 +56,8 @@ void LinearAllocator::Destroy()
 {
     m_pHeap = nullptr;
     m_HeapSize = 0;
+
+    m_pVirtualMemoryHeap = nullptr;
 }
 
 void* LinearAllocator::Allocate(size_t size, size_t alignment 
@@ -71,6 +97,11 @@ void* LinearAllocator::Allocate(size_t size, size_t alignment
 
     } while (AtomicOperations::CompareExchange(m_AllocationOffset, newAllocationOffset, allocationOffset) != allocationOffset);
 
+    if (!CommitUpTo(newAllocationOffset))
+    {
+        return nullptr;
+    }
+
     void* allocatedPtr = reinterpret_cast<void*>(allocatedAddress);
 
     return allocatedPtr;
@@ -81,9 +112,71 @@ void LinearAllocator::Deallocate(const void* memory)
     SHIP_ASSERT_MSG(false, "LinearAllocator doesn't support individual deallocation, you must go through LinearAllocator::FreeEverything instead.");
 }
 
+shipBool LinearAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+    size_t allocationOffset = size_t(memory) - size_t(m_pHeap);
+    size_t endOfAllocationOffset = allocationOffset + currentSize;
+    size_t newAllocationOffset = allocationOffset + newSize;
+
+    if (newAllocationOffset > m_HeapSize)
+    {
+        return false;
+    }
+
+    // Only succeeds if nothing was allocated after this allocation. The pages are committed before moving the offset, so that a
+    // failed expansion leaves the allocation, and the heap, untouched.
+    shipBool isLastAllocation = (m_AllocationOffset == endOfAllocationOffset);
+    if (isLastAllocation && CommitUpTo(newAllocationOffset))
+    {
+        if (AtomicOperations::CompareExchange(m_AllocationOffset, newAllocationOffset, endOfAllocationOffset) == endOfAllocationOffset)
+        {
+            return true;
+        }
+    }
+
+    return (newSize <= currentSize);
+}
+
 void LinearAllocator::FreeEverything()
 {
     m_AllocationOffset = 0;
+
+    if (m_pVirtualMemoryHeap != nullptr)
+    {
+        m_pVirtualMemoryHeap->Shrink(0);
+    }
+}
+
+shipBool LinearAllocator::CommitUpTo(size_t endOfAllocationOffset)
+{
+    if (m_pVirtualMemoryHeap == nullptr || endOfAllocationOffset <= m_pVirtualMemoryHeap->GetCommittedSize())
+    {
+        return true;
+    }
+
+    // The offset was already moved past the allocation, so that memory is lost if we're out of memory. It's no different
+    // from a failed allocation in a full heap though.
+    return m_pVirtualMemoryHeap->Grow(endOfAllocationOffset);
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+const LinearAllocator::MemoryInfo& LinearAllocator::GetMemoryInfo() const
+{
+    m_MemoryInfo.numBytesUsed = m_AllocationOffset;
+
+    if (m_pVirtualMemoryHeap != nullptr)
+    {
+        m_MemoryInfo.numBytesCommitted = m_pVirtualMemoryHeap->GetCommittedSize();
+        m_MemoryInfo.numBytesResident = m_pVirtualMemoryHeap->GetResidentSize();
+    }
+    else
+    {
+        m_MemoryInfo.numBytesCommitted = m_HeapSize;
+        m_MemoryInfo.numBytesResident = m_HeapSize;
+    }
+
+    return m_MemoryInfo;
 }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
 }
\ No newline at end of file
@@ -4,15 +4,25 @@
 
 namespace Shipyard
 {
+    class VirtualMemoryHeap;
+
     // Allocator that allocates by always increasing linearly a pointer in its heap. Single deallocation is not possible,
     // only full allocator's deallocation is possible.
+    //
+    // When created on a VirtualMemoryHeap, pages are committed as the allocations reach them, and given back to the OS
+    // when freeing everything.
     class SHIPYARD_SYSTEM_API LinearAllocator : public BaseAllocator
     {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
     public:
         LinearAllocator();
         ~LinearAllocator();
 
         shipBool Create(void* pHeap, size_t heapSize);
+        shipBool Create(VirtualMemoryHeap* pVirtualMemoryHeap);
         void Destroy();
 
         // Alignment must be a power of 2 and non-zero.
@@ -28,10 +38,37 @@ namespace Shipyard
         // Single deallocation is not permitted with the LinearAllocator.
         virtual void Deallocate(const void* memory) override;
 
+        // Only the last allocation made can be resized in place.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
         // Not thread-safe.
         void FreeEverything();
 
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        const MemoryInfo& GetMemoryInfo() const;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        // Makes sure the heap is committed up to endOfAllocationOffset.
+        shipBool CommitUpTo(size_t endOfAllocationOffset);
+
     private:
         SHIP_ALIGN(8) size_t m_AllocationOffset;
+
+        VirtualMemoryHeap* m_pVirtualMemoryHeap;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo
+        {
+            size_t heapSize = 0;
+
+            // Sampled every time the memory info is retrieved, since pages become resident when they're first touched.
+            mutable size_t numBytesUsed = 0;
+            mutable size_t numBytesCommitted = 0;
+            mutable size_t numBytesResident = 0;
+        };
+
+        MemoryInfo m_MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
     };
 }
\ No newline at end of file
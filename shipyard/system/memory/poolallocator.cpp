@@ -2,10 +2,12 @@
 
 #include <system/memory/poolallocator.h>
 
+#include <system/atomicoperations.h>
 #include <system/logger.h>
 #include <system/systemdebug.h>
 
 #include <system/memory/memoryutils.h>
+#include <system/memory/virtualmemoryheap.h>
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 #include <system/memory/debugallocator.h>
@@ -18,6 +20,11 @@ PoolAllocator::PoolAllocator()
     : m_pFirstFreeChunk(nullptr)
     , m_ChunkSize(0)
     , m_NumChunks(0)
+    , m_NumCommittedChunks(0)
+    , m_ChunkAlignment(0)
+    , m_SynchronizationMode(SynchronizationMode::Mutex)
+    , m_pVirtualMemoryHeap(nullptr)
+    , m_LockFreeFreeListHead(0)
 {
 }
 
@@ -37,7 +44,7 @@ namespace
 }
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
 
-shipBool PoolAllocator::Create(void* pHeap, size_t numChunks, size_t chunkSize)
+shipBool PoolAllocator::Create(void* pHeap, size_t numChunks, size_t chunkSize, SynchronizationMode synchronizationMode)
 {
     if (pHeap == nullptr)
     {
@@ -58,33 +65,69 @@ shipBool PoolAllocator::Create(void* pHeap, size_t numChunks, size_t chunkSize)
     memset(pHeap, FixedHeapAllocatorDebugConstants_NeverAllocatedMemory, m_HeapSize);
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
 
+    SHIP_ASSERT_MSG(
+            synchronizationMode != SynchronizationMode::LockFree || numChunks < size_t(0xFFFFFFFF),
+            "PoolAllocator::Create --> Pool allocator %p in lock-free mode can have at most %u chunks",
+            this, 0xFFFFFFFE);
+
     m_pHeap = pHeap;
 
     m_ChunkSize = chunkSize;
     m_NumChunks = numChunks;
+    m_ChunkAlignment = (chunkSize & (~chunkSize + 1));
+    m_SynchronizationMode = synchronizationMode;
 
     m_HeapSize = chunkSize * numChunks;
 
     m_pFirstFreeChunk = reinterpret_cast<FreeChunkHeader*>(m_pHeap);
-    FreeChunkHeader* pCurrentFreeChunk = m_pFirstFreeChunk;
-    FreeChunkHeader* pLastFreeChunk = nullptr;
 
-    for (size_t i = 0; i < m_NumChunks; i++)
-    {
-        pLastFreeChunk = pCurrentFreeChunk;
+    FreeChunkHeader* pLastFreeChunk = LinkChunks(m_pFirstFreeChunk, m_NumChunks);
+    pLastFreeChunk->pNextFreeChunk = nullptr;
 
-        size_t nextFreeChunkAddress = size_t(pCurrentFreeChunk) + chunkSize;
+    m_LockFreeFreeListHead = GetLockFreeIndexFromChunk(m_pFirstFreeChunk);
 
-        FreeChunkHeader* pNextFreeChunk = reinterpret_cast<FreeChunkHeader*>(nextFreeChunkAddress);
-        pCurrentFreeChunk->pNextFreeChunk = pNextFreeChunk;
+    m_NumCommittedChunks = numChunks;
+    m_pVirtualMemoryHeap = nullptr;
 
-        pCurrentFreeChunk = pNextFreeChunk;
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.heapSize = chunkSize * numChunks;
+    m_MemoryInfo.numBytesCommitted = m_MemoryInfo.heapSize;
+    m_MemoryInfo.numBytesResident = m_MemoryInfo.heapSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+shipBool PoolAllocator::Create(VirtualMemoryHeap* pVirtualMemoryHeap, size_t chunkSize, SynchronizationMode synchronizationMode)
+{
+    SHIP_ASSERT_MSG(pVirtualMemoryHeap != nullptr && pVirtualMemoryHeap->GetBaseAddress() != nullptr, "PoolAllocator::Create --> Trying to initialize a pool allocator with an invalid virtual memory heap");
+
+    size_t numChunks = pVirtualMemoryHeap->GetReservedSize() / chunkSize;
+
+    SHIP_ASSERT_MSG(
+            synchronizationMode != SynchronizationMode::LockFree || numChunks < size_t(0xFFFFFFFF),
+            "PoolAllocator::Create --> Pool allocator %p in lock-free mode can have at most %u chunks",
+            this, 0xFFFFFFFE);
+
+    if (!pVirtualMemoryHeap->Grow(chunkSize))
+    {
+        return false;
     }
 
-    pLastFreeChunk->pNextFreeChunk = nullptr;
+    size_t numCommittedChunks = MIN(pVirtualMemoryHeap->GetCommittedSize() / chunkSize, numChunks);
+
+    if (!Create(pVirtualMemoryHeap->GetBaseAddress(), numCommittedChunks, chunkSize, synchronizationMode))
+    {
+        return false;
+    }
+
+    // Chunks can be anywhere in the reserved range.
+    m_NumChunks = numChunks;
+    m_HeapSize = chunkSize * numChunks;
+    m_pVirtualMemoryHeap = pVirtualMemoryHeap;
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
-    m_MemoryInfo.heapSize = chunkSize * numChunks;
+    m_MemoryInfo.heapSize = m_HeapSize;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
     return true;
@@ -95,7 +138,10 @@ void PoolAllocator::Destroy()
     m_pHeap = nullptr;
     m_pFirstFreeChunk = nullptr;
     m_NumChunks = 0;
+    m_NumCommittedChunks = 0;
     m_ChunkSize = 0;
+    m_LockFreeFreeListHead = 0;
+    m_pVirtualMemoryHeap = nullptr;
 }
 
 void* PoolAllocator::Allocate(size_t size, size_t alignment
@@ -111,9 +157,40 @@ void* PoolAllocator::Allocate(size_t size, size_t alignment
     SHIP_ASSERT_MSG(alignment > 0, "PoolAllocator::Allocate --> alignment cannot be 0");
     SHIP_ASSERT_MSG((((alignment - 1) & alignment) == 0), "PoolAllocator::Allocate --> alignment %zu is not a power-of-2", alignment);
 
+    if (m_SynchronizationMode == SynchronizationMode::LockFree)
+    {
+        void* pChunk = AllocateLockFree(alignment);
+
+        if (pChunk == nullptr && m_pVirtualMemoryHeap != nullptr && alignment <= m_ChunkAlignment)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+
+                // Another thread may have committed new chunks while we were waiting for the lock.
+                if ((AtomicOperations::Load(m_LockFreeFreeListHead, MemoryOrder::Acquire) & 0xFFFFFFFF) == 0)
+                {
+                    CommitMoreChunks();
+                }
+            }
+
+            pChunk = AllocateLockFree(alignment);
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        if (pChunk != nullptr)
+        {
+            UpdateMemoryInfoOnAllocation();
+
+            DebugAllocator::GetInstance().Allocate(this, pChunk, m_ChunkSize, pAllocationFilename, allocationLineNumber);
+        }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        return pChunk;
+    }
+
     std::lock_guard<std::mutex> lock(m_Lock);
 
-    if (m_pFirstFreeChunk == nullptr)
+    if (m_pFirstFreeChunk == nullptr && !CommitMoreChunks())
     {
         return nullptr;
     }
@@ -154,10 +231,7 @@ void* PoolAllocator::Allocate(size_t size, size_t alignment
     }
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
-    m_MemoryInfo.numBlocksAllocated += 1;
-    m_MemoryInfo.numBytesUsed += m_ChunkSize;
-    m_MemoryInfo.numUserBytesAllocated += m_ChunkSize;
-    m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.peakUserBytesAllocated, m_MemoryInfo.numUserBytesAllocated);
+    UpdateMemoryInfoOnAllocation();
 
     DebugAllocator::GetInstance().Allocate(this, pChunkCandidate, m_ChunkSize, pAllocationFilename, allocationLineNumber);
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
@@ -167,6 +241,18 @@ void* PoolAllocator::Allocate(size_t size, size_t alignment
 
 void PoolAllocator::Deallocate(const void* memory)
 {
+    if (m_SynchronizationMode == SynchronizationMode::LockFree)
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        UpdateMemoryInfoOnDeallocation();
+
+        DebugAllocator::GetInstance().Deallocate(memory);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        DeallocateLockFree(memory);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(m_Lock);
 
     FreeChunkHeader* pNewFreeChunk = reinterpret_cast<FreeChunkHeader*>(const_cast<void*>(memory));
@@ -180,15 +266,209 @@ void PoolAllocator::Deallocate(const void* memory)
     m_pFirstFreeChunk = pNewFreeChunk;
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
-    SHIP_ASSERT(m_MemoryInfo.numBlocksAllocated > 0);
-
-    m_MemoryInfo.numBlocksAllocated -= 1;
-    m_MemoryInfo.numBytesUsed -= m_ChunkSize;
-    m_MemoryInfo.numUserBytesAllocated -= m_ChunkSize;
+    UpdateMemoryInfoOnDeallocation();
 
     DebugAllocator::GetInstance().Deallocate(memory);
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
 }
 
+PoolAllocator::FreeChunkHeader* PoolAllocator::LinkChunks(FreeChunkHeader* pFirstChunk, size_t numChunks) const
+{
+    FreeChunkHeader* pCurrentFreeChunk = pFirstChunk;
+    FreeChunkHeader* pLastFreeChunk = nullptr;
+
+    for (size_t i = 0; i < numChunks; i++)
+    {
+        pLastFreeChunk = pCurrentFreeChunk;
+
+        size_t nextFreeChunkAddress = size_t(pCurrentFreeChunk) + m_ChunkSize;
+
+        FreeChunkHeader* pNextFreeChunk = reinterpret_cast<FreeChunkHeader*>(nextFreeChunkAddress);
+        pCurrentFreeChunk->pNextFreeChunk = pNextFreeChunk;
+
+        pCurrentFreeChunk = pNextFreeChunk;
+    }
+
+    return pLastFreeChunk;
+}
+
+shipBool PoolAllocator::CommitMoreChunks()
+{
+    if (m_pVirtualMemoryHeap == nullptr || m_NumCommittedChunks == m_NumChunks)
+    {
+        return false;
+    }
+
+    size_t committedChunksSize = m_NumCommittedChunks * m_ChunkSize;
+
+    if (!m_pVirtualMemoryHeap->Grow(committedChunksSize + m_ChunkSize))
+    {
+        return false;
+    }
+
+    size_t newNumCommittedChunks = MIN(m_pVirtualMemoryHeap->GetCommittedSize() / m_ChunkSize, m_NumChunks);
+
+    FreeChunkHeader* pFirstNewChunk = reinterpret_cast<FreeChunkHeader*>(size_t(m_pHeap) + committedChunksSize);
+    FreeChunkHeader* pLastNewChunk = LinkChunks(pFirstNewChunk, newNumCommittedChunks - m_NumCommittedChunks);
+
+    m_NumCommittedChunks = newNumCommittedChunks;
+
+    if (m_SynchronizationMode == SynchronizationMode::Mutex)
+    {
+        pLastNewChunk->pNextFreeChunk = m_pFirstFreeChunk;
+        m_pFirstFreeChunk = pFirstNewChunk;
+
+        return true;
+    }
+
+    // Other threads can still push and pop chunks, the new chunks are pushed all at once.
+    shipUint64 newHeadIndex = GetLockFreeIndexFromChunk(pFirstNewChunk);
+    shipUint64 head = AtomicOperations::Load(m_LockFreeFreeListHead, MemoryOrder::Acquire);
+
+    while (true)
+    {
+        pLastNewChunk->pNextFreeChunk = GetChunkFromLockFreeIndex(shipUint32(head & 0xFFFFFFFF));
+
+        shipUint64 tag = (head >> 32) + 1;
+        shipUint64 newHead = (tag << 32) | newHeadIndex;
+
+        shipUint64 previousHead = AtomicOperations::CompareExchange(m_LockFreeFreeListHead, newHead, head);
+        if (previousHead == head)
+        {
+            return true;
+        }
+
+        head = previousHead;
+    }
+}
+
+void* PoolAllocator::AllocateLockFree(size_t alignment)
+{
+    // Chunks are all guaranteed to be aligned to m_ChunkAlignment only, so there's no point in looking for another one.
+    if (alignment > m_ChunkAlignment)
+    {
+        return nullptr;
+    }
+
+    shipUint64 head = AtomicOperations::Load(m_LockFreeFreeListHead, MemoryOrder::Acquire);
+
+    while (true)
+    {
+        shipUint32 lockFreeIndex = shipUint32(head & 0xFFFFFFFF);
+        if (lockFreeIndex == 0)
+        {
+            return nullptr;
+        }
+
+        FreeChunkHeader* pChunk = GetChunkFromLockFreeIndex(lockFreeIndex);
+
+        // The chunk may have been allocated and overwritten by another thread in the meantime, in which case the
+        // next chunk read here is garbage. The tag will have changed though, so the compare exchange will fail.
+        FreeChunkHeader* pNextFreeChunk = static_cast<FreeChunkHeader* volatile&>(pChunk->pNextFreeChunk);
+
+        shipUint64 tag = (head >> 32) + 1;
+        shipUint64 newHead = (tag << 32) | GetLockFreeIndexFromChunk(pNextFreeChunk);
+
+        shipUint64 previousHead = AtomicOperations::CompareExchange(m_LockFreeFreeListHead, newHead, head);
+        if (previousHead == head)
+        {
+            return pChunk;
+        }
+
+        head = previousHead;
+    }
+}
+
+void PoolAllocator::DeallocateLockFree(const void* memory)
+{
+    FreeChunkHeader* pNewFreeChunk = reinterpret_cast<FreeChunkHeader*>(const_cast<void*>(memory));
+
+#ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
+    memset(pNewFreeChunk, FixedHeapAllocatorDebugConstants_FreedMemory, m_ChunkSize);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_MEMORY_FILL
+
+    shipUint64 newHeadIndex = GetLockFreeIndexFromChunk(pNewFreeChunk);
+    shipUint64 head = AtomicOperations::Load(m_LockFreeFreeListHead, MemoryOrder::Acquire);
+
+    while (true)
+    {
+        pNewFreeChunk->pNextFreeChunk = GetChunkFromLockFreeIndex(shipUint32(head & 0xFFFFFFFF));
+
+        shipUint64 tag = (head >> 32) + 1;
+        shipUint64 newHead = (tag << 32) | newHeadIndex;
+
+        shipUint64 previousHead = AtomicOperations::CompareExchange(m_LockFreeFreeListHead, newHead, head);
+        if (previousHead == head)
+        {
+            return;
+        }
+
+        head = previousHead;
+    }
+}
+
+PoolAllocator::FreeChunkHeader* PoolAllocator::GetChunkFromLockFreeIndex(shipUint32 lockFreeIndex) const
+{
+    if (lockFreeIndex == 0)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<FreeChunkHeader*>(size_t(m_pHeap) + (lockFreeIndex - 1) * m_ChunkSize);
+}
+
+shipUint32 PoolAllocator::GetLockFreeIndexFromChunk(const FreeChunkHeader* pChunk) const
+{
+    if (pChunk == nullptr)
+    {
+        return 0;
+    }
+
+    return shipUint32((size_t(pChunk) - size_t(m_pHeap)) / m_ChunkSize + 1);
+}
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+const PoolAllocator::MemoryInfo& PoolAllocator::GetMemoryInfo() const
+{
+    if (m_pVirtualMemoryHeap != nullptr)
+    {
+        m_MemoryInfo.numBytesCommitted = m_pVirtualMemoryHeap->GetCommittedSize();
+        m_MemoryInfo.numBytesResident = m_pVirtualMemoryHeap->GetResidentSize();
+    }
+
+    return m_MemoryInfo;
+}
+
+void PoolAllocator::UpdateMemoryInfoOnAllocation()
+{
+    // Counters are updated atomically since they aren't protected by the lock in lock-free mode.
+    AtomicOperations::Increment(m_MemoryInfo.numBlocksAllocated);
+    AtomicOperations::Add(m_MemoryInfo.numBytesUsed, m_ChunkSize);
+
+    size_t numUserBytesAllocated = AtomicOperations::Add(m_MemoryInfo.numUserBytesAllocated, m_ChunkSize) + m_ChunkSize;
+    size_t peakUserBytesAllocated = m_MemoryInfo.peakUserBytesAllocated;
+
+    while (numUserBytesAllocated > peakUserBytesAllocated)
+    {
+        size_t previousPeakUserBytesAllocated = AtomicOperations::CompareExchange(m_MemoryInfo.peakUserBytesAllocated, numUserBytesAllocated, peakUserBytesAllocated);
+        if (previousPeakUserBytesAllocated == peakUserBytesAllocated)
+        {
+            break;
+        }
+
+        peakUserBytesAllocated = previousPeakUserBytesAllocated;
+    }
+}
+
+void PoolAllocator::UpdateMemoryInfoOnDeallocation()
+{
+    SHIP_ASSERT(m_MemoryInfo.numBlocksAllocated > 0);
+
+    AtomicOperations::Decrement(m_MemoryInfo.numBlocksAllocated);
+    AtomicOperations::Subtract(m_MemoryInfo.numBytesUsed, m_ChunkSize);
+    AtomicOperations::Subtract(m_MemoryInfo.numUserBytesAllocated, m_ChunkSize);
+}
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
 }
\ No newline at end of file
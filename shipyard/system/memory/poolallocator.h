@@ -6,15 +6,31 @@
 
 namespace Shipyard
 {
+    class VirtualMemoryHeap;
+
     // Use this class to allocate fixed sized chunk of memory.
     // The PoolAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
     // calling PoolAllocator::Destroy()
+    //
+    // When created on a VirtualMemoryHeap, new chunks are committed when the free list runs out. Since free chunks end up scattered
+    // in the heap, the pool never gives memory back to the OS before being destroyed.
     class SHIPYARD_SYSTEM_API PoolAllocator : public BaseAllocator
     {
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
         struct MemoryInfo;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
+    public:
+        enum class SynchronizationMode : shipUint8
+        {
+            // The free list is protected by a mutex.
+            Mutex,
+
+            // The free list is a lock-free stack. Allocations requiring a larger alignment than the chunks' natural alignment
+            // (the largest power of 2 dividing chunkSize) will fail instead of searching the free list for an aligned chunk.
+            LockFree
+        };
+
     public:
         PoolAllocator();
         ~PoolAllocator();
@@ -22,7 +38,10 @@ namespace Shipyard
         // pHeap is assumed to be aligned to chunkSize bytes.
         // chunkSize is assumed to be at least sizeof(void*) bytes, because free chunks are used
         // as pointers to next free chunks.
-        shipBool Create(void* pHeap, size_t numChunks, size_t chunkSize);
+        shipBool Create(void* pHeap, size_t numChunks, size_t chunkSize, SynchronizationMode synchronizationMode = SynchronizationMode::Mutex);
+
+        // The pool can hold as many chunks as fit in the reserved size.
+        shipBool Create(VirtualMemoryHeap* pVirtualMemoryHeap, size_t chunkSize, SynchronizationMode synchronizationMode = SynchronizationMode::Mutex);
         void Destroy();
 
         // Alignment must be a power of 2 and non-zero.
@@ -39,7 +58,7 @@ namespace Shipyard
         virtual void Deallocate(const void* memory) override;
 
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
-        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+        const MemoryInfo& GetMemoryInfo() const;
 #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
 
     private:
@@ -48,13 +67,42 @@ namespace Shipyard
             FreeChunkHeader* pNextFreeChunk;
         };
 
+    private:
+        // Links numChunks chunks starting at pFirstChunk, and returns the last one.
+        FreeChunkHeader* LinkChunks(FreeChunkHeader* pFirstChunk, size_t numChunks) const;
+
+        // Commits more chunks from the virtual memory heap and adds them to the free list. Must be called with m_Lock held.
+        shipBool CommitMoreChunks();
+
+        void* AllocateLockFree(size_t alignment);
+        void DeallocateLockFree(const void* memory);
+
+        // In lock-free mode, chunks are referred to by their index + 1, so that 0 means no chunk.
+        FreeChunkHeader* GetChunkFromLockFreeIndex(shipUint32 lockFreeIndex) const;
+        shipUint32 GetLockFreeIndexFromChunk(const FreeChunkHeader* pChunk) const;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        void UpdateMemoryInfoOnAllocation();
+        void UpdateMemoryInfoOnDeallocation();
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
     private:
         FreeChunkHeader* m_pFirstFreeChunk;
         size_t m_ChunkSize;
         size_t m_NumChunks;
+        size_t m_NumCommittedChunks;
+        size_t m_ChunkAlignment;
+
+        SynchronizationMode m_SynchronizationMode;
+
+        VirtualMemoryHeap* m_pVirtualMemoryHeap;
 
         std::mutex m_Lock;
 
+        // Head of the lock-free free list. The low 32 bits are the lock-free index of the first free chunk, and the high 32 bits are
+        // a tag incremented on every change, so that a compare exchange fails if the head was popped and pushed back in between (ABA problem).
+        SHIP_ALIGN(8) volatile shipUint64 m_LockFreeFreeListHead;
+
 #ifdef SHIP_ALLOCATOR_DEBUG_INFO
         struct MemoryInfo
         {
@@ -63,6 +111,10 @@ namespace Shipyard
             size_t numBytesUsed = 0;
             size_t numUserBytesAllocated = 0;
             size_t peakUserBytesAllocated = 0;
+
+            // Sampled every time the memory info is retrieved, since pages become resident when they're first touched.
+            mutable size_t numBytesCommitted = 0;
+            mutable size_t numBytesResident = 0;
         };
 
         MemoryInfo m_MemoryInfo;
@@ -0,0 +1,200 @@
+#include <system/systemprecomp.h>
+
+#include <system/memory/scratchallocator.h>
+
+#include <system/memory.h>
+#include <system/systemdebug.h>
+
+#include <system/memory/memoryutils.h>
+
+namespace Shipyard
+{;
+
+namespace
+{
+    struct ThreadScratchAllocator
+    {
+        ~ThreadScratchAllocator()
+        {
+            if (pHeap != nullptr)
+            {
+                scratchAllocator.Destroy();
+
+                free(pHeap);
+            }
+        }
+
+        ScratchAllocator scratchAllocator;
+
+        // The heap doesn't come from the GlobalAllocator, since threads may exit after it was destroyed.
+        void* pHeap = nullptr;
+    };
+
+    thread_local ThreadScratchAllocator g_ThreadScratchAllocator;
+}
+
+ScratchAllocator::ScratchAllocator()
+    : m_AllocationOffset(0)
+    , m_LastAllocationOffset(size_t(-1))
+{
+
+}
+
+ScratchAllocator::~ScratchAllocator()
+{
+    SHIP_ASSERT_MSG(m_pHeap == nullptr, "It is required to manually call Destroy on the ScratchAllocator %p to control when to free the memory.", this);
+}
+
+shipBool ScratchAllocator::Create(void* pHeap, size_t heapSize)
+{
+    m_pHeap = pHeap;
+    m_HeapSize = heapSize;
+
+    m_AllocationOffset = 0;
+    m_LastAllocationOffset = size_t(-1);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo = MemoryInfo();
+    m_MemoryInfo.heapSize = heapSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+void ScratchAllocator::Destroy()
+{
+    m_pHeap = nullptr;
+    m_HeapSize = 0;
+}
+
+void* ScratchAllocator::Allocate(size_t size, size_t alignment
+
+        #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            , const shipChar* pAllocationFilename
+            , int allocationLineNumber
+        #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        )
+{
+    size_t allocatedAddress = MemoryUtils::AlignAddress(size_t(m_pHeap) + m_AllocationOffset, alignment);
+    size_t allocationOffset = allocatedAddress - size_t(m_pHeap);
+    size_t newAllocationOffset = allocationOffset + size;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.numAllocations += 1;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    shipBool validAllocation = (newAllocationOffset <= m_HeapSize);
+    if (!validAllocation)
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        m_MemoryInfo.numForwardedAllocations += 1;
+
+        return GetGlobalAllocator().Allocate(size, alignment, pAllocationFilename, allocationLineNumber);
+#else
+        return GetGlobalAllocator().Allocate(size, alignment);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    m_LastAllocationOffset = allocationOffset;
+    m_AllocationOffset = newAllocationOffset;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.peakBytesUsed = MAX(m_MemoryInfo.peakBytesUsed, m_AllocationOffset);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return reinterpret_cast<void*>(allocatedAddress);
+}
+
+void ScratchAllocator::Deallocate(const void* memory)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    size_t address = size_t(memory);
+    size_t heapStartAddress = size_t(m_pHeap);
+
+    shipBool isInHeap = (address >= heapStartAddress && address < heapStartAddress + m_HeapSize);
+    if (!isInHeap)
+    {
+        GetGlobalAllocator().Deallocate(memory);
+        return;
+    }
+
+    // Only the last allocation can be given back, everything else waits for the allocator to be rewinded.
+    if (address - heapStartAddress == m_LastAllocationOffset)
+    {
+        m_AllocationOffset = m_LastAllocationOffset;
+        m_LastAllocationOffset = size_t(-1);
+    }
+}
+
+shipBool ScratchAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+    size_t allocationOffset = size_t(memory) - size_t(m_pHeap);
+    if (allocationOffset != m_LastAllocationOffset)
+    {
+        return (newSize <= currentSize);
+    }
+
+    size_t newAllocationOffset = allocationOffset + newSize;
+    if (newAllocationOffset > m_HeapSize)
+    {
+        return false;
+    }
+
+    m_AllocationOffset = newAllocationOffset;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.peakBytesUsed = MAX(m_MemoryInfo.peakBytesUsed, m_AllocationOffset);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+ScratchAllocator::Marker ScratchAllocator::GetMarker()
+{
+    m_LastAllocationOffset = size_t(-1);
+
+    return m_AllocationOffset;
+}
+
+void ScratchAllocator::RewindToMarker(Marker marker)
+{
+    SHIP_ASSERT_MSG(marker <= m_AllocationOffset, "ScratchAllocator::RewindToMarker --> Scratch scopes must be destroyed in the reverse order of their creation.");
+
+    m_AllocationOffset = marker;
+    m_LastAllocationOffset = size_t(-1);
+}
+
+ScratchAllocator& ScratchAllocator::GetThreadScratchAllocator()
+{
+    ThreadScratchAllocator& threadScratchAllocator = g_ThreadScratchAllocator;
+
+    if (threadScratchAllocator.pHeap == nullptr)
+    {
+        threadScratchAllocator.pHeap = malloc(ms_ThreadScratchHeapSize);
+        threadScratchAllocator.scratchAllocator.Create(threadScratchAllocator.pHeap, ms_ThreadScratchHeapSize);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        threadScratchAllocator.scratchAllocator.SetAllocatorDebugName("Thread ScratchAllocator");
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    return threadScratchAllocator.scratchAllocator;
+}
+
+ScratchScope::ScratchScope()
+    : m_pScratchAllocator(&ScratchAllocator::GetThreadScratchAllocator())
+{
+    m_Marker = m_pScratchAllocator->GetMarker();
+}
+
+ScratchScope::~ScratchScope()
+{
+    m_pScratchAllocator->RewindToMarker(m_Marker);
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <system/memory/baseallocator.h>
+
+namespace Shipyard
+{
+    // Stack-style allocator for short-lived temporaries. Allocations are made by increasing an offset in the heap, and rewinding
+    // to a marker frees everything allocated after it in one go. A single deallocation only gives memory back if it is the last
+    // allocation made. When the heap is full, allocations are forwarded to the GlobalAllocator, and deallocated through it.
+    //
+    // Every thread has its own ScratchAllocator, which is usually accessed through a ScratchScope. Not thread-safe.
+    //
+    // The ScratchAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
+    // calling ScratchAllocator::Destroy()
+    class SHIPYARD_SYSTEM_API ScratchAllocator : public BaseAllocator
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    public:
+        static const size_t ms_ThreadScratchHeapSize = 1024 * 1024;
+
+        using Marker = size_t;
+
+    public:
+        ScratchAllocator();
+        ~ScratchAllocator();
+
+        shipBool Create(void* pHeap, size_t heapSize);
+        void Destroy();
+
+        // Alignment must be a power of 2 and non-zero.
+        virtual void* Allocate(size_t size, size_t alignment
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                ) override;
+
+        // Memory must come from the allocator that allocated it.
+        virtual void Deallocate(const void* memory) override;
+
+        // Only the last allocation made can be resized in place.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
+        // Memory allocated before the marker is never given back by single deallocations until it's rewinded to.
+        Marker GetMarker();
+
+        // Frees everything allocated since the marker was taken, except the allocations forwarded to the GlobalAllocator,
+        // which still need to be deallocated.
+        void RewindToMarker(Marker marker);
+
+        // Returns the calling thread's ScratchAllocator, its heap is allocated the first time it's used by the thread.
+        static ScratchAllocator& GetThreadScratchAllocator();
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        size_t m_AllocationOffset;
+
+        // Offset of the last allocation made, which can be given back on deallocation. size_t(-1) if there is none.
+        size_t m_LastAllocationOffset;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo
+        {
+            shipUint64 numAllocations = 0;
+            shipUint64 numForwardedAllocations = 0;
+            size_t heapSize = 0;
+            size_t peakBytesUsed = 0;
+        };
+
+        MemoryInfo m_MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    };
+
+    // Takes a marker on the calling thread's ScratchAllocator when created, and rewinds to it when destroyed, which frees every
+    // temporary allocated through GetAllocator() in the scope at once. Containers using it must therefore be destroyed before
+    // the scope, and containers from an outer scope must not grow while an inner scope is alive.
+    class SHIPYARD_SYSTEM_API ScratchScope
+    {
+    public:
+        ScratchScope();
+        ~ScratchScope();
+
+        ScratchAllocator* GetAllocator() const { return m_pScratchAllocator; }
+
+    private:
+        ScratchScope(const ScratchScope& src) = delete;
+        ScratchScope& operator= (const ScratchScope& rhs) = delete;
+
+        ScratchAllocator* m_pScratchAllocator;
+        ScratchAllocator::Marker m_Marker;
+    };
+}
@@ -0,0 +1,388 @@
+#include <system/systemprecomp.h>
+
+#include <system/memory/smallobjectallocator.h>
+
+#include <system/atomicoperations.h>
+#include <system/systemdebug.h>
+
+#include <system/memory/memoryutils.h>
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+#include <system/memory/debugallocator.h>
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+namespace Shipyard
+{;
+
+namespace
+{
+    // Classes are 8 bytes apart up to 48 bytes, then 16 and 32 bytes apart, so that no allocation wastes more than 25% of its block.
+    const shipUint32 g_SizeClassBlockSizes[SmallObjectAllocator::ms_NumSizeClasses] =
+    {
+        8, 16, 24, 32, 40, 48, 64, 80, 96, 112, 128, 144, 160, 192, 224, 256
+    };
+
+    // Size class index to use for every size, by increments of 8 bytes.
+    const shipUint8 g_SizeClassIndexFromSize[SmallObjectAllocator::ms_MaxAllocationSize / 8 + 1] =
+    {
+        0, 0, 1, 2, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15
+    };
+
+    const shipUint32 g_InvalidSizeClassIndex = SmallObjectAllocator::ms_NumSizeClasses;
+}
+
+SmallObjectAllocator::SmallObjectAllocator()
+    : m_pPageDescriptors(nullptr)
+    , m_FirstPageAddress(0)
+    , m_NumPages(0)
+    , m_NumPagesEverUsed(0)
+    , m_pFirstEmptyPage(nullptr)
+{
+    for (shipUint32 i = 0; i < ms_NumSizeClasses; i++)
+    {
+        SizeClass& sizeClass = m_SizeClasses[i];
+        sizeClass.blockSize = g_SizeClassBlockSizes[i];
+        sizeClass.numBlocksPerPage = shipUint32(ms_PageSize / sizeClass.blockSize);
+    }
+}
+
+SmallObjectAllocator::~SmallObjectAllocator()
+{
+    SHIP_ASSERT_MSG(m_pHeap == nullptr, "It is required to manually call Destroy on the SmallObjectAllocator %p to control when to free the memory.", this);
+}
+
+shipBool SmallObjectAllocator::Create(void* pHeap, size_t heapSize)
+{
+    SHIP_ASSERT(pHeap != nullptr);
+
+    size_t heapStartAddress = size_t(pHeap);
+    size_t heapEndAddress = heapStartAddress + heapSize;
+
+    // Page descriptors are at the start of the heap, followed by the pages themselves.
+    size_t descriptorsAddress = MemoryUtils::AlignAddress(heapStartAddress, alignof(PageDescriptor));
+    if (descriptorsAddress >= heapEndAddress)
+    {
+        return false;
+    }
+
+    size_t numPages = (heapEndAddress - descriptorsAddress) / (ms_PageSize + sizeof(PageDescriptor));
+
+    size_t firstPageAddress = MemoryUtils::AlignAddress(descriptorsAddress + numPages * sizeof(PageDescriptor), ms_PageSize);
+    while (numPages > 0 && firstPageAddress + numPages * ms_PageSize > heapEndAddress)
+    {
+        numPages -= 1;
+        firstPageAddress = MemoryUtils::AlignAddress(descriptorsAddress + numPages * sizeof(PageDescriptor), ms_PageSize);
+    }
+
+    if (numPages == 0)
+    {
+        return false;
+    }
+
+    m_pHeap = pHeap;
+    m_HeapSize = heapSize;
+
+    m_pPageDescriptors = reinterpret_cast<PageDescriptor*>(descriptorsAddress);
+    m_FirstPageAddress = firstPageAddress;
+    m_NumPages = numPages;
+    m_NumPagesEverUsed = 0;
+    m_pFirstEmptyPage = nullptr;
+
+    for (SizeClass& sizeClass : m_SizeClasses)
+    {
+        sizeClass.pFirstPartialPage = nullptr;
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo = MemoryInfo();
+    m_MemoryInfo.heapSize = heapSize;
+    m_MemoryInfo.numPages = numPages;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+void SmallObjectAllocator::Destroy()
+{
+    m_pHeap = nullptr;
+    m_HeapSize = 0;
+
+    m_pPageDescriptors = nullptr;
+    m_FirstPageAddress = 0;
+    m_NumPages = 0;
+    m_NumPagesEverUsed = 0;
+    m_pFirstEmptyPage = nullptr;
+
+    for (SizeClass& sizeClass : m_SizeClasses)
+    {
+        sizeClass.pFirstPartialPage = nullptr;
+    }
+}
+
+void* SmallObjectAllocator::Allocate(size_t size, size_t alignment
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            , const shipChar* pAllocationFilename
+            , int allocationLineNumber
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        )
+{
+    SHIP_ASSERT_MSG(alignment > 0, "SmallObjectAllocator::Allocate --> alignment cannot be 0");
+    SHIP_ASSERT_MSG((((alignment - 1) & alignment) == 0), "SmallObjectAllocator::Allocate --> alignment %zu is not a power-of-2", alignment);
+
+    shipUint32 sizeClassIndex = GetSizeClassIndex(size, alignment);
+    if (sizeClassIndex == g_InvalidSizeClassIndex)
+    {
+        return nullptr;
+    }
+
+    SizeClass& sizeClass = m_SizeClasses[sizeClassIndex];
+
+    void* pBlock = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.lock);
+
+        PageDescriptor* pPageDescriptor = sizeClass.pFirstPartialPage;
+        if (pPageDescriptor == nullptr)
+        {
+            pPageDescriptor = AcquireEmptyPage(sizeClassIndex);
+            if (pPageDescriptor == nullptr)
+            {
+                return nullptr;
+            }
+
+            PushPage(sizeClass.pFirstPartialPage, pPageDescriptor);
+        }
+
+        if (pPageDescriptor->pFirstFreeBlock != nullptr)
+        {
+            pBlock = pPageDescriptor->pFirstFreeBlock;
+            pPageDescriptor->pFirstFreeBlock = pPageDescriptor->pFirstFreeBlock->pNextFreeBlock;
+        }
+        else
+        {
+            pBlock = reinterpret_cast<void*>(GetPageAddress(pPageDescriptor) + pPageDescriptor->neverAllocatedOffset);
+            pPageDescriptor->neverAllocatedOffset += sizeClass.blockSize;
+        }
+
+        pPageDescriptor->numBlocksAllocated += 1;
+
+        // Full pages aren't tracked, they come back in the partial list when one of their blocks is deallocated.
+        if (pPageDescriptor->numBlocksAllocated == sizeClass.numBlocksPerPage)
+        {
+            RemovePage(sizeClass.pFirstPartialPage, pPageDescriptor);
+        }
+    }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    AtomicOperations::Increment(m_MemoryInfo.numBlocksAllocated);
+
+    size_t blockSize = size_t(sizeClass.blockSize);
+    size_t numUserBytesAllocated = AtomicOperations::Add(m_MemoryInfo.numUserBytesAllocated, blockSize) + blockSize;
+    size_t peakUserBytesAllocated = m_MemoryInfo.peakUserBytesAllocated;
+
+    while (numUserBytesAllocated > peakUserBytesAllocated)
+    {
+        size_t previousPeakUserBytesAllocated = AtomicOperations::CompareExchange(m_MemoryInfo.peakUserBytesAllocated, numUserBytesAllocated, peakUserBytesAllocated);
+        if (previousPeakUserBytesAllocated == peakUserBytesAllocated)
+        {
+            break;
+        }
+
+        peakUserBytesAllocated = previousPeakUserBytesAllocated;
+    }
+
+    DebugAllocator::GetInstance().Allocate(this, pBlock, blockSize, pAllocationFilename, allocationLineNumber);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return pBlock;
+}
+
+void SmallObjectAllocator::Deallocate(const void* memory)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    PageDescriptor* pPageDescriptor = GetPageDescriptor(memory);
+    SizeClass& sizeClass = m_SizeClasses[pPageDescriptor->sizeClassIndex];
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    SHIP_ASSERT_MSG(((size_t(memory) - GetPageAddress(pPageDescriptor)) % sizeClass.blockSize) == 0, "SmallObjectAllocator::Deallocate --> %p wasn't allocated by this allocator", memory);
+
+    AtomicOperations::Decrement(m_MemoryInfo.numBlocksAllocated);
+    AtomicOperations::Subtract(m_MemoryInfo.numUserBytesAllocated, size_t(sizeClass.blockSize));
+
+    DebugAllocator::GetInstance().Deallocate(memory);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    PageDescriptor* pPageToRelease = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.lock);
+
+        SHIP_ASSERT(pPageDescriptor->numBlocksAllocated > 0);
+
+        FreeBlockHeader* pFreeBlock = reinterpret_cast<FreeBlockHeader*>(const_cast<void*>(memory));
+        pFreeBlock->pNextFreeBlock = pPageDescriptor->pFirstFreeBlock;
+        pPageDescriptor->pFirstFreeBlock = pFreeBlock;
+
+        shipBool wasFull = (pPageDescriptor->numBlocksAllocated == sizeClass.numBlocksPerPage);
+
+        pPageDescriptor->numBlocksAllocated -= 1;
+
+        if (wasFull)
+        {
+            PushPage(sizeClass.pFirstPartialPage, pPageDescriptor);
+        }
+
+        // The last partial page of a class is kept even when empty, so that allocating and freeing a single block
+        // doesn't take and give back a page every time.
+        shipBool isLastPartialPage = (sizeClass.pFirstPartialPage == pPageDescriptor && pPageDescriptor->pNextPage == nullptr);
+
+        if (pPageDescriptor->numBlocksAllocated == 0 && !isLastPartialPage)
+        {
+            RemovePage(sizeClass.pFirstPartialPage, pPageDescriptor);
+
+            pPageToRelease = pPageDescriptor;
+        }
+    }
+
+    if (pPageToRelease != nullptr)
+    {
+        ReleaseEmptyPage(pPageToRelease);
+    }
+}
+
+shipBool SmallObjectAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+    PageDescriptor* pPageDescriptor = GetPageDescriptor(memory);
+
+    return (newSize <= size_t(m_SizeClasses[pPageDescriptor->sizeClassIndex].blockSize));
+}
+
+size_t SmallObjectAllocator::GetSizeClassBlockSize(size_t size)
+{
+    shipUint32 sizeClassIndex = GetSizeClassIndex(size, 1);
+
+    return (sizeClassIndex == g_InvalidSizeClassIndex) ? 0 : size_t(g_SizeClassBlockSizes[sizeClassIndex]);
+}
+
+shipUint32 SmallObjectAllocator::GetSizeClassIndex(size_t size, size_t alignment)
+{
+    if (size > ms_MaxAllocationSize)
+    {
+        return g_InvalidSizeClassIndex;
+    }
+
+    shipUint32 sizeClassIndex = g_SizeClassIndexFromSize[(size + 7) / 8];
+
+    // Pages are aligned to their size, so blocks are aligned to the largest power of 2 dividing the block size.
+    while (sizeClassIndex < ms_NumSizeClasses && (g_SizeClassBlockSizes[sizeClassIndex] & (alignment - 1)) != 0)
+    {
+        sizeClassIndex += 1;
+    }
+
+    return sizeClassIndex;
+}
+
+SmallObjectAllocator::PageDescriptor* SmallObjectAllocator::AcquireEmptyPage(shipUint32 sizeClassIndex)
+{
+    PageDescriptor* pPageDescriptor = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_EmptyPagesLock);
+
+        if (m_pFirstEmptyPage != nullptr)
+        {
+            pPageDescriptor = m_pFirstEmptyPage;
+            RemovePage(m_pFirstEmptyPage, pPageDescriptor);
+        }
+        else if (m_NumPagesEverUsed < m_NumPages)
+        {
+            pPageDescriptor = &m_pPageDescriptors[m_NumPagesEverUsed];
+            m_NumPagesEverUsed += 1;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        m_MemoryInfo.numPagesUsed += 1;
+        m_MemoryInfo.peakPagesUsed = MAX(m_MemoryInfo.peakPagesUsed, m_MemoryInfo.numPagesUsed);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    }
+
+    pPageDescriptor->pFirstFreeBlock = nullptr;
+    pPageDescriptor->pNextPage = nullptr;
+    pPageDescriptor->pPreviousPage = nullptr;
+    pPageDescriptor->neverAllocatedOffset = 0;
+    pPageDescriptor->numBlocksAllocated = 0;
+    pPageDescriptor->sizeClassIndex = shipUint8(sizeClassIndex);
+
+    return pPageDescriptor;
+}
+
+void SmallObjectAllocator::ReleaseEmptyPage(PageDescriptor* pPageDescriptor)
+{
+    std::lock_guard<std::mutex> lock(m_EmptyPagesLock);
+
+    PushPage(m_pFirstEmptyPage, pPageDescriptor);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo.numPagesUsed -= 1;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+}
+
+SmallObjectAllocator::PageDescriptor* SmallObjectAllocator::GetPageDescriptor(const void* memory) const
+{
+    size_t address = size_t(memory);
+
+    SHIP_ASSERT_MSG(address >= m_FirstPageAddress && address < m_FirstPageAddress + m_NumPages * ms_PageSize, "SmallObjectAllocator --> %p wasn't allocated by this allocator", memory);
+
+    return &m_pPageDescriptors[(address - m_FirstPageAddress) / ms_PageSize];
+}
+
+size_t SmallObjectAllocator::GetPageAddress(const PageDescriptor* pPageDescriptor) const
+{
+    return m_FirstPageAddress + size_t(pPageDescriptor - m_pPageDescriptors) * ms_PageSize;
+}
+
+void SmallObjectAllocator::PushPage(PageDescriptor*& pFirstPage, PageDescriptor* pPageDescriptor)
+{
+    pPageDescriptor->pPreviousPage = nullptr;
+    pPageDescriptor->pNextPage = pFirstPage;
+
+    if (pFirstPage != nullptr)
+    {
+        pFirstPage->pPreviousPage = pPageDescriptor;
+    }
+
+    pFirstPage = pPageDescriptor;
+}
+
+void SmallObjectAllocator::RemovePage(PageDescriptor*& pFirstPage, PageDescriptor* pPageDescriptor)
+{
+    if (pPageDescriptor->pPreviousPage != nullptr)
+    {
+        pPageDescriptor->pPreviousPage->pNextPage = pPageDescriptor->pNextPage;
+    }
+    else
+    {
+        pFirstPage = pPageDescriptor->pNextPage;
+    }
+
+    if (pPageDescriptor->pNextPage != nullptr)
+    {
+        pPageDescriptor->pNextPage->pPreviousPage = pPageDescriptor->pPreviousPage;
+    }
+
+    pPageDescriptor->pNextPage = nullptr;
+    pPageDescriptor->pPreviousPage = nullptr;
+}
+
+}
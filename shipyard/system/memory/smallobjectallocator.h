@@ -0,0 +1,134 @@
+#pragma once
+
+#include <system/memory/baseallocator.h>
+
+#include <mutex>
+
+namespace Shipyard
+{
+    // Allocator for small objects, up to ms_MaxAllocationSize bytes. The heap is split in pages of ms_PageSize bytes, and each page
+    // in use holds blocks of a single size class. Allocations are rounded up to the size of their class, and are served from the
+    // free list of a partially used page of that class. Blocks have no header: everything about a page lives in a descriptor
+    // stored at the start of the heap, found from the block's address. Pages left empty are given back to be reused by any class.
+    //
+    // Every size class has its own lock, so allocations of different sizes don't contend with each other.
+    //
+    // The SmallObjectAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
+    // calling SmallObjectAllocator::Destroy()
+    class SHIPYARD_SYSTEM_API SmallObjectAllocator : public BaseAllocator
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    public:
+        static const size_t ms_PageSize = 16 * 1024;
+        static const size_t ms_MaxAllocationSize = 256;
+        static const shipUint32 ms_NumSizeClasses = 16;
+
+    public:
+        SmallObjectAllocator();
+        ~SmallObjectAllocator();
+
+        // pHeap doesn't need to be aligned, pages are aligned to ms_PageSize within the heap.
+        shipBool Create(void* pHeap, size_t heapSize);
+        void Destroy();
+
+        // Alignment must be a power of 2 and non-zero. Blocks are naturally aligned to the largest power of 2 dividing their size,
+        // a larger alignment is honored by using a bigger size class. Returns nullptr if size is bigger than ms_MaxAllocationSize.
+        virtual void* Allocate(size_t size, size_t alignment
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                ) override;
+
+        // Memory must come from the allocator that allocated it.
+        virtual void Deallocate(const void* memory) override;
+
+        // Allocations can grow up to the size of their class.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
+        // Returns the size of the blocks size will be rounded up to, 0 if it's too big.
+        static size_t GetSizeClassBlockSize(size_t size);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        struct FreeBlockHeader
+        {
+            FreeBlockHeader* pNextFreeBlock;
+        };
+
+        struct PageDescriptor
+        {
+            // Blocks given back to the page, allocated first since they're more likely to be in the cache.
+            FreeBlockHeader* pFirstFreeBlock;
+
+            // Pages of the same size class with free blocks, or the list of empty pages.
+            PageDescriptor* pNextPage;
+            PageDescriptor* pPreviousPage;
+
+            // Blocks past this offset were never allocated, which avoids building the free list when a page is taken.
+            shipUint32 neverAllocatedOffset;
+            shipUint32 numBlocksAllocated;
+
+            shipUint8 sizeClassIndex;
+        };
+
+        struct SizeClass
+        {
+            PageDescriptor* pFirstPartialPage = nullptr;
+            shipUint32 blockSize = 0;
+            shipUint32 numBlocksPerPage = 0;
+
+            std::mutex lock;
+        };
+
+    private:
+        SmallObjectAllocator(const SmallObjectAllocator& src) = delete;
+        SmallObjectAllocator& operator= (const SmallObjectAllocator& rhs) = delete;
+
+        static shipUint32 GetSizeClassIndex(size_t size, size_t alignment);
+
+        PageDescriptor* AcquireEmptyPage(shipUint32 sizeClassIndex);
+        void ReleaseEmptyPage(PageDescriptor* pPageDescriptor);
+
+        PageDescriptor* GetPageDescriptor(const void* memory) const;
+        size_t GetPageAddress(const PageDescriptor* pPageDescriptor) const;
+
+        static void PushPage(PageDescriptor*& pFirstPage, PageDescriptor* pPageDescriptor);
+        static void RemovePage(PageDescriptor*& pFirstPage, PageDescriptor* pPageDescriptor);
+
+    private:
+        PageDescriptor* m_pPageDescriptors;
+        size_t m_FirstPageAddress;
+        size_t m_NumPages;
+
+        // Pages past this index were never used, which avoids building the empty page list on creation.
+        size_t m_NumPagesEverUsed;
+        PageDescriptor* m_pFirstEmptyPage;
+        std::mutex m_EmptyPagesLock;
+
+        SizeClass m_SizeClasses[ms_NumSizeClasses];
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo
+        {
+            size_t heapSize = 0;
+            size_t numPages = 0;
+            SHIP_ALIGN(8) size_t numPagesUsed = 0;
+            SHIP_ALIGN(8) shipUint64 numBlocksAllocated = 0;
+            SHIP_ALIGN(8) size_t numUserBytesAllocated = 0;
+            SHIP_ALIGN(8) size_t peakUserBytesAllocated = 0;
+            SHIP_ALIGN(8) size_t peakPagesUsed = 0;
+        };
+
+        MemoryInfo m_MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    };
+}
@@ -0,0 +1,598 @@
+#include <system/systemprecomp.h>
+
+#include <system/memory/tlsfallocator.h>
+
+#include <system/systemcommon.h>
+#include <system/systemdebug.h>
+
+#include <system/memory/memoryutils.h>
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+#include <system/memory/debugallocator.h>
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+namespace Shipyard
+{;
+
+namespace
+{
+    enum TLSFBlockFlags : size_t
+    {
+        TLSFBlockFlags_Free = 0x1,
+        TLSFBlockFlags_PreviousBlockFree = 0x2,
+
+        TLSFBlockFlags_All = (TLSFBlockFlags_Free | TLSFBlockFlags_PreviousBlockFree)
+    };
+
+    // A used block only has its size as overhead, since pPreviousPhysicalBlock lives in the previous block.
+    const size_t g_BlockHeaderOverhead = sizeof(size_t);
+
+    // The user pointer comes right after pPreviousPhysicalBlock and sizeAndFlags.
+    const size_t g_BlockUserPointerOffset = sizeof(void*) + sizeof(size_t);
+
+    // A free block must be able to hold its size and its free list pointers.
+    const size_t g_MinBlockSize = sizeof(size_t) + sizeof(void*) * 2;
+
+    size_t GetBlockSize(size_t sizeAndFlags)
+    {
+        return (sizeAndFlags & ~size_t(TLSFBlockFlags_All));
+    }
+
+    void SetBlockSize(size_t& sizeAndFlags, size_t size)
+    {
+        sizeAndFlags = (size | (sizeAndFlags & size_t(TLSFBlockFlags_All)));
+    }
+
+    shipBool IsFlagSet(size_t sizeAndFlags, TLSFBlockFlags flag)
+    {
+        return ((sizeAndFlags & size_t(flag)) != 0);
+    }
+
+    void SetFlag(size_t& sizeAndFlags, TLSFBlockFlags flag)
+    {
+        sizeAndFlags |= size_t(flag);
+    }
+
+    void ClearFlag(size_t& sizeAndFlags, TLSFBlockFlags flag)
+    {
+        sizeAndFlags &= ~size_t(flag);
+    }
+
+    // Returns 0 if the size is too big to ever be allocated.
+    size_t AdjustRequestSize(size_t size, size_t alignment)
+    {
+        size_t alignedSize = MemoryUtils::AlignAddress(size, alignment);
+
+        return ((alignedSize < TLSFAllocator::ms_MaxBlockSize) ? MAX(alignedSize, g_MinBlockSize) : 0);
+    }
+}
+
+TLSFAllocator::TLSFAllocator()
+    : m_FirstLevelBitmap(0)
+{
+    m_NullBlock.pPreviousPhysicalBlock = nullptr;
+    m_NullBlock.sizeAndFlags = 0;
+    m_NullBlock.pNextFreeBlock = &m_NullBlock;
+    m_NullBlock.pPreviousFreeBlock = &m_NullBlock;
+}
+
+TLSFAllocator::~TLSFAllocator()
+{
+    SHIP_ASSERT_MSG(m_pHeap == nullptr, "It is required to manually call Destroy on the TLSFAllocator %p to control when to free the memory.", this);
+}
+
+shipBool TLSFAllocator::Create(void* pHeap, size_t heapSize)
+{
+    SHIP_ASSERT_MSG(pHeap != nullptr && heapSize > 0, "TLSFAllocator::Create --> Trying to initialize a TLSF allocator with an invalid heap");
+
+    SHIP_ASSERT_MSG(
+            MemoryUtils::IsAddressAligned(size_t(pHeap), ms_AlignmentSize),
+            "TLSFAllocator::Create --> pHeap %p for TLSF allocator %p is assumed to be aligned to %zu bytes",
+            pHeap, this, ms_AlignmentSize);
+
+    // We need space for the size of the first block, and for the size of the sentinel block at the end.
+    const size_t heapOverhead = 2 * g_BlockHeaderOverhead;
+
+    SHIP_ASSERT_MSG(
+            heapSize >= heapOverhead + g_MinBlockSize,
+            "TLSFAllocator::Create --> Heap of %zu bytes for TLSF allocator %p is too small",
+            heapSize, this);
+
+    m_pHeap = pHeap;
+    m_HeapSize = heapSize;
+
+    m_NullBlock.pNextFreeBlock = &m_NullBlock;
+    m_NullBlock.pPreviousFreeBlock = &m_NullBlock;
+
+    m_FirstLevelBitmap = 0;
+
+    for (shipUint32 firstLevelIndex = 0; firstLevelIndex < ms_FirstLevelIndexCount; firstLevelIndex++)
+    {
+        m_SecondLevelBitmaps[firstLevelIndex] = 0;
+
+        for (shipUint32 secondLevelIndex = 0; secondLevelIndex < ms_SecondLevelIndexCount; secondLevelIndex++)
+        {
+            m_pFreeBlocks[firstLevelIndex][secondLevelIndex] = &m_NullBlock;
+        }
+    }
+
+    size_t usableHeapSize = ((heapSize - heapOverhead) & ~(ms_AlignmentSize - 1));
+    usableHeapSize = MIN(usableHeapSize, ms_MaxBlockSize - ms_AlignmentSize);
+
+    // The first block's pPreviousPhysicalBlock lies before the heap, but it's never accessed since there's no previous block to merge with.
+    BlockHeader* pBlock = reinterpret_cast<BlockHeader*>(size_t(pHeap) - g_BlockHeaderOverhead);
+    pBlock->sizeAndFlags = (usableHeapSize | TLSFBlockFlags_Free);
+
+    InsertFreeBlock(pBlock);
+
+    // Used block of size 0 at the end of the heap, so that we never try to merge past the heap.
+    BlockHeader* pSentinelBlock = LinkWithNextPhysicalBlock(pBlock);
+    pSentinelBlock->sizeAndFlags = TLSFBlockFlags_PreviousBlockFree;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    m_MemoryInfo = MemoryInfo();
+    m_MemoryInfo.heapSize = usableHeapSize;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+void TLSFAllocator::Destroy()
+{
+    m_pHeap = nullptr;
+    m_HeapSize = 0;
+}
+
+void* TLSFAllocator::Allocate(size_t size, size_t alignment
+
+        #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+            , const shipChar* pAllocationFilename
+            , int allocationLineNumber
+        #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+        )
+{
+    SHIP_ASSERT_MSG(alignment > 0, "TLSFAllocator::Allocate --> alignment cannot be 0");
+    SHIP_ASSERT_MSG( ( ((alignment - 1) & alignment) == 0 ), "TLSFAllocator::Allocate --> alignment %zu is not a power-of-2", alignment);
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    void* pUserPointer = FindAndPrepareBlock(size, alignment);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    if (pUserPointer != nullptr)
+    {
+        // User bytes are counted as the block's size, since the requested size isn't stored.
+        size_t blockSize = GetBlockSize(GetBlockFromUserPointer(pUserPointer)->sizeAndFlags);
+
+        m_MemoryInfo.numBlocksAllocated += 1;
+        m_MemoryInfo.numBytesUsed += blockSize + g_BlockHeaderOverhead;
+        m_MemoryInfo.numUserBytesAllocated += blockSize;
+        m_MemoryInfo.maxAllocatedUserSize = MAX(m_MemoryInfo.maxAllocatedUserSize, blockSize);
+        m_MemoryInfo.minAllocatedUserSize = MIN(m_MemoryInfo.minAllocatedUserSize, blockSize);
+        m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.peakUserBytesAllocated, m_MemoryInfo.numUserBytesAllocated);
+
+        DebugAllocator::GetInstance().Allocate(this, pUserPointer, blockSize, pAllocationFilename, allocationLineNumber);
+    }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return pUserPointer;
+}
+
+void TLSFAllocator::Deallocate(const void* memory)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    SHIP_ASSERT_MSG(size_t(m_pHeap) <= size_t(memory) && (size_t(m_pHeap) + size_t(m_HeapSize)) >= size_t(memory), "TLSFAllocator::Deallocate --> Memory address %p was not allocated from allocator %p", memory, this);
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    BlockHeader* pBlock = GetBlockFromUserPointer(memory);
+
+    SHIP_ASSERT_MSG(!IsFlagSet(pBlock->sizeAndFlags, TLSFBlockFlags_Free), "TLSFAllocator::Deallocate --> Memory address %p was already freed", memory);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    size_t blockSize = GetBlockSize(pBlock->sizeAndFlags);
+
+    m_MemoryInfo.numBlocksAllocated -= 1;
+    m_MemoryInfo.numBytesUsed -= blockSize + g_BlockHeaderOverhead;
+    m_MemoryInfo.numUserBytesAllocated -= blockSize;
+
+    DebugAllocator::GetInstance().Deallocate(memory);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    MarkBlockAsFree(pBlock);
+
+    pBlock = MergeWithPreviousBlock(pBlock);
+    pBlock = MergeWithNextBlock(pBlock);
+
+    InsertFreeBlock(pBlock);
+}
+
+shipBool TLSFAllocator::TryExpandInPlace(void* memory, size_t currentSize, size_t newSize)
+{
+    SHIP_ASSERT_MSG(size_t(m_pHeap) <= size_t(memory) && (size_t(m_pHeap) + size_t(m_HeapSize)) >= size_t(memory), "TLSFAllocator::TryExpandInPlace --> Memory address %p was not allocated from allocator %p", memory, this);
+
+    size_t adjustedSize = AdjustRequestSize(MAX(newSize, 1), ms_AlignmentSize);
+    if (adjustedSize == 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    BlockHeader* pBlock = GetBlockFromUserPointer(memory);
+
+    SHIP_ASSERT_MSG(!IsFlagSet(pBlock->sizeAndFlags, TLSFBlockFlags_Free), "TLSFAllocator::TryExpandInPlace --> Memory address %p was freed", memory);
+
+    size_t blockSize = GetBlockSize(pBlock->sizeAndFlags);
+    if (adjustedSize <= blockSize)
+    {
+        return true;
+    }
+
+    BlockHeader* pNextBlock = GetNextPhysicalBlock(pBlock);
+
+    shipBool canExpandInNextBlock =
+            IsFlagSet(pNextBlock->sizeAndFlags, TLSFBlockFlags_Free) &&
+            (blockSize + GetBlockSize(pNextBlock->sizeAndFlags) + g_BlockHeaderOverhead >= adjustedSize);
+
+    if (!canExpandInNextBlock)
+    {
+        return false;
+    }
+
+    RemoveFreeBlock(pNextBlock);
+    AbsorbBlock(pBlock, pNextBlock);
+
+    // Give back what we don't need, the same way it's done when allocating.
+    TrimFreeBlock(pBlock, adjustedSize);
+    MarkBlockAsUsed(pBlock);
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    size_t newBlockSize = GetBlockSize(pBlock->sizeAndFlags);
+
+    m_MemoryInfo.numBytesUsed += newBlockSize - blockSize;
+    m_MemoryInfo.numUserBytesAllocated += newBlockSize - blockSize;
+    m_MemoryInfo.maxAllocatedUserSize = MAX(m_MemoryInfo.maxAllocatedUserSize, newBlockSize);
+    m_MemoryInfo.peakUserBytesAllocated = MAX(m_MemoryInfo.peakUserBytesAllocated, m_MemoryInfo.numUserBytesAllocated);
+
+    DebugAllocator::GetInstance().Resize(memory, newBlockSize);
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    return true;
+}
+
+void* TLSFAllocator::FindAndPrepareBlock(size_t size, size_t alignment)
+{
+    size_t adjustedSize = AdjustRequestSize(MAX(size, 1), ms_AlignmentSize);
+    if (adjustedSize == 0)
+    {
+        return nullptr;
+    }
+
+    // For larger alignments, we look for a block big enough to hold the aligned allocation as well as a free block before it,
+    // so that the memory skipped to respect the alignment isn't lost.
+    const size_t minimalGapSize = sizeof(BlockHeader);
+
+    shipBool requiresAlignmentPadding = (alignment > ms_AlignmentSize);
+
+    size_t sizeToLocate = adjustedSize;
+
+    if (requiresAlignmentPadding)
+    {
+        sizeToLocate = AdjustRequestSize(adjustedSize + alignment + minimalGapSize, alignment);
+        if (sizeToLocate == 0)
+        {
+            return nullptr;
+        }
+    }
+
+    BlockHeader* pBlock = LocateFreeBlock(sizeToLocate);
+    if (pBlock == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (requiresAlignmentPadding)
+    {
+        size_t userPointerAddress = size_t(GetUserPointerFromBlock(pBlock));
+        size_t alignedUserPointerAddress = MemoryUtils::AlignAddress(userPointerAddress, alignment);
+
+        size_t gapSize = (alignedUserPointerAddress - userPointerAddress);
+
+        // The gap must be big enough to become a free block on its own.
+        if (gapSize > 0 && gapSize < minimalGapSize)
+        {
+            size_t offset = MAX(minimalGapSize - gapSize, alignment);
+
+            alignedUserPointerAddress = MemoryUtils::AlignAddress(alignedUserPointerAddress + offset, alignment);
+
+            gapSize = (alignedUserPointerAddress - userPointerAddress);
+        }
+
+        if (gapSize > 0)
+        {
+            pBlock = TrimFreeBlockLeadingSpace(pBlock, gapSize);
+        }
+    }
+
+    TrimFreeBlock(pBlock, adjustedSize);
+    MarkBlockAsUsed(pBlock);
+
+    void* pUserPointer = GetUserPointerFromBlock(pBlock);
+
+    SHIP_ASSERT(MemoryUtils::IsAddressAligned(size_t(pUserPointer), alignment));
+
+    return pUserPointer;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::LocateFreeBlock(size_t size)
+{
+    shipUint32 firstLevelIndex = 0;
+    shipUint32 secondLevelIndex = 0;
+
+    MappingSearch(size, firstLevelIndex, secondLevelIndex);
+
+    if (firstLevelIndex >= ms_FirstLevelIndexCount)
+    {
+        return nullptr;
+    }
+
+    BlockHeader* pBlock = SearchSuitableBlock(firstLevelIndex, secondLevelIndex);
+    if (pBlock == nullptr)
+    {
+        return nullptr;
+    }
+
+    SHIP_ASSERT(GetBlockSize(pBlock->sizeAndFlags) >= size);
+
+    RemoveFreeBlock(pBlock, firstLevelIndex, secondLevelIndex);
+
+    return pBlock;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::SearchSuitableBlock(shipUint32& firstLevelIndex, shipUint32& secondLevelIndex) const
+{
+    // First, look for a list with big enough blocks in the same first level.
+    shipUint32 secondLevelBitmap = (m_SecondLevelBitmaps[firstLevelIndex] & (~0u << secondLevelIndex));
+
+    if (secondLevelBitmap == 0)
+    {
+        // Otherwise, any block of the next non-empty first level will do.
+        shipUint32 firstLevelBitmap = (m_FirstLevelBitmap & (~0u << (firstLevelIndex + 1)));
+
+        if (firstLevelBitmap == 0)
+        {
+            return nullptr;
+        }
+
+        firstLevelIndex = GetLowestBitSetIndex(firstLevelBitmap);
+        secondLevelBitmap = m_SecondLevelBitmaps[firstLevelIndex];
+    }
+
+    secondLevelIndex = GetLowestBitSetIndex(secondLevelBitmap);
+
+    return m_pFreeBlocks[firstLevelIndex][secondLevelIndex];
+}
+
+void TLSFAllocator::InsertFreeBlock(BlockHeader* pBlock)
+{
+    shipUint32 firstLevelIndex = 0;
+    shipUint32 secondLevelIndex = 0;
+
+    MappingInsert(GetBlockSize(pBlock->sizeAndFlags), firstLevelIndex, secondLevelIndex);
+
+    InsertFreeBlock(pBlock, firstLevelIndex, secondLevelIndex);
+}
+
+void TLSFAllocator::RemoveFreeBlock(BlockHeader* pBlock)
+{
+    shipUint32 firstLevelIndex = 0;
+    shipUint32 secondLevelIndex = 0;
+
+    MappingInsert(GetBlockSize(pBlock->sizeAndFlags), firstLevelIndex, secondLevelIndex);
+
+    RemoveFreeBlock(pBlock, firstLevelIndex, secondLevelIndex);
+}
+
+void TLSFAllocator::InsertFreeBlock(BlockHeader* pBlock, shipUint32 firstLevelIndex, shipUint32 secondLevelIndex)
+{
+    BlockHeader* pCurrentFirstBlock = m_pFreeBlocks[firstLevelIndex][secondLevelIndex];
+
+    pBlock->pNextFreeBlock = pCurrentFirstBlock;
+    pBlock->pPreviousFreeBlock = &m_NullBlock;
+    pCurrentFirstBlock->pPreviousFreeBlock = pBlock;
+
+    m_pFreeBlocks[firstLevelIndex][secondLevelIndex] = pBlock;
+
+    m_FirstLevelBitmap |= (1u << firstLevelIndex);
+    m_SecondLevelBitmaps[firstLevelIndex] |= (1u << secondLevelIndex);
+}
+
+void TLSFAllocator::RemoveFreeBlock(BlockHeader* pBlock, shipUint32 firstLevelIndex, shipUint32 secondLevelIndex)
+{
+    BlockHeader* pPreviousFreeBlock = pBlock->pPreviousFreeBlock;
+    BlockHeader* pNextFreeBlock = pBlock->pNextFreeBlock;
+
+    pNextFreeBlock->pPreviousFreeBlock = pPreviousFreeBlock;
+    pPreviousFreeBlock->pNextFreeBlock = pNextFreeBlock;
+
+    if (m_pFreeBlocks[firstLevelIndex][secondLevelIndex] == pBlock)
+    {
+        m_pFreeBlocks[firstLevelIndex][secondLevelIndex] = pNextFreeBlock;
+
+        if (pNextFreeBlock == &m_NullBlock)
+        {
+            m_SecondLevelBitmaps[firstLevelIndex] &= ~(1u << secondLevelIndex);
+
+            if (m_SecondLevelBitmaps[firstLevelIndex] == 0)
+            {
+                m_FirstLevelBitmap &= ~(1u << firstLevelIndex);
+            }
+        }
+    }
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::SplitBlock(BlockHeader* pBlock, size_t size)
+{
+    // The remaining block's pPreviousPhysicalBlock overlaps with the last bytes of the block we're splitting.
+    BlockHeader* pRemainingBlock = reinterpret_cast<BlockHeader*>(size_t(GetUserPointerFromBlock(pBlock)) + size - g_BlockHeaderOverhead);
+
+    size_t remainingSize = GetBlockSize(pBlock->sizeAndFlags) - (size + g_BlockHeaderOverhead);
+
+    SHIP_ASSERT(remainingSize >= g_MinBlockSize);
+
+    pRemainingBlock->sizeAndFlags = remainingSize;
+    SetBlockSize(pBlock->sizeAndFlags, size);
+
+    MarkBlockAsFree(pRemainingBlock);
+
+    return pRemainingBlock;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::AbsorbBlock(BlockHeader* pPreviousBlock, BlockHeader* pBlock)
+{
+    size_t newSize = GetBlockSize(pPreviousBlock->sizeAndFlags) + GetBlockSize(pBlock->sizeAndFlags) + g_BlockHeaderOverhead;
+
+    SetBlockSize(pPreviousBlock->sizeAndFlags, newSize);
+
+    LinkWithNextPhysicalBlock(pPreviousBlock);
+
+    return pPreviousBlock;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::MergeWithPreviousBlock(BlockHeader* pBlock)
+{
+    if (IsFlagSet(pBlock->sizeAndFlags, TLSFBlockFlags_PreviousBlockFree))
+    {
+        BlockHeader* pPreviousBlock = pBlock->pPreviousPhysicalBlock;
+
+        SHIP_ASSERT(IsFlagSet(pPreviousBlock->sizeAndFlags, TLSFBlockFlags_Free));
+
+        RemoveFreeBlock(pPreviousBlock);
+
+        pBlock = AbsorbBlock(pPreviousBlock, pBlock);
+    }
+
+    return pBlock;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::MergeWithNextBlock(BlockHeader* pBlock)
+{
+    BlockHeader* pNextBlock = GetNextPhysicalBlock(pBlock);
+
+    if (IsFlagSet(pNextBlock->sizeAndFlags, TLSFBlockFlags_Free))
+    {
+        RemoveFreeBlock(pNextBlock);
+
+        pBlock = AbsorbBlock(pBlock, pNextBlock);
+    }
+
+    return pBlock;
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::TrimFreeBlockLeadingSpace(BlockHeader* pBlock, size_t size)
+{
+    BlockHeader* pRemainingBlock = pBlock;
+
+    if (GetBlockSize(pBlock->sizeAndFlags) >= sizeof(BlockHeader) + size)
+    {
+        // The leading space goes back in the free lists, and the remaining block is the one we'll use.
+        pRemainingBlock = SplitBlock(pBlock, size - g_BlockHeaderOverhead);
+        SetFlag(pRemainingBlock->sizeAndFlags, TLSFBlockFlags_PreviousBlockFree);
+
+        LinkWithNextPhysicalBlock(pBlock);
+        InsertFreeBlock(pBlock);
+    }
+
+    return pRemainingBlock;
+}
+
+void TLSFAllocator::TrimFreeBlock(BlockHeader* pBlock, size_t size)
+{
+    if (GetBlockSize(pBlock->sizeAndFlags) >= sizeof(BlockHeader) + size)
+    {
+        BlockHeader* pRemainingBlock = SplitBlock(pBlock, size);
+
+        LinkWithNextPhysicalBlock(pBlock);
+        SetFlag(pRemainingBlock->sizeAndFlags, TLSFBlockFlags_PreviousBlockFree);
+
+        InsertFreeBlock(pRemainingBlock);
+    }
+}
+
+void TLSFAllocator::MarkBlockAsFree(BlockHeader* pBlock)
+{
+    BlockHeader* pNextBlock = LinkWithNextPhysicalBlock(pBlock);
+
+    SetFlag(pNextBlock->sizeAndFlags, TLSFBlockFlags_PreviousBlockFree);
+    SetFlag(pBlock->sizeAndFlags, TLSFBlockFlags_Free);
+}
+
+void TLSFAllocator::MarkBlockAsUsed(BlockHeader* pBlock)
+{
+    BlockHeader* pNextBlock = GetNextPhysicalBlock(pBlock);
+
+    ClearFlag(pNextBlock->sizeAndFlags, TLSFBlockFlags_PreviousBlockFree);
+    ClearFlag(pBlock->sizeAndFlags, TLSFBlockFlags_Free);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::GetNextPhysicalBlock(const BlockHeader* pBlock)
+{
+    size_t nextBlockAddress = size_t(GetUserPointerFromBlock(pBlock)) + GetBlockSize(pBlock->sizeAndFlags) - g_BlockHeaderOverhead;
+
+    return reinterpret_cast<BlockHeader*>(nextBlockAddress);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::LinkWithNextPhysicalBlock(BlockHeader* pBlock)
+{
+    BlockHeader* pNextBlock = GetNextPhysicalBlock(pBlock);
+    pNextBlock->pPreviousPhysicalBlock = pBlock;
+
+    return pNextBlock;
+}
+
+void* TLSFAllocator::GetUserPointerFromBlock(const BlockHeader* pBlock)
+{
+    return reinterpret_cast<void*>(size_t(pBlock) + g_BlockUserPointerOffset);
+}
+
+TLSFAllocator::BlockHeader* TLSFAllocator::GetBlockFromUserPointer(const void* pUserPointer)
+{
+    return reinterpret_cast<BlockHeader*>(size_t(pUserPointer) - g_BlockUserPointerOffset);
+}
+
+void TLSFAllocator::MappingInsert(size_t size, shipUint32& firstLevelIndex, shipUint32& secondLevelIndex)
+{
+    if (size < ms_SmallBlockSize)
+    {
+        // Small blocks are linearly distributed in the first level.
+        firstLevelIndex = 0;
+        secondLevelIndex = shipUint32(size / (ms_SmallBlockSize / ms_SecondLevelIndexCount));
+    }
+    else
+    {
+        shipUint32 lastBitSet = GetHighestBitSetIndex(shipUint64(size));
+
+        secondLevelIndex = (shipUint32(size >> (lastBitSet - ms_SecondLevelIndexCountLog2)) ^ (1u << ms_SecondLevelIndexCountLog2));
+        firstLevelIndex = lastBitSet - shipUint32(ms_FirstLevelIndexShift - 1);
+    }
+}
+
+void TLSFAllocator::MappingSearch(size_t size, shipUint32& firstLevelIndex, shipUint32& secondLevelIndex)
+{
+    // Round up to the next list, so that any block found in it is big enough.
+    if (size >= ms_SmallBlockSize)
+    {
+        size_t roundUp = (size_t(1) << (GetHighestBitSetIndex(shipUint64(size)) - ms_SecondLevelIndexCountLog2)) - 1;
+        size += roundUp;
+    }
+
+    MappingInsert(size, firstLevelIndex, secondLevelIndex);
+}
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <system/memory/baseallocator.h>
+
+#include <mutex>
+
+namespace Shipyard
+{
+    // Two-Level Segregated Fit allocator, used to allocate variably sized chunk of memory from a fixed heap in constant time.
+    // Free blocks are kept in segregated lists indexed by a first level (power of 2 of the block size) and a second level
+    // (linear subdivision of that power of 2). Two bitmaps allow finding a non-empty list large enough for a request
+    // with two bit scans, and free blocks are merged with their physical neighbors as soon as they are freed.
+    //
+    // The TLSFAllocator does not take ownership of the memory. It is the responsability of the user to properly free it after
+    // calling TLSFAllocator::Destroy()
+    class SHIPYARD_SYSTEM_API TLSFAllocator : public BaseAllocator
+    {
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    public:
+        TLSFAllocator();
+        ~TLSFAllocator();
+
+        // pHeap is assumed to be aligned to 8 bytes. Only the first ms_MaxBlockSize bytes of the heap can be used.
+        shipBool Create(void* pHeap, size_t heapSize);
+        void Destroy();
+
+        // Alignment must be a power of 2 and non-zero.
+        virtual void* Allocate(size_t size, size_t alignment
+
+                #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+                    , const shipChar* pAllocationFilename
+                    , int allocationLineNumber
+                #endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+                ) override;
+
+        // Memory must come from the allocator that allocated it.
+        virtual void Deallocate(const void* memory) override;
+
+        // Grows the allocation's block into the next physical block if it's free and big enough.
+        virtual shipBool TryExpandInPlace(void* memory, size_t currentSize, size_t newSize) override;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        const MemoryInfo& GetMemoryInfo() const { return m_MemoryInfo; }
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+
+    private:
+        // Allocations are always a multiple of, and aligned to, ms_AlignmentSize bytes.
+        static const size_t ms_AlignmentSizeLog2 = 3;
+        static const size_t ms_AlignmentSize = (1 << ms_AlignmentSizeLog2);
+
+        // Each first level is subdivided in 2^ms_SecondLevelIndexCountLog2 second level lists.
+        static const size_t ms_SecondLevelIndexCountLog2 = 5;
+        static const size_t ms_SecondLevelIndexCount = (1 << ms_SecondLevelIndexCountLog2);
+
+        // Blocks smaller than ms_SmallBlockSize are all in the first level 0, linearly subdivided.
+#if CPU_BITS == CPU_BITS_64
+        static const size_t ms_FirstLevelIndexMax = 32;
+#else
+        // ms_MaxBlockSize must fit in a size_t.
+        static const size_t ms_FirstLevelIndexMax = 31;
+#endif // #if CPU_BITS == CPU_BITS_64
+        static const size_t ms_FirstLevelIndexShift = (ms_SecondLevelIndexCountLog2 + ms_AlignmentSizeLog2);
+        static const size_t ms_FirstLevelIndexCount = (ms_FirstLevelIndexMax - ms_FirstLevelIndexShift + 1);
+        static const size_t ms_SmallBlockSize = (1 << ms_FirstLevelIndexShift);
+
+    public:
+        static const size_t ms_MaxBlockSize = (size_t(1) << ms_FirstLevelIndexMax);
+
+    private:
+        // A block's user memory starts right after its size. pPreviousPhysicalBlock is stored in the last bytes of the previous
+        // block's memory, and is therefore only valid when the previous block is free. The free list pointers are only valid
+        // when the block is free, since they overlap with the user's memory.
+        struct BlockHeader
+        {
+            BlockHeader* pPreviousPhysicalBlock;
+
+            // The lowest bits of the size are used for the flags, since sizes are always multiple of ms_AlignmentSize.
+            size_t sizeAndFlags;
+
+            BlockHeader* pNextFreeBlock;
+            BlockHeader* pPreviousFreeBlock;
+        };
+
+    private:
+        void* FindAndPrepareBlock(size_t size, size_t alignment);
+
+        BlockHeader* LocateFreeBlock(size_t size);
+        BlockHeader* SearchSuitableBlock(shipUint32& firstLevelIndex, shipUint32& secondLevelIndex) const;
+
+        void InsertFreeBlock(BlockHeader* pBlock);
+        void RemoveFreeBlock(BlockHeader* pBlock);
+        void InsertFreeBlock(BlockHeader* pBlock, shipUint32 firstLevelIndex, shipUint32 secondLevelIndex);
+        void RemoveFreeBlock(BlockHeader* pBlock, shipUint32 firstLevelIndex, shipUint32 secondLevelIndex);
+
+        BlockHeader* SplitBlock(BlockHeader* pBlock, size_t size);
+        BlockHeader* AbsorbBlock(BlockHeader* pPreviousBlock, BlockHeader* pBlock);
+        BlockHeader* MergeWithPreviousBlock(BlockHeader* pBlock);
+        BlockHeader* MergeWithNextBlock(BlockHeader* pBlock);
+
+        BlockHeader* TrimFreeBlockLeadingSpace(BlockHeader* pBlock, size_t size);
+        void TrimFreeBlock(BlockHeader* pBlock, size_t size);
+
+        void MarkBlockAsFree(BlockHeader* pBlock);
+        void MarkBlockAsUsed(BlockHeader* pBlock);
+
+        static BlockHeader* GetNextPhysicalBlock(const BlockHeader* pBlock);
+        static BlockHeader* LinkWithNextPhysicalBlock(BlockHeader* pBlock);
+
+        static void* GetUserPointerFromBlock(const BlockHeader* pBlock);
+        static BlockHeader* GetBlockFromUserPointer(const void* pUserPointer);
+
+        static void MappingInsert(size_t size, shipUint32& firstLevelIndex, shipUint32& secondLevelIndex);
+        static void MappingSearch(size_t size, shipUint32& firstLevelIndex, shipUint32& secondLevelIndex);
+
+    private:
+        // Every empty free list points to this block, which saves a few branches when inserting and removing blocks.
+        BlockHeader m_NullBlock;
+
+        shipUint32 m_FirstLevelBitmap;
+        shipUint32 m_SecondLevelBitmaps[ms_FirstLevelIndexCount];
+
+        BlockHeader* m_pFreeBlocks[ms_FirstLevelIndexCount][ms_SecondLevelIndexCount];
+
+        std::mutex m_Lock;
+
+#ifdef SHIP_ALLOCATOR_DEBUG_INFO
+        struct MemoryInfo
+        {
+            shipUint64 numBlocksAllocated = 0;
+            size_t heapSize = 0;
+            size_t numBytesUsed = 0;
+            size_t numUserBytesAllocated = 0;
+            size_t maxAllocatedUserSize = 0;
+            size_t minAllocatedUserSize = size_t(-1);
+            size_t peakUserBytesAllocated = 0;
+        };
+
+        MemoryInfo m_MemoryInfo;
+#endif // #ifdef SHIP_ALLOCATOR_DEBUG_INFO
+    };
+}
@@ -0,0 +1,268 @@
+#include <system/systemprecomp.h>
+
+#include <system/memory/virtualmemoryheap.h>
+
+#include <system/systemdebug.h>
+
+#include <system/memory/memoryutils.h>
+
+#include <math/mathutilities.h>
+
+#if PLATFORM == PLATFORM_LINUX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // #if PLATFORM == PLATFORM_LINUX
+
+namespace Shipyard
+{;
+
+namespace
+{
+    void* ReserveAddressRange(size_t size, size_t alignment)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        // Reservations are always aligned to the allocation granularity, which is 64KB. Huge pages aren't used on Windows.
+        return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#elif PLATFORM == PLATFORM_LINUX
+        // Reserve enough to align the range ourselves, then give back the parts we don't need.
+        size_t sizeToReserve = size + alignment;
+
+        void* pReservedRange = mmap(nullptr, sizeToReserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (pReservedRange == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        size_t reservedRangeStart = size_t(pReservedRange);
+        size_t alignedRangeStart = MemoryUtils::AlignAddress(reservedRangeStart, alignment);
+
+        size_t leadingSize = (alignedRangeStart - reservedRangeStart);
+        size_t trailingSize = (sizeToReserve - leadingSize - size);
+
+        if (leadingSize > 0)
+        {
+            munmap(pReservedRange, leadingSize);
+        }
+
+        if (trailingSize > 0)
+        {
+            munmap(reinterpret_cast<void*>(alignedRangeStart + size), trailingSize);
+        }
+
+        return reinterpret_cast<void*>(alignedRangeStart);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+
+    void ReleaseAddressRange(void* pAddress, size_t size)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        VirtualFree(pAddress, 0, MEM_RELEASE);
+#elif PLATFORM == PLATFORM_LINUX
+        munmap(pAddress, size);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+
+    shipBool CommitPages(void* pAddress, size_t size)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        return (VirtualAlloc(pAddress, size, MEM_COMMIT, PAGE_READWRITE) != nullptr);
+#elif PLATFORM == PLATFORM_LINUX
+        return (mprotect(pAddress, size, PROT_READ | PROT_WRITE) == 0);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+
+    void DecommitPages(void* pAddress, size_t size)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        VirtualFree(pAddress, size, MEM_DECOMMIT);
+#elif PLATFORM == PLATFORM_LINUX
+        // Dropping the pages frees the physical memory right away, and they read back as zero if they're ever committed again.
+        madvise(pAddress, size, MADV_DONTNEED);
+        mprotect(pAddress, size, PROT_NONE);
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+    }
+}
+
+VirtualMemoryHeap::VirtualMemoryHeap()
+    : m_pBaseAddress(nullptr)
+    , m_ReservedSize(0)
+    , m_InitialCommittedSize(0)
+    , m_CommitGranularity(0)
+    , m_CommittedSize(0)
+{
+}
+
+VirtualMemoryHeap::~VirtualMemoryHeap()
+{
+    SHIP_ASSERT_MSG(m_pBaseAddress == nullptr, "It is required to manually call Destroy on the VirtualMemoryHeap %p to control when to free the memory.", this);
+}
+
+shipBool VirtualMemoryHeap::Create(size_t reservedSize, size_t initialCommittedSize, shipBool useHugePages)
+{
+    SHIP_ASSERT_MSG(initialCommittedSize <= reservedSize, "VirtualMemoryHeap::Create --> Can't commit %zu bytes out of the %zu bytes reserved", initialCommittedSize, reservedSize);
+
+    shipBool canUseHugePages = (useHugePages && reservedSize >= ms_HugePageSize);
+
+#if PLATFORM != PLATFORM_LINUX
+    canUseHugePages = false;
+#endif // #if PLATFORM != PLATFORM_LINUX
+
+    m_CommitGranularity = (canUseHugePages) ? ms_HugePageSize : MAX(ms_DefaultCommitGranularity, GetPageSize());
+    m_ReservedSize = MemoryUtils::AlignAddress(reservedSize, m_CommitGranularity);
+
+    m_pBaseAddress = ReserveAddressRange(m_ReservedSize, m_CommitGranularity);
+    if (m_pBaseAddress == nullptr)
+    {
+        m_ReservedSize = 0;
+
+        return false;
+    }
+
+#if PLATFORM == PLATFORM_LINUX
+    if (canUseHugePages)
+    {
+        madvise(m_pBaseAddress, m_ReservedSize, MADV_HUGEPAGE);
+    }
+#endif // #if PLATFORM == PLATFORM_LINUX
+
+    m_CommittedSize = 0;
+    m_InitialCommittedSize = 0;
+
+    if (!Grow(initialCommittedSize))
+    {
+        Destroy();
+
+        return false;
+    }
+
+    m_InitialCommittedSize = m_CommittedSize;
+
+    return true;
+}
+
+void VirtualMemoryHeap::Destroy()
+{
+    if (m_pBaseAddress != nullptr)
+    {
+        ReleaseAddressRange(m_pBaseAddress, m_ReservedSize);
+    }
+
+    m_pBaseAddress = nullptr;
+    m_ReservedSize = 0;
+    m_InitialCommittedSize = 0;
+    m_CommittedSize = 0;
+}
+
+shipBool VirtualMemoryHeap::Grow(size_t committedSize)
+{
+    if (committedSize <= GetCommittedSize())
+    {
+        return true;
+    }
+
+    if (committedSize > m_ReservedSize)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    // Another thread may have grown the heap while we were waiting for the lock.
+    size_t currentCommittedSize = m_CommittedSize;
+    if (committedSize <= currentCommittedSize)
+    {
+        return true;
+    }
+
+    size_t newCommittedSize = MIN(MemoryUtils::AlignAddress(committedSize, m_CommitGranularity), m_ReservedSize);
+
+    void* pStartOfNewPages = reinterpret_cast<void*>(size_t(m_pBaseAddress) + currentCommittedSize);
+
+    if (!CommitPages(pStartOfNewPages, newCommittedSize - currentCommittedSize))
+    {
+        return false;
+    }
+
+    // Released once the pages are committed, so that threads seeing the new size without taking the lock can use them.
+    AtomicOperations::Store(m_CommittedSize, newCommittedSize, MemoryOrder::Release);
+
+    return true;
+}
+
+void VirtualMemoryHeap::Shrink(size_t committedSize)
+{
+    std::lock_guard<std::mutex> lock(m_Lock);
+
+    size_t currentCommittedSize = m_CommittedSize;
+    size_t newCommittedSize = MAX(MemoryUtils::AlignAddress(committedSize, m_CommitGranularity), m_InitialCommittedSize);
+
+    if (newCommittedSize >= currentCommittedSize)
+    {
+        return;
+    }
+
+    AtomicOperations::Store(m_CommittedSize, newCommittedSize, MemoryOrder::Release);
+
+    void* pStartOfFreedPages = reinterpret_cast<void*>(size_t(m_pBaseAddress) + newCommittedSize);
+
+    DecommitPages(pStartOfFreedPages, currentCommittedSize - newCommittedSize);
+}
+
+size_t VirtualMemoryHeap::GetResidentSize() const
+{
+#if PLATFORM == PLATFORM_LINUX
+    const size_t pageSize = GetPageSize();
+
+    // Query the pages by batches to keep the result vector on the stack.
+    constexpr size_t numPagesPerBatch = 4096;
+    unsigned char pageResidency[numPagesPerBatch];
+
+    size_t committedSize = GetCommittedSize();
+    size_t numResidentPages = 0;
+
+    for (size_t offset = 0; offset < committedSize; offset += numPagesPerBatch * pageSize)
+    {
+        size_t batchSize = MIN(numPagesPerBatch * pageSize, committedSize - offset);
+
+        if (mincore(reinterpret_cast<void*>(size_t(m_pBaseAddress) + offset), batchSize, pageResidency) != 0)
+        {
+            return committedSize;
+        }
+
+        size_t numPagesInBatch = (batchSize + pageSize - 1) / pageSize;
+        for (size_t i = 0; i < numPagesInBatch; i++)
+        {
+            numResidentPages += (pageResidency[i] & 1);
+        }
+    }
+
+    return numResidentPages * pageSize;
+#else
+    // Windows charges committed memory against the commit limit whether it's touched or not, so that's what we report.
+    return GetCommittedSize();
+#endif // #if PLATFORM == PLATFORM_LINUX
+}
+
+size_t VirtualMemoryHeap::GetPageSize()
+{
+#if PLATFORM == PLATFORM_WINDOWS
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    return size_t(systemInfo.dwPageSize);
+#elif PLATFORM == PLATFORM_LINUX
+    return size_t(sysconf(_SC_PAGESIZE));
+#else
+#error "Unsupported platform"
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <system/atomicoperations.h>
+#include <system/platform.h>
+
+#include <mutex>
+
+namespace Shipyard
+{
+    // Heap provider that reserves a large range of address space up front, without using any memory, and commits pages at the
+    // start of it on demand. Allocators created on top of it can therefore be given a generous maximum size, grow without ever
+    // moving their heap, and give memory back to the OS when it's not needed anymore.
+    //
+    // The committed region always starts at the base address, and grows or shrinks in multiples of the commit granularity.
+    // Growing and shrinking are thread-safe, reading the committed size is lock-free.
+    class SHIPYARD_SYSTEM_API VirtualMemoryHeap
+    {
+    public:
+        // Heaps at least this big use transparent huge pages when requested, and commit memory by huge pages.
+        static const size_t ms_HugePageSize = 2 * 1024 * 1024;
+
+        // Memory is committed by chunks of at least this size, to avoid going to the OS for every allocation.
+        static const size_t ms_DefaultCommitGranularity = 64 * 1024;
+
+    public:
+        VirtualMemoryHeap();
+        ~VirtualMemoryHeap();
+
+        // reservedSize is rounded up to the commit granularity. useHugePages is only a hint to the OS, and is ignored on platforms
+        // where huge pages require special privileges.
+        shipBool Create(size_t reservedSize, size_t initialCommittedSize = 0, shipBool useHugePages = false);
+
+        // Gives the whole address range back to the OS.
+        void Destroy();
+
+        // Makes sure at least the first committedSize bytes of the heap can be used. Returns false if it's bigger than the reserved size,
+        // or if the OS is out of memory.
+        shipBool Grow(size_t committedSize);
+
+        // Gives back to the OS every page past the first committedSize bytes, which stay reserved. The heap never shrinks
+        // below its initial committed size.
+        void Shrink(size_t committedSize);
+
+        // Number of bytes of the committed region that are actually backed by physical memory, which is usually less than the
+        // committed size since the OS only maps pages the first time they are touched.
+        size_t GetResidentSize() const;
+
+        void* GetBaseAddress() const { return m_pBaseAddress; }
+        size_t GetReservedSize() const { return m_ReservedSize; }
+        size_t GetCommittedSize() const { return AtomicOperations::Load(m_CommittedSize, MemoryOrder::Acquire); }
+        size_t GetInitialCommittedSize() const { return m_InitialCommittedSize; }
+        size_t GetCommitGranularity() const { return m_CommitGranularity; }
+
+        static size_t GetPageSize();
+
+    private:
+        VirtualMemoryHeap(const VirtualMemoryHeap& src) = delete;
+        VirtualMemoryHeap& operator= (const VirtualMemoryHeap& rhs) = delete;
+
+    private:
+        void* m_pBaseAddress;
+        size_t m_ReservedSize;
+        size_t m_InitialCommittedSize;
+        size_t m_CommitGranularity;
+
+        // Only written with m_Lock held, but read without it to skip the lock when the pages are already committed.
+        SHIP_ALIGN(8) volatile size_t m_CommittedSize;
+
+        std::mutex m_Lock;
+    };
+}
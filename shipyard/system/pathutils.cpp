@@ -17,6 +17,11 @@ namespace PathUtils
 
 void NormalizePath(StringT& path)
 {
+    if (path.IsEmpty())
+    {
+        return;
+    }
+
     shipChar* pBuffer = path.GetWriteBuffer();
 
     while (*pBuffer != '\0')
@@ -109,7 +114,7 @@ void GetFileDirectory(const StringT& path, StringT* fileDirectory)
 
     if (endOfDirectoryIndex != pathLength)
     {
-        *fileDirectory = path.Substring(0, endOfDirectoryIndex + 1);
+        *fileDirectory = path.SubstringView(0, endOfDirectoryIndex + 1);
     }
 }
 
@@ -138,13 +143,13 @@ void CreateDirectories(const shipChar* path)
     StringT normalizedPath;
     PathUtils::NormalizePath(path, &normalizedPath);
 
-    InplaceArray<StringT, 32> directories;
-    StringSplit(normalizedPath.GetBuffer(), '/', directories);
+    InplaceArray<StringView, 32> directories;
+    StringSplit(normalizedPath, '/', directories);
 
     StringT currentDirectoryToCreate;
     currentDirectoryToCreate.Reserve(normalizedPath.Size());
 
-    for (const StringT& directory : directories)
+    for (const StringView& directory : directories)
     {
         currentDirectoryToCreate += directory;
 
@@ -79,6 +79,9 @@ namespace Shipyard
 #if COMPILER == COMPILER_MSVC
 #   define SHIP_INLINE inline
 #   define SHIP_ALIGN(alignment) __declspec(align(alignment))
+#elif COMPILER == COMPILER_GNUC
+#   define SHIP_INLINE inline
+#   define SHIP_ALIGN(alignment) __attribute__((aligned(alignment)))
 #else
 #   pragma error "Unreconized compiler"
 #endif // #if COMPILER == COMPILER_MSVC
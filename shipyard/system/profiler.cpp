@@ -0,0 +1,391 @@
+#include <system/systemprecomp.h>
+
+#include <system/profiler.h>
+
+#ifdef SHIP_ENABLE_PROFILER
+
+#include <system/memory.h>
+#include <system/systemdebug.h>
+
+#include <chrono>
+#include <fstream>
+
+namespace Shipyard
+{;
+
+namespace
+{
+    // The buffer claimed by the thread, only valid during the capture it was claimed for. Captures start at index 1.
+    struct ClaimedThreadEventBuffer
+    {
+        shipUint32 captureIndex = 0;
+        shipUint32 bufferIndex = 0;
+    };
+
+    thread_local ClaimedThreadEventBuffer t_ClaimedThreadEventBuffer;
+
+    shipUint64 GetTimeInNanoseconds()
+    {
+        return shipUint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void WriteJsonString(std::ofstream& traceFile, const shipChar* pString)
+    {
+        traceFile << '"';
+
+        for (const shipChar* pCharacter = pString; *pCharacter != '\0'; pCharacter++)
+        {
+            shipChar character = *pCharacter;
+
+            if (character == '"' || character == '\\')
+            {
+                traceFile << '\\' << character;
+            }
+            else if (shipUint8(character) < 0x20)
+            {
+                shipChar escapedCharacter[8];
+                snprintf(escapedCharacter, sizeof(escapedCharacter), "\\u%04x", shipUint32(shipUint8(character)));
+
+                traceFile << escapedCharacter;
+            }
+            else
+            {
+                traceFile << character;
+            }
+        }
+
+        traceFile << '"';
+    }
+}
+
+const shipChar Profiler::FrameMarkerName[] = "Frame";
+
+volatile shipUint32 Profiler::ms_IsCapturing = 0;
+
+Profiler::Profiler()
+    : m_pThreadEventBuffers(nullptr)
+    , m_pEvents(nullptr)
+    , m_MaxNumThreads(0)
+    , m_MaxNumEventsPerThread(0)
+    , m_pAllocator(nullptr)
+    , m_CaptureIndex(0)
+    , m_NumClaimedThreadEventBuffers(0)
+    , m_NumDroppedEventsWithoutBuffer(0)
+    , m_CaptureStartTimestamp(0)
+    , m_CaptureEndTimestamp(0)
+    , m_CaptureStartTimeInNanoseconds(0)
+    , m_CaptureEndTimeInNanoseconds(0)
+{
+}
+
+Profiler::~Profiler()
+{
+    SHIP_ASSERT_MSG(m_pThreadEventBuffers == nullptr, "Profiler::Destroy wasn't called");
+}
+
+shipBool Profiler::Create(shipUint32 maxNumThreads, shipUint32 maxNumEventsPerThread, BaseAllocator* pAllocator)
+{
+    SHIP_ASSERT(m_pThreadEventBuffers == nullptr);
+    SHIP_ASSERT(maxNumThreads > 0);
+
+    // A scope takes two events.
+    SHIP_ASSERT(maxNumEventsPerThread >= 2);
+
+    m_pAllocator = ((pAllocator != nullptr) ? pAllocator : &GetGlobalAllocator());
+
+    m_pEvents = reinterpret_cast<Event*>(SHIP_ALLOC_EX(m_pAllocator, size_t(maxNumThreads) * size_t(maxNumEventsPerThread) * sizeof(Event), SHIP_CACHE_LINE_SIZE));
+    if (m_pEvents == nullptr)
+    {
+        return false;
+    }
+
+    m_pThreadEventBuffers = SHIP_NEW_ARRAY_EX(m_pAllocator, ThreadEventBuffer, maxNumThreads, SHIP_CACHE_LINE_SIZE);
+    if (m_pThreadEventBuffers == nullptr)
+    {
+        SHIP_FREE_EX(m_pAllocator, m_pEvents);
+        m_pEvents = nullptr;
+
+        return false;
+    }
+
+    for (shipUint32 i = 0; i < maxNumThreads; i++)
+    {
+        ThreadEventBuffer& threadEventBuffer = m_pThreadEventBuffers[i];
+        threadEventBuffer.numEvents = 0;
+        threadEventBuffer.depth = 0;
+        threadEventBuffer.numDroppedEvents = 0;
+        threadEventBuffer.pEvents = m_pEvents + size_t(i) * size_t(maxNumEventsPerThread);
+    }
+
+    m_MaxNumThreads = maxNumThreads;
+    m_MaxNumEventsPerThread = maxNumEventsPerThread;
+
+    m_NumClaimedThreadEventBuffers = 0;
+    m_NumDroppedEventsWithoutBuffer = 0;
+
+    return true;
+}
+
+void Profiler::Destroy()
+{
+    if (m_pThreadEventBuffers == nullptr)
+    {
+        return;
+    }
+
+    SHIP_ASSERT_MSG(!IsCapturing(), "The capture must be stopped before destroying the profiler");
+
+    SHIP_DELETE_ARRAY_EX(m_pAllocator, m_pThreadEventBuffers);
+    SHIP_FREE_EX(m_pAllocator, m_pEvents);
+
+    m_pThreadEventBuffers = nullptr;
+    m_pEvents = nullptr;
+    m_MaxNumThreads = 0;
+    m_MaxNumEventsPerThread = 0;
+    m_NumClaimedThreadEventBuffers = 0;
+}
+
+void Profiler::StartCapture()
+{
+    SHIP_ASSERT_MSG(m_pThreadEventBuffers != nullptr, "Profiler::Create must be called before starting a capture");
+    SHIP_ASSERT_MSG(!IsCapturing(), "A capture is already running");
+
+    for (shipUint32 i = 0; i < m_MaxNumThreads; i++)
+    {
+        ThreadEventBuffer& threadEventBuffer = m_pThreadEventBuffers[i];
+        threadEventBuffer.numEvents = 0;
+        threadEventBuffer.depth = 0;
+        threadEventBuffer.numDroppedEvents = 0;
+    }
+
+    AtomicOperations::Store(m_NumClaimedThreadEventBuffers, 0u, MemoryOrder::Relaxed);
+    AtomicOperations::Store(m_NumDroppedEventsWithoutBuffer, shipUint64(0), MemoryOrder::Relaxed);
+
+    m_CaptureStartTimeInNanoseconds = GetTimeInNanoseconds();
+    m_CaptureStartTimestamp = GetProfilerTimestamp();
+
+    // Threads see the buffers reset above as soon as they see the new capture index.
+    AtomicOperations::Store(m_CaptureIndex, m_CaptureIndex + 1, MemoryOrder::Release);
+    AtomicOperations::Store(ms_IsCapturing, 1u, MemoryOrder::Release);
+}
+
+void Profiler::StopCapture()
+{
+    SHIP_ASSERT_MSG(IsCapturing(), "No capture is running");
+
+    AtomicOperations::Store(ms_IsCapturing, 0u, MemoryOrder::Release);
+
+    m_CaptureEndTimestamp = GetProfilerTimestamp();
+    m_CaptureEndTimeInNanoseconds = GetTimeInNanoseconds();
+}
+
+Profiler::ThreadEventBuffer* Profiler::GetThreadEventBuffer(shipBool claimIfNeeded)
+{
+    shipUint32 captureIndex = AtomicOperations::Load(m_CaptureIndex, MemoryOrder::Acquire);
+
+    ClaimedThreadEventBuffer& claimedThreadEventBuffer = t_ClaimedThreadEventBuffer;
+
+    if (claimedThreadEventBuffer.captureIndex != captureIndex)
+    {
+        if (!claimIfNeeded)
+        {
+            return nullptr;
+        }
+
+        claimedThreadEventBuffer.captureIndex = captureIndex;
+        claimedThreadEventBuffer.bufferIndex = AtomicOperations::Increment(m_NumClaimedThreadEventBuffers) - 1;
+    }
+
+    if (claimedThreadEventBuffer.bufferIndex >= m_MaxNumThreads)
+    {
+        return nullptr;
+    }
+
+    return &m_pThreadEventBuffers[claimedThreadEventBuffer.bufferIndex];
+}
+
+void Profiler::RecordEvent(ThreadEventBuffer& threadEventBuffer, const shipChar* pName, shipUint64 timestamp)
+{
+    shipUint32 numEvents = threadEventBuffer.numEvents;
+
+    Event& event = threadEventBuffer.pEvents[numEvents];
+    event.timestamp = timestamp;
+    event.pName = pName;
+
+    AtomicOperations::Store(threadEventBuffer.numEvents, numEvents + 1, MemoryOrder::Release);
+}
+
+shipBool Profiler::BeginScope(const shipChar* pName)
+{
+    ThreadEventBuffer* pThreadEventBuffer = GetThreadEventBuffer(true);
+    if (pThreadEventBuffer == nullptr)
+    {
+        AtomicOperations::Add(m_NumDroppedEventsWithoutBuffer, shipUint64(2), MemoryOrder::Relaxed);
+        return false;
+    }
+
+    // Room is kept for the end of this scope, and of every scope it's nested in.
+    if (pThreadEventBuffer->numEvents + pThreadEventBuffer->depth + 2 > m_MaxNumEventsPerThread)
+    {
+        AtomicOperations::Store(pThreadEventBuffer->numDroppedEvents, pThreadEventBuffer->numDroppedEvents + 2, MemoryOrder::Relaxed);
+        return false;
+    }
+
+    pThreadEventBuffer->depth += 1;
+
+    // Read last, so that the bookkeeping isn't part of the scope.
+    RecordEvent(*pThreadEventBuffer, pName, GetProfilerTimestamp());
+
+    return true;
+}
+
+void Profiler::EndScope()
+{
+    shipUint64 timestamp = GetProfilerTimestamp();
+
+    // The capture was restarted since the scope began, its begin is gone.
+    ThreadEventBuffer* pThreadEventBuffer = GetThreadEventBuffer(false);
+    if (pThreadEventBuffer == nullptr || pThreadEventBuffer->depth == 0)
+    {
+        return;
+    }
+
+    pThreadEventBuffer->depth -= 1;
+
+    RecordEvent(*pThreadEventBuffer, nullptr, timestamp);
+}
+
+void Profiler::MarkFrame()
+{
+    shipUint64 timestamp = GetProfilerTimestamp();
+
+    ThreadEventBuffer* pThreadEventBuffer = GetThreadEventBuffer(true);
+    if (pThreadEventBuffer == nullptr)
+    {
+        AtomicOperations::Increment(m_NumDroppedEventsWithoutBuffer, MemoryOrder::Relaxed);
+        return;
+    }
+
+    if (pThreadEventBuffer->numEvents + pThreadEventBuffer->depth + 1 > m_MaxNumEventsPerThread)
+    {
+        AtomicOperations::Store(pThreadEventBuffer->numDroppedEvents, pThreadEventBuffer->numDroppedEvents + 1, MemoryOrder::Relaxed);
+        return;
+    }
+
+    RecordEvent(*pThreadEventBuffer, FrameMarkerName, timestamp);
+}
+
+shipDouble Profiler::GetTicksPerMicrosecond() const
+{
+    shipUint64 endTimestamp = m_CaptureEndTimestamp;
+    shipUint64 endTimeInNanoseconds = m_CaptureEndTimeInNanoseconds;
+
+    if (IsCapturing())
+    {
+        endTimestamp = GetProfilerTimestamp();
+        endTimeInNanoseconds = GetTimeInNanoseconds();
+    }
+
+    if (endTimeInNanoseconds <= m_CaptureStartTimeInNanoseconds || endTimestamp <= m_CaptureStartTimestamp)
+    {
+        return 1.0;
+    }
+
+    return shipDouble(endTimestamp - m_CaptureStartTimestamp) * 1000.0 / shipDouble(endTimeInNanoseconds - m_CaptureStartTimeInNanoseconds);
+}
+
+shipBool Profiler::WriteChromeTrace(const shipChar* pFilename) const
+{
+    SHIP_ASSERT(pFilename != nullptr);
+
+    std::ofstream traceFile(pFilename, std::ios_base::out | std::ios_base::trunc);
+    if (!traceFile.is_open())
+    {
+        return false;
+    }
+
+    shipDouble ticksPerMicrosecond = GetTicksPerMicrosecond();
+    shipUint32 numThreadsCaptured = GetNumThreadsCaptured();
+    shipUint32 frameIndex = 0;
+    shipBool isFirstEvent = true;
+
+    traceFile << "{\"traceEvents\":[\n";
+
+    for (shipUint32 threadIndex = 0; threadIndex < numThreadsCaptured; threadIndex++)
+    {
+        const ThreadEventBuffer& threadEventBuffer = m_pThreadEventBuffers[threadIndex];
+
+        traceFile << (isFirstEvent ? "" : ",\n")
+                  << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadIndex
+                  << ",\"args\":{\"name\":\"Thread " << threadIndex << "\"}}";
+
+        isFirstEvent = false;
+
+        shipUint32 numEvents = AtomicOperations::Load(threadEventBuffer.numEvents, MemoryOrder::Acquire);
+
+        for (shipUint32 i = 0; i < numEvents; i++)
+        {
+            const Event& event = threadEventBuffer.pEvents[i];
+
+            // Trace timestamps are in microseconds, relative to the start of the capture.
+            shipInt64 elapsedTicks = shipInt64(event.timestamp - m_CaptureStartTimestamp);
+            shipDouble timeInMicroseconds = ((elapsedTicks > 0) ? (shipDouble(elapsedTicks) / ticksPerMicrosecond) : 0.0);
+
+            shipChar timestamp[32];
+            snprintf(timestamp, sizeof(timestamp), "%.3f", timeInMicroseconds);
+
+            traceFile << ",\n{";
+
+            if (event.pName == nullptr)
+            {
+                traceFile << "\"ph\":\"E\"";
+            }
+            else if (event.pName == FrameMarkerName)
+            {
+                traceFile << "\"name\":\"Frame " << frameIndex << "\",\"ph\":\"i\",\"s\":\"g\"";
+                frameIndex += 1;
+            }
+            else
+            {
+                traceFile << "\"name\":";
+                WriteJsonString(traceFile, event.pName);
+                traceFile << ",\"ph\":\"B\"";
+            }
+
+            traceFile << ",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":" << threadIndex << "}";
+        }
+    }
+
+    traceFile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    return traceFile.good();
+}
+
+shipUint32 Profiler::GetNumThreadsCaptured() const
+{
+    shipUint32 numClaimedThreadEventBuffers = AtomicOperations::Load(m_NumClaimedThreadEventBuffers, MemoryOrder::Relaxed);
+
+    return ((numClaimedThreadEventBuffers < m_MaxNumThreads) ? numClaimedThreadEventBuffers : m_MaxNumThreads);
+}
+
+shipUint64 Profiler::GetNumDroppedEvents() const
+{
+    shipUint64 numDroppedEvents = AtomicOperations::Load(m_NumDroppedEventsWithoutBuffer, MemoryOrder::Relaxed);
+
+    shipUint32 numThreadsCaptured = GetNumThreadsCaptured();
+    for (shipUint32 i = 0; i < numThreadsCaptured; i++)
+    {
+        numDroppedEvents += AtomicOperations::Load(m_pThreadEventBuffers[i].numDroppedEvents, MemoryOrder::Relaxed);
+    }
+
+    return numDroppedEvents;
+}
+
+Profiler& GetProfiler()
+{
+    return Profiler::GetInstance();
+}
+
+}
+
+#endif // #ifdef SHIP_ENABLE_PROFILER
@@ -0,0 +1,184 @@
+#pragma once
+
+#ifndef SHIP_MASTER
+#define SHIP_ENABLE_PROFILER
+#endif // #ifndef SHIP_MASTER
+
+#ifdef SHIP_ENABLE_PROFILER
+
+#include <system/atomicoperations.h>
+
+#if COMPILER == COMPILER_MSVC
+#include <intrin.h>
+#elif COMPILER == COMPILER_GNUC && !defined(__i386__) && !defined(__x86_64__)
+#include <time.h>
+#endif // #if COMPILER == COMPILER_MSVC
+
+namespace Shipyard
+{
+    class BaseAllocator;
+
+    // Profiler timestamps are CPU ticks where available, converted to microseconds with the frequency measured during the capture.
+    SHIP_INLINE shipUint64 GetProfilerTimestamp()
+    {
+#if COMPILER == COMPILER_MSVC
+        return __rdtsc();
+#elif COMPILER == COMPILER_GNUC && (defined(__i386__) || defined(__x86_64__))
+        return __builtin_ia32_rdtsc();
+#elif COMPILER == COMPILER_GNUC
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+
+        return (shipUint64(time.tv_sec) * 1000000000ull + shipUint64(time.tv_nsec));
+#else
+#error "Unsupported compiler"
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    // Records the begin and end timestamps of the SHIP_PROFILE_SCOPE scopes, and the SHIP_PROFILE_FRAME markers, while a capture
+    // is running. Captures are written as Chrome Trace Event JSON, which chrome://tracing and Perfetto open.
+    //
+    // Each thread claims its own event buffer the first time it records something during a capture, so recording never takes
+    // a lock. Events are dropped once a thread's buffer is full, or when more threads than there are buffers recorded something.
+    // Scopes are either recorded with both their begin and end, or not at all.
+    class SHIPYARD_SYSTEM_API Profiler
+    {
+    public:
+        static Profiler& GetInstance()
+        {
+            static Profiler s_Profiler;
+            return s_Profiler;
+        }
+
+        // Event buffers are allocated from pAllocator, or from the global allocator if it's null.
+        shipBool Create(shipUint32 maxNumThreads = 32, shipUint32 maxNumEventsPerThread = 16384, BaseAllocator* pAllocator = nullptr);
+        void Destroy();
+
+        // Starting a capture discards the previous one.
+        void StartCapture();
+        void StopCapture();
+
+        // The only check done by the SHIP_PROFILE_* macros when no capture is running.
+        static shipBool IsCapturing()
+        {
+            return (AtomicOperations::Load(ms_IsCapturing, MemoryOrder::Relaxed) != 0);
+        }
+
+        // Returns false if the scope wasn't recorded, in which case EndScope must not be called.
+        shipBool BeginScope(const shipChar* pName);
+        void EndScope();
+
+        void MarkFrame();
+
+        // Writes the last capture. Scopes still open when the capture was stopped only have their begin written.
+        shipBool WriteChromeTrace(const shipChar* pFilename) const;
+
+        shipUint32 GetNumThreadsCaptured() const;
+        shipUint64 GetNumDroppedEvents() const;
+
+    private:
+        // Frame markers use FrameMarkerName as their name, and end events nullptr.
+        struct Event
+        {
+            shipUint64 timestamp;
+            const shipChar* pName;
+        };
+
+        struct SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) ThreadEventBuffer
+        {
+            // Published with a release store once the event is written, so that events can be read while the thread records.
+            volatile shipUint32 numEvents;
+
+            // Number of open scopes, whose end events are always kept room for.
+            shipUint32 depth;
+
+            volatile shipUint64 numDroppedEvents;
+            Event* pEvents;
+        };
+
+    private:
+        Profiler();
+        ~Profiler();
+
+        Profiler(const Profiler& src) = delete;
+        Profiler& operator= (const Profiler& rhs) = delete;
+
+        // Returns nullptr if the calling thread has no buffer in the current capture, and can't claim one.
+        ThreadEventBuffer* GetThreadEventBuffer(shipBool claimIfNeeded);
+
+        void RecordEvent(ThreadEventBuffer& threadEventBuffer, const shipChar* pName, shipUint64 timestamp);
+
+        // Ticks per microsecond between the start of the capture and its end, or now if it's still running.
+        shipDouble GetTicksPerMicrosecond() const;
+
+    private:
+        static const shipChar FrameMarkerName[];
+
+        static volatile shipUint32 ms_IsCapturing;
+
+        ThreadEventBuffer* m_pThreadEventBuffers;
+        Event* m_pEvents;
+        shipUint32 m_MaxNumThreads;
+        shipUint32 m_MaxNumEventsPerThread;
+        BaseAllocator* m_pAllocator;
+
+        // Incremented on every capture, so that threads know that the buffer they claimed belongs to a previous capture.
+        volatile shipUint32 m_CaptureIndex;
+        volatile shipUint32 m_NumClaimedThreadEventBuffers;
+
+        volatile shipUint64 m_NumDroppedEventsWithoutBuffer;
+
+        shipUint64 m_CaptureStartTimestamp;
+        shipUint64 m_CaptureEndTimestamp;
+        shipUint64 m_CaptureStartTimeInNanoseconds;
+        shipUint64 m_CaptureEndTimeInNanoseconds;
+    };
+
+    SHIPYARD_SYSTEM_API Profiler& GetProfiler();
+
+    // Used by SHIP_PROFILE_SCOPE. The scope's end is only recorded if its begin was.
+    class ProfilerScope
+    {
+    public:
+        explicit ProfilerScope(const shipChar* pName)
+            : m_IsRecorded(Profiler::IsCapturing() && GetProfiler().BeginScope(pName))
+        {
+        }
+
+        ~ProfilerScope()
+        {
+            if (m_IsRecorded)
+            {
+                GetProfiler().EndScope();
+            }
+        }
+
+        ProfilerScope(const ProfilerScope& src) = delete;
+        ProfilerScope& operator= (const ProfilerScope& rhs) = delete;
+
+    private:
+        shipBool m_IsRecorded;
+    };
+}
+
+#define SHIP_PROFILE_CONCATENATE_INTERNAL(a, b) a##b
+#define SHIP_PROFILE_CONCATENATE(a, b) SHIP_PROFILE_CONCATENATE_INTERNAL(a, b)
+
+// Names must be string literals, they're only copied when the capture is written.
+#define SHIP_PROFILE_SCOPE(name) Shipyard::ProfilerScope SHIP_PROFILE_CONCATENATE(shipProfilerScope, __LINE__)("" name)
+
+#define SHIP_PROFILE_FRAME() \
+    do \
+    { \
+        if (Shipyard::Profiler::IsCapturing()) \
+        { \
+            Shipyard::GetProfiler().MarkFrame(); \
+        } \
+    } while (false)
+
+#else
+
+#define SHIP_PROFILE_SCOPE(name)
+#define SHIP_PROFILE_FRAME()
+
+#endif // #ifdef SHIP_ENABLE_PROFILER
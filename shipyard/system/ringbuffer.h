@@ -0,0 +1,152 @@
+#pragma once
+
+#include <system/atomicoperations.h>
+#include <system/systemdebug.h>
+
+namespace Shipyard
+{
+    // Lock-free ring buffer of variable sized records, with one producer thread and one consumer thread.
+    //
+    // Each record is preceded by its size, and never wraps around the end of the buffer: when a record doesn't fit in the bytes
+    // left before the end, those bytes are skipped with a padding record. Records are 4 bytes aligned.
+    //
+    // Read and write positions only ever increase, and are masked when accessing the buffer. The producer only reads the
+    // consumer's position when the space it last saw runs out, so that most writes don't touch the consumer's cache line.
+    template <shipUint32 SizeInBytes>
+    class SPSCRingBuffer
+    {
+        static_assert((SizeInBytes & (SizeInBytes - 1)) == 0, "SPSCRingBuffer size must be a power of 2");
+
+    public:
+        // Records can't be larger than half the buffer, so that a record always fits once the buffer is empty.
+        static const shipUint32 MaxRecordSize = SizeInBytes / 2 - sizeof(shipUint32);
+
+    public:
+        SPSCRingBuffer()
+            : m_WritePosition(0)
+            , m_ReservedWritePosition(0)
+            , m_CachedReadPosition(0)
+            , m_ReadPosition(0)
+            , m_PendingReadPosition(0)
+        {
+        }
+
+        // Producer side. Returns nullptr if the buffer is full, otherwise the record must be written and then published with
+        // EndWrite before the next BeginWrite.
+        void* BeginWrite(shipUint32 recordSize)
+        {
+            SHIP_ASSERT_MSG(recordSize <= MaxRecordSize, "Record of %u bytes is too large for SPSCRingBuffer of %u bytes", recordSize, SizeInBytes);
+
+            shipUint32 writePosition = m_WritePosition;
+            shipUint32 offset = (writePosition & (SizeInBytes - 1));
+            shipUint32 numBytesBeforeEnd = SizeInBytes - offset;
+
+            shipUint32 alignedRecordSize = GetAlignedRecordSize(recordSize);
+            shipUint32 requiredSize = (alignedRecordSize > numBytesBeforeEnd) ? (numBytesBeforeEnd + alignedRecordSize) : alignedRecordSize;
+
+            if (requiredSize > SizeInBytes - (writePosition - m_CachedReadPosition))
+            {
+                // Acquire: records read by the consumer are not overwritten.
+                m_CachedReadPosition = AtomicOperations::Load(m_ReadPosition, MemoryOrder::Acquire);
+
+                if (requiredSize > SizeInBytes - (writePosition - m_CachedReadPosition))
+                {
+                    return nullptr;
+                }
+            }
+
+            if (requiredSize != alignedRecordSize)
+            {
+                SetRecordSize(offset, PaddingRecord);
+
+                writePosition += numBytesBeforeEnd;
+                offset = 0;
+            }
+
+            SetRecordSize(offset, recordSize);
+
+            m_ReservedWritePosition = writePosition + alignedRecordSize;
+
+            return &m_Buffer[offset + sizeof(shipUint32)];
+        }
+
+        void EndWrite()
+        {
+            // Release: the record is visible to the consumer before the new write position.
+            AtomicOperations::Store(m_WritePosition, m_ReservedWritePosition, MemoryOrder::Release);
+        }
+
+        // Consumer side. Returns nullptr if the buffer is empty, otherwise the record must be released with EndRead before the
+        // next BeginRead.
+        const void* BeginRead(shipUint32* recordSize)
+        {
+            shipUint32 readPosition = m_ReadPosition;
+            shipUint32 writePosition = AtomicOperations::Load(m_WritePosition, MemoryOrder::Acquire);
+
+            while (readPosition != writePosition)
+            {
+                shipUint32 offset = (readPosition & (SizeInBytes - 1));
+                shipUint32 size = GetRecordSize(offset);
+
+                if (size == PaddingRecord)
+                {
+                    readPosition += SizeInBytes - offset;
+                    continue;
+                }
+
+                *recordSize = size;
+                m_PendingReadPosition = readPosition + GetAlignedRecordSize(size);
+
+                return &m_Buffer[offset + sizeof(shipUint32)];
+            }
+
+            // Skipped padding is given back to the producer.
+            if (readPosition != m_ReadPosition)
+            {
+                AtomicOperations::Store(m_ReadPosition, readPosition, MemoryOrder::Release);
+            }
+
+            return nullptr;
+        }
+
+        void EndRead()
+        {
+            AtomicOperations::Store(m_ReadPosition, m_PendingReadPosition, MemoryOrder::Release);
+        }
+
+        // Only a hint when called while the producer is writing.
+        shipUint32 GetNumBytesUsed() const
+        {
+            return (m_WritePosition - m_ReadPosition);
+        }
+
+    private:
+        static const shipUint32 PaddingRecord = shipUint32(-1);
+
+        static shipUint32 GetAlignedRecordSize(shipUint32 recordSize)
+        {
+            return ((recordSize + sizeof(shipUint32) + 3) & ~3u);
+        }
+
+        shipUint32 GetRecordSize(shipUint32 offset) const
+        {
+            return *reinterpret_cast<const shipUint32*>(&m_Buffer[offset]);
+        }
+
+        void SetRecordSize(shipUint32 offset, shipUint32 recordSize)
+        {
+            *reinterpret_cast<shipUint32*>(&m_Buffer[offset]) = recordSize;
+        }
+
+    private:
+        // Producer's positions and consumer's positions are kept on different cache lines.
+        SHIP_ALIGN(64) volatile shipUint32 m_WritePosition;
+        shipUint32 m_ReservedWritePosition;
+        shipUint32 m_CachedReadPosition;
+
+        SHIP_ALIGN(64) volatile shipUint32 m_ReadPosition;
+        shipUint32 m_PendingReadPosition;
+
+        SHIP_ALIGN(64) shipUint8 m_Buffer[SizeInBytes];
+    };
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <system/array.h>
+
+#include <utility>
+
+namespace Shipyard
+{
+    // Container that keeps its items densely packed, for objects that are iterated over every frame.
+    //
+    // Items are referred to with the same index and generation pairs as the GenerationalDataPool. The index is a slot in an
+    // indirection table, which stores where the item currently lives in the packed array, so that handles stay valid while items
+    // move around. Releasing an item moves the last item in its place.
+    //
+    // Iterating is a linear scan over the packed items, in no particular order. References to items are invalidated when
+    // items are created or released.
+    template <typename T, size_t alignment = 1>
+    class SlotMap
+    {
+    public:
+        static const shipUint32 InvalidSlotMapIndex = shipUint32(-1);
+        using GenerationType = shipUint16;
+
+    public:
+        SlotMap(BaseAllocator* pAllocator = nullptr)
+            : m_Datas(pAllocator)
+            , m_SlotIndices(pAllocator)
+            , m_Slots(pAllocator)
+            , m_FirstFreeSlot(InvalidSlotMapIndex)
+        {
+        }
+
+        template <typename... Args>
+        shipUint32 GetNewItemIndex(GenerationType* newItemGeneration, Args&&... args)
+        {
+            shipUint32 slotIndex = m_FirstFreeSlot;
+            if (slotIndex == InvalidSlotMapIndex)
+            {
+                slotIndex = m_Slots.Size();
+                m_Slots.Grow();
+            }
+            else
+            {
+                m_FirstFreeSlot = m_Slots[slotIndex].nextFreeSlot;
+            }
+
+            Slot& slot = m_Slots[slotIndex];
+            slot.denseIndex = m_Datas.Size();
+            slot.nextFreeSlot = InvalidSlotMapIndex;
+
+            m_Datas.EmplaceBack(std::forward<Args>(args)...);
+            m_SlotIndices.Add(slotIndex);
+
+            *newItemGeneration = slot.generation;
+
+            return slotIndex;
+        }
+
+        void ReleaseItem(shipUint32 index)
+        {
+            SHIP_ASSERT_MSG(index < m_Slots.Size() && m_Slots[index].denseIndex != InvalidSlotMapIndex, "Releasing index %u more than once for slot map 0x%p", index, this);
+
+            // The last item takes the place of the released one, its slot has to follow.
+            shipUint32 denseIndex = m_Slots[index].denseIndex;
+            shipUint32 lastSlotIndex = m_SlotIndices.Back();
+
+            m_Slots[lastSlotIndex].denseIndex = denseIndex;
+
+            m_Datas.RemoveAt(denseIndex);
+            m_SlotIndices.RemoveAt(denseIndex);
+
+            ReleaseSlot(index);
+        }
+
+        void Clear()
+        {
+            for (shipUint32 slotIndex : m_SlotIndices)
+            {
+                ReleaseSlot(slotIndex);
+            }
+
+            m_Datas.Clear();
+            m_SlotIndices.Clear();
+        }
+
+        shipBool IsValid(shipUint32 index, GenerationType generation) const
+        {
+            return (index < m_Slots.Size() && m_Slots[index].denseIndex != InvalidSlotMapIndex && m_Slots[index].generation == generation);
+        }
+
+        T& GetItem(shipUint32 index, GenerationType generation)
+        {
+            return m_Datas[GetDenseIndex(index, generation)];
+        }
+
+        const T& GetItem(shipUint32 index, GenerationType generation) const
+        {
+            return m_Datas[GetDenseIndex(index, generation)];
+        }
+
+        T* GetItemPtr(shipUint32 index, GenerationType generation)
+        {
+            return &m_Datas[GetDenseIndex(index, generation)];
+        }
+
+        const T* GetItemPtr(shipUint32 index, GenerationType generation) const
+        {
+            return &m_Datas[GetDenseIndex(index, generation)];
+        }
+
+        // Returns the index and generation of the item at the given position of the packed array, to get a handle to an item found
+        // while iterating.
+        shipUint32 GetItemIndex(shipUint32 denseIndex, GenerationType* itemGeneration) const
+        {
+            SHIP_ASSERT(denseIndex < m_SlotIndices.Size());
+
+            shipUint32 slotIndex = m_SlotIndices[denseIndex];
+            *itemGeneration = m_Slots[slotIndex].generation;
+
+            return slotIndex;
+        }
+
+        shipUint32 Size() const
+        {
+            return m_Datas.Size();
+        }
+
+        shipBool Empty() const
+        {
+            return m_Datas.Empty();
+        }
+
+        void Reserve(shipUint32 newCapacity)
+        {
+            m_Datas.Reserve(newCapacity);
+            m_SlotIndices.Reserve(newCapacity);
+            m_Slots.Reserve(newCapacity);
+        }
+
+        T& operator[] (shipUint32 denseIndex)
+        {
+            return m_Datas[denseIndex];
+        }
+
+        const T& operator[] (shipUint32 denseIndex) const
+        {
+            return m_Datas[denseIndex];
+        }
+
+        typename Array<T, alignment>::Iterator begin()
+        {
+            return m_Datas.begin();
+        }
+
+        typename Array<T, alignment>::ConstIterator begin() const
+        {
+            return m_Datas.begin();
+        }
+
+        typename Array<T, alignment>::Iterator end()
+        {
+            return m_Datas.end();
+        }
+
+        typename Array<T, alignment>::ConstIterator end() const
+        {
+            return m_Datas.end();
+        }
+
+    private:
+        struct Slot
+        {
+            // Position of the item in the packed array, or InvalidSlotMapIndex when the slot is free.
+            shipUint32 denseIndex = InvalidSlotMapIndex;
+            shipUint32 nextFreeSlot = InvalidSlotMapIndex;
+            GenerationType generation = 0;
+        };
+
+        shipUint32 GetDenseIndex(shipUint32 index, GenerationType generation) const
+        {
+            SHIP_ASSERT_MSG(index < m_Slots.Size() && m_Slots[index].denseIndex != InvalidSlotMapIndex, "Accessing index %u that was not previously allocated for slot map 0x%p", index, this);
+            SHIP_ASSERT_MSG(m_Slots[index].generation == generation, "Accessing index %u that was already deleted! Current generation %u, requested generation %u", index, m_Slots[index].generation, generation);
+
+            return m_Slots[index].denseIndex;
+        }
+
+        void ReleaseSlot(shipUint32 index)
+        {
+            Slot& slot = m_Slots[index];
+
+            slot.denseIndex = InvalidSlotMapIndex;
+            slot.nextFreeSlot = m_FirstFreeSlot;
+            slot.generation += 1;
+
+            m_FirstFreeSlot = index;
+        }
+
+    private:
+        Array<T, alignment> m_Datas;
+
+        // Slot of each item of the packed array.
+        Array<shipUint32> m_SlotIndices;
+
+        Array<Slot> m_Slots;
+        shipUint32 m_FirstFreeSlot;
+    };
+}
@@ -0,0 +1,569 @@
+#pragma once
+
+#include <system/array.h>
+#include <system/memory.h>
+#include <system/platform.h>
+#include <system/systemdebug.h>
+
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Shipyard
+{
+    template <typename T>
+    struct LessThan
+    {
+        shipBool operator() (const T& lhs, const T& rhs) const
+        {
+            return (lhs < rhs);
+        }
+    };
+
+    namespace SortInternal
+    {
+        // Below this many elements, insertion sort beats partitioning or merging.
+        constexpr size_t InsertionSortThreshold = 16;
+
+        template <typename T, typename Compare>
+        void InsertionSort(T* pFirst, T* pLast, Compare& compare)
+        {
+            for (T* pCurrent = pFirst + 1; pCurrent < pLast; pCurrent++)
+            {
+                if (!compare(*pCurrent, *(pCurrent - 1)))
+                {
+                    continue;
+                }
+
+                T element = std::move(*pCurrent);
+
+                T* pHole = pCurrent;
+                do
+                {
+                    *pHole = std::move(*(pHole - 1));
+                    pHole -= 1;
+                } while (pHole > pFirst && compare(element, *(pHole - 1)));
+
+                *pHole = std::move(element);
+            }
+        }
+
+        template <typename T, typename Compare>
+        void SiftDown(T* pElements, size_t root, size_t numElements, Compare& compare)
+        {
+            T element = std::move(pElements[root]);
+
+            size_t child = 2 * root + 1;
+            while (child < numElements)
+            {
+                if ((child + 1) < numElements && compare(pElements[child], pElements[child + 1]))
+                {
+                    child += 1;
+                }
+
+                if (!compare(element, pElements[child]))
+                {
+                    break;
+                }
+
+                pElements[root] = std::move(pElements[child]);
+
+                root = child;
+                child = 2 * root + 1;
+            }
+
+            pElements[root] = std::move(element);
+        }
+
+        template <typename T, typename Compare>
+        void HeapSort(T* pFirst, T* pLast, Compare& compare)
+        {
+            size_t numElements = size_t(pLast - pFirst);
+
+            for (size_t i = numElements / 2; i > 0; i--)
+            {
+                SiftDown(pFirst, i - 1, numElements, compare);
+            }
+
+            for (size_t i = numElements - 1; i > 0; i--)
+            {
+                std::swap(pFirst[0], pFirst[i]);
+                SiftDown(pFirst, 0, i, compare);
+            }
+        }
+
+        template <typename T, typename Compare>
+        void MoveMedianToFirst(T* pFirst, T* pA, T* pB, T* pC, Compare& compare)
+        {
+            if (compare(*pA, *pB))
+            {
+                if (compare(*pB, *pC))
+                {
+                    std::swap(*pFirst, *pB);
+                }
+                else if (compare(*pA, *pC))
+                {
+                    std::swap(*pFirst, *pC);
+                }
+                else
+                {
+                    std::swap(*pFirst, *pA);
+                }
+            }
+            else if (compare(*pA, *pC))
+            {
+                std::swap(*pFirst, *pA);
+            }
+            else if (compare(*pB, *pC))
+            {
+                std::swap(*pFirst, *pC);
+            }
+            else
+            {
+                std::swap(*pFirst, *pB);
+            }
+        }
+
+        // Quicksort until the ranges are small enough for insertion sort, which is done once over the whole range by the caller.
+        // Ranges that got partitioned badly too many times are heap sorted instead, so the worst case stays O(n log n).
+        template <typename T, typename Compare>
+        void IntroSortLoop(T* pFirst, T* pLast, shipUint32 depthLimit, Compare& compare)
+        {
+            while (size_t(pLast - pFirst) > InsertionSortThreshold)
+            {
+                if (depthLimit == 0)
+                {
+                    HeapSort(pFirst, pLast, compare);
+                    return;
+                }
+
+                depthLimit -= 1;
+
+                T* pMiddle = pFirst + (pLast - pFirst) / 2;
+                MoveMedianToFirst(pFirst, pFirst + 1, pMiddle, pLast - 1, compare);
+
+                // The pivot being a median of elements of the range, both scans are guaranteed to stop without bound checks.
+                T* pLeft = pFirst + 1;
+                T* pRight = pLast;
+                while (true)
+                {
+                    while (compare(*pLeft, *pFirst))
+                    {
+                        pLeft += 1;
+                    }
+
+                    pRight -= 1;
+                    while (compare(*pFirst, *pRight))
+                    {
+                        pRight -= 1;
+                    }
+
+                    if (pLeft >= pRight)
+                    {
+                        break;
+                    }
+
+                    std::swap(*pLeft, *pRight);
+                    pLeft += 1;
+                }
+
+                IntroSortLoop(pLeft, pLast, depthLimit, compare);
+                pLast = pLeft;
+            }
+        }
+
+        // Stable merge of two sorted ranges into pOutput, which must not overlap them.
+        template <typename T, typename Compare>
+        T* Merge(T* pFirstA, T* pLastA, T* pFirstB, T* pLastB, T* pOutput, Compare& compare)
+        {
+            while (pFirstA < pLastA && pFirstB < pLastB)
+            {
+                if (compare(*pFirstB, *pFirstA))
+                {
+                    *pOutput++ = std::move(*pFirstB++);
+                }
+                else
+                {
+                    *pOutput++ = std::move(*pFirstA++);
+                }
+            }
+
+            while (pFirstA < pLastA)
+            {
+                *pOutput++ = std::move(*pFirstA++);
+            }
+
+            while (pFirstB < pLastB)
+            {
+                *pOutput++ = std::move(*pFirstB++);
+            }
+
+            return pOutput;
+        }
+
+        // pBuffer must hold at least half of the elements.
+        template <typename T, typename Compare>
+        void MergeSort(T* pFirst, T* pLast, T* pBuffer, Compare& compare)
+        {
+            size_t numElements = size_t(pLast - pFirst);
+            if (numElements <= InsertionSortThreshold)
+            {
+                InsertionSort(pFirst, pLast, compare);
+                return;
+            }
+
+            T* pMiddle = pFirst + numElements / 2;
+
+            MergeSort(pFirst, pMiddle, pBuffer, compare);
+            MergeSort(pMiddle, pLast, pBuffer, compare);
+
+            // Already in order.
+            if (!compare(*pMiddle, *(pMiddle - 1)))
+            {
+                return;
+            }
+
+            // The first half is moved out of the way. Elements of the second half are never overwritten before being merged,
+            // since the output is always behind them.
+            T* pBufferLast = pBuffer;
+            for (T* pCurrent = pFirst; pCurrent < pMiddle; pCurrent++)
+            {
+                *pBufferLast++ = std::move(*pCurrent);
+            }
+
+            T* pBufferFirst = pBuffer;
+            T* pOutput = pFirst;
+            while (pBufferFirst < pBufferLast && pMiddle < pLast)
+            {
+                if (compare(*pMiddle, *pBufferFirst))
+                {
+                    *pOutput++ = std::move(*pMiddle++);
+                }
+                else
+                {
+                    *pOutput++ = std::move(*pBufferFirst++);
+                }
+            }
+
+            while (pBufferFirst < pBufferLast)
+            {
+                *pOutput++ = std::move(*pBufferFirst++);
+            }
+        }
+
+        SHIP_INLINE shipUint32 GetIntroSortDepthLimit(shipUint32 numElements)
+        {
+            shipUint32 log2 = 0;
+            while ((numElements >> log2) > 1)
+            {
+                log2 += 1;
+            }
+
+            return (2 * log2);
+        }
+    }
+
+    // Introsort: not stable, in place, O(n log n) in the worst case.
+    template <typename T, typename Compare>
+    void Sort(T* pElements, shipUint32 numElements, Compare compare)
+    {
+        if (numElements < 2)
+        {
+            return;
+        }
+
+        SortInternal::IntroSortLoop(pElements, pElements + numElements, SortInternal::GetIntroSortDepthLimit(numElements), compare);
+        SortInternal::InsertionSort(pElements, pElements + numElements, compare);
+    }
+
+    template <typename T>
+    void Sort(T* pElements, shipUint32 numElements)
+    {
+        Sort(pElements, numElements, LessThan<T>());
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy, typename Compare>
+    void Sort(Array<T, alignment, GrowthPolicy>& elements, Compare compare)
+    {
+        if (elements.Size() > 1)
+        {
+            Sort(&elements[0], elements.Size(), compare);
+        }
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy>
+    void Sort(Array<T, alignment, GrowthPolicy>& elements)
+    {
+        Sort(elements, LessThan<T>());
+    }
+
+    // Merge sort: elements that compare equal keep their order. A buffer of half the elements is taken from pAllocator,
+    // or from the global allocator if it's null.
+    template <typename T, typename Compare>
+    void StableSort(T* pElements, shipUint32 numElements, Compare compare, BaseAllocator* pAllocator = nullptr)
+    {
+        if (numElements < 2)
+        {
+            return;
+        }
+
+        Array<T> buffer(pAllocator);
+        if (numElements > SortInternal::InsertionSortThreshold)
+        {
+            buffer.Resize(numElements / 2);
+        }
+
+        SortInternal::MergeSort(pElements, pElements + numElements, buffer.Empty() ? nullptr : &buffer[0], compare);
+    }
+
+    template <typename T>
+    void StableSort(T* pElements, shipUint32 numElements)
+    {
+        StableSort(pElements, numElements, LessThan<T>());
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy, typename Compare>
+    void StableSort(Array<T, alignment, GrowthPolicy>& elements, Compare compare)
+    {
+        if (elements.Size() > 1)
+        {
+            StableSort(&elements[0], elements.Size(), compare, elements.GetAllocator());
+        }
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy>
+    void StableSort(Array<T, alignment, GrowthPolicy>& elements)
+    {
+        StableSort(elements, LessThan<T>());
+    }
+
+    template <typename T>
+    struct IdentityRadixSortKey
+    {
+        T operator() (T element) const
+        {
+            return element;
+        }
+    };
+
+    // LSD radix sort on the unsigned integer key returned by getKey, 8 bits at a time. It's stable and runs in O(n), at the
+    // cost of pTempElements, which must hold numElements elements. Every histogram is built in a single pass over the keys, and
+    // bytes that are the same for every key are skipped, so keys that only use their low bits are cheap to sort.
+    template <typename T, typename GetKey>
+    void RadixSort(T* pElements, shipUint32 numElements, T* pTempElements, GetKey getKey)
+    {
+        using KeyType = typename std::decay<decltype(getKey(*pElements))>::type;
+        static_assert(std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value, "Radix sort keys must be unsigned integers.");
+
+        constexpr shipUint32 NumBuckets = 256;
+        constexpr shipUint32 NumPasses = sizeof(KeyType);
+
+        if (numElements < 2)
+        {
+            return;
+        }
+
+        shipUint32 histograms[NumPasses][NumBuckets] = {};
+
+        for (shipUint32 i = 0; i < numElements; i++)
+        {
+            KeyType key = getKey(pElements[i]);
+
+            for (shipUint32 pass = 0; pass < NumPasses; pass++)
+            {
+                histograms[pass][(key >> (pass * 8)) & 0xFF] += 1;
+            }
+        }
+
+        T* pSource = pElements;
+        T* pDestination = pTempElements;
+
+        for (shipUint32 pass = 0; pass < NumPasses; pass++)
+        {
+            shipUint32 shift = pass * 8;
+            shipUint32* histogram = histograms[pass];
+
+            if (histogram[(getKey(pSource[0]) >> shift) & 0xFF] == numElements)
+            {
+                continue;
+            }
+
+            shipUint32 offset = 0;
+            for (shipUint32 bucket = 0; bucket < NumBuckets; bucket++)
+            {
+                shipUint32 numElementsInBucket = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += numElementsInBucket;
+            }
+
+            for (shipUint32 i = 0; i < numElements; i++)
+            {
+                shipUint32 bucket = ((getKey(pSource[i]) >> shift) & 0xFF);
+                pDestination[histogram[bucket]++] = std::move(pSource[i]);
+            }
+
+            std::swap(pSource, pDestination);
+        }
+
+        if (pSource != pElements)
+        {
+            for (shipUint32 i = 0; i < numElements; i++)
+            {
+                pElements[i] = std::move(pSource[i]);
+            }
+        }
+    }
+
+    template <typename T>
+    void RadixSort(T* pElements, shipUint32 numElements, T* pTempElements)
+    {
+        RadixSort(pElements, numElements, pTempElements, IdentityRadixSortKey<T>());
+    }
+
+    // The temporary elements are taken from the array's allocator.
+    template <typename T, size_t alignment, typename GrowthPolicy, typename GetKey>
+    void RadixSort(Array<T, alignment, GrowthPolicy>& elements, GetKey getKey)
+    {
+        shipUint32 numElements = elements.Size();
+        if (numElements < 2)
+        {
+            return;
+        }
+
+        Array<T, alignment> tempElements(elements.GetAllocator());
+        tempElements.Resize(numElements);
+
+        RadixSort(&elements[0], numElements, &tempElements[0], getKey);
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy>
+    void RadixSort(Array<T, alignment, GrowthPolicy>& elements)
+    {
+        RadixSort(elements, IdentityRadixSortKey<T>());
+    }
+
+    // Sorts a chunk of the elements per thread with introsort, then merges the chunks two by two, each merge also running on its
+    // own thread, until one is left. The result is the same as Sort's, but isn't stable either.
+    //
+    // numThreads is the number of hardware threads when 0. Each thread is given at least minElementsPerThread elements, threads
+    // costing more than they save below that, so small arrays are sorted on the calling thread only. compare is called from
+    // several threads at once. A buffer as big as the elements is taken from pAllocator, or from the global allocator if it's null.
+    template <typename T, typename Compare>
+    void ParallelSort(
+            T* pElements,
+            shipUint32 numElements,
+            Compare compare,
+            shipUint32 numThreads = 0,
+            shipUint32 minElementsPerThread = 16384,
+            BaseAllocator* pAllocator = nullptr)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = MAX(std::thread::hardware_concurrency(), 1u);
+        }
+
+        shipUint32 numChunks = MIN(numThreads, MAX(numElements / MAX(minElementsPerThread, 1u), 1u));
+        if (numChunks == 1)
+        {
+            Sort(pElements, numElements, compare);
+            return;
+        }
+
+        Array<shipUint32> chunkStarts(numChunks + 1, pAllocator);
+        for (shipUint32 i = 0; i <= numChunks; i++)
+        {
+            chunkStarts.Add(shipUint32(shipUint64(numElements) * i / numChunks));
+        }
+
+        Array<std::thread> threads(numChunks, pAllocator);
+
+        for (shipUint32 i = 1; i < numChunks; i++)
+        {
+            T* pChunk = pElements + chunkStarts[i];
+            shipUint32 numElementsInChunk = chunkStarts[i + 1] - chunkStarts[i];
+
+            threads.EmplaceBack([pChunk, numElementsInChunk, &compare]()
+            {
+                Sort(pChunk, numElementsInChunk, compare);
+            });
+        }
+
+        Sort(pElements, chunkStarts[1], compare);
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        Array<T> buffer(pAllocator);
+        buffer.Resize(numElements);
+
+        T* pSource = pElements;
+        T* pDestination = &buffer[0];
+
+        while (chunkStarts.Size() > 2)
+        {
+            threads.Resize(0);
+
+            shipUint32 numRuns = chunkStarts.Size() - 1;
+
+            // Runs are merged from pSource to pDestination, the one left over when there's an odd number of runs being moved as is.
+            for (shipUint32 i = 0; i < numRuns; i += 2)
+            {
+                shipUint32 firstA = chunkStarts[i];
+                shipUint32 firstB = chunkStarts[i + 1];
+                shipUint32 lastB = chunkStarts[MIN(i + 2, numRuns)];
+
+                threads.EmplaceBack([pSource, pDestination, firstA, firstB, lastB, &compare]()
+                {
+                    SortInternal::Merge(pSource + firstA, pSource + firstB, pSource + firstB, pSource + lastB, pDestination + firstA, compare);
+                });
+            }
+
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+
+            shipUint32 numMergedRuns = 0;
+            for (shipUint32 i = 0; i < numRuns; i += 2)
+            {
+                chunkStarts[numMergedRuns++] = chunkStarts[i];
+            }
+
+            chunkStarts[numMergedRuns] = numElements;
+            chunkStarts.Resize(numMergedRuns + 1);
+
+            std::swap(pSource, pDestination);
+        }
+
+        if (pSource != pElements)
+        {
+            for (shipUint32 i = 0; i < numElements; i++)
+            {
+                pElements[i] = std::move(pSource[i]);
+            }
+        }
+    }
+
+    template <typename T>
+    void ParallelSort(T* pElements, shipUint32 numElements)
+    {
+        ParallelSort(pElements, numElements, LessThan<T>());
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy, typename Compare>
+    void ParallelSort(Array<T, alignment, GrowthPolicy>& elements, Compare compare, shipUint32 numThreads = 0)
+    {
+        if (elements.Size() > 1)
+        {
+            ParallelSort(&elements[0], elements.Size(), compare, numThreads, 16384, elements.GetAllocator());
+        }
+    }
+
+    template <typename T, size_t alignment, typename GrowthPolicy>
+    void ParallelSort(Array<T, alignment, GrowthPolicy>& elements)
+    {
+        ParallelSort(elements, LessThan<T>());
+    }
+}
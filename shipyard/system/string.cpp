@@ -71,6 +71,11 @@ void StringSplit(const shipChar* str, shipChar delimiter, Array<StringA>& string
     }
 }
 
+void StringSplit(const StringView& str, shipChar delimiter, Array<StringView>& stringParts)
+{
+    str.Split(delimiter, stringParts);
+}
+
 shipInt32 StringCompare(const shipChar* str1, const shipChar* str2)
 {
     for (size_t idx = 0; true; idx++)
@@ -2,6 +2,7 @@
 
 #include <system/array.h>
 #include <system/memory.h>
+#include <system/stringview.h>
 
 namespace Shipyard
 {
@@ -20,12 +21,19 @@ namespace Shipyard
         // It is the caller's responsibility to make sure that numChars <= strlen(sz)
         String(const CharType* sz, size_t numChars, BaseAllocator* pAllocator = nullptr);
 
+        explicit String(const BaseStringView<CharType>& str, BaseAllocator* pAllocator = nullptr);
+
         String(const String& src);
+
+        // Takes the memory of src when it owns it, src is then left empty.
+        String(String&& src);
         ~String();
 
         String& operator= (const String& rhs);
+        String& operator= (String&& rhs);
         String& operator= (const CharType* rhs);
         String& operator= (CharType c);
+        String& operator= (const BaseStringView<CharType>& rhs);
 
         CharType& operator[] (size_t index);
         const CharType& operator[] (size_t index) const;
@@ -33,6 +41,7 @@ namespace Shipyard
         void operator+= (const String& rhs);
         void operator+= (const CharType* rhs);
         void operator+= (CharType c);
+        void operator+= (const BaseStringView<CharType>& rhs);
 
         String operator+ (const String& rhs) const;
         String operator+ (const CharType* rhs) const;
@@ -46,20 +55,26 @@ namespace Shipyard
 
         void Assign(const CharType* sz, size_t numChars);
         void Assign(const CharType* sz);
+        void Assign(const BaseStringView<CharType>& str);
         void Append(const CharType* sz, size_t numChars);
         void Append(const CharType* sz);
+        void Append(const BaseStringView<CharType>& str);
 
         void Insert(size_t pos, const String& str);
         void InsertSubstring(size_t pos, const String& str, size_t substringPos, size_t substringLength);
         void Insert(size_t pos, const CharType* str, size_t numChars);
         void Insert(size_t pos, const CharType* str);
+        void Insert(size_t pos, const BaseStringView<CharType>& str);
 
         void Erase(size_t pos, size_t length);
 
         CharType& At(size_t index);
         const CharType& At(size_t index) const;
 
+        // Returns nullptr until memory is allocated.
         CharType* GetWriteBuffer();
+
+        // Never returns nullptr, strings without memory return an empty string.
         const CharType* GetBuffer() const;
 
         // This method also reserves the extra null character.
@@ -77,6 +92,7 @@ namespace Shipyard
         size_t FindIndexOfFirst(const CharType* strToFind, size_t numChars, size_t startingPos) const;
         size_t FindIndexOfFirst(const CharType* strToFind, size_t startingPos) const;
         size_t FindIndexOfFirst(CharType charToFind, size_t startingPos) const;
+        size_t FindIndexOfFirst(const BaseStringView<CharType>& strToFind, size_t startingPos) const;
 
         size_t FindIndexOfFirstReverse(const String& strToFind, size_t startingPos) const;
         size_t FindIndexOfFirstReverse(const CharType* strToFind, size_t numChars, size_t startingPos) const;
@@ -87,6 +103,7 @@ namespace Shipyard
         size_t FindIndexOfFirstCaseInsensitive(const CharType* strToFind, size_t numChars, size_t startingPos) const;
         size_t FindIndexOfFirstCaseInsensitive(const CharType* strToFind, size_t startingPos) const;
         size_t FindIndexOfFirstCaseInsensitive(CharType charToFind, size_t startingPos) const;
+        size_t FindIndexOfFirstCaseInsensitive(const BaseStringView<CharType>& strToFind, size_t startingPos) const;
 
         size_t FindIndexOfFirstCaseInsensitiveReverse(const String& strToFind, size_t startingPos) const;
         size_t FindIndexOfFirstCaseInsensitiveReverse(const CharType* strToFind, size_t numChars, size_t startingPos) const;
@@ -95,15 +112,21 @@ namespace Shipyard
 
         String Substring(size_t pos, size_t lengthOfSubstring) const;
 
+        // Doesn't copy the characters, the view is invalidated when the string is modified.
+        BaseStringView<CharType> SubstringView(size_t pos, size_t lengthOfSubstring) const;
+
         int Compare(const String& str) const;
         int Compare(const CharType* str) const;
+        int Compare(const BaseStringView<CharType>& str) const;
 
         int CompareCaseInsensitive(const String& str) const;
         int CompareCaseInsensitive(const CharType* str) const;
+        int CompareCaseInsensitive(const BaseStringView<CharType>& str) const;
 
         shipBool EqualCaseInsensitive(const String& str) const;
         shipBool EqualCaseInsensitive(const CharType* str, size_t numChars) const;
         shipBool EqualCaseInsensitive(const CharType* str) const;
+        shipBool EqualCaseInsensitive(const BaseStringView<CharType>& str) const;
 
         void Format(const shipChar* format, ...);
 
@@ -111,6 +134,11 @@ namespace Shipyard
         shipBool operator== (const CharType* rhs) const;
         shipBool operator!= (const String& rhs) const;
         shipBool operator!= (const CharType* rhs) const;
+        shipBool operator== (const BaseStringView<CharType>& rhs) const;
+        shipBool operator!= (const BaseStringView<CharType>& rhs) const;
+
+        // Lets strings be passed to every function taking a view.
+        operator BaseStringView<CharType>() const;
 
         void SetAllocator(BaseAllocator* pAllocator);
         BaseAllocator* GetAllocator() const;
@@ -179,6 +207,9 @@ namespace Shipyard
 
     SHIPYARD_SYSTEM_API const shipChar* StringFormat(const shipChar* fmt, ...);
     SHIPYARD_SYSTEM_API void StringSplit(const shipChar* str, shipChar delimiter, Array<StringA>& stringParts);
+
+    // The parts point in str, which must outlive them.
+    SHIPYARD_SYSTEM_API void StringSplit(const StringView& str, shipChar delimiter, Array<StringView>& stringParts);
     SHIPYARD_SYSTEM_API shipInt32 StringCompare(const shipChar* str1, const shipChar* str2);
     SHIPYARD_SYSTEM_API shipBool AreStringsEqual(const shipChar* str1, const shipChar* str2);
 }
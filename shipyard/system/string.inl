@@ -23,13 +23,9 @@ String<CharType>::String(BaseAllocator* pAllocator)
         m_pAllocator = &GetGlobalAllocator();
     }
 
+    // Memory is only allocated once characters are added.
     m_NumChars = 0;
-    m_Capacity = DefaultStringCapacity;
-
-    size_t requiredSize = sizeof(CharType) * m_Capacity;
-    m_Buffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-    m_Buffer[m_NumChars] = '\0';
+    m_Capacity = 0;
 }
 
 template <typename CharType>
@@ -93,6 +89,12 @@ String<CharType>::String(const CharType* sz, size_t numChars, BaseAllocator* pAl
     }
 }
 
+template <typename CharType>
+String<CharType>::String(const BaseStringView<CharType>& str, BaseAllocator* pAllocator)
+    : String(str.GetBuffer(), str.Size(), pAllocator)
+{
+}
+
 template <typename CharType>
 String<CharType>::String(const String<CharType>& src)
     : m_pAllocator(src.m_pAllocator)
@@ -104,12 +106,15 @@ String<CharType>::String(const String<CharType>& src)
         m_NumChars = src.m_NumChars;
         m_Capacity = src.m_Capacity;
 
-        size_t requiredSize = sizeof(CharType) * m_Capacity;
-        m_Buffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
+        if (src.m_Buffer != nullptr)
+        {
+            size_t requiredSize = sizeof(CharType) * m_Capacity;
+            m_Buffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
 
-        memcpy(m_Buffer, src.m_Buffer, m_NumChars);
+            memcpy(m_Buffer, src.m_Buffer, m_NumChars);
 
-        m_Buffer[m_NumChars] = '\0';
+            m_Buffer[m_NumChars] = '\0';
+        }
     }
     else
     {
@@ -117,6 +122,31 @@ String<CharType>::String(const String<CharType>& src)
     }
 }
 
+template <typename CharType>
+String<CharType>::String(String<CharType>&& src)
+    : m_pAllocator(src.m_pAllocator)
+    , m_Buffer(nullptr)
+    , m_NumChars(0)
+    , m_Capacity(0)
+    , m_OwnMemory(true)
+{
+    if (src.m_OwnMemory)
+    {
+        m_Buffer = src.m_Buffer;
+        m_NumChars = src.m_NumChars;
+        m_Capacity = src.m_Capacity;
+
+        src.m_Buffer = nullptr;
+        src.m_NumChars = 0;
+        src.m_Capacity = 0;
+    }
+    else if (src.m_NumChars > 0)
+    {
+        // Memory we don't own may not outlive src, like an InplaceString's buffer.
+        Assign(src.m_Buffer, src.m_NumChars);
+    }
+}
+
 template <typename CharType>
 String<CharType>::~String()
 {
@@ -140,16 +170,53 @@ String<CharType>& String<CharType>::operator= (const String <CharType>& rhs)
             m_pAllocator = rhs.m_pAllocator;
 
             m_Capacity = rhs.m_Capacity;
+            m_Buffer = nullptr;
 
-            size_t requiredSize = sizeof(CharType) * m_Capacity;
-            m_Buffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
+            // Empty strings without memory stay that way.
+            if (m_Capacity > 0)
+            {
+                size_t requiredSize = sizeof(CharType) * m_Capacity;
+                m_Buffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
+            }
 
             m_OwnMemory = true;
         }
 
-        memcpy(m_Buffer, rhs.m_Buffer, m_NumChars);
+        if (m_Buffer != nullptr)
+        {
+            memcpy(m_Buffer, rhs.m_Buffer, m_NumChars);
 
-        m_Buffer[m_NumChars] = '\0';
+            m_Buffer[m_NumChars] = '\0';
+        }
+    }
+
+    return *this;
+}
+
+template <typename CharType>
+String<CharType>& String<CharType>::operator= (String<CharType>&& rhs)
+{
+    if (&rhs != this)
+    {
+        if (!rhs.m_OwnMemory)
+        {
+            return (*this = static_cast<const String<CharType>&>(rhs));
+        }
+
+        if (m_OwnMemory)
+        {
+            SHIP_FREE_EX(m_pAllocator, m_Buffer);
+        }
+
+        m_pAllocator = rhs.m_pAllocator;
+        m_Buffer = rhs.m_Buffer;
+        m_NumChars = rhs.m_NumChars;
+        m_Capacity = rhs.m_Capacity;
+        m_OwnMemory = true;
+
+        rhs.m_Buffer = nullptr;
+        rhs.m_NumChars = 0;
+        rhs.m_Capacity = 0;
     }
 
     return *this;
@@ -208,6 +275,14 @@ String<CharType>& String<CharType>::operator= (CharType c)
     return *this;
 }
 
+template <typename CharType>
+String<CharType>& String<CharType>::operator= (const BaseStringView<CharType>& rhs)
+{
+    Assign(rhs);
+
+    return *this;
+}
+
 template <typename CharType>
 CharType& String<CharType>::operator[] (size_t index)
 {
@@ -229,20 +304,7 @@ void String<CharType>::operator+= (const String<CharType>& rhs)
 
     if (newSize >= m_Capacity)
     {
-        m_Capacity = newSize + 1;
-
-        size_t requiredSize = sizeof(CharType) * m_Capacity;
-        CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-        memcpy(newBuffer, m_Buffer, m_NumChars);
-
-        if (m_OwnMemory)
-        {
-            SHIP_FREE_EX(m_pAllocator, m_Buffer);
-        }
-        
-        m_Buffer = newBuffer;
-        m_OwnMemory = true;
+        Reserve(newSize + 1);
     }
 
     memcpy(&m_Buffer[m_NumChars], rhs.m_Buffer, rhs.m_NumChars);
@@ -261,20 +323,7 @@ void String<CharType>::operator+= (const CharType* rhs)
     
     if (newSize >= m_Capacity)
     {
-        m_Capacity = newSize + 1;
-
-        size_t requiredSize = sizeof(CharType) * m_Capacity;
-        CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-        memcpy(newBuffer, m_Buffer, m_NumChars);
-
-        if (m_OwnMemory)
-        {
-            SHIP_FREE_EX(m_pAllocator, m_Buffer);
-        }
-
-        m_Buffer = newBuffer;
-        m_OwnMemory = true;
+        Reserve(newSize + 1);
     }
 
     memcpy(&m_Buffer[m_NumChars], rhs, numCharsToAdd);
@@ -291,20 +340,7 @@ void String<CharType>::operator+= (CharType c)
 
     if (newSize >= m_Capacity)
     {
-        m_Capacity = newSize + 1;
-
-        size_t requiredSize = sizeof(CharType) * m_Capacity;
-        CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-        memcpy(newBuffer, m_Buffer, m_NumChars);
-
-        if (m_OwnMemory)
-        {
-            SHIP_FREE_EX(m_pAllocator, m_Buffer);
-        }
-
-        m_Buffer = newBuffer;
-        m_OwnMemory = true;
+        Reserve(newSize + 1);
     }
 
     m_Buffer[m_NumChars] = c;
@@ -314,6 +350,12 @@ void String<CharType>::operator+= (CharType c)
     m_Buffer[m_NumChars] = '\0';
 }
 
+template <typename CharType>
+void String<CharType>::operator+= (const BaseStringView<CharType>& rhs)
+{
+    Append(rhs.GetBuffer(), rhs.Size());
+}
+
 template <typename CharType>
 String<CharType> String<CharType>::operator+ (const String<CharType>& rhs) const
 {
@@ -399,7 +441,7 @@ String<CharType> operator+ (const CharType* lhs, const String<CharType>& rhs)
     result.Resize(sizeOfNewString);
 
     memcpy(&result[0], lhs, sizeOfLhsString);
-    memcpy(&result[sizeOfLhsString], &rhs[0], rhs.Size());
+    memcpy(&result[sizeOfLhsString], rhs.GetBuffer(), rhs.Size());
 
     return result;
 }
@@ -419,7 +461,7 @@ String<CharType> operator+ (CharType c, const String<CharType>& rhs)
     result.Resize(sizeOfNewString);
 
     result[0] = c;
-    memcpy(&result[1], &rhs[0], rhs.Size());
+    memcpy(&result[1], rhs.GetBuffer(), rhs.Size());
 
     return result;
 }
@@ -444,7 +486,8 @@ void String<CharType>::Assign(const CharType* sz, size_t numChars)
         m_OwnMemory = true;
     }
 
-    memcpy(m_Buffer, sz, m_NumChars);
+    // The characters can come from a view on this string.
+    memmove(m_Buffer, sz, m_NumChars);
 
     m_Buffer[m_NumChars] = '\0';
 }
@@ -455,6 +498,12 @@ void String<CharType>::Assign(const CharType* sz)
     Assign(sz, strlen(sz));
 }
 
+template <typename CharType>
+void String<CharType>::Assign(const BaseStringView<CharType>& str)
+{
+    Assign(str.GetBuffer(), str.Size());
+}
+
 template <typename CharType>
 void String<CharType>::Append(const CharType* sz, size_t numChars)
 {
@@ -462,20 +511,7 @@ void String<CharType>::Append(const CharType* sz, size_t numChars)
 
     if (newSize >= m_Capacity)
     {
-        m_Capacity = newSize + 1;
-
-        size_t requiredSize = sizeof(CharType) * m_Capacity;
-        CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-        memcpy(newBuffer, m_Buffer, m_NumChars);
-
-        if (m_OwnMemory)
-        {
-            SHIP_FREE_EX(m_pAllocator, m_Buffer);
-        }
-
-        m_Buffer = newBuffer;
-        m_OwnMemory = true;
+        Reserve(newSize + 1);
     }
 
     memcpy(&m_Buffer[m_NumChars], sz, numChars);
@@ -491,6 +527,12 @@ void String<CharType>::Append(const CharType* sz)
     Append(sz, strlen(sz));
 }
 
+template <typename CharType>
+void String<CharType>::Append(const BaseStringView<CharType>& str)
+{
+    Append(str.GetBuffer(), str.Size());
+}
+
 template <typename CharType>
 void String<CharType>::Insert(size_t pos, const String<CharType>& str)
 {
@@ -693,10 +735,16 @@ void String<CharType>::Insert(size_t pos, const CharType* str)
     Insert(pos, str, strlen(str));
 }
 
+template <typename CharType>
+void String<CharType>::Insert(size_t pos, const BaseStringView<CharType>& str)
+{
+    Insert(pos, str.GetBuffer(), str.Size());
+}
+
 template <typename CharType>
 void String<CharType>::Erase(size_t pos, size_t length)
 {
-    if (length == 0)
+    if (length == 0 || m_Buffer == nullptr)
     {
         return;
     }
@@ -746,6 +794,12 @@ CharType* String<CharType>::GetWriteBuffer()
 template <typename CharType>
 const CharType* String<CharType>::GetBuffer() const
 {
+    if (m_Buffer == nullptr)
+    {
+        static const CharType s_EmptyString = CharType(0);
+        return &s_EmptyString;
+    }
+
     return m_Buffer;
 }
 
@@ -760,20 +814,7 @@ void String<CharType>::Resize(size_t newSize)
     {
         if (newSize >= m_Capacity)
         {
-            m_Capacity = newSize + 1;
-
-            size_t requiredSize = sizeof(CharType) * m_Capacity;
-            CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-
-            memcpy(newBuffer, m_Buffer, m_NumChars);
-
-            if (m_OwnMemory)
-            {
-                SHIP_FREE_EX(m_pAllocator, m_Buffer);
-            }
-            
-            m_Buffer = newBuffer;
-            m_OwnMemory = true;
+            Reserve(newSize + 1);
         }
     }
 
@@ -789,20 +830,24 @@ void String<CharType>::Reserve(size_t newCapacity)
         return;
     }
 
-    m_Capacity = newCapacity;
+    size_t requiredSize = sizeof(CharType) * newCapacity;
 
-    size_t requiredSize = sizeof(CharType) * m_Capacity;
-    CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
-    
-    size_t numCharsToCopy = MIN(newCapacity - 1, m_NumChars);
-    memcpy(newBuffer, m_Buffer, numCharsToCopy);
-
-    if (m_OwnMemory)
+    if (m_OwnMemory && m_Buffer != nullptr)
     {
-        SHIP_FREE_EX(m_pAllocator, m_Buffer);
+        // The allocator may be able to resize our buffer in place, otherwise it copies it for us.
+        m_Buffer = reinterpret_cast<CharType*>(SHIP_REALLOC_EX(m_pAllocator, m_Buffer, sizeof(CharType) * m_Capacity, requiredSize, 1));
     }
+    else
+    {
+        CharType* newBuffer = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(m_pAllocator, requiredSize, 1));
+
+        size_t numCharsToCopy = MIN(newCapacity - 1, m_NumChars);
+        memcpy(newBuffer, m_Buffer, numCharsToCopy);
 
-    m_Buffer = newBuffer;
+        m_Buffer = newBuffer;
+    }
+
+    m_Capacity = newCapacity;
 
     m_NumChars = MIN(m_NumChars, newCapacity - 1);
 
@@ -940,6 +985,12 @@ size_t String<CharType>::FindIndexOfFirst(CharType charToFind, size_t startingPo
     return InvalidIndex;
 }
 
+template <typename CharType>
+size_t String<CharType>::FindIndexOfFirst(const BaseStringView<CharType>& strToFind, size_t startingPos) const
+{
+    return FindIndexOfFirst(strToFind.GetBuffer(), strToFind.Size(), startingPos);
+}
+
 template <typename CharType>
 size_t String<CharType>::FindIndexOfFirstReverse(const String<CharType>& strToFind, size_t startingPos) const
 {
@@ -1130,6 +1181,12 @@ size_t String<CharType>::FindIndexOfFirstCaseInsensitive(CharType charToFind, si
     return InvalidIndex;
 }
 
+template <typename CharType>
+size_t String<CharType>::FindIndexOfFirstCaseInsensitive(const BaseStringView<CharType>& strToFind, size_t startingPos) const
+{
+    return FindIndexOfFirstCaseInsensitive(strToFind.GetBuffer(), strToFind.Size(), startingPos);
+}
+
 template <typename CharType>
 size_t String<CharType>::FindIndexOfFirstCaseInsensitiveReverse(const String<CharType>& strToFind, size_t startingPos) const
 {
@@ -1245,36 +1302,25 @@ String<CharType> String<CharType>::Substring(size_t pos, size_t lengthOfSubstrin
 }
 
 template <typename CharType>
-int String<CharType>::Compare(const String<CharType>& str) const
+BaseStringView<CharType> String<CharType>::SubstringView(size_t pos, size_t lengthOfSubstring) const
 {
-    for (size_t idx = 0; true; idx++)
-    {
-        CharType first = m_Buffer[idx];
-        CharType second = str.m_Buffer[idx];
-
-        int diff = (int(first) - int(second));
+    return BaseStringView<CharType>(GetBuffer(), m_NumChars).Substring(pos, lengthOfSubstring);
+}
 
-        if (diff < 0)
-        {
-            return -1;
-        }
-        else if (diff > 0)
-        {
-            return 1;
-        }
-        else if (first == '\0')
-        {
-            return 0;
-        }
-    }
+template <typename CharType>
+int String<CharType>::Compare(const String<CharType>& str) const
+{
+    return Compare(str.GetBuffer());
 }
 
 template <typename CharType>
 int String<CharType>::Compare(const CharType* str) const
 {
+    const CharType* buffer = GetBuffer();
+
     for (size_t idx = 0; true; idx++)
     {
-        CharType first = m_Buffer[idx];
+        CharType first = buffer[idx];
         CharType second = str[idx];
 
         int diff = (int(first) - int(second));
@@ -1295,36 +1341,25 @@ int String<CharType>::Compare(const CharType* str) const
 }
 
 template <typename CharType>
-int String<CharType>::CompareCaseInsensitive(const String<CharType>& str) const
+int String<CharType>::Compare(const BaseStringView<CharType>& str) const
 {
-    for (size_t idx = 0; true; idx++)
-    {
-        int first = tolower(m_Buffer[idx]);
-        int second = tolower(str.m_Buffer[idx]);
-
-        int diff = (first - second);
+    return BaseStringView<CharType>(GetBuffer(), m_NumChars).Compare(str);
+}
 
-        if (diff < 0)
-        {
-            return -1;
-        }
-        else if (diff > 0)
-        {
-            return 1;
-        }
-        else if (first == '\0')
-        {
-            return 0;
-        }
-    }
+template <typename CharType>
+int String<CharType>::CompareCaseInsensitive(const String<CharType>& str) const
+{
+    return CompareCaseInsensitive(str.GetBuffer());
 }
 
 template <typename CharType>
 int String<CharType>::CompareCaseInsensitive(const CharType* str) const
 {
+    const CharType* buffer = GetBuffer();
+
     for (size_t idx = 0; true; idx++)
     {
-        CharType first = tolower(m_Buffer[idx]);
+        CharType first = tolower(buffer[idx]);
         CharType second = tolower(str[idx]);
 
         int diff = (int(first) - int(second));
@@ -1344,6 +1379,12 @@ int String<CharType>::CompareCaseInsensitive(const CharType* str) const
     }
 }
 
+template <typename CharType>
+int String<CharType>::CompareCaseInsensitive(const BaseStringView<CharType>& str) const
+{
+    return BaseStringView<CharType>(GetBuffer(), m_NumChars).CompareCaseInsensitive(str);
+}
+
 template <typename CharType>
 shipBool String<CharType>::EqualCaseInsensitive(const String<CharType>& str) const
 {
@@ -1398,6 +1439,12 @@ shipBool String<CharType>::EqualCaseInsensitive(const CharType* str) const
     return EqualCaseInsensitive(str, strlen(str));
 }
 
+template <typename CharType>
+shipBool String<CharType>::EqualCaseInsensitive(const BaseStringView<CharType>& str) const
+{
+    return EqualCaseInsensitive(str.GetBuffer(), str.Size());
+}
+
 template <typename CharType>
 void String<CharType>::Format(const shipChar* format, ...)
 {
@@ -1413,6 +1460,11 @@ void String<CharType>::Format(const shipChar* format, ...)
 
     Resize(requiredLength);
 
+    if (m_Buffer == nullptr)
+    {
+        return;
+    }
+
     va_start(args, format);
     vsnprintf(m_Buffer, requiredLength + 1, format, args);
     va_end(args);
@@ -1498,6 +1550,24 @@ shipBool String<CharType>::operator!= (const CharType* rhs) const
     return false;
 }
 
+template <typename CharType>
+shipBool String<CharType>::operator== (const BaseStringView<CharType>& rhs) const
+{
+    return (BaseStringView<CharType>(GetBuffer(), m_NumChars) == rhs);
+}
+
+template <typename CharType>
+shipBool String<CharType>::operator!= (const BaseStringView<CharType>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template <typename CharType>
+String<CharType>::operator BaseStringView<CharType>() const
+{
+    return BaseStringView<CharType>(GetBuffer(), m_NumChars);
+}
+
 template <typename CharType>
 void String<CharType>::SetAllocator(BaseAllocator* pAllocator)
 {
@@ -1506,7 +1576,7 @@ void String<CharType>::SetAllocator(BaseAllocator* pAllocator)
         return;
     }
 
-    if (m_OwnMemory)
+    if (m_OwnMemory && m_Buffer != nullptr)
     {
         size_t requiredSize = sizeof(CharType) * m_Capacity;
         CharType* pNewArray = reinterpret_cast<CharType*>(SHIP_ALLOC_EX(pAllocator, requiredSize, 1));
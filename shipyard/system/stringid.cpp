@@ -0,0 +1,203 @@
+#include <system/systemprecomp.h>
+
+#include <system/stringid.h>
+
+#include <system/systemdebug.h>
+
+#ifdef SHIP_STRING_ID_INTERNING
+#include <mutex>
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+
+#include <string.h>
+
+namespace Shipyard
+{;
+
+#ifdef SHIP_STRING_ID_INTERNING
+
+namespace
+{
+    // The intern table doesn't use the engine's allocators, since ids are created during static initialization, before they
+    // exist. Once it's full, new strings are not interned anymore.
+    constexpr shipUint32 InternTableSize = 16384;
+    constexpr shipUint32 MaxNumInternedStrings = InternTableSize / 2;
+    constexpr size_t InternedStringsStorageSize = 512 * 1024;
+    constexpr shipUint32 InvalidStringOffset = shipUint32(-1);
+
+    struct StringIdInternTable
+    {
+        StringIdInternTable()
+            : numInternedStrings(0)
+            , storageUsed(0)
+        {
+            for (shipUint32& stringOffset : stringOffsets)
+            {
+                stringOffset = InvalidStringOffset;
+            }
+        }
+
+        std::mutex lock;
+
+        shipUint64 hashes[InternTableSize];
+        shipUint32 stringOffsets[InternTableSize];
+        shipBool caseInsensitiveStrings[InternTableSize];
+        shipUint32 numInternedStrings;
+
+        shipChar storage[InternedStringsStorageSize];
+        size_t storageUsed;
+    };
+
+    StringIdInternTable& GetStringIdInternTable()
+    {
+        static StringIdInternTable s_StringIdInternTable;
+        return s_StringIdInternTable;
+    }
+
+    // The case insensitive id of a string is the id of its lowercase version, so only the case insensitive strings are compared
+    // without their case.
+    shipBool AreInternedStringsEqual(
+            const shipChar* internedString,
+            shipBool isInternedStringCaseInsensitive,
+            const shipChar* str,
+            size_t numChars,
+            shipBool isCaseInsensitive)
+    {
+        for (size_t i = 0; i < numChars; i++)
+        {
+            shipChar internedChar = (isInternedStringCaseInsensitive ? StringIdUtils::ToLower(internedString[i]) : internedString[i]);
+            shipChar c = (isCaseInsensitive ? StringIdUtils::ToLower(str[i]) : str[i]);
+
+            if (internedChar != c || internedChar == '\0')
+            {
+                return false;
+            }
+        }
+
+        return (internedString[numChars] == '\0');
+    }
+
+    void InternString(shipUint64 hash, const shipChar* str, size_t numChars, shipBool isCaseInsensitive)
+    {
+        StringIdInternTable& internTable = GetStringIdInternTable();
+
+        std::lock_guard<std::mutex> lock(internTable.lock);
+
+        shipUint32 slot = shipUint32(HashUint64(hash)) & (InternTableSize - 1);
+        while (internTable.stringOffsets[slot] != InvalidStringOffset)
+        {
+            if (internTable.hashes[slot] == hash)
+            {
+                SHIP_ASSERT_MSG(
+                        AreInternedStringsEqual(
+                                &internTable.storage[internTable.stringOffsets[slot]],
+                                internTable.caseInsensitiveStrings[slot],
+                                str,
+                                numChars,
+                                isCaseInsensitive),
+                        "StringId collision: %s and %.*s have the same hash 0x%llx",
+                        &internTable.storage[internTable.stringOffsets[slot]],
+                        int(numChars),
+                        str,
+                        hash);
+
+                return;
+            }
+
+            slot = (slot + 1) & (InternTableSize - 1);
+        }
+
+        size_t requiredStorage = numChars + 1;
+        if (internTable.numInternedStrings == MaxNumInternedStrings || internTable.storageUsed + requiredStorage > InternedStringsStorageSize)
+        {
+            return;
+        }
+
+        shipChar* pInternedString = &internTable.storage[internTable.storageUsed];
+        memcpy(pInternedString, str, numChars);
+        pInternedString[numChars] = '\0';
+
+        internTable.hashes[slot] = hash;
+        internTable.stringOffsets[slot] = shipUint32(internTable.storageUsed);
+        internTable.caseInsensitiveStrings[slot] = isCaseInsensitive;
+
+        internTable.numInternedStrings += 1;
+        internTable.storageUsed += requiredStorage;
+    }
+
+    const shipChar* FindInternedString(shipUint64 hash)
+    {
+        StringIdInternTable& internTable = GetStringIdInternTable();
+
+        std::lock_guard<std::mutex> lock(internTable.lock);
+
+        shipUint32 slot = shipUint32(HashUint64(hash)) & (InternTableSize - 1);
+        while (internTable.stringOffsets[slot] != InvalidStringOffset)
+        {
+            if (internTable.hashes[slot] == hash)
+            {
+                return &internTable.storage[internTable.stringOffsets[slot]];
+            }
+
+            slot = (slot + 1) & (InternTableSize - 1);
+        }
+
+        return nullptr;
+    }
+}
+
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+
+StringId::StringId(const shipChar* str)
+    : StringId(str, strlen(str))
+{
+}
+
+StringId::StringId(const shipChar* str, size_t numChars)
+    : m_Hash(StringIdUtils::HashString(str, numChars))
+{
+#ifdef SHIP_STRING_ID_INTERNING
+    InternString(m_Hash, str, numChars, false);
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+}
+
+StringId::StringId(const StringA& str)
+    : StringId(str.GetBuffer(), str.Size())
+{
+}
+
+StringId::StringId(const StringView& str)
+    : StringId(str.GetBuffer(), str.Size())
+{
+}
+
+StringId StringId::CreateCaseInsensitive(const shipChar* str, size_t numChars)
+{
+    StringId stringId = FromHash(StringIdUtils::HashStringCaseInsensitive(str, numChars));
+
+#ifdef SHIP_STRING_ID_INTERNING
+    InternString(stringId.m_Hash, str, numChars, true);
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+
+    return stringId;
+}
+
+StringId StringId::CreateCaseInsensitive(const StringA& str)
+{
+    return CreateCaseInsensitive(str.GetBuffer(), str.Size());
+}
+
+StringId StringId::CreateCaseInsensitive(const StringView& str)
+{
+    return CreateCaseInsensitive(str.GetBuffer(), str.Size());
+}
+
+const shipChar* StringId::GetString() const
+{
+#ifdef SHIP_STRING_ID_INTERNING
+    return FindInternedString(m_Hash);
+#else
+    return nullptr;
+#endif // #ifdef SHIP_STRING_ID_INTERNING
+}
+
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <system/hash.h>
+#include <system/platform.h>
+#include <system/string.h>
+
+// Keeps the strings StringIds were created from, to be able to get them back when debugging.
+#if defined(SHIP_DEBUG) && !defined(SHIP_STRING_ID_DISABLE_INTERNING)
+#   define SHIP_STRING_ID_INTERNING
+#endif // #if defined(SHIP_DEBUG) && !defined(SHIP_STRING_ID_DISABLE_INTERNING)
+
+namespace Shipyard
+{
+    namespace StringIdUtils
+    {
+        // 64 bits FNV-1a, which is simple enough to be evaluated at compile time.
+        constexpr shipUint64 FnvOffsetBasis = 0xcbf29ce484222325ULL;
+        constexpr shipUint64 FnvPrime = 0x100000001b3ULL;
+
+        constexpr shipChar ToLower(shipChar c)
+        {
+            return (c >= 'A' && c <= 'Z') ? shipChar(c - 'A' + 'a') : c;
+        }
+
+        constexpr shipUint64 HashString(const shipChar* str, size_t numChars)
+        {
+            shipUint64 hash = FnvOffsetBasis;
+            for (size_t i = 0; i < numChars; i++)
+            {
+                hash = (hash ^ shipUint8(str[i])) * FnvPrime;
+            }
+
+            return hash;
+        }
+
+        constexpr shipUint64 HashString(const shipChar* str)
+        {
+            shipUint64 hash = FnvOffsetBasis;
+            for (; *str != '\0'; str++)
+            {
+                hash = (hash ^ shipUint8(*str)) * FnvPrime;
+            }
+
+            return hash;
+        }
+
+        constexpr shipUint64 HashStringCaseInsensitive(const shipChar* str, size_t numChars)
+        {
+            shipUint64 hash = FnvOffsetBasis;
+            for (size_t i = 0; i < numChars; i++)
+            {
+                hash = (hash ^ shipUint8(ToLower(str[i]))) * FnvPrime;
+            }
+
+            return hash;
+        }
+    }
+
+    // Identifies a string by its 64 bits hash, to replace string comparisons by integer comparisons when looking names up.
+    //
+    // Ids of string literals can be computed at compile time with SHIP_STRING_ID. Ids created at runtime from a string are
+    // added to a global, thread-safe intern table when SHIP_STRING_ID_INTERNING is defined, which lets GetString give back the
+    // string of an id, and asserts if two different strings have the same hash.
+    class SHIPYARD_SYSTEM_API StringId
+    {
+    public:
+        constexpr StringId()
+            : m_Hash(0)
+        {
+        }
+
+        explicit StringId(const shipChar* str);
+        StringId(const shipChar* str, size_t numChars);
+        explicit StringId(const StringA& str);
+        explicit StringId(const StringView& str);
+
+        static constexpr StringId FromHash(shipUint64 hash)
+        {
+            return StringId(hash, FromHashTag());
+        }
+
+        // Strings that only differ by their case have the same id, for file names.
+        static StringId CreateCaseInsensitive(const shipChar* str, size_t numChars);
+        static StringId CreateCaseInsensitive(const StringA& str);
+        static StringId CreateCaseInsensitive(const StringView& str);
+
+        constexpr shipUint64 GetHash() const
+        {
+            return m_Hash;
+        }
+
+        constexpr shipBool IsValid() const
+        {
+            return (m_Hash != 0);
+        }
+
+        // Returns nullptr if the id was computed at compile time, or if interning is disabled.
+        const shipChar* GetString() const;
+
+        constexpr shipBool operator== (const StringId& rhs) const
+        {
+            return (m_Hash == rhs.m_Hash);
+        }
+
+        constexpr shipBool operator!= (const StringId& rhs) const
+        {
+            return (m_Hash != rhs.m_Hash);
+        }
+
+        constexpr shipBool operator< (const StringId& rhs) const
+        {
+            return (m_Hash < rhs.m_Hash);
+        }
+
+    private:
+        struct FromHashTag
+        {
+        };
+
+        constexpr StringId(shipUint64 hash, FromHashTag)
+            : m_Hash(hash)
+        {
+        }
+
+        shipUint64 m_Hash;
+    };
+
+    template <>
+    struct DefaultHasher<StringId>
+    {
+        shipUint64 operator() (const StringId& stringId) const
+        {
+            // FNV-1a doesn't mix the high bits well enough for the hash tables.
+            return HashUint64(stringId.GetHash());
+        }
+    };
+}
+
+#define SHIP_STRING_ID(str) Shipyard::StringId::FromHash(Shipyard::StringIdUtils::HashString(str))
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <system/array.h>
+
+namespace Shipyard
+{
+    // Non-owning view on a range of characters, which isn't necessarily null-terminated.
+    //
+    // Views are meant for parsing: substrings, trimming and splitting only move the view around instead of copying characters
+    // in a new String. The viewed characters must outlive the view.
+    template <typename CharType>
+    class BaseStringView
+    {
+    public:
+        static const size_t InvalidIndex = size_t(-1);
+
+    public:
+        BaseStringView();
+        BaseStringView(const CharType* sz);
+        BaseStringView(const CharType* sz, size_t numChars);
+
+        const CharType& operator[] (size_t index) const;
+
+        // The buffer is not null-terminated, Size() characters can be read from it.
+        const CharType* GetBuffer() const;
+
+        size_t Size() const;
+        shipBool IsEmpty() const;
+
+        size_t FindIndexOfFirst(const BaseStringView& strToFind, size_t startingPos) const;
+        size_t FindIndexOfFirst(CharType charToFind, size_t startingPos) const;
+
+        size_t FindIndexOfFirstReverse(CharType charToFind, size_t startingPos) const;
+
+        size_t FindIndexOfFirstCaseInsensitive(const BaseStringView& strToFind, size_t startingPos) const;
+        size_t FindIndexOfFirstCaseInsensitive(CharType charToFind, size_t startingPos) const;
+
+        // The substring is clamped to the end of the view.
+        BaseStringView Substring(size_t pos, size_t lengthOfSubstring) const;
+
+        // Removes spaces, tabs and newlines.
+        BaseStringView Trim() const;
+        BaseStringView TrimLeft() const;
+        BaseStringView TrimRight() const;
+
+        shipBool StartsWith(const BaseStringView& str) const;
+        shipBool EndsWith(const BaseStringView& str) const;
+
+        int Compare(const BaseStringView& str) const;
+        int CompareCaseInsensitive(const BaseStringView& str) const;
+
+        shipBool EqualCaseInsensitive(const BaseStringView& str) const;
+
+        // Like StringSplit, empty parts between two delimiters are kept, but a trailing empty part is not. Using an InplaceArray
+        // for the parts keeps splitting free of allocations.
+        void Split(CharType delimiter, Array<BaseStringView>& stringParts) const;
+
+        shipBool operator== (const BaseStringView& rhs) const;
+        shipBool operator!= (const BaseStringView& rhs) const;
+
+    private:
+        const CharType* m_Buffer;
+        size_t m_NumChars;
+    };
+
+    using StringView = BaseStringView<shipChar>;
+}
+
+#include <system/stringview.inl>
@@ -0,0 +1,345 @@
+#include <cctype>
+#include <cstring>
+
+#include <system/systemdebug.h>
+
+namespace Shipyard
+{;
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif // #ifndef MIN
+
+template <typename CharType>
+shipBool IsStringViewWhitespace(CharType c)
+{
+    return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+template <typename CharType>
+BaseStringView<CharType>::BaseStringView()
+    : m_Buffer(nullptr)
+    , m_NumChars(0)
+{
+}
+
+template <typename CharType>
+BaseStringView<CharType>::BaseStringView(const CharType* sz)
+    : m_Buffer(sz)
+    , m_NumChars((sz == nullptr) ? 0 : strlen(sz))
+{
+}
+
+template <typename CharType>
+BaseStringView<CharType>::BaseStringView(const CharType* sz, size_t numChars)
+    : m_Buffer(sz)
+    , m_NumChars(numChars)
+{
+}
+
+template <typename CharType>
+const CharType& BaseStringView<CharType>::operator[] (size_t index) const
+{
+    SHIP_ASSERT(index < m_NumChars);
+    return m_Buffer[index];
+}
+
+template <typename CharType>
+const CharType* BaseStringView<CharType>::GetBuffer() const
+{
+    return m_Buffer;
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::Size() const
+{
+    return m_NumChars;
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::IsEmpty() const
+{
+    return (m_NumChars == 0);
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::FindIndexOfFirst(const BaseStringView<CharType>& strToFind, size_t startingPos) const
+{
+    if (strToFind.m_NumChars == 0 || startingPos >= m_NumChars || strToFind.m_NumChars > (m_NumChars - startingPos))
+    {
+        return InvalidIndex;
+    }
+
+    size_t lastPossiblePos = (m_NumChars - strToFind.m_NumChars);
+
+    for (size_t i = startingPos; i <= lastPossiblePos; i++)
+    {
+        if (memcmp(&m_Buffer[i], strToFind.m_Buffer, strToFind.m_NumChars * sizeof(CharType)) == 0)
+        {
+            return i;
+        }
+    }
+
+    return InvalidIndex;
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::FindIndexOfFirst(CharType charToFind, size_t startingPos) const
+{
+    for (size_t i = startingPos; i < m_NumChars; i++)
+    {
+        if (m_Buffer[i] == charToFind)
+        {
+            return i;
+        }
+    }
+
+    return InvalidIndex;
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::FindIndexOfFirstReverse(CharType charToFind, size_t startingPos) const
+{
+    if (m_NumChars == 0)
+    {
+        return InvalidIndex;
+    }
+
+    startingPos = MIN(startingPos, m_NumChars - 1);
+
+    for (size_t i = startingPos + 1; i > 0; i--)
+    {
+        size_t idx = i - 1;
+
+        if (m_Buffer[idx] == charToFind)
+        {
+            return idx;
+        }
+    }
+
+    return InvalidIndex;
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::FindIndexOfFirstCaseInsensitive(const BaseStringView<CharType>& strToFind, size_t startingPos) const
+{
+    if (strToFind.m_NumChars == 0 || startingPos >= m_NumChars || strToFind.m_NumChars > (m_NumChars - startingPos))
+    {
+        return InvalidIndex;
+    }
+
+    size_t lastPossiblePos = (m_NumChars - strToFind.m_NumChars);
+
+    for (size_t i = startingPos; i <= lastPossiblePos; i++)
+    {
+        shipBool foundString = true;
+
+        for (size_t j = 0; j < strToFind.m_NumChars; j++)
+        {
+            if (tolower(m_Buffer[i + j]) != tolower(strToFind.m_Buffer[j]))
+            {
+                foundString = false;
+                break;
+            }
+        }
+
+        if (foundString)
+        {
+            return i;
+        }
+    }
+
+    return InvalidIndex;
+}
+
+template <typename CharType>
+size_t BaseStringView<CharType>::FindIndexOfFirstCaseInsensitive(CharType charToFind, size_t startingPos) const
+{
+    int loweredCharToFind = tolower(charToFind);
+
+    for (size_t i = startingPos; i < m_NumChars; i++)
+    {
+        if (tolower(m_Buffer[i]) == loweredCharToFind)
+        {
+            return i;
+        }
+    }
+
+    return InvalidIndex;
+}
+
+template <typename CharType>
+BaseStringView<CharType> BaseStringView<CharType>::Substring(size_t pos, size_t lengthOfSubstring) const
+{
+    if (pos >= m_NumChars)
+    {
+        return BaseStringView<CharType>(m_Buffer + m_NumChars, 0);
+    }
+
+    size_t sizeOfSubstring = MIN((m_NumChars - pos), lengthOfSubstring);
+
+    return BaseStringView<CharType>(m_Buffer + pos, sizeOfSubstring);
+}
+
+template <typename CharType>
+BaseStringView<CharType> BaseStringView<CharType>::Trim() const
+{
+    return TrimLeft().TrimRight();
+}
+
+template <typename CharType>
+BaseStringView<CharType> BaseStringView<CharType>::TrimLeft() const
+{
+    size_t startPos = 0;
+    while (startPos < m_NumChars && IsStringViewWhitespace(m_Buffer[startPos]))
+    {
+        startPos += 1;
+    }
+
+    return BaseStringView<CharType>(m_Buffer + startPos, m_NumChars - startPos);
+}
+
+template <typename CharType>
+BaseStringView<CharType> BaseStringView<CharType>::TrimRight() const
+{
+    size_t endPos = m_NumChars;
+    while (endPos > 0 && IsStringViewWhitespace(m_Buffer[endPos - 1]))
+    {
+        endPos -= 1;
+    }
+
+    return BaseStringView<CharType>(m_Buffer, endPos);
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::StartsWith(const BaseStringView<CharType>& str) const
+{
+    return (str.m_NumChars <= m_NumChars && Substring(0, str.m_NumChars) == str);
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::EndsWith(const BaseStringView<CharType>& str) const
+{
+    return (str.m_NumChars <= m_NumChars && Substring(m_NumChars - str.m_NumChars, str.m_NumChars) == str);
+}
+
+template <typename CharType>
+int BaseStringView<CharType>::Compare(const BaseStringView<CharType>& str) const
+{
+    size_t numCharsToCompare = MIN(m_NumChars, str.m_NumChars);
+
+    for (size_t idx = 0; idx < numCharsToCompare; idx++)
+    {
+        int diff = (int(m_Buffer[idx]) - int(str.m_Buffer[idx]));
+
+        if (diff < 0)
+        {
+            return -1;
+        }
+        else if (diff > 0)
+        {
+            return 1;
+        }
+    }
+
+    // A view is smaller than the longer views it is a prefix of, like with null-terminated strings.
+    if (m_NumChars < str.m_NumChars)
+    {
+        return -1;
+    }
+    else if (m_NumChars > str.m_NumChars)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+template <typename CharType>
+int BaseStringView<CharType>::CompareCaseInsensitive(const BaseStringView<CharType>& str) const
+{
+    size_t numCharsToCompare = MIN(m_NumChars, str.m_NumChars);
+
+    for (size_t idx = 0; idx < numCharsToCompare; idx++)
+    {
+        int diff = (tolower(m_Buffer[idx]) - tolower(str.m_Buffer[idx]));
+
+        if (diff < 0)
+        {
+            return -1;
+        }
+        else if (diff > 0)
+        {
+            return 1;
+        }
+    }
+
+    if (m_NumChars < str.m_NumChars)
+    {
+        return -1;
+    }
+    else if (m_NumChars > str.m_NumChars)
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::EqualCaseInsensitive(const BaseStringView<CharType>& str) const
+{
+    if (m_NumChars != str.m_NumChars)
+    {
+        return false;
+    }
+
+    for (size_t idx = 0; idx < m_NumChars; idx++)
+    {
+        if (tolower(m_Buffer[idx]) != tolower(str.m_Buffer[idx]))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename CharType>
+void BaseStringView<CharType>::Split(CharType delimiter, Array<BaseStringView<CharType>>& stringParts) const
+{
+    size_t partStartPos = 0;
+
+    for (size_t i = 0; i < m_NumChars; i++)
+    {
+        if (m_Buffer[i] == delimiter)
+        {
+            stringParts.Add(BaseStringView<CharType>(m_Buffer + partStartPos, i - partStartPos));
+            partStartPos = i + 1;
+        }
+    }
+
+    if (partStartPos < m_NumChars)
+    {
+        stringParts.Add(BaseStringView<CharType>(m_Buffer + partStartPos, m_NumChars - partStartPos));
+    }
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::operator== (const BaseStringView<CharType>& rhs) const
+{
+    if (m_NumChars != rhs.m_NumChars)
+    {
+        return false;
+    }
+
+    return (m_NumChars == 0 || memcmp(m_Buffer, rhs.m_Buffer, m_NumChars * sizeof(CharType)) == 0);
+}
+
+template <typename CharType>
+shipBool BaseStringView<CharType>::operator!= (const BaseStringView<CharType>& rhs) const
+{
+    return !(*this == rhs);
+}
+
+}
@@ -28,6 +28,43 @@ SHIPYARD_SYSTEM_API void GetCurrentTimeFullyFormatted(StringA& formattedOutput)
 #endif // #if PLATFORM == PLATFORM_WINDOWS
 }
 
+SHIPYARD_SYSTEM_API shipUint64 GetCurrentTimestamp()
+{
+#if PLATFORM == PLATFORM_WINDOWS
+
+    FILETIME currentTime;
+    GetSystemTimeAsFileTime(&currentTime);
+
+    return ((shipUint64(currentTime.dwHighDateTime) << 32) | shipUint64(currentTime.dwLowDateTime));
+
+#else
+#error To implement
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+}
+
+SHIPYARD_SYSTEM_API shipUint32 FormatTimestamp(shipUint64 timestamp, shipChar* buffer, size_t bufferSize)
+{
+#if PLATFORM == PLATFORM_WINDOWS
+
+    FILETIME fileTime;
+    fileTime.dwLowDateTime = DWORD(timestamp & 0xffffffff);
+    fileTime.dwHighDateTime = DWORD(timestamp >> 32);
+
+    SYSTEMTIME systemTime;
+    FileTimeToSystemTime(&fileTime, &systemTime);
+
+    SYSTEMTIME localTime;
+    SystemTimeToTzSpecificLocalTime(nullptr, &systemTime, &localTime);
+
+    int numChars = sprintf_s(buffer, bufferSize, "%04d-%02d-%02d-%02d-%02d-%02d-%04d", localTime.wYear, localTime.wMonth, localTime.wDay, localTime.wHour, localTime.wMinute, localTime.wSecond, localTime.wMilliseconds);
+
+    return ((numChars > 0) ? shipUint32(numChars) : 0);
+
+#else
+#error To implement
+#endif // #if PLATFORM == PLATFORM_WINDOWS
+}
+
 #if COMPILER == COMPILER_MSVC
 #pragma warning( default: 4996 )
 #endif // #if COMPILER == COMPILER_MSVC
@@ -19,6 +19,101 @@ namespace Shipyard
 #   endif // #if CPU_BITS == CPU_BITS_64
 #endif // #if COMPILER == COMPILER_MSVC
 
+    // Index of the lowest bit set to 1. The value must not be 0.
+    SHIP_INLINE shipUint32 GetLowestBitSetIndex(shipUint64 value)
+    {
+#if COMPILER == COMPILER_MSVC
+        unsigned long lowestBitSet = 0;
+#   if CPU_BITS == CPU_BITS_64
+        _BitScanForward64(&lowestBitSet, value);
+#   elif CPU_BITS == CPU_BITS_32
+        if (!_BitScanForward(&lowestBitSet, shipUint32(value)))
+        {
+            _BitScanForward(&lowestBitSet, shipUint32(value >> 32));
+            lowestBitSet += 32;
+        }
+#   endif // #if CPU_BITS == CPU_BITS_64
+        return shipUint32(lowestBitSet);
+#else
+        return shipUint32(__builtin_ctzll(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    SHIP_INLINE shipUint32 GetLowestBitSetIndex(shipUint32 value)
+    {
+#if COMPILER == COMPILER_MSVC
+        unsigned long lowestBitSet = 0;
+        _BitScanForward(&lowestBitSet, value);
+        return shipUint32(lowestBitSet);
+#else
+        return shipUint32(__builtin_ctz(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    // Index of the highest bit set to 1. The value must not be 0.
+    SHIP_INLINE shipUint32 GetHighestBitSetIndex(shipUint64 value)
+    {
+#if COMPILER == COMPILER_MSVC
+        unsigned long highestBitSet = 0;
+#   if CPU_BITS == CPU_BITS_64
+        _BitScanReverse64(&highestBitSet, value);
+#   elif CPU_BITS == CPU_BITS_32
+        if (_BitScanReverse(&highestBitSet, shipUint32(value >> 32)))
+        {
+            highestBitSet += 32;
+        }
+        else
+        {
+            _BitScanReverse(&highestBitSet, shipUint32(value));
+        }
+#   endif // #if CPU_BITS == CPU_BITS_64
+        return shipUint32(highestBitSet);
+#else
+        return shipUint32(63 - __builtin_clzll(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    SHIP_INLINE shipUint32 GetHighestBitSetIndex(shipUint32 value)
+    {
+#if COMPILER == COMPILER_MSVC
+        unsigned long highestBitSet = 0;
+        _BitScanReverse(&highestBitSet, value);
+        return shipUint32(highestBitSet);
+#else
+        return shipUint32(31 - __builtin_clz(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    SHIP_INLINE shipUint32 GetNumBitsSet(shipUint64 value)
+    {
+#if COMPILER == COMPILER_MSVC
+#   if CPU_BITS == CPU_BITS_64
+        return shipUint32(__popcnt64(value));
+#   elif CPU_BITS == CPU_BITS_32
+        return shipUint32(__popcnt(shipUint32(value)) + __popcnt(shipUint32(value >> 32)));
+#   endif // #if CPU_BITS == CPU_BITS_64
+#else
+        return shipUint32(__builtin_popcountll(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
+    SHIP_INLINE shipUint32 GetNumBitsSet(shipUint32 value)
+    {
+#if COMPILER == COMPILER_MSVC
+        return shipUint32(__popcnt(value));
+#else
+        return shipUint32(__builtin_popcount(value));
+#endif // #if COMPILER == COMPILER_MSVC
+    }
+
     // Returns the current time in a formatted output: year-month-day-hour-minutes-seconds-milliseconds.
     SHIPYARD_SYSTEM_API void GetCurrentTimeFullyFormatted(StringA& formattedOutput);
+
+    // Returns the current time as a number of 100 nanoseconds intervals. Cheaper than GetCurrentTimeFullyFormatted, to timestamp
+    // events that are formatted later.
+    SHIPYARD_SYSTEM_API shipUint64 GetCurrentTimestamp();
+
+    // Formats a timestamp returned by GetCurrentTimestamp like GetCurrentTimeFullyFormatted does, in local time. Returns the
+    // number of characters written.
+    SHIPYARD_SYSTEM_API shipUint32 FormatTimestamp(shipUint64 timestamp, shipChar* buffer, size_t bufferSize);
 }
\ No newline at end of file
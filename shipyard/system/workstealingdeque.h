@@ -0,0 +1,116 @@
+#pragma once
+
+#include <system/atomicoperations.h>
+
+#include <type_traits>
+
+namespace Shipyard
+{
+    // Chase-Lev work-stealing deque of a fixed capacity. Its owner thread pushes and pops at the bottom, in LIFO order, while
+    // any other thread steals from the top, in FIFO order.
+    //
+    // The owner and the thieves only race for the last element. Elements are pointers, so that a thief reading an element can't
+    // see it half written, and nullptr is never pushed since it means that nothing was popped or stolen.
+    template <typename T, shipUint32 Capacity>
+    class WorkStealingDeque
+    {
+        static_assert(std::is_pointer<T>::value, "WorkStealingDeque elements must be pointers");
+        static_assert((Capacity & (Capacity - 1)) == 0, "WorkStealingDeque capacity must be a power of 2");
+
+    public:
+        WorkStealingDeque()
+            : m_Top(0)
+            , m_Bottom(0)
+        {
+        }
+
+        // Owner only. Returns false if the deque is full.
+        shipBool Push(T element)
+        {
+            shipInt64 bottom = AtomicOperations::Load(m_Bottom, MemoryOrder::Relaxed);
+            shipInt64 top = AtomicOperations::Load(m_Top, MemoryOrder::Acquire);
+
+            if (bottom - top >= shipInt64(Capacity))
+            {
+                return false;
+            }
+
+            AtomicOperations::Store(m_Elements[bottom & (Capacity - 1)], element, MemoryOrder::Relaxed);
+
+            // Release: thieves see the element before the new bottom.
+            AtomicOperations::Store(m_Bottom, bottom + 1, MemoryOrder::Release);
+
+            return true;
+        }
+
+        // Owner only. Returns nullptr if the deque is empty.
+        T Pop()
+        {
+            shipInt64 bottom = AtomicOperations::Load(m_Bottom, MemoryOrder::Relaxed) - 1;
+
+            // Thieves must see the new bottom before the top is read, otherwise the owner and a thief could both take the last
+            // element. A sequentially consistent exchange followed by a sequentially consistent load orders them like a fence.
+            AtomicOperations::Exchange(m_Bottom, bottom);
+            shipInt64 top = AtomicOperations::Load(m_Top);
+
+            if (top > bottom)
+            {
+                AtomicOperations::Store(m_Bottom, bottom + 1, MemoryOrder::Relaxed);
+                return nullptr;
+            }
+
+            T element = AtomicOperations::Load(m_Elements[bottom & (Capacity - 1)], MemoryOrder::Relaxed);
+
+            if (top == bottom)
+            {
+                // Last element, whoever moves the top first gets it.
+                if (AtomicOperations::CompareExchange(m_Top, top + 1, top) != top)
+                {
+                    element = nullptr;
+                }
+
+                AtomicOperations::Store(m_Bottom, bottom + 1, MemoryOrder::Relaxed);
+            }
+
+            return element;
+        }
+
+        // Any thread. Returns nullptr if the deque is empty, or if another thread took the element first.
+        T Steal()
+        {
+            shipInt64 top = AtomicOperations::Load(m_Top);
+            shipInt64 bottom = AtomicOperations::Load(m_Bottom);
+
+            if (top >= bottom)
+            {
+                return nullptr;
+            }
+
+            // The slot can't be overwritten by the owner as long as the top didn't move, since the deque would be full.
+            T element = AtomicOperations::Load(m_Elements[top & (Capacity - 1)], MemoryOrder::Relaxed);
+
+            if (AtomicOperations::CompareExchange(m_Top, top + 1, top) != top)
+            {
+                return nullptr;
+            }
+
+            return element;
+        }
+
+        // Only a hint when other threads are using the deque.
+        shipUint32 Size() const
+        {
+            shipInt64 bottom = AtomicOperations::Load(m_Bottom, MemoryOrder::Relaxed);
+            shipInt64 top = AtomicOperations::Load(m_Top, MemoryOrder::Relaxed);
+
+            return ((bottom > top) ? shipUint32(bottom - top) : 0);
+        }
+
+    private:
+        // Thieves only write the top, the bottom is kept on its own cache line so that pushing doesn't bounce it.
+        SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) volatile shipInt64 m_Top;
+        SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) volatile shipInt64 m_Bottom;
+
+        SHIP_ALIGN(SHIP_CACHE_LINE_SIZE) T volatile m_Elements[Capacity];
+    };
+}
@@ -24,8 +24,8 @@ namespace Shipyard
             VertexFormatType SubMeshVertexFormatType;
 
             // MeshVertices are to be interpreted depending on the VertexFormatType
-            BigArray<shipUint8> SubMeshVertices;
-            BigArray<shipUint8> SubMeshIndices;
+            Array<shipUint8> SubMeshVertices;
+            Array<shipUint8> SubMeshIndices;
 
             ImportedSubMeshMaterial* ReferencedSubMeshMaterial;
 
@@ -65,7 +65,7 @@ ErrorCode LoadTextureFromFile(const shipChar* filename, ImportedTexture* importe
 
     unsigned int size = height * pitch;
 
-    BigArray<BYTE> textureDataFromFileArray;
+    Array<BYTE> textureDataFromFileArray;
     textureDataFromFileArray.Resize(shipUint32(size));
 
     BYTE* textureDataFromFile = &textureDataFromFileArray[0];
@@ -17,7 +17,7 @@ namespace Shipyard
             GfxFormat PixelFormat;
 
             // To be interpreted according to the dimension and pixel format. The memory is laid out, row by rows, for each slice of the texture.
-            BigArray<shipUint8> TextureData;
+            Array<shipUint8> TextureData;
         };
 
         enum class ErrorCode : shipUint8